@@ -129,6 +129,7 @@ void AggregatedTrackerView::RefreshTrackedItems()
 
     // Clear current items
     m_allItems.clear();
+    m_allItemsLabelsDirty = true;
 
     // Get all subscribed jobs
     std::vector<UFB::Subscription> subscriptions = m_subscriptionManager->GetAllSubscriptions();
@@ -209,6 +210,13 @@ void AggregatedTrackerView::Draw(const char* title, HWND hwnd)
     if (m_isShutdown)
         return;
 
+    // Handle deferred refresh (from operations during rendering)
+    if (m_needsRefresh)
+    {
+        m_needsRefresh = false;
+        RefreshTrackedItems();
+    }
+
     // Use close button and check if window was closed
     bool windowOpen = ImGui::Begin(title, &m_isOpen, ImGuiWindowFlags_None);
 
@@ -988,6 +996,52 @@ void AggregatedTrackerView::UpdateUnifiedItemsList()
     {
         m_selectedItemIndex = -1;
     }
+
+    RebuildItemLabels();
+}
+
+void AggregatedTrackerView::RebuildItemLabels()
+{
+    m_allItemsLabels.clear();
+    m_allItemsLabels.resize(m_allItems.size());
+
+    for (size_t i = 0; i < m_allItems.size(); i++)
+    {
+        const auto& item = m_allItems[i];
+        const auto& metadata = item.metadata;
+        ItemLabels& labels = m_allItemsLabels[i];
+
+        labels.project = UFB::WideToUtf8(item.jobName);
+
+        std::wstring displayPath = metadata.shotPath;
+        if (metadata.itemType == "manual_task")
+        {
+            // Extract task name from path: jobPath/__task_TaskName
+            size_t taskMarkerPos = metadata.shotPath.find(L"/__task_");
+            if (taskMarkerPos != std::wstring::npos)
+            {
+                displayPath = metadata.shotPath.substr(taskMarkerPos + 8);  // Skip "/__task_"
+            }
+        }
+        else
+        {
+            // Remove job path prefix
+            if (displayPath.find(item.jobPath) == 0)
+            {
+                displayPath = displayPath.substr(item.jobPath.length());
+                if (!displayPath.empty() && (displayPath[0] == L'\\' || displayPath[0] == L'/'))
+                    displayPath = displayPath.substr(1);
+            }
+        }
+        labels.path = UFB::WideToUtf8(displayPath);
+
+        labels.dueDate = metadata.dueDate;
+        labels.dueDateText = (metadata.dueDate > 0) ? FormatDate(metadata.dueDate) : "Not Set";
+        labels.modifiedTime = metadata.modifiedTime;
+        labels.modifiedText = (metadata.modifiedTime > 0) ? FormatDate(metadata.modifiedTime) : "-";
+    }
+
+    m_allItemsLabelsDirty = false;
 }
 
 void AggregatedTrackerView::DrawUnifiedTable()
@@ -1034,6 +1088,7 @@ void AggregatedTrackerView::DrawUnifiedTable()
                 m_allItemsSortColumn = sortsSpecs->Specs[0].ColumnIndex;
                 m_allItemsSortAscending = (sortsSpecs->Specs[0].SortDirection == ImGuiSortDirection_Ascending);
                 SortItems(m_allItems, m_allItemsSortColumn, m_allItemsSortAscending);
+                RebuildItemLabels();
                 sortsSpecs->SpecsDirty = false;
             }
         }
@@ -1041,112 +1096,67 @@ void AggregatedTrackerView::DrawUnifiedTable()
         ImGui::TableHeadersRow();
 
         // Draw rows
-        for (int i = 0; i < static_cast<int>(m_allItems.size()); ++i)
-        {
-            auto& item = m_allItems[i];
-            auto& metadata = item.metadata;
+        // Labels normally follow m_allItems already (rebuilt with the list and after sorting)
+        if (m_allItemsLabelsDirty || m_allItemsLabels.size() != m_allItems.size())
+            RebuildItemLabels();
 
-            // Set minimum row height (matching shot_view)
-            ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
+        // Only the visible rows are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_allItems.size()));
 
-            ImGui::PushID(i);
-
-            // Column 0: Type (with color badge)
-            ImGui::TableSetColumnIndex(0);
-            ImVec4 typeColor = GetTypeColor(metadata.itemType);
-            ImGui::PushStyleColor(ImGuiCol_Text, typeColor);
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+            {
+                auto& item = m_allItems[i];
+                auto& metadata = item.metadata;
+                ItemLabels& labels = m_allItemsLabels[i];
 
-            std::string typeLabel = "Unknown";
-            if (metadata.itemType == "shot") typeLabel = "Shot";
-            else if (metadata.itemType == "asset") typeLabel = "Asset";
-            else if (metadata.itemType == "posting") typeLabel = "Posting";
-            else if (metadata.itemType == "manual_task") typeLabel = "Task";
+                // Set minimum row height (matching shot_view)
+                ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
 
-            ImGui::TextUnformatted(typeLabel.c_str());
-            ImGui::PopStyleColor();
+                ImGui::PushID(i);
 
-            // Column 1: Project
-            ImGui::TableSetColumnIndex(1);
-            char projectUtf8[256];
-            WideCharToMultiByte(CP_UTF8, 0, item.jobName.c_str(), -1, projectUtf8, sizeof(projectUtf8), nullptr, nullptr);
-            ImGui::TextUnformatted(projectUtf8);
+                // Column 0: Type (with color badge)
+                ImGui::TableSetColumnIndex(0);
+                ImVec4 typeColor = GetTypeColor(metadata.itemType);
+                ImGui::PushStyleColor(ImGuiCol_Text, typeColor);
 
-            // Column 2: Path
-            ImGui::TableSetColumnIndex(2);
+                std::string typeLabel = "Unknown";
+                if (metadata.itemType == "shot") typeLabel = "Shot";
+                else if (metadata.itemType == "asset") typeLabel = "Asset";
+                else if (metadata.itemType == "posting") typeLabel = "Posting";
+                else if (metadata.itemType == "manual_task") typeLabel = "Task";
 
-            std::wstring displayPath = metadata.shotPath;
-            if (metadata.itemType == "manual_task")
-            {
-                // Extract task name from path: jobPath/__task_TaskName
-                size_t taskMarkerPos = metadata.shotPath.find(L"/__task_");
-                if (taskMarkerPos != std::wstring::npos)
-                {
-                    displayPath = metadata.shotPath.substr(taskMarkerPos + 8);  // Skip "/__task_"
-                }
-            }
-            else
-            {
-                // Remove job path prefix
-                if (displayPath.find(item.jobPath) == 0)
-                {
-                    displayPath = displayPath.substr(item.jobPath.length());
-                    if (!displayPath.empty() && (displayPath[0] == L'\\' || displayPath[0] == L'/'))
-                        displayPath = displayPath.substr(1);
-                }
-            }
-
-            char pathUtf8[4096];
-            WideCharToMultiByte(CP_UTF8, 0, displayPath.c_str(), -1, pathUtf8, sizeof(pathUtf8), nullptr, nullptr);
+                ImGui::TextUnformatted(typeLabel.c_str());
+                ImGui::PopStyleColor();
 
-            bool isSelected = (i == m_selectedItemIndex);
+                // Column 1: Project
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextUnformatted(labels.project.c_str());
 
-            // Use accent color for selected items (matching shot_view)
-            ImVec4 accentColor = GetWindowsAccentColor();
-            accentColor.w = 0.3f;  // Set transparency
-            if (isSelected)
-            {
-                ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
-                ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
-                ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
-            }
+                // Column 2: Path
+                ImGui::TableSetColumnIndex(2);
 
-            // Use explicit height to match row height (35.0f)
-            if (ImGui::Selectable(pathUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
-            {
-                m_selectedItemIndex = i;
+                bool isSelected = (i == m_selectedItemIndex);
 
-                // Double-click to open
-                if (ImGui::IsMouseDoubleClicked(0))
+                // Use accent color for selected items (matching shot_view)
+                ImVec4 accentColor = GetWindowsAccentColor();
+                accentColor.w = 0.3f;  // Set transparency
+                if (isSelected)
                 {
-                    if (metadata.itemType == "shot" && onOpenShot)
-                        onOpenShot(metadata.shotPath);
-                    else if (metadata.itemType == "asset" && onOpenAsset)
-                        onOpenAsset(metadata.shotPath);
-                    else if (metadata.itemType == "posting" && onOpenPosting)
-                        onOpenPosting(metadata.shotPath);
+                    ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
+                    ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
+                    ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
                 }
 
-                // Middle-click to open in new window
-                if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
+                // Use explicit height to match row height (35.0f)
+                if (ImGui::Selectable(labels.path.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
                 {
-                    if (metadata.itemType != "manual_task" && onOpenInNewWindow)
-                    {
-                        onOpenInNewWindow(metadata.shotPath);
-                    }
-                }
-            }
+                    m_selectedItemIndex = i;
 
-            if (isSelected)
-            {
-                ImGui::PopStyleColor(3);  // Pop Header, HeaderHovered, HeaderActive
-            }
-
-            // Context menu
-            if (ImGui::BeginPopupContextItem())
-            {
-                if (metadata.itemType != "manual_task")
-                {
-                    if (ImGui::MenuItem("Open in Project View"))
+                    // Double-click to open
+                    if (ImGui::IsMouseDoubleClicked(0))
                     {
                         if (metadata.itemType == "shot" && onOpenShot)
                             onOpenShot(metadata.shotPath);
@@ -1156,437 +1166,480 @@ void AggregatedTrackerView::DrawUnifiedTable()
                             onOpenPosting(metadata.shotPath);
                     }
 
-                    ImGui::Separator();
-
-                    // Reveal in Explorer
-                    if (ImGui::MenuItem("Reveal in Explorer"))
-                    {
-                        std::wstring command = L"/select,\"" + metadata.shotPath + L"\"";
-                        ShellExecuteW(nullptr, L"open", L"explorer.exe", command.c_str(), nullptr, SW_SHOW);
-                    }
-
-                    // Open in New Window
-                    if (onOpenInNewWindow)
+                    // Middle-click to open in new window
+                    if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
                     {
-                        if (ImGui::MenuItem("Open in New Window"))
+                        if (metadata.itemType != "manual_task" && onOpenInNewWindow)
                         {
                             onOpenInNewWindow(metadata.shotPath);
                         }
                     }
+                }
+
+                if (isSelected)
+                {
+                    ImGui::PopStyleColor(3);  // Pop Header, HeaderHovered, HeaderActive
+                }
 
-                    // Open in Browser 1 and Browser 2
-                    if (onOpenInBrowser1)
+                // Context menu
+                if (ImGui::BeginPopupContextItem())
+                {
+                    if (metadata.itemType != "manual_task")
                     {
-                        if (ImGui::MenuItem("Open in the Left Browser"))
+                        if (ImGui::MenuItem("Open in Project View"))
                         {
-                            onOpenInBrowser1(metadata.shotPath);
+                            if (metadata.itemType == "shot" && onOpenShot)
+                                onOpenShot(metadata.shotPath);
+                            else if (metadata.itemType == "asset" && onOpenAsset)
+                                onOpenAsset(metadata.shotPath);
+                            else if (metadata.itemType == "posting" && onOpenPosting)
+                                onOpenPosting(metadata.shotPath);
                         }
-                    }
 
-                    if (onOpenInBrowser2)
-                    {
-                        if (ImGui::MenuItem("Open in the Right Browser"))
+                        ImGui::Separator();
+
+                        // Reveal in Explorer
+                        if (ImGui::MenuItem("Reveal in Explorer"))
                         {
-                            onOpenInBrowser2(metadata.shotPath);
+                            std::wstring command = L"/select,\"" + metadata.shotPath + L"\"";
+                            ShellExecuteW(nullptr, L"open", L"explorer.exe", command.c_str(), nullptr, SW_SHOW);
                         }
-                    }
 
-                    ImGui::Separator();
-                }
+                        // Open in New Window
+                        if (onOpenInNewWindow)
+                        {
+                            if (ImGui::MenuItem("Open in New Window"))
+                            {
+                                onOpenInNewWindow(metadata.shotPath);
+                            }
+                        }
 
-                // Open project tracker for this item's project
-                if (onOpenProjectTracker)
-                {
-                    if (ImGui::MenuItem("Open Project Tracker"))
-                    {
-                        onOpenProjectTracker(item.jobPath, item.jobName);
-                    }
+                        // Open in Browser 1 and Browser 2
+                        if (onOpenInBrowser1)
+                        {
+                            if (ImGui::MenuItem("Open in the Left Browser"))
+                            {
+                                onOpenInBrowser1(metadata.shotPath);
+                            }
+                        }
 
-                    ImGui::Separator();
-                }
+                        if (onOpenInBrowser2)
+                        {
+                            if (ImGui::MenuItem("Open in the Right Browser"))
+                            {
+                                onOpenInBrowser2(metadata.shotPath);
+                            }
+                        }
 
-                if (ImGui::MenuItem("Un-track"))
-                {
-                    metadata.isTracked = false;
-                    if (m_subscriptionManager)
+                        ImGui::Separator();
+                    }
+
+                    // Open project tracker for this item's project
+                    if (onOpenProjectTracker)
                     {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        if (ImGui::MenuItem("Open Project Tracker"))
+                        {
+                            onOpenProjectTracker(item.jobPath, item.jobName);
+                        }
+
+                        ImGui::Separator();
                     }
-                    RefreshTrackedItems();
-                }
 
-                if (metadata.itemType == "manual_task")
-                {
-                    if (ImGui::MenuItem("Delete Task"))
+                    if (ImGui::MenuItem("Un-track"))
                     {
+                        metadata.isTracked = false;
                         if (m_subscriptionManager)
                         {
-                            m_subscriptionManager->DeleteShotMetadata(metadata.shotPath);
+                            m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
                         }
-                        RefreshTrackedItems();
+                        // Defer refresh until the table has ended (can't update m_allItems while rendering)
+                        m_needsRefresh = true;
                     }
-                }
 
-                ImGui::EndPopup();
-            }
+                    if (metadata.itemType == "manual_task")
+                    {
+                        if (ImGui::MenuItem("Delete Task"))
+                        {
+                            if (m_subscriptionManager)
+                            {
+                                m_subscriptionManager->DeleteShotMetadata(metadata.shotPath);
+                            }
+                            m_needsRefresh = true;
+                        }
+                    }
 
-            // Push mono font for all metadata columns
-            if (font_mono)
-                ImGui::PushFont(font_mono);
+                    ImGui::EndPopup();
+                }
 
-            // Column 3: Status (editable dropdown)
-            ImGui::TableSetColumnIndex(3);
+                // Push mono font for all metadata columns
+                if (font_mono)
+                    ImGui::PushFont(font_mono);
 
-            // Get config for this item's project
-            UFB::ProjectConfig* config = GetConfigForItem(item);
+                // Column 3: Status (editable dropdown)
+                ImGui::TableSetColumnIndex(3);
 
-            // Get status options from config
-            std::vector<UFB::StatusOption> statusOptions;
-            if (config && config->IsLoaded() && !metadata.folderType.empty())
-            {
-                statusOptions = config->GetStatusOptions(metadata.folderType);
-            }
+                // Get config for this item's project
+                UFB::ProjectConfig* config = GetConfigForItem(item);
 
-            std::string displayStatus = metadata.status.empty() ? "Not Set" : metadata.status;
-            ImVec4 statusColor = metadata.status.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetStatusColor(metadata.status, metadata.folderType, config);
-            ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
+                std::string displayStatus = metadata.status.empty() ? "Not Set" : metadata.status;
+                ImVec4 statusColor = metadata.status.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetStatusColor(metadata.status, metadata.folderType, config);
+                ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##status" + std::to_string(i)).c_str(), displayStatus.c_str()))
-            {
-                if (statusOptions.empty())
-                {
-                    ImGui::TextDisabled("(No options configured)");
-                }
-                else
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##status" + std::to_string(i)).c_str(), displayStatus.c_str()))
                 {
-                    for (const auto& statusOpt : statusOptions)
+                    // Options are only needed while the combo is open
+                    std::vector<UFB::StatusOption> statusOptions;
+                    if (config && config->IsLoaded() && !metadata.folderType.empty())
                     {
-                        bool isSelected = (metadata.status == statusOpt.name);
-                        ImVec4 optionColor = GetStatusColor(statusOpt.name, metadata.folderType, config);
-                        ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+                        statusOptions = config->GetStatusOptions(metadata.folderType);
+                    }
 
-                        if (ImGui::Selectable(statusOpt.name.c_str(), isSelected))
+                    if (statusOptions.empty())
+                    {
+                        ImGui::TextDisabled("(No options configured)");
+                    }
+                    else
+                    {
+                        for (const auto& statusOpt : statusOptions)
                         {
-                            metadata.status = statusOpt.name;
-                            if (m_subscriptionManager)
+                            bool isSelected = (metadata.status == statusOpt.name);
+                            ImVec4 optionColor = GetStatusColor(statusOpt.name, metadata.folderType, config);
+                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+
+                            if (ImGui::Selectable(statusOpt.name.c_str(), isSelected))
                             {
-                                m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                                metadata.status = statusOpt.name;
+                                if (m_subscriptionManager)
+                                {
+                                    m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                                }
                             }
-                        }
 
-                        ImGui::PopStyleColor();
+                            ImGui::PopStyleColor();
 
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+                        }
                     }
+                    ImGui::EndCombo();
                 }
-                ImGui::EndCombo();
-            }
-            ImGui::PopStyleColor();
-
-            // Column 4: Category (editable dropdown)
-            ImGui::TableSetColumnIndex(4);
+                ImGui::PopStyleColor();
 
-            // Get category options from config
-            std::vector<UFB::CategoryOption> categoryOptions;
-            if (config && config->IsLoaded() && !metadata.folderType.empty())
-            {
-                categoryOptions = config->GetCategoryOptions(metadata.folderType);
-            }
+                // Column 4: Category (editable dropdown)
+                ImGui::TableSetColumnIndex(4);
 
-            std::string displayCategory = metadata.category.empty() ? "Not Set" : metadata.category;
-            ImVec4 categoryColor = metadata.category.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetCategoryColor(metadata.category, metadata.folderType, config);
-            ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
+                std::string displayCategory = metadata.category.empty() ? "Not Set" : metadata.category;
+                ImVec4 categoryColor = metadata.category.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetCategoryColor(metadata.category, metadata.folderType, config);
+                ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##category" + std::to_string(i)).c_str(), displayCategory.c_str()))
-            {
-                if (categoryOptions.empty())
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##category" + std::to_string(i)).c_str(), displayCategory.c_str()))
                 {
-                    ImGui::TextDisabled("(No options configured)");
-                }
-                else
-                {
-                    for (const auto& catOpt : categoryOptions)
+                    // Options are only needed while the combo is open
+                    std::vector<UFB::CategoryOption> categoryOptions;
+                    if (config && config->IsLoaded() && !metadata.folderType.empty())
                     {
-                        bool isSelected = (metadata.category == catOpt.name);
-                        ImVec4 optionColor = GetCategoryColor(catOpt.name, metadata.folderType, config);
-                        ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+                        categoryOptions = config->GetCategoryOptions(metadata.folderType);
+                    }
 
-                        if (ImGui::Selectable(catOpt.name.c_str(), isSelected))
+                    if (categoryOptions.empty())
+                    {
+                        ImGui::TextDisabled("(No options configured)");
+                    }
+                    else
+                    {
+                        for (const auto& catOpt : categoryOptions)
                         {
-                            metadata.category = catOpt.name;
-                            if (m_subscriptionManager)
+                            bool isSelected = (metadata.category == catOpt.name);
+                            ImVec4 optionColor = GetCategoryColor(catOpt.name, metadata.folderType, config);
+                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+
+                            if (ImGui::Selectable(catOpt.name.c_str(), isSelected))
                             {
-                                m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                                metadata.category = catOpt.name;
+                                if (m_subscriptionManager)
+                                {
+                                    m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                                }
                             }
-                        }
 
-                        ImGui::PopStyleColor();
+                            ImGui::PopStyleColor();
 
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+                        }
                     }
+                    ImGui::EndCombo();
                 }
-                ImGui::EndCombo();
-            }
-            ImGui::PopStyleColor();
+                ImGui::PopStyleColor();
 
-            // Column 5: Priority (editable dropdown)
-            ImGui::TableSetColumnIndex(5);
+                // Column 5: Priority (editable dropdown)
+                ImGui::TableSetColumnIndex(5);
 
-            const char* priorityLabel = GetPriorityLabel(metadata.priority);
-            ImVec4 priorityColor = GetPriorityColor(metadata.priority);
-            ImGui::PushStyleColor(ImGuiCol_Text, priorityColor);
+                const char* priorityLabel = GetPriorityLabel(metadata.priority);
+                ImVec4 priorityColor = GetPriorityColor(metadata.priority);
+                ImGui::PushStyleColor(ImGuiCol_Text, priorityColor);
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##priority" + std::to_string(i)).c_str(), priorityLabel))
-            {
-                // High Priority
-                bool isHighSelected = (metadata.priority == 1);
-                ImVec4 highColor = GetPriorityColor(1);
-                ImGui::PushStyleColor(ImGuiCol_Text, highColor);
-                if (ImGui::Selectable("High", isHighSelected))
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##priority" + std::to_string(i)).c_str(), priorityLabel))
                 {
-                    metadata.priority = 1;
-                    if (m_subscriptionManager)
+                    // High Priority
+                    bool isHighSelected = (metadata.priority == 1);
+                    ImVec4 highColor = GetPriorityColor(1);
+                    ImGui::PushStyleColor(ImGuiCol_Text, highColor);
+                    if (ImGui::Selectable("High", isHighSelected))
                     {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        metadata.priority = 1;
+                        if (m_subscriptionManager)
+                        {
+                            m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        }
                     }
-                }
-                ImGui::PopStyleColor();
-                if (isHighSelected)
-                    ImGui::SetItemDefaultFocus();
-
-                // Medium Priority
-                bool isMediumSelected = (metadata.priority == 2);
-                ImVec4 mediumColor = GetPriorityColor(2);
-                ImGui::PushStyleColor(ImGuiCol_Text, mediumColor);
-                if (ImGui::Selectable("Medium", isMediumSelected))
-                {
-                    metadata.priority = 2;
-                    if (m_subscriptionManager)
+                    ImGui::PopStyleColor();
+                    if (isHighSelected)
+                        ImGui::SetItemDefaultFocus();
+
+                    // Medium Priority
+                    bool isMediumSelected = (metadata.priority == 2);
+                    ImVec4 mediumColor = GetPriorityColor(2);
+                    ImGui::PushStyleColor(ImGuiCol_Text, mediumColor);
+                    if (ImGui::Selectable("Medium", isMediumSelected))
                     {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        metadata.priority = 2;
+                        if (m_subscriptionManager)
+                        {
+                            m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        }
                     }
-                }
-                ImGui::PopStyleColor();
-                if (isMediumSelected)
-                    ImGui::SetItemDefaultFocus();
-
-                // Low Priority
-                bool isLowSelected = (metadata.priority == 3);
-                ImVec4 lowColor = GetPriorityColor(3);
-                ImGui::PushStyleColor(ImGuiCol_Text, lowColor);
-                if (ImGui::Selectable("Low", isLowSelected))
-                {
-                    metadata.priority = 3;
-                    if (m_subscriptionManager)
+                    ImGui::PopStyleColor();
+                    if (isMediumSelected)
+                        ImGui::SetItemDefaultFocus();
+
+                    // Low Priority
+                    bool isLowSelected = (metadata.priority == 3);
+                    ImVec4 lowColor = GetPriorityColor(3);
+                    ImGui::PushStyleColor(ImGuiCol_Text, lowColor);
+                    if (ImGui::Selectable("Low", isLowSelected))
                     {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        metadata.priority = 3;
+                        if (m_subscriptionManager)
+                        {
+                            m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        }
                     }
+                    ImGui::PopStyleColor();
+                    if (isLowSelected)
+                        ImGui::SetItemDefaultFocus();
+
+                    ImGui::EndCombo();
                 }
                 ImGui::PopStyleColor();
-                if (isLowSelected)
-                    ImGui::SetItemDefaultFocus();
-
-                ImGui::EndCombo();
-            }
-            ImGui::PopStyleColor();
 
-            // Column 6: Artist (editable dropdown)
-            ImGui::TableSetColumnIndex(6);
+                // Column 6: Artist (editable dropdown)
+                ImGui::TableSetColumnIndex(6);
 
-            // Get users list from config
-            std::vector<UFB::User> users;
-            if (config && config->IsLoaded())
-            {
-                users = config->GetUsers();
-            }
+                // Get users list from config
+                std::vector<UFB::User> users;
+                if (config && config->IsLoaded())
+                {
+                    users = config->GetUsers();
+                }
 
-            std::string displayArtist = metadata.artist.empty() ? "Not Set" : metadata.artist;
+                std::string displayArtist = metadata.artist.empty() ? "Not Set" : metadata.artist;
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##artist" + std::to_string(i)).c_str(), displayArtist.c_str()))
-            {
-                // "Not Set" option to clear the artist
-                bool isNotSetSelected = metadata.artist.empty();
-                if (ImGui::Selectable("Not Set", isNotSetSelected))
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##artist" + std::to_string(i)).c_str(), displayArtist.c_str()))
                 {
-                    metadata.artist = "";
-                    if (m_subscriptionManager)
+                    // "Not Set" option to clear the artist
+                    bool isNotSetSelected = metadata.artist.empty();
+                    if (ImGui::Selectable("Not Set", isNotSetSelected))
                     {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        metadata.artist = "";
+                        if (m_subscriptionManager)
+                        {
+                            m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                        }
                     }
-                }
-                if (isNotSetSelected)
-                    ImGui::SetItemDefaultFocus();
-
-                if (!users.empty())
-                {
-                    ImGui::Separator();
+                    if (isNotSetSelected)
+                        ImGui::SetItemDefaultFocus();
 
-                    for (const auto& user : users)
+                    if (!users.empty())
                     {
-                        bool isSelected = (metadata.artist == user.displayName);
-                        if (ImGui::Selectable(user.displayName.c_str(), isSelected))
+                        ImGui::Separator();
+
+                        for (const auto& user : users)
                         {
-                            metadata.artist = user.displayName;
-                            if (m_subscriptionManager)
+                            bool isSelected = (metadata.artist == user.displayName);
+                            if (ImGui::Selectable(user.displayName.c_str(), isSelected))
                             {
-                                m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                                metadata.artist = user.displayName;
+                                if (m_subscriptionManager)
+                                {
+                                    m_subscriptionManager->CreateOrUpdateShotMetadata(metadata);
+                                }
                             }
-                        }
 
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+                        }
+                    }
+                    else
+                    {
+                        ImGui::TextDisabled("(No users configured)");
                     }
+
+                    ImGui::EndCombo();
                 }
-                else
+
+                // Column 7: Due Date (clickable button like shot_view)
+                ImGui::TableSetColumnIndex(7);
+
+                // Re-formatted only when the date was edited since the labels were made
+                if (labels.dueDate != metadata.dueDate)
                 {
-                    ImGui::TextDisabled("(No users configured)");
+                    labels.dueDate = metadata.dueDate;
+                    labels.dueDateText = (metadata.dueDate > 0) ? FormatDate(metadata.dueDate) : "Not Set";
                 }
+                const std::string& dueDateStr = labels.dueDateText;
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::Button((dueDateStr + "##duedate" + std::to_string(i)).c_str(), ImVec2(-FLT_MIN, 0)))
+                {
+                    m_showAllItemsDatePicker = true;
+                    m_allItemsDatePickerIndex = i;
+                }
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Click to select date");
 
-                ImGui::EndCombo();
-            }
+                // Column 8: Modified Date (read-only, disabled text color)
+                ImGui::TableSetColumnIndex(8);
+
+                if (labels.modifiedTime != metadata.modifiedTime)
+                {
+                    labels.modifiedTime = metadata.modifiedTime;
+                    labels.modifiedText = (metadata.modifiedTime > 0) ? FormatDate(metadata.modifiedTime) : "-";
+                }
+                const std::string& modifiedDateStr = labels.modifiedText;
+                ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+                ImGui::TextUnformatted(modifiedDateStr.c_str());
+                ImGui::PopStyleColor();
 
-            // Column 7: Due Date (clickable button like shot_view)
-            ImGui::TableSetColumnIndex(7);
+                // Column 9: Links (clickable, similar to notes)
+                ImGui::TableSetColumnIndex(9);
 
-            std::string dueDateStr = (metadata.dueDate > 0) ? FormatDate(metadata.dueDate) : "Not Set";
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::Button((dueDateStr + "##duedate" + std::to_string(i)).c_str(), ImVec2(-FLT_MIN, 0)))
-            {
-                m_showAllItemsDatePicker = true;
-                m_allItemsDatePickerIndex = i;
-            }
-            if (ImGui::IsItemHovered())
-                ImGui::SetTooltip("Click to select date");
+                // Pop mono font before Links/Notes columns
+                if (font_mono)
+                    ImGui::PopFont();
 
-            // Column 8: Modified Date (read-only, disabled text color)
-            ImGui::TableSetColumnIndex(8);
+                // Check if link exists (links field is a string, not empty means we have a link)
+                bool hasLink = !metadata.links.empty();
 
-            std::string modifiedDateStr = (metadata.modifiedTime > 0) ? FormatDate(metadata.modifiedTime) : "-";
-            ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
-            ImGui::TextUnformatted(modifiedDateStr.c_str());
-            ImGui::PopStyleColor();
+                if (hasLink)
+                {
+                    // 50/50 split for Edit and Link buttons (120px column / 2 = ~55px each with spacing)
+                    float buttonWidth = 55.0f;
 
-            // Column 9: Links (clickable, similar to notes)
-            ImGui::TableSetColumnIndex(9);
+                    // Show "Edit" button (left side)
+                    if (ImGui::Button(("Edit##linkedit" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                    {
+                        m_showLinkEditor = true;
+                        m_linkEditorItemIndex = i;
+                        strncpy_s(m_linkEditorBuffer, sizeof(m_linkEditorBuffer), metadata.links.c_str(), sizeof(m_linkEditorBuffer) - 1);
+                        m_linkEditorBuffer[sizeof(m_linkEditorBuffer) - 1] = '\0';
+                    }
 
-            // Pop mono font before Links/Notes columns
-            if (font_mono)
-                ImGui::PopFont();
+                    ImGui::SameLine();
 
-            // Check if link exists (links field is a string, not empty means we have a link)
-            bool hasLink = !metadata.links.empty();
+                    // Show "Link" button in accent color (right side)
+                    ImVec4 accentColor = GetWindowsAccentColor();
+                    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));  // Transparent background
+                    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.2f));
+                    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.3f));
+                    ImGui::PushStyleColor(ImGuiCol_Text, accentColor);
 
-            if (hasLink)
-            {
-                // 50/50 split for Edit and Link buttons (120px column / 2 = ~55px each with spacing)
-                float buttonWidth = 55.0f;
+                    if (ImGui::Button(("Link##linkopen" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                    {
+                        // Open link in default browser
+                        std::wstring wideLink(metadata.links.begin(), metadata.links.end());
+                        ShellExecuteW(nullptr, L"open", wideLink.c_str(), nullptr, nullptr, SW_SHOW);
+                    }
 
-                // Show "Edit" button (left side)
-                if (ImGui::Button(("Edit##linkedit" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                    ImGui::PopStyleColor(4);
+
+                    if (ImGui::IsItemHovered())
+                    {
+                        ImGui::BeginTooltip();
+                        ImGui::Text("Click to open: %s", metadata.links.c_str());
+                        ImGui::EndTooltip();
+                    }
+                }
+                else
                 {
-                    m_showLinkEditor = true;
-                    m_linkEditorItemIndex = i;
-                    strncpy_s(m_linkEditorBuffer, sizeof(m_linkEditorBuffer), metadata.links.c_str(), sizeof(m_linkEditorBuffer) - 1);
-                    m_linkEditorBuffer[sizeof(m_linkEditorBuffer) - 1] = '\0';
+                    // Show "(click to add link)" in disabled color
+                    ImVec4 textColor = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+                    ImGui::PushStyleColor(ImGuiCol_Text, textColor);
+
+                    if (ImGui::Selectable(("(click to add link)##linkadd" + std::to_string(i)).c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
+                    {
+                        m_showLinkEditor = true;
+                        m_linkEditorItemIndex = i;
+                        m_linkEditorBuffer[0] = '\0';
+                    }
+
+                    ImGui::PopStyleColor();
                 }
 
-                ImGui::SameLine();
+                // Column 10: Notes (clickable text with tooltip)
+                ImGui::TableSetColumnIndex(10);
 
-                // Show "Link" button in accent color (right side)
-                ImVec4 accentColor = GetWindowsAccentColor();
-                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));  // Transparent background
-                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.2f));
-                ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.3f));
-                ImGui::PushStyleColor(ImGuiCol_Text, accentColor);
+                // Create a one-line preview
+                std::string notePreview = metadata.note.empty() ? "(click to add note)" : metadata.note;
 
-                if (ImGui::Button(("Link##linkopen" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                // Truncate to first line only
+                size_t newlinePos = notePreview.find('\n');
+                if (newlinePos != std::string::npos)
                 {
-                    // Open link in default browser
-                    std::wstring wideLink(metadata.links.begin(), metadata.links.end());
-                    ShellExecuteW(nullptr, L"open", wideLink.c_str(), nullptr, nullptr, SW_SHOW);
+                    notePreview = notePreview.substr(0, newlinePos) + "...";
                 }
 
-                ImGui::PopStyleColor(4);
-
-                if (ImGui::IsItemHovered())
+                // Truncate if too long (max 50 chars for preview)
+                if (notePreview.length() > 50)
                 {
-                    ImGui::BeginTooltip();
-                    ImGui::Text("Click to open: %s", metadata.links.c_str());
-                    ImGui::EndTooltip();
+                    notePreview = notePreview.substr(0, 47) + "...";
                 }
-            }
-            else
-            {
-                // Show "(click to add link)" in disabled color
-                ImVec4 textColor = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+                // Make it selectable to detect clicks, fill the full cell height
+                // Adjust height to account for cell padding (8.0f top + 8.0f bottom = 16.0f)
+                std::string selectableId = "##note_preview_" + std::to_string(i);
+                ImVec4 textColor = metadata.note.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
                 ImGui::PushStyleColor(ImGuiCol_Text, textColor);
 
-                if (ImGui::Selectable(("(click to add link)##linkadd" + std::to_string(i)).c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
+                // Disable frame padding for this Selectable to fill the cell properly
+                ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(4.0f, 0.0f));
+                if (ImGui::Selectable(notePreview.c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
                 {
-                    m_showLinkEditor = true;
-                    m_linkEditorItemIndex = i;
-                    m_linkEditorBuffer[0] = '\0';
+                    // Open note editor modal
+                    m_showNoteEditor = true;
+                    m_noteEditorItemIndex = i;
+                    strncpy_s(m_noteEditorBuffer, sizeof(m_noteEditorBuffer), metadata.note.c_str(), sizeof(m_noteEditorBuffer) - 1);
+                    m_noteEditorBuffer[sizeof(m_noteEditorBuffer) - 1] = '\0';
                 }
+                ImGui::PopStyleVar();
 
                 ImGui::PopStyleColor();
-            }
-
-            // Column 10: Notes (clickable text with tooltip)
-            ImGui::TableSetColumnIndex(10);
-
-            // Create a one-line preview
-            std::string notePreview = metadata.note.empty() ? "(click to add note)" : metadata.note;
-
-            // Truncate to first line only
-            size_t newlinePos = notePreview.find('\n');
-            if (newlinePos != std::string::npos)
-            {
-                notePreview = notePreview.substr(0, newlinePos) + "...";
-            }
-
-            // Truncate if too long (max 50 chars for preview)
-            if (notePreview.length() > 50)
-            {
-                notePreview = notePreview.substr(0, 47) + "...";
-            }
 
-            // Make it selectable to detect clicks, fill the full cell height
-            // Adjust height to account for cell padding (8.0f top + 8.0f bottom = 16.0f)
-            std::string selectableId = "##note_preview_" + std::to_string(i);
-            ImVec4 textColor = metadata.note.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
-            ImGui::PushStyleColor(ImGuiCol_Text, textColor);
-
-            // Disable frame padding for this Selectable to fill the cell properly
-            ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(4.0f, 0.0f));
-            if (ImGui::Selectable(notePreview.c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
-            {
-                // Open note editor modal
-                m_showNoteEditor = true;
-                m_noteEditorItemIndex = i;
-                strncpy_s(m_noteEditorBuffer, sizeof(m_noteEditorBuffer), metadata.note.c_str(), sizeof(m_noteEditorBuffer) - 1);
-                m_noteEditorBuffer[sizeof(m_noteEditorBuffer) - 1] = '\0';
-            }
-            ImGui::PopStyleVar();
-
-            ImGui::PopStyleColor();
+                // Show full note on hover
+                if (ImGui::IsItemHovered() && !metadata.note.empty())
+                {
+                    ImGui::BeginTooltip();
+                    ImGui::PushTextWrapPos(400.0f);
+                    ImGui::TextUnformatted(metadata.note.c_str());
+                    ImGui::PopTextWrapPos();
+                    ImGui::EndTooltip();
+                }
 
-            // Show full note on hover
-            if (ImGui::IsItemHovered() && !metadata.note.empty())
-            {
-                ImGui::BeginTooltip();
-                ImGui::PushTextWrapPos(400.0f);
-                ImGui::TextUnformatted(metadata.note.c_str());
-                ImGui::PopTextWrapPos();
-                ImGui::EndTooltip();
+                ImGui::PopID();
             }
-
-            ImGui::PopID();
         }
 
         ImGui::EndTable();
@@ -1597,4 +1650,11 @@ void AggregatedTrackerView::DrawUnifiedTable()
 
     // Clear rendering flag
     m_isRendering = false;
+
+    // Un-track/Delete from a row's context menu: reload now that the table has ended
+    if (m_needsRefresh)
+    {
+        m_needsRefresh = false;
+        RefreshTrackedItems();
+    }
 }
@@ -64,6 +64,7 @@ private:
     bool m_isOpen = true;
     bool m_isShutdown = false;  // Prevent callbacks during cleanup
     bool m_isRendering = false; // Prevent modifying m_allItems during iteration
+    bool m_needsRefresh = false; // Deferred refresh flag
 
     // Manager dependencies
     UFB::SubscriptionManager* m_subscriptionManager = nullptr;
@@ -78,6 +79,20 @@ private:
     int m_allItemsSortColumn = -1;
     bool m_allItemsSortAscending = true;
 
+    // Display strings for m_allItems rows (same order), rebuilt with the list and after sorting
+    // Dates remember the timestamp they were formatted from, so in-place edits re-format just that cell
+    struct ItemLabels
+    {
+        std::string project;        // UTF-8 job name
+        std::string path;           // UTF-8 path relative to the job (task name for manual tasks)
+        uint64_t dueDate = 0;
+        std::string dueDateText;
+        uint64_t modifiedTime = 0;
+        std::string modifiedText;
+    };
+    std::vector<ItemLabels> m_allItemsLabels;
+    bool m_allItemsLabelsDirty = true;  // Set when m_allItems is re-loaded (which can happen mid-draw)
+
     // Filter state
     std::set<std::wstring> m_filterProjects;        // Selected project names
     std::set<std::string> m_filterTypes;            // Selected types: "shot", "asset", "posting", "manual_task"
@@ -109,6 +124,7 @@ private:
     void ReloadTrackedItems();  // Reload tracked items (called by observer)
     void DrawUnifiedTable();  // Draw single unified table with all items
     void UpdateUnifiedItemsList();  // Combine and filter all items into m_allItems
+    void RebuildItemLabels();  // Format display strings for m_allItems
     bool PassesFilters(const TrackedItemWithProject& item);  // Check if item passes all active filters
     void CollectAvailableFilterValues();  // Collect unique values from all items
     void SortItems(std::vector<TrackedItemWithProject>& items, int column, bool ascending);
@@ -67,6 +67,9 @@ public:
     // Callback for transcoding video files
     std::function<void(const std::vector<std::wstring>&)> onTranscodeToMP4;
 
+    // Callback for copying/moving files into a folder (queued on the copy engine; SHFileOperation when unset)
+    std::function<void(const std::vector<std::wstring>& sources, const std::wstring& destDirectory, bool move)> onCopyFiles;
+
     // Handle external drag-drop from Windows Explorer (delegates to browser panel)
     void HandleExternalDrop(const std::vector<std::wstring>& droppedPaths);
 
@@ -194,4 +197,23 @@ private:
     // Filter helpers
     void CollectAvailableFilterValues();           // Collect unique values from metadata
     bool PassesFilters(const FileEntry& entry);    // Check if entry passes all active filters
+
+    // Assets table rows that pass the filters, in m_assetItems order, with their display strings
+    // Rebuilt only when items, metadata, filters or sort order change; the table draws only the
+    // visible ones through ImGuiListClipper
+    struct AssetRow
+    {
+        int index = 0;          // Index into m_assetItems
+        std::string name;       // UTF-8 name
+        std::string modified;   // Formatted modification time
+    };
+    std::vector<AssetRow> m_assetRows;
+    bool m_assetRowsDirty = true;
+    double m_assetRowsBuiltTime = 0.0;
+    void RebuildAssetRows();
+
+    // Set by context menu actions (paste, delete) while the table's rows are being drawn; the list
+    // is re-read once the table has ended, so a row loop never sees it replaced
+    bool m_reloadItemsPending = false;
+    void RunPendingReloads();
 };
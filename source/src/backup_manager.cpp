@@ -1,5 +1,7 @@
 #include "backup_manager.h"
 #include "utils.h"
+#include "file_hash_service.h"
+#include "xxhash64.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -8,6 +10,7 @@
 #include <thread>
 #include <chrono>
 #include <set>
+#include <algorithm>
 
 namespace UFB {
 
@@ -19,8 +22,25 @@ BackupManager::~BackupManager()
 {
 }
 
-bool BackupManager::CreateBackup(const std::wstring& jobPath)
+bool BackupManager::CreateBackup(const std::wstring& jobPath, bool skipIfUnchanged)
 {
+    std::string checksum = ComputeChecksum(jobPath);
+
+    // Nothing changed since a backup that is still inside the keep-everything window of EvictOldBackups
+    if (skipIfUnchanged && !checksum.empty())
+    {
+        auto backups = ListBackups(jobPath);
+        auto latest = std::max_element(backups.begin(), backups.end(), [](const BackupInfo& a, const BackupInfo& b) {
+            return a.timestamp < b.timestamp;
+        });
+
+        if (latest != backups.end() && latest->checksum == checksum && GetDaysOld(latest->timestamp) < 7)
+        {
+            std::cout << "[Backup] Unchanged since " << WideToUtf8(latest->filename) << ", skipping copy" << std::endl;
+            return UpdateLastBackupDate(jobPath, GetDateString());
+        }
+    }
+
     // Ensure backup directory exists
     std::filesystem::path backupDir = GetBackupDirectory(jobPath);
     if (!EnsureDirectoryExists(backupDir))
@@ -222,6 +242,8 @@ bool BackupManager::CreateBackup(const std::wstring& jobPath)
     backupEntry["created_by"] = info.createdBy;
     backupEntry["shot_count"] = info.shotCount;
     backupEntry["uncompressed_size"] = info.uncompressedSize;
+    if (!checksum.empty())
+        backupEntry["checksum"] = checksum;
 
     metadata["backups"].push_back(backupEntry);
     metadata["last_backup_date"] = WideToUtf8(GetDateString());
@@ -370,6 +392,7 @@ std::vector<BackupInfo> BackupManager::ListBackups(const std::wstring& jobPath)
         info.createdBy = entry.value("created_by", "");
         info.shotCount = entry.value("shot_count", 0);
         info.uncompressedSize = entry.value("uncompressed_size", 0ULL);
+        info.checksum = entry.value("checksum", "");
 
         // Calculate date from timestamp
         std::time_t time = info.timestamp / 1000;
@@ -713,6 +736,13 @@ bool BackupManager::WriteBackupMetadata(const std::wstring& jobPath, const nlohm
     }
 }
 
+bool BackupManager::UpdateLastBackupDate(const std::wstring& jobPath, const std::wstring& date)
+{
+    nlohmann::json metadata = ReadBackupMetadata(jobPath);
+    metadata["last_backup_date"] = WideToUtf8(date);
+    return WriteBackupMetadata(jobPath, metadata);
+}
+
 std::wstring BackupManager::GetDateString()
 {
     std::time_t now = std::time(nullptr);
@@ -809,6 +839,45 @@ bool BackupManager::IsStalelock(const std::filesystem::path& lockFile)
     return age > 300; // 5 minutes
 }
 
+std::string BackupManager::ComputeChecksum(const std::wstring& jobPath)
+{
+    if (!m_hashService)
+        return "";
+
+    // Relative path and content hash of every backed-up file, in a stable order
+    std::vector<std::pair<std::wstring, std::wstring>> files;
+    std::filesystem::path ufbDir = std::filesystem::path(jobPath) / L".ufb";
+    for (const wchar_t* folder : { L"changes", L"tasks" })
+    {
+        std::filesystem::path dir = ufbDir / folder;
+        std::error_code ec;
+        if (!std::filesystem::exists(dir, ec))
+            continue;
+
+        for (auto it = std::filesystem::recursive_directory_iterator(dir, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+        {
+            if (it->is_regular_file(ec))
+                files.emplace_back(std::filesystem::relative(it->path(), ufbDir, ec).wstring(), it->path().wstring());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    XxHash64 combined;
+    for (const auto& file : files)
+    {
+        auto hash = m_hashService->GetHash(file.second);
+        if (!hash)
+            return "";  // Unreadable file: never treat the job as unchanged
+
+        std::string name = WideToUtf8(file.first);
+        combined.Update(reinterpret_cast<const uint8_t*>(name.c_str()), name.size() + 1);
+        combined.Update(reinterpret_cast<const uint8_t*>(&*hash), sizeof(uint64_t));
+    }
+
+    return FileHashService::FormatHash(combined.Digest());
+}
+
 int BackupManager::GetDaysOld(uint64_t timestamp)
 {
     uint64_t now = GetCurrentTimeMs();
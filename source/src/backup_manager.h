@@ -8,6 +8,8 @@
 
 namespace UFB {
 
+class FileHashService;
+
 // JSON validation results
 enum class ValidationResult
 {
@@ -25,7 +27,7 @@ struct BackupInfo
     std::wstring filename;
     std::string createdBy;      // Device ID
     int shotCount = 0;
-    std::string checksum;       // SHA-256 (future)
+    std::string checksum;       // xxHash of the backed-up change logs and tasks (empty without a hash service)
     size_t uncompressedSize = 0;
     std::wstring date;          // Human-readable date (e.g., "2025-10-30")
 };
@@ -36,8 +38,11 @@ public:
     BackupManager();
     ~BackupManager();
 
-    // Backup operations
-    bool CreateBackup(const std::wstring& jobPath);
+    // Content hashes for detecting unchanged backups (optional)
+    void SetHashService(FileHashService* hashService) { m_hashService = hashService; }
+
+    // Backup operations (skipIfUnchanged: no new copy when a recent backup has the same content)
+    bool CreateBackup(const std::wstring& jobPath, bool skipIfUnchanged = false);
     bool ShouldBackupToday(const std::wstring& jobPath);
 
     // Lock coordination
@@ -77,10 +82,13 @@ private:
     int GetDaysOld(uint64_t timestamp);
     bool IsSunday(uint64_t timestamp);
     void UpdateChangeLogTimestamps(const std::filesystem::path& changesDir, uint64_t newTimestamp);
+    std::string ComputeChecksum(const std::wstring& jobPath);
 
     // Compression (future - for now just copy)
     bool CompressFile(const std::filesystem::path& source, const std::filesystem::path& dest);
     bool DecompressFile(const std::filesystem::path& source, const std::filesystem::path& dest);
+
+    FileHashService* m_hashService = nullptr;
 };
 
 } // namespace UFB
@@ -0,0 +1,1080 @@
+#include "copy_engine.h"
+#include "copy_skip.h"
+#include "utils.h"
+#include "xxhash64.h"
+#include "file_hash_service.h"
+#include <shellapi.h>
+#include <filesystem>
+#include <system_error>
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+namespace UFB {
+
+namespace {
+
+// Size of each worker's read/write buffer
+constexpr size_t kBufferSize = 4 * 1024 * 1024;
+
+// Unbuffered I/O needs sector-aligned offsets, sizes and memory (4 KB covers 512e and 4Kn disks)
+constexpr uint64_t kAlignment = 4096;
+
+// Files at least this large are split into chunks that are copied by several workers at once
+constexpr uint64_t kChunkedThreshold = 256ull * 1024 * 1024;
+constexpr uint64_t kChunkSize = 64ull * 1024 * 1024;
+
+// Resume map written next to the partial file of a chunked copy: header, then one byte per chunk
+constexpr uint32_t kMapMagic = 0x50424655;  // "UFBP"
+constexpr uint32_t kMapVersion = 1;
+
+struct MapHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;
+    uint64_t lastWriteTime;
+    uint64_t chunkSize;
+};
+
+uint64_t RoundUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t FileTimeTicks(const FILETIME& time)
+{
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+std::string LastErrorMessage()
+{
+    DWORD code = GetLastError();
+    return std::system_category().message(static_cast<int>(code)) + " (" + std::to_string(code) + ")";
+}
+
+std::wstring JoinPath(const std::wstring& folder, const std::wstring& name)
+{
+    if (!folder.empty() && folder.back() != L'\\' && folder.back() != L'/')
+        return folder + L'\\' + name;
+    return folder + name;
+}
+
+std::wstring TrimSeparators(std::wstring path)
+{
+    while (path.size() > 3 && (path.back() == L'\\' || path.back() == L'/'))
+        path.pop_back();
+    return path;
+}
+
+bool SamePath(const std::wstring& a, const std::wstring& b)
+{
+    std::wstring left = TrimSeparators(a);
+    std::wstring right = TrimSeparators(b);
+    return CompareStringOrdinal(left.c_str(), static_cast<int>(left.size()),
+                                right.c_str(), static_cast<int>(right.size()), TRUE) == CSTR_EQUAL;
+}
+
+// True when path is folder itself or lies anywhere below it
+bool IsInsideFolder(const std::wstring& path, const std::wstring& folder)
+{
+    std::wstring base = TrimSeparators(folder);
+    if (path.size() < base.size())
+        return false;
+    if (CompareStringOrdinal(path.c_str(), static_cast<int>(base.size()),
+                             base.c_str(), static_cast<int>(base.size()), TRUE) != CSTR_EQUAL)
+        return false;
+    return path.size() == base.size() || path[base.size()] == L'\\' || path[base.size()] == L'/';
+}
+
+// "name - Copy.ext", then "name - Copy (2).ext", ... (same naming as Explorer for pastes into the same folder)
+std::wstring MakeCopyName(const std::wstring& path)
+{
+    std::filesystem::path p(path);
+    std::wstring folder = p.parent_path().wstring();
+    std::wstring stem = p.stem().wstring();
+    std::wstring extension = p.extension().wstring();
+
+    for (int i = 1; ; ++i)
+    {
+        std::wstring name = stem + L" - Copy";
+        if (i > 1)
+            name += L" (" + std::to_wstring(i) + L")";
+        std::wstring candidate = JoinPath(folder, name + extension);
+        if (GetFileAttributesW(candidate.c_str()) == INVALID_FILE_ATTRIBUTES)
+            return candidate;
+    }
+}
+
+// "name (2).ext", then "name (3).ext", ... (Explorer's "keep both" naming); folder names are never split
+std::wstring MakeNumberedName(const std::wstring& path, bool isFolder)
+{
+    std::filesystem::path p(path);
+    std::wstring folder = p.parent_path().wstring();
+    std::wstring stem = isFolder ? p.filename().wstring() : p.stem().wstring();
+    std::wstring extension = isFolder ? std::wstring() : p.extension().wstring();
+
+    for (int i = 2; ; ++i)
+    {
+        std::wstring candidate = JoinPath(folder, stem + L" (" + std::to_wstring(i) + L")" + extension);
+        if (GetFileAttributesW(candidate.c_str()) == INVALID_FILE_ATTRIBUTES)
+            return candidate;
+    }
+}
+
+// Open with FILE_FLAG_NO_BUFFERING when asked, falling back to cached I/O where the volume refuses it
+HANDLE OpenForCopy(const std::wstring& path, DWORD access, DWORD disposition, DWORD flags, bool& unbuffered)
+{
+    const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE;
+
+    if (unbuffered)
+    {
+        HANDLE handle = CreateFileW(path.c_str(), access, share, nullptr, disposition,
+                                    flags | FILE_FLAG_NO_BUFFERING, nullptr);
+        if (handle != INVALID_HANDLE_VALUE || GetLastError() != ERROR_INVALID_PARAMETER)
+            return handle;
+        unbuffered = false;
+    }
+
+    return CreateFileW(path.c_str(), access, share, nullptr, disposition, flags, nullptr);
+}
+
+bool ReadAt(HANDLE handle, uint64_t offset, uint8_t* buffer, DWORD size, DWORD& outRead)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    if (ReadFile(handle, buffer, size, &outRead, &overlapped))
+        return true;
+    if (GetLastError() == ERROR_HANDLE_EOF)
+    {
+        outRead = 0;
+        return true;
+    }
+    return false;
+}
+
+bool WriteAt(HANDLE handle, uint64_t offset, const uint8_t* buffer, DWORD size)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD written = 0;
+    return WriteFile(handle, buffer, size, &written, &overlapped) && written == size;
+}
+
+bool SetFileSize(HANDLE handle, uint64_t size)
+{
+    FILE_END_OF_FILE_INFO info = {};
+    info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+    return SetFileInformationByHandle(handle, FileEndOfFileInfo, &info, sizeof(info)) != FALSE;
+}
+
+// Send files and folders to the Recycle Bin in one operation, like the browsers' deletes
+bool RecyclePaths(const std::vector<std::wstring>& paths)
+{
+    std::wstring pathsDoubleNull;
+    for (const auto& path : paths)
+    {
+        pathsDoubleNull += path;
+        pathsDoubleNull.push_back(L'\0');
+    }
+    pathsDoubleNull.push_back(L'\0');
+
+    // Workers don't otherwise use COM, which the shell needs
+    HRESULT hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED | COINIT_DISABLE_OLE1DDE);
+
+    SHFILEOPSTRUCTW fileOp = {};
+    fileOp.wFunc = FO_DELETE;
+    fileOp.pFrom = pathsDoubleNull.c_str();
+    fileOp.fFlags = FOF_ALLOWUNDO | FOF_NO_UI;
+    int result = SHFileOperationW(&fileOp);
+
+    if (SUCCEEDED(hr))
+        CoUninitialize();
+
+    return result == 0 && !fileOp.fAnyOperationsAborted;
+}
+
+} // namespace
+
+struct CopyEngine::FileTask
+{
+    std::wstring source;
+    std::wstring dest;
+    std::wstring partPath;      // dest + ".ufbpart" while copying
+    uint64_t size = 0;
+    FILETIME creationTime = {};
+    FILETIME lastWriteTime = {};
+    DWORD attributes = 0;
+    uint32_t chunkCount = 1;
+    std::atomic<uint32_t> chunksRemaining{0};
+    std::atomic<bool> failed{false};
+    uint64_t contentHash = 0;   // Whole-file hash, known after a verified copy of an unchunked file
+    size_t sourceIndex = 0;     // Top-level source (index into Job::sources) the file belongs to
+    bool replaceExisting = false;   // The user chose to replace a file by this name
+    bool clearReadOnly = false;     // ... and agreed to replace it although it is read-only
+    std::mutex mapMutex;        // Serializes updates of the resume map
+
+    bool IsChunked() const { return chunkCount > 1; }
+    std::wstring MapPath() const { return partPath + L".map"; }
+
+    uint64_t ChunkLength(uint32_t chunk) const
+    {
+        if (!IsChunked())
+            return size;
+        return (std::min)(kChunkSize, size - chunk * kChunkSize);
+    }
+};
+
+struct CopyEngine::Job
+{
+    uint64_t id = 0;
+    std::vector<std::wstring> sources;
+    std::wstring destDirectory;
+    CopyOperation operation = CopyOperation::Copy;
+    CopyOptions options;
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<uint64_t> bytesTotal{0};
+    std::atomic<uint64_t> bytesDone{0};
+    std::atomic<uint32_t> filesTotal{0};
+    std::atomic<uint32_t> filesDone{0};
+    std::atomic<uint32_t> filesSkipped{0};
+    std::atomic<uint32_t> filesKept{0};
+    std::atomic<uint32_t> filesFailed{0};
+    std::atomic<uint32_t> pendingFiles{1};          // Files still copying, plus one while scanning
+
+    std::vector<std::unique_ptr<FileTask>> files;   // Written by the scanning worker only
+
+    // Move: per source, whether it is recycled whole once the job completes (set by the scanning
+    // worker; cleared for sources that were renamed into place or left something behind)
+    std::vector<char> recycleWholeSource;
+
+    std::mutex mutex;                               // Guards the fields below
+    CopyJobProgress::State state = CopyJobProgress::State::Queued;
+    std::wstring currentFile;
+    std::string errorMessage;
+    std::vector<std::pair<size_t, std::wstring>> movedFiles;   // Move: copied files by source index
+};
+
+CopyEngine::CopyEngine(int streamCount)
+    : m_streamCount((std::max)(1, streamCount))
+{
+    m_running = true;
+    for (int i = 0; i < m_streamCount; ++i)
+        m_workers.emplace_back(&CopyEngine::WorkerThread, this);
+}
+
+CopyEngine::~CopyEngine()
+{
+    // Stop running copies at the next buffer (partial files stay for resuming)
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        for (auto& pair : m_jobs)
+            pair.second->cancelled = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_running = false;
+        m_queue.clear();
+    }
+    m_queueCV.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            try
+            {
+                worker.join();
+            }
+            catch (const std::system_error& e)
+            {
+                std::cerr << "[CopyEngine] Thread join error: " << e.what() << std::endl;
+                try { worker.detach(); } catch (...) {}
+            }
+        }
+    }
+}
+
+std::vector<CopyConflict> CopyEngine::FindConflicts(const std::vector<std::wstring>& sources,
+                                                    const std::wstring& destDirectory)
+{
+    std::vector<CopyConflict> conflicts;
+    for (const auto& source : sources)
+    {
+        std::filesystem::path sourcePath(TrimSeparators(source));
+        std::wstring name = sourcePath.filename().wstring();
+        if (name.empty() || SamePath(sourcePath.parent_path().wstring(), destDirectory))
+            continue;
+
+        std::wstring dest = JoinPath(destDirectory, name);
+        DWORD existing = GetFileAttributesW(dest.c_str());
+        if (existing == INVALID_FILE_ATTRIBUTES)
+            continue;
+
+        DWORD attributes = GetFileAttributesW(source.c_str());
+        bool existingIsFolder = (existing & FILE_ATTRIBUTE_DIRECTORY) != 0;
+
+        CopyConflict conflict;
+        conflict.source = source;
+        conflict.dest = dest;
+        conflict.isFolder = existingIsFolder && attributes != INVALID_FILE_ATTRIBUTES &&
+                            (attributes & FILE_ATTRIBUTE_DIRECTORY);
+        conflict.destReadOnly = !existingIsFolder && (existing & FILE_ATTRIBUTE_READONLY);
+        conflicts.push_back(std::move(conflict));
+    }
+    return conflicts;
+}
+
+uint64_t CopyEngine::Submit(const std::vector<std::wstring>& sources, const std::wstring& destDirectory,
+                            CopyOperation operation, const CopyOptions& options)
+{
+    auto job = std::make_shared<Job>();
+    job->sources = sources;
+    job->destDirectory = destDirectory;
+    job->operation = operation;
+    job->options = options;
+    job->recycleWholeSource.assign(sources.size(), 0);
+
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        job->id = m_nextJobId++;
+        m_jobs[job->id] = job;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        WorkItem item;
+        item.job = job;
+        m_queue.push_back(std::move(item));
+    }
+    m_queueCV.notify_one();
+
+    return job->id;
+}
+
+void CopyEngine::Cancel(uint64_t jobId)
+{
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    auto it = m_jobs.find(jobId);
+    if (it != m_jobs.end())
+        it->second->cancelled = true;
+}
+
+bool CopyEngine::GetProgress(uint64_t jobId, CopyJobProgress& outProgress)
+{
+    std::shared_ptr<Job> job;
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        auto it = m_jobs.find(jobId);
+        if (it == m_jobs.end())
+            return false;
+        job = it->second;
+    }
+
+    outProgress.bytesTotal = job->bytesTotal;
+    outProgress.bytesDone = job->bytesDone;
+    outProgress.filesTotal = job->filesTotal;
+    outProgress.filesDone = job->filesDone;
+    outProgress.filesSkipped = job->filesSkipped;
+    outProgress.filesKept = job->filesKept;
+    outProgress.filesFailed = job->filesFailed;
+
+    std::lock_guard<std::mutex> lock(job->mutex);
+    outProgress.state = job->state;
+    outProgress.currentFile = job->currentFile;
+    outProgress.errorMessage = job->errorMessage;
+    return true;
+}
+
+void CopyEngine::Forget(uint64_t jobId)
+{
+    // Queued work keeps its own reference and drains quickly once cancelled
+    std::lock_guard<std::mutex> lock(m_jobsMutex);
+    auto it = m_jobs.find(jobId);
+    if (it != m_jobs.end())
+    {
+        it->second->cancelled = true;
+        m_jobs.erase(it);
+    }
+}
+
+void CopyEngine::WorkerThread()
+{
+    // Page-aligned buffers satisfy the alignment rules of unbuffered I/O
+    uint8_t* buffer = static_cast<uint8_t*>(VirtualAlloc(nullptr, kBufferSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    uint8_t* verifyBuffer = static_cast<uint8_t*>(VirtualAlloc(nullptr, kBufferSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (!buffer || !verifyBuffer)
+    {
+        std::cerr << "[CopyEngine] Failed to allocate copy buffers" << std::endl;
+        if (buffer) VirtualFree(buffer, 0, MEM_RELEASE);
+        if (verifyBuffer) VirtualFree(verifyBuffer, 0, MEM_RELEASE);
+        return;
+    }
+
+    while (m_running)
+    {
+        WorkItem item;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCV.wait(lock, [this] { return !m_queue.empty() || !m_running; });
+
+            if (!m_running)
+                break;
+
+            item = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        if (item.file)
+            CopyChunk(item, buffer, verifyBuffer);
+        else
+            PlanJob(item.job);
+    }
+
+    VirtualFree(buffer, 0, MEM_RELEASE);
+    VirtualFree(verifyBuffer, 0, MEM_RELEASE);
+}
+
+void CopyEngine::PlanJob(const std::shared_ptr<Job>& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->state = CopyJobProgress::State::Scanning;
+    }
+
+    std::vector<WorkItem> items;
+
+    // Chunks are queued folder by folder, so copying starts while large trees are still being scanned
+    auto enqueue = [this, &items]()
+    {
+        if (items.empty())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            for (auto& item : items)
+                m_queue.push_back(std::move(item));
+        }
+        items.clear();
+        m_queueCV.notify_all();
+    };
+
+    for (size_t sourceIndex = 0; sourceIndex < job->sources.size(); ++sourceIndex)
+    {
+        if (job->cancelled)
+            break;
+
+        const std::wstring& source = job->sources[sourceIndex];
+        std::filesystem::path sourcePath(TrimSeparators(source));
+        std::wstring name = sourcePath.filename().wstring();
+        if (name.empty())
+        {
+            SetJobError(*job, "Cannot copy a drive root: " + WideToUtf8(source));
+            continue;
+        }
+
+        // Moving into the folder the item is already in does nothing; copying makes "name - Copy"
+        bool sameFolder = SamePath(sourcePath.parent_path().wstring(), job->destDirectory);
+        if (sameFolder && job->operation == CopyOperation::Move)
+            continue;
+
+        std::wstring dest = JoinPath(job->destDirectory, name);
+        if (sameFolder)
+            dest = MakeCopyName(dest);
+
+        WIN32_FILE_ATTRIBUTE_DATA info;
+        if (!GetFileAttributesExW(source.c_str(), GetFileExInfoStandard, &info))
+        {
+            SetJobError(*job, WideToUtf8(source) + ": " + LastErrorMessage());
+            job->filesFailed++;
+            continue;
+        }
+
+        bool isFolder = (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        if (isFolder && IsInsideFolder(job->destDirectory, source))
+        {
+            SetJobError(*job, "Cannot copy a folder into itself: " + WideToUtf8(source));
+            job->filesFailed++;
+            continue;
+        }
+
+        // Name already taken (reported by FindConflicts before queueing): "keep both" picks a free
+        // name; otherwise a folder merges into the folder there and the policy applies file by file
+        DWORD existing = sameFolder ? INVALID_FILE_ATTRIBUTES : GetFileAttributesW(dest.c_str());
+        if (existing != INVALID_FILE_ATTRIBUTES)
+        {
+            bool existingIsFolder = (existing & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            if (job->options.conflictPolicy == CopyConflictPolicy::KeepBoth)
+            {
+                dest = MakeNumberedName(dest, isFolder);
+            }
+            else if (isFolder && !existingIsFolder)
+            {
+                SetJobError(*job, WideToUtf8(dest) + ": a file with this name already exists");
+                job->filesFailed++;
+                continue;
+            }
+        }
+
+        // A move within one volume is a rename (fails across volumes or onto existing items, then copy + recycle)
+        if (job->operation == CopyOperation::Move && MoveFileExW(source.c_str(), dest.c_str(), 0))
+        {
+            job->filesTotal++;
+            job->filesDone++;
+            continue;
+        }
+
+        if (job->operation == CopyOperation::Move)
+            job->recycleWholeSource[sourceIndex] = 1;
+
+        if (!isFolder)
+        {
+            AddFile(job, sourceIndex, source, dest, info, items);
+            enqueue();
+            continue;
+        }
+
+        // Walk the folder depth first, recreating it at the destination
+        std::vector<std::pair<std::wstring, std::wstring>> folders = { { source, dest } };
+        while (!folders.empty() && !job->cancelled)
+        {
+            auto [folderSource, folderDest] = std::move(folders.back());
+            folders.pop_back();
+
+            if (!CreateDirectoryW(folderDest.c_str(), nullptr))
+            {
+                if (GetLastError() != ERROR_ALREADY_EXISTS)
+                {
+                    SetJobError(*job, WideToUtf8(folderDest) + ": " + LastErrorMessage());
+                    continue;
+                }
+
+                DWORD existing = GetFileAttributesW(folderDest.c_str());
+                if (existing == INVALID_FILE_ATTRIBUTES || !(existing & FILE_ATTRIBUTE_DIRECTORY))
+                {
+                    SetJobError(*job, WideToUtf8(folderDest) + ": a file with this name already exists");
+                    continue;
+                }
+            }
+
+            WIN32_FIND_DATAW data;
+            HANDLE find = FindFirstFileExW(JoinPath(folderSource, L"*").c_str(), FindExInfoBasic, &data,
+                                           FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+            if (find == INVALID_HANDLE_VALUE)
+            {
+                SetJobError(*job, WideToUtf8(folderSource) + ": " + LastErrorMessage());
+                continue;
+            }
+
+            do
+            {
+                const wchar_t* childName = data.cFileName;
+                if (childName[0] == L'.' && (childName[1] == L'\0' || (childName[1] == L'.' && childName[2] == L'\0')))
+                    continue;
+
+                std::wstring childSource = JoinPath(folderSource, childName);
+                std::wstring childDest = JoinPath(folderDest, childName);
+
+                if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                {
+                    folders.emplace_back(std::move(childSource), std::move(childDest));
+                }
+                else
+                {
+                    WIN32_FILE_ATTRIBUTE_DATA childInfo = {};
+                    childInfo.dwFileAttributes = data.dwFileAttributes;
+                    childInfo.ftCreationTime = data.ftCreationTime;
+                    childInfo.ftLastAccessTime = data.ftLastAccessTime;
+                    childInfo.ftLastWriteTime = data.ftLastWriteTime;
+                    childInfo.nFileSizeHigh = data.nFileSizeHigh;
+                    childInfo.nFileSizeLow = data.nFileSizeLow;
+                    AddFile(job, sourceIndex, childSource, childDest, childInfo, items);
+                }
+            } while (FindNextFileW(find, &data) && !job->cancelled);
+
+            FindClose(find);
+            enqueue();
+        }
+    }
+
+    enqueue();
+
+    // Drop the scanning reference; finishes the job here if nothing was left to copy
+    FinishFile(*job);
+}
+
+void CopyEngine::AddFile(const std::shared_ptr<Job>& job, size_t sourceIndex, const std::wstring& source,
+                         const std::wstring& dest, const WIN32_FILE_ATTRIBUTE_DATA& info, std::vector<WorkItem>& outItems)
+{
+    uint64_t size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    job->filesTotal++;
+    job->bytesTotal += size;
+
+    WIN32_FILE_ATTRIBUTE_DATA destInfo;
+    bool destExists = GetFileAttributesExW(dest.c_str(), GetFileExInfoStandard, &destInfo) != FALSE;
+    bool destIsFile = destExists && !(destInfo.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+
+    // Unchanged file already at the destination (also lets a re-queued folder copy pick up where it stopped).
+    // With a hash service, a same-size file touched since (re-saved, copied by another tool) is also
+    // skipped when both cached hashes match
+    if (destIsFile)
+    {
+        FileStamp sourceStamp = { size, FileTimeTicks(info.ftLastWriteTime) };
+        FileStamp destStamp = { (static_cast<uint64_t>(destInfo.nFileSizeHigh) << 32) | destInfo.nFileSizeLow,
+                                FileTimeTicks(destInfo.ftLastWriteTime) };
+        auto lookupHash = [this](const std::wstring& path, const FileStamp& stamp) -> std::optional<uint64_t> {
+            if (!m_hashService)
+                return std::nullopt;
+            return m_hashService->GetCachedHash(path, stamp.size, stamp.lastWriteTime);
+        };
+
+        if (IsUnchangedAtDestination(source, sourceStamp, dest, destStamp, lookupHash))
+        {
+            job->filesSkipped++;
+            job->bytesDone += size;
+            RecordMovedFile(*job, sourceIndex, source);
+            return;
+        }
+    }
+
+    // A different file by this name: the policy the user picked decides, read-only files need their
+    // own consent, and anything left alone keeps its source
+    std::wstring target = dest;
+    bool replace = false;
+    bool clearReadOnly = false;
+    if (destExists)
+    {
+        bool readOnly = (destInfo.dwFileAttributes & FILE_ATTRIBUTE_READONLY) != 0;
+        CopyConflictPolicy policy = job->options.conflictPolicy;
+
+        if (!destIsFile)
+        {
+            SetJobError(*job, WideToUtf8(dest) + ": a folder with this name already exists");
+            job->filesFailed++;
+            return;
+        }
+        if (policy == CopyConflictPolicy::KeepBoth)
+        {
+            target = MakeNumberedName(dest, false);
+        }
+        else if (policy == CopyConflictPolicy::Replace && (!readOnly || job->options.replaceReadOnly))
+        {
+            replace = true;
+            clearReadOnly = readOnly;
+        }
+        else
+        {
+            job->filesKept++;
+            job->bytesDone += size;
+            job->recycleWholeSource[sourceIndex] = 0;
+            return;
+        }
+    }
+
+    auto file = std::make_unique<FileTask>();
+    file->source = source;
+    file->dest = target;
+    file->partPath = target + L".ufbpart";
+    file->sourceIndex = sourceIndex;
+    file->replaceExisting = replace;
+    file->clearReadOnly = clearReadOnly;
+    file->size = size;
+    file->creationTime = info.ftCreationTime;
+    file->lastWriteTime = info.ftLastWriteTime;
+    file->attributes = info.dwFileAttributes;
+    file->chunkCount = size >= kChunkedThreshold ? static_cast<uint32_t>((size + kChunkSize - 1) / kChunkSize) : 1;
+
+    std::vector<uint8_t> doneChunks(file->chunkCount, 0);
+
+    if (file->IsChunked())
+    {
+        // Resume from an earlier partial copy of the same source, if its map still matches
+        MapHeader expected = { kMapMagic, kMapVersion, size, FileTimeTicks(info.ftLastWriteTime), kChunkSize };
+        bool resumed = false;
+
+        WIN32_FILE_ATTRIBUTE_DATA partInfo;
+        HANDLE map = CreateFileW(file->MapPath().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, 0, nullptr);
+        if (map != INVALID_HANDLE_VALUE)
+        {
+            MapHeader header = {};
+            DWORD read = 0;
+            if (ReadFile(map, &header, sizeof(header), &read, nullptr) && read == sizeof(header) &&
+                memcmp(&header, &expected, sizeof(header)) == 0 &&
+                ReadFile(map, doneChunks.data(), file->chunkCount, &read, nullptr) && read == file->chunkCount &&
+                GetFileAttributesExW(file->partPath.c_str(), GetFileExInfoStandard, &partInfo) &&
+                ((static_cast<uint64_t>(partInfo.nFileSizeHigh) << 32) | partInfo.nFileSizeLow) >= size)
+            {
+                resumed = true;
+            }
+            CloseHandle(map);
+        }
+
+        if (!resumed)
+        {
+            std::fill(doneChunks.begin(), doneChunks.end(), 0);
+
+            // Full-size partial file up front, so the chunk writers never extend it concurrently
+            HANDLE part = CreateFileW(file->partPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, 0, nullptr);
+            bool created = part != INVALID_HANDLE_VALUE && SetFileSize(part, size);
+            if (part != INVALID_HANDLE_VALUE)
+                CloseHandle(part);
+
+            map = created ? CreateFileW(file->MapPath().c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                        FILE_ATTRIBUTE_HIDDEN, nullptr)
+                          : INVALID_HANDLE_VALUE;
+            DWORD written = 0;
+            bool mapped = map != INVALID_HANDLE_VALUE &&
+                          WriteFile(map, &expected, sizeof(expected), &written, nullptr) &&
+                          WriteFile(map, doneChunks.data(), file->chunkCount, &written, nullptr);
+            if (map != INVALID_HANDLE_VALUE)
+                CloseHandle(map);
+
+            if (!mapped)
+            {
+                SetJobError(*job, WideToUtf8(target) + ": " + LastErrorMessage());
+                job->filesFailed++;
+                return;
+            }
+        }
+    }
+
+    uint32_t remaining = 0;
+    for (uint32_t chunk = 0; chunk < file->chunkCount; ++chunk)
+    {
+        if (doneChunks[chunk])
+            job->bytesDone += file->ChunkLength(chunk);
+        else
+            remaining++;
+    }
+
+    FileTask* task = file.get();
+    task->chunksRemaining = remaining;
+    job->files.push_back(std::move(file));
+    job->pendingFiles++;
+
+    // Every chunk was already copied (stopped just before the final rename)
+    if (remaining == 0)
+    {
+        FinalizeFile(*job, *task);
+        return;
+    }
+
+    for (uint32_t chunk = 0; chunk < task->chunkCount; ++chunk)
+    {
+        if (doneChunks[chunk])
+            continue;
+
+        WorkItem item;
+        item.job = job;
+        item.file = task;
+        item.chunk = chunk;
+        outItems.push_back(std::move(item));
+    }
+}
+
+void CopyEngine::CopyChunk(const WorkItem& item, uint8_t* buffer, uint8_t* verifyBuffer)
+{
+    Job& job = *item.job;
+    FileTask& file = *item.file;
+
+    if (job.cancelled || file.failed)
+    {
+        file.failed = true;
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.state = CopyJobProgress::State::Copying;
+            job.currentFile = file.dest;
+        }
+
+        std::string error;
+        uint64_t offset = item.chunk * kChunkSize;
+        if (CopyRange(job, file, offset, file.ChunkLength(item.chunk), buffer, verifyBuffer, error))
+        {
+            if (file.IsChunked())
+            {
+                // Record the chunk so a later run of the same copy skips it
+                std::lock_guard<std::mutex> lock(file.mapMutex);
+                HANDLE map = CreateFileW(file.MapPath().c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+                if (map != INVALID_HANDLE_VALUE)
+                {
+                    const uint8_t done = 1;
+                    WriteAt(map, sizeof(MapHeader) + item.chunk, &done, 1);
+                    CloseHandle(map);
+                }
+            }
+        }
+        else
+        {
+            file.failed = true;
+            if (!job.cancelled)
+                SetJobError(job, WideToUtf8(file.source) + ": " + error);
+        }
+    }
+
+    if (file.chunksRemaining.fetch_sub(1) == 1)
+        FinalizeFile(job, file);
+}
+
+bool CopyEngine::CopyRange(Job& job, FileTask& file, uint64_t offset, uint64_t length,
+                           uint8_t* buffer, uint8_t* verifyBuffer, std::string& outError)
+{
+    bool sourceUnbuffered = true;
+    HANDLE source = OpenForCopy(file.source, GENERIC_READ, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, sourceUnbuffered);
+    if (source == INVALID_HANDLE_VALUE)
+    {
+        outError = LastErrorMessage();
+        return false;
+    }
+
+    // Chunked files were created at full size when the job was scanned
+    bool destUnbuffered = true;
+    HANDLE dest = OpenForCopy(file.partPath, GENERIC_WRITE, file.IsChunked() ? OPEN_EXISTING : CREATE_ALWAYS,
+                              0, destUnbuffered);
+    if (dest == INVALID_HANDLE_VALUE)
+    {
+        outError = LastErrorMessage();
+        CloseHandle(source);
+        return false;
+    }
+
+    XxHash64 sourceHash;
+    uint64_t copied = 0;
+    bool ok = true;
+
+    while (copied < length)
+    {
+        if (job.cancelled)
+        {
+            outError = "Cancelled";
+            ok = false;
+            break;
+        }
+
+        uint64_t want = std::min<uint64_t>(kBufferSize, length - copied);
+        DWORD request = static_cast<DWORD>(sourceUnbuffered ? RoundUp(want, kAlignment) : want);
+        DWORD read = 0;
+        if (!ReadAt(source, offset + copied, buffer, request, read))
+        {
+            outError = LastErrorMessage();
+            ok = false;
+            break;
+        }
+
+        read = static_cast<DWORD>(std::min<uint64_t>(read, want));
+        if (read == 0)
+        {
+            outError = "Source file changed during copy";
+            ok = false;
+            break;
+        }
+
+        // Unbuffered writes are rounded up to whole sectors; the file is trimmed to size when finalized
+        DWORD writeSize = static_cast<DWORD>(destUnbuffered ? RoundUp(read, kAlignment) : read);
+        if (!WriteAt(dest, offset + copied, buffer, writeSize))
+        {
+            outError = LastErrorMessage();
+            ok = false;
+            break;
+        }
+
+        if (job.options.verify)
+            sourceHash.Update(buffer, read);
+
+        copied += read;
+        job.bytesDone += read;
+    }
+
+    // The resume map may only claim chunks that are on disk
+    if (ok && file.IsChunked() && !FlushFileBuffers(dest))
+    {
+        outError = LastErrorMessage();
+        ok = false;
+    }
+
+    CloseHandle(dest);
+    CloseHandle(source);
+
+    // Read the range back from the destination and compare hashes
+    if (ok && job.options.verify)
+    {
+        bool verifyUnbuffered = true;
+        HANDLE check = OpenForCopy(file.partPath, GENERIC_READ, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, verifyUnbuffered);
+        if (check == INVALID_HANDLE_VALUE)
+        {
+            outError = LastErrorMessage();
+            ok = false;
+        }
+        else
+        {
+            XxHash64 destHash;
+            uint64_t checked = 0;
+            while (ok && checked < length)
+            {
+                uint64_t want = std::min<uint64_t>(kBufferSize, length - checked);
+                DWORD request = static_cast<DWORD>(verifyUnbuffered ? RoundUp(want, kAlignment) : want);
+                DWORD read = 0;
+                if (!ReadAt(check, offset + checked, verifyBuffer, request, read) || read == 0)
+                {
+                    outError = "Verification read failed";
+                    ok = false;
+                    break;
+                }
+                read = static_cast<DWORD>(std::min<uint64_t>(read, want));
+                destHash.Update(verifyBuffer, read);
+                checked += read;
+            }
+            CloseHandle(check);
+
+            if (ok && destHash.Digest() != sourceHash.Digest())
+            {
+                outError = "Verification failed: destination does not match source";
+                ok = false;
+            }
+            else if (ok && !file.IsChunked())
+            {
+                file.contentHash = sourceHash.Digest();
+            }
+        }
+    }
+
+    if (!ok)
+        job.bytesDone -= copied;
+
+    return ok;
+}
+
+void CopyEngine::FinalizeFile(Job& job, FileTask& file)
+{
+    if (file.failed)
+    {
+        // Partial file and map stay behind for resuming
+        if (!job.cancelled)
+            job.filesFailed++;
+        FinishFile(job);
+        return;
+    }
+
+    // Trim the sector padding and carry over the source timestamps
+    bool ok = false;
+    HANDLE part = CreateFileW(file.partPath.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (part != INVALID_HANDLE_VALUE)
+    {
+        ok = SetFileSize(part, file.size) &&
+             SetFileTime(part, &file.creationTime, nullptr, &file.lastWriteTime);
+        CloseHandle(part);
+    }
+
+    if (ok)
+    {
+        // Only a replace the user asked for overwrites; a read-only file would refuse the rename
+        if (file.clearReadOnly)
+        {
+            DWORD existing = GetFileAttributesW(file.dest.c_str());
+            if (existing != INVALID_FILE_ATTRIBUTES && (existing & FILE_ATTRIBUTE_READONLY))
+                SetFileAttributesW(file.dest.c_str(), existing & ~FILE_ATTRIBUTE_READONLY);
+        }
+
+        ok = MoveFileExW(file.partPath.c_str(), file.dest.c_str(),
+                         file.replaceExisting ? MOVEFILE_REPLACE_EXISTING : 0) != FALSE;
+    }
+
+    if (!ok)
+    {
+        SetJobError(job, WideToUtf8(file.dest) + ": " + LastErrorMessage());
+        job.filesFailed++;
+        FinishFile(job);
+        return;
+    }
+
+    if (file.IsChunked())
+        DeleteFileW(file.MapPath().c_str());
+
+    DWORD attributes = file.attributes & (FILE_ATTRIBUTE_READONLY | FILE_ATTRIBUTE_HIDDEN |
+                                          FILE_ATTRIBUTE_SYSTEM | FILE_ATTRIBUTE_ARCHIVE);
+    if (attributes != 0)
+        SetFileAttributesW(file.dest.c_str(), attributes);
+
+    // A verified copy has hashed the whole file already; both sides now share it
+    if (m_hashService && job.options.verify && !file.IsChunked())
+    {
+        uint64_t lastWriteTime = FileTimeTicks(file.lastWriteTime);
+        m_hashService->StoreHash(file.dest, file.size, lastWriteTime, file.contentHash);
+        if (job.operation == CopyOperation::Copy)
+            m_hashService->StoreHash(file.source, file.size, lastWriteTime, file.contentHash);
+    }
+
+    RecordMovedFile(job, file.sourceIndex, file.source);
+
+    job.filesDone++;
+    FinishFile(job);
+}
+
+void CopyEngine::FinishFile(Job& job)
+{
+    if (job.pendingFiles.fetch_sub(1) == 1)
+        FinishJob(job);
+}
+
+void CopyEngine::FinishJob(Job& job)
+{
+    // A move recycles its sources only once everything was copied: whole items where nothing was
+    // left behind, otherwise just the files that made it across
+    if (job.operation == CopyOperation::Move && !job.cancelled && job.filesFailed == 0)
+    {
+        std::vector<std::wstring> recycle;
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (job.errorMessage.empty())
+            {
+                for (size_t i = 0; i < job.sources.size(); ++i)
+                {
+                    if (job.recycleWholeSource[i])
+                        recycle.push_back(job.sources[i]);
+                }
+                for (const auto& [sourceIndex, path] : job.movedFiles)
+                {
+                    if (!job.recycleWholeSource[sourceIndex])
+                        recycle.push_back(path);
+                }
+            }
+        }
+
+        if (!recycle.empty() && !RecyclePaths(recycle))
+            SetJobError(job, "Copied but could not move the sources to the Recycle Bin");
+    }
+
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (job.cancelled)
+        job.state = CopyJobProgress::State::Cancelled;
+    else if (job.filesFailed > 0 || !job.errorMessage.empty())
+        job.state = CopyJobProgress::State::Failed;
+    else
+        job.state = CopyJobProgress::State::Completed;
+    job.currentFile.clear();
+}
+
+void CopyEngine::RecordMovedFile(Job& job, size_t sourceIndex, const std::wstring& source)
+{
+    if (job.operation != CopyOperation::Move)
+        return;
+
+    std::lock_guard<std::mutex> lock(job.mutex);
+    job.movedFiles.emplace_back(sourceIndex, source);
+}
+
+void CopyEngine::SetJobError(Job& job, const std::string& message)
+{
+    std::cerr << "[CopyEngine] " << message << std::endl;
+
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (job.errorMessage.empty())
+        job.errorMessage = message;
+}
+
+} // namespace UFB
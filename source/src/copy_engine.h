@@ -0,0 +1,160 @@
+#pragma once
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+
+namespace UFB {
+
+class FileHashService;
+
+enum class CopyOperation
+{
+    Copy,
+    Move
+};
+
+// What to do when a file's name is already taken at the destination (asked before the job is queued)
+enum class CopyConflictPolicy
+{
+    Skip,           // Leave the existing file; a move also leaves its source
+    KeepBoth,       // Copy under a free name, "name (2).ext"
+    Replace         // Overwrite the existing file
+};
+
+// An item whose name is already taken at the destination
+struct CopyConflict
+{
+    std::wstring source;
+    std::wstring dest;
+    bool isFolder = false;      // Folder onto folder: merged, the policy then applies to each file inside
+    bool destReadOnly = false;
+};
+
+struct CopyOptions
+{
+    bool verify = false;
+    CopyConflictPolicy conflictPolicy = CopyConflictPolicy::Skip;
+    bool replaceReadOnly = false;   // Replace also overwrites read-only files (otherwise they are kept)
+};
+
+// Snapshot of one copy job, copied out for the UI
+struct CopyJobProgress
+{
+    enum class State
+    {
+        Queued,
+        Scanning,       // Walking the source folders
+        Copying,
+        Completed,
+        Failed,
+        Cancelled
+    };
+
+    State state = State::Queued;
+    uint64_t bytesTotal = 0;
+    uint64_t bytesDone = 0;
+    uint32_t filesTotal = 0;
+    uint32_t filesDone = 0;
+    uint32_t filesSkipped = 0;  // Already at the destination with the same size and modification time
+    uint32_t filesKept = 0;     // A different file by that name was left in place (Skip, or read-only)
+    uint32_t filesFailed = 0;
+    std::wstring currentFile;
+    std::string errorMessage;   // First error of the job
+};
+
+// Copies and moves files on a pool of worker threads instead of SHFileOperation
+//
+// - Several files are copied at once, and large files are split into chunks that are copied in parallel
+// - Reads and writes bypass the system cache with large aligned buffers (falls back to buffered I/O
+//   where the volume refuses unbuffered handles)
+// - Files are written to "<name>.ufbpart" and renamed into place when complete. Large files also keep a
+//   "<name>.ufbpart.map" of finished chunks, so a cancelled or failed copy resumes where it stopped when
+//   the same copy is queued again
+// - Optionally every chunk is read back from the destination and compared by 64-bit xxHash
+// - Existing destination files with the same size and modification time are skipped (or, with a hash
+//   service, the same size and the same cached content hash). Other existing files are only replaced
+//   when the job's conflict policy says so
+// - A move removes its sources through the Recycle Bin, and only once every file has been copied
+class CopyEngine
+{
+public:
+    explicit CopyEngine(int streamCount = 4);
+    ~CopyEngine();
+
+    // Top-level items whose name is already taken in destDirectory (pastes into their own folder
+    // make "name - Copy" and never conflict). Call before Submit to ask the user for a policy
+    static std::vector<CopyConflict> FindConflicts(const std::vector<std::wstring>& sources,
+                                                   const std::wstring& destDirectory);
+
+    // Queue a copy or move of files and folders into destDirectory, returns the job id
+    uint64_t Submit(const std::vector<std::wstring>& sources, const std::wstring& destDirectory,
+                    CopyOperation operation, const CopyOptions& options);
+
+    // Stop a job (partial files are kept so the copy can resume)
+    void Cancel(uint64_t jobId);
+
+    // Get the current state of a job (returns false for unknown jobs)
+    bool GetProgress(uint64_t jobId, CopyJobProgress& outProgress);
+
+    // Drop a job's state (cancels it if it is still running)
+    void Forget(uint64_t jobId);
+
+    // Share content hashes with the hash service (optional; set before submitting jobs)
+    void SetHashService(FileHashService* hashService) { m_hashService = hashService; }
+
+private:
+    struct Job;
+    struct FileTask;
+
+    // One unit of work: scanning a job, or copying one chunk of one file
+    struct WorkItem
+    {
+        std::shared_ptr<Job> job;
+        FileTask* file = nullptr;   // nullptr = scan the job's sources
+        uint32_t chunk = 0;
+    };
+
+    void WorkerThread();
+
+    // Scan sources, create destination folders and queue the chunks of every file
+    void PlanJob(const std::shared_ptr<Job>& job);
+    void AddFile(const std::shared_ptr<Job>& job, size_t sourceIndex, const std::wstring& source,
+                 const std::wstring& dest, const WIN32_FILE_ATTRIBUTE_DATA& info, std::vector<WorkItem>& outItems);
+
+    // Copy one chunk (using the worker's buffers), finalize the file after its last chunk
+    void CopyChunk(const WorkItem& item, uint8_t* buffer, uint8_t* verifyBuffer);
+    bool CopyRange(Job& job, FileTask& file, uint64_t offset, uint64_t length,
+                   uint8_t* buffer, uint8_t* verifyBuffer, std::string& outError);
+    void FinalizeFile(Job& job, FileTask& file);
+    void FinishFile(Job& job);
+    void FinishJob(Job& job);
+
+    // Note a file of a move as copied; its source is recycled when the job completes
+    void RecordMovedFile(Job& job, size_t sourceIndex, const std::wstring& source);
+
+    void SetJobError(Job& job, const std::string& message);
+
+    int m_streamCount;
+    FileHashService* m_hashService = nullptr;
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_running{false};
+
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCV;
+    std::deque<WorkItem> m_queue;
+
+    std::mutex m_jobsMutex;
+    std::map<uint64_t, std::shared_ptr<Job>> m_jobs;
+    uint64_t m_nextJobId = 1;
+};
+
+} // namespace UFB
@@ -0,0 +1,600 @@
+#include "copy_queue_panel.h"
+#include "utils.h"
+#include "imgui.h"
+#include <filesystem>
+#include <sstream>
+#include <random>
+#include <algorithm>
+#include <windows.h>
+
+// Undefine Windows macros that conflict with our method names
+#ifdef AddJob
+#undef AddJob
+#endif
+
+namespace fs = std::filesystem;
+
+// Helper to get Windows accent color (global function from main.cpp)
+extern ImVec4 GetWindowsAccentColor();
+
+// Mono font from main.cpp
+extern ImFont* font_mono;
+
+namespace UFB {
+
+// Parallel copy streams of the engine (files and chunks of large files)
+static constexpr int kCopyStreams = 4;
+
+// Helper: Format a byte count for display
+static std::string FormatBytes(double bytes) {
+    const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        unit++;
+    }
+    char text[32];
+    snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+    return text;
+}
+
+// CopyJob helper methods
+std::wstring CopyJob::GetDisplayName() const {
+    if (sources.empty()) return L"";
+    std::wstring name = fs::path(sources[0]).filename().wstring();
+    if (sources.size() > 1) {
+        name += L" + " + std::to_wstring(sources.size() - 1) + L" more";
+    }
+    return name;
+}
+
+const char* CopyJob::GetStatusString() const {
+    bool move = (operation == CopyOperation::Move);
+    switch (progress.state) {
+        case CopyJobProgress::State::Queued: return "Queued";
+        case CopyJobProgress::State::Scanning: return "Scanning";
+        case CopyJobProgress::State::Copying: return move ? "Moving" : "Copying";
+        case CopyJobProgress::State::Completed: return "Completed";
+        case CopyJobProgress::State::Failed: return "Failed";
+        case CopyJobProgress::State::Cancelled: return "Cancelled";
+        default: return "Unknown";
+    }
+}
+
+bool CopyJob::IsFinished() const {
+    return progress.state == CopyJobProgress::State::Completed ||
+           progress.state == CopyJobProgress::State::Failed ||
+           progress.state == CopyJobProgress::State::Cancelled;
+}
+
+float CopyJob::GetElapsedSeconds() const {
+    auto endTime = IsFinished() ? completedTime : std::chrono::system_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - queuedTime);
+    return duration.count() / 1000.0f;
+}
+
+// CopyQueuePanel implementation
+CopyQueuePanel::CopyQueuePanel() {
+}
+
+CopyQueuePanel::~CopyQueuePanel() {
+    // Engine destructor stops running copies (partial files are kept for resuming)
+    m_engine.reset();
+}
+
+CopyEngine& CopyQueuePanel::GetEngine() {
+    if (!m_engine) {
+        m_engine = std::make_unique<CopyEngine>(kCopyStreams);
+        m_engine->SetHashService(m_hashService);
+    }
+    return *m_engine;
+}
+
+void CopyQueuePanel::Render() {
+    if (!m_isOpen) return;
+
+    ImGui::SetNextWindowSize(ImVec2(900, 500), ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Copy Queue", &m_isOpen, ImGuiWindowFlags_None)) {
+        RenderToolbar();
+        ImGui::Separator();
+
+        // Queue table (takes remaining space minus details panel)
+        float availableHeight = ImGui::GetContentRegionAvail().y;
+        float tableHeight = availableHeight - m_detailsPanelHeight - 10.0f;
+
+        ImGui::BeginChild("CopyTableRegion", ImVec2(0, tableHeight), true, ImGuiWindowFlags_NoScrollbar);
+        RenderQueueTable();
+        ImGui::EndChild();
+
+        ImGui::Separator();
+
+        // Details panel at bottom
+        ImGui::BeginChild("CopyDetailsPanel", ImVec2(0, m_detailsPanelHeight), true, ImGuiWindowFlags_NoScrollbar);
+        RenderJobDetailsPanel();
+        ImGui::EndChild();
+    }
+    ImGui::End();
+}
+
+void CopyQueuePanel::RenderToolbar() {
+    bool processing = IsProcessing();
+    ImVec4 accentColor = GetWindowsAccentColor();
+    ImVec4 statusColor = processing ? accentColor : ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+    ImGui::TextColored(statusColor, "STATUS: %s", processing ? "COPYING" : "IDLE");
+    ImGui::SameLine();
+
+    // Statistics and overall throughput
+    size_t active = 0, completed = 0, failed = 0;
+    float totalSpeed = 0.0f;
+    for (const auto& job : m_jobs) {
+        if (!job->IsFinished()) {
+            active++;
+            totalSpeed += job->bytesPerSecond;
+        } else if (job->progress.state == CopyJobProgress::State::Completed) {
+            completed++;
+        } else if (job->progress.state == CopyJobProgress::State::Failed) {
+            failed++;
+        }
+    }
+
+    ImGui::Text(" | Active: %zu  Completed: %zu  Failed: %zu", active, completed, failed);
+    if (processing) {
+        ImGui::SameLine();
+        ImGui::Text(" | %s/s", FormatBytes(totalSpeed).c_str());
+    }
+
+    ImGui::SameLine(ImGui::GetWindowWidth() - 470);
+
+    ImGui::Checkbox("Verify (xxHash)", &m_verifyCopies);
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Read every copied file back and compare it with the source.\nApplies to copies queued after changing it.");
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear Completed", ImVec2(140, 0))) {
+        ClearCompleted();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear All", ImVec2(130, 0))) {
+        ClearAll();
+    }
+}
+
+void CopyQueuePanel::RenderQueueTable() {
+    if (m_jobs.empty()) {
+        ImGui::TextDisabled("No copies in queue");
+        ImGui::TextDisabled("Pasting or dropping files into a browser or view adds them here.");
+        return;
+    }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                           ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+    // Push table colors for subtle borders
+    ImGui::PushStyleColor(ImGuiCol_TableBorderStrong, ImVec4(0.31f, 0.31f, 0.31f, 0.50f));
+    ImGui::PushStyleColor(ImGuiCol_TableBorderLight, ImVec4(0.23f, 0.23f, 0.23f, 0.50f));
+    ImGui::PushStyleColor(ImGuiCol_TableRowBgAlt, ImVec4(1.00f, 1.00f, 1.00f, 0.03f));
+
+    // Push larger cell padding for taller rows
+    ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(8.0f, 8.0f));
+
+    // Actions are applied after the loop (they modify m_jobs)
+    std::string removeJobId;
+    std::string cancelJobId;
+    std::string retryJobId;
+
+    if (ImGui::BeginTable("CopyJobsTable", 5, flags)) {
+        ImGui::TableSetupColumn("Items", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableSetupColumn("Progress", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupColumn("Speed", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        ImVec4 accentColor = GetWindowsAccentColor();
+
+        for (size_t i = 0; i < m_jobs.size(); ++i) {
+            const auto& job = m_jobs[i];
+            const CopyJobProgress& progress = job->progress;
+            ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
+            ImGui::PushID(job->id.c_str());
+
+            bool isSelected = (job->id == m_selectedJobId);
+
+            ImVec4 statusColor;
+            switch (progress.state) {
+                case CopyJobProgress::State::Queued:
+                    statusColor = ImVec4(0.7f, 0.7f, 0.7f, 1.0f);
+                    break;
+                case CopyJobProgress::State::Scanning:
+                case CopyJobProgress::State::Copying:
+                    statusColor = ImVec4(accentColor.x * 1.3f, accentColor.y * 1.3f, accentColor.z * 1.3f, 1.0f);
+                    break;
+                case CopyJobProgress::State::Completed:
+                    statusColor = accentColor;
+                    break;
+                case CopyJobProgress::State::Failed:
+                case CopyJobProgress::State::Cancelled:
+                default:
+                    statusColor = ImVec4(1.0f, 0.3f, 0.3f, 1.0f);
+                    break;
+            }
+
+            // Items column (selectable)
+            ImGui::TableSetColumnIndex(0);
+            std::string nameUtf8 = WideToUtf8(job->GetDisplayName());
+            if (ImGui::Selectable(nameUtf8.c_str(), isSelected,
+                                 ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap,
+                                 ImVec2(0, 35.0f))) {
+                m_selectedJobId = job->id;
+            }
+
+            // Middle-click to open destination in new window
+            if (ImGui::IsItemClicked(ImGuiMouseButton_Middle) && onOpenInNewWindow) {
+                onOpenInNewWindow(job->destDirectory);
+            }
+
+            // Right-click context menu
+            if (ImGui::BeginPopupContextItem()) {
+                if (!job->IsFinished() && ImGui::MenuItem("Cancel")) {
+                    cancelJobId = job->id;
+                }
+                if ((progress.state == CopyJobProgress::State::Failed ||
+                     progress.state == CopyJobProgress::State::Cancelled) && ImGui::MenuItem("Resume")) {
+                    retryJobId = job->id;
+                }
+                if (job->IsFinished() && ImGui::MenuItem("Remove")) {
+                    removeJobId = job->id;
+                }
+                if (ImGui::MenuItem("Open Destination Folder")) {
+                    ShellExecuteW(nullptr, L"open", job->destDirectory.c_str(), nullptr, nullptr, SW_SHOW);
+                }
+                ImGui::EndPopup();
+            }
+
+            // Status column
+            ImGui::TableSetColumnIndex(1);
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextColored(statusColor, "%s", job->GetStatusString());
+
+            // Progress column with accent color
+            ImGui::TableSetColumnIndex(2);
+            if (progress.state == CopyJobProgress::State::Copying ||
+                progress.state == CopyJobProgress::State::Completed ||
+                (progress.state == CopyJobProgress::State::Scanning && progress.bytesTotal > 0)) {
+                float fraction = progress.bytesTotal > 0
+                    ? (float)((double)progress.bytesDone / (double)progress.bytesTotal) : 1.0f;
+                std::string text = FormatBytes((double)progress.bytesDone) + " / " + FormatBytes((double)progress.bytesTotal);
+
+                float cellWidth = ImGui::GetContentRegionAvail().x;
+                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, accentColor);
+                ImGui::ProgressBar(std::clamp(fraction, 0.0f, 1.0f), ImVec2(cellWidth, 35.0f), text.c_str());
+                ImGui::PopStyleColor();
+            } else {
+                ImGui::AlignTextToFramePadding();
+                ImGui::TextDisabled("--");
+            }
+
+            // Speed column
+            ImGui::TableSetColumnIndex(3);
+            ImGui::AlignTextToFramePadding();
+            if (font_mono) ImGui::PushFont(font_mono);
+            if (!job->IsFinished() && job->bytesPerSecond > 0.0f) {
+                ImGui::TextDisabled("%s/s", FormatBytes(job->bytesPerSecond).c_str());
+            } else {
+                ImGui::TextDisabled("--");
+            }
+            if (font_mono) ImGui::PopFont();
+
+            // Time column
+            ImGui::TableSetColumnIndex(4);
+            ImGui::AlignTextToFramePadding();
+            if (font_mono) ImGui::PushFont(font_mono);
+            float elapsed = job->GetElapsedSeconds();
+            ImGui::TextDisabled("%dm %ds", (int)(elapsed / 60.0f), (int)elapsed % 60);
+            if (font_mono) ImGui::PopFont();
+
+            ImGui::PopID();
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::PopStyleVar(); // Pop CellPadding
+    ImGui::PopStyleColor(3); // Pop table colors
+
+    if (!cancelJobId.empty()) CancelJob(cancelJobId);
+    if (!retryJobId.empty()) RetryJob(retryJobId);
+    if (!removeJobId.empty()) RemoveJob(removeJobId);
+}
+
+void CopyQueuePanel::RenderJobDetailsPanel() {
+    CopyJob* selectedJob = m_selectedJobId.empty() ? nullptr : FindJob(m_selectedJobId);
+    if (!selectedJob) {
+        ImGui::TextDisabled("No job selected");
+        return;
+    }
+
+    const CopyJobProgress& progress = selectedJob->progress;
+
+    ImGui::Text("%s %zu item(s)%s", selectedJob->operation == CopyOperation::Move ? "Move" : "Copy",
+                selectedJob->sources.size(), selectedJob->options.verify ? "  (verified)" : "");
+    ImGui::Separator();
+
+    // Destination with "Open in Browser" buttons
+    ImGui::Text("Destination: %s", WideToUtf8(selectedJob->destDirectory).c_str());
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Left Browser##DestLB")) {
+        if (onOpenInLeftBrowser) onOpenInLeftBrowser(selectedJob->destDirectory);
+    }
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Right Browser##DestRB")) {
+        if (onOpenInRightBrowser) onOpenInRightBrowser(selectedJob->destDirectory);
+    }
+    ImGui::SameLine();
+    if (ImGui::SmallButton("New Window##DestNW")) {
+        if (onOpenInNewWindow) onOpenInNewWindow(selectedJob->destDirectory);
+    }
+
+    if (!progress.currentFile.empty()) {
+        ImGui::Text("Current: %s", WideToUtf8(progress.currentFile).c_str());
+    }
+
+    ImGui::Separator();
+
+    ImGui::Text("Status: %s", selectedJob->GetStatusString());
+    ImGui::Text("Files: %u / %u  (skipped unchanged: %u, kept existing: %u, failed: %u)",
+               progress.filesDone + progress.filesSkipped + progress.filesKept, progress.filesTotal,
+               progress.filesSkipped, progress.filesKept, progress.filesFailed);
+
+    float elapsed = selectedJob->GetElapsedSeconds();
+    if (!selectedJob->IsFinished() && selectedJob->bytesPerSecond > 0.0f && progress.bytesTotal > progress.bytesDone) {
+        float remaining = (float)(progress.bytesTotal - progress.bytesDone) / selectedJob->bytesPerSecond;
+        ImGui::Text("Elapsed: %.0fs  |  ETA: %.0fs", elapsed, remaining);
+    } else {
+        ImGui::Text("Time: %.0fs", elapsed);
+    }
+
+    if (!progress.errorMessage.empty()) {
+        ImGui::Separator();
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Error:");
+        ImGui::TextWrapped("%s", progress.errorMessage.c_str());
+    }
+}
+
+void CopyQueuePanel::AddJob(const std::vector<std::wstring>& sources, const std::wstring& destDirectory,
+                            CopyOperation operation, CopyConflictPolicy conflictPolicy, bool replaceReadOnly) {
+    if (sources.empty()) return;
+
+    auto job = std::make_unique<CopyJob>();
+    job->id = GenerateJobId();
+    job->sources = sources;
+    job->destDirectory = destDirectory;
+    job->operation = operation;
+    job->options.verify = m_verifyCopies;
+    job->options.conflictPolicy = conflictPolicy;
+    job->options.replaceReadOnly = replaceReadOnly;
+    job->queuedTime = std::chrono::system_clock::now();
+    job->lastSampleTime = std::chrono::steady_clock::now();
+    job->engineJobId = GetEngine().Submit(sources, destDirectory, operation, job->options);
+
+    m_jobs.push_back(std::move(job));
+    m_isOpen = true;
+}
+
+void CopyQueuePanel::AskAboutConflicts(const std::vector<std::wstring>& sources, const std::wstring& destDirectory,
+                                       CopyOperation operation, std::vector<CopyConflict> conflicts) {
+    if (conflicts.empty()) {
+        AddJob(sources, destDirectory, operation);
+        return;
+    }
+
+    PendingCopy pending;
+    pending.sources = sources;
+    pending.destDirectory = destDirectory;
+    pending.operation = operation;
+    pending.conflicts = std::move(conflicts);
+    m_pendingCopies.push_back(std::move(pending));
+}
+
+void CopyQueuePanel::RenderConflictPrompt() {
+    if (m_pendingCopies.empty()) return;
+
+    const char* popupId = "Replace or Skip Files##CopyConflicts";
+    if (!ImGui::IsPopupOpen(popupId)) {
+        ImGui::OpenPopup(popupId);
+        m_replaceReadOnly = false;
+    }
+
+    ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImVec2 center = ImVec2(viewport->WorkPos.x + viewport->WorkSize.x * 0.5f,
+                           viewport->WorkPos.y + viewport->WorkSize.y * 0.5f);
+    ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+
+    if (!ImGui::BeginPopupModal(popupId, NULL, ImGuiWindowFlags_AlwaysAutoResize)) return;
+
+    const PendingCopy& pending = m_pendingCopies.front();
+    bool anyReadOnly = false;
+    for (const auto& conflict : pending.conflicts) {
+        anyReadOnly = anyReadOnly || conflict.destReadOnly;
+    }
+
+    ImGui::Text("%zu item(s) already exist in:", pending.conflicts.size());
+    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.7f, 0.9f, 1.0f, 1.0f));
+    ImGui::TextUnformatted(WideToUtf8(pending.destDirectory).c_str());
+    ImGui::PopStyleColor();
+    ImGui::Spacing();
+
+    float listHeight = (std::min)(pending.conflicts.size(), (size_t)8) * ImGui::GetTextLineHeightWithSpacing() + 8.0f;
+    ImGui::BeginChild("ConflictList", ImVec2(520, listHeight), true);
+    for (const auto& conflict : pending.conflicts) {
+        std::string name = WideToUtf8(fs::path(conflict.dest).filename().wstring());
+        if (conflict.isFolder) {
+            ImGui::Text("%s  (folder, contents are merged)", name.c_str());
+        } else if (conflict.destReadOnly) {
+            ImGui::Text("%s  (read-only)", name.c_str());
+        } else {
+            ImGui::TextUnformatted(name.c_str());
+        }
+    }
+    ImGui::EndChild();
+
+    if (anyReadOnly) {
+        ImGui::Checkbox("Also replace read-only files", &m_replaceReadOnly);
+    }
+    if (pending.operation == CopyOperation::Move) {
+        ImGui::TextDisabled("Skipped files stay in the source folder.");
+    }
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
+    bool decided = false;
+    if (ImGui::Button("Replace", ImVec2(120, 0))) {
+        AddJob(pending.sources, pending.destDirectory, pending.operation, CopyConflictPolicy::Replace, m_replaceReadOnly);
+        decided = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Skip", ImVec2(120, 0))) {
+        AddJob(pending.sources, pending.destDirectory, pending.operation, CopyConflictPolicy::Skip);
+        decided = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Keep Both", ImVec2(120, 0))) {
+        AddJob(pending.sources, pending.destDirectory, pending.operation, CopyConflictPolicy::KeepBoth);
+        decided = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Cancel", ImVec2(120, 0)) || ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+        decided = true;
+    }
+
+    if (decided) {
+        m_pendingCopies.pop_front();
+        ImGui::CloseCurrentPopup();
+    }
+    ImGui::EndPopup();
+}
+
+void CopyQueuePanel::RemoveJob(const std::string& jobId) {
+    CopyJob* job = FindJob(jobId);
+    if (job && m_engine) {
+        m_engine->Forget(job->engineJobId);
+    }
+
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+                                [&jobId](const std::unique_ptr<CopyJob>& job) {
+                                    return job->id == jobId;
+                                }), m_jobs.end());
+
+    if (m_selectedJobId == jobId) {
+        m_selectedJobId.clear();
+    }
+}
+
+void CopyQueuePanel::CancelJob(const std::string& jobId) {
+    CopyJob* job = FindJob(jobId);
+    if (job && m_engine) {
+        m_engine->Cancel(job->engineJobId);
+    }
+}
+
+void CopyQueuePanel::RetryJob(const std::string& jobId) {
+    // Re-queueing the same copy skips finished files and resumes partial ones
+    CopyJob* job = FindJob(jobId);
+    if (!job || !job->IsFinished()) return;
+
+    GetEngine().Forget(job->engineJobId);
+    job->progress = CopyJobProgress();
+    job->bytesPerSecond = 0.0f;
+    job->lastSampleBytes = 0;
+    job->lastSampleTime = std::chrono::steady_clock::now();
+    job->queuedTime = std::chrono::system_clock::now();
+    job->engineJobId = GetEngine().Submit(job->sources, job->destDirectory, job->operation, job->options);
+}
+
+void CopyQueuePanel::ClearCompleted() {
+    for (const auto& job : m_jobs) {
+        if (job->progress.state == CopyJobProgress::State::Completed && m_engine) {
+            m_engine->Forget(job->engineJobId);
+        }
+    }
+
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+                                [](const std::unique_ptr<CopyJob>& job) {
+                                    return job->progress.state == CopyJobProgress::State::Completed;
+                                }), m_jobs.end());
+
+    if (!FindJob(m_selectedJobId)) {
+        m_selectedJobId.clear();
+    }
+}
+
+void CopyQueuePanel::ClearAll() {
+    // Cancels anything still running
+    if (m_engine) {
+        for (const auto& job : m_jobs) {
+            m_engine->Forget(job->engineJobId);
+        }
+    }
+    m_jobs.clear();
+    m_selectedJobId.clear();
+}
+
+bool CopyQueuePanel::IsProcessing() const {
+    for (const auto& job : m_jobs) {
+        if (!job->IsFinished()) return true;
+    }
+    return false;
+}
+
+void CopyQueuePanel::Update() {
+    if (!m_engine) return;
+
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto& job : m_jobs) {
+        if (job->IsFinished()) continue;
+
+        if (!m_engine->GetProgress(job->engineJobId, job->progress)) continue;
+
+        // Smoothed throughput, sampled twice a second
+        float dt = std::chrono::duration<float>(now - job->lastSampleTime).count();
+        if (dt >= 0.5f) {
+            uint64_t done = job->progress.bytesDone;
+            float instant = done > job->lastSampleBytes ? (float)(done - job->lastSampleBytes) / dt : 0.0f;
+            job->bytesPerSecond = job->bytesPerSecond > 0.0f ? job->bytesPerSecond * 0.7f + instant * 0.3f : instant;
+            job->lastSampleBytes = done;
+            job->lastSampleTime = now;
+        }
+
+        if (job->IsFinished()) {
+            job->completedTime = std::chrono::system_clock::now();
+        }
+    }
+}
+
+CopyJob* CopyQueuePanel::FindJob(const std::string& jobId) {
+    for (const auto& job : m_jobs) {
+        if (job->id == jobId) return job.get();
+    }
+    return nullptr;
+}
+
+std::string CopyQueuePanel::GenerateJobId() {
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+    static std::uniform_int_distribution<> dis(0, 15);
+
+    std::stringstream ss;
+    ss << "copy_" << std::hex;
+    for (int i = 0; i < 8; ++i) {
+        ss << dis(gen);
+    }
+    return ss.str();
+}
+
+} // namespace UFB
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "copy_engine.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <functional>
+
+namespace UFB {
+
+// Single copy/move job (one paste or drop)
+struct CopyJob {
+    std::string id;                     // Unique ID
+    uint64_t engineJobId = 0;           // ID in the CopyEngine
+    std::vector<std::wstring> sources;  // Files and folders being copied
+    std::wstring destDirectory;         // Folder they are copied into
+    CopyOperation operation = CopyOperation::Copy;
+    CopyOptions options;                // Verify and conflict policy (kept for Resume)
+    CopyJobProgress progress;           // Latest snapshot from the engine
+
+    // Speed tracking
+    float bytesPerSecond = 0.0f;
+    uint64_t lastSampleBytes = 0;
+    std::chrono::steady_clock::time_point lastSampleTime;
+
+    // Timestamps
+    std::chrono::system_clock::time_point queuedTime;
+    std::chrono::system_clock::time_point completedTime;
+
+    // Helper methods
+    std::wstring GetDisplayName() const;
+    const char* GetStatusString() const;
+    bool IsFinished() const;
+    float GetElapsedSeconds() const;
+};
+
+// Paste or drop waiting for the user to decide about names already taken at the destination
+struct PendingCopy {
+    std::vector<std::wstring> sources;
+    std::wstring destDirectory;
+    CopyOperation operation = CopyOperation::Copy;
+    std::vector<CopyConflict> conflicts;
+};
+
+class CopyQueuePanel {
+public:
+    CopyQueuePanel();
+    ~CopyQueuePanel();
+
+    // Panel control
+    void Show() { m_isOpen = true; }
+    void Hide() { m_isOpen = false; }
+    void Toggle() { m_isOpen = !m_isOpen; }
+    bool IsOpen() const { return m_isOpen; }
+
+    // Main render method
+    void Render();
+
+    // Conflict prompt (call each frame outside any window, even while the panel is closed)
+    void RenderConflictPrompt();
+
+    // Queue operations (shows the panel). Files already at the destination are only replaced when the
+    // policy says so
+    void AddJob(const std::vector<std::wstring>& sources, const std::wstring& destDirectory, CopyOperation operation,
+                CopyConflictPolicy conflictPolicy = CopyConflictPolicy::Skip, bool replaceReadOnly = false);
+
+    // Ask Replace / Skip / Keep Both about conflicts from CopyEngine::FindConflicts, then queue the job
+    void AskAboutConflicts(const std::vector<std::wstring>& sources, const std::wstring& destDirectory,
+                           CopyOperation operation, std::vector<CopyConflict> conflicts);
+    void RemoveJob(const std::string& jobId);
+    void CancelJob(const std::string& jobId);
+    void RetryJob(const std::string& jobId);
+    void ClearCompleted();
+    void ClearAll();
+
+    // Content hash cache shared with the copy engine (optional)
+    void SetHashService(FileHashService* hashService) { m_hashService = hashService; }
+
+    // Queue state
+    bool IsProcessing() const;
+    size_t GetQueueSize() const { return m_jobs.size(); }
+
+    // Update (call each frame)
+    void Update();
+
+    // Callbacks for opening the destination in browsers and views
+    std::function<void(const std::wstring&)> onOpenInLeftBrowser;
+    std::function<void(const std::wstring&)> onOpenInRightBrowser;
+    std::function<void(const std::wstring&)> onOpenInNewWindow;
+
+private:
+    // UI Rendering
+    void RenderToolbar();
+    void RenderQueueTable();
+    void RenderJobDetailsPanel();
+
+    // Helpers
+    CopyEngine& GetEngine();
+    CopyJob* FindJob(const std::string& jobId);
+    std::string GenerateJobId();
+
+    // State
+    bool m_isOpen = false;
+    std::unique_ptr<CopyEngine> m_engine;  // Created on first job (worker threads)
+    FileHashService* m_hashService = nullptr;
+    std::vector<std::unique_ptr<CopyJob>> m_jobs;
+    std::string m_selectedJobId;
+
+    // UI State
+    float m_detailsPanelHeight = 170.0f;
+    bool m_verifyCopies = false;           // Applies to jobs queued afterwards
+    std::deque<PendingCopy> m_pendingCopies;   // Waiting for the conflict prompt, oldest first
+    bool m_replaceReadOnly = false;        // Conflict prompt: Replace also overwrites read-only files
+};
+
+} // namespace UFB
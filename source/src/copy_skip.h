@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace UFB {
+
+// Size and modification time (FILETIME ticks) of a file
+struct FileStamp
+{
+    uint64_t size = 0;
+    uint64_t lastWriteTime = 0;
+};
+
+// Whether an existing destination file already holds the source's content, so a copy can skip it:
+// the same size and modification time, or the same size and the same cached content hash on both sides
+// @param lookupHash - (path, stamp) -> std::optional<uint64_t>, the cached hash of the file in that state
+//                     without reading it (destination is only looked up when the source has one)
+template <typename LookupHash>
+bool IsUnchangedAtDestination(const std::wstring& source, const FileStamp& sourceStamp,
+                              const std::wstring& dest, const FileStamp& destStamp, LookupHash&& lookupHash)
+{
+    if (sourceStamp.size != destStamp.size)
+        return false;
+
+    if (sourceStamp.lastWriteTime == destStamp.lastWriteTime)
+        return true;
+
+    // Same size but touched since (re-saved, copied by another tool)
+    std::optional<uint64_t> sourceHash = lookupHash(source, sourceStamp);
+    if (!sourceHash)
+        return false;
+    std::optional<uint64_t> destHash = lookupHash(dest, destStamp);
+    return destHash && *destHash == *sourceHash;
+}
+
+} // namespace UFB
@@ -0,0 +1,225 @@
+#include "directory_cache.h"
+#include "file_entry.h"
+#include "file_watcher.h"
+#include <algorithm>
+#include <iostream>
+
+namespace UFB {
+
+namespace {
+
+// Each cached directory holds a watch, so keep the count modest
+constexpr size_t kMaxListings = 16;
+
+// Cap total memory (a 200k-frame render folder would otherwise pin everything)
+constexpr size_t kMaxCachedEntries = 200000;
+
+} // namespace
+
+ListingDiff DiffListings(const std::vector<FileEntry>& before, const std::vector<FileEntry>& after)
+{
+    ListingDiff diff;
+
+    std::unordered_map<std::wstring, const FileEntry*> previous;
+    previous.reserve(before.size());
+    for (const auto& entry : before)
+    {
+        previous.emplace(entry.name, &entry);
+    }
+
+    for (const auto& entry : after)
+    {
+        auto it = previous.find(entry.name);
+        if (it == previous.end())
+        {
+            diff.added.push_back(entry.fullPath);
+            continue;
+        }
+
+        const FileEntry& old = *it->second;
+        if (old.isDirectory != entry.isDirectory || old.size != entry.size || old.lastModified != entry.lastModified)
+        {
+            diff.modified.push_back(entry.fullPath);
+        }
+
+        previous.erase(it);
+    }
+
+    for (const auto& [name, entry] : previous)
+    {
+        diff.removed.push_back(entry->fullPath);
+    }
+
+    return diff;
+}
+
+DirectoryCache& DirectoryCache::Get()
+{
+    static DirectoryCache instance;
+    return instance;
+}
+
+DirectoryCache::DirectoryCache()
+    : m_watcher(std::make_unique<FileWatcher>())
+{
+}
+
+DirectoryCache::~DirectoryCache()
+{
+    // Stop watcher threads before the listings they call into go away
+    m_watcher->StopWatching();
+}
+
+std::wstring DirectoryCache::MakeKey(const std::wstring& path)
+{
+    std::wstring key = path;
+    while (key.size() > 3 && (key.back() == L'\\' || key.back() == L'/'))
+        key.pop_back();
+
+    std::transform(key.begin(), key.end(), key.begin(), ::towlower);
+    return key;
+}
+
+bool DirectoryCache::Lookup(const std::wstring& path, bool includeHidden, std::vector<FileEntry>& outEntries, uint64_t& outVersion)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(MakeKey(path));
+    if (it == m_index.end() || it->second->includeHidden != includeHidden)
+        return false;
+
+    // Move to front (most recently used)
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+
+    outEntries = it->second->entries;
+    outVersion = it->second->listedVersion;
+    return true;
+}
+
+void DirectoryCache::Store(const std::wstring& path, bool includeHidden, const std::vector<FileEntry>& entries, uint64_t version)
+{
+    std::wstring key = MakeKey(path);
+    bool startWatching = false;
+    std::vector<std::wstring> evicted;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            CachedListing listing;
+            listing.path = path;
+            listing.version = version;
+            m_lru.push_front(std::move(listing));
+            it = m_index.emplace(key, m_lru.begin()).first;
+        }
+        else
+        {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            m_totalEntries -= it->second->entries.size();
+        }
+
+        CachedListing& listing = *it->second;
+        listing.includeHidden = includeHidden;
+        listing.entries = entries;
+        listing.listedVersion = version;
+        m_totalEntries += entries.size();
+
+        if (!listing.watching)
+        {
+            listing.watching = true;
+            startWatching = true;
+        }
+
+        evicted = EvictLocked();
+    }
+
+    // Watcher calls take the watcher's locks and may join threads that wait on m_mutex
+    for (const auto& evictedPath : evicted)
+    {
+        m_watcher->StopWatchingDirectory(evictedPath);
+    }
+
+    if (startWatching && !m_watcher->WatchDirectory(path, [this, key]() { OnDirectoryChanged(key); }))
+    {
+        // Not watchable (permissions, some network filesystems) - views fall back to manual refresh
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+            it->second->watching = false;
+    }
+}
+
+uint64_t DirectoryCache::GetVersion(const std::wstring& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(MakeKey(path));
+    return (it != m_index.end()) ? it->second->version : 0;
+}
+
+void DirectoryCache::Remove(const std::wstring& path)
+{
+    std::wstring watchedPath;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_index.find(MakeKey(path));
+        if (it == m_index.end())
+            return;
+
+        if (it->second->watching)
+            watchedPath = it->second->path;
+
+        m_totalEntries -= it->second->entries.size();
+        m_lru.erase(it->second);
+        m_index.erase(it);
+    }
+
+    if (!watchedPath.empty())
+        m_watcher->StopWatchingDirectory(watchedPath);
+}
+
+void DirectoryCache::Clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lru.clear();
+        m_index.clear();
+        m_totalEntries = 0;
+    }
+
+    m_watcher->StopWatching();
+}
+
+void DirectoryCache::OnDirectoryChanged(const std::wstring& key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+        it->second->version++;
+}
+
+std::vector<std::wstring> DirectoryCache::EvictLocked()
+{
+    std::vector<std::wstring> evicted;
+
+    // Never evict the listing just stored (front)
+    while (m_lru.size() > 1 && (m_lru.size() > kMaxListings || m_totalEntries > kMaxCachedEntries))
+    {
+        CachedListing& oldest = m_lru.back();
+        if (oldest.watching)
+            evicted.push_back(oldest.path);
+
+        m_totalEntries -= oldest.entries.size();
+        m_index.erase(MakeKey(oldest.path));
+        m_lru.pop_back();
+    }
+
+    return evicted;
+}
+
+} // namespace UFB
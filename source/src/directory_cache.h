@@ -0,0 +1,101 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+struct FileEntry;
+
+namespace UFB {
+
+class FileWatcher;
+
+// Difference between two listings of the same directory (paths)
+struct ListingDiff
+{
+    std::vector<std::wstring> added;
+    std::vector<std::wstring> removed;
+    std::vector<std::wstring> modified;  // Same name, different size/mtime/type
+
+    bool IsEmpty() const { return added.empty() && removed.empty() && modified.empty(); }
+};
+
+// Compare two listings by name
+ListingDiff DiffListings(const std::vector<FileEntry>& before, const std::vector<FileEntry>& after);
+
+// Process-wide LRU cache of recent directory listings, shared by every browser window and shot view
+// Each cached directory is watched (FileWatcher::WatchDirectory); a change bumps the directory's
+// version, which tells the views their listing is stale and should be re-read in the background.
+//
+// Usage:
+//   auto& cache = DirectoryCache::Get();
+//   uint64_t version = cache.GetVersion(path);     // before starting a read
+//   ... read directory ...
+//   cache.Store(path, includeHidden, entries, version);
+//   ...
+//   if (cache.Lookup(path, includeHidden, entries, listedVersion)) show entries instantly;
+//   if (cache.GetVersion(path) != listedVersion) re-read;
+class DirectoryCache
+{
+public:
+    static DirectoryCache& Get();
+
+    DirectoryCache(const DirectoryCache&) = delete;
+    DirectoryCache& operator=(const DirectoryCache&) = delete;
+
+    // Cached listing for path (marks it most recently used)
+    // @param outVersion - directory version the listing was read at (compare with GetVersion)
+    // @return false if path is not cached with the same hidden-file setting
+    bool Lookup(const std::wstring& path, bool includeHidden, std::vector<FileEntry>& outEntries, uint64_t& outVersion);
+
+    // Store a listing and start watching the directory (evicts least recently used listings)
+    // @param version - GetVersion(path) taken before the directory was read, so changes made
+    //                  during the read leave the listing stale instead of being lost
+    void Store(const std::wstring& path, bool includeHidden, const std::vector<FileEntry>& entries, uint64_t version);
+
+    // Current version of a directory; changes whenever the watcher reports a change (0 if not cached)
+    uint64_t GetVersion(const std::wstring& path);
+
+    // Drop one listing (e.g. after a failed read)
+    void Remove(const std::wstring& path);
+
+    // Drop all listings and stop watching
+    void Clear();
+
+private:
+    DirectoryCache();
+    ~DirectoryCache();
+
+    struct CachedListing
+    {
+        std::wstring path;
+        bool includeHidden = false;
+        std::vector<FileEntry> entries;
+        uint64_t listedVersion = 0;   // Version the entries were read at
+        uint64_t version = 0;         // Bumped by the watcher
+        bool watching = false;
+    };
+
+    // Case-insensitive key without trailing separator
+    static std::wstring MakeKey(const std::wstring& path);
+
+    // Called from watcher threads
+    void OnDirectoryChanged(const std::wstring& key);
+
+    // Evict until within limits; returns paths to stop watching (caller unlocks first)
+    std::vector<std::wstring> EvictLocked();
+
+    std::mutex m_mutex;
+    std::list<CachedListing> m_lru;  // Most recently used first
+    std::unordered_map<std::wstring, std::list<CachedListing>::iterator> m_index;
+    size_t m_totalEntries = 0;
+
+    // Watcher callbacks take m_mutex, so the watcher is only called with m_mutex released
+    std::unique_ptr<FileWatcher> m_watcher;
+};
+
+} // namespace UFB
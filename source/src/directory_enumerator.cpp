@@ -0,0 +1,389 @@
+#include "directory_enumerator.h"
+#include "file_entry.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+
+namespace UFB {
+
+namespace {
+
+// Hand entries to the UI every this many entries...
+constexpr size_t kBatchSize = 1024;
+
+// ...or after this long, whichever comes first (keeps slow shares showing progress)
+constexpr auto kBatchInterval = std::chrono::milliseconds(100);
+
+#ifdef _WIN32
+
+// Open a bulk directory read (returns INVALID_HANDLE_VALUE on failure)
+HANDLE BeginFind(const std::wstring& path, WIN32_FIND_DATAW& data)
+{
+    std::wstring pattern = path;
+    if (!pattern.empty() && pattern.back() != L'\\' && pattern.back() != L'/')
+        pattern += L'\\';
+    pattern += L'*';
+
+    // Basic info skips the 8.3 short name; large fetch asks SMB for bigger directory chunks
+    return FindFirstFileExW(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch,
+                            nullptr, FIND_FIRST_EX_LARGE_FETCH);
+}
+
+// Convert one find record; returns false for entries that should not be listed
+bool MakeEntry(const std::wstring& path, const WIN32_FIND_DATAW& data, bool includeHidden, FileEntry& outEntry)
+{
+    const wchar_t* name = data.cFileName;
+
+    // Skip "." and ".."
+    if (name[0] == L'.' && (name[1] == L'\0' || (name[1] == L'.' && name[2] == L'\0')))
+        return false;
+
+    if (!includeHidden && (name[0] == L'.' || (data.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN)))
+        return false;
+
+    outEntry.name = name;
+    outEntry.fullPath = path;
+    if (!outEntry.fullPath.empty() && outEntry.fullPath.back() != L'\\' && outEntry.fullPath.back() != L'/')
+        outEntry.fullPath += L'\\';
+    outEntry.fullPath += outEntry.name;
+
+    outEntry.isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    outEntry.size = outEntry.isDirectory ? 0 :
+        (static_cast<uintmax_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+
+    // file_time_type on MSVC counts 100ns ticks since 1601, same as FILETIME
+    ULARGE_INTEGER ticks;
+    ticks.LowPart = data.ftLastWriteTime.dwLowDateTime;
+    ticks.HighPart = data.ftLastWriteTime.dwHighDateTime;
+    outEntry.lastModified = std::filesystem::file_time_type(
+        std::filesystem::file_time_type::duration(static_cast<int64_t>(ticks.QuadPart)));
+
+    return true;
+}
+
+// One pass over a directory: FindFirstFileExW / FindNextFileW
+class DirectoryReader
+{
+public:
+    DirectoryReader(const std::wstring& path, bool includeHidden)
+        : m_path(path), m_includeHidden(includeHidden)
+    {
+        m_find = BeginFind(path, m_data);
+        m_hasData = (m_find != INVALID_HANDLE_VALUE);
+    }
+
+    ~DirectoryReader()
+    {
+        if (m_find != INVALID_HANDLE_VALUE)
+            FindClose(m_find);
+    }
+
+    DirectoryReader(const DirectoryReader&) = delete;
+    DirectoryReader& operator=(const DirectoryReader&) = delete;
+
+    bool IsOpen() const { return m_find != INVALID_HANDLE_VALUE; }
+
+    // Next listed entry; false at the end of the directory
+    bool Next(FileEntry& outEntry)
+    {
+        while (m_hasData)
+        {
+            bool listed = MakeEntry(m_path, m_data, m_includeHidden, outEntry);
+            m_hasData = FindNextFileW(m_find, &m_data) != FALSE;
+            if (listed)
+                return true;
+        }
+        return false;
+    }
+
+private:
+    std::wstring m_path;
+    bool m_includeHidden;
+    HANDLE m_find = INVALID_HANDLE_VALUE;
+    WIN32_FIND_DATAW m_data;
+    bool m_hasData = false;
+};
+
+#else
+
+// One pass over a directory: readdir, plus an fstatat per entry for size and mtime
+class DirectoryReader
+{
+public:
+    DirectoryReader(const std::wstring& path, bool includeHidden)
+        : m_includeHidden(includeHidden)
+    {
+        m_dir = opendir(std::filesystem::path(path).c_str());
+
+        m_prefix = path;
+        if (!m_prefix.empty() && m_prefix.back() != L'/')
+            m_prefix += L'/';
+    }
+
+    ~DirectoryReader()
+    {
+        if (m_dir)
+            closedir(m_dir);
+    }
+
+    DirectoryReader(const DirectoryReader&) = delete;
+    DirectoryReader& operator=(const DirectoryReader&) = delete;
+
+    bool IsOpen() const { return m_dir != nullptr; }
+
+    // Next listed entry; false at the end of the directory
+    bool Next(FileEntry& outEntry)
+    {
+        if (!m_dir)
+            return false;
+
+        while (dirent* entry = readdir(m_dir))
+        {
+            const char* name = entry->d_name;
+
+            // Skip "." and ".."; dot-files are the hidden files here
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+            if (!m_includeHidden && name[0] == '.')
+                continue;
+
+            // Follow symlinks like Explorer does; a dangling link is listed as itself
+            struct stat info;
+            if (fstatat(dirfd(m_dir), name, &info, 0) != 0 &&
+                fstatat(dirfd(m_dir), name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+                continue;
+
+            outEntry.name = std::filesystem::path(name).wstring();
+            outEntry.fullPath = m_prefix + outEntry.name;
+            outEntry.isDirectory = S_ISDIR(info.st_mode);
+            outEntry.size = outEntry.isDirectory ? 0 : static_cast<uintmax_t>(info.st_size);
+            outEntry.lastModified = std::chrono::file_clock::from_sys(
+                std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::seconds(info.st_mtim.tv_sec) + std::chrono::nanoseconds(info.st_mtim.tv_nsec))));
+            return true;
+        }
+        return false;
+    }
+
+private:
+    std::wstring m_prefix;
+    bool m_includeHidden;
+    DIR* m_dir = nullptr;
+};
+
+#endif
+
+} // namespace
+
+bool ListDirectory(const std::wstring& path, bool includeHidden, std::vector<FileEntry>& outEntries)
+{
+    DirectoryReader reader(path, includeHidden);
+    if (!reader.IsOpen())
+        return false;
+
+    FileEntry entry;
+    while (reader.Next(entry))
+        outEntries.push_back(std::move(entry));
+
+    return true;
+}
+
+DirectoryEnumerator::DirectoryEnumerator()
+{
+}
+
+DirectoryEnumerator::~DirectoryEnumerator()
+{
+    if (!m_running)
+        return;
+
+    // Abandon any enumeration in progress and stop the worker
+    m_generation++;
+    m_running = false;
+    m_jobCV.notify_all();
+
+    if (m_worker.joinable())
+    {
+        try
+        {
+            m_worker.join();
+        }
+        catch (const std::system_error& e)
+        {
+            std::cerr << "[DirectoryEnumerator] Thread join error: " << e.what() << std::endl;
+            try { m_worker.detach(); } catch (...) {}
+        }
+    }
+}
+
+void DirectoryEnumerator::Start(const std::wstring& path, bool includeHidden)
+{
+    // Worker is created on first use (most panels never enumerate off-thread)
+    if (!m_running)
+    {
+        m_running = true;
+        m_worker = std::thread(&DirectoryEnumerator::WorkerThread, this);
+    }
+
+    // New generation and job are set together, so the worker always pairs a job with its own generation
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_generation++;
+        m_jobPath = path;
+        m_jobIncludeHidden = includeHidden;
+        m_hasJob = true;
+    }
+    m_jobCV.notify_one();
+
+    // Drop results of the previous enumeration (the generation bump above stops new ones arriving)
+    {
+        std::lock_guard<std::mutex> lock(m_resultMutex);
+        m_readyEntries.clear();
+        m_readyComplete = false;
+        m_readyFailed = false;
+    }
+
+    m_path = path;
+    m_includeHidden = includeHidden;
+    m_busy = true;
+}
+
+void DirectoryEnumerator::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobMutex);
+        m_generation++;
+        m_hasJob = false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_resultMutex);
+        m_readyEntries.clear();
+        m_readyComplete = false;
+        m_readyFailed = false;
+    }
+
+    m_busy = false;
+}
+
+bool DirectoryEnumerator::Poll(std::vector<FileEntry>& outEntries, bool& outComplete, bool& outFailed)
+{
+    outComplete = false;
+    outFailed = false;
+
+    if (!m_busy)
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_resultMutex);
+    if (m_readyEntries.empty() && !m_readyComplete)
+        return false;
+
+    if (outEntries.empty())
+    {
+        outEntries.swap(m_readyEntries);
+    }
+    else
+    {
+        outEntries.insert(outEntries.end(), std::make_move_iterator(m_readyEntries.begin()),
+                          std::make_move_iterator(m_readyEntries.end()));
+        m_readyEntries.clear();
+    }
+
+    outComplete = m_readyComplete;
+    outFailed = m_readyFailed;
+
+    if (m_readyComplete)
+    {
+        m_readyComplete = false;
+        m_readyFailed = false;
+        m_busy = false;
+    }
+
+    return true;
+}
+
+void DirectoryEnumerator::WorkerThread()
+{
+    while (m_running)
+    {
+        std::wstring path;
+        bool includeHidden = false;
+        uint64_t generation = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_jobMutex);
+            m_jobCV.wait(lock, [this] { return m_hasJob || !m_running; });
+
+            if (!m_running)
+                break;
+
+            path = std::move(m_jobPath);
+            includeHidden = m_jobIncludeHidden;
+            m_hasJob = false;
+
+            generation = m_generation;
+        }
+
+        Enumerate(path, includeHidden, generation);
+    }
+}
+
+void DirectoryEnumerator::Enumerate(const std::wstring& path, bool includeHidden, uint64_t generation)
+{
+    std::vector<FileEntry> batch;
+    batch.reserve(kBatchSize);
+
+    DirectoryReader reader(path, includeHidden);
+    if (!reader.IsOpen())
+    {
+        Publish(batch, generation, true, true);
+        return;
+    }
+
+    auto lastPublish = std::chrono::steady_clock::now();
+
+    FileEntry entry;
+    while (reader.Next(entry))
+    {
+        // Navigated away - stop reading this directory
+        if (m_generation != generation)
+            break;
+
+        batch.push_back(std::move(entry));
+
+        if (batch.size() >= kBatchSize || std::chrono::steady_clock::now() - lastPublish >= kBatchInterval)
+        {
+            Publish(batch, generation, false, false);
+            lastPublish = std::chrono::steady_clock::now();
+        }
+    }
+
+    Publish(batch, generation, true, false);
+}
+
+void DirectoryEnumerator::Publish(std::vector<FileEntry>& entries, uint64_t generation, bool complete, bool failed)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_resultMutex);
+
+        // Checked under the result lock: Start()/Cancel() bump the generation before clearing
+        if (m_generation == generation)
+        {
+            m_readyEntries.insert(m_readyEntries.end(), std::make_move_iterator(entries.begin()),
+                                  std::make_move_iterator(entries.end()));
+            m_readyComplete = m_readyComplete || complete;
+            m_readyFailed = m_readyFailed || failed;
+        }
+    }
+
+    entries.clear();
+}
+
+} // namespace UFB
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+struct FileEntry;
+
+namespace UFB {
+
+// Read a directory in one bulk pass (FindFirstFileExW with large fetch; readdir elsewhere)
+// On Windows name, size, mtime and attributes all come from the directory read itself, so there
+// are no per-entry stat calls (each one is a network round trip on SMB shares).
+// @param includeHidden - if false, skips dot-files and entries with FILE_ATTRIBUTE_HIDDEN
+// @return false if the directory could not be opened
+bool ListDirectory(const std::wstring& path, bool includeHidden, std::vector<FileEntry>& outEntries);
+
+// Enumerates one directory at a time on a background thread and hands the entries to the UI
+// thread in batches. Starting a new enumeration cancels the one in progress (navigation).
+//
+// Usage (UI thread):
+//   enumerator.Start(path, showHidden);
+//   ...every frame:
+//   std::vector<FileEntry> batch; bool complete, failed;
+//   if (enumerator.Poll(batch, complete, failed)) { append batch; if (complete) ... }
+class DirectoryEnumerator
+{
+public:
+    DirectoryEnumerator();
+    ~DirectoryEnumerator();
+
+    DirectoryEnumerator(const DirectoryEnumerator&) = delete;
+    DirectoryEnumerator& operator=(const DirectoryEnumerator&) = delete;
+
+    // Begin enumerating path (cancels any enumeration in progress, drops its undelivered batches)
+    void Start(const std::wstring& path, bool includeHidden);
+
+    // Stop the enumeration in progress and drop its undelivered batches
+    void Cancel();
+
+    // Take the entries read since the last call (UI thread, once per frame)
+    // @param outEntries - receives new entries (appended)
+    // @param outComplete - true once the whole directory has been delivered
+    // @param outFailed - true if the directory could not be opened (outComplete is also set)
+    // @return true if there was anything to deliver (entries or completion)
+    bool Poll(std::vector<FileEntry>& outEntries, bool& outComplete, bool& outFailed);
+
+    // True between Start() and the Poll() that reports completion
+    bool IsBusy() const { return m_busy; }
+
+    // Directory of the current (or last) enumeration
+    const std::wstring& GetPath() const { return m_path; }
+
+    // Hidden-file setting of the current (or last) enumeration
+    bool GetIncludeHidden() const { return m_includeHidden; }
+
+private:
+    // Worker thread function
+    void WorkerThread();
+
+    // Read one directory, publishing batches while generation is still current
+    void Enumerate(const std::wstring& path, bool includeHidden, uint64_t generation);
+
+    // Queue entries for Poll() (dropped if generation is stale)
+    void Publish(std::vector<FileEntry>& entries, uint64_t generation, bool complete, bool failed);
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+
+    // Pending job (UI thread -> worker)
+    std::mutex m_jobMutex;
+    std::condition_variable m_jobCV;
+    std::wstring m_jobPath;
+    bool m_jobIncludeHidden = false;
+    bool m_hasJob = false;
+
+    // Incremented by Start()/Cancel(); the worker abandons any enumeration with an older value
+    std::atomic<uint64_t> m_generation{0};
+
+    // Delivered results (worker -> UI thread)
+    std::mutex m_resultMutex;
+    std::vector<FileEntry> m_readyEntries;
+    bool m_readyComplete = false;
+    bool m_readyFailed = false;
+
+    // UI thread state
+    std::wstring m_path;
+    bool m_includeHidden = false;
+    bool m_busy = false;
+};
+
+} // namespace UFB
@@ -0,0 +1,330 @@
+#include "blend_reader.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#ifndef _WIN32
+#include <filesystem>
+#endif
+
+#ifdef UFB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef UFB_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+// 64-bit seek with the C runtime
+bool Seek(FILE* file, int64_t offset, int origin)
+{
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+// Read chunk for files and compressed input
+constexpr size_t kReadBufferSize = 64 * 1024;
+
+// The TEST block is written right after REND/GLOB; give up if it is not within this much data
+constexpr uint64_t kMaxScanBytes = 16ULL * 1024 * 1024;
+
+// Sequential byte source over a raw, gzip or zstd .blend file
+class BlendStream
+{
+public:
+    virtual ~BlendStream() = default;
+
+    // Read exactly length bytes
+    virtual bool Read(void* dst, size_t length) = 0;
+
+    // Skip length bytes
+    virtual bool Skip(uint64_t length)
+    {
+        // Compressed streams have to decode what they skip
+        unsigned char scratch[4096];
+        while (length > 0)
+        {
+            size_t chunk = static_cast<size_t>((std::min)(length, static_cast<uint64_t>(sizeof(scratch))));
+            if (!Read(scratch, chunk))
+                return false;
+            length -= chunk;
+        }
+        return true;
+    }
+};
+
+// Uncompressed file: the CRT buffer holds the header region, skips are seeks
+class RawBlendStream : public BlendStream
+{
+public:
+    explicit RawBlendStream(FILE* file) : m_file(file)
+    {
+        setvbuf(m_file, nullptr, _IOFBF, kReadBufferSize);
+    }
+
+    bool Read(void* dst, size_t length) override
+    {
+        return fread(dst, 1, length, m_file) == length;
+    }
+
+    bool Skip(uint64_t length) override
+    {
+        return Seek(m_file, static_cast<int64_t>(length), SEEK_CUR);
+    }
+
+private:
+    FILE* m_file;
+};
+
+#ifdef UFB_HAVE_ZLIB
+// gzip-compressed file ("Compress" in Blender 2.x)
+class GzipBlendStream : public BlendStream
+{
+public:
+    explicit GzipBlendStream(FILE* file) : m_file(file), m_input(kReadBufferSize)
+    {
+        m_valid = (inflateInit2(&m_stream, 16 + MAX_WBITS) == Z_OK);  // 16: expect a gzip wrapper
+    }
+
+    ~GzipBlendStream() override
+    {
+        if (m_valid)
+            inflateEnd(&m_stream);
+    }
+
+    bool Read(void* dst, size_t length) override
+    {
+        if (!m_valid)
+            return false;
+
+        m_stream.next_out = static_cast<Bytef*>(dst);
+        m_stream.avail_out = static_cast<uInt>(length);
+
+        while (m_stream.avail_out > 0)
+        {
+            if (m_stream.avail_in == 0)
+            {
+                size_t bytesRead = fread(m_input.data(), 1, m_input.size(), m_file);
+                if (bytesRead == 0)
+                    return false;
+                m_stream.next_in = m_input.data();
+                m_stream.avail_in = static_cast<uInt>(bytesRead);
+            }
+
+            int result = inflate(&m_stream, Z_NO_FLUSH);
+            if (result == Z_STREAM_END)
+                return m_stream.avail_out == 0;
+            if (result != Z_OK && result != Z_BUF_ERROR)
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    FILE* m_file;
+    std::vector<Bytef> m_input;
+    z_stream m_stream = {};
+    bool m_valid = false;
+};
+#endif
+
+#ifdef UFB_HAVE_ZSTD
+// zstd-compressed file (Blender 3.0+ default when "Compress" is on)
+class ZstdBlendStream : public BlendStream
+{
+public:
+    explicit ZstdBlendStream(FILE* file) : m_file(file), m_input(ZSTD_DStreamInSize())
+    {
+        m_context = ZSTD_createDCtx();
+    }
+
+    ~ZstdBlendStream() override
+    {
+        ZSTD_freeDCtx(m_context);
+    }
+
+    bool Read(void* dst, size_t length) override
+    {
+        if (!m_context)
+            return false;
+
+        ZSTD_outBuffer output = { dst, length, 0 };
+
+        while (output.pos < output.size)
+        {
+            if (m_inBuffer.pos == m_inBuffer.size)
+            {
+                size_t bytesRead = fread(m_input.data(), 1, m_input.size(), m_file);
+                if (bytesRead == 0)
+                    return false;
+                m_inBuffer = { m_input.data(), bytesRead, 0 };
+            }
+
+            size_t result = ZSTD_decompressStream(m_context, &output, &m_inBuffer);
+            if (ZSTD_isError(result))
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    FILE* m_file;
+    std::vector<unsigned char> m_input;
+    ZSTD_inBuffer m_inBuffer = { nullptr, 0, 0 };
+    ZSTD_DCtx* m_context = nullptr;
+};
+#endif
+
+// Pick the stream type from the first bytes of the file
+std::unique_ptr<BlendStream> OpenBlendStream(FILE* file)
+{
+    unsigned char magic[4] = {};
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || !Seek(file, 0, SEEK_SET))
+        return nullptr;
+
+    if (magic[0] == 0x1F && magic[1] == 0x8B)
+    {
+#ifdef UFB_HAVE_ZLIB
+        return std::make_unique<GzipBlendStream>(file);
+#else
+        return nullptr;
+#endif
+    }
+
+    if (magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD)
+    {
+#ifdef UFB_HAVE_ZSTD
+        return std::make_unique<ZstdBlendStream>(file);
+#else
+        return nullptr;
+#endif
+    }
+
+    return std::make_unique<RawBlendStream>(file);
+}
+
+// Walk BHead blocks until TEST (thumbnail) and read its RGBA pixels (bottom-up)
+bool ReadThumbnailBlock(BlendStream& stream, std::vector<unsigned char>& outData, uint32_t& outWidth, uint32_t& outHeight)
+{
+    // Legacy header (12 bytes): "BLENDER" + '_'/'-' (4/8-byte pointers) + 'v'/'V' (endianness) + "300"
+    // Large header (17 bytes, Blender 4.x+): "BLENDER" + "17" (header size) + '-' + "01" (format) + 'v'/'V' + "0405"
+    char header[17];
+    if (!stream.Read(header, 12) || strncmp(header, "BLENDER", 7) != 0)
+    {
+        return false;
+    }
+
+    bool largeHeader = (header[7] >= '0' && header[7] <= '9');
+    int ptrSize;
+    bool littleEndian;
+
+    if (largeHeader)
+    {
+        if (header[7] != '1' || header[8] != '7' || !stream.Read(header + 12, 5))
+            return false;
+
+        ptrSize = 8;
+        littleEndian = (header[12] == 'v');
+    }
+    else
+    {
+        ptrSize = (header[7] == '_') ? 4 : 8;
+        littleEndian = (header[8] == 'v');
+    }
+
+    auto toUInt32 = [littleEndian](const unsigned char* bytes) -> uint32_t {
+        if (littleEndian)
+            return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        else
+            return (static_cast<uint32_t>(bytes[0]) << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
+    };
+
+    auto toUInt64 = [littleEndian, &toUInt32](const unsigned char* bytes) -> uint64_t {
+        uint64_t first = toUInt32(bytes);
+        uint64_t second = toUInt32(bytes + 4);
+        return littleEndian ? (first | (second << 32)) : ((first << 32) | second);
+    };
+
+    // BHead layouts:
+    //   legacy: code(4) len(4) old(ptr) SDNAnr(4) nr(4)
+    //   large:  code(4) SDNAnr(4) old(8) len(8) nr(8)
+    const size_t bheadSize = largeHeader ? 32 : (16 + ptrSize);
+    uint64_t scanned = 0;
+
+    while (scanned < kMaxScanBytes)
+    {
+        unsigned char bhead[32];
+        if (!stream.Read(bhead, bheadSize))
+            return false;
+
+        uint64_t blockSize = largeHeader ? toUInt64(bhead + 16) : toUInt32(bhead + 4);
+
+        if (memcmp(bhead, "TEST", 4) == 0)
+        {
+            // Thumbnail dimensions (unsigned 32-bit integers) followed by RGBA pixels
+            unsigned char dims[8];
+            if (!stream.Read(dims, sizeof(dims)))
+                return false;
+
+            outWidth = toUInt32(dims);
+            outHeight = toUInt32(dims + 4);
+
+            // Validate dimensions
+            if (outWidth == 0 || outHeight == 0 || outWidth > 1024 || outHeight > 1024 ||
+                blockSize < 8 + static_cast<uint64_t>(outWidth) * outHeight * 4)
+            {
+                return false;
+            }
+
+            outData.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+            return stream.Read(outData.data(), outData.size());
+        }
+
+        if (memcmp(bhead, "ENDB", 4) == 0)
+        {
+            // End of file blocks
+            return false;
+        }
+
+        // Skip this block's data
+        if (!stream.Skip(blockSize))
+            return false;
+        scanned += bheadSize + blockSize;
+    }
+
+    return false;
+}
+
+} // namespace
+
+bool ReadBlendThumbnail(const std::wstring& path, std::vector<unsigned char>& rgba, uint32_t& width, uint32_t& height)
+{
+#ifdef _WIN32
+    FILE* file = nullptr;
+    if (_wfopen_s(&file, path.c_str(), L"rb") != 0 || !file)
+        return false;
+#else
+    FILE* file = fopen(std::filesystem::path(path).c_str(), "rb");
+    if (!file)
+        return false;
+#endif
+
+    bool found = false;
+    {
+        // Only decompresses as far as the TEST block
+        std::unique_ptr<BlendStream> stream = OpenBlendStream(file);
+        if (stream)
+            found = ReadThumbnailBlock(*stream, rgba, width, height);
+    }
+
+    fclose(file);
+    return found && !rgba.empty();
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Reads the embedded thumbnail (TEST block) of a .blend file
+// Only reads up to the TEST block. Legacy 12-byte headers (4/8-byte pointers, either
+// endianness) and the 17-byte large-BHead header of Blender 4.x are understood.
+// gzip/zstd-compressed files are decompressed as a stream and only as far as needed
+// (requires UFB_HAVE_ZLIB / UFB_HAVE_ZSTD at build time; without them such files have no thumbnail).
+// @param rgba - receives width * height RGBA pixels, bottom-up as Blender stores them
+// @return false if the file can't be read, isn't a .blend file or has no thumbnail
+bool ReadBlendThumbnail(const std::wstring& path, std::vector<unsigned char>& rgba, uint32_t& width, uint32_t& height);
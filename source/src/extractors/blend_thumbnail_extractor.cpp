@@ -1,8 +1,8 @@
 #include "blend_thumbnail_extractor.h"
+#include "blend_reader.h"
 #include <windows.h>
 #include <iostream>
 #include <algorithm>
-#include <fstream>
 #include <vector>
 
 BlendThumbnailExtractor::BlendThumbnailExtractor()
@@ -26,118 +26,11 @@ bool BlendThumbnailExtractor::CanHandle(const std::wstring& extension)
 
 HBITMAP BlendThumbnailExtractor::Extract(const std::wstring& path, int size)
 {
-    // Open .blend file
-    std::ifstream file(path, std::ios::binary);
-    if (!file)
-    {
-        return nullptr;
-    }
-
-    // Read header (12 bytes)
-    char header[12];
-    file.read(header, 12);
-    if (file.gcount() != 12)
-    {
-        return nullptr;
-    }
-
-    // Check signature
-    if (strncmp(header, "BLENDER", 7) != 0)
-    {
-        return nullptr;
-    }
-
-    // Parse header
-    char pointerSize = header[7];  // '_' = 32-bit (4 bytes), '-' = 64-bit (8 bytes)
-    char endianness = header[8];   // 'v' = little-endian, 'V' = big-endian
-    int ptrSize = (pointerSize == '_') ? 4 : 8;
-    bool littleEndian = (endianness == 'v');
-
-    // Helper to read int32 with endianness
-    auto readInt32 = [&](std::ifstream& f) -> int32_t {
-        unsigned char bytes[4];
-        f.read(reinterpret_cast<char*>(bytes), 4);
-        if (littleEndian)
-            return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
-        else
-            return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
-    };
-
-    // Helper to read uint32 with endianness
-    auto readUInt32 = [&](std::ifstream& f) -> uint32_t {
-        unsigned char bytes[4];
-        f.read(reinterpret_cast<char*>(bytes), 4);
-        if (littleEndian)
-            return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
-        else
-            return (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3];
-    };
-
-    // Search for TEST block (thumbnail)
-    bool found = false;
     std::vector<unsigned char> thumbnailData;
     uint32_t thumbWidth = 0;
     uint32_t thumbHeight = 0;
 
-    while (file.good() && !found)
-    {
-        // Read block code (4 bytes)
-        char blockCode[5] = {0};
-        file.read(blockCode, 4);
-        if (file.gcount() != 4)
-            break;
-
-        // Read block size
-        int32_t blockSize = readInt32(file);
-
-        // Read old memory address (skip)
-        file.seekg(ptrSize, std::ios::cur);
-
-        // Read SDNA index
-        readInt32(file);
-
-        // Read count
-        int32_t count = readInt32(file);
-
-        // Check if this is the TEST block (thumbnail)
-        if (strncmp(blockCode, "TEST", 4) == 0)
-        {
-            // Read thumbnail dimensions (stored as unsigned 32-bit integers)
-            thumbWidth = readUInt32(file);
-            thumbHeight = readUInt32(file);
-
-            // Validate dimensions
-            if (thumbWidth == 0 || thumbHeight == 0 || thumbWidth > 1024 || thumbHeight > 1024)
-            {
-                break;
-            }
-
-            // Read RGBA data
-            int dataSize = thumbWidth * thumbHeight * 4;
-            thumbnailData.resize(dataSize);
-            file.read(reinterpret_cast<char*>(thumbnailData.data()), dataSize);
-
-            if (file.gcount() == dataSize)
-            {
-                found = true;
-            }
-            break;
-        }
-        else if (strncmp(blockCode, "ENDB", 4) == 0)
-        {
-            // End of file blocks
-            break;
-        }
-        else
-        {
-            // Skip this block's data
-            file.seekg(blockSize, std::ios::cur);
-        }
-    }
-
-    file.close();
-
-    if (!found || thumbnailData.empty())
+    if (!ReadBlendThumbnail(path, thumbnailData, thumbWidth, thumbHeight))
     {
         return nullptr;
     }
@@ -5,6 +5,8 @@
 #include <string>
 
 // Blender thumbnail extractor - extracts embedded thumbnail from .blend files
+// Reads only up to the TEST block; gzip/zstd-compressed files are decompressed as a stream
+// and only as far as needed (requires UFB_HAVE_ZLIB / UFB_HAVE_ZSTD at build time)
 class BlendThumbnailExtractor : public ThumbnailExtractorInterface
 {
 public:
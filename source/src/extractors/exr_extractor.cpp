@@ -1,230 +1,435 @@
 #define NOMINMAX  // Prevent Windows min/max macros from conflicting with std::min/max
 #include "exr_extractor.h"
+#include "exr_tonemap.h"
+#include "image_downscaler.h"
 #include <OpenEXR/ImfInputFile.h>
 #include <OpenEXR/ImfMultiPartInputFile.h>
 #include <OpenEXR/ImfHeader.h>
 #include <OpenEXR/ImfChannelList.h>
+#include <OpenEXR/ImfCompression.h>
 #include <OpenEXR/ImfFrameBuffer.h>
 #include <OpenEXR/ImfInputPart.h>
+#include <OpenEXR/ImfTiledInputPart.h>
+#include <OpenEXR/ImfPreviewImage.h>
+#include <OpenEXR/ImfThreading.h>
 #include <Imath/ImathBox.h>
-#include <Imath/half.h>
 #include <vector>
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <mutex>
+#include <thread>
 
-EXRExtractor::EXRExtractor()
+namespace {
+
+// Upper bound for one decoded band (float RGBA); bands are still at least one chunk tall
+constexpr size_t kMaxBandBytes = 32ULL * 1024 * 1024;
+
+// Target number of scanlines per band so several chunks decompress in parallel
+constexpr int kTargetBandLines = 256;
+
+// Single-line chunks: source rows read and box-averaged per output row
+constexpr int kSampledRowsPerOutputRow = 4;
+
+struct RGBAChannelNames
 {
+    std::string r = "R";
+    std::string g = "G";
+    std::string b = "B";
+    std::string a = "A";
+    bool hasAlpha = false;
+};
+
+// Find RGBA channels - try default first, then search for layered channels
+bool FindRGBAChannels(const Imf::ChannelList& channels, RGBAChannelNames& names)
+{
+    const Imf::Channel* chR = channels.findChannel("R");
+    const Imf::Channel* chG = channels.findChannel("G");
+    const Imf::Channel* chB = channels.findChannel("B");
+    const Imf::Channel* chA = channels.findChannel("A");
+
+    // If default channels not found, search for the first available layer with RGB
+    if (!chR || !chG || !chB)
+    {
+        std::string layerPrefix;
+        for (Imf::ChannelList::ConstIterator it = channels.begin(); it != channels.end(); ++it)
+        {
+            std::string channelName = it.name();
+
+            // Find the LAST dot (for Blender ViewLayer.Combined.R style names)
+            size_t dotPos = channelName.find_last_of('.');
+            if (dotPos != std::string::npos)
+            {
+                // Extract layer prefix (everything before last dot)
+                // E.g., "ViewLayer.Combined.R" -> prefix="ViewLayer.Combined", suffix="R"
+                std::string prefix = channelName.substr(0, dotPos);
+                std::string suffix = channelName.substr(dotPos + 1);
+
+                // Convert suffix to uppercase for case-insensitive comparison
+                std::string suffixUpper = suffix;
+                std::transform(suffixUpper.begin(), suffixUpper.end(), suffixUpper.begin(), ::toupper);
+
+                // Check if this is an R channel
+                if (suffixUpper == "R")
+                {
+                    // Check if this layer has G and B channels too
+                    if (channels.findChannel((prefix + ".G").c_str()) &&
+                        channels.findChannel((prefix + ".B").c_str()))
+                    {
+                        layerPrefix = prefix;
+                        break;
+                    }
+                    // Also check lowercase (some renderers use lowercase)
+                    else if (channels.findChannel((prefix + ".g").c_str()) &&
+                             channels.findChannel((prefix + ".b").c_str()))
+                    {
+                        layerPrefix = prefix;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (!layerPrefix.empty())
+        {
+            // Try uppercase first
+            names.r = layerPrefix + ".R";
+            names.g = layerPrefix + ".G";
+            names.b = layerPrefix + ".B";
+            names.a = layerPrefix + ".A";
+
+            chR = channels.findChannel(names.r.c_str());
+            chG = channels.findChannel(names.g.c_str());
+            chB = channels.findChannel(names.b.c_str());
+            chA = channels.findChannel(names.a.c_str());
+
+            // If uppercase not found, try lowercase
+            if (!chR || !chG || !chB)
+            {
+                names.r = layerPrefix + ".r";
+                names.g = layerPrefix + ".g";
+                names.b = layerPrefix + ".b";
+                names.a = layerPrefix + ".a";
+
+                chR = channels.findChannel(names.r.c_str());
+                chG = channels.findChannel(names.g.c_str());
+                chB = channels.findChannel(names.b.c_str());
+                chA = channels.findChannel(names.a.c_str());
+            }
+        }
+    }
+
+    names.hasAlpha = (chA != nullptr);
+    return chR && chG && chB;
 }
 
-EXRExtractor::~EXRExtractor()
+// Point a float RGBA framebuffer at band memory holding rows [bandMinY, ...] of dataWindow
+void SetupBandFrameBuffer(Imf::FrameBuffer& frameBuffer, const RGBAChannelNames& names,
+                          std::vector<float>& band, const Imath::Box2i& dataWindow, int bandMinY)
 {
+    const int width = dataWindow.max.x - dataWindow.min.x + 1;
+    const size_t xStride = 4 * sizeof(float);
+    const size_t yStride = xStride * width;
+
+    // OpenEXR addresses pixels by absolute coordinates, so offset the base pointer
+    char* base = reinterpret_cast<char*>(band.data())
+               - static_cast<ptrdiff_t>(dataWindow.min.x) * xStride
+               - static_cast<ptrdiff_t>(bandMinY) * yStride;
+
+    frameBuffer = Imf::FrameBuffer();
+    frameBuffer.insert(names.r.c_str(), Imf::Slice(Imf::FLOAT, base + 0 * sizeof(float), xStride, yStride, 1, 1, 0.0f));
+    frameBuffer.insert(names.g.c_str(), Imf::Slice(Imf::FLOAT, base + 1 * sizeof(float), xStride, yStride, 1, 1, 0.0f));
+    frameBuffer.insert(names.b.c_str(), Imf::Slice(Imf::FLOAT, base + 2 * sizeof(float), xStride, yStride, 1, 1, 0.0f));
+    // Missing alpha channels are filled with the slice fill value
+    frameBuffer.insert(names.a.c_str(), Imf::Slice(Imf::FLOAT, base + 3 * sizeof(float), xStride, yStride, 1, 1, 1.0f));
 }
 
-bool EXRExtractor::CanHandle(const std::wstring& extension)
+// Number of scanlines per band: a whole number of chunks, bounded by kMaxBandBytes
+int ChooseBandLines(int width, int linesPerChunk)
 {
-    return (extension == L".exr");
+    size_t rowBytes = static_cast<size_t>(width) * 4 * sizeof(float);
+    int maxLines = static_cast<int>((std::max)(static_cast<size_t>(1), kMaxBandBytes / rowBytes));
+    int lines = (std::min)(kTargetBandLines, maxLines);
+    lines = (std::max)(linesPerChunk, (lines / linesPerChunk) * linesPerChunk);
+    return lines;
 }
 
-HBITMAP EXRExtractor::Extract(const std::wstring& path, int size)
+// Scanline parts: read whole chunk-aligned bands so each chunk is decompressed once,
+// letting OpenEXR's global thread pool decode the chunks of a band in parallel
+void ReadScanlines(Imf::MultiPartInputFile& file, const RGBAChannelNames& names,
+                   int thumbWidth, int thumbHeight, std::vector<float>& thumbPixels)
 {
-    try
+    Imf::InputPart part(file, 0);
+    const Imath::Box2i dataWindow = part.header().dataWindow();
+    const int width = dataWindow.max.x - dataWindow.min.x + 1;
+    const int height = dataWindow.max.y - dataWindow.min.y + 1;
+    const int linesPerChunk = Imf::getCompressionNumScanlines(part.header().compression());
+
+    Imf::FrameBuffer frameBuffer;
+
+    // Single-line chunks (NONE/RLE/ZIPS) can skip rows without wasted decompression: read
+    // kSampledRowsPerOutputRow evenly spaced rows per output row and let the box filter average
+    // them. Rows between the samples are still skipped, so thin horizontal lines and other fine
+    // vertical detail can alias slightly; that is the price of not decoding every row.
+    const int sampledRows = thumbHeight * kSampledRowsPerOutputRow;
+    if (linesPerChunk <= 1 && height >= sampledRows * 2)
     {
-        // Convert wstring to string for OpenEXR
-        std::string path_str(path.begin(), path.end());
+        ImageDownscaler scaler(width, sampledRows, thumbWidth, thumbHeight);
+        scaler.SetOutputFloat(thumbPixels.data(), static_cast<size_t>(thumbWidth) * 4);
 
-        // Open the EXR file
-        Imf::MultiPartInputFile file(path_str.c_str());
-        const Imf::Header& header = file.header(0);
-        const Imath::Box2i displayWindow = header.displayWindow();
-
-        int full_width = displayWindow.max.x - displayWindow.min.x + 1;
-        int full_height = displayWindow.max.y - displayWindow.min.y + 1;
+        std::vector<float> row(static_cast<size_t>(width) * 4);
+        for (int sample = 0; sample < sampledRows; sample++)
+        {
+            int srcY = static_cast<int>((static_cast<int64_t>(2 * sample + 1) * height) / (2 * sampledRows));
+            int y = dataWindow.min.y + srcY;
 
-        // Calculate skip factor for downsampling
-        int max_dim = (std::max)(full_width, full_height);
-        int skip_factor = (std::max)(1, max_dim / size);
+            SetupBandFrameBuffer(frameBuffer, names, row, dataWindow, y);
+            part.setFrameBuffer(frameBuffer);
+            part.readPixels(y, y);
+            scaler.PushRow(row.data(), ImageDownscaler::PixelFormat::RGBAF32);
+        }
+        return;
+    }
 
-        int thumb_width = full_width / skip_factor;
-        int thumb_height = full_height / skip_factor;
+    ImageDownscaler scaler(width, height, thumbWidth, thumbHeight);
+    scaler.SetOutputFloat(thumbPixels.data(), static_cast<size_t>(thumbWidth) * 4);
 
-        // Find RGBA channels - try default first, then search for layered channels
-        const Imf::ChannelList& channels = header.channels();
+    const int bandLines = ChooseBandLines(width, (std::max)(1, linesPerChunk));
+    std::vector<float> band(static_cast<size_t>(width) * bandLines * 4);
 
-        std::string channelR = "R";
-        std::string channelG = "G";
-        std::string channelB = "B";
-        std::string channelA = "A";
+    for (int bandStart = 0; bandStart < height; bandStart += bandLines)
+    {
+        int bandEnd = (std::min)(height, bandStart + bandLines) - 1;
 
-        const Imf::Channel* chR = channels.findChannel("R");
-        const Imf::Channel* chG = channels.findChannel("G");
-        const Imf::Channel* chB = channels.findChannel("B");
-        const Imf::Channel* chA = channels.findChannel("A");
+        SetupBandFrameBuffer(frameBuffer, names, band, dataWindow, dataWindow.min.y + bandStart);
+        part.setFrameBuffer(frameBuffer);
+        part.readPixels(dataWindow.min.y + bandStart, dataWindow.min.y + bandEnd);
 
-        // If default channels not found, search for the first available layer with RGB
-        if (!chR || !chG || !chB)
+        for (int y = bandStart; y <= bandEnd; y++)
         {
-            std::string layerPrefix;
-            for (Imf::ChannelList::ConstIterator it = channels.begin(); it != channels.end(); ++it)
-            {
-                std::string channelName = it.name();
+            scaler.PushRow(band.data() + static_cast<size_t>(y - bandStart) * width * 4,
+                           ImageDownscaler::PixelFormat::RGBAF32);
+        }
+    }
+}
 
-                // Find the LAST dot (for Blender ViewLayer.Combined.R style names)
-                size_t dotPos = channelName.find_last_of('.');
-                if (dotPos != std::string::npos)
-                {
-                    // Extract layer prefix (everything before last dot)
-                    // E.g., "ViewLayer.Combined.R" -> prefix="ViewLayer.Combined", suffix="R"
-                    std::string prefix = channelName.substr(0, dotPos);
-                    std::string suffix = channelName.substr(dotPos + 1);
+// Tiled parts: read one full row of tiles per call (parallel tile decode) from the chosen level
+void ReadTiles(Imf::TiledInputPart& part, const RGBAChannelNames& names, int levelX, int levelY,
+               int thumbWidth, int thumbHeight, std::vector<float>& thumbPixels)
+{
+    const Imath::Box2i levelWindow = part.dataWindowForLevel(levelX, levelY);
+    const int width = levelWindow.max.x - levelWindow.min.x + 1;
+    const int height = levelWindow.max.y - levelWindow.min.y + 1;
+    const int numXTiles = part.numXTiles(levelX);
+    const int numYTiles = part.numYTiles(levelY);
+    const int tileHeight = static_cast<int>(part.tileYSize());
 
-                    // Convert suffix to uppercase for case-insensitive comparison
-                    std::string suffixUpper = suffix;
-                    std::transform(suffixUpper.begin(), suffixUpper.end(), suffixUpper.begin(), ::toupper);
+    ImageDownscaler scaler(width, height, thumbWidth, thumbHeight);
+    scaler.SetOutputFloat(thumbPixels.data(), static_cast<size_t>(thumbWidth) * 4);
 
-                    // Check if this is an R channel
-                    if (suffixUpper == "R")
-                    {
-                        // Check if this layer has G and B channels too
-                        if (channels.findChannel((prefix + ".G").c_str()) &&
-                            channels.findChannel((prefix + ".B").c_str()))
-                        {
-                            layerPrefix = prefix;
-                            break;
-                        }
-                        // Also check lowercase (some renderers use lowercase)
-                        else if (channels.findChannel((prefix + ".g").c_str()) &&
-                                 channels.findChannel((prefix + ".b").c_str()))
-                        {
-                            layerPrefix = prefix;
-                            break;
-                        }
-                    }
+    std::vector<float> band(static_cast<size_t>(width) * tileHeight * 4);
+    Imf::FrameBuffer frameBuffer;
+
+    for (int tileY = 0; tileY < numYTiles; tileY++)
+    {
+        int bandMinY = levelWindow.min.y + tileY * tileHeight;
+        int bandMaxY = (std::min)(levelWindow.max.y, bandMinY + tileHeight - 1);
+
+        SetupBandFrameBuffer(frameBuffer, names, band, levelWindow, bandMinY);
+        part.setFrameBuffer(frameBuffer);
+        part.readTiles(0, numXTiles - 1, tileY, tileY, levelX, levelY);
+
+        for (int y = bandMinY; y <= bandMaxY; y++)
+        {
+            scaler.PushRow(band.data() + static_cast<size_t>(y - bandMinY) * width * 4,
+                           ImageDownscaler::PixelFormat::RGBAF32);
+        }
+    }
+}
+
+// Pick the smallest mip/rip level that still covers the thumbnail
+void ChooseTileLevel(const Imf::TiledInputPart& part, int thumbWidth, int thumbHeight, int& levelX, int& levelY)
+{
+    levelX = 0;
+    levelY = 0;
+
+    switch (part.levelMode())
+    {
+        case Imf::MIPMAP_LEVELS:
+            for (int l = part.numLevels() - 1; l > 0; l--)
+            {
+                if (part.levelWidth(l) >= thumbWidth && part.levelHeight(l) >= thumbHeight)
+                {
+                    levelX = levelY = l;
+                    break;
                 }
             }
+            break;
 
-            if (!layerPrefix.empty())
+        case Imf::RIPMAP_LEVELS:
+            for (int lx = part.numXLevels() - 1; lx > 0; lx--)
             {
-                // Try uppercase first
-                channelR = layerPrefix + ".R";
-                channelG = layerPrefix + ".G";
-                channelB = layerPrefix + ".B";
-                channelA = layerPrefix + ".A";
-
-                chR = channels.findChannel(channelR.c_str());
-                chG = channels.findChannel(channelG.c_str());
-                chB = channels.findChannel(channelB.c_str());
-                chA = channels.findChannel(channelA.c_str());
-
-                // If uppercase not found, try lowercase
-                if (!chR || !chG || !chB)
+                if (part.levelWidth(lx) >= thumbWidth)
                 {
-                    channelR = layerPrefix + ".r";
-                    channelG = layerPrefix + ".g";
-                    channelB = layerPrefix + ".b";
-                    channelA = layerPrefix + ".a";
-
-                    chR = channels.findChannel(channelR.c_str());
-                    chG = channels.findChannel(channelG.c_str());
-                    chB = channels.findChannel(channelB.c_str());
-                    chA = channels.findChannel(channelA.c_str());
+                    levelX = lx;
+                    break;
                 }
-
-                // Successfully found a layer
             }
-        }
+            for (int ly = part.numYLevels() - 1; ly > 0; ly--)
+            {
+                if (part.levelHeight(ly) >= thumbHeight)
+                {
+                    levelY = ly;
+                    break;
+                }
+            }
+            break;
 
-        if (!chR || !chG || !chB)
-        {
-            // No suitable RGB channels found - fallback extractor will handle it
-            return nullptr;
-        }
+        default:
+            break;
+    }
+}
+
+HBITMAP CreateThumbnailBitmap(int width, int height, void** outBits)
+{
+    HDC hdcScreen = GetDC(nullptr);
+    HDC hdcMem = CreateCompatibleDC(hdcScreen);
+
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = width;
+    bmi.bmiHeader.biHeight = -height;  // Top-down DIB
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    *outBits = nullptr;
+    HBITMAP hBitmap = CreateDIBSection(hdcMem, &bmi, DIB_RGB_COLORS, outBits, nullptr, 0);
+
+    DeleteDC(hdcMem);
+    ReleaseDC(nullptr, hdcScreen);
+
+    if (hBitmap && !*outBits)
+    {
+        DeleteObject(hBitmap);
+        return nullptr;
+    }
+    return hBitmap;
+}
 
-        bool hasAlpha = (chA != nullptr);
+// Embedded preview images are already 8-bit display-referred - just downscale them
+HBITMAP ExtractFromPreview(const Imf::PreviewImage& preview, int size)
+{
+    const int width = static_cast<int>(preview.width());
+    const int height = static_cast<int>(preview.height());
 
-        // Allocate thumbnail buffer (half-float RGBA)
-        std::vector<Imath::half> thumb_pixels(thumb_width * thumb_height * 4);
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(width, height, size, thumbWidth, thumbHeight);
 
-        // Allocate scanline buffer for reading
-        std::vector<Imath::half> scanline_buffer(full_width * 4);
+    void* pBits = nullptr;
+    HBITMAP hBitmap = CreateThumbnailBitmap(thumbWidth, thumbHeight, &pBits);
+    if (!hBitmap)
+        return nullptr;
 
-        Imf::InputPart part(file, 0);
-        Imf::FrameBuffer frameBuffer;
+    // PreviewRgba is four bytes in R, G, B, A order
+    ImageDownscaler scaler(width, height, thumbWidth, thumbHeight);
+    scaler.SetOutputBGRA8(static_cast<uint8_t*>(pBits), static_cast<size_t>(thumbWidth) * 4);
 
-        const size_t channelByteCount = sizeof(Imath::half);
-        const size_t cb = 4 * channelByteCount;
+    const Imf::PreviewRgba* pixels = preview.pixels();
+    for (int y = 0; y < height; y++)
+    {
+        scaler.PushRow(pixels + static_cast<size_t>(y) * width, ImageDownscaler::PixelFormat::RGBA8);
+    }
 
-        // Setup framebuffer for reading one scanline at a time
-        frameBuffer.insert(channelR.c_str(), Imf::Slice(Imf::HALF, (char*)(scanline_buffer.data()) + 0 * channelByteCount, cb, 0, 1, 1, 0.0f));
-        frameBuffer.insert(channelG.c_str(), Imf::Slice(Imf::HALF, (char*)(scanline_buffer.data()) + 1 * channelByteCount, cb, 0, 1, 1, 0.0f));
-        frameBuffer.insert(channelB.c_str(), Imf::Slice(Imf::HALF, (char*)(scanline_buffer.data()) + 2 * channelByteCount, cb, 0, 1, 1, 0.0f));
-        if (hasAlpha)
+    return hBitmap;
+}
+
+} // namespace
+
+EXRExtractor::EXRExtractor()
+{
+    // OpenEXR decompresses chunks on its global thread pool, which is empty by default
+    static std::once_flag s_threadPoolInit;
+    std::call_once(s_threadPoolInit, []() {
+        if (Imf::globalThreadCount() == 0)
         {
-            frameBuffer.insert(channelA.c_str(), Imf::Slice(Imf::HALF, (char*)(scanline_buffer.data()) + 3 * channelByteCount, cb, 0, 1, 1, 0.0f));
+            Imf::setGlobalThreadCount((std::max)(1u, std::thread::hardware_concurrency()));
         }
+    });
+}
 
-        part.setFrameBuffer(frameBuffer);
+EXRExtractor::~EXRExtractor()
+{
+}
 
-        // Read every Nth scanline and downsample horizontally
-        for (int thumb_y = 0; thumb_y < thumb_height; thumb_y++)
-        {
-            int source_y = displayWindow.min.y + (thumb_y * skip_factor);
-            if (source_y > displayWindow.max.y) break;
+bool EXRExtractor::CanHandle(const std::wstring& extension)
+{
+    return (extension == L".exr");
+}
 
-            // Read one scanline
-            part.readPixels(source_y, source_y);
+HBITMAP EXRExtractor::Extract(const std::wstring& path, int size)
+{
+    try
+    {
+        // Convert wstring to string for OpenEXR
+        std::string path_str(path.begin(), path.end());
 
-            // Downsample horizontally - pick every Nth pixel
-            for (int thumb_x = 0; thumb_x < thumb_width; thumb_x++)
-            {
-                int source_x = thumb_x * skip_factor;
-                if (source_x >= full_width) break;
+        // Open the EXR file
+        Imf::MultiPartInputFile file(path_str.c_str());
+        const Imf::Header& header = file.header(0);
+        const Imath::Box2i dataWindow = header.dataWindow();
+
+        int full_width = dataWindow.max.x - dataWindow.min.x + 1;
+        int full_height = dataWindow.max.y - dataWindow.min.y + 1;
 
-                int src_idx = source_x * 4;
-                int dst_idx = (thumb_y * thumb_width + thumb_x) * 4;
+        int thumb_width, thumb_height;
+        ImageDownscaler::FitSize(full_width, full_height, size, thumb_width, thumb_height);
 
-                thumb_pixels[dst_idx + 0] = scanline_buffer[src_idx + 0];  // R
-                thumb_pixels[dst_idx + 1] = scanline_buffer[src_idx + 1];  // G
-                thumb_pixels[dst_idx + 2] = scanline_buffer[src_idx + 2];  // B
-                thumb_pixels[dst_idx + 3] = hasAlpha ? scanline_buffer[src_idx + 3] : Imath::half(1.0f);  // A
+        // Use the embedded preview when it is big enough - no pixel data needs decoding
+        if (header.hasPreviewImage())
+        {
+            const Imf::PreviewImage& preview = header.previewImage();
+            if (static_cast<int>(preview.width()) >= thumb_width &&
+                static_cast<int>(preview.height()) >= thumb_height)
+            {
+                return ExtractFromPreview(preview, size);
             }
         }
 
-        // Convert half-float to RGBA8
-        std::vector<uint8_t> rgba8;
-        ConvertHalfToRGBA8(thumb_pixels.data(), thumb_width, thumb_height, rgba8);
+        RGBAChannelNames names;
+        if (!FindRGBAChannels(header.channels(), names))
+        {
+            // No suitable RGB channels found - fallback extractor will handle it
+            return nullptr;
+        }
 
-        // Create HBITMAP from RGBA8 data
-        HDC hdcScreen = GetDC(nullptr);
-        HDC hdcMem = CreateCompatibleDC(hdcScreen);
+        std::vector<float> averaged(static_cast<size_t>(thumb_width) * thumb_height * 4, 0.0f);
 
-        BITMAPINFO bmi = {};
-        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        bmi.bmiHeader.biWidth = thumb_width;
-        bmi.bmiHeader.biHeight = -thumb_height;  // Top-down DIB
-        bmi.bmiHeader.biPlanes = 1;
-        bmi.bmiHeader.biBitCount = 32;
-        bmi.bmiHeader.biCompression = BI_RGB;
+        if (header.hasTileDescription())
+        {
+            Imf::TiledInputPart part(file, 0);
+
+            int levelX, levelY;
+            ChooseTileLevel(part, thumb_width, thumb_height, levelX, levelY);
+            ReadTiles(part, names, levelX, levelY, thumb_width, thumb_height, averaged);
+        }
+        else
+        {
+            ReadScanlines(file, names, thumb_width, thumb_height, averaged);
+        }
 
+        // Create HBITMAP and tonemap straight into it (BGRA, top-down)
         void* pBits = nullptr;
-        HBITMAP hBitmap = CreateDIBSection(hdcMem, &bmi, DIB_RGB_COLORS, &pBits, nullptr, 0);
+        HBITMAP hBitmap = CreateThumbnailBitmap(thumb_width, thumb_height, &pBits);
 
-        if (hBitmap && pBits)
+        if (hBitmap)
         {
-            // Copy RGBA data to bitmap (convert RGBA to BGRA for Windows)
-            uint8_t* dst = (uint8_t*)pBits;
-            for (int i = 0; i < thumb_width * thumb_height; i++)
-            {
-                dst[i * 4 + 0] = rgba8[i * 4 + 2];  // B
-                dst[i * 4 + 1] = rgba8[i * 4 + 1];  // G
-                dst[i * 4 + 2] = rgba8[i * 4 + 0];  // R
-                dst[i * 4 + 3] = rgba8[i * 4 + 3];  // A
-            }
+            // Exposure, sRGB curve and quantization in one SIMD pass over the float thumbnail
+            ExrTonemap::Params params;
+            ExrTonemap::ConvertFloatRGBAToBGRA8(averaged.data(), static_cast<uint8_t*>(pBits),
+                                                static_cast<size_t>(thumb_width) * thumb_height, params);
         }
 
-        DeleteDC(hdcMem);
-        ReleaseDC(nullptr, hdcScreen);
-
         return hBitmap;
     }
     catch (const std::exception& e)
@@ -233,49 +438,3 @@ HBITMAP EXRExtractor::Extract(const std::wstring& path, int size)
         return nullptr;
     }
 }
-
-void EXRExtractor::ConvertHalfToRGBA8(const void* halfData, int width, int height, std::vector<uint8_t>& rgba8)
-{
-    const unsigned short* src = (const unsigned short*)halfData;  // half is 16-bit
-    rgba8.resize(width * height * 4);
-
-    for (int i = 0; i < width * height; i++)
-    {
-        // Manual half-to-float conversion (simple version)
-        auto halfToFloat = [](unsigned short h) -> float {
-            unsigned int sign = (h >> 15) & 0x1;
-            unsigned int exp = (h >> 10) & 0x1F;
-            unsigned int mant = h & 0x3FF;
-
-            if (exp == 0) {
-                if (mant == 0) return sign ? -0.0f : 0.0f;
-                // Denormalized
-                float val = mant / 1024.0f;
-                return sign ? -val / 16384.0f : val / 16384.0f;
-            }
-            if (exp == 31) {
-                return mant ? NAN : (sign ? -INFINITY : INFINITY);
-            }
-
-            int e = exp - 15;
-            float val = (1.0f + mant / 1024.0f) * powf(2.0f, (float)e);
-            return sign ? -val : val;
-        };
-
-        float r = halfToFloat(src[i * 4 + 0]);
-        float g = halfToFloat(src[i * 4 + 1]);
-        float b = halfToFloat(src[i * 4 + 2]);
-        float a = halfToFloat(src[i * 4 + 3]);
-
-        // Simple clamp to [0, 1] range (could use more sophisticated tone mapping)
-        r = (std::max)(0.0f, (std::min)(1.0f, r));
-        g = (std::max)(0.0f, (std::min)(1.0f, g));
-        b = (std::max)(0.0f, (std::min)(1.0f, b));
-        a = (std::max)(0.0f, (std::min)(1.0f, a));
-
-        rgba8[i * 4 + 0] = (uint8_t)(r * 255.0f);
-        rgba8[i * 4 + 1] = (uint8_t)(g * 255.0f);
-        rgba8[i * 4 + 2] = (uint8_t)(b * 255.0f);
-        rgba8[i * 4 + 3] = (uint8_t)(a * 255.0f);
-    }
-}
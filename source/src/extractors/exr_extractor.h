@@ -16,8 +16,4 @@ public:
     HBITMAP Extract(const std::wstring& path, int size) override;
     const char* GetName() const override { return "EXR"; }
     int GetPriority() const override { return 80; }  // High priority (before image extractor)
-
-private:
-    // Helper to convert half-float to RGBA8
-    void ConvertHalfToRGBA8(const void* halfData, int width, int height, std::vector<uint8_t>& rgba8);
 };
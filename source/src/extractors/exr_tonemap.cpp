@@ -0,0 +1,453 @@
+#include "exr_tonemap.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define UFB_TONEMAP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// GCC/Clang only emit AVX/F16C instructions inside functions that opt in;
+// MSVC allows the intrinsics anywhere, so the attribute is empty there
+#if defined(UFB_TONEMAP_X86) && !defined(_MSC_VER)
+#define UFB_TARGET_AVX_F16C __attribute__((target("avx,f16c")))
+#else
+#define UFB_TARGET_AVX_F16C
+#endif
+
+namespace ExrTonemap {
+
+namespace {
+
+// Curve LUT resolution (14-bit index keeps the sRGB toe below 0.25 LSB per step)
+constexpr int kLutSize = 1 << 14;
+
+// Upper bound of the linear input domain covered by each curve's LUT
+constexpr float kFilmicDomainMax = 8.0f;
+
+struct CurveLut
+{
+    std::array<uint8_t, kLutSize> table;
+    float domainMax;  // Inputs are clamped to [0, domainMax]
+    float lutScale;   // Maps [0, domainMax] onto [0, kLutSize - 1]
+};
+
+float EncodeSRGB(float v)
+{
+    if (v <= 0.0031308f)
+        return v * 12.92f;
+    return 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+}
+
+float ApplyFilmic(float v)
+{
+    // Narkowicz ACES fit
+    float mapped = (v * (2.51f * v + 0.03f)) / (v * (2.43f * v + 0.59f) + 0.14f);
+    return (std::min)(1.0f, (std::max)(0.0f, mapped));
+}
+
+CurveLut BuildLut(Curve curve)
+{
+    CurveLut lut;
+    lut.domainMax = (curve == Curve::Filmic) ? kFilmicDomainMax : 1.0f;
+    lut.lutScale = static_cast<float>(kLutSize - 1) / lut.domainMax;
+
+    for (int i = 0; i < kLutSize; i++)
+    {
+        float v = static_cast<float>(i) / lut.lutScale;
+        switch (curve)
+        {
+            case Curve::Linear: break;
+            case Curve::SRGB:   v = EncodeSRGB(v); break;
+            case Curve::Filmic: v = EncodeSRGB(ApplyFilmic(v)); break;
+        }
+        v = (std::min)(1.0f, (std::max)(0.0f, v));
+        lut.table[i] = static_cast<uint8_t>(v * 255.0f + 0.5f);
+    }
+
+    return lut;
+}
+
+const CurveLut& GetLut(Curve curve)
+{
+    // Built once on first use (thread-safe static initialization)
+    static const CurveLut linearLut = BuildLut(Curve::Linear);
+    static const CurveLut srgbLut = BuildLut(Curve::SRGB);
+    static const CurveLut filmicLut = BuildLut(Curve::Filmic);
+
+    switch (curve)
+    {
+        case Curve::Linear: return linearLut;
+        case Curve::Filmic: return filmicLut;
+        default:            return srgbLut;
+    }
+}
+
+// Per-call constants shared by every kernel
+struct KernelSetup
+{
+    const uint8_t* lut;
+    float gain;       // 2^exposure
+    float domainMax;
+    float lutScale;
+    bool premultiply;
+};
+
+KernelSetup MakeSetup(const Params& params)
+{
+    const CurveLut& lut = GetLut(params.curve);
+    return { lut.table.data(), std::exp2(params.exposure), lut.domainMax, lut.lutScale, params.premultiplyAlpha };
+}
+
+// Exact half -> float (no transcendental calls; denormals, Inf and NaN preserved)
+inline float HalfToFloat(uint16_t h)
+{
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1F;
+    uint32_t mantissa = h & 0x3FF;
+    uint32_t bits;
+
+    if (exponent == 0x1F)
+    {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent == 0)
+    {
+        // Zero or denormal: mantissa * 2^-24 is exact in float
+        float value = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+        return sign ? -value : value;
+    }
+    else
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Clamp with the same NaN/ordering semantics as SSE max_ps/min_ps (NaN -> 0)
+inline float ClampRange(float v, float hi)
+{
+    v = (v > 0.0f) ? v : 0.0f;
+    return (v < hi) ? v : hi;
+}
+
+inline float LoadChannel(uint16_t h) { return HalfToFloat(h); }
+inline float LoadChannel(float v) { return v; }
+
+// Scalar kernel - also handles the tails left over by the SIMD kernels
+// (T is uint16_t for half input, float for float input)
+template <typename T>
+void ConvertScalar(const T* src, uint8_t* dst, size_t pixelCount, const KernelSetup& k)
+{
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        float r = LoadChannel(src[i * 4 + 0]);
+        float g = LoadChannel(src[i * 4 + 1]);
+        float b = LoadChannel(src[i * 4 + 2]);
+        float alpha = ClampRange(LoadChannel(src[i * 4 + 3]), 1.0f);
+
+        r *= k.gain;
+        g *= k.gain;
+        b *= k.gain;
+
+        if (k.premultiply)
+        {
+            r *= alpha;
+            g *= alpha;
+            b *= alpha;
+        }
+
+        r = ClampRange(r, k.domainMax);
+        g = ClampRange(g, k.domainMax);
+        b = ClampRange(b, k.domainMax);
+
+        dst[i * 4 + 0] = k.lut[static_cast<int>(b * k.lutScale + 0.5f)];
+        dst[i * 4 + 1] = k.lut[static_cast<int>(g * k.lutScale + 0.5f)];
+        dst[i * 4 + 2] = k.lut[static_cast<int>(r * k.lutScale + 0.5f)];
+        dst[i * 4 + 3] = static_cast<uint8_t>(static_cast<int>(alpha * 255.0f + 0.5f));
+    }
+}
+
+#ifdef UFB_TONEMAP_X86
+
+// SSE2 half -> float for four halves zero-extended into 32-bit lanes
+// (bit trick: rebias the exponent with a multiply, then patch Inf/NaN and sign)
+inline __m128 HalfToFloatSSE2(__m128i h)
+{
+    const __m128i maskNoSign = _mm_set1_epi32(0x7FFF);
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128i wasInfNan = _mm_set1_epi32(0x7BFF);
+    const __m128 expInfNan = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+    __m128i expMant = _mm_and_si128(maskNoSign, h);
+    __m128i justSign = _mm_xor_si128(h, expMant);
+    __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMant, 13)), magic);
+    __m128i isInfNan = _mm_cmpgt_epi32(expMant, wasInfNan);
+    __m128 signBits = _mm_castsi128_ps(_mm_slli_epi32(justSign, 16));
+    __m128 infNanExp = _mm_and_ps(_mm_castsi128_ps(isInfNan), expInfNan);
+    return _mm_or_ps(scaled, _mm_or_ps(signBits, infNanExp));
+}
+
+// Four pixels into four registers
+inline void LoadPixelsSSE2(const uint16_t* src, __m128 v[4])
+{
+    __m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8));
+    v[0] = HalfToFloatSSE2(_mm_unpacklo_epi16(h0, _mm_setzero_si128()));
+    v[1] = HalfToFloatSSE2(_mm_unpackhi_epi16(h0, _mm_setzero_si128()));
+    v[2] = HalfToFloatSSE2(_mm_unpacklo_epi16(h1, _mm_setzero_si128()));
+    v[3] = HalfToFloatSSE2(_mm_unpackhi_epi16(h1, _mm_setzero_si128()));
+}
+
+inline void LoadPixelsSSE2(const float* src, __m128 v[4])
+{
+    for (int j = 0; j < 4; j++)
+        v[j] = _mm_loadu_ps(src + j * 4);
+}
+
+// SSE2 kernel: 4 pixels per iteration (one pixel per 128-bit register)
+template <typename T>
+void ConvertSSE2(const T* src, uint8_t* dst, size_t pixelCount, const KernelSetup& k)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 gain = _mm_setr_ps(k.gain, k.gain, k.gain, 1.0f);
+    const __m128 hi = _mm_setr_ps(k.domainMax, k.domainMax, k.domainMax, 1.0f);
+    const __m128 scale = _mm_setr_ps(k.lutScale, k.lutScale, k.lutScale, 255.0f);
+    const __m128 alphaLane = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    alignas(16) int32_t idx[16];
+
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128 v[4];
+        LoadPixelsSSE2(src + i * 4, v);
+
+        for (int j = 0; j < 4; j++)
+        {
+            __m128 alpha = _mm_shuffle_ps(v[j], v[j], _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm_min_ps(_mm_max_ps(alpha, zero), one);
+
+            __m128 x = _mm_mul_ps(v[j], gain);
+            if (k.premultiply)
+            {
+                __m128 premul = _mm_mul_ps(x, alpha);
+                x = _mm_or_ps(_mm_andnot_ps(alphaLane, premul), _mm_and_ps(alphaLane, x));
+            }
+
+            x = _mm_min_ps(_mm_max_ps(x, zero), hi);
+            _mm_store_si128(reinterpret_cast<__m128i*>(idx + j * 4),
+                            _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(x, scale), half)));
+        }
+
+        uint8_t* out = dst + i * 4;
+        for (int p = 0; p < 4; p++)
+        {
+            out[p * 4 + 0] = k.lut[idx[p * 4 + 2]];
+            out[p * 4 + 1] = k.lut[idx[p * 4 + 1]];
+            out[p * 4 + 2] = k.lut[idx[p * 4 + 0]];
+            out[p * 4 + 3] = static_cast<uint8_t>(idx[p * 4 + 3]);
+        }
+    }
+
+    ConvertScalar(src + i * 4, dst + i * 4, pixelCount - i, k);
+}
+
+// Four pixels into two registers
+UFB_TARGET_AVX_F16C
+inline void LoadPixelsAVX(const uint16_t* src, __m256 v[2])
+{
+    v[0] = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    v[1] = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8)));
+}
+
+UFB_TARGET_AVX_F16C
+inline void LoadPixelsAVX(const float* src, __m256 v[2])
+{
+    v[0] = _mm256_loadu_ps(src);
+    v[1] = _mm256_loadu_ps(src + 8);
+}
+
+// AVX + F16C kernel: 4 pixels per iteration (two pixels per 256-bit register)
+template <typename T>
+UFB_TARGET_AVX_F16C
+void ConvertAVX(const T* src, uint8_t* dst, size_t pixelCount, const KernelSetup& k)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 gain = _mm256_setr_ps(k.gain, k.gain, k.gain, 1.0f, k.gain, k.gain, k.gain, 1.0f);
+    const __m256 hi = _mm256_setr_ps(k.domainMax, k.domainMax, k.domainMax, 1.0f,
+                                     k.domainMax, k.domainMax, k.domainMax, 1.0f);
+    const __m256 scale = _mm256_setr_ps(k.lutScale, k.lutScale, k.lutScale, 255.0f,
+                                        k.lutScale, k.lutScale, k.lutScale, 255.0f);
+
+    alignas(32) int32_t idx[16];
+
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m256 v[2];
+        LoadPixelsAVX(src + i * 4, v);
+
+        for (int j = 0; j < 2; j++)
+        {
+            __m256 alpha = _mm256_permute_ps(v[j], _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm256_min_ps(_mm256_max_ps(alpha, zero), one);
+
+            __m256 x = _mm256_mul_ps(v[j], gain);
+            if (k.premultiply)
+            {
+                x = _mm256_blend_ps(_mm256_mul_ps(x, alpha), x, 0x88);
+            }
+
+            x = _mm256_min_ps(_mm256_max_ps(x, zero), hi);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(idx + j * 8),
+                               _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(x, scale), half)));
+        }
+
+        uint8_t* out = dst + i * 4;
+        for (int p = 0; p < 4; p++)
+        {
+            out[p * 4 + 0] = k.lut[idx[p * 4 + 2]];
+            out[p * 4 + 1] = k.lut[idx[p * 4 + 1]];
+            out[p * 4 + 2] = k.lut[idx[p * 4 + 0]];
+            out[p * 4 + 3] = static_cast<uint8_t>(idx[p * 4 + 3]);
+        }
+    }
+
+    ConvertScalar(src + i * 4, dst + i * 4, pixelCount - i, k);
+}
+
+bool CpuSupportsAVXF16C()
+{
+    int info[4] = {};
+#if defined(_MSC_VER)
+    __cpuid(info, 1);
+#else
+    unsigned int a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d))
+        return false;
+    info[2] = static_cast<int>(c);
+#endif
+
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    if (!osxsave || !avx || !f16c)
+        return false;
+
+    // The OS must save YMM state across context switches
+#if defined(_MSC_VER)
+    unsigned long long xcr0 = _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    unsigned long long xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+    return (xcr0 & 0x6) == 0x6;
+}
+
+#endif // UFB_TONEMAP_X86
+
+template <typename T>
+using KernelFn = void (*)(const T*, uint8_t*, size_t, const KernelSetup&);
+
+bool HasSSE2Kernel()
+{
+#if defined(UFB_TONEMAP_X86) && (defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    return true;
+#else
+    return false;
+#endif
+}
+
+template <typename T>
+KernelFn<T> GetKernelFn(Kernel kernel)
+{
+#ifdef UFB_TONEMAP_X86
+    static const bool hasAVXF16C = CpuSupportsAVXF16C();
+    if (kernel == Kernel::AVXF16C && hasAVXF16C)
+        return ConvertAVX<T>;
+    if (kernel == Kernel::SSE2 && HasSSE2Kernel())
+        return ConvertSSE2<T>;
+#else
+    (void)kernel;
+#endif
+    return ConvertScalar<T>;
+}
+
+Kernel GetActiveKernel()
+{
+    static const Kernel kernel = []() {
+        if (IsKernelAvailable(Kernel::AVXF16C))
+            return Kernel::AVXF16C;
+        if (IsKernelAvailable(Kernel::SSE2))
+            return Kernel::SSE2;
+        return Kernel::Scalar;
+    }();
+    return kernel;
+}
+
+} // namespace
+
+void ConvertHalfRGBAToBGRA8(const uint16_t* src, uint8_t* dst, size_t pixelCount, const Params& params)
+{
+    GetKernelFn<uint16_t>(GetActiveKernel())(src, dst, pixelCount, MakeSetup(params));
+}
+
+void ConvertHalfRGBAToBGRA8Scalar(const uint16_t* src, uint8_t* dst, size_t pixelCount, const Params& params)
+{
+    ConvertScalar(src, dst, pixelCount, MakeSetup(params));
+}
+
+const char* GetActiveKernelName()
+{
+    return GetKernelName(GetActiveKernel());
+}
+
+bool IsKernelAvailable(Kernel kernel)
+{
+    return kernel == Kernel::Scalar || GetKernelFn<uint16_t>(kernel) != ConvertScalar<uint16_t>;
+}
+
+void ConvertHalfRGBAToBGRA8With(Kernel kernel, const uint16_t* src, uint8_t* dst, size_t pixelCount,
+                                const Params& params)
+{
+    GetKernelFn<uint16_t>(kernel)(src, dst, pixelCount, MakeSetup(params));
+}
+
+void ConvertFloatRGBAToBGRA8(const float* src, uint8_t* dst, size_t pixelCount, const Params& params)
+{
+    GetKernelFn<float>(GetActiveKernel())(src, dst, pixelCount, MakeSetup(params));
+}
+
+void ConvertFloatRGBAToBGRA8With(Kernel kernel, const float* src, uint8_t* dst, size_t pixelCount,
+                                 const Params& params)
+{
+    GetKernelFn<float>(kernel)(src, dst, pixelCount, MakeSetup(params));
+}
+
+const char* GetKernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+        case Kernel::AVXF16C: return "AVX+F16C";
+        case Kernel::SSE2:    return "SSE2";
+        default:              return "Scalar";
+    }
+}
+
+} // namespace ExrTonemap
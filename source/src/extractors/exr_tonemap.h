@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Half- or float RGBA -> 8-bit BGRA conversion used by the EXR extractor
+// Does the load (half->float for half input), exposure, optional alpha premultiply, display curve and
+// 8-bit quantization in a single pass over the pixels.
+// The best kernel for the running CPU (AVX/F16C, SSE2 or scalar) is picked once at runtime.
+namespace ExrTonemap {
+
+    // Display transform applied after exposure
+    enum class Curve
+    {
+        Linear,  // Clamp to [0, 1], no encoding (legacy behaviour)
+        SRGB,    // Clamp to [0, 1], sRGB OETF
+        Filmic   // ACES-style filmic shoulder over [0, 8], then sRGB OETF
+    };
+
+    struct Params
+    {
+        float exposure = 0.0f;          // Exposure adjustment in stops
+        Curve curve = Curve::SRGB;
+        bool premultiplyAlpha = false;  // Multiply RGB by alpha before the curve
+    };
+
+    // Convert interleaved RGBA half pixels to BGRA8 (Windows DIB byte order)
+    // @param src - pixelCount * 4 half values (raw 16-bit bit patterns)
+    // @param dst - pixelCount * 4 bytes
+    void ConvertHalfRGBAToBGRA8(const uint16_t* src, uint8_t* dst, size_t pixelCount, const Params& params);
+
+    // Reference implementation - the SIMD kernels produce bit-identical output
+    void ConvertHalfRGBAToBGRA8Scalar(const uint16_t* src, uint8_t* dst, size_t pixelCount, const Params& params);
+
+    // Convert interleaved RGBA float pixels (e.g. the downscaler's float output) to BGRA8
+    // Same transform as the half entry point, without rounding the input to half first
+    void ConvertFloatRGBAToBGRA8(const float* src, uint8_t* dst, size_t pixelCount, const Params& params);
+
+    // Name of the kernel selected by runtime CPU dispatch ("AVX+F16C", "SSE2" or "Scalar")
+    const char* GetActiveKernelName();
+
+    // The individual kernels, for tests and benchmarks that compare them
+    enum class Kernel
+    {
+        Scalar,
+        SSE2,
+        AVXF16C
+    };
+
+    // True if this build and the running CPU can run the kernel
+    bool IsKernelAvailable(Kernel kernel);
+
+    // Convert with one specific kernel (falls back to the scalar reference if it is unavailable)
+    void ConvertHalfRGBAToBGRA8With(Kernel kernel, const uint16_t* src, uint8_t* dst, size_t pixelCount,
+                                    const Params& params);
+    void ConvertFloatRGBAToBGRA8With(Kernel kernel, const float* src, uint8_t* dst, size_t pixelCount,
+                                     const Params& params);
+
+    const char* GetKernelName(Kernel kernel);
+
+} // namespace ExrTonemap
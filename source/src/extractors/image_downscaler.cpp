@@ -0,0 +1,325 @@
+#include "image_downscaler.h"
+#include <algorithm>
+#include <cmath>
+
+// UFB_DOWNSCALER_NO_SIMD builds the scalar paths only (the tests build both)
+#if !defined(UFB_DOWNSCALER_NO_SIMD) && \
+    (defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define UFB_DOWNSCALER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+double Sinc(double x)
+{
+    if (x == 0.0)
+        return 1.0;
+    x *= kPi;
+    return std::sin(x) / x;
+}
+
+double Lanczos3(double x)
+{
+    if (x <= -3.0 || x >= 3.0)
+        return 0.0;
+    return Sinc(x) * Sinc(x / 3.0);
+}
+
+} // namespace
+
+ImageDownscaler::ImageDownscaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, Filter filter)
+    : m_srcWidth((std::max)(1, srcWidth)), m_srcHeight((std::max)(1, srcHeight)),
+      m_dstWidth((std::max)(1, dstWidth)), m_dstHeight((std::max)(1, dstHeight))
+{
+    m_horizontal = ComputeWeights(m_srcWidth, m_dstWidth, filter);
+    m_vertical = ComputeWeights(m_srcHeight, m_dstHeight, filter);
+
+    m_sourceRow.resize(static_cast<size_t>(m_srcWidth) * 4);
+    m_ring.resize(static_cast<size_t>(m_vertical.maxTaps) * m_dstWidth * 4);
+    m_outputRow.resize(static_cast<size_t>(m_dstWidth) * 4);
+}
+
+void ImageDownscaler::SetOutputBGRA8(uint8_t* dst, size_t strideBytes)
+{
+    m_outBGRA8 = dst;
+    m_outStrideBytes = strideBytes;
+}
+
+void ImageDownscaler::SetOutputFloat(float* dst, size_t strideFloats)
+{
+    m_outFloat = dst;
+    m_outStrideFloats = strideFloats;
+}
+
+void ImageDownscaler::FitSize(int width, int height, int size, int& outWidth, int& outHeight)
+{
+    width = (std::max)(1, width);
+    height = (std::max)(1, height);
+
+    if (width >= height)
+    {
+        outWidth = (std::min)(size, width);
+        outHeight = (std::max)(1, static_cast<int>(static_cast<int64_t>(height) * outWidth / width));
+    }
+    else
+    {
+        outHeight = (std::min)(size, height);
+        outWidth = (std::max)(1, static_cast<int>(static_cast<int64_t>(width) * outHeight / height));
+    }
+}
+
+ImageDownscaler::AxisWeights ImageDownscaler::ComputeWeights(int srcSize, int dstSize, Filter filter)
+{
+    AxisWeights axis;
+    axis.contributions.resize(dstSize);
+
+    const double scale = static_cast<double>(srcSize) / dstSize;
+    std::vector<std::vector<std::pair<int, double>>> taps(dstSize);
+
+    for (int i = 0; i < dstSize; i++)
+    {
+        auto& list = taps[i];
+
+        if (filter == Filter::Box)
+        {
+            // Coverage of source pixel j by the output pixel footprint [lo, hi)
+            double lo = i * scale;
+            double hi = (i + 1) * scale;
+            int first = static_cast<int>(std::floor(lo));
+            int last = (std::min)(srcSize - 1, static_cast<int>(std::ceil(hi)) - 1);
+            for (int j = first; j <= last; j++)
+            {
+                double overlap = (std::min)(hi, j + 1.0) - (std::max)(lo, static_cast<double>(j));
+                if (overlap > 0.0)
+                    list.push_back({ j, overlap });
+            }
+        }
+        else
+        {
+            // Stretch the kernel when downscaling so it also low-pass filters
+            double filterScale = (std::max)(1.0, scale);
+            double support = 3.0 * filterScale;
+            double center = (i + 0.5) * scale;
+            int first = (std::max)(0, static_cast<int>(std::floor(center - support)));
+            int last = (std::min)(srcSize - 1, static_cast<int>(std::ceil(center + support)));
+            for (int j = first; j <= last; j++)
+            {
+                double w = Lanczos3((j + 0.5 - center) / filterScale);
+                if (w != 0.0)
+                    list.push_back({ j, w });
+            }
+        }
+
+        // Degenerate footprint (only possible at the edges) - fall back to nearest pixel
+        if (list.empty())
+        {
+            int nearest = (std::min)(srcSize - 1, static_cast<int>((i + 0.5) * scale));
+            list.push_back({ nearest, 1.0 });
+        }
+
+        axis.maxTaps = (std::max)(axis.maxTaps, list.back().first - list.front().first + 1);
+    }
+
+    axis.weights.assign(static_cast<size_t>(dstSize) * axis.maxTaps, 0.0f);
+
+    for (int i = 0; i < dstSize; i++)
+    {
+        const auto& list = taps[i];
+        double total = 0.0;
+        for (const auto& tap : list)
+            total += tap.second;
+
+        Contribution& c = axis.contributions[i];
+        c.start = list.front().first;
+        c.count = list.back().first - c.start + 1;
+
+        float* w = axis.weights.data() + static_cast<size_t>(i) * axis.maxTaps;
+        for (const auto& tap : list)
+            w[tap.first - c.start] = static_cast<float>(tap.second / total);
+    }
+
+    return axis;
+}
+
+void ImageDownscaler::ConvertRow(const void* row, PixelFormat format)
+{
+    float* dst = m_sourceRow.data();
+    const int width = m_srcWidth;
+
+    switch (format)
+    {
+        case PixelFormat::RGB8:
+        {
+            const uint8_t* src = static_cast<const uint8_t*>(row);
+            for (int x = 0; x < width; x++)
+            {
+                dst[x * 4 + 0] = src[x * 3 + 2];
+                dst[x * 4 + 1] = src[x * 3 + 1];
+                dst[x * 4 + 2] = src[x * 3 + 0];
+                dst[x * 4 + 3] = 255.0f;
+            }
+            break;
+        }
+        case PixelFormat::RGBA8:
+        {
+            const uint8_t* src = static_cast<const uint8_t*>(row);
+            for (int x = 0; x < width; x++)
+            {
+                dst[x * 4 + 0] = src[x * 4 + 2];
+                dst[x * 4 + 1] = src[x * 4 + 1];
+                dst[x * 4 + 2] = src[x * 4 + 0];
+                dst[x * 4 + 3] = src[x * 4 + 3];
+            }
+            break;
+        }
+        case PixelFormat::BGRA8:
+        {
+            const uint8_t* src = static_cast<const uint8_t*>(row);
+            int x = 0;
+#ifdef UFB_DOWNSCALER_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+                __m128i lo = _mm_unpacklo_epi8(px, zero);
+                __m128i hi = _mm_unpackhi_epi8(px, zero);
+                _mm_storeu_ps(dst + x * 4 + 0, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+                _mm_storeu_ps(dst + x * 4 + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+                _mm_storeu_ps(dst + x * 4 + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+                _mm_storeu_ps(dst + x * 4 + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+            }
+#endif
+            for (; x < width; x++)
+            {
+                dst[x * 4 + 0] = src[x * 4 + 0];
+                dst[x * 4 + 1] = src[x * 4 + 1];
+                dst[x * 4 + 2] = src[x * 4 + 2];
+                dst[x * 4 + 3] = src[x * 4 + 3];
+            }
+            break;
+        }
+        case PixelFormat::RGBAF32:
+            std::copy_n(static_cast<const float*>(row), static_cast<size_t>(width) * 4, dst);
+            break;
+    }
+}
+
+void ImageDownscaler::FilterHorizontal(float* dst) const
+{
+    const float* src = m_sourceRow.data();
+    const int maxTaps = m_horizontal.maxTaps;
+
+    for (int x = 0; x < m_dstWidth; x++)
+    {
+        const Contribution& c = m_horizontal.contributions[x];
+        const float* w = m_horizontal.weights.data() + static_cast<size_t>(x) * maxTaps;
+        const float* px = src + static_cast<size_t>(c.start) * 4;
+
+#ifdef UFB_DOWNSCALER_SSE2
+        // One pixel (4 channels) per register
+        __m128 acc = _mm_setzero_ps();
+        for (int k = 0; k < c.count; k++)
+        {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(w[k]), _mm_loadu_ps(px + k * 4)));
+        }
+        _mm_storeu_ps(dst + x * 4, acc);
+#else
+        float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int k = 0; k < c.count; k++)
+        {
+            acc[0] += w[k] * px[k * 4 + 0];
+            acc[1] += w[k] * px[k * 4 + 1];
+            acc[2] += w[k] * px[k * 4 + 2];
+            acc[3] += w[k] * px[k * 4 + 3];
+        }
+        std::copy_n(acc, 4, dst + x * 4);
+#endif
+    }
+}
+
+void ImageDownscaler::PushRow(const void* row, PixelFormat format)
+{
+    if (m_nextSrcRow >= m_srcHeight || IsComplete())
+        return;
+
+    const int srcY = m_nextSrcRow++;
+    const size_t rowFloats = static_cast<size_t>(m_dstWidth) * 4;
+
+    // Rows before the next output row's footprint are not needed by anyone
+    if (srcY < m_vertical.contributions[m_nextDstRow].start)
+        return;
+
+    ConvertRow(row, format);
+    FilterHorizontal(m_ring.data() + static_cast<size_t>(srcY % m_vertical.maxTaps) * rowFloats);
+
+    // Emit every output row whose footprint ends at this source row
+    while (!IsComplete())
+    {
+        const Contribution& c = m_vertical.contributions[m_nextDstRow];
+        if (c.start + c.count - 1 > srcY)
+            break;
+        EmitRow(m_nextDstRow++);
+    }
+}
+
+void ImageDownscaler::EmitRow(int dstY)
+{
+    const Contribution& c = m_vertical.contributions[dstY];
+    const float* w = m_vertical.weights.data() + static_cast<size_t>(dstY) * m_vertical.maxTaps;
+    const size_t rowFloats = static_cast<size_t>(m_dstWidth) * 4;
+    float* out = m_outputRow.data();
+
+    std::fill(m_outputRow.begin(), m_outputRow.end(), 0.0f);
+
+    for (int k = 0; k < c.count; k++)
+    {
+        const float weight = w[k];
+        const float* src = m_ring.data() + static_cast<size_t>((c.start + k) % m_vertical.maxTaps) * rowFloats;
+        size_t i = 0;
+#ifdef UFB_DOWNSCALER_SSE2
+        const __m128 wv = _mm_set1_ps(weight);
+        for (; i + 4 <= rowFloats; i += 4)
+        {
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(wv, _mm_loadu_ps(src + i))));
+        }
+#endif
+        for (; i < rowFloats; i++)
+        {
+            out[i] += weight * src[i];
+        }
+    }
+
+    if (m_outFloat)
+    {
+        std::copy_n(out, rowFloats, m_outFloat + static_cast<size_t>(dstY) * m_outStrideFloats);
+    }
+
+    if (m_outBGRA8)
+    {
+        uint8_t* dst = m_outBGRA8 + static_cast<size_t>(dstY) * m_outStrideBytes;
+        size_t i = 0;
+#ifdef UFB_DOWNSCALER_SSE2
+        // Round, saturate to [0, 255] and pack 4 pixels at a time
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 maxValue = _mm_set1_ps(255.0f);
+        for (; i + 16 <= rowFloats; i += 16)
+        {
+            __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i + 0), zero), maxValue), half));
+            __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i + 4), zero), maxValue), half));
+            __m128i c4 = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i + 8), zero), maxValue), half));
+            __m128i d = _mm_cvttps_epi32(_mm_add_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i + 12), zero), maxValue), half));
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c4, d));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+#endif
+        for (; i < rowFloats; i++)
+        {
+            float v = (std::min)(255.0f, (std::max)(0.0f, out[i]));
+            dst[i] = static_cast<uint8_t>(v + 0.5f);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Streaming separable image downscaler shared by the thumbnail extractors
+// Source rows are pushed top to bottom as the decoder produces them; each row is
+// filtered horizontally once and kept in a small ring buffer until every output row
+// that needs it has been written. Peak memory is one source row plus
+// (vertical taps x output row), independent of the source height.
+//
+// Usage:
+//   ImageDownscaler scaler(srcW, srcH, dstW, dstH);
+//   scaler.SetOutputBGRA8(dibBits, dstW * 4);
+//   for (each decoded row) scaler.PushRow(row, ImageDownscaler::PixelFormat::RGBA8);
+class ImageDownscaler
+{
+public:
+    enum class Filter
+    {
+        Box,      // Exact area average (default, no ringing)
+        Lanczos3  // Sharper, 3-lobe windowed sinc
+    };
+
+    enum class PixelFormat
+    {
+        RGB8,     // 3 bytes per pixel, alpha treated as 255
+        RGBA8,
+        BGRA8,
+        RGBAF32   // 4 floats per pixel
+    };
+
+    ImageDownscaler(int srcWidth, int srcHeight, int dstWidth, int dstHeight, Filter filter = Filter::Box);
+
+    // Write 8-bit BGRA output rows (Windows DIB order); 8-bit inputs are swizzled as needed
+    void SetOutputBGRA8(uint8_t* dst, size_t strideBytes);
+
+    // Write 4-channel float output rows, in the same channel order as an RGBAF32 input
+    void SetOutputFloat(float* dst, size_t strideFloats);
+
+    // Push the next source row (must be called srcHeight times, top to bottom)
+    void PushRow(const void* row, PixelFormat format);
+
+    // True once every output row has been written
+    bool IsComplete() const { return m_nextDstRow >= m_dstHeight; }
+
+    int GetSourceWidth() const { return m_srcWidth; }
+    int GetSourceHeight() const { return m_srcHeight; }
+
+    // Fit width x height into a size x size box, preserving aspect (never upscales)
+    static void FitSize(int width, int height, int size, int& outWidth, int& outHeight);
+
+private:
+    // Filter taps for one output pixel/row, weights stored at index * m_maxTaps
+    struct Contribution
+    {
+        int start;
+        int count;
+    };
+
+    struct AxisWeights
+    {
+        std::vector<Contribution> contributions;
+        std::vector<float> weights;
+        int maxTaps = 0;
+    };
+
+    static AxisWeights ComputeWeights(int srcSize, int dstSize, Filter filter);
+
+    void ConvertRow(const void* row, PixelFormat format);
+    void FilterHorizontal(float* dst) const;
+    void EmitRow(int dstY);
+
+    int m_srcWidth, m_srcHeight, m_dstWidth, m_dstHeight;
+
+    AxisWeights m_horizontal;
+    AxisWeights m_vertical;
+
+    std::vector<float> m_sourceRow;  // Current source row as float BGRA/RGBA
+    std::vector<float> m_ring;       // Horizontally filtered rows, m_vertical.maxTaps slots
+    std::vector<float> m_outputRow;
+
+    int m_nextSrcRow = 0;
+    int m_nextDstRow = 0;
+
+    uint8_t* m_outBGRA8 = nullptr;
+    size_t m_outStrideBytes = 0;
+    float* m_outFloat = nullptr;
+    size_t m_outStrideFloats = 0;
+};
@@ -1,8 +1,14 @@
 #include "image_thumbnail_extractor.h"
+#include "image_downscaler.h"
 #include <windows.h>
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstring>
+#include <csetjmp>
 
 // libjpeg-turbo
 #include <jpeglib.h>
@@ -14,8 +20,129 @@
 // libtiff
 #include <tiffio.h>
 
-// Define static mutex
-std::mutex ImageThumbnailExtractor::s_tiffMutex;
+namespace {
+
+// Largest decoded band held at once for strip/tile reads
+constexpr size_t kMaxBandBytes = 64ULL * 1024 * 1024;
+
+// Full-resolution fallbacks (interlaced PNG, bottom-up TIFF) still need one whole RGBA raster
+constexpr uint64_t kMaxFullRasterBytes = 200ULL * 1024 * 1024;
+
+// libjpeg error manager that longjmps back instead of calling exit()
+struct JpegErrorManager
+{
+    jpeg_error_mgr pub;
+    jmp_buf jumpBuffer;
+};
+
+void JpegErrorExit(j_common_ptr cinfo)
+{
+    JpegErrorManager* err = reinterpret_cast<JpegErrorManager*>(cinfo->err);
+    longjmp(err->jumpBuffer, 1);
+}
+
+void JpegOutputMessage(j_common_ptr)
+{
+    // Corrupt-data warnings are expected on partial files - stay quiet
+}
+
+// True when a reduced image keeps the aspect ratio of the full image (within 2%)
+bool SameAspect(uint32_t width, uint32_t height, uint32_t fullWidth, uint32_t fullHeight)
+{
+    double aspect = static_cast<double>(width) / height;
+    double fullAspect = static_cast<double>(fullWidth) / fullHeight;
+    return std::abs(aspect - fullAspect) <= fullAspect * 0.02;
+}
+
+uint16_t ReadU16(const uint8_t* p, bool littleEndian)
+{
+    return littleEndian ? static_cast<uint16_t>(p[0] | (p[1] << 8))
+                        : static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t ReadU32(const uint8_t* p, bool littleEndian)
+{
+    return littleEndian ? (static_cast<uint32_t>(p[0]) | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24))
+                        : ((static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | static_cast<uint32_t>(p[3]));
+}
+
+// Locate the JPEG thumbnail stored in IFD1 of an EXIF APP1 segment
+// @return true and the byte range inside the segment, or false if there is none
+bool FindExifThumbnail(const uint8_t* data, size_t length, size_t& outOffset, size_t& outLength)
+{
+    static const uint8_t kExifHeader[6] = { 'E', 'x', 'i', 'f', 0, 0 };
+    if (length < 6 + 8 || memcmp(data, kExifHeader, 6) != 0)
+        return false;
+
+    const uint8_t* tiff = data + 6;
+    const size_t tiffLength = length - 6;
+
+    bool littleEndian;
+    if (tiff[0] == 'I' && tiff[1] == 'I')
+        littleEndian = true;
+    else if (tiff[0] == 'M' && tiff[1] == 'M')
+        littleEndian = false;
+    else
+        return false;
+
+    // IFD0 -> skip its entries -> IFD1
+    // Offsets come from the file: compare against what's left (tiffLength >= 8) so that no
+    // offset + size can wrap around
+    size_t ifd0 = ReadU32(tiff + 4, littleEndian);
+    if (ifd0 > tiffLength - 2)
+        return false;
+    uint16_t ifd0Entries = ReadU16(tiff + ifd0, littleEndian);
+    size_t ifd0Size = 2 + static_cast<size_t>(ifd0Entries) * 12;
+    if (ifd0Size > tiffLength - ifd0 || 4 > tiffLength - ifd0 - ifd0Size)
+        return false;
+    size_t nextOffsetPos = ifd0 + ifd0Size;
+
+    size_t ifd1 = ReadU32(tiff + nextOffsetPos, littleEndian);
+    if (ifd1 == 0 || ifd1 > tiffLength - 2)
+        return false;
+
+    uint16_t ifd1Entries = ReadU16(tiff + ifd1, littleEndian);
+    uint32_t thumbOffset = 0;
+    uint32_t thumbLength = 0;
+
+    for (uint16_t i = 0; i < ifd1Entries; i++)
+    {
+        size_t entryOffset = 2 + static_cast<size_t>(i) * 12;
+        if (entryOffset > tiffLength - ifd1 || 12 > tiffLength - ifd1 - entryOffset)
+            return false;
+        size_t entry = ifd1 + entryOffset;
+
+        uint16_t tag = ReadU16(tiff + entry, littleEndian);
+        if (tag == 0x0201)       // JPEGInterchangeFormat
+            thumbOffset = ReadU32(tiff + entry + 8, littleEndian);
+        else if (tag == 0x0202)  // JPEGInterchangeFormatLength
+            thumbLength = ReadU32(tiff + entry + 8, littleEndian);
+    }
+
+    if (thumbOffset == 0 || thumbLength == 0 || thumbOffset > tiffLength || thumbLength > tiffLength - thumbOffset)
+        return false;
+
+    outOffset = 6 + static_cast<size_t>(thumbOffset);
+    outLength = thumbLength;
+    return true;
+}
+
+} // namespace
+
+// State that must outlive a longjmp out of libjpeg/libpng (created before setjmp)
+struct ImageThumbnailExtractor::DecodeState
+{
+    std::vector<uint8_t> rowBuffer;
+    std::unique_ptr<ImageDownscaler> scaler;
+    HBITMAP hBitmap = nullptr;
+
+    void Discard()
+    {
+        if (hBitmap)
+            DeleteObject(hBitmap);
+        hBitmap = nullptr;
+    }
+};
 
 ImageThumbnailExtractor::ImageThumbnailExtractor()
 {
@@ -63,12 +190,6 @@ HBITMAP ImageThumbnailExtractor::Extract(const std::wstring& path, int size)
 
 HBITMAP ImageThumbnailExtractor::ExtractJPEG(const std::wstring& path, int size)
 {
-    // Convert wide string to UTF-8
-    int utf8Size = WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, nullptr, 0, nullptr, nullptr);
-    std::string pathUtf8(utf8Size, '\0');
-    WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, &pathUtf8[0], utf8Size, nullptr, nullptr);
-    pathUtf8.resize(utf8Size - 1);
-
     // Open JPEG file
     FILE* infile = nullptr;
     if (_wfopen_s(&infile, path.c_str(), L"rb") != 0 || !infile)
@@ -78,57 +199,171 @@ HBITMAP ImageThumbnailExtractor::ExtractJPEG(const std::wstring& path, int size)
 
     // Setup libjpeg decompression
     struct jpeg_decompress_struct cinfo;
-    struct jpeg_error_mgr jerr;
+    JpegErrorManager jerr;
+    DecodeState state;
+
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = JpegErrorExit;
+    jerr.pub.output_message = JpegOutputMessage;
+
+    if (setjmp(jerr.jumpBuffer))
+    {
+        // Corrupt or truncated file
+        jpeg_destroy_decompress(&cinfo);
+        fclose(infile);
+        state.Discard();
+        return nullptr;
+    }
 
-    cinfo.err = jpeg_std_error(&jerr);
     jpeg_create_decompress(&cinfo);
     jpeg_stdio_src(&cinfo, infile);
+    jpeg_save_markers(&cinfo, JPEG_APP0 + 1, 0xFFFF);  // Keep APP1 (EXIF) for the embedded thumbnail
     jpeg_read_header(&cinfo, TRUE);
 
+    // Prefer the EXIF thumbnail when it already covers the requested size
+    for (jpeg_saved_marker_ptr marker = cinfo.marker_list; marker; marker = marker->next)
+    {
+        size_t thumbOffset, thumbLength;
+        if (marker->marker == JPEG_APP0 + 1 &&
+            FindExifThumbnail(marker->data, marker->data_length, thumbOffset, thumbLength))
+        {
+            HBITMAP hThumb = DecodeEmbeddedJPEG(marker->data + thumbOffset, thumbLength,
+                                                cinfo.image_width, cinfo.image_height, size);
+            if (hThumb)
+            {
+                jpeg_destroy_decompress(&cinfo);
+                fclose(infile);
+                return hThumb;
+            }
+            break;
+        }
+    }
+
+    DecodeJPEGRows(&cinfo, size, state);
+
+    jpeg_destroy_decompress(&cinfo);
+    fclose(infile);
+
+    return state.hBitmap;
+}
+
+HBITMAP ImageThumbnailExtractor::DecodeEmbeddedJPEG(const uint8_t* data, size_t length,
+                                                    uint32_t fullWidth, uint32_t fullHeight, int size)
+{
+    struct jpeg_decompress_struct cinfo;
+    JpegErrorManager jerr;
+    DecodeState state;
+
+    cinfo.err = jpeg_std_error(&jerr.pub);
+    jerr.pub.error_exit = JpegErrorExit;
+    jerr.pub.output_message = JpegOutputMessage;
+
+    if (setjmp(jerr.jumpBuffer))
+    {
+        jpeg_destroy_decompress(&cinfo);
+        state.Discard();
+        return nullptr;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, data, static_cast<unsigned long>(length));
+    jpeg_read_header(&cinfo, TRUE);
+
+    // Only use it if it is big enough and not letterboxed to a different aspect
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(static_cast<int>(fullWidth), static_cast<int>(fullHeight), size, thumbWidth, thumbHeight);
+
+    if (static_cast<int>(cinfo.image_width) < thumbWidth || static_cast<int>(cinfo.image_height) < thumbHeight ||
+        !SameAspect(cinfo.image_width, cinfo.image_height, fullWidth, fullHeight))
+    {
+        jpeg_destroy_decompress(&cinfo);
+        return nullptr;
+    }
+
+    DecodeJPEGRows(&cinfo, size, state);
+    jpeg_destroy_decompress(&cinfo);
+
+    return state.hBitmap;
+}
+
+void ImageThumbnailExtractor::DecodeJPEGRows(jpeg_decompress_struct* cinfo, int size, DecodeState& state)
+{
     // Calculate scale factor for fast decoding
     int scale = 1;
-    while (cinfo.image_width / (scale * 2) >= size && cinfo.image_height / (scale * 2) >= size && scale < 8)
+    while (static_cast<int>(cinfo->image_width / (scale * 2)) >= size &&
+           static_cast<int>(cinfo->image_height / (scale * 2)) >= size && scale < 8)
     {
         scale *= 2;
     }
-    cinfo.scale_num = 1;
-    cinfo.scale_denom = scale;
+    cinfo->scale_num = 1;
+    cinfo->scale_denom = scale;
 
-    // Request RGB output
-    cinfo.out_color_space = JCS_RGB;
+    // Request BGRA output (libjpeg-turbo extension) so rows can be fed straight to the scaler
+    cinfo->out_color_space = JCS_EXT_BGRA;
 
-    jpeg_start_decompress(&cinfo);
+    // At 1/8 scale only DC coefficients are used, and progressive files send those first:
+    // stop reading once the DC scans are in instead of decoding every refinement pass.
+    // Only progressive files track per-coefficient progress (coef_bits); multi-scan sequential
+    // files take the normal scaled decode
+    const bool dcOnly = (scale == 8) && cinfo->progressive_mode;
+    cinfo->buffered_image = dcOnly ? TRUE : FALSE;
 
-    int width = cinfo.output_width;
-    int height = cinfo.output_height;
-    int channels = cinfo.output_components;
+    jpeg_start_decompress(cinfo);
 
-    // Allocate row buffer
-    unsigned char* rowData = new unsigned char[width * channels];
-    unsigned char* imageData = new unsigned char[width * height * channels];
-
-    // Read scanlines
-    int row = 0;
-    while (cinfo.output_scanline < cinfo.output_height)
+    if (dcOnly)
     {
-        unsigned char* rowPtr = rowData;
-        jpeg_read_scanlines(&cinfo, &rowPtr, 1);
-        memcpy(imageData + row * width * channels, rowData, width * channels);
-        row++;
+        while (!jpeg_input_complete(cinfo))
+        {
+            bool dcStarted = cinfo->coef_bits != nullptr;     // Unknown: read everything
+            for (int c = 0; dcStarted && c < cinfo->num_components; c++)
+            {
+                if (cinfo->coef_bits[c][0] < 0)
+                    dcStarted = false;
+            }
+
+            int scanBefore = cinfo->input_scan_number;
+            int result = jpeg_consume_input(cinfo);
+            if (result == JPEG_SUSPENDED || result == JPEG_REACHED_EOI)
+                break;
+            if (result == JPEG_REACHED_SOS && dcStarted && cinfo->input_scan_number > scanBefore)
+                break;  // The scan that completed the DC data has been fully read
+        }
+
+        jpeg_start_output(cinfo, cinfo->input_scan_number);
     }
 
-    delete[] rowData;
+    int width = cinfo->output_width;
+    int height = cinfo->output_height;
 
-    jpeg_finish_decompress(&cinfo);
-    jpeg_destroy_decompress(&cinfo);
-    fclose(infile);
+    // DCT scaling gets within 2x of the target; the downscaler does the rest
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(width, height, size, thumbWidth, thumbHeight);
+
+    uint8_t* pBits = nullptr;
+    state.hBitmap = CreateThumbnailDIB(thumbWidth, thumbHeight, &pBits);
+    if (!state.hBitmap)
+    {
+        jpeg_abort_decompress(cinfo);
+        return;
+    }
 
-    // Create HBITMAP
-    HBITMAP hBitmap = CreateHBITMAPFromRGB(imageData, width, height, channels);
+    state.scaler = std::make_unique<ImageDownscaler>(width, height, thumbWidth, thumbHeight);
+    state.scaler->SetOutputBGRA8(pBits, static_cast<size_t>(thumbWidth) * 4);
+    state.rowBuffer.resize(static_cast<size_t>(width) * 4);
 
-    delete[] imageData;
+    // Stream scanlines through the scaler (only one decoded row is held at a time)
+    while (cinfo->output_scanline < cinfo->output_height)
+    {
+        unsigned char* rowPtr = state.rowBuffer.data();
+        jpeg_read_scanlines(cinfo, &rowPtr, 1);
+        state.scaler->PushRow(rowPtr, ImageDownscaler::PixelFormat::BGRA8);
+    }
 
-    return hBitmap;
+    if (dcOnly)
+        jpeg_finish_output(cinfo);
+
+    // Skip the remaining data (trailing scans/markers are not needed)
+    jpeg_abort_decompress(cinfo);
 }
 
 HBITMAP ImageThumbnailExtractor::ExtractPNG(const std::wstring& path, int size)
@@ -142,8 +377,7 @@ HBITMAP ImageThumbnailExtractor::ExtractPNG(const std::wstring& path, int size)
 
     // Check PNG signature
     unsigned char header[8];
-    fread(header, 1, 8, infile);
-    if (png_sig_cmp(header, 0, 8))
+    if (fread(header, 1, 8, infile) != 8 || png_sig_cmp(header, 0, 8))
     {
         fclose(infile);
         return nullptr;
@@ -165,10 +399,13 @@ HBITMAP ImageThumbnailExtractor::ExtractPNG(const std::wstring& path, int size)
         return nullptr;
     }
 
+    DecodeState state;
+
     if (setjmp(png_jmpbuf(png_ptr)))
     {
         png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
         fclose(infile);
+        state.Discard();
         return nullptr;
     }
 
@@ -181,7 +418,7 @@ HBITMAP ImageThumbnailExtractor::ExtractPNG(const std::wstring& path, int size)
     png_byte color_type = png_get_color_type(png_ptr, info_ptr);
     png_byte bit_depth = png_get_bit_depth(png_ptr, info_ptr);
 
-    // Convert to RGBA
+    // Convert to BGRA (libpng does the swizzle while unfiltering each row)
     if (bit_depth == 16)
         png_set_strip_16(png_ptr);
     if (color_type == PNG_COLOR_TYPE_PALETTE)
@@ -194,131 +431,263 @@ HBITMAP ImageThumbnailExtractor::ExtractPNG(const std::wstring& path, int size)
         png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
     if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
         png_set_gray_to_rgb(png_ptr);
+    png_set_bgr(png_ptr);
+
+    int passes = png_set_interlace_handling(png_ptr);
 
     png_read_update_info(png_ptr, info_ptr);
 
-    // Allocate row pointers
-    png_bytep* row_pointers = new png_bytep[height];
-    unsigned char* imageData = new unsigned char[width * height * 4];
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(width, height, size, thumbWidth, thumbHeight);
 
-    for (int y = 0; y < height; y++)
+    uint8_t* pBits = nullptr;
+    state.hBitmap = CreateThumbnailDIB(thumbWidth, thumbHeight, &pBits);
+    if (!state.hBitmap)
     {
-        row_pointers[y] = imageData + y * width * 4;
+        png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+        fclose(infile);
+        return nullptr;
     }
 
-    png_read_image(png_ptr, row_pointers);
+    state.scaler = std::make_unique<ImageDownscaler>(width, height, thumbWidth, thumbHeight);
+    state.scaler->SetOutputBGRA8(pBits, static_cast<size_t>(thumbWidth) * 4);
 
-    delete[] row_pointers;
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
 
-    png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
-    fclose(infile);
-
-    // Convert RGBA to BGRA (libpng outputs RGBA, Windows needs BGRA)
-    for (int i = 0; i < width * height; i++)
+    if (passes == 1)
     {
-        unsigned char r = imageData[i * 4 + 0];
-        unsigned char b = imageData[i * 4 + 2];
-        imageData[i * 4 + 0] = b;  // Swap R and B
-        imageData[i * 4 + 2] = r;
+        // Non-interlaced: decode one row at a time straight into the scaler
+        state.rowBuffer.resize(rowBytes);
+        for (int y = 0; y < height; y++)
+        {
+            png_read_row(png_ptr, state.rowBuffer.data(), nullptr);
+            state.scaler->PushRow(state.rowBuffer.data(), ImageDownscaler::PixelFormat::BGRA8);
+        }
     }
+    else
+    {
+        // Adam7 spreads every row across seven passes, so the full image is needed
+        if (rowBytes * height > kMaxFullRasterBytes)
+        {
+            png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+            fclose(infile);
+            state.Discard();
+            return nullptr;
+        }
 
-    // Create HBITMAP
-    HBITMAP hBitmap = CreateHBITMAPFromRGB(imageData, width, height, 4);
+        state.rowBuffer.resize(rowBytes * height);
+        std::vector<png_bytep> rowPointers(height);
+        for (int y = 0; y < height; y++)
+        {
+            rowPointers[y] = state.rowBuffer.data() + y * rowBytes;
+        }
 
-    delete[] imageData;
+        png_read_image(png_ptr, rowPointers.data());
 
-    return hBitmap;
+        for (int y = 0; y < height; y++)
+        {
+            state.scaler->PushRow(rowPointers[y], ImageDownscaler::PixelFormat::BGRA8);
+        }
+    }
+
+    // Trailing chunks (text, time, etc.) are not needed - skip png_read_end
+    png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+    fclose(infile);
+
+    return state.hBitmap;
 }
 
-HBITMAP ImageThumbnailExtractor::ExtractTIFF(const std::wstring& path, int size)
+bool ImageThumbnailExtractor::SelectTIFFImage(TIFF* tif, int size, bool& outIsReduced)
 {
-    // Check file size first (compressed size on disk)
-    try
-    {
-        uintmax_t fileSize = std::filesystem::file_size(path);
-        constexpr uintmax_t maxFileSize = 500ULL * 1024 * 1024; // 500MB
-
-        if (fileSize > maxFileSize)
+    uint32_t fullWidth = 0, fullHeight = 0;
+    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &fullWidth);
+    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &fullHeight);
+    if (fullWidth == 0 || fullHeight == 0)
+        return false;
+
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(static_cast<int>(fullWidth), static_cast<int>(fullHeight), size, thumbWidth, thumbHeight);
+
+    // Best candidate: smallest reduced-resolution image that still covers the thumbnail
+    uint64_t bestPixels = static_cast<uint64_t>(fullWidth) * fullHeight;
+    tdir_t bestDirectory = 0;
+    uint64_t bestSubIFD = 0;
+    bool found = false;
+
+    auto consider = [&](bool isSubIFD, tdir_t directory, uint64_t subIFDOffset) {
+        uint32_t subFileType = 0;
+        uint32_t width = 0, height = 0;
+        TIFFGetField(tif, TIFFTAG_SUBFILETYPE, &subFileType);
+        TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
+        TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
+
+        if (!(subFileType & FILETYPE_REDUCEDIMAGE) || (subFileType & FILETYPE_MASK))
+            return;
+        if (static_cast<int>(width) < thumbWidth || static_cast<int>(height) < thumbHeight)
+            return;
+        if (!SameAspect(width, height, fullWidth, fullHeight))
+            return;
+
+        uint64_t pixels = static_cast<uint64_t>(width) * height;
+        if (pixels < bestPixels)
         {
-            return nullptr;
+            bestPixels = pixels;
+            bestDirectory = directory;
+            bestSubIFD = isSubIFD ? subIFDOffset : 0;
+            found = true;
         }
+    };
+
+    // Pyramid levels stored as SubIFDs of the main image
+    uint16_t subIFDCount = 0;
+    uint64_t* subIFDArray = nullptr;
+    std::vector<uint64_t> subIFDs;
+    if (TIFFGetField(tif, TIFFTAG_SUBIFD, &subIFDCount, &subIFDArray) && subIFDArray)
+    {
+        subIFDs.assign(subIFDArray, subIFDArray + subIFDCount);
     }
-    catch (...)
+
+    for (uint64_t offset : subIFDs)
     {
-        return nullptr;
+        if (TIFFSetSubDirectory(tif, offset))
+            consider(true, 0, offset);
+    }
+
+    // Reduced images stored as following top-level IFDs (classic TIFF thumbnails/pyramids)
+    if (TIFFSetDirectory(tif, 0))
+    {
+        while (TIFFReadDirectory(tif))
+        {
+            consider(false, TIFFCurrentDirectory(tif), 0);
+        }
     }
 
-    // Convert wide string to UTF-8
-    int utf8Size = WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, nullptr, 0, nullptr, nullptr);
-    std::string pathUtf8(utf8Size, '\0');
-    WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, &pathUtf8[0], utf8Size, nullptr, nullptr);
-    pathUtf8.resize(utf8Size - 1);
+    outIsReduced = found;
+    if (found && bestSubIFD != 0)
+        return TIFFSetSubDirectory(tif, bestSubIFD) != 0;
+    return TIFFSetDirectory(tif, found ? bestDirectory : 0) != 0;
+}
 
-    // Open TIFF file
-    TIFF* tif = TIFFOpen(pathUtf8.c_str(), "r");
+HBITMAP ImageThumbnailExtractor::ExtractTIFF(const std::wstring& path, int size)
+{
+    // Open TIFF file (wide API so non-ASCII paths work)
+    TIFF* tif = TIFFOpenW(path.c_str(), "r");
     if (!tif)
     {
         return nullptr;
     }
 
-    uint32 width, height;
-    TIFFGetField(tif, TIFFTAG_IMAGEWIDTH, &width);
-    TIFFGetField(tif, TIFFTAG_IMAGELENGTH, &height);
-
-    // Check memory requirements BEFORE allocating
-    // We need 2 buffers: raster (width × height × 4) + imageData (width × height × 4) = 8 bytes per pixel
-    uint64_t pixelCount = static_cast<uint64_t>(width) * static_cast<uint64_t>(height);
-    uint64_t memoryNeeded = pixelCount * 8; // 8 bytes per pixel (two RGBA buffers)
-    constexpr uint64_t maxMemory = 200ULL * 1024 * 1024; // 200MB limit
-
-    if (memoryNeeded > maxMemory)
+    bool isReduced = false;
+    if (!SelectTIFFImage(tif, size, isReduced))
     {
         TIFFClose(tif);
         return nullptr;
     }
 
-    // Lock mutex to serialize large TIFF extractions (prevent concurrent multi-GB allocations)
-    std::lock_guard<std::mutex> lock(s_tiffMutex);
+    // Full-resolution decodes of huge files are still skipped (compressed size on disk)
+    if (!isReduced)
+    {
+        std::error_code ec;
+        uintmax_t fileSize = std::filesystem::file_size(path, ec);
+        constexpr uintmax_t maxFileSize = 500ULL * 1024 * 1024; // 500MB
+
+        if (ec || fileSize > maxFileSize)
+        {
+            TIFFClose(tif);
+            return nullptr;
+        }
+    }
 
-    // Allocate raster
-    uint32* raster = (uint32*)_TIFFmalloc(width * height * sizeof(uint32));
-    if (!raster)
+    char emsg[1024];
+    TIFFRGBAImage img;
+    if (!TIFFRGBAImageOK(tif, emsg) || !TIFFRGBAImageBegin(&img, tif, 0, emsg))
     {
         TIFFClose(tif);
         return nullptr;
     }
 
-    // Read RGBA image
-    if (!TIFFReadRGBAImageOriented(tif, width, height, raster, ORIENTATION_TOPLEFT))
+    const uint32_t width = img.width;
+    const uint32_t height = img.height;
+
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(static_cast<int>(width), static_cast<int>(height), size, thumbWidth, thumbHeight);
+
+    uint8_t* pBits = nullptr;
+    HBITMAP hBitmap = CreateThumbnailDIB(thumbWidth, thumbHeight, &pBits);
+    if (!hBitmap)
     {
-        _TIFFfree(raster);
+        TIFFRGBAImageEnd(&img);
         TIFFClose(tif);
         return nullptr;
     }
 
-    TIFFClose(tif);
+    ImageDownscaler scaler(static_cast<int>(width), static_cast<int>(height), thumbWidth, thumbHeight);
+    scaler.SetOutputBGRA8(pBits, static_cast<size_t>(thumbWidth) * 4);
+
+    // Files stored bottom-up cannot be streamed top-down band by band
+    uint16_t orientation = ORIENTATION_TOPLEFT;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_ORIENTATION, &orientation);
+    const bool topDown = (orientation == ORIENTATION_TOPLEFT || orientation == ORIENTATION_TOPRIGHT);
+
+    // Bands follow the file's strip/tile layout so every strip or tile is decoded once
+    uint32_t bandRows = height;
+    if (TIFFIsTiled(tif))
+        TIFFGetField(tif, TIFFTAG_TILELENGTH, &bandRows);
+    else
+        TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &bandRows);
 
-    // Convert RGBA to BGRA (Windows format)
-    unsigned char* imageData = new unsigned char[width * height * 4];
-    for (uint32 i = 0; i < width * height; i++)
+    const uint64_t rowBytes = static_cast<uint64_t>(width) * 4;
+    if (!topDown)
+    {
+        bandRows = height;
+        if (rowBytes * height > kMaxFullRasterBytes)
+        {
+            TIFFRGBAImageEnd(&img);
+            TIFFClose(tif);
+            DeleteObject(hBitmap);
+            return nullptr;
+        }
+    }
+    else
     {
-        imageData[i * 4 + 0] = TIFFGetB(raster[i]);  // B
-        imageData[i * 4 + 1] = TIFFGetG(raster[i]);  // G
-        imageData[i * 4 + 2] = TIFFGetR(raster[i]);  // R
-        imageData[i * 4 + 3] = TIFFGetA(raster[i]);  // A
+        bandRows = (std::min)(height, (std::max)(1u, bandRows));
+        uint32_t maxRows = static_cast<uint32_t>((std::max)(static_cast<uint64_t>(1), kMaxBandBytes / rowBytes));
+        bandRows = (std::min)(bandRows, maxRows);
     }
 
-    _TIFFfree(raster);
+    img.req_orientation = ORIENTATION_TOPLEFT;
 
-    // Create HBITMAP
-    HBITMAP hBitmap = CreateHBITMAPFromRGB(imageData, width, height, 4);
+    std::vector<uint32_t> band(static_cast<size_t>(width) * bandRows);
+    bool ok = true;
 
-    delete[] imageData;
+    for (uint32_t row = 0; row < height && ok; row += bandRows)
+    {
+        uint32_t rows = (std::min)(bandRows, height - row);
+        img.row_offset = static_cast<int>(row);
+        img.col_offset = 0;
+
+        ok = TIFFRGBAImageGet(&img, band.data(), width, rows) != 0;
+
+        // Raster words are R,G,B,A in memory order
+        for (uint32_t y = 0; y < rows && ok; y++)
+        {
+            scaler.PushRow(band.data() + static_cast<size_t>(y) * width, ImageDownscaler::PixelFormat::RGBA8);
+        }
+    }
+
+    TIFFRGBAImageEnd(&img);
+    TIFFClose(tif);
+
+    if (!ok)
+    {
+        DeleteObject(hBitmap);
+        return nullptr;
+    }
 
     return hBitmap;
 }
 
-HBITMAP ImageThumbnailExtractor::CreateHBITMAPFromRGB(unsigned char* data, int width, int height, int channels)
+HBITMAP ImageThumbnailExtractor::CreateThumbnailDIB(int width, int height, uint8_t** outBits)
 {
     // Create DIB section
     BITMAPINFO bmi = {};
@@ -336,28 +705,12 @@ HBITMAP ImageThumbnailExtractor::CreateHBITMAPFromRGB(unsigned char* data, int w
 
     if (!hBitmap || !pBits)
     {
+        if (hBitmap)
+            DeleteObject(hBitmap);
+        *outBits = nullptr;
         return nullptr;
     }
 
-    // Copy and convert to BGRA
-    unsigned char* dst = (unsigned char*)pBits;
-
-    if (channels == 3)
-    {
-        // RGB to BGRA
-        for (int i = 0; i < width * height; i++)
-        {
-            dst[i * 4 + 0] = data[i * 3 + 2]; // B
-            dst[i * 4 + 1] = data[i * 3 + 1]; // G
-            dst[i * 4 + 2] = data[i * 3 + 0]; // R
-            dst[i * 4 + 3] = 255;              // A
-        }
-    }
-    else if (channels == 4)
-    {
-        // Already BGRA (converted before calling this function)
-        memcpy(dst, data, width * height * 4);
-    }
-
+    *outBits = static_cast<uint8_t*>(pBits);
     return hBitmap;
 }
@@ -3,9 +3,15 @@
 #include "../thumbnail_extractor.h"
 #include <set>
 #include <string>
-#include <mutex>
+#include <cstdint>
+
+struct jpeg_decompress_struct;
+struct tiff;
+typedef struct tiff TIFF;
 
 // Fast image thumbnail extractor using libjpeg, libpng, and libtiff
+// Rows are streamed from the decoders into ImageDownscaler; no full-size buffers are kept
+// except for interlaced PNGs and bottom-up TIFFs
 class ImageThumbnailExtractor : public ThumbnailExtractorInterface
 {
 public:
@@ -24,22 +30,33 @@ public:
     // Extract thumbnail from image file
     HBITMAP Extract(const std::wstring& path, int size) override;
 
+    // Decode an in-memory JPEG (EXIF/PSD thumbnail) if it covers the thumbnail of a fullWidth x fullHeight image
+    // @return top-down BGRA HBITMAP, or nullptr if the JPEG is too small, a different aspect, or corrupt
+    static HBITMAP DecodeEmbeddedJPEG(const uint8_t* data, size_t length, uint32_t fullWidth, uint32_t fullHeight, int size);
+
 private:
     // Supported extensions
     std::set<std::wstring> m_supportedExtensions;
 
-    // Static mutex to serialize large TIFF extractions (prevents concurrent multi-GB allocations)
-    static std::mutex s_tiffMutex;
+    // Decoder state that survives a longjmp out of libjpeg/libpng
+    struct DecodeState;
 
-    // Extract JPEG using libjpeg-turbo
+    // Extract JPEG using libjpeg-turbo (uses the EXIF thumbnail when it is big enough)
     HBITMAP ExtractJPEG(const std::wstring& path, int size);
 
+    // Stream a JPEG whose header has been read through DCT scaling and the downscaler
+    static void DecodeJPEGRows(jpeg_decompress_struct* cinfo, int size, DecodeState& state);
+
     // Extract PNG using libpng
     HBITMAP ExtractPNG(const std::wstring& path, int size);
 
-    // Extract TIFF using libtiff
+    // Extract TIFF using libtiff (strip/tile bands, reduced-resolution IFDs when present)
     HBITMAP ExtractTIFF(const std::wstring& path, int size);
 
-    // Helper: Create HBITMAP from RGB(A) data
-    HBITMAP CreateHBITMAPFromRGB(unsigned char* data, int width, int height, int channels);
+    // Make the smallest reduced-resolution image that covers the thumbnail current
+    // (falls back to the main image); outIsReduced is set when a reduced image was chosen
+    bool SelectTIFFImage(TIFF* tif, int size, bool& outIsReduced);
+
+    // Helper: Create a top-down 32-bit DIB section for the thumbnail
+    static HBITMAP CreateThumbnailDIB(int width, int height, uint8_t** outBits);
 };
@@ -1,4 +1,7 @@
 #include "psd_ai_thumbnail_extractor.h"
+#include "psd_reader.h"
+#include "image_downscaler.h"
+#include "image_thumbnail_extractor.h"
 #include <windows.h>
 #include <gdiplus.h>
 #include <iostream>
@@ -15,6 +18,7 @@ PsdAiThumbnailExtractor::PsdAiThumbnailExtractor()
     // Initialize supported extensions
     m_supportedExtensions = {
         L".psd",    // Photoshop
+        L".psb",    // Photoshop Large Document
         L".ai",     // Illustrator
         L".eps",    // Encapsulated PostScript
         L".pdf",    // PDF documents
@@ -63,6 +67,17 @@ HBITMAP PsdAiThumbnailExtractor::Extract(const std::wstring& path, int size)
     std::wstring ext = filePath.extension().wstring();
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
 
+    // PSD/PSB are read in-process (streaming, so no file size limit); ImageMagick is only
+    // the fallback for modes the native reader does not handle (Lab, Multichannel, ZIP data)
+    if (ext == L".psd" || ext == L".psb")
+    {
+        HBITMAP hBitmap = ExtractPSD(path, size);
+        if (hBitmap)
+        {
+            return hBitmap;
+        }
+    }
+
     // Check file size - skip files larger than 500MB (prevent memory exhaustion)
     try
     {
@@ -91,11 +106,78 @@ HBITMAP PsdAiThumbnailExtractor::Extract(const std::wstring& path, int size)
     }
     else
     {
-        // Use ImageMagick for all other formats (PSD, HDR, PIC, WebP, AVIF, HEIC, HEIF, JXL, JP2)
+        // Use ImageMagick for all other formats (PSD fallback, HDR, PIC, WebP, AVIF, HEIC, HEIF, JXL, JP2)
         return ExtractWithMagick(path, size);
     }
 }
 
+HBITMAP PsdAiThumbnailExtractor::ExtractPSD(const std::wstring& path, int size)
+{
+    PsdReader reader;
+    if (!reader.Open(path))
+    {
+        return nullptr;
+    }
+
+    const std::vector<uint8_t>& thumbnail = reader.GetThumbnailJPEG();
+
+    // Embedded thumbnail: used when it covers the requested size, or when the composite is
+    // blank (saved without Maximize Compatibility) - then at whatever size it has
+    if (!thumbnail.empty())
+    {
+        bool useAnySize = !reader.HasMergedImage() && reader.GetThumbnailWidth() > 0 && reader.GetThumbnailHeight() > 0;
+        uint32_t coverWidth = useAnySize ? reader.GetThumbnailWidth() : reader.GetWidth();
+        uint32_t coverHeight = useAnySize ? reader.GetThumbnailHeight() : reader.GetHeight();
+
+        HBITMAP hBitmap = ImageThumbnailExtractor::DecodeEmbeddedJPEG(
+            thumbnail.data(), thumbnail.size(), coverWidth, coverHeight, size);
+        if (hBitmap)
+        {
+            return hBitmap;
+        }
+    }
+
+    if (!reader.HasMergedImage())
+    {
+        return nullptr;
+    }
+
+    // Merged composite, streamed through the downscaler
+    int thumbWidth, thumbHeight;
+    ImageDownscaler::FitSize(reader.GetWidth(), reader.GetHeight(), size, thumbWidth, thumbHeight);
+
+    BITMAPINFO bmi = {};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = thumbWidth;
+    bmi.bmiHeader.biHeight = -thumbHeight; // Top-down DIB
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* pBits = nullptr;
+    HDC hdcScreen = GetDC(nullptr);
+    HBITMAP hBitmap = CreateDIBSection(hdcScreen, &bmi, DIB_RGB_COLORS, &pBits, nullptr, 0);
+    ReleaseDC(nullptr, hdcScreen);
+
+    if (!hBitmap || !pBits)
+    {
+        if (hBitmap)
+            DeleteObject(hBitmap);
+        return nullptr;
+    }
+
+    ImageDownscaler scaler(reader.GetWidth(), reader.GetHeight(), thumbWidth, thumbHeight);
+    scaler.SetOutputBGRA8(static_cast<uint8_t*>(pBits), static_cast<size_t>(thumbWidth) * 4);
+
+    if (!reader.DecodeComposite(scaler))
+    {
+        DeleteObject(hBitmap);
+        return nullptr;
+    }
+
+    return hBitmap;
+}
+
 HBITMAP PsdAiThumbnailExtractor::ExtractWithMagick(const std::wstring& path, int size)
 {
     // Create temp output path with unique filename (process + thread + tick count)
@@ -5,7 +5,8 @@
 #include <string>
 #include <mutex>
 
-// PSD, AI, WebP, AVIF, JXL, JP2 thumbnail extractor using ImageMagick and Ghostscript
+// PSD, AI, WebP, AVIF, JXL, JP2 thumbnail extractor
+// PSD/PSB are decoded in-process (PsdReader); the rest use ImageMagick and Ghostscript subprocesses
 class PsdAiThumbnailExtractor : public ThumbnailExtractorInterface
 {
 public:
@@ -32,10 +33,13 @@ private:
     std::wstring m_magickPath;
     std::wstring m_ghostscriptPath;
 
-    // Static mutex to limit concurrent extractions (prevents memory exhaustion)
+    // Static mutex to limit concurrent subprocess extractions (prevents memory exhaustion)
     static std::mutex s_extractionMutex;
 
-    // Extract using ImageMagick (PSD, HDR, PIC, WebP, AVIF, JXL, JP2)
+    // Extract PSD/PSB natively: embedded JPEG thumbnail or streamed merged composite
+    HBITMAP ExtractPSD(const std::wstring& path, int size);
+
+    // Extract using ImageMagick (PSD fallback, HDR, PIC, WebP, AVIF, JXL, JP2)
     HBITMAP ExtractWithMagick(const std::wstring& path, int size);
 
     // Extract AI/EPS/PDF using Ghostscript
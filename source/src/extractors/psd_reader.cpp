@@ -0,0 +1,496 @@
+#include "psd_reader.h"
+#include "image_downscaler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifndef _WIN32
+#include <filesystem>
+#endif
+
+namespace {
+
+// 64-bit file positions with the C runtime (PSB files can exceed 2GB)
+FILE* OpenForReading(const std::wstring& path)
+{
+#ifdef _WIN32
+    FILE* file = nullptr;
+    return (_wfopen_s(&file, path.c_str(), L"rb") == 0) ? file : nullptr;
+#else
+    return fopen(std::filesystem::path(path).c_str(), "rb");
+#endif
+}
+
+int64_t Tell(FILE* file)
+{
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return ftello(file);
+#endif
+}
+
+bool Seek(FILE* file, int64_t offset, int origin)
+{
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+// Photoshop color modes (file header)
+enum ColorMode : uint16_t
+{
+    kModeBitmap = 0,
+    kModeGrayscale = 1,
+    kModeIndexed = 2,
+    kModeRGB = 3,
+    kModeCMYK = 4,
+    kModeDuotone = 8
+};
+
+// Image resource IDs
+constexpr uint16_t kResourceThumbnail = 1036;    // JPEG thumbnail (Photoshop 5.0+)
+constexpr uint16_t kResourceVersionInfo = 1057;  // Contains the "has real merged data" flag
+
+// Refuse absurd resource blocks before allocating for them
+constexpr uint32_t kMaxThumbnailBytes = 16 * 1024 * 1024;
+
+// Read-ahead window per channel plane
+constexpr size_t kChannelBufferSize = 256 * 1024;
+
+uint16_t ReadBE16(const uint8_t* p)
+{
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+uint32_t ReadBE32(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint64_t ReadBE64(const uint8_t* p)
+{
+    return (static_cast<uint64_t>(ReadBE32(p)) << 32) | ReadBE32(p + 4);
+}
+
+// PackBits (Apple RLE) row decode; short or overlong runs are clamped, missing bytes stay zero
+void UnpackBits(const uint8_t* src, size_t srcLength, uint8_t* dst, size_t dstLength)
+{
+    size_t in = 0;
+    size_t out = 0;
+
+    while (in < srcLength && out < dstLength)
+    {
+        int n = static_cast<int8_t>(src[in++]);
+        if (n >= 0)
+        {
+            size_t count = (std::min)({ static_cast<size_t>(n) + 1, srcLength - in, dstLength - out });
+            memcpy(dst + out, src + in, count);
+            in += count;
+            out += count;
+        }
+        else if (n != -128)
+        {
+            if (in >= srcLength)
+                break;
+            size_t count = (std::min)(static_cast<size_t>(1 - n), dstLength - out);
+            memset(dst + out, src[in++], count);
+            out += count;
+        }
+    }
+
+    if (out < dstLength)
+        memset(dst + out, 0, dstLength - out);
+}
+
+// 32-bit documents are linear light; encode to display gamma through a small table
+const uint8_t* LinearToDisplayLUT()
+{
+    static const struct Table
+    {
+        uint8_t values[4096];
+        Table()
+        {
+            for (int i = 0; i < 4096; i++)
+                values[i] = static_cast<uint8_t>(std::pow(i / 4095.0f, 1.0f / 2.2f) * 255.0f + 0.5f);
+        }
+    } table;
+    return table.values;
+}
+
+// Convert one decoded row of a channel to 8-bit samples
+void ConvertSamples(const uint8_t* src, uint8_t* dst, uint32_t width, uint16_t depth)
+{
+    switch (depth)
+    {
+    case 1:
+        // Bitmap mode: set bit = black
+        for (uint32_t x = 0; x < width; x++)
+            dst[x] = (src[x >> 3] & (0x80 >> (x & 7))) ? 0 : 255;
+        break;
+
+    case 8:
+        memcpy(dst, src, width);
+        break;
+
+    case 16:
+        // Big-endian: the high byte is the 8-bit value
+        for (uint32_t x = 0; x < width; x++)
+            dst[x] = src[x * 2];
+        break;
+
+    case 32:
+    {
+        const uint8_t* lut = LinearToDisplayLUT();
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint32_t bits = ReadBE32(src + x * 4);
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            value = (value > 0.0f) ? (std::min)(value, 1.0f) : 0.0f;  // Also maps NaN to 0
+            dst[x] = lut[static_cast<int>(value * 4095.0f)];
+        }
+        break;
+    }
+    }
+}
+
+} // namespace
+
+PsdReader::~PsdReader()
+{
+    if (m_file)
+        fclose(m_file);
+}
+
+bool PsdReader::Open(const std::wstring& path)
+{
+    m_file = OpenForReading(path);
+    if (!m_file)
+        return false;
+
+    // File header
+    uint8_t header[26];
+    if (!ReadExact(header, sizeof(header)) || memcmp(header, "8BPS", 4) != 0)
+        return false;
+
+    uint16_t version = ReadBE16(header + 4);
+    if (version != 1 && version != 2)
+        return false;
+    m_isPSB = (version == 2);
+
+    m_channels = ReadBE16(header + 12);
+    m_height = ReadBE32(header + 14);
+    m_width = ReadBE32(header + 18);
+    m_depth = ReadBE16(header + 22);
+    m_colorMode = ReadBE16(header + 24);
+
+    const uint32_t maxDimension = m_isPSB ? 300000 : 30000;
+    if (m_channels < 1 || m_channels > 56 || m_width == 0 || m_height == 0 ||
+        m_width > maxDimension || m_height > maxDimension)
+        return false;
+
+    switch (m_colorMode)
+    {
+    case kModeBitmap:
+        if (m_depth != 1)
+            return false;
+        break;
+    case kModeIndexed:
+        if (m_depth != 8)
+            return false;
+        break;
+    case kModeGrayscale:
+    case kModeDuotone:
+    case kModeRGB:
+        if (m_depth != 8 && m_depth != 16 && m_depth != 32)
+            return false;
+        break;
+    case kModeCMYK:
+        if (m_depth != 8 && m_depth != 16)
+            return false;
+        break;
+    default:
+        return false;  // Lab/Multichannel go through ImageMagick
+    }
+
+    // Color mode data (palette for indexed images, ignored otherwise)
+    uint8_t lengthBytes[8];
+    if (!ReadExact(lengthBytes, 4))
+        return false;
+    uint32_t colorModeLength = ReadBE32(lengthBytes);
+
+    if (m_colorMode == kModeIndexed)
+    {
+        if (colorModeLength < 768)
+            return false;
+        m_palette.resize(768);
+        if (!ReadExact(m_palette.data(), m_palette.size()) || !Skip(colorModeLength - 768))
+            return false;
+    }
+    else if (!Skip(colorModeLength))
+    {
+        return false;
+    }
+
+    // Image resources
+    if (!ReadExact(lengthBytes, 4) || !ReadImageResources(ReadBE32(lengthBytes)))
+        return false;
+
+    // Layer and mask information (length field is 8 bytes in PSB)
+    if (!ReadExact(lengthBytes, m_isPSB ? 8 : 4))
+        return false;
+    uint64_t layerLength = m_isPSB ? ReadBE64(lengthBytes) : ReadBE32(lengthBytes);
+    if (layerLength > static_cast<uint64_t>(INT64_MAX / 2))
+        return false;
+
+    m_imageDataOffset = Tell(m_file) + static_cast<int64_t>(layerLength);
+    return true;
+}
+
+bool PsdReader::ReadImageResources(int64_t length)
+{
+    const int64_t start = Tell(m_file);
+    const int64_t end = start + length;
+
+    while (Tell(m_file) + 12 <= end)
+    {
+        // Signature, ID, Pascal name padded to even length, data size, data padded to even length
+        uint8_t block[6];
+        if (!ReadExact(block, sizeof(block)) || memcmp(block, "8BIM", 4) != 0)
+            break;
+        uint16_t id = ReadBE16(block + 4);
+
+        uint8_t nameLength = 0;
+        if (!ReadExact(&nameLength, 1) || !Skip(nameLength + ((nameLength % 2 == 0) ? 1 : 0)))
+            return false;
+
+        uint8_t sizeBytes[4];
+        if (!ReadExact(sizeBytes, sizeof(sizeBytes)))
+            return false;
+        uint32_t dataSize = ReadBE32(sizeBytes);
+
+        const int64_t dataStart = Tell(m_file);
+        const int64_t dataEnd = dataStart + dataSize + (dataSize & 1);
+        if (dataEnd > end)
+            break;
+
+        if (id == kResourceThumbnail && dataSize > 28 && dataSize <= kMaxThumbnailBytes)
+        {
+            // Format, width, height, widthbytes, total size, compressed size, bpp, planes, JFIF data
+            std::vector<uint8_t> data(dataSize);
+            if (!ReadExact(data.data(), data.size()))
+                return false;
+
+            if (ReadBE32(data.data()) == 1)  // kJpegRGB
+            {
+                m_thumbnailWidth = static_cast<int>(ReadBE32(data.data() + 4));
+                m_thumbnailHeight = static_cast<int>(ReadBE32(data.data() + 8));
+                m_thumbnailJPEG.assign(data.begin() + 28, data.end());
+            }
+        }
+        else if (id == kResourceVersionInfo && dataSize >= 5)
+        {
+            uint8_t versionInfo[5];
+            if (!ReadExact(versionInfo, sizeof(versionInfo)))
+                return false;
+            m_hasMergedImage = (versionInfo[4] != 0);
+        }
+
+        if (!Seek(m_file, dataEnd, SEEK_SET))
+            return false;
+    }
+
+    return Seek(m_file, end, SEEK_SET);
+}
+
+bool PsdReader::DecodeComposite(ImageDownscaler& scaler)
+{
+    if (!m_file || !Seek(m_file, m_imageDataOffset, SEEK_SET))
+        return false;
+
+    uint8_t compressionBytes[2];
+    if (!ReadExact(compressionBytes, sizeof(compressionBytes)))
+        return false;
+
+    // Photoshop only writes raw or RLE merged data (ZIP is used for layers)
+    uint16_t compression = ReadBE16(compressionBytes);
+    if (compression > 1)
+        return false;
+
+    const int colorChannels = (m_colorMode == kModeRGB) ? 3 : (m_colorMode == kModeCMYK) ? 4 : 1;
+    if (m_channels < colorChannels)
+        return false;
+
+    const size_t rowBytes = (static_cast<size_t>(m_width) * m_depth + 7) / 8;
+    const int64_t dataStart = m_imageDataOffset + 2;
+
+    // Planes are stored one after another; each channel gets its own read position
+    std::vector<ChannelStream> streams(colorChannels);
+    std::vector<std::vector<uint32_t>> rowLengths;
+
+    if (compression == 0)
+    {
+        for (int c = 0; c < colorChannels; c++)
+            streams[c].filePos = dataStart + static_cast<int64_t>(c) * m_height * rowBytes;
+    }
+    else
+    {
+        // RLE: byte counts for every row of every channel precede the data (2 bytes each, 4 in PSB)
+        const size_t countSize = m_isPSB ? 4 : 2;
+        int64_t planePos = dataStart + static_cast<int64_t>(m_channels) * m_height * countSize;
+
+        std::vector<uint8_t> counts(static_cast<size_t>(m_height) * countSize);
+        rowLengths.resize(colorChannels);
+
+        for (int c = 0; c < colorChannels; c++)
+        {
+            if (!ReadExact(counts.data(), counts.size()))
+                return false;
+
+            rowLengths[c].resize(m_height);
+            int64_t planeBytes = 0;
+            for (uint32_t y = 0; y < m_height; y++)
+            {
+                const uint8_t* p = counts.data() + y * countSize;
+                rowLengths[c][y] = m_isPSB ? ReadBE32(p) : ReadBE16(p);
+                planeBytes += rowLengths[c][y];
+            }
+
+            streams[c].filePos = planePos;
+            planePos += planeBytes;
+        }
+    }
+
+    for (auto& stream : streams)
+        stream.buffer.resize(kChannelBufferSize);
+
+    // Sane encoders never need more than a header byte per data byte; anything larger is corrupt
+    const size_t maxPackedRow = rowBytes * 2 + 16;
+
+    std::vector<uint8_t> packed;
+    std::vector<uint8_t> raw(rowBytes);
+    std::vector<uint8_t> samples(static_cast<size_t>(m_width) * colorChannels);
+    std::vector<uint8_t> rgba(static_cast<size_t>(m_width) * 4);
+
+    for (uint32_t y = 0; y < m_height; y++)
+    {
+        for (int c = 0; c < colorChannels; c++)
+        {
+            if (compression == 0)
+            {
+                if (!ReadChannelBytes(streams[c], raw.data(), rowBytes))
+                    return false;
+            }
+            else
+            {
+                size_t packedLength = rowLengths[c][y];
+                if (packedLength > maxPackedRow)
+                    return false;
+
+                packed.resize(packedLength);
+                if (!ReadChannelBytes(streams[c], packed.data(), packedLength))
+                    return false;
+                UnpackBits(packed.data(), packedLength, raw.data(), rowBytes);
+            }
+
+            ConvertSamples(raw.data(), samples.data() + static_cast<size_t>(c) * m_width, m_width, m_depth);
+        }
+
+        // Compose RGBA (alpha channels are ignored: the composite is already flattened on white)
+        const uint8_t* s0 = samples.data();
+        uint8_t* out = rgba.data();
+
+        switch (m_colorMode)
+        {
+        case kModeRGB:
+        {
+            const uint8_t* s1 = s0 + m_width;
+            const uint8_t* s2 = s1 + m_width;
+            for (uint32_t x = 0; x < m_width; x++, out += 4)
+            {
+                out[0] = s0[x];
+                out[1] = s1[x];
+                out[2] = s2[x];
+                out[3] = 255;
+            }
+            break;
+        }
+        case kModeCMYK:
+        {
+            // Stored inverted (255 = no ink)
+            const uint8_t* s1 = s0 + m_width;
+            const uint8_t* s2 = s1 + m_width;
+            const uint8_t* s3 = s2 + m_width;
+            for (uint32_t x = 0; x < m_width; x++, out += 4)
+            {
+                out[0] = static_cast<uint8_t>((s0[x] * s3[x] + 127) / 255);
+                out[1] = static_cast<uint8_t>((s1[x] * s3[x] + 127) / 255);
+                out[2] = static_cast<uint8_t>((s2[x] * s3[x] + 127) / 255);
+                out[3] = 255;
+            }
+            break;
+        }
+        case kModeIndexed:
+            for (uint32_t x = 0; x < m_width; x++, out += 4)
+            {
+                out[0] = m_palette[s0[x]];
+                out[1] = m_palette[256 + s0[x]];
+                out[2] = m_palette[512 + s0[x]];
+                out[3] = 255;
+            }
+            break;
+        default:
+            // Bitmap, grayscale, duotone (duotone data is the grayscale base)
+            for (uint32_t x = 0; x < m_width; x++, out += 4)
+            {
+                out[0] = out[1] = out[2] = s0[x];
+                out[3] = 255;
+            }
+            break;
+        }
+
+        scaler.PushRow(rgba.data(), ImageDownscaler::PixelFormat::RGBA8);
+    }
+
+    return true;
+}
+
+bool PsdReader::ReadExact(void* dst, size_t length)
+{
+    return fread(dst, 1, length, m_file) == length;
+}
+
+bool PsdReader::Skip(int64_t length)
+{
+    return length >= 0 && Seek(m_file, length, SEEK_CUR);
+}
+
+bool PsdReader::ReadChannelBytes(ChannelStream& stream, uint8_t* dst, size_t length)
+{
+    while (length > 0)
+    {
+        if (stream.bufferPos == stream.bufferLength)
+        {
+            if (!Seek(m_file, stream.filePos, SEEK_SET))
+                return false;
+
+            stream.bufferLength = fread(stream.buffer.data(), 1, stream.buffer.size(), m_file);
+            stream.bufferPos = 0;
+            stream.filePos += stream.bufferLength;
+
+            if (stream.bufferLength == 0)
+                return false;  // Truncated file
+        }
+
+        size_t count = (std::min)(length, stream.bufferLength - stream.bufferPos);
+        memcpy(dst, stream.buffer.data() + stream.bufferPos, count);
+        stream.bufferPos += count;
+        dst += count;
+        length -= count;
+    }
+
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ImageDownscaler;
+
+// Minimal streaming reader for Photoshop PSD/PSB files
+// Only the parts needed for thumbnails are read: the header, the embedded JPEG thumbnail
+// resource (1036) and the merged composite ("image data" section, raw or PackBits RLE,
+// 1/8/16/32-bit). The layer section is skipped. The planar composite is decoded row by row
+// with one small read-ahead window per channel, so memory does not grow with image size.
+//
+// Usage:
+//   PsdReader reader;
+//   if (reader.Open(path)) reader.DecodeComposite(scaler);
+class PsdReader
+{
+public:
+    PsdReader() = default;
+    ~PsdReader();
+
+    PsdReader(const PsdReader&) = delete;
+    PsdReader& operator=(const PsdReader&) = delete;
+
+    // Parse header, color mode data and image resources
+    // @return false if the file is not a PSD/PSB, is malformed, or uses an unsupported color mode
+    bool Open(const std::wstring& path);
+
+    int GetWidth() const { return static_cast<int>(m_width); }
+    int GetHeight() const { return static_cast<int>(m_height); }
+
+    // True unless the file was saved without "Maximize Compatibility" (composite is blank then)
+    bool HasMergedImage() const { return m_hasMergedImage; }
+
+    // Embedded JPEG thumbnail (resource 1036), empty if the file has none
+    const std::vector<uint8_t>& GetThumbnailJPEG() const { return m_thumbnailJPEG; }
+    int GetThumbnailWidth() const { return m_thumbnailWidth; }
+    int GetThumbnailHeight() const { return m_thumbnailHeight; }
+
+    // Decode the merged composite, pushing GetHeight() RGBA8 rows into scaler (opaque;
+    // Photoshop stores the composite already matted against white)
+    // @return false on unsupported compression or corrupt data
+    bool DecodeComposite(ImageDownscaler& scaler);
+
+private:
+    // Sequential reader over one channel plane (planes are stored one after another)
+    struct ChannelStream
+    {
+        int64_t filePos = 0;
+        std::vector<uint8_t> buffer;
+        size_t bufferPos = 0;
+        size_t bufferLength = 0;
+    };
+
+    bool ReadExact(void* dst, size_t length);
+    bool Skip(int64_t length);
+    bool ReadImageResources(int64_t length);
+    bool ReadChannelBytes(ChannelStream& stream, uint8_t* dst, size_t length);
+
+    FILE* m_file = nullptr;
+
+    bool m_isPSB = false;
+    uint16_t m_channels = 0;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint16_t m_depth = 0;
+    uint16_t m_colorMode = 0;
+
+    std::vector<uint8_t> m_palette;  // Indexed mode: 256 R, then 256 G, then 256 B
+    std::vector<uint8_t> m_thumbnailJPEG;
+    int m_thumbnailWidth = 0;
+    int m_thumbnailHeight = 0;
+    bool m_hasMergedImage = true;
+
+    int64_t m_imageDataOffset = 0;
+};
@@ -2,6 +2,8 @@
 #include <windows.h>
 #include <iostream>
 #include <algorithm>
+#include <filesystem>
+#include <cstdio>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -10,6 +12,72 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
+namespace {
+
+// AVIO buffer size (large reads are what matter over SMB)
+constexpr int kIOBufferSize = 256 * 1024;
+
+// Idle contexts kept per pool (roughly one per worker thread plus a few formats)
+constexpr size_t kMaxPooledContexts = 8;
+
+// Probe cache entries kept before the cache is reset
+constexpr size_t kMaxProbeEntries = 2048;
+
+// Packets read after a seek before giving up
+constexpr int kMaxPacketsToRead = 100;
+
+int ReadFilePacket(void* opaque, uint8_t* buf, int bufSize)
+{
+    FILE* file = static_cast<FILE*>(opaque);
+    size_t bytesRead = fread(buf, 1, bufSize, file);
+    if (bytesRead == 0)
+        return AVERROR_EOF;
+    return static_cast<int>(bytesRead);
+}
+
+int64_t SeekFile(void* opaque, int64_t offset, int whence)
+{
+    FILE* file = static_cast<FILE*>(opaque);
+
+    if (whence & AVSEEK_SIZE)
+    {
+        int64_t current = _ftelli64(file);
+        _fseeki64(file, 0, SEEK_END);
+        int64_t fileSize = _ftelli64(file);
+        _fseeki64(file, current, SEEK_SET);
+        return fileSize;
+    }
+
+    whence &= ~AVSEEK_FORCE;
+    if (_fseeki64(file, offset, whence) != 0)
+        return -1;
+    return _ftelli64(file);
+}
+
+// Decoders can only be shared between streams with identical parameters
+std::string MakeDecoderKey(const AVCodecParameters* params, int lowres)
+{
+    std::string key;
+    auto append = [&key](int64_t value) {
+        key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    append(params->codec_id);
+    append(params->codec_tag);
+    append(params->width);
+    append(params->height);
+    append(params->format);
+    append(params->bits_per_coded_sample);
+    append(lowres);
+
+    if (params->extradata && params->extradata_size > 0)
+        key.append(reinterpret_cast<const char*>(params->extradata), params->extradata_size);
+
+    return key;
+}
+
+} // namespace
+
 VideoThumbnailExtractor::VideoThumbnailExtractor()
 {
     // Initialize supported video extensions (lowercase)
@@ -21,6 +89,14 @@ VideoThumbnailExtractor::VideoThumbnailExtractor()
 
 VideoThumbnailExtractor::~VideoThumbnailExtractor()
 {
+    for (auto& [key, codecCtx] : m_decoderPool)
+        avcodec_free_context(&codecCtx);
+
+    for (auto& [key, swsCtx] : m_scalerPool)
+        sws_freeContext(swsCtx);
+
+    for (uint8_t* buffer : m_ioBufferPool)
+        av_free(buffer);
 }
 
 bool VideoThumbnailExtractor::CanHandle(const std::wstring& extension)
@@ -34,23 +110,18 @@ bool VideoThumbnailExtractor::CanHandle(const std::wstring& extension)
 
 HBITMAP VideoThumbnailExtractor::Extract(const std::wstring& path, int size)
 {
-    int outWidth, outHeight;
-
-    // Try to extract a frame at 1 second into the video
-    HBITMAP hBitmap = ExtractFrame(path, 1.0, size, outWidth, outHeight);
-
-    if (!hBitmap)
-    {
-        // If that fails, try at the beginning
-        hBitmap = ExtractFrame(path, 0.0, size, outWidth, outHeight);
-    }
+    std::error_code ec;
+    uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec)
+        return nullptr;
+    int64_t writeTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
 
-    return hBitmap;
-}
+    ProbeInfo probe;
+    bool probeCached = LookupProbe(path, fileSize, writeTime, probe);
+    probe.fileSize = fileSize;
+    probe.writeTime = writeTime;
 
-HBITMAP VideoThumbnailExtractor::ExtractFrame(const std::wstring& path, double timestamp, int size, int& outWidth, int& outHeight)
-{
-    // Convert wide string to UTF-8
+    // Convert wide string to UTF-8 (demuxers use the name as a format hint)
     int utf8Size = WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, nullptr, 0, nullptr, nullptr);
     if (utf8Size == 0)
         return nullptr;
@@ -59,199 +130,234 @@ HBITMAP VideoThumbnailExtractor::ExtractFrame(const std::wstring& path, double t
     WideCharToMultiByte(CP_UTF8, 0, path.c_str(), -1, &pathUtf8[0], utf8Size, nullptr, nullptr);
     pathUtf8.resize(utf8Size - 1); // Remove null terminator
 
-    AVFormatContext* formatCtx = nullptr;
-    AVCodecContext* codecCtx = nullptr;
-    AVFrame* frame = nullptr;
-    AVFrame* rgbFrame = nullptr;
-    SwsContext* swsCtx = nullptr;
-    HBITMAP hBitmap = nullptr;
-
-    // Open video file
-    if (avformat_open_input(&formatCtx, pathUtf8.c_str(), nullptr, nullptr) != 0)
+    // Read through our own AVIO context so the IO buffer comes from the pool
+    FILE* file = nullptr;
+    if (_wfopen_s(&file, path.c_str(), L"rb") != 0 || !file)
     {
         return nullptr;
     }
+    setvbuf(file, nullptr, _IONBF, 0);  // AVIO already buffers
 
-    // Retrieve stream information
-    if (avformat_find_stream_info(formatCtx, nullptr) < 0)
+    uint8_t* ioBuffer = AcquireIOBuffer();
+    AVIOContext* ioCtx = ioBuffer ? avio_alloc_context(ioBuffer, kIOBufferSize, 0, file, ReadFilePacket, nullptr, SeekFile) : nullptr;
+    if (!ioCtx)
     {
-        avformat_close_input(&formatCtx);
+        if (ioBuffer)
+            ReleaseIOBuffer(ioBuffer, kIOBufferSize);
+        fclose(file);
         return nullptr;
     }
 
-    // Find the first video stream
-    int videoStreamIndex = -1;
-    for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
+    HBITMAP hBitmap = nullptr;
+    AVFormatContext* formatCtx = avformat_alloc_context();
+    if (formatCtx)
     {
-        if (formatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+        formatCtx->pb = ioCtx;
+        formatCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+
+        // A cached input format skips format probing entirely
+        if (avformat_open_input(&formatCtx, pathUtf8.c_str(), probe.inputFormat, nullptr) == 0)
         {
-            videoStreamIndex = i;
-            break;
+            hBitmap = DecodeThumbnail(formatCtx, probe, probeCached, size);
+            avformat_close_input(&formatCtx);
+
+            if (probe.videoStreamIndex >= 0)
+                StoreProbe(path, probe);
         }
+        // On failure avformat_open_input frees the context (but not our AVIO)
     }
 
-    if (videoStreamIndex == -1)
-    {
-        avformat_close_input(&formatCtx);
-        return nullptr;
-    }
+    // AVIO may have swapped its buffer; the pool only takes buffers of the original size
+    ReleaseIOBuffer(ioCtx->buffer, ioCtx->buffer_size);
+    avio_context_free(&ioCtx);
+    fclose(file);
 
-    AVStream* videoStream = formatCtx->streams[videoStreamIndex];
-    AVCodecParameters* codecParams = videoStream->codecpar;
+    return hBitmap;
+}
 
-    // Find decoder
-    const AVCodec* codec = avcodec_find_decoder(codecParams->codec_id);
-    if (!codec)
+HBITMAP VideoThumbnailExtractor::DecodeThumbnail(AVFormatContext* formatCtx, ProbeInfo& probe, bool probeCached, int size)
+{
+    probe.inputFormat = formatCtx->iformat;
+
+    // Find the first video stream (cached index is validated against the new header)
+    int videoStreamIndex = -1;
+    if (probeCached && probe.videoStreamIndex >= 0 &&
+        probe.videoStreamIndex < static_cast<int>(formatCtx->nb_streams) &&
+        formatCtx->streams[probe.videoStreamIndex]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
     {
-        avformat_close_input(&formatCtx);
-        return nullptr;
+        videoStreamIndex = probe.videoStreamIndex;
     }
+    else
+    {
+        for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
+        {
+            if (formatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+            {
+                videoStreamIndex = i;
+                break;
+            }
+        }
 
-    // Allocate codec context
-    codecCtx = avcodec_alloc_context3(codec);
-    if (!codecCtx)
+        // Containers like MOV/MXF/MKV describe the codec in the header; only run the
+        // (slow, decoding) stream-info probe when it did not
+        probe.needsStreamInfo = (videoStreamIndex == -1) ||
+                                formatCtx->streams[videoStreamIndex]->codecpar->codec_id == AV_CODEC_ID_NONE ||
+                                formatCtx->streams[videoStreamIndex]->codecpar->width <= 0;
+    }
+
+    if (probe.needsStreamInfo)
     {
-        avformat_close_input(&formatCtx);
-        return nullptr;
+        // Retrieve stream information
+        if (avformat_find_stream_info(formatCtx, nullptr) < 0)
+        {
+            return nullptr;
+        }
+
+        if (videoStreamIndex == -1)
+        {
+            for (unsigned int i = 0; i < formatCtx->nb_streams; i++)
+            {
+                if (formatCtx->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+                {
+                    videoStreamIndex = i;
+                    break;
+                }
+            }
+        }
     }
 
-    // Copy codec parameters to context
-    if (avcodec_parameters_to_context(codecCtx, codecParams) < 0)
+    if (videoStreamIndex == -1)
     {
-        avcodec_free_context(&codecCtx);
-        avformat_close_input(&formatCtx);
         return nullptr;
     }
+    probe.videoStreamIndex = videoStreamIndex;
 
-    // Open codec
-    if (avcodec_open2(codecCtx, codec, nullptr) < 0)
+    std::string decoderKey;
+    AVCodecContext* codecCtx = AcquireDecoder(formatCtx->streams[videoStreamIndex]->codecpar, size, decoderKey);
+    if (!codecCtx)
     {
-        avcodec_free_context(&codecCtx);
-        avformat_close_input(&formatCtx);
         return nullptr;
     }
 
-    // Allocate frames
-    frame = av_frame_alloc();
-    rgbFrame = av_frame_alloc();
-    if (!frame || !rgbFrame)
+    AVFrame* frame = av_frame_alloc();
+    if (!frame)
     {
-        if (frame) av_frame_free(&frame);
-        if (rgbFrame) av_frame_free(&rgbFrame);
-        avcodec_free_context(&codecCtx);
-        avformat_close_input(&formatCtx);
+        ReleaseDecoder(decoderKey, codecCtx);
         return nullptr;
     }
 
-    // Calculate output dimensions maintaining aspect ratio
-    int srcWidth = codecCtx->width;
-    int srcHeight = codecCtx->height;
-    float aspectRatio = (float)srcWidth / (float)srcHeight;
+    // Try a frame 1 second in (skips slates/black), unless that already failed for this file
+    // or the clip is shorter than that; otherwise fall back to the start on the same input
+    bool startAtZero = probe.seekFailed ||
+                       (formatCtx->duration > 0 && formatCtx->duration < AV_TIME_BASE);
+    bool gotFrame = false;
 
-    int dstWidth, dstHeight;
-    if (aspectRatio > 1.0f)
+    if (!startAtZero)
     {
-        // Landscape
-        dstWidth = size;
-        dstHeight = (int)(size / aspectRatio);
+        gotFrame = DecodeFrameAt(formatCtx, codecCtx, videoStreamIndex, 1.0, frame);
+        probe.seekFailed = !gotFrame;
     }
-    else
+
+    if (!gotFrame)
     {
-        // Portrait or square
-        dstHeight = size;
-        dstWidth = (int)(size * aspectRatio);
+        gotFrame = DecodeFrameAt(formatCtx, codecCtx, videoStreamIndex, 0.0, frame);
     }
 
-    // Allocate buffer for RGB frame
-    int numBytes = av_image_get_buffer_size(AV_PIX_FMT_BGRA, dstWidth, dstHeight, 1);
-    uint8_t* buffer = (uint8_t*)av_malloc(numBytes * sizeof(uint8_t));
-    av_image_fill_arrays(rgbFrame->data, rgbFrame->linesize, buffer, AV_PIX_FMT_BGRA, dstWidth, dstHeight, 1);
+    HBITMAP hBitmap = gotFrame ? ConvertFrameToHBITMAP(frame, size) : nullptr;
 
-    // Create scaling context
-    swsCtx = sws_getContext(
-        srcWidth, srcHeight, codecCtx->pix_fmt,
-        dstWidth, dstHeight, AV_PIX_FMT_BGRA,
-        SWS_BILINEAR, nullptr, nullptr, nullptr
-    );
+    av_frame_free(&frame);
+    ReleaseDecoder(decoderKey, codecCtx);
 
-    if (!swsCtx)
+    return hBitmap;
+}
+
+bool VideoThumbnailExtractor::DecodeFrameAt(AVFormatContext* formatCtx, AVCodecContext* codecCtx, int streamIndex, double timestamp, AVFrame* frame)
+{
+    // Seek to the keyframe at or before the timestamp
+    int64_t seekTarget = (int64_t)(timestamp * AV_TIME_BASE);
+    if (av_seek_frame(formatCtx, -1, seekTarget, AVSEEK_FLAG_BACKWARD) < 0 && timestamp > 0.0)
     {
-        av_free(buffer);
-        av_frame_free(&frame);
-        av_frame_free(&rgbFrame);
-        avcodec_free_context(&codecCtx);
-        avformat_close_input(&formatCtx);
-        return nullptr;
+        return false;
     }
+    avcodec_flush_buffers(codecCtx);
 
-    // Seek to desired timestamp
-    if (timestamp > 0.0)
+    AVPacket* packet = av_packet_alloc();
+    if (!packet)
     {
-        int64_t seekTarget = (int64_t)(timestamp * AV_TIME_BASE);
-        av_seek_frame(formatCtx, -1, seekTarget, AVSEEK_FLAG_BACKWARD);
-        avcodec_flush_buffers(codecCtx);
+        return false;
     }
 
-    // Read frames until we get a valid one
-    AVPacket packet;
     bool gotFrame = false;
-    int framesRead = 0;
-    const int maxFramesToRead = 100; // Safety limit
+    int packetsRead = 0;
 
-    while (av_read_frame(formatCtx, &packet) >= 0 && framesRead < maxFramesToRead)
+    while (!gotFrame && packetsRead < kMaxPacketsToRead && av_read_frame(formatCtx, packet) >= 0)
     {
-        if (packet.stream_index == videoStreamIndex)
+        if (packet->stream_index == streamIndex)
         {
-            // Send packet to decoder
-            if (avcodec_send_packet(codecCtx, &packet) == 0)
+            packetsRead++;
+            bool isKey = (packet->flags & AV_PKT_FLAG_KEY) != 0;
+
+            if (avcodec_send_packet(codecCtx, packet) == 0)
             {
-                // Receive decoded frame
-                if (avcodec_receive_frame(codecCtx, frame) == 0)
+                gotFrame = avcodec_receive_frame(codecCtx, frame) == 0;
+
+                // Frame threading holds frames back until the pipeline fills; for a keyframe,
+                // drain the decoder instead of reading further packets
+                if (!gotFrame && isKey)
                 {
-                    // Scale and convert to BGRA
-                    sws_scale(
-                        swsCtx,
-                        frame->data, frame->linesize, 0, srcHeight,
-                        rgbFrame->data, rgbFrame->linesize
-                    );
-
-                    // Convert to HBITMAP
-                    hBitmap = ConvertFrameToHBITMAP(rgbFrame, dstWidth, dstHeight);
-
-                    if (hBitmap)
-                    {
-                        outWidth = dstWidth;
-                        outHeight = dstHeight;
-                        gotFrame = true;
-                    }
-
-                    av_packet_unref(&packet);
-                    break;
+                    avcodec_send_packet(codecCtx, nullptr);
+                    gotFrame = avcodec_receive_frame(codecCtx, frame) == 0;
+
+                    // Leave draining mode so later packets are accepted
+                    if (!gotFrame)
+                        avcodec_flush_buffers(codecCtx);
                 }
             }
-            framesRead++;
         }
-        av_packet_unref(&packet);
+        av_packet_unref(packet);
     }
 
-    // Cleanup
-    sws_freeContext(swsCtx);
-    av_free(buffer);
-    av_frame_free(&frame);
-    av_frame_free(&rgbFrame);
-    avcodec_free_context(&codecCtx);
-    avformat_close_input(&formatCtx);
-
-    return hBitmap;
+    av_packet_free(&packet);
+    return gotFrame;
 }
 
-HBITMAP VideoThumbnailExtractor::ConvertFrameToHBITMAP(AVFrame* frame, int width, int height)
+HBITMAP VideoThumbnailExtractor::ConvertFrameToHBITMAP(AVFrame* frame, int size)
 {
+    // Calculate output dimensions maintaining aspect ratio
+    int srcWidth = frame->width;
+    int srcHeight = frame->height;
+    if (srcWidth <= 0 || srcHeight <= 0)
+    {
+        return nullptr;
+    }
+    float aspectRatio = (float)srcWidth / (float)srcHeight;
+
+    int dstWidth, dstHeight;
+    if (aspectRatio > 1.0f)
+    {
+        // Landscape
+        dstWidth = size;
+        dstHeight = (std::max)(1, (int)(size / aspectRatio));
+    }
+    else
+    {
+        // Portrait or square
+        dstHeight = size;
+        dstWidth = (std::max)(1, (int)(size * aspectRatio));
+    }
+
+    ScalerKey scalerKey = { frame->format, srcWidth, srcHeight, dstWidth, dstHeight };
+    SwsContext* swsCtx = AcquireScaler(scalerKey);
+    if (!swsCtx)
+    {
+        return nullptr;
+    }
+
     // Create DIB section
     BITMAPINFO bmi = {};
     bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-    bmi.bmiHeader.biWidth = width;
-    bmi.bmiHeader.biHeight = -height; // Top-down DIB
+    bmi.bmiHeader.biWidth = dstWidth;
+    bmi.bmiHeader.biHeight = -dstHeight; // Top-down DIB
     bmi.bmiHeader.biPlanes = 1;
     bmi.bmiHeader.biBitCount = 32;
     bmi.bmiHeader.biCompression = BI_RGB;
@@ -263,19 +369,189 @@ HBITMAP VideoThumbnailExtractor::ConvertFrameToHBITMAP(AVFrame* frame, int width
 
     if (!hBitmap || !pBits)
     {
+        ReleaseScaler(scalerKey, swsCtx);
         return nullptr;
     }
 
-    // Copy frame data to bitmap
-    // AVFrame data is already in BGRA format with linesize padding
-    uint8_t* dst = (uint8_t*)pBits;
-    uint8_t* src = frame->data[0];
-    int srcLineSize = frame->linesize[0];
+    // Scale and convert to BGRA directly into the bitmap
+    uint8_t* dstData[4] = { static_cast<uint8_t*>(pBits), nullptr, nullptr, nullptr };
+    int dstLinesize[4] = { dstWidth * 4, 0, 0, 0 };
+    sws_scale(swsCtx, frame->data, frame->linesize, 0, srcHeight, dstData, dstLinesize);
+
+    ReleaseScaler(scalerKey, swsCtx);
+    return hBitmap;
+}
+
+bool VideoThumbnailExtractor::LookupProbe(const std::wstring& path, uintmax_t fileSize, int64_t writeTime, ProbeInfo& outProbe)
+{
+    std::lock_guard<std::mutex> lock(m_probeMutex);
+
+    auto it = m_probeCache.find(path);
+    if (it == m_probeCache.end())
+        return false;
 
-    for (int y = 0; y < height; y++)
+    // File was replaced or re-rendered
+    if (it->second.fileSize != fileSize || it->second.writeTime != writeTime)
     {
-        memcpy(dst + y * width * 4, src + y * srcLineSize, width * 4);
+        m_probeCache.erase(it);
+        return false;
     }
 
-    return hBitmap;
+    outProbe = it->second;
+    return true;
+}
+
+void VideoThumbnailExtractor::StoreProbe(const std::wstring& path, const ProbeInfo& probe)
+{
+    std::lock_guard<std::mutex> lock(m_probeMutex);
+
+    if (m_probeCache.size() >= kMaxProbeEntries && m_probeCache.find(path) == m_probeCache.end())
+        m_probeCache.clear();
+
+    m_probeCache[path] = probe;
+}
+
+AVCodecContext* VideoThumbnailExtractor::AcquireDecoder(const AVCodecParameters* params, int size, std::string& outKey)
+{
+    // Find decoder
+    const AVCodec* codec = avcodec_find_decoder(params->codec_id);
+    if (!codec)
+    {
+        return nullptr;
+    }
+
+    // Decode at reduced resolution when the codec supports it (MJPEG and friends)
+    int lowres = 0;
+    while (lowres < codec->max_lowres &&
+           (params->width >> (lowres + 1)) >= size && (params->height >> (lowres + 1)) >= size)
+    {
+        lowres++;
+    }
+
+    outKey = MakeDecoderKey(params, lowres);
+
+    {
+        std::lock_guard<std::mutex> lock(m_decoderMutex);
+        for (auto it = m_decoderPool.begin(); it != m_decoderPool.end(); ++it)
+        {
+            if (it->first == outKey)
+            {
+                AVCodecContext* codecCtx = it->second;
+                m_decoderPool.erase(it);
+                return codecCtx;  // Flushed by DecodeFrameAt before use
+            }
+        }
+    }
+
+    // Allocate codec context
+    AVCodecContext* codecCtx = avcodec_alloc_context3(codec);
+    if (!codecCtx)
+    {
+        return nullptr;
+    }
+
+    // Copy codec parameters to context
+    if (avcodec_parameters_to_context(codecCtx, params) < 0)
+    {
+        avcodec_free_context(&codecCtx);
+        return nullptr;
+    }
+
+    // Thumbnails only need one keyframe: skip everything else and the deblocking pass
+    codecCtx->skip_frame = AVDISCARD_NONKEY;
+    codecCtx->skip_loop_filter = AVDISCARD_ALL;
+    codecCtx->flags2 |= AV_CODEC_FLAG2_FAST;
+    codecCtx->lowres = lowres;
+    codecCtx->thread_count = 0;  // Auto
+    codecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+    // Open codec
+    if (avcodec_open2(codecCtx, codec, nullptr) < 0)
+    {
+        avcodec_free_context(&codecCtx);
+        return nullptr;
+    }
+
+    return codecCtx;
+}
+
+void VideoThumbnailExtractor::ReleaseDecoder(const std::string& key, AVCodecContext* codecCtx)
+{
+    std::lock_guard<std::mutex> lock(m_decoderMutex);
+
+    if (m_decoderPool.size() >= kMaxPooledContexts)
+    {
+        avcodec_free_context(&m_decoderPool.front().second);
+        m_decoderPool.erase(m_decoderPool.begin());
+    }
+
+    m_decoderPool.emplace_back(key, codecCtx);
+}
+
+SwsContext* VideoThumbnailExtractor::AcquireScaler(const ScalerKey& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_scalerMutex);
+        for (auto it = m_scalerPool.begin(); it != m_scalerPool.end(); ++it)
+        {
+            if (it->first == key)
+            {
+                SwsContext* swsCtx = it->second;
+                m_scalerPool.erase(it);
+                return swsCtx;
+            }
+        }
+    }
+
+    // Create scaling context
+    return sws_getContext(
+        key.srcWidth, key.srcHeight, static_cast<AVPixelFormat>(key.srcFormat),
+        key.dstWidth, key.dstHeight, AV_PIX_FMT_BGRA,
+        SWS_BILINEAR, nullptr, nullptr, nullptr
+    );
+}
+
+void VideoThumbnailExtractor::ReleaseScaler(const ScalerKey& key, SwsContext* swsCtx)
+{
+    std::lock_guard<std::mutex> lock(m_scalerMutex);
+
+    if (m_scalerPool.size() >= kMaxPooledContexts)
+    {
+        sws_freeContext(m_scalerPool.front().second);
+        m_scalerPool.erase(m_scalerPool.begin());
+    }
+
+    m_scalerPool.emplace_back(key, swsCtx);
+}
+
+uint8_t* VideoThumbnailExtractor::AcquireIOBuffer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_ioBufferMutex);
+        if (!m_ioBufferPool.empty())
+        {
+            uint8_t* buffer = m_ioBufferPool.back();
+            m_ioBufferPool.pop_back();
+            return buffer;
+        }
+    }
+
+    return static_cast<uint8_t*>(av_malloc(kIOBufferSize));
+}
+
+void VideoThumbnailExtractor::ReleaseIOBuffer(uint8_t* buffer, int bufferSize)
+{
+    if (!buffer)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_ioBufferMutex);
+        if (bufferSize == kIOBufferSize && m_ioBufferPool.size() < kMaxPooledContexts)
+        {
+            m_ioBufferPool.push_back(buffer);
+            return;
+        }
+    }
+
+    av_free(buffer);
 }
@@ -2,15 +2,24 @@
 
 #include "../thumbnail_extractor.h"
 #include <set>
+#include <map>
 #include <string>
+#include <vector>
+#include <mutex>
+#include <cstdint>
 
 // Forward declarations for FFmpeg types to avoid including headers here
 struct AVFormatContext;
+struct AVInputFormat;
 struct AVCodecContext;
+struct AVCodecParameters;
 struct AVFrame;
 struct SwsContext;
 
 // Video thumbnail extractor using FFmpeg
+// One instance is shared by all ThumbnailManager workers, so the pools below are mutex-guarded.
+// Decoder, scaler and IO-buffer pools let consecutive clips with the same format (a folder of
+// ProRes/DNxHR dailies) skip codec setup; the probe cache lets re-extraction skip format probing.
 class VideoThumbnailExtractor : public ThumbnailExtractorInterface
 {
 public:
@@ -31,12 +40,70 @@ public:
     HBITMAP Extract(const std::wstring& path, int size) override;
 
 private:
+    // Demuxer probe results for a file (invalidated by size/mtime change)
+    struct ProbeInfo
+    {
+        uintmax_t fileSize = 0;
+        int64_t writeTime = 0;
+        const AVInputFormat* inputFormat = nullptr;
+        int videoStreamIndex = -1;
+        bool needsStreamInfo = false;  // Container header lacked codec parameters
+        bool seekFailed = false;       // Nothing decodable at 1s, start at 0
+    };
+
+    // Swscale context identity (source format/size -> BGRA thumbnail size)
+    struct ScalerKey
+    {
+        int srcFormat;
+        int srcWidth;
+        int srcHeight;
+        int dstWidth;
+        int dstHeight;
+
+        bool operator==(const ScalerKey& other) const
+        {
+            return srcFormat == other.srcFormat && srcWidth == other.srcWidth && srcHeight == other.srcHeight &&
+                   dstWidth == other.dstWidth && dstHeight == other.dstHeight;
+        }
+    };
+
     // Supported video extensions
     std::set<std::wstring> m_videoExtensions;
 
-    // Extract a frame from the video at the specified timestamp (in seconds)
-    HBITMAP ExtractFrame(const std::wstring& path, double timestamp, int size, int& outWidth, int& outHeight);
+    // Probe cache
+    std::map<std::wstring, ProbeInfo> m_probeCache;
+    std::mutex m_probeMutex;
+
+    // Idle decoder contexts, keyed by codec parameters + extradata
+    std::vector<std::pair<std::string, AVCodecContext*>> m_decoderPool;
+    std::mutex m_decoderMutex;
+
+    // Idle swscale contexts
+    std::vector<std::pair<ScalerKey, SwsContext*>> m_scalerPool;
+    std::mutex m_scalerMutex;
+
+    // Idle AVIO buffers
+    std::vector<uint8_t*> m_ioBufferPool;
+    std::mutex m_ioBufferMutex;
+
+    // Find the video stream, decode one keyframe and convert it (input is already open)
+    HBITMAP DecodeThumbnail(AVFormatContext* formatCtx, ProbeInfo& probe, bool probeCached, int size);
+
+    // Seek to timestamp (seconds) and decode the first keyframe after it into frame
+    bool DecodeFrameAt(AVFormatContext* formatCtx, AVCodecContext* codecCtx, int streamIndex, double timestamp, AVFrame* frame);
+
+    // Scale an AVFrame into a new top-down BGRA HBITMAP fitting size x size
+    HBITMAP ConvertFrameToHBITMAP(AVFrame* frame, int size);
+
+    // Probe cache access
+    bool LookupProbe(const std::wstring& path, uintmax_t fileSize, int64_t writeTime, ProbeInfo& outProbe);
+    void StoreProbe(const std::wstring& path, const ProbeInfo& probe);
 
-    // Convert AVFrame to HBITMAP
-    HBITMAP ConvertFrameToHBITMAP(AVFrame* frame, int width, int height);
+    // Pool access (Acquire creates a new object when none is idle)
+    AVCodecContext* AcquireDecoder(const AVCodecParameters* params, int size, std::string& outKey);
+    void ReleaseDecoder(const std::string& key, AVCodecContext* codecCtx);
+    SwsContext* AcquireScaler(const ScalerKey& key);
+    void ReleaseScaler(const ScalerKey& key, SwsContext* swsCtx);
+    uint8_t* AcquireIOBuffer();
+    void ReleaseIOBuffer(uint8_t* buffer, int bufferSize);
 };
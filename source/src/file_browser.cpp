@@ -11,6 +11,10 @@
 #include "bookmark_manager.h"
 #include "subscription_manager.h"
 #include "utils.h"
+#include "image_sequence.h"
+#include "directory_cache.h"
+#include "file_hash_service.h"
+#include "file_index.h"
 #include <shellapi.h>
 #include <shlobj.h>
 #include <shlwapi.h>
@@ -39,9 +43,14 @@ extern ImFont* font_icons;
 // External accent color function
 extern ImVec4 GetWindowsAccentColor();
 
+// Rows are rebuilt at most this often (seconds) while a new directory's listing streams in
+static constexpr double kStreamRebuildInterval = 0.25;
+
 // Static member definitions - shared across all FileBrowser instances
 std::vector<std::wstring> FileBrowser::m_cutFiles;
 bool FileBrowser::showHiddenFiles = false;
+bool FileBrowser::collapseImageSequences = true;
+UFB::FileIndex* FileBrowser::fileIndex = nullptr;
 int FileBrowser::m_oleRefCount = 0;
 
 FileBrowser::FileBrowser()
@@ -196,13 +205,10 @@ void FileBrowser::SetCurrentDirectory(const std::wstring& path)
         if (std::filesystem::exists(path) && std::filesystem::is_directory(path))
         {
             m_currentDirectory = std::filesystem::canonical(path).wstring();
+            m_pendingSelectPath.clear();
 
-            // Clear pending thumbnail work before changing directory
-            m_thumbnailManager.ClearPendingRequests();
-            m_thumbnailManager.ClearCache();
-
+            // Thumbnails and selection are reset when the new listing replaces the old one
             RefreshFileList();
-            m_selectedIndices.clear();  // Clear selection when changing directories
         }
     }
     catch (const std::exception&)
@@ -219,31 +225,15 @@ void FileBrowser::SetCurrentDirectoryAndSelectFile(const std::wstring& directory
         {
             m_currentDirectory = std::filesystem::canonical(directoryPath).wstring();
 
-            // Clear pending thumbnail work before changing directory
-            m_thumbnailManager.ClearPendingRequests();
-            m_thumbnailManager.ClearCache();
-
-            RefreshFileList();
-            m_selectedIndices.clear();
-
-            // Find and select the specified file
-            std::wstring canonicalFilePathToSelect;
+            // Find and select the specified file once the listing has been read
             try {
-                canonicalFilePathToSelect = std::filesystem::canonical(filePathToSelect).wstring();
+                m_pendingSelectPath = std::filesystem::canonical(filePathToSelect).wstring();
             } catch (...) {
                 // If canonical fails (file doesn't exist), just use the path as-is
-                canonicalFilePathToSelect = filePathToSelect;
+                m_pendingSelectPath = filePathToSelect;
             }
 
-            for (size_t i = 0; i < m_files.size(); i++)
-            {
-                if (m_files[i].fullPath == canonicalFilePathToSelect)
-                {
-                    m_selectedIndices.insert(static_cast<int>(i));
-                    std::wcout << L"[FileBrowser] Selected file: " << m_files[i].name << std::endl;
-                    break;
-                }
-            }
+            RefreshFileList();
         }
     }
     catch (const std::exception&)
@@ -254,91 +244,222 @@ void FileBrowser::SetCurrentDirectoryAndSelectFile(const std::wstring& directory
 
 void FileBrowser::RefreshFileList()
 {
-    std::lock_guard<std::mutex> lock(m_filesMutex);
+    auto& cache = UFB::DirectoryCache::Get();
 
-    m_files.clear();
+    // Show a recent listing of a different folder instantly, then revalidate it below
+    if (m_currentDirectory != m_listedDirectory)
+    {
+        std::vector<FileEntry> cached;
+        uint64_t cachedVersion = 0;
+        if (cache.Lookup(m_currentDirectory, showHiddenFiles, cached, cachedVersion))
+        {
+            m_thumbnailManager.ClearPendingRequests();
+            m_thumbnailManager.ClearCache();
+            m_selectedIndices.clear();
+            m_listedDirectory = m_currentDirectory;
+            m_listedVersion = cachedVersion;
+            m_directoryEntries = std::move(cached);
+            RebuildFileList();
+            SelectPendingFile();
+        }
+    }
 
-    try
+    // Read on the enumerator thread; a newer refresh or navigation cancels this one
+    m_readVersion = cache.GetVersion(m_currentDirectory);
+    m_enumerator.Start(m_currentDirectory, showHiddenFiles);
+    m_pendingEntries.clear();
+    m_streamingListing = false;
+}
+
+void FileBrowser::PollDirectoryListing()
+{
+    // Directory on screen changed on disk (renders landing, other users) - re-read it in the background
+    if (!m_isSearchMode && !m_enumerator.IsBusy() && !m_listedDirectory.empty() && m_listedDirectory == m_currentDirectory)
     {
-        for (const auto& entry : std::filesystem::directory_iterator(m_currentDirectory))
+        double now = glfwGetTime();
+        if (UFB::DirectoryCache::Get().GetVersion(m_listedDirectory) != m_listedVersion &&
+            now - m_lastAutoRefreshTime >= 1.0)  // At most once a second while files keep arriving
         {
-            // Skip hidden files if option is disabled
-            if (!showHiddenFiles)
-            {
-                auto filename = entry.path().filename().wstring();
-                if (!filename.empty() && filename[0] == L'.')
-                    continue;
+            m_lastAutoRefreshTime = now;
+            RefreshFileList();
+        }
+    }
 
-                DWORD attrs = GetFileAttributesW(entry.path().c_str());
-                if (attrs != INVALID_FILE_ATTRIBUTES && (attrs & FILE_ATTRIBUTE_HIDDEN))
-                    continue;
-            }
+    std::vector<FileEntry> batch;
+    bool complete = false;
+    bool failed = false;
+
+    if (!m_enumerator.Poll(batch, complete, failed))
+        return;
+
+    bool newDirectory = (m_enumerator.GetPath() != m_listedDirectory);
+
+    // Refreshing the folder on screen: keep its rows until the new listing is whole (no flicker)
+    if (!newDirectory && !m_streamingListing)
+    {
+        m_pendingEntries.insert(m_pendingEntries.end(), std::make_move_iterator(batch.begin()),
+                                std::make_move_iterator(batch.end()));
+        if (!complete)
+            return;
+    }
+
+    // Entering a different folder: show entries batch by batch as they arrive. Batches go straight
+    // into m_directoryEntries, and the rows are rebuilt at most every kStreamRebuildInterval
+    // (a rebuild collapses and sorts the whole listing, so one per batch is quadratic).
+    double now = glfwGetTime();
+    if (newDirectory)
+    {
+        // Old listing is replaced now - drop its thumbnails and selection
+        m_thumbnailManager.ClearPendingRequests();
+        m_thumbnailManager.ClearCache();
+        m_selectedIndices.clear();
+        m_listedDirectory = m_enumerator.GetPath();
+        m_directoryEntries.clear();
+        m_lastStreamRebuildTime = -kStreamRebuildInterval;
+    }
+
+    const bool streamed = newDirectory || m_streamingListing;
+    if (streamed)
+    {
+        m_directoryEntries.insert(m_directoryEntries.end(), std::make_move_iterator(batch.begin()),
+                                  std::make_move_iterator(batch.end()));
+    }
 
-            FileEntry fileEntry;
-            fileEntry.name = entry.path().filename().wstring();
-            fileEntry.fullPath = entry.path().wstring();
-            fileEntry.isDirectory = entry.is_directory();
+    m_streamingListing = !complete;
 
-            if (!fileEntry.isDirectory)
+    if (!complete)
+    {
+        if (now - m_lastStreamRebuildTime >= kStreamRebuildInterval)
+        {
+            m_lastStreamRebuildTime = now;
+            RebuildFileList();
+        }
+        return;
+    }
+
+    // Listed version: the one the read started at, or the current one after a failed read (so it
+    // does not retrigger forever)
+    const std::vector<FileEntry>& listing = streamed ? m_directoryEntries : m_pendingEntries;
+    if (failed)
+    {
+        std::wcerr << L"[FileBrowser] Failed to read directory: " << m_enumerator.GetPath() << std::endl;
+        UFB::DirectoryCache::Get().Remove(m_enumerator.GetPath());
+        m_listedVersion = UFB::DirectoryCache::Get().GetVersion(m_enumerator.GetPath());
+    }
+    else
+    {
+        UFB::DirectoryCache::Get().Store(m_enumerator.GetPath(), m_enumerator.GetIncludeHidden(), listing, m_readVersion);
+        m_listedVersion = m_readVersion;
+    }
+
+    if (!streamed)
+    {
+        // Revalidation of the listing on screen: only touch what changed
+        UFB::ListingDiff diff = UFB::DiffListings(m_directoryEntries, m_pendingEntries);
+        if (diff.IsEmpty())
+        {
+            m_pendingEntries.clear();
+            SelectPendingFile();
+            m_pendingSelectPath.clear();
+            return;
+        }
+
+        for (const auto& path : diff.modified)
+            m_thumbnailManager.InvalidateThumbnail(path);
+        for (const auto& path : diff.removed)
+            m_thumbnailManager.InvalidateThumbnail(path);
+
+        m_directoryEntries = std::move(m_pendingEntries);
+        m_pendingEntries.clear();
+    }
+
+    RebuildFileList();
+    SelectPendingFile();
+    m_pendingSelectPath.clear();
+}
+
+void FileBrowser::SelectPendingFile()
+{
+    if (m_pendingSelectPath.empty())
+        return;
+
+    // Kept until the fresh listing completes (a cached listing may predate the file)
+
+    std::lock_guard<std::mutex> lock(m_filesMutex);
+    for (size_t i = 0; i < m_files.size(); i++)
+    {
+        if (m_files[i].fullPath == m_pendingSelectPath)
+        {
+            m_selectedIndices.clear();
+            m_selectedIndices.insert(static_cast<int>(i));
+            std::wcout << L"[FileBrowser] Selected file: " << m_files[i].name << std::endl;
+            m_pendingSelectPath.clear();
+            return;
+        }
+    }
+}
+
+void FileBrowser::RebuildFileList()
+{
+    std::lock_guard<std::mutex> lock(m_filesMutex);
+
+    // Selection is by index; carry it over by path (rows move when entries are added or re-sorted)
+    std::set<std::wstring> selectedPaths;
+    for (int idx : m_selectedIndices)
+    {
+        if (idx >= 0 && idx < static_cast<int>(m_files.size()))
+            selectedPaths.insert(m_files[idx].fullPath);
+    }
+
+    m_files.clear();
+    m_files.reserve(m_directoryEntries.size());
+
+    for (const auto& fileEntry : m_directoryEntries)
+    {
+        // Apply filter if active
+        if (!m_filterExtensions.empty())
+        {
+            bool shouldShow = false;
+
+            if (fileEntry.isDirectory)
             {
-                try
-                {
-                    fileEntry.size = entry.file_size();
-                }
-                catch (...)
-                {
-                    fileEntry.size = 0;
-                }
+                // Show directory only if "[folders]" is in the filter set
+                shouldShow = (m_filterExtensions.count(L"[folders]") > 0);
             }
             else
             {
-                fileEntry.size = 0;
-            }
+                // Show file only if its extension is in the filter set
+                std::wstring ext = std::filesystem::path(fileEntry.name).extension().wstring();
+                // Convert to lowercase for case-insensitive comparison
+                std::transform(ext.begin(), ext.end(), ext.begin(), ::towlower);
 
-            try
-            {
-                fileEntry.lastModified = entry.last_write_time();
-            }
-            catch (...)
-            {
-                // Use epoch time if we can't get the real time
-                fileEntry.lastModified = std::filesystem::file_time_type();
+                shouldShow = (m_filterExtensions.count(ext) > 0);
             }
 
-            // Apply filter if active
-            if (!m_filterExtensions.empty())
-            {
-                bool shouldShow = false;
-
-                if (fileEntry.isDirectory)
-                {
-                    // Show directory only if "[folders]" is in the filter set
-                    shouldShow = (m_filterExtensions.count(L"[folders]") > 0);
-                }
-                else
-                {
-                    // Show file only if its extension is in the filter set
-                    std::filesystem::path p(entry.path());
-                    std::wstring ext = p.extension().wstring();
-                    // Convert to lowercase for case-insensitive comparison
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::towlower);
+            if (!shouldShow)
+                continue;  // Skip items that don't match any active filter
+        }
 
-                    shouldShow = (m_filterExtensions.count(ext) > 0);
-                }
+        m_files.push_back(fileEntry);
+    }
 
-                if (!shouldShow)
-                    continue;  // Skip items that don't match any active filter
-            }
+    // One row (and one thumbnail) per render sequence instead of one per frame
+    if (collapseImageSequences)
+    {
+        UFB::CollapseImageSequences(m_files);
+    }
 
-            m_files.push_back(fileEntry);
-        }
+    // Sort using current sort settings
+    SortFileList();
 
-        // Sort using current sort settings
-        SortFileList();
-    }
-    catch (const std::exception&)
+    m_selectedIndices.clear();
+    if (!selectedPaths.empty())
     {
-        // Failed to read directory
+        for (size_t i = 0; i < m_files.size(); i++)
+        {
+            if (selectedPaths.count(m_files[i].fullPath))
+                m_selectedIndices.insert(static_cast<int>(i));
+        }
     }
 }
 
@@ -629,6 +750,7 @@ void FileBrowser::PasteFilesFromClipboard()
 
         // Build source file list and check if any file is from the same directory
         std::wstring sourceFiles;
+        std::vector<std::wstring> sourcePaths;
         bool sameDirectory = false;
         for (UINT i = 0; i < fileCount; i++)
         {
@@ -637,6 +759,7 @@ void FileBrowser::PasteFilesFromClipboard()
             {
                 sourceFiles += filePath;
                 sourceFiles += L'\0';
+                sourcePaths.push_back(filePath);
 
                 // Check if source is in the same directory as destination
                 std::filesystem::path sourcePath(filePath);
@@ -649,6 +772,16 @@ void FileBrowser::PasteFilesFromClipboard()
         }
         sourceFiles += L'\0';  // Double null terminator
 
+        // Queue on the copy engine (cut + paste is a move; same-folder copies become "name - Copy"; the host
+        // asks Replace / Skip / Keep Both when names are taken)
+        if (onCopyFiles)
+        {
+            onCopyFiles(sourcePaths, m_currentDirectory, !m_cutFiles.empty());
+            m_cutFiles.clear();
+            CloseClipboard();
+            return;
+        }
+
         // Perform copy operation using SHFileOperation
         SHFILEOPSTRUCTW fileOp = {};
         fileOp.wFunc = FO_COPY;
@@ -730,6 +863,13 @@ void FileBrowser::CopyFilesToDestination(const std::vector<std::wstring>& source
 
     std::wcout << L"[FileBrowser] Copying " << sourcePaths.size() << L" item(s) to: " << destDirectory << std::endl;
 
+    // Queue on the copy engine when the host provides one (progress shows in the Copy Queue panel)
+    if (onCopyFiles)
+    {
+        onCopyFiles(sourcePaths, destDirectory, false);
+        return;
+    }
+
     // Build double-null terminated string for sources
     std::wstring sourceDoubleNull;
     for (const auto& path : sourcePaths)
@@ -814,7 +954,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
             if (m_selectedIndices.empty())
             {
                 // If no selection, copy just this file
-                selectedPaths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, selectedPaths);
             }
             else
             {
@@ -823,7 +963,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
             }
@@ -838,7 +978,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
             if (m_selectedIndices.empty())
             {
                 // If no selection, cut just this file
-                selectedPaths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, selectedPaths);
             }
             else
             {
@@ -847,7 +987,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
             }
@@ -1192,10 +1332,38 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
             }
         }
 
+        // Content hashing: duplicates and hash manifests of folders, verification of manifests
+        if (entry.isDirectory && (onFindDuplicates || onCreateHashManifest))
+        {
+            ImGui::Separator();
+
+            if (onFindDuplicates && ImGui::MenuItem("Find Duplicates"))
+            {
+                onFindDuplicates(entry.fullPath);
+                ImGui::CloseCurrentPopup();
+            }
+            if (onCreateHashManifest && ImGui::MenuItem("Create Hash Manifest"))
+            {
+                onCreateHashManifest(entry.fullPath);
+                ImGui::CloseCurrentPopup();
+            }
+        }
+        else if (!entry.isDirectory && onVerifyHashManifest &&
+                 _wcsicmp(std::filesystem::path(entry.fullPath).extension().c_str(), UFB::FileHashService::kManifestExtension) == 0)
+        {
+            ImGui::Separator();
+
+            if (ImGui::MenuItem("Verify Against Manifest"))
+            {
+                onVerifyHashManifest(entry.fullPath);
+                ImGui::CloseCurrentPopup();
+            }
+        }
+
         ImGui::Separator();
 
-        // Rename
-        if (ImGui::MenuItem("Rename"))
+        // Rename (not for collapsed sequences - that would rename only the first frame)
+        if (ImGui::MenuItem("Rename", nullptr, false, !entry.IsSequence()))
         {
             m_showRenameDialog = true;
             m_renameOriginalPath = entry.fullPath;
@@ -1214,7 +1382,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
             if (m_selectedIndices.empty())
             {
                 // If no selection, delete just this file
-                selectedPaths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, selectedPaths);
             }
             else
             {
@@ -1223,7 +1391,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
             }
@@ -1280,7 +1448,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
             std::vector<std::wstring> selectedPaths;
             if (m_selectedIndices.empty())
             {
-                selectedPaths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, selectedPaths);
             }
             else
             {
@@ -1288,7 +1456,7 @@ void FileBrowser::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
             }
@@ -1471,6 +1639,13 @@ void FileBrowser::DrawNavigationBar()
 
     ImGui::SameLine();
 
+    // Directory still being read (slow shares)
+    if (m_enumerator.IsBusy())
+    {
+        ImGui::TextDisabled("Loading...");
+        ImGui::SameLine();
+    }
+
     // New Job button (only show if in project folder)
     if (m_bookmarkManager)
     {
@@ -1583,7 +1758,7 @@ void FileBrowser::DrawNavigationBar()
         if (ImGui::Button("Reset All"))
         {
             m_filterExtensions.clear();
-            RefreshFileList();
+            RebuildFileList();
         }
 
         ImGui::Separator();
@@ -1596,34 +1771,26 @@ void FileBrowser::DrawNavigationBar()
                 m_filterExtensions.insert(L"[folders]");
             else
                 m_filterExtensions.erase(L"[folders]");
-            RefreshFileList();
+            RebuildFileList();
         }
 
         ImGui::Separator();
 
         // Collect unique extensions from current directory (unfiltered)
         std::set<std::wstring> extensions;
-        try
+        for (const auto& entry : m_directoryEntries)
         {
-            for (const auto& entry : std::filesystem::directory_iterator(m_currentDirectory))
+            if (!entry.isDirectory)
             {
-                if (!entry.is_directory())
+                std::wstring ext = std::filesystem::path(entry.name).extension().wstring();
+                if (!ext.empty())
                 {
-                    std::filesystem::path p(entry.path());
-                    std::wstring ext = p.extension().wstring();
-                    if (!ext.empty())
-                    {
-                        // Convert to lowercase for consistency
-                        std::transform(ext.begin(), ext.end(), ext.begin(), ::towlower);
-                        extensions.insert(ext);
-                    }
+                    // Convert to lowercase for consistency
+                    std::transform(ext.begin(), ext.end(), ext.begin(), ::towlower);
+                    extensions.insert(ext);
                 }
             }
         }
-        catch (...)
-        {
-            // Failed to read directory
-        }
 
         // Display each extension as a toggleable checkbox
         for (const auto& ext : extensions)
@@ -1639,7 +1806,7 @@ void FileBrowser::DrawNavigationBar()
                     m_filterExtensions.insert(ext);
                 else
                     m_filterExtensions.erase(ext);
-                RefreshFileList();
+                RebuildFileList();
             }
         }
 
@@ -1734,15 +1901,9 @@ void FileBrowser::DrawFileList(HWND hwnd)
                      m_searchQuery, UFB::WideToUtf8(m_preSearchDirectory).c_str());
             ImGui::TextWrapped("%s", bannerText);
 
-            // Check if network path
-            if (m_preSearchDirectory.size() >= 2 && m_preSearchDirectory[0] == L'\\' && m_preSearchDirectory[1] == L'\\')
-            {
-                ImGui::TextDisabled("Note: Everything may not be indexing this drive or folder");
-            }
-            else
+            if (!m_searchIndexed)
             {
-              /*  ImGui::TextDisabled("Possible causes: 1) Everything hasn't indexed this folder, 2) Folder is excluded in Everything settings,");
-                ImGui::TextDisabled("3) Cloud sync/junction point - check Everything > Options > Indexes > NTFS > 'Index folder junctions'");*/
+                ImGui::TextDisabled("Note: this folder is not in a subscribed job, so it was searched directly");
             }
         }
         else
@@ -1751,6 +1912,12 @@ void FileBrowser::DrawFileList(HWND hwnd)
                      m_searchResultCount, (m_searchResultCount == 1 ? "" : "s"),
                      m_searchQuery, UFB::WideToUtf8(m_preSearchDirectory).c_str());
             ImGui::TextWrapped("%s", bannerText);
+
+            if (m_searchTruncated)
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("(limit reached, refine the search)");
+            }
         }
 
         ImGui::PopStyleColor();
@@ -1758,6 +1925,9 @@ void FileBrowser::DrawFileList(HWND hwnd)
         ImGui::PopStyleColor();
     }
 
+    // Apply directory listing batches from the background enumerator
+    PollDirectoryListing();
+
     // Process completed thumbnails from background threads (convert HBITMAP to GL textures)
     m_thumbnailManager.ProcessCompletedThumbnails();
 
@@ -1777,7 +1947,7 @@ void FileBrowser::DrawFileList(HWND hwnd)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
                 if (!selectedPaths.empty())
@@ -1797,7 +1967,7 @@ void FileBrowser::DrawFileList(HWND hwnd)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
                 if (!selectedPaths.empty())
@@ -1823,7 +1993,7 @@ void FileBrowser::DrawFileList(HWND hwnd)
                 {
                     if (idx >= 0 && idx < m_files.size())
                     {
-                        selectedPaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], selectedPaths);
                     }
                 }
                 if (!selectedPaths.empty())
@@ -1840,7 +2010,7 @@ void FileBrowser::DrawFileList(HWND hwnd)
             if (m_selectedIndices.size() == 1)
             {
                 int idx = *m_selectedIndices.begin();
-                if (idx >= 0 && idx < m_files.size())
+                if (idx >= 0 && idx < m_files.size() && !m_files[idx].IsSequence())
                 {
                     m_renameOriginalPath = m_files[idx].fullPath;
                     std::wstring filename = m_files[idx].name;
@@ -2311,14 +2481,14 @@ void FileBrowser::DrawListView(HWND hwnd)
                         {
                             if (idx < m_files.size())
                             {
-                                filePaths.push_back(m_files[idx].fullPath);
+                                UFB::AppendEntryPaths(m_files[idx], filePaths);
                             }
                         }
                     }
                     else
                     {
                         // Not selected - drag just this one
-                        filePaths.push_back(entry.fullPath);
+                        UFB::AppendEntryPaths(entry, filePaths);
                     }
 
                     if (!filePaths.empty())
@@ -2348,33 +2518,20 @@ void FileBrowser::DrawListView(HWND hwnd)
                             {
                                 if (idx < m_files.size())
                                 {
-                                    filePaths.push_back(m_files[idx].fullPath);
-
-                                    // Also build UTF-8 string for ImGui payload
-                                    std::wstring& selectedPath = m_files[idx].fullPath;
-                                    int utf8Size = WideCharToMultiByte(CP_UTF8, 0, selectedPath.c_str(), -1, nullptr, 0, nullptr, nullptr);
-                                    if (utf8Size > 0)
-                                    {
-                                        std::string pathUtf8;
-                                        pathUtf8.resize(utf8Size);
-                                        WideCharToMultiByte(CP_UTF8, 0, selectedPath.c_str(), -1, &pathUtf8[0], utf8Size, nullptr, nullptr);
-                                        pathUtf8.resize(utf8Size - 1); // Remove null terminator
-                                        allPathsUtf8 += pathUtf8 + "\n";
-                                    }
+                                    UFB::AppendEntryPaths(m_files[idx], filePaths);
                                 }
                             }
                         }
                         else
                         {
                             // Not selected - drag just this one
-                            filePaths.push_back(entry.fullPath);
+                            UFB::AppendEntryPaths(entry, filePaths);
+                        }
 
-                            int utf8Size = WideCharToMultiByte(CP_UTF8, 0, entry.fullPath.c_str(), -1, nullptr, 0, nullptr, nullptr);
-                            if (utf8Size > 0)
-                            {
-                                allPathsUtf8.resize(utf8Size);
-                                WideCharToMultiByte(CP_UTF8, 0, entry.fullPath.c_str(), -1, &allPathsUtf8[0], utf8Size, nullptr, nullptr);
-                            }
+                        // UTF-8 payload for in-app drops (one path per line; sequences expand to every frame)
+                        for (const auto& path : filePaths)
+                        {
+                            allPathsUtf8 += UFB::WideToUtf8(path) + "\n";
                         }
 
                         // Check if mouse has left the main window (HWND) - if so, start Windows OLE drag
@@ -2935,14 +3092,14 @@ void FileBrowser::DrawGridView(HWND hwnd)
                 {
                     if (idx < m_files.size())
                     {
-                        filePaths.push_back(m_files[idx].fullPath);
+                        UFB::AppendEntryPaths(m_files[idx], filePaths);
                     }
                 }
             }
             else
             {
                 // Not selected - drag just this one
-                filePaths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, filePaths);
             }
 
             if (!filePaths.empty())
@@ -2972,33 +3129,20 @@ void FileBrowser::DrawGridView(HWND hwnd)
                     {
                         if (idx < m_files.size())
                         {
-                            filePaths.push_back(m_files[idx].fullPath);
-
-                            // Also build UTF-8 string for ImGui payload
-                            std::wstring& selectedPath = m_files[idx].fullPath;
-                            int utf8Size = WideCharToMultiByte(CP_UTF8, 0, selectedPath.c_str(), -1, nullptr, 0, nullptr, nullptr);
-                            if (utf8Size > 0)
-                            {
-                                std::string pathUtf8;
-                                pathUtf8.resize(utf8Size);
-                                WideCharToMultiByte(CP_UTF8, 0, selectedPath.c_str(), -1, &pathUtf8[0], utf8Size, nullptr, nullptr);
-                                pathUtf8.resize(utf8Size - 1); // Remove null terminator
-                                allPathsUtf8 += pathUtf8 + "\n";
-                            }
+                            UFB::AppendEntryPaths(m_files[idx], filePaths);
                         }
                     }
                 }
                 else
                 {
                     // Not selected - drag just this one
-                    filePaths.push_back(entry.fullPath);
+                    UFB::AppendEntryPaths(entry, filePaths);
+                }
 
-                    int utf8Size = WideCharToMultiByte(CP_UTF8, 0, entry.fullPath.c_str(), -1, nullptr, 0, nullptr, nullptr);
-                    if (utf8Size > 0)
-                    {
-                        allPathsUtf8.resize(utf8Size);
-                        WideCharToMultiByte(CP_UTF8, 0, entry.fullPath.c_str(), -1, &allPathsUtf8[0], utf8Size, nullptr, nullptr);
-                    }
+                // UTF-8 payload for in-app drops (one path per line; sequences expand to every frame)
+                for (const auto& path : filePaths)
+                {
+                    allPathsUtf8 += UFB::WideToUtf8(path) + "\n";
                 }
 
                 // Check if mouse has left the main window (HWND) - if so, start Windows OLE drag
@@ -3835,119 +3979,36 @@ void FileBrowser::ExecuteSearch(const std::string& query)
         m_forwardHistory.clear();
     }
 
-    // Build es.exe command
-    // Use -path to limit search to current directory recursively
-    // Use -csv for easy parsing
-    std::string pathUtf8 = UFB::WideToUtf8(m_currentDirectory);
-    std::string command = "es.exe \"" + query + "\" -path \"" + pathUtf8 + "\" -csv -n 1000";
-
-    std::cout << "[FileBrowser] Command: " << command << std::endl;
-
-    // Execute command and capture output
-    std::string output;
-    SECURITY_ATTRIBUTES sa = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
-    HANDLE hRead, hWrite;
-
-    if (!CreatePipe(&hRead, &hWrite, &sa, 0))
-    {
-        std::cerr << "[FileBrowser] Failed to create pipe" << std::endl;
-        return;
-    }
-
-    STARTUPINFOA si = { sizeof(STARTUPINFOA) };
-    si.dwFlags = STARTF_USESTDHANDLES | STARTF_USESHOWWINDOW;
-    si.hStdOutput = hWrite;
-    si.hStdError = hWrite;
-    si.wShowWindow = SW_HIDE;
-
-    PROCESS_INFORMATION pi;
-
-    if (CreateProcessA(NULL, const_cast<char*>(command.c_str()), NULL, NULL, TRUE,
-                       0, NULL, NULL, &si, &pi))
-    {
-        CloseHandle(hWrite);
-
-        // Read output
-        char buffer[4096];
-        DWORD bytesRead;
-
-        while (ReadFile(hRead, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0)
-        {
-            buffer[bytesRead] = '\0';
-            output += buffer;
-        }
-
-        WaitForSingleObject(pi.hProcess, INFINITE);
-        CloseHandle(pi.hProcess);
-        CloseHandle(pi.hThread);
-        CloseHandle(hRead);
-    }
+    // Subscribed jobs are answered from the file index; other folders are walked directly
+    constexpr size_t kMaxSearchResults = 10000;
+    std::wstring queryWide = UFB::Utf8ToWide(query);
+    std::vector<UFB::FileIndexResult> results;
+    m_searchIndexed = fileIndex && fileIndex->IsIndexed(m_currentDirectory);
+    if (m_searchIndexed)
+        results = fileIndex->Search(m_currentDirectory, queryWide, kMaxSearchResults, &m_searchTruncated);
     else
-    {
-        CloseHandle(hWrite);
-        CloseHandle(hRead);
-        std::cerr << "[FileBrowser] Failed to execute es.exe" << std::endl;
-        return;
-    }
+        results = UFB::FileIndex::SearchUnindexed(m_currentDirectory, queryWide, kMaxSearchResults, &m_searchTruncated);
+
+    // Search results replace the listing; drop any directory read still in flight
+    m_enumerator.Cancel();
+    m_pendingEntries.clear();
+    m_streamingListing = false;
+    m_listedDirectory.clear();
 
-    // Parse CSV output (format: Filename)
-    // First line is header, skip it
     std::lock_guard<std::mutex> lock(m_filesMutex);
     m_files.clear();
-    std::istringstream stream(output);
-    std::string line;
-    bool firstLine = true;
-
-    std::cout << "[FileBrowser] Raw output length: " << output.length() << " bytes" << std::endl;
-
-    while (std::getline(stream, line))
+    m_files.reserve(results.size());
+    for (auto& result : results)
     {
-        // Remove trailing carriage return if present (Windows line endings)
-        if (!line.empty() && line.back() == '\r')
-            line.pop_back();
-
-        if (firstLine)
-        {
-            firstLine = false;
-            continue;  // Skip header
-        }
-
-        if (line.empty())
-            continue;
-
-        // Remove quotes if present
-        if (!line.empty() && line.front() == '\"' && line.back() == '\"')
-        {
-            line = line.substr(1, line.length() - 2);
-        }
-
-        std::cout << "[FileBrowser] Processing line: " << line << std::endl;
-
-        // Convert to wstring
-        int wchars_num = MultiByteToWideChar(CP_UTF8, 0, line.c_str(), -1, NULL, 0);
-        std::wstring wpath(wchars_num, 0);
-        MultiByteToWideChar(CP_UTF8, 0, line.c_str(), -1, &wpath[0], wchars_num);
-        wpath.resize(wchars_num - 1);  // Remove null terminator
-
-        // Create FileEntry
-        try
-        {
-            if (std::filesystem::exists(wpath))
-            {
-                FileEntry entry;
-                entry.fullPath = wpath;
-                entry.name = std::filesystem::path(wpath).filename().wstring();
-                entry.isDirectory = std::filesystem::is_directory(wpath);
-                entry.size = entry.isDirectory ? 0 : std::filesystem::file_size(wpath);
-                entry.lastModified = std::filesystem::last_write_time(wpath);
-
-                m_files.push_back(entry);
-            }
-        }
-        catch (const std::exception& e)
-        {
-            std::cerr << "[FileBrowser] Error processing file: " << e.what() << std::endl;
-        }
+        FileEntry entry;
+        entry.name = std::filesystem::path(result.path).filename().wstring();
+        entry.fullPath = std::move(result.path);
+        entry.isDirectory = result.isDirectory;
+        entry.size = result.size;
+        // file_time_type counts 100ns ticks since 1601, the same as FILETIME
+        entry.lastModified = std::filesystem::file_time_type(
+            std::filesystem::file_time_type::duration(static_cast<int64_t>(result.lastWriteTime)));
+        m_files.push_back(std::move(entry));
     }
 
     // Update search state
@@ -3958,18 +4019,8 @@ void FileBrowser::ExecuteSearch(const std::string& query)
     // Sort results
     SortFileList();
 
-    std::cout << "[FileBrowser] Search completed: " << m_searchResultCount << " results" << std::endl;
-
-    // Check if searching on network drive and warn user
-    if (m_searchResultCount == 0 && m_preSearchDirectory.size() >= 2)
-    {
-        // Check if it's a network path (starts with \\ or is mapped drive pointing to network)
-        if (m_preSearchDirectory[0] == L'\\' && m_preSearchDirectory[1] == L'\\')
-        {
-            std::cerr << "[FileBrowser] Warning: Searching on network path. Everything may not index network drives by default." << std::endl;
-            std::cerr << "[FileBrowser] Network path: " << UFB::WideToUtf8(m_preSearchDirectory) << std::endl;
-        }
-    }
+    std::cout << "[FileBrowser] Search completed: " << m_searchResultCount << " results"
+              << (m_searchTruncated ? " (limit reached)" : "") << (m_searchIndexed ? "" : " (not indexed)") << std::endl;
 }
 
 void FileBrowser::ExitSearchMode()
@@ -4010,20 +4061,8 @@ void FileBrowser::ShowInBrowser(const std::wstring& filePath)
             ExitSearchMode();
         }
 
-        // Navigate to parent directory
-        SetCurrentDirectory(parentDir);
-
-        // Find and select the file in the list
-        for (size_t i = 0; i < m_files.size(); ++i)
-        {
-            if (m_files[i].fullPath == filePath)
-            {
-                m_selectedIndices.clear();
-                m_selectedIndices.insert(static_cast<int>(i));
-                std::cout << "[FileBrowser] Selected file at index " << i << std::endl;
-                break;
-            }
-        }
+        // Navigate to parent directory and select the file once it is listed
+        SetCurrentDirectoryAndSelectFile(parentDir, filePath);
     }
     catch (const std::exception& e)
     {
@@ -10,22 +10,16 @@
 #include "imgui.h"
 #include "icon_manager.h"
 #include "thumbnail_manager.h"
+#include "directory_enumerator.h"
+#include "file_entry.h"
 
 // Forward declarations
 namespace UFB {
     class BookmarkManager;
     class SubscriptionManager;
+    class FileIndex;
 }
 
-struct FileEntry
-{
-    std::wstring name;
-    std::wstring fullPath;
-    bool isDirectory;
-    uintmax_t size;
-    std::filesystem::file_time_type lastModified;
-};
-
 class FileBrowser
 {
 public:
@@ -64,10 +58,23 @@ public:
 
     // Public settings (static so it's shared across all browser instances)
     static bool showHiddenFiles;
+    static bool collapseImageSequences;  // Show "name.####.ext" frames as one entry (applies on refresh)
+
+    // Filename index used by search (set by main; folders outside it are searched directly)
+    static UFB::FileIndex* fileIndex;
 
     // Callback for transcoding video files
     std::function<void(const std::vector<std::wstring>&)> onTranscodeToMP4;
 
+    // Callback for copying/moving files into a folder (queued on the copy engine after asking about names already
+    // taken there; SHFileOperation when unset)
+    std::function<void(const std::vector<std::wstring>& sources, const std::wstring& destDirectory, bool move)> onCopyFiles;
+
+    // Callbacks for content hashing (folder, folder, manifest file)
+    std::function<void(const std::wstring& folder)> onFindDuplicates;
+    std::function<void(const std::wstring& folder)> onCreateHashManifest;
+    std::function<void(const std::wstring& manifestPath)> onVerifyHashManifest;
+
     // Callback for opening shot view
     std::function<void(const std::wstring& categoryPath, const std::wstring& categoryName)> onOpenShotView;
 
@@ -92,9 +99,19 @@ public:
     std::function<void(const std::vector<std::wstring>&)> onCustomContextMenu;
 
 private:
-    // Refresh the file list for the current directory
+    // Refresh the file list for the current directory (starts a background enumeration; the
+    // current rows stay visible until PollDirectoryListing() applies the new listing)
     void RefreshFileList();
 
+    // Apply directory listing batches from the background enumerator (main thread, each frame)
+    void PollDirectoryListing();
+
+    // Rebuild m_files from m_directoryEntries (filter, sequence collapse, sort) without touching disk
+    void RebuildFileList();
+
+    // Select m_pendingSelectPath if it is in m_files
+    void SelectPendingFile();
+
     // Navigate up one directory level
     void NavigateUp();
 
@@ -146,6 +163,18 @@ private:
     std::vector<FileEntry> m_files;
     mutable std::mutex m_filesMutex;  // Protects m_files from concurrent access
 
+    // Background directory listing
+    UFB::DirectoryEnumerator m_enumerator;
+    std::vector<FileEntry> m_directoryEntries;  // Unfiltered listing m_files is built from
+    std::vector<FileEntry> m_pendingEntries;    // Listing being read
+    std::wstring m_listedDirectory;             // Directory m_directoryEntries belongs to
+    std::wstring m_pendingSelectPath;           // File to select once its directory listing completes
+    bool m_streamingListing = false;            // New directory is shown batch by batch while it loads
+    uint64_t m_listedVersion = 0;               // UFB::DirectoryCache version of m_directoryEntries
+    uint64_t m_readVersion = 0;                 // Version when the current read started
+    double m_lastAutoRefreshTime = 0.0;         // Throttles re-reads triggered by the directory watcher
+    double m_lastStreamRebuildTime = 0.0;       // Throttles row rebuilds while a listing streams in
+
     // Icon manager
     IconManager m_iconManager;
 
@@ -240,9 +269,11 @@ private:
     char m_searchQuery[256] = {};                   // Current search query
     std::wstring m_preSearchDirectory;              // Directory before search (to return to)
     int m_searchResultCount = 0;                    // Number of search results found
+    bool m_searchTruncated = false;                 // Result limit reached
+    bool m_searchIndexed = false;                   // Searched with the file index (false: walked the folder)
 
     // Search helper methods
-    void ExecuteSearch(const std::string& query);   // Execute es.exe and populate results
+    void ExecuteSearch(const std::string& query);   // Search below the current directory and populate results
     void ExitSearchMode();                          // Return to pre-search directory
     void ShowInBrowser(const std::wstring& filePath); // Navigate to file's parent directory and select it
 
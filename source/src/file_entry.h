@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// One row of a directory listing (file browser, views, enumerator, cache)
+struct FileEntry
+{
+    std::wstring name;
+    std::wstring fullPath;
+    bool isDirectory;
+    uintmax_t size;
+    std::filesystem::file_time_type lastModified;
+
+    // Image sequence (set by UFB::CollapseImageSequences); frames is empty for regular entries
+    std::vector<int> frames;         // Frame numbers present, ascending
+    std::wstring sequencePrefix;     // Full path up to the frame number
+    std::wstring sequenceSuffix;     // Everything after the frame number (".exr")
+    int framePadding = 0;            // Zero-padded width of the frame number, 0 = unpadded
+
+    bool IsSequence() const { return !frames.empty(); }
+};
@@ -0,0 +1,494 @@
+#include "file_hash_panel.h"
+#include "utils.h"
+#include "imgui.h"
+#include <filesystem>
+#include <algorithm>
+#include <windows.h>
+
+namespace fs = std::filesystem;
+
+// Helper to get Windows accent color (global function from main.cpp)
+extern ImVec4 GetWindowsAccentColor();
+
+// Mono font from main.cpp
+extern ImFont* font_mono;
+
+namespace UFB {
+
+// Helper: Format a byte count for display
+static std::string FormatBytes(double bytes) {
+    const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        unit++;
+    }
+    char text[32];
+    snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+    return text;
+}
+
+static const char* GetKindString(HashTask::Kind kind) {
+    switch (kind) {
+        case HashTask::Kind::FindDuplicates: return "Find Duplicates";
+        case HashTask::Kind::CreateManifest: return "Create Manifest";
+        case HashTask::Kind::VerifyManifest: return "Verify Manifest";
+        default: return "Unknown";
+    }
+}
+
+static const char* GetStateString(HashTask::State state) {
+    switch (state) {
+        case HashTask::State::Queued: return "Queued";
+        case HashTask::State::Scanning: return "Scanning";
+        case HashTask::State::Hashing: return "Hashing";
+        case HashTask::State::Completed: return "Completed";
+        case HashTask::State::Failed: return "Failed";
+        case HashTask::State::Cancelled: return "Cancelled";
+        default: return "Unknown";
+    }
+}
+
+static const char* GetReasonString(ManifestMismatch::Reason reason) {
+    switch (reason) {
+        case ManifestMismatch::Reason::Missing: return "Missing";
+        case ManifestMismatch::Reason::Changed: return "Changed";
+        case ManifestMismatch::Reason::Unreadable: return "Unreadable";
+        default: return "Unknown";
+    }
+}
+
+// FileHashPanel implementation
+FileHashPanel::FileHashPanel() {
+}
+
+FileHashPanel::~FileHashPanel() {
+}
+
+bool FileHashPanel::IsFinished(const HashTask& task) {
+    return task.state == HashTask::State::Completed ||
+           task.state == HashTask::State::Failed ||
+           task.state == HashTask::State::Cancelled;
+}
+
+void FileHashPanel::Render() {
+    if (!m_isOpen) return;
+
+    ImGui::SetNextWindowSize(ImVec2(900, 600), ImGuiCond_FirstUseEver);
+
+    if (ImGui::Begin("Hash Results", &m_isOpen, ImGuiWindowFlags_None)) {
+        RenderToolbar();
+        ImGui::Separator();
+
+        ImGui::BeginChild("HashTaskRegion", ImVec2(0, m_taskTableHeight), true, ImGuiWindowFlags_NoScrollbar);
+        RenderTaskTable();
+        ImGui::EndChild();
+
+        ImGui::Separator();
+
+        // Results of the selected task take the remaining space
+        ImGui::BeginChild("HashResultsRegion", ImVec2(0, 0), true, ImGuiWindowFlags_NoScrollbar);
+        RenderResults();
+        ImGui::EndChild();
+    }
+    ImGui::End();
+}
+
+void FileHashPanel::RenderToolbar() {
+    size_t active = 0;
+    float totalSpeed = 0.0f;
+    for (const auto& entry : m_tasks) {
+        if (!IsFinished(entry.task)) {
+            active++;
+            totalSpeed += entry.bytesPerSecond;
+        }
+    }
+
+    ImVec4 accentColor = GetWindowsAccentColor();
+    ImVec4 statusColor = active > 0 ? accentColor : ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+    ImGui::TextColored(statusColor, "STATUS: %s", active > 0 ? "HASHING" : "IDLE");
+    ImGui::SameLine();
+    ImGui::Text(" | Tasks: %zu  Active: %zu", m_tasks.size(), active);
+    if (active > 0 && totalSpeed > 0.0f) {
+        ImGui::SameLine();
+        ImGui::Text(" | %s/s", FormatBytes(totalSpeed).c_str());
+    }
+
+    ImGui::SameLine(ImGui::GetWindowWidth() - 150);
+    if (ImGui::Button("Clear Finished", ImVec2(140, 0))) {
+        ClearFinished();
+    }
+}
+
+void FileHashPanel::RenderTaskTable() {
+    if (m_tasks.empty()) {
+        ImGui::TextDisabled("No hash tasks");
+        ImGui::TextDisabled("Right-click a folder in a browser to find duplicates or create a hash manifest.");
+        return;
+    }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                           ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+    // Push table colors for subtle borders
+    ImGui::PushStyleColor(ImGuiCol_TableBorderStrong, ImVec4(0.31f, 0.31f, 0.31f, 0.50f));
+    ImGui::PushStyleColor(ImGuiCol_TableBorderLight, ImVec4(0.23f, 0.23f, 0.23f, 0.50f));
+    ImGui::PushStyleColor(ImGuiCol_TableRowBgAlt, ImVec4(1.00f, 1.00f, 1.00f, 0.03f));
+
+    if (ImGui::BeginTable("HashTasksTable", 5, flags)) {
+        ImGui::TableSetupColumn("Task", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+        ImGui::TableSetupColumn("Path", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableSetupColumn("Progress", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupColumn("Read Speed", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        ImVec4 accentColor = GetWindowsAccentColor();
+        uint64_t cancelTaskId = 0;
+
+        for (const auto& entry : m_tasks) {
+            const HashTask& task = entry.task;
+            ImGui::TableNextRow();
+            ImGui::PushID((int)task.id);
+
+            // Task column (selectable)
+            ImGui::TableSetColumnIndex(0);
+            if (ImGui::Selectable(GetKindString(task.kind), task.id == m_selectedTaskId,
+                                 ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap)) {
+                m_selectedTaskId = task.id;
+            }
+            if (ImGui::BeginPopupContextItem()) {
+                if (!IsFinished(task) && ImGui::MenuItem("Cancel")) {
+                    cancelTaskId = task.id;
+                }
+                ImGui::EndPopup();
+            }
+
+            ImGui::TableSetColumnIndex(1);
+            ImGui::TextUnformatted(WideToUtf8(task.path).c_str());
+
+            ImGui::TableSetColumnIndex(2);
+            if (task.state == HashTask::State::Failed || task.state == HashTask::State::Cancelled) {
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", GetStateString(task.state));
+            } else {
+                ImGui::TextColored(accentColor, "%s", GetStateString(task.state));
+            }
+
+            // Progress column with accent color
+            ImGui::TableSetColumnIndex(3);
+            if (task.state == HashTask::State::Scanning) {
+                ImGui::TextDisabled("%u files found", task.filesTotal);
+            } else if (task.state != HashTask::State::Queued) {
+                float fraction = task.filesTotal > 0 ? (float)task.filesHashed / (float)task.filesTotal : 1.0f;
+                char text[64];
+                snprintf(text, sizeof(text), "%u / %u files (%u cached)", task.filesHashed, task.filesTotal, task.filesCached);
+                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, accentColor);
+                ImGui::ProgressBar(std::clamp(fraction, 0.0f, 1.0f), ImVec2(-1.0f, 0.0f), text);
+                ImGui::PopStyleColor();
+            } else {
+                ImGui::TextDisabled("--");
+            }
+
+            // Live speed while running, average read throughput once done
+            ImGui::TableSetColumnIndex(4);
+            if (font_mono) ImGui::PushFont(font_mono);
+            if (!IsFinished(task) && entry.bytesPerSecond > 0.0f) {
+                ImGui::TextDisabled("%s/s", FormatBytes(entry.bytesPerSecond).c_str());
+            } else if (IsFinished(task) && task.readSeconds > 0.0 && task.bytesRead > 0) {
+                ImGui::TextDisabled("%s/s", FormatBytes((double)task.bytesRead / task.readSeconds).c_str());
+            } else {
+                ImGui::TextDisabled("--");
+            }
+            if (font_mono) ImGui::PopFont();
+
+            ImGui::PopID();
+        }
+
+        ImGui::EndTable();
+
+        if (cancelTaskId != 0 && m_hashService) {
+            m_hashService->CancelTask(cancelTaskId);
+        }
+    }
+
+    ImGui::PopStyleColor(3); // Pop table colors
+}
+
+void FileHashPanel::RenderResults() {
+    TaskEntry* entry = m_selectedTaskId != 0 ? FindTask(m_selectedTaskId) : nullptr;
+    if (!entry) {
+        ImGui::TextDisabled("No task selected");
+        return;
+    }
+
+    const HashTask& task = entry->task;
+    ImGui::Text("%s: %s", GetKindString(task.kind), WideToUtf8(task.path).c_str());
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Left Browser##TaskLB")) {
+        if (onOpenInLeftBrowser) onOpenInLeftBrowser(task.kind == HashTask::Kind::VerifyManifest
+            ? fs::path(task.path).parent_path().wstring() : task.path);
+    }
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Right Browser##TaskRB")) {
+        if (onOpenInRightBrowser) onOpenInRightBrowser(task.kind == HashTask::Kind::VerifyManifest
+            ? fs::path(task.path).parent_path().wstring() : task.path);
+    }
+
+    // Read statistics (files taken from the cache were not read)
+    if (task.bytesRead > 0 && task.readSeconds > 0.0) {
+        ImGui::Text("Read %s in %.1fs (%.2f GB/s), %u of %u files unchanged since last hashed",
+                    FormatBytes((double)task.bytesRead).c_str(), task.readSeconds,
+                    (double)task.bytesRead / task.readSeconds / (1024.0 * 1024.0 * 1024.0),
+                    task.filesCached, task.filesTotal);
+    } else if (task.filesCached > 0) {
+        ImGui::Text("All %u files unchanged since last hashed (nothing read)", task.filesCached);
+    }
+
+    if (!task.errorMessage.empty()) {
+        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", task.errorMessage.c_str());
+    }
+
+    ImGui::Separator();
+
+    if (!IsFinished(task)) {
+        ImGui::TextDisabled("Results appear when the task completes.");
+        return;
+    }
+    if (task.state == HashTask::State::Cancelled) {
+        ImGui::TextDisabled("Cancelled.");
+        return;
+    }
+
+    if (task.kind == HashTask::Kind::FindDuplicates) {
+        RenderDuplicates(task);
+    } else {
+        RenderMismatches(task);
+    }
+}
+
+void FileHashPanel::RenderDuplicates(const HashTask& task) {
+    if (task.duplicates.empty()) {
+        ImGui::TextDisabled("No duplicate files found.");
+        return;
+    }
+
+    // Flatten groups into rows once per task so the clipper can index them
+    if (m_duplicateRowsTaskId != task.id) {
+        m_duplicateRows.clear();
+        for (size_t g = 0; g < task.duplicates.size(); ++g) {
+            m_duplicateRows.push_back({ g, -1 });
+            for (size_t p = 0; p < task.duplicates[g].paths.size(); ++p) {
+                m_duplicateRows.push_back({ g, (int)p });
+            }
+        }
+        m_duplicateRowsTaskId = task.id;
+    }
+
+    uint64_t wasted = 0;
+    for (const auto& group : task.duplicates) {
+        wasted += group.size * (group.paths.size() - 1);
+    }
+    ImGui::Text("%zu duplicate group(s), %s reclaimable", task.duplicates.size(), FormatBytes((double)wasted).c_str());
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                           ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+    if (ImGui::BeginTable("DuplicatesTable", 2, flags)) {
+        ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)m_duplicateRows.size());
+
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const DuplicateRow& duplicateRow = m_duplicateRows[row];
+                const DuplicateGroup& group = task.duplicates[duplicateRow.groupIndex];
+                ImGui::TableNextRow();
+                ImGui::PushID(row);
+
+                ImGui::TableSetColumnIndex(0);
+                if (duplicateRow.pathIndex < 0) {
+                    // Group header: hash and copy count
+                    if (font_mono) ImGui::PushFont(font_mono);
+                    ImGui::TextColored(GetWindowsAccentColor(), "%s  (%zu copies)",
+                                       FileHashService::FormatHash(group.hash).c_str(), group.paths.size());
+                    if (font_mono) ImGui::PopFont();
+                } else {
+                    const std::wstring& path = group.paths[duplicateRow.pathIndex];
+                    ImGui::Indent();
+                    ImGui::Selectable(WideToUtf8(path).c_str(), false, ImGuiSelectableFlags_SpanAllColumns);
+                    ImGui::Unindent();
+                    RenderFileContextMenu(path);
+                }
+
+                ImGui::TableSetColumnIndex(1);
+                if (duplicateRow.pathIndex < 0) {
+                    ImGui::TextDisabled("%s", FormatBytes((double)group.size).c_str());
+                }
+
+                ImGui::PopID();
+            }
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+void FileHashPanel::RenderMismatches(const HashTask& task) {
+    if (!task.manifestPath.empty()) {
+        ImGui::Text("Manifest: %s", WideToUtf8(task.manifestPath).c_str());
+    }
+
+    if (task.kind == HashTask::Kind::CreateManifest) {
+        ImGui::Text("%u file(s) written to the manifest", task.verifiedCount);
+    } else if (task.mismatches.empty()) {
+        ImGui::TextColored(GetWindowsAccentColor(), "All %u file(s) match the manifest", task.verifiedCount);
+        return;
+    } else {
+        ImGui::Text("%u file(s) match, %zu problem(s):", task.verifiedCount, task.mismatches.size());
+    }
+
+    if (task.mismatches.empty()) return;
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                           ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+    if (ImGui::BeginTable("MismatchesTable", 2, flags)) {
+        ImGui::TableSetupColumn("Problem", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin((int)task.mismatches.size());
+
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const ManifestMismatch& mismatch = task.mismatches[row];
+                ImGui::TableNextRow();
+                ImGui::PushID(row);
+
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", GetReasonString(mismatch.reason));
+
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Selectable(WideToUtf8(mismatch.path).c_str(), false, ImGuiSelectableFlags_SpanAllColumns);
+                RenderFileContextMenu(mismatch.path);
+
+                ImGui::PopID();
+            }
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+void FileHashPanel::RenderFileContextMenu(const std::wstring& path) {
+    std::wstring folder = fs::path(path).parent_path().wstring();
+
+    // Middle-click to open the containing folder in a new window
+    if (ImGui::IsItemClicked(ImGuiMouseButton_Middle) && onOpenInNewWindow) {
+        onOpenInNewWindow(folder);
+    }
+
+    if (ImGui::BeginPopupContextItem()) {
+        if (ImGui::MenuItem("Open in Left Browser") && onOpenInLeftBrowser) {
+            onOpenInLeftBrowser(folder);
+        }
+        if (ImGui::MenuItem("Open in Right Browser") && onOpenInRightBrowser) {
+            onOpenInRightBrowser(folder);
+        }
+        if (ImGui::MenuItem("Show in Explorer")) {
+            std::wstring args = L"/select,\"" + path + L"\"";
+            ShellExecuteW(nullptr, L"open", L"explorer.exe", args.c_str(), nullptr, SW_SHOW);
+        }
+        if (ImGui::MenuItem("Copy Path")) {
+            ImGui::SetClipboardText(WideToUtf8(path).c_str());
+        }
+        ImGui::EndPopup();
+    }
+}
+
+void FileHashPanel::FindDuplicates(const std::wstring& folder) {
+    if (!m_hashService) return;
+    AddTask(m_hashService->FindDuplicates(folder));
+}
+
+void FileHashPanel::CreateManifest(const std::wstring& folder) {
+    if (!m_hashService) return;
+    AddTask(m_hashService->CreateManifest(folder));
+}
+
+void FileHashPanel::VerifyManifest(const std::wstring& manifestPath) {
+    if (!m_hashService) return;
+    AddTask(m_hashService->VerifyManifest(manifestPath));
+}
+
+void FileHashPanel::AddTask(uint64_t taskId) {
+    TaskEntry entry;
+    m_hashService->GetTask(taskId, entry.task, false);
+    entry.lastSampleTime = std::chrono::steady_clock::now();
+    m_tasks.push_back(std::move(entry));
+
+    m_selectedTaskId = taskId;
+    m_isOpen = true;
+}
+
+void FileHashPanel::ClearFinished() {
+    for (const auto& entry : m_tasks) {
+        if (IsFinished(entry.task) && m_hashService) {
+            m_hashService->ForgetTask(entry.task.id);
+        }
+    }
+
+    m_tasks.erase(std::remove_if(m_tasks.begin(), m_tasks.end(),
+                                 [](const TaskEntry& entry) { return IsFinished(entry.task); }),
+                  m_tasks.end());
+
+    if (!FindTask(m_selectedTaskId)) {
+        m_selectedTaskId = 0;
+    }
+    m_duplicateRows.clear();
+    m_duplicateRowsTaskId = 0;
+}
+
+void FileHashPanel::Update() {
+    if (!m_hashService) return;
+
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto& entry : m_tasks) {
+        if (IsFinished(entry.task)) continue;
+
+        // Progress only while running; results are copied once when the task finishes
+        if (!m_hashService->GetTask(entry.task.id, entry.task, false)) continue;
+        if (IsFinished(entry.task)) {
+            m_hashService->GetTask(entry.task.id, entry.task, true);
+            continue;
+        }
+
+        // Smoothed throughput, sampled twice a second
+        float dt = std::chrono::duration<float>(now - entry.lastSampleTime).count();
+        if (dt >= 0.5f) {
+            uint64_t read = entry.task.bytesRead;
+            float instant = read > entry.lastSampleBytes ? (float)(read - entry.lastSampleBytes) / dt : 0.0f;
+            entry.bytesPerSecond = entry.bytesPerSecond > 0.0f ? entry.bytesPerSecond * 0.7f + instant * 0.3f : instant;
+            entry.lastSampleBytes = read;
+            entry.lastSampleTime = now;
+        }
+    }
+}
+
+FileHashPanel::TaskEntry* FileHashPanel::FindTask(uint64_t taskId) {
+    for (auto& entry : m_tasks) {
+        if (entry.task.id == taskId) return &entry;
+    }
+    return nullptr;
+}
+
+} // namespace UFB
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "file_hash_service.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+
+namespace UFB {
+
+class FileHashPanel {
+public:
+    FileHashPanel();
+    ~FileHashPanel();
+
+    // Panel control
+    void Show() { m_isOpen = true; }
+    void Hide() { m_isOpen = false; }
+    void Toggle() { m_isOpen = !m_isOpen; }
+    bool IsOpen() const { return m_isOpen; }
+
+    // Service that runs the tasks (owned by main)
+    void SetHashService(FileHashService* hashService) { m_hashService = hashService; }
+
+    // Main render method
+    void Render();
+
+    // Task operations (show the panel)
+    void FindDuplicates(const std::wstring& folder);
+    void CreateManifest(const std::wstring& folder);
+    void VerifyManifest(const std::wstring& manifestPath);
+    void ClearFinished();
+
+    // Update (call each frame)
+    void Update();
+
+    // Callbacks for showing files in browsers (receive the containing folder)
+    std::function<void(const std::wstring&)> onOpenInLeftBrowser;
+    std::function<void(const std::wstring&)> onOpenInRightBrowser;
+    std::function<void(const std::wstring&)> onOpenInNewWindow;
+
+private:
+    struct TaskEntry {
+        HashTask task;                  // Latest snapshot (results once finished)
+        float bytesPerSecond = 0.0f;
+        uint64_t lastSampleBytes = 0;
+        std::chrono::steady_clock::time_point lastSampleTime;
+    };
+
+    // One row of the duplicates list: group header (pathIndex = -1) or a file of the group
+    struct DuplicateRow {
+        size_t groupIndex = 0;
+        int pathIndex = -1;
+    };
+
+    // UI Rendering
+    void RenderToolbar();
+    void RenderTaskTable();
+    void RenderResults();
+    void RenderDuplicates(const HashTask& task);
+    void RenderMismatches(const HashTask& task);
+    void RenderFileContextMenu(const std::wstring& path);
+
+    // Helpers
+    void AddTask(uint64_t taskId);
+    TaskEntry* FindTask(uint64_t taskId);
+    static bool IsFinished(const HashTask& task);
+
+    // State
+    bool m_isOpen = false;
+    FileHashService* m_hashService = nullptr;
+    std::vector<TaskEntry> m_tasks;
+    uint64_t m_selectedTaskId = 0;
+
+    // Flattened duplicate rows of the selected task (rebuilt when the selection changes)
+    std::vector<DuplicateRow> m_duplicateRows;
+    uint64_t m_duplicateRowsTaskId = 0;
+
+    // UI State
+    float m_taskTableHeight = 160.0f;
+};
+
+} // namespace UFB
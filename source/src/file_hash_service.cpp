@@ -0,0 +1,804 @@
+#include "file_hash_service.h"
+#include "subscription_manager.h"
+#include "utils.h"
+#include "xxhash64.h"
+#include <windows.h>
+#include <sqlite3.h>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+
+namespace UFB {
+
+namespace {
+
+// Files are mapped this much at a time (multiple of the 64 KB allocation granularity)
+constexpr uint64_t kViewSize = 64ull * 1024 * 1024;
+
+uint64_t FileTimeTicks(const FILETIME& time)
+{
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+std::wstring JoinPath(const std::wstring& folder, const std::wstring& name)
+{
+    if (!folder.empty() && folder.back() != L'\\' && folder.back() != L'/')
+        return folder + L'\\' + name;
+    return folder + name;
+}
+
+// Hash one mapped view; false when the pages could not be read (share dropped, file truncated meanwhile)
+bool HashView(XxHash64& hash, const uint8_t* data, size_t size)
+{
+    __try
+    {
+        hash.Update(data, size);
+        return true;
+    }
+    __except (GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+    {
+        return false;
+    }
+}
+
+} // namespace
+
+struct FileHashService::TaskState
+{
+    std::atomic<bool> cancelled{false};
+    std::atomic<uint32_t> filesTotal{0};
+    std::atomic<uint32_t> filesHashed{0};
+    std::atomic<uint32_t> filesCached{0};
+    std::atomic<uint64_t> bytesTotal{0};
+    std::atomic<uint64_t> bytesRead{0};
+
+    std::mutex mutex;   // Guards info (state, error, timings and results)
+    HashTask info;
+
+    void SetState(HashTask::State state)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        info.state = state;
+    }
+};
+
+FileHashService::FileHashService()
+{
+}
+
+FileHashService::~FileHashService()
+{
+    Shutdown();
+}
+
+bool FileHashService::Initialize(SubscriptionManager* subscriptionManager, int threadCount)
+{
+    if (!subscriptionManager || !subscriptionManager->GetDatabase())
+    {
+        std::cerr << "[FileHashService] Invalid database" << std::endl;
+        return false;
+    }
+
+    m_subscriptionManager = subscriptionManager;
+    m_threadCount = (std::max)(1, threadCount);
+
+    if (!CreateTables())
+        return false;
+
+    m_running = true;
+    m_taskThread = std::thread(&FileHashService::TaskThread, this);
+    return true;
+}
+
+void FileHashService::Shutdown()
+{
+    if (!m_running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        for (auto& pair : m_tasks)
+            pair.second->cancelled = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_running = false;
+        m_queue.clear();
+    }
+    m_queueCV.notify_all();
+
+    if (m_taskThread.joinable())
+    {
+        try
+        {
+            m_taskThread.join();
+        }
+        catch (const std::system_error& e)
+        {
+            std::cerr << "[FileHashService] Thread join error: " << e.what() << std::endl;
+            try { m_taskThread.detach(); } catch (...) {}
+        }
+    }
+}
+
+bool FileHashService::CreateTables()
+{
+    // Hash is the raw 64-bit value; mtime is FILETIME ticks so it compares exactly with directory listings
+    const char* sql = R"(
+        CREATE TABLE IF NOT EXISTS file_hashes (
+            path TEXT PRIMARY KEY COLLATE NOCASE,
+            size INTEGER NOT NULL,
+            mtime INTEGER NOT NULL,
+            hash INTEGER NOT NULL,
+            hashed_time INTEGER NOT NULL
+        );
+    )";
+
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(m_subscriptionManager->GetDatabase(), sql, nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK)
+    {
+        std::cerr << "[FileHashService] Failed to create tables: " << (errMsg ? errMsg : "") << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    return true;
+}
+
+std::optional<uint64_t> FileHashService::GetHash(const std::wstring& path)
+{
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &info) ||
+        (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        return std::nullopt;
+
+    uint64_t size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    uint64_t lastWriteTime = FileTimeTicks(info.ftLastWriteTime);
+
+    if (auto cached = GetCachedHash(path, size, lastWriteTime))
+        return cached;
+
+    uint64_t hash = 0;
+    if (!HashFile(path, hash, nullptr, nullptr))
+        return std::nullopt;
+
+    StoreHash(path, size, lastWriteTime, hash);
+    return hash;
+}
+
+std::optional<uint64_t> FileHashService::GetCachedHash(const std::wstring& path, uint64_t size, uint64_t lastWriteTime)
+{
+    if (!m_subscriptionManager)
+        return std::nullopt;
+
+    std::vector<FileInfo> files(1);
+    files[0].path = path;
+    files[0].size = size;
+    files[0].lastWriteTime = lastWriteTime;
+    LookupCachedHashes(files);
+
+    if (!files[0].hashed)
+        return std::nullopt;
+    return files[0].hash;
+}
+
+void FileHashService::StoreHash(const std::wstring& path, uint64_t size, uint64_t lastWriteTime, uint64_t hash)
+{
+    if (!m_subscriptionManager)
+        return;
+
+    FileInfo file;
+    file.path = path;
+    file.size = size;
+    file.lastWriteTime = lastWriteTime;
+    file.hash = hash;
+    file.hashed = true;
+    StoreHashes({ &file });
+}
+
+void FileHashService::LookupCachedHashes(std::vector<FileInfo>& files)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+    sqlite3* db = m_subscriptionManager->GetDatabase();
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, "SELECT size, mtime, hash FROM file_hashes WHERE path = ?", -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "[FileHashService] Failed to prepare lookup: " << sqlite3_errmsg(db) << std::endl;
+        return;
+    }
+
+    // One read transaction for the whole batch
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+
+    for (auto& file : files)
+    {
+        std::string pathUtf8 = WideToUtf8(file.path);
+        sqlite3_bind_text(stmt, 1, pathUtf8.c_str(), -1, SQLITE_TRANSIENT);
+
+        if (sqlite3_step(stmt) == SQLITE_ROW &&
+            static_cast<uint64_t>(sqlite3_column_int64(stmt, 0)) == file.size &&
+            static_cast<uint64_t>(sqlite3_column_int64(stmt, 1)) == file.lastWriteTime)
+        {
+            file.hash = static_cast<uint64_t>(sqlite3_column_int64(stmt, 2));
+            file.hashed = true;
+        }
+
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_finalize(stmt);
+}
+
+void FileHashService::StoreHashes(const std::vector<const FileInfo*>& files)
+{
+    if (files.empty())
+        return;
+
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+    sqlite3* db = m_subscriptionManager->GetDatabase();
+
+    const char* sql = "INSERT OR REPLACE INTO file_hashes (path, size, mtime, hash, hashed_time) VALUES (?, ?, ?, ?, ?)";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "[FileHashService] Failed to prepare insert: " << sqlite3_errmsg(db) << std::endl;
+        return;
+    }
+
+    sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+
+    sqlite3_int64 now = static_cast<sqlite3_int64>(GetCurrentTimeMs());
+    for (const FileInfo* file : files)
+    {
+        std::string pathUtf8 = WideToUtf8(file->path);
+        sqlite3_bind_text(stmt, 1, pathUtf8.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(file->size));
+        sqlite3_bind_int64(stmt, 3, static_cast<sqlite3_int64>(file->lastWriteTime));
+        sqlite3_bind_int64(stmt, 4, static_cast<sqlite3_int64>(file->hash));
+        sqlite3_bind_int64(stmt, 5, now);
+
+        if (sqlite3_step(stmt) != SQLITE_DONE)
+            std::cerr << "[FileHashService] Failed to store hash: " << sqlite3_errmsg(db) << std::endl;
+
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_finalize(stmt);
+}
+
+bool FileHashService::HashFile(const std::wstring& path, uint64_t& outHash, std::atomic<uint64_t>* bytesRead,
+                               const std::atomic<bool>* cancelled)
+{
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    XxHash64 hash;
+    bool ok = true;
+    uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+
+    // Empty files cannot be mapped (and hash to the empty digest)
+    if (size > 0)
+    {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        for (uint64_t offset = 0; offset < size; offset += kViewSize)
+        {
+            if (cancelled && *cancelled)
+            {
+                ok = false;
+                break;
+            }
+
+            size_t length = static_cast<size_t>((std::min)(kViewSize, size - offset));
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, static_cast<DWORD>(offset >> 32),
+                                       static_cast<DWORD>(offset), length);
+            if (!view)
+            {
+                ok = false;
+                break;
+            }
+
+            // Ask for the whole view up front so it is read in large requests rather than page by page
+            WIN32_MEMORY_RANGE_ENTRY range = { view, length };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+
+            bool read = HashView(hash, static_cast<const uint8_t*>(view), length);
+            UnmapViewOfFile(view);
+
+            if (!read)
+            {
+                ok = false;
+                break;
+            }
+
+            if (bytesRead)
+                *bytesRead += length;
+        }
+
+        CloseHandle(mapping);
+    }
+
+    CloseHandle(file);
+
+    if (ok)
+        outHash = hash.Digest();
+    return ok;
+}
+
+uint64_t FileHashService::FindDuplicates(const std::wstring& folder)
+{
+    return QueueTask(HashTask::Kind::FindDuplicates, folder);
+}
+
+uint64_t FileHashService::CreateManifest(const std::wstring& folder)
+{
+    return QueueTask(HashTask::Kind::CreateManifest, folder);
+}
+
+uint64_t FileHashService::VerifyManifest(const std::wstring& manifestPath)
+{
+    return QueueTask(HashTask::Kind::VerifyManifest, manifestPath);
+}
+
+uint64_t FileHashService::QueueTask(HashTask::Kind kind, const std::wstring& path)
+{
+    auto task = std::make_shared<TaskState>();
+    task->info.kind = kind;
+    task->info.path = path;
+
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        task->info.id = m_nextTaskId++;
+        m_tasks[task->info.id] = task;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.push_back(task);
+    }
+    m_queueCV.notify_one();
+
+    return task->info.id;
+}
+
+void FileHashService::CancelTask(uint64_t taskId)
+{
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    auto it = m_tasks.find(taskId);
+    if (it != m_tasks.end())
+        it->second->cancelled = true;
+}
+
+bool FileHashService::GetTask(uint64_t taskId, HashTask& outTask, bool includeResults)
+{
+    std::shared_ptr<TaskState> task;
+    {
+        std::lock_guard<std::mutex> lock(m_tasksMutex);
+        auto it = m_tasks.find(taskId);
+        if (it == m_tasks.end())
+            return false;
+        task = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(task->mutex);
+    if (includeResults)
+    {
+        outTask = task->info;
+    }
+    else
+    {
+        outTask.id = task->info.id;
+        outTask.kind = task->info.kind;
+        outTask.path = task->info.path;
+        outTask.state = task->info.state;
+        outTask.readSeconds = task->info.readSeconds;
+        outTask.errorMessage = task->info.errorMessage;
+    }
+
+    outTask.filesTotal = task->filesTotal;
+    outTask.filesHashed = task->filesHashed;
+    outTask.filesCached = task->filesCached;
+    outTask.bytesTotal = task->bytesTotal;
+    outTask.bytesRead = task->bytesRead;
+    return true;
+}
+
+void FileHashService::ForgetTask(uint64_t taskId)
+{
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    auto it = m_tasks.find(taskId);
+    if (it != m_tasks.end())
+    {
+        it->second->cancelled = true;
+        m_tasks.erase(it);
+    }
+}
+
+std::string FileHashService::FormatHash(uint64_t hash)
+{
+    char text[17];
+    snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+void FileHashService::TaskThread()
+{
+    while (m_running)
+    {
+        std::shared_ptr<TaskState> task;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCV.wait(lock, [this] { return !m_queue.empty() || !m_running; });
+
+            if (!m_running)
+                break;
+
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        RunTask(*task);
+    }
+}
+
+void FileHashService::RunTask(TaskState& task)
+{
+    if (!task.cancelled)
+    {
+        task.SetState(HashTask::State::Scanning);
+
+        switch (task.info.kind)
+        {
+            case HashTask::Kind::FindDuplicates: RunFindDuplicates(task); break;
+            case HashTask::Kind::CreateManifest: RunCreateManifest(task); break;
+            case HashTask::Kind::VerifyManifest: RunVerifyManifest(task); break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(task.mutex);
+    if (task.cancelled)
+        task.info.state = HashTask::State::Cancelled;
+    else if (!task.info.errorMessage.empty())
+        task.info.state = HashTask::State::Failed;
+    else
+        task.info.state = HashTask::State::Completed;
+}
+
+bool FileHashService::ScanFolder(TaskState& task, const std::wstring& folder, std::vector<FileInfo>& outFiles)
+{
+    std::vector<std::wstring> folders = { folder };
+    while (!folders.empty())
+    {
+        if (task.cancelled)
+            return false;
+
+        std::wstring current = std::move(folders.back());
+        folders.pop_back();
+
+        WIN32_FIND_DATAW data;
+        HANDLE find = FindFirstFileExW(JoinPath(current, L"*").c_str(), FindExInfoBasic, &data,
+                                       FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+        if (find == INVALID_HANDLE_VALUE)
+            continue;
+
+        do
+        {
+            const wchar_t* name = data.cFileName;
+            if (name[0] == L'.' && (name[1] == L'\0' || (name[1] == L'.' && name[2] == L'\0')))
+                continue;
+
+            if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                // Junctions and symlinked folders would be visited twice (or forever)
+                if (!(data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                    folders.push_back(JoinPath(current, name));
+                continue;
+            }
+
+            FileInfo file;
+            file.path = JoinPath(current, name);
+            file.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+            file.lastWriteTime = FileTimeTicks(data.ftLastWriteTime);
+            outFiles.push_back(std::move(file));
+
+            task.filesTotal = static_cast<uint32_t>(outFiles.size());
+        } while (FindNextFileW(find, &data));
+
+        FindClose(find);
+    }
+
+    return true;
+}
+
+void FileHashService::HashFiles(TaskState& task, std::vector<FileInfo>& files)
+{
+    uint64_t bytesTotal = 0;
+    for (const auto& file : files)
+        bytesTotal += file.size;
+
+    task.filesTotal = static_cast<uint32_t>(files.size());
+    task.bytesTotal = bytesTotal;
+    task.filesHashed = 0;
+    task.filesCached = 0;
+    task.SetState(HashTask::State::Hashing);
+
+    // Verification must read the files; everything else trusts hashes of unchanged files
+    if (task.info.kind != HashTask::Kind::VerifyManifest)
+    {
+        LookupCachedHashes(files);
+        for (const auto& file : files)
+        {
+            if (file.hashed)
+            {
+                task.filesHashed++;
+                task.filesCached++;
+            }
+        }
+    }
+
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        if (!files[i].hashed)
+            pending.push_back(i);
+    }
+
+    // Several files are read at once (keeps network shares and NVMe queues busy)
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next{0};
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < pending.size() && !task.cancelled; i = next++)
+        {
+            FileInfo& file = files[pending[i]];
+            uint64_t hash = 0;
+            if (HashFile(file.path, hash, &task.bytesRead, &task.cancelled))
+            {
+                file.hash = hash;
+                file.hashed = true;
+            }
+            task.filesHashed++;
+        }
+    };
+
+    size_t threadCount = (std::min)(static_cast<size_t>(m_threadCount), pending.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    if (threadCount > 0)
+        worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        task.info.readSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Remember what was read so unchanged files are not read again
+    std::vector<const FileInfo*> newHashes;
+    for (size_t index : pending)
+    {
+        if (files[index].hashed)
+            newHashes.push_back(&files[index]);
+    }
+    StoreHashes(newHashes);
+
+    std::cout << "[FileHashService] Hashed " << pending.size() << " file(s) ("
+              << (files.size() - pending.size()) << " cached), " << task.bytesRead << " bytes in "
+              << task.info.readSeconds << "s" << std::endl;
+}
+
+void FileHashService::RunFindDuplicates(TaskState& task)
+{
+    std::vector<FileInfo> files;
+    if (!ScanFolder(task, task.info.path, files))
+        return;
+
+    // Only files sharing a size with another file can be duplicates - the rest are never read
+    std::unordered_map<uint64_t, uint32_t> sizeCounts;
+    for (const auto& file : files)
+    {
+        if (file.size > 0)
+            sizeCounts[file.size]++;
+    }
+
+    std::vector<FileInfo> candidates;
+    for (auto& file : files)
+    {
+        if (file.size > 0 && sizeCounts[file.size] > 1)
+            candidates.push_back(std::move(file));
+    }
+    files.clear();
+
+    HashFiles(task, candidates);
+    if (task.cancelled)
+        return;
+
+    std::map<std::pair<uint64_t, uint64_t>, std::vector<std::wstring>> groups;
+    for (const auto& file : candidates)
+    {
+        if (file.hashed)
+            groups[{ file.size, file.hash }].push_back(file.path);
+    }
+
+    std::vector<DuplicateGroup> duplicates;
+    for (auto& pair : groups)
+    {
+        if (pair.second.size() < 2)
+            continue;
+
+        DuplicateGroup group;
+        group.size = pair.first.first;
+        group.hash = pair.first.second;
+        group.paths = std::move(pair.second);
+        std::sort(group.paths.begin(), group.paths.end());
+        duplicates.push_back(std::move(group));
+    }
+
+    // Most wasted space first
+    std::sort(duplicates.begin(), duplicates.end(), [](const DuplicateGroup& a, const DuplicateGroup& b) {
+        return a.size * (a.paths.size() - 1) > b.size * (b.paths.size() - 1);
+    });
+
+    std::lock_guard<std::mutex> lock(task.mutex);
+    task.info.duplicates = std::move(duplicates);
+}
+
+void FileHashService::RunCreateManifest(TaskState& task)
+{
+    std::wstring folder = task.info.path;
+    while (folder.size() > 3 && (folder.back() == L'\\' || folder.back() == L'/'))
+        folder.pop_back();
+
+    std::wstring folderName = std::filesystem::path(folder).filename().wstring();
+    if (folderName.empty())
+        folderName = L"root";
+    std::wstring manifestPath = JoinPath(folder, folderName + kManifestExtension);
+
+    std::vector<FileInfo> files;
+    if (!ScanFolder(task, folder, files))
+        return;
+
+    // The manifest never lists itself
+    files.erase(std::remove_if(files.begin(), files.end(), [&manifestPath](const FileInfo& file) {
+        return _wcsicmp(file.path.c_str(), manifestPath.c_str()) == 0;
+    }), files.end());
+    std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.path < b.path; });
+
+    HashFiles(task, files);
+    if (task.cancelled)
+        return;
+
+    // xxhsum format: "<16 hex digits>  <path relative to the manifest>"
+    std::ofstream out(std::filesystem::path(manifestPath), std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        task.info.errorMessage = "Failed to write " + WideToUtf8(manifestPath);
+        return;
+    }
+
+    std::vector<ManifestMismatch> unreadable;
+    size_t prefix = folder.size() + ((folder.back() == L'\\' || folder.back() == L'/') ? 0 : 1);
+    for (const auto& file : files)
+    {
+        if (!file.hashed)
+        {
+            unreadable.push_back({ file.path, ManifestMismatch::Reason::Unreadable });
+            continue;
+        }
+        out << FormatHash(file.hash) << "  " << WideToUtf8(file.path.substr(prefix)) << "\n";
+    }
+    out.close();
+
+    std::lock_guard<std::mutex> lock(task.mutex);
+    task.info.manifestPath = manifestPath;
+    task.info.verifiedCount = static_cast<uint32_t>(files.size() - unreadable.size());
+    task.info.mismatches = std::move(unreadable);
+    if (!task.info.mismatches.empty())
+        task.info.errorMessage = std::to_string(task.info.mismatches.size()) + " file(s) could not be read and were left out";
+}
+
+void FileHashService::RunVerifyManifest(TaskState& task)
+{
+    const std::wstring& manifestPath = task.info.path;
+    std::wstring baseFolder = std::filesystem::path(manifestPath).parent_path().wstring();
+
+    std::ifstream in(std::filesystem::path(manifestPath), std::ios::binary);
+    if (!in.is_open())
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        task.info.errorMessage = "Failed to open " + WideToUtf8(manifestPath);
+        return;
+    }
+
+    std::vector<FileInfo> files;
+    std::vector<uint64_t> expected;
+    std::vector<ManifestMismatch> mismatches;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.size() < 18 || line[0] == '#')
+            continue;
+
+        // "<hash>  <path>" or "<hash> *<path>" (binary marker)
+        char* end = nullptr;
+        uint64_t hash = strtoull(line.substr(0, 16).c_str(), &end, 16);
+        size_t pos = 16;
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '*'))
+            pos++;
+        if (pos >= line.size())
+            continue;
+
+        std::wstring relative = Utf8ToWide(line.substr(pos));
+        std::replace(relative.begin(), relative.end(), L'/', L'\\');
+        std::wstring path = std::filesystem::path(relative).is_absolute() ? relative : JoinPath(baseFolder, relative);
+
+        WIN32_FILE_ATTRIBUTE_DATA info;
+        if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &info) ||
+            (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        {
+            mismatches.push_back({ path, ManifestMismatch::Reason::Missing });
+            continue;
+        }
+
+        FileInfo file;
+        file.path = path;
+        file.size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        file.lastWriteTime = FileTimeTicks(info.ftLastWriteTime);
+        files.push_back(std::move(file));
+        expected.push_back(hash);
+    }
+
+    HashFiles(task, files);
+    if (task.cancelled)
+        return;
+
+    uint32_t verified = 0;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        if (!files[i].hashed)
+            mismatches.push_back({ files[i].path, ManifestMismatch::Reason::Unreadable });
+        else if (files[i].hash != expected[i])
+            mismatches.push_back({ files[i].path, ManifestMismatch::Reason::Changed });
+        else
+            verified++;
+    }
+
+    std::lock_guard<std::mutex> lock(task.mutex);
+    task.info.manifestPath = manifestPath;
+    task.info.verifiedCount = verified;
+    task.info.mismatches = std::move(mismatches);
+}
+
+} // namespace UFB
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <optional>
+#include <condition_variable>
+#include <cstdint>
+
+namespace UFB {
+
+class SubscriptionManager;
+
+// Files with identical content (same size and hash)
+struct DuplicateGroup
+{
+    uint64_t size = 0;
+    uint64_t hash = 0;
+    std::vector<std::wstring> paths;
+};
+
+// Manifest entry that failed verification
+struct ManifestMismatch
+{
+    enum class Reason
+    {
+        Missing,
+        Changed,
+        Unreadable
+    };
+
+    std::wstring path;
+    Reason reason = Reason::Changed;
+};
+
+// State and results of one background hashing task, copied out for the UI
+struct HashTask
+{
+    enum class Kind
+    {
+        FindDuplicates,     // Folder: groups of identical files
+        CreateManifest,     // Folder: writes "<folder>\<name>.xxh64"
+        VerifyManifest      // Manifest file: re-hashes and compares every listed file
+    };
+
+    enum class State
+    {
+        Queued,
+        Scanning,
+        Hashing,
+        Completed,
+        Failed,
+        Cancelled
+    };
+
+    uint64_t id = 0;
+    Kind kind = Kind::FindDuplicates;
+    std::wstring path;                  // Folder or manifest the task runs on
+    State state = State::Queued;
+
+    uint32_t filesTotal = 0;            // Files that need a hash
+    uint32_t filesHashed = 0;           // Hashed so far (read from disk or cache)
+    uint32_t filesCached = 0;           // Unchanged since last hashed - taken from the database
+    uint64_t bytesTotal = 0;
+    uint64_t bytesRead = 0;             // Bytes actually read from disk
+    double readSeconds = 0.0;           // Time spent reading (throughput = bytesRead / readSeconds)
+    std::string errorMessage;
+
+    // Results (filled when the task completes)
+    std::vector<DuplicateGroup> duplicates;
+    std::vector<ManifestMismatch> mismatches;
+    uint32_t verifiedCount = 0;         // Manifest entries that matched
+    std::wstring manifestPath;          // Manifest written or verified
+};
+
+// Content hashes (64-bit xxHash) of files, cached in ufb.db by path, size and modification time so only
+// new or changed files are read again
+//
+// - Files are read through memory-mapped views on a pool of threads
+// - Background tasks (find duplicates, create and verify manifests) run one at a time and are polled by the UI
+// - Blocking lookups are available to other managers (copy engine, backups)
+class FileHashService
+{
+public:
+    FileHashService();
+    ~FileHashService();
+
+    // Initialize with the shared database (file_hashes table lives in ufb.db)
+    bool Initialize(SubscriptionManager* subscriptionManager, int threadCount = 4);
+
+    // Stop tasks and worker threads
+    void Shutdown();
+
+    // Hash of a file: cached value when unchanged, otherwise reads the file now (blocking)
+    std::optional<uint64_t> GetHash(const std::wstring& path);
+
+    // Cached hash of a file in the given state (size, FILETIME ticks of last write) without reading it
+    std::optional<uint64_t> GetCachedHash(const std::wstring& path, uint64_t size, uint64_t lastWriteTime);
+
+    // Record a hash computed elsewhere (e.g. while copying)
+    void StoreHash(const std::wstring& path, uint64_t size, uint64_t lastWriteTime, uint64_t hash);
+
+    // Background tasks (return the task id)
+    uint64_t FindDuplicates(const std::wstring& folder);
+    uint64_t CreateManifest(const std::wstring& folder);
+    uint64_t VerifyManifest(const std::wstring& manifestPath);
+
+    // Task control and polling
+    void CancelTask(uint64_t taskId);
+    bool GetTask(uint64_t taskId, HashTask& outTask, bool includeResults = true);
+    void ForgetTask(uint64_t taskId);
+
+    // Hash as 16 hex digits (xxhsum format)
+    static std::string FormatHash(uint64_t hash);
+
+    // Extension of manifest files
+    static constexpr const wchar_t* kManifestExtension = L".xxh64";
+
+private:
+    struct FileInfo
+    {
+        std::wstring path;
+        uint64_t size = 0;
+        uint64_t lastWriteTime = 0;
+        uint64_t hash = 0;
+        bool hashed = false;
+    };
+
+    struct TaskState;
+
+    uint64_t QueueTask(HashTask::Kind kind, const std::wstring& path);
+    void TaskThread();
+    void RunTask(TaskState& task);
+    void RunFindDuplicates(TaskState& task);
+    void RunCreateManifest(TaskState& task);
+    void RunVerifyManifest(TaskState& task);
+
+    // Collect all files below a folder (returns false if cancelled)
+    bool ScanFolder(TaskState& task, const std::wstring& folder, std::vector<FileInfo>& outFiles);
+
+    // Fill in hashes: cached ones from the database, the rest read on the thread pool
+    void HashFiles(TaskState& task, std::vector<FileInfo>& files);
+
+    // Read and hash one file through mapped views
+    bool HashFile(const std::wstring& path, uint64_t& outHash, std::atomic<uint64_t>* bytesRead, const std::atomic<bool>* cancelled);
+
+    void LookupCachedHashes(std::vector<FileInfo>& files);
+    void StoreHashes(const std::vector<const FileInfo*>& files);
+
+    bool CreateTables();
+
+    SubscriptionManager* m_subscriptionManager = nullptr;
+    int m_threadCount = 4;
+
+    std::thread m_taskThread;
+    std::atomic<bool> m_running{false};
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCV;
+    std::deque<std::shared_ptr<TaskState>> m_queue;
+
+    std::mutex m_tasksMutex;
+    std::map<uint64_t, std::shared_ptr<TaskState>> m_tasks;
+    uint64_t m_nextTaskId = 1;
+};
+
+} // namespace UFB
@@ -0,0 +1,773 @@
+#include "file_index.h"
+#include "file_watcher.h"
+#include "utils.h"
+#include <windows.h>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cwctype>
+
+namespace UFB {
+
+namespace {
+
+// Saved index layout: header, then per root its path, raw entries and packed names
+constexpr uint32_t kIndexMagic = 0x49424655;    // "UFBI"
+constexpr uint32_t kIndexVersion = 1;
+
+// Unsaved incremental changes are written at most this often (full scans save right away)
+constexpr auto kSaveInterval = std::chrono::minutes(5);
+
+// Walking a folder that is not indexed stops after this many entries
+constexpr size_t kMaxUnindexedEntries = 500000;
+
+uint64_t FileTimeTicks(const FILETIME& time)
+{
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+// Root path without trailing separators ("C:\" stays as is)
+std::wstring TrimPath(std::wstring path)
+{
+    std::replace(path.begin(), path.end(), L'/', L'\\');
+    while (path.size() > 3 && path.back() == L'\\')
+        path.pop_back();
+    return path;
+}
+
+// Case-insensitive key for root lookups
+std::wstring PathKey(const std::wstring& path)
+{
+    std::wstring key = TrimPath(path);
+    for (auto& c : key)
+        c = static_cast<wchar_t>(std::towlower(c));
+    return key;
+}
+
+// Relative part of path below root, false if path is not inside root (both are keys)
+bool RelativeTo(const std::wstring& pathKey, const std::wstring& rootKey, std::wstring& outRelative)
+{
+    if (pathKey.size() < rootKey.size() || pathKey.compare(0, rootKey.size(), rootKey) != 0)
+        return false;
+    if (pathKey.size() == rootKey.size())
+    {
+        outRelative.clear();
+        return true;
+    }
+
+    size_t start = rootKey.size();
+    if (rootKey.back() != L'\\')
+    {
+        if (pathKey[start] != L'\\')
+            return false;
+        start++;
+    }
+    outRelative = pathKey.substr(start);
+    return true;
+}
+
+} // namespace
+
+// FileIndex implementation
+FileIndex::FileIndex()
+{
+}
+
+FileIndex::~FileIndex()
+{
+    Shutdown();
+}
+
+bool FileIndex::Initialize()
+{
+    m_watcher = std::make_unique<FileWatcher>();
+
+    if (Load())
+        std::cout << "[FileIndex] Loaded " << GetEntryCount() << " entries in " << m_roots.size() << " root(s)" << std::endl;
+
+    m_lastSave = std::chrono::steady_clock::now();
+    m_running = true;
+    m_workerThread = std::thread(&FileIndex::WorkerThread, this);
+    return true;
+}
+
+void FileIndex::Shutdown()
+{
+    if (!m_running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_running = false;
+    }
+    m_workCV.notify_all();
+
+    if (m_workerThread.joinable())
+    {
+        try
+        {
+            m_workerThread.join();
+        }
+        catch (const std::system_error& e)
+        {
+            std::cerr << "[FileIndex] Thread join error: " << e.what() << std::endl;
+            try { m_workerThread.detach(); } catch (...) {}
+        }
+    }
+
+    if (m_watcher)
+        m_watcher->StopWatching();
+
+    if (m_dirty)
+        Save();
+}
+
+void FileIndex::SetRoots(const std::vector<std::wstring>& roots)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_wantedRoots = roots;
+        m_rootsChanged = true;
+    }
+    m_workCV.notify_one();
+}
+
+bool FileIndex::IsIndexed(const std::wstring& folder) const
+{
+    std::wstring key = PathKey(folder);
+    std::wstring relative;
+
+    std::shared_lock<std::shared_mutex> lock(m_rootsMutex);
+    for (const auto& pair : m_roots)
+    {
+        if (RelativeTo(key, pair.first, relative))
+            return true;
+    }
+    return false;
+}
+
+size_t FileIndex::GetEntryCount() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_rootsMutex);
+    size_t count = 0;
+    for (const auto& pair : m_roots)
+        count += pair.second->entries.size() - pair.second->deletedCount;
+    return count;
+}
+
+void FileIndex::OnTreeChanged(const std::wstring& rootKey, const std::vector<std::wstring>& changedPaths)
+{
+    std::lock_guard<std::mutex> lock(m_workMutex);
+    if (changedPaths.empty())
+        m_overflowedRoots.insert(rootKey);
+    else
+        m_pendingChanges[rootKey].insert(changedPaths.begin(), changedPaths.end());
+}
+
+void FileIndex::WorkerThread()
+{
+    while (m_running)
+    {
+        // Take the work queued so far; file changes are batched for a second so bursts patch once
+        std::vector<std::wstring> wantedRoots;
+        bool rootsChanged = false;
+        std::map<std::wstring, std::set<std::wstring>> pendingChanges;
+        std::set<std::wstring> overflowedRoots;
+        {
+            std::unique_lock<std::mutex> lock(m_workMutex);
+            m_workCV.wait_for(lock, std::chrono::seconds(1), [this] { return !m_running || m_rootsChanged; });
+            if (!m_running)
+                break;
+
+            rootsChanged = m_rootsChanged;
+            m_rootsChanged = false;
+            wantedRoots.swap(m_wantedRoots);
+            pendingChanges.swap(m_pendingChanges);
+            overflowedRoots.swap(m_overflowedRoots);
+        }
+
+        // Roots to scan: new ones from scratch, loaded and overflowed ones against their current tables
+        std::vector<std::wstring> scanKeys;
+        std::map<std::wstring, std::wstring> rootPaths;
+
+        if (rootsChanged)
+        {
+            std::map<std::wstring, std::wstring> wanted;
+            for (const auto& root : wantedRoots)
+            {
+                if (!root.empty())
+                    wanted[PathKey(root)] = TrimPath(root);
+            }
+
+            // Drop unsubscribed roots
+            {
+                std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+                for (auto it = m_roots.begin(); it != m_roots.end();)
+                {
+                    if (wanted.find(it->first) == wanted.end())
+                    {
+                        m_verifiedRoots.erase(it->first);
+                        it = m_roots.erase(it);
+                        m_dirty = true;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+            for (auto it = m_watchedRoots.begin(); it != m_watchedRoots.end();)
+            {
+                if (wanted.find(it->first) == wanted.end())
+                {
+                    m_watcher->StopWatchingTree(it->second);
+                    it = m_watchedRoots.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            // Loaded roots are rescanned once; new roots are scanned from scratch
+            for (const auto& pair : wanted)
+            {
+                if (m_verifiedRoots.count(pair.first) == 0)
+                {
+                    scanKeys.push_back(pair.first);
+                    rootPaths[pair.first] = pair.second;
+                }
+            }
+        }
+
+        for (const auto& key : overflowedRoots)
+        {
+            if (std::find(scanKeys.begin(), scanKeys.end(), key) == scanKeys.end())
+            {
+                scanKeys.push_back(key);
+                rootPaths[key] = L"";
+            }
+        }
+
+        bool scanned = false;
+        for (const auto& key : scanKeys)
+        {
+            if (!m_running)
+                break;
+
+            // Only the worker writes m_roots, so it reads without the lock
+            std::shared_ptr<RootIndex> previous;
+            auto existing = m_roots.find(key);
+            if (existing != m_roots.end())
+                previous = existing->second;
+
+            std::wstring path = rootPaths[key];
+            if (path.empty())
+            {
+                if (!previous)
+                    continue;   // Overflow of a root that was removed meanwhile
+                path = previous->path;
+            }
+
+            // Watch first so nothing that changes during the scan is missed
+            if (m_watchedRoots.find(key) == m_watchedRoots.end())
+            {
+                if (m_watcher->WatchTree(path, [this, key](const std::vector<std::wstring>& changedPaths) {
+                        OnTreeChanged(key, changedPaths);
+                    }))
+                {
+                    m_watchedRoots[key] = path;
+                }
+            }
+
+            m_building = true;
+            auto start = std::chrono::steady_clock::now();
+            std::shared_ptr<RootIndex> root = ScanRoot(path, previous.get(), &m_running);
+            m_building = false;
+
+            if (!root)
+            {
+                if (m_running)
+                    std::cerr << "[FileIndex] Failed to scan " << WideToUtf8(path) << std::endl;
+                continue;
+            }
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "[FileIndex] Indexed " << WideToUtf8(path) << ": " << root->entries.size() << " entries in "
+                      << seconds << "s" << (previous ? " (rescan)" : "") << std::endl;
+
+            {
+                std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+                m_roots[key] = root;
+            }
+            m_verifiedRoots.insert(key);
+            m_dirty = true;
+            scanned = true;
+        }
+
+        // Patch the tables with the batched file changes
+        for (const auto& pair : pendingChanges)
+        {
+            if (!m_running)
+                break;
+
+            auto it = m_roots.find(pair.first);
+            if (it == m_roots.end())
+                continue;
+
+            std::shared_ptr<RootIndex> root = it->second;
+            ApplyChanges(*root, pair.second);
+
+            // Rebuild once a quarter of the table is tombstones
+            if (root->deletedCount > 1000 && root->deletedCount > root->entries.size() / 4)
+            {
+                std::shared_ptr<RootIndex> compacted = Compact(*root);
+                std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+                m_roots[pair.first] = compacted;
+            }
+        }
+
+        if (m_dirty && (scanned || std::chrono::steady_clock::now() - m_lastSave >= kSaveInterval))
+            Save();
+    }
+}
+
+std::shared_ptr<FileIndex::RootIndex> FileIndex::ScanRoot(const std::wstring& rootPath, const RootIndex* previous,
+                                                          const std::atomic<bool>* running, size_t maxEntries)
+{
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExW(rootPath.c_str(), GetFileExInfoStandard, &info) ||
+        !(info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        return nullptr;
+
+    auto root = std::make_shared<RootIndex>();
+    root->path = rootPath;
+    root->AddEntry(kNoEntry, "", kDirectory, 0, FileTimeTicks(info.ftLastWriteTime));
+
+    if (!ScanInto(*root, 0, rootPath, previous, previous ? 0 : kNoEntry, running, maxEntries))
+        return nullptr;
+    return root;
+}
+
+bool FileIndex::ScanInto(RootIndex& root, uint32_t folderIndex, const std::wstring& folderPath, const RootIndex* previous,
+                         uint32_t previousIndex, const std::atomic<bool>* running, size_t maxEntries)
+{
+    struct PendingFolder
+    {
+        uint32_t index;
+        std::wstring path;
+        uint32_t previousIndex;     // Same folder in the previous table (kNoEntry if unknown)
+    };
+
+    std::vector<PendingFolder> stack;
+    stack.push_back({ folderIndex, folderPath, previousIndex });
+
+    while (!stack.empty())
+    {
+        if (running && !*running)
+            return false;
+        if (root.entries.size() >= maxEntries)
+            return true;
+
+        PendingFolder folder = std::move(stack.back());
+        stack.pop_back();
+
+        std::wstring prefix = folder.path;
+        if (prefix.back() != L'\\')
+            prefix += L'\\';
+
+        // Adding or removing entries updates a folder's modification time: unchanged folders keep their
+        // previous listing and only their subfolders are checked
+        if (previous && folder.previousIndex != kNoEntry &&
+            previous->entries[folder.previousIndex].lastWriteTime == root.entries[folder.index].lastWriteTime)
+        {
+            auto it = previous->children.find(folder.previousIndex);
+            if (it == previous->children.end())
+                continue;
+
+            for (uint32_t child : it->second)
+            {
+                const Entry& entry = previous->entries[child];
+                if (entry.flags & kDeleted)
+                    continue;
+
+                std::string name(previous->Name(entry));
+                if (!(entry.flags & kDirectory))
+                {
+                    root.AddEntry(folder.index, name, entry.flags, entry.size, entry.lastWriteTime);
+                    continue;
+                }
+
+                WIN32_FILE_ATTRIBUTE_DATA info;
+                std::wstring childPath = prefix + Utf8ToWide(name);
+                if (!GetFileAttributesExW(childPath.c_str(), GetFileExInfoStandard, &info))
+                    continue;
+
+                uint32_t index = root.AddEntry(folder.index, name, kDirectory, 0, FileTimeTicks(info.ftLastWriteTime));
+                if (!(info.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                    stack.push_back({ index, childPath, child });
+            }
+            continue;
+        }
+
+        WIN32_FIND_DATAW data;
+        HANDLE find = FindFirstFileExW((prefix + L"*").c_str(), FindExInfoBasic, &data,
+                                       FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+        if (find == INVALID_HANDLE_VALUE)
+            continue;
+
+        do
+        {
+            const wchar_t* name = data.cFileName;
+            if (name[0] == L'.' && (name[1] == L'\0' || (name[1] == L'.' && name[2] == L'\0')))
+                continue;
+
+            std::string nameUtf8 = WideToUtf8(name);
+            uint64_t lastWriteTime = FileTimeTicks(data.ftLastWriteTime);
+
+            if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                uint32_t index = root.AddEntry(folder.index, nameUtf8, kDirectory, 0, lastWriteTime);
+
+                // Junctions and symlinked folders are listed but not followed (loops, other volumes)
+                if (!(data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                {
+                    uint32_t previousChild = (previous && folder.previousIndex != kNoEntry)
+                        ? previous->FindChild(folder.previousIndex, nameUtf8) : kNoEntry;
+                    stack.push_back({ index, prefix + name, previousChild });
+                }
+            }
+            else
+            {
+                uint64_t size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+                root.AddEntry(folder.index, nameUtf8, 0, size, lastWriteTime);
+            }
+        } while (FindNextFileW(find, &data));
+
+        FindClose(find);
+    }
+
+    return true;
+}
+
+void FileIndex::ApplyChanges(RootIndex& root, const std::set<std::wstring>& changedPaths)
+{
+    // Sorted paths put parents before their children
+    for (const auto& relative : changedPaths)
+    {
+        std::wstring fullPath = root.path;
+        if (fullPath.back() != L'\\')
+            fullPath += L'\\';
+        fullPath += relative;
+
+        WIN32_FILE_ATTRIBUTE_DATA info;
+        bool exists = GetFileAttributesExW(fullPath.c_str(), GetFileExInfoStandard, &info) != FALSE;
+        bool isDirectory = exists && (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+        uint64_t size = exists ? (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow : 0;
+        uint64_t lastWriteTime = exists ? FileTimeTicks(info.ftLastWriteTime) : 0;
+
+        uint32_t current = root.FindPath(relative);
+
+        if (!exists)
+        {
+            if (current != kNoEntry && current != 0)
+            {
+                std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+                root.RemoveEntry(current);
+                m_dirty = true;
+            }
+            continue;
+        }
+
+        if (current != kNoEntry)
+        {
+            Entry& entry = root.entries[current];
+            std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+            if (((entry.flags & kDirectory) != 0) == isDirectory)
+            {
+                entry.size = isDirectory ? 0 : size;
+                entry.lastWriteTime = lastWriteTime;
+                m_dirty = true;
+                continue;
+            }
+            root.RemoveEntry(current);  // File replaced by a folder or the other way round
+        }
+
+        // New entry: find the deepest indexed ancestor; anything missing in between is scanned with it
+        uint32_t parent = 0;
+        size_t start = 0;
+        std::wstring addPath = relative;
+        while (true)
+        {
+            size_t end = relative.find(L'\\', start);
+            if (end == std::wstring::npos)
+                break;
+
+            uint32_t next = root.FindChild(parent, WideToUtf8(relative.substr(start, end - start)));
+            if (next == kNoEntry)
+            {
+                addPath = relative.substr(0, end);
+                break;
+            }
+            parent = next;
+            start = end + 1;
+        }
+
+        std::wstring addFullPath = root.path;
+        if (addFullPath.back() != L'\\')
+            addFullPath += L'\\';
+        addFullPath += addPath;
+        std::string name = WideToUtf8(std::filesystem::path(addPath).filename().wstring());
+
+        if (addPath != relative)
+        {
+            if (!GetFileAttributesExW(addFullPath.c_str(), GetFileExInfoStandard, &info))
+                continue;
+            isDirectory = (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+            lastWriteTime = FileTimeTicks(info.ftLastWriteTime);
+        }
+
+        if (!isDirectory)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+            root.AddEntry(parent, name, 0, size, lastWriteTime);
+            m_dirty = true;
+            continue;
+        }
+
+        // New folder (created, moved in or renamed): scan it outside the lock, then graft it in
+        std::shared_ptr<RootIndex> subtree;
+        if (!(info.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+            subtree = ScanRoot(addFullPath, nullptr, &m_running);
+
+        std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+        uint32_t folder = root.AddEntry(parent, name, kDirectory, 0, lastWriteTime);
+        if (subtree)
+        {
+            std::vector<uint32_t> mapping(subtree->entries.size(), kNoEntry);
+            mapping[0] = folder;
+            for (uint32_t i = 1; i < subtree->entries.size(); ++i)
+            {
+                const Entry& entry = subtree->entries[i];
+                mapping[i] = root.AddEntry(mapping[entry.parent], std::string(subtree->Name(entry)),
+                                           entry.flags, entry.size, entry.lastWriteTime);
+            }
+        }
+        m_dirty = true;
+    }
+}
+
+std::shared_ptr<FileIndex::RootIndex> FileIndex::Compact(const RootIndex& root)
+{
+    auto compacted = std::make_shared<RootIndex>();
+    compacted->path = root.path;
+    compacted->entries.reserve(root.entries.size() - root.deletedCount);
+
+    // Parents always precede their children, so one pass remaps every parent index
+    std::vector<uint32_t> mapping(root.entries.size(), kNoEntry);
+    for (uint32_t i = 0; i < root.entries.size(); ++i)
+    {
+        const Entry& entry = root.entries[i];
+        if (entry.flags & kDeleted)
+            continue;
+
+        uint32_t parent = entry.parent == kNoEntry ? kNoEntry : mapping[entry.parent];
+        if (entry.parent != kNoEntry && parent == kNoEntry)
+            continue;
+
+        mapping[i] = compacted->AddEntry(parent, std::string(root.Name(entry)), entry.flags, entry.size, entry.lastWriteTime);
+    }
+
+    return compacted;
+}
+
+std::vector<FileIndexResult> FileIndex::Search(const std::wstring& scope, const std::wstring& query, size_t maxResults,
+                                               bool* outTruncated) const
+{
+    std::vector<FileIndexResult> results;
+    bool truncated = false;
+
+    FileIndexQuery parsed;
+    if (FileIndexQuery::Parse(query, parsed))
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::wstring scopeKey = PathKey(scope);
+        std::wstring relative;
+
+        std::shared_lock<std::shared_mutex> lock(m_rootsMutex);
+        for (const auto& pair : m_roots)
+        {
+            if (!RelativeTo(scopeKey, pair.first, relative))
+                continue;
+
+            uint32_t scopeIndex = pair.second->FindPath(relative);
+            if (scopeIndex != kNoEntry)
+                pair.second->Search(scopeIndex, parsed, maxResults, results, truncated);
+            break;
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[FileIndex] Search \"" << WideToUtf8(query) << "\": " << results.size()
+                  << (truncated ? "+" : "") << " results in " << ms << "ms" << std::endl;
+    }
+
+    if (outTruncated)
+        *outTruncated = truncated;
+    return results;
+}
+
+std::vector<FileIndexResult> FileIndex::SearchUnindexed(const std::wstring& folder, const std::wstring& query,
+                                                        size_t maxResults, bool* outTruncated)
+{
+    std::vector<FileIndexResult> results;
+    bool truncated = false;
+
+    // Same matching as the index, over a table built for this search only
+    FileIndexQuery parsed;
+    if (FileIndexQuery::Parse(query, parsed))
+    {
+        std::shared_ptr<RootIndex> root = ScanRoot(TrimPath(folder), nullptr, nullptr, kMaxUnindexedEntries);
+        if (root)
+        {
+            root->Search(0, parsed, maxResults, results, truncated);
+            if (root->entries.size() >= kMaxUnindexedEntries)
+                truncated = true;
+        }
+    }
+
+    if (outTruncated)
+        *outTruncated = truncated;
+    return results;
+}
+
+bool FileIndex::Load()
+{
+    std::filesystem::path indexPath = GetLocalAppDataPath() / L"file_index.bin";
+    std::ifstream in(indexPath, std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    uint32_t header[4] = {};
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || header[0] != kIndexMagic || header[1] != kIndexVersion || header[2] != sizeof(Entry))
+    {
+        std::cout << "[FileIndex] Ignoring saved index (different format)" << std::endl;
+        return false;
+    }
+
+    std::map<std::wstring, std::shared_ptr<RootIndex>> roots;
+    for (uint32_t r = 0; r < header[3]; ++r)
+    {
+        auto root = std::make_shared<RootIndex>();
+
+        uint32_t pathLength = 0;
+        in.read(reinterpret_cast<char*>(&pathLength), sizeof(pathLength));
+        if (!in || pathLength == 0 || pathLength > 32767)
+            return false;
+        root->path.resize(pathLength);
+        in.read(reinterpret_cast<char*>(root->path.data()), pathLength * sizeof(wchar_t));
+
+        uint64_t entryCount = 0, namesSize = 0;
+        in.read(reinterpret_cast<char*>(&entryCount), sizeof(entryCount));
+        if (!in || entryCount == 0 || entryCount >= kNoEntry)
+            return false;
+        root->entries.resize(static_cast<size_t>(entryCount));
+        in.read(reinterpret_cast<char*>(root->entries.data()), entryCount * sizeof(Entry));
+
+        in.read(reinterpret_cast<char*>(&namesSize), sizeof(namesSize));
+        if (!in)
+            return false;
+        root->names.resize(static_cast<size_t>(namesSize));
+        in.read(root->names.data(), namesSize);
+        if (!in)
+            return false;
+
+        // Reject anything that would index out of range, then rebuild the lookup maps
+        for (uint32_t i = 0; i < root->entries.size(); ++i)
+        {
+            const Entry& entry = root->entries[i];
+            bool parentValid = (i == 0) ? entry.parent == kNoEntry : entry.parent < i;
+            if (!parentValid || static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > namesSize ||
+                (entry.flags & kDeleted))
+                return false;
+            root->IndexEntry(i);
+        }
+
+        roots[PathKey(root->path)] = root;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_rootsMutex);
+    m_roots = std::move(roots);
+    return true;
+}
+
+bool FileIndex::Save()
+{
+    std::filesystem::path indexPath = GetLocalAppDataPath() / L"file_index.bin";
+    std::filesystem::path tempPath = indexPath;
+    tempPath += L".tmp";
+
+    auto start = std::chrono::steady_clock::now();
+    size_t entryCount = 0;
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            std::cerr << "[FileIndex] Failed to write " << tempPath.string() << std::endl;
+            return false;
+        }
+
+        std::shared_lock<std::shared_mutex> lock(m_rootsMutex);
+
+        uint32_t header[4] = { kIndexMagic, kIndexVersion, static_cast<uint32_t>(sizeof(Entry)),
+                               static_cast<uint32_t>(m_roots.size()) };
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+        for (const auto& pair : m_roots)
+        {
+            // Tombstones are not saved
+            std::shared_ptr<RootIndex> compacted;
+            const RootIndex* root = pair.second.get();
+            if (root->deletedCount > 0)
+            {
+                compacted = Compact(*root);
+                root = compacted.get();
+            }
+
+            uint32_t pathLength = static_cast<uint32_t>(root->path.size());
+            uint64_t count = root->entries.size();
+            uint64_t namesSize = root->names.size();
+            out.write(reinterpret_cast<const char*>(&pathLength), sizeof(pathLength));
+            out.write(reinterpret_cast<const char*>(root->path.data()), pathLength * sizeof(wchar_t));
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            out.write(reinterpret_cast<const char*>(root->entries.data()), count * sizeof(Entry));
+            out.write(reinterpret_cast<const char*>(&namesSize), sizeof(namesSize));
+            out.write(root->names.data(), namesSize);
+            entryCount += count;
+        }
+
+        if (!out)
+        {
+            std::cerr << "[FileIndex] Failed to write " << tempPath.string() << std::endl;
+            return false;
+        }
+    }
+
+    if (!MoveFileExW(tempPath.c_str(), indexPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        std::cerr << "[FileIndex] Failed to replace " << indexPath.string() << std::endl;
+        return false;
+    }
+
+    m_dirty = false;
+    m_lastSave = std::chrono::steady_clock::now();
+
+    double ms = std::chrono::duration<double, std::milli>(m_lastSave - start).count();
+    std::cout << "[FileIndex] Saved " << entryCount << " entries in " << ms << "ms" << std::endl;
+    return true;
+}
+
+} // namespace UFB
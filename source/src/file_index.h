@@ -0,0 +1,111 @@
+#pragma once
+
+#include "file_index_table.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+namespace UFB {
+
+class FileWatcher;
+
+// Filename index of the subscribed job folders, used by the browser search
+//
+// - Every root is a FileIndexTable: a flat table of entries (parent index, name, size, time) with names
+//   packed in one UTF-8 buffer and a trigram -> block map, so a query only checks the blocks that hold
+//   all of its trigrams
+// - Roots are scanned on a background thread and kept current by watching their folder trees;
+//   changes patch the tables in place (removed entries are tombstoned and compacted later)
+// - The tables are saved to %LOCALAPPDATA%\ufb\file_index.bin and searchable immediately on the next
+//   start; the rescan that follows re-lists only folders whose modification time changed
+//
+// Query syntax (terms separated by spaces, all must match, ASCII case-insensitive):
+//   comp          name contains "comp"
+//   comp\v003     full path contains "comp\v003" (terms with a backslash)
+//   sh*_v00?.exr  glob over the name (* and ?)
+//   ext:exr;dpx   extension is one of the listed ones
+class FileIndex
+{
+public:
+    FileIndex();
+    ~FileIndex();
+
+    // Load the saved index and start the worker thread
+    bool Initialize();
+
+    // Save the index and stop watching
+    void Shutdown();
+
+    // Folders to index (subscribed jobs); roots no longer listed are dropped, new ones are scanned
+    void SetRoots(const std::vector<std::wstring>& roots);
+
+    // True if the folder is inside an indexed root (search can use the index)
+    bool IsIndexed(const std::wstring& folder) const;
+
+    // Search entries below scope (inclusive of nested folders), at most maxResults
+    std::vector<FileIndexResult> Search(const std::wstring& scope, const std::wstring& query, size_t maxResults,
+                                        bool* outTruncated = nullptr) const;
+
+    // Search a folder that is not indexed by walking it directly (slower, same query syntax)
+    static std::vector<FileIndexResult> SearchUnindexed(const std::wstring& folder, const std::wstring& query,
+                                                        size_t maxResults, bool* outTruncated = nullptr);
+
+    // Status
+    size_t GetEntryCount() const;
+    bool IsBuilding() const { return m_building; }
+
+private:
+    using RootIndex = FileIndexTable;
+    using Entry = FileIndexTable::Entry;
+    static constexpr uint32_t kNoEntry = FileIndexTable::kNoEntry;
+    static constexpr uint16_t kDirectory = FileIndexTable::kDirectory;
+    static constexpr uint16_t kDeleted = FileIndexTable::kDeleted;
+
+    // Worker
+    void WorkerThread();
+    void ApplyChanges(RootIndex& root, const std::set<std::wstring>& changedPaths);
+    void OnTreeChanged(const std::wstring& rootKey, const std::vector<std::wstring>& changedPaths);
+    static std::shared_ptr<RootIndex> Compact(const RootIndex& root);
+
+    // Scanning (previous: table of the same root to reuse unchanged folders from; running: stop flag)
+    static std::shared_ptr<RootIndex> ScanRoot(const std::wstring& rootPath, const RootIndex* previous,
+                                               const std::atomic<bool>* running, size_t maxEntries = kNoEntry - 1);
+    static bool ScanInto(RootIndex& root, uint32_t folderIndex, const std::wstring& folderPath, const RootIndex* previous,
+                         uint32_t previousIndex, const std::atomic<bool>* running, size_t maxEntries);
+
+    // Persistence
+    bool Load();
+    bool Save();
+
+    mutable std::shared_mutex m_rootsMutex;     // Guards m_roots (searches share, the worker writes)
+    std::map<std::wstring, std::shared_ptr<RootIndex>> m_roots;   // Lowercase root path -> index
+
+    std::unique_ptr<FileWatcher> m_watcher;
+    std::thread m_workerThread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_building{false};
+    std::atomic<bool> m_dirty{false};           // Changed since last save
+    std::chrono::steady_clock::time_point m_lastSave;
+
+    // Worker thread only
+    std::map<std::wstring, std::wstring> m_watchedRoots;    // Root key -> watched path
+    std::set<std::wstring> m_verifiedRoots;     // Roots scanned this session (loaded ones are rescanned once)
+
+    std::mutex m_workMutex;                     // Guards the work below
+    std::condition_variable m_workCV;
+    std::vector<std::wstring> m_wantedRoots;    // Latest SetRoots
+    bool m_rootsChanged = false;
+    std::map<std::wstring, std::set<std::wstring>> m_pendingChanges;    // Root key -> changed relative paths
+    std::set<std::wstring> m_overflowedRoots;   // Roots that lost events (rescan)
+};
+
+} // namespace UFB
@@ -0,0 +1,454 @@
+#include "file_index_table.h"
+#include "utils.h"
+#include <algorithm>
+#include <iterator>
+
+namespace UFB {
+
+namespace {
+
+inline char FoldAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+inline uint32_t Trigram(std::string_view text, size_t i)
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(FoldAscii(text[i]))) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(FoldAscii(text[i + 1]))) << 8) |
+            static_cast<uint32_t>(static_cast<uint8_t>(FoldAscii(text[i + 2])));
+}
+
+void AddTrigrams(std::string_view text, std::vector<uint32_t>& out)
+{
+    for (size_t i = 0; i + 2 < text.size(); ++i)
+        out.push_back(Trigram(text, i));
+}
+
+bool EqualsFolded(std::string_view a, std::string_view b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (FoldAscii(a[i]) != FoldAscii(b[i]))
+            return false;
+    }
+    return true;
+}
+
+// needle is already lowercase
+bool ContainsFolded(std::string_view haystack, std::string_view needle)
+{
+    if (needle.empty())
+        return true;
+    if (needle.size() > haystack.size())
+        return false;
+
+    for (size_t i = 0; i + needle.size() <= haystack.size(); ++i)
+    {
+        size_t j = 0;
+        while (j < needle.size() && FoldAscii(haystack[i + j]) == needle[j])
+            j++;
+        if (j == needle.size())
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+bool GlobMatch(std::string_view name, std::string_view pattern)
+{
+    size_t n = 0, p = 0;
+    size_t starP = std::string_view::npos, starN = 0;
+
+    auto nextChar = [&name](size_t i) {
+        i++;
+        while (i < name.size() && (static_cast<uint8_t>(name[i]) & 0xC0) == 0x80)
+            i++;
+        return i;
+    };
+
+    while (n < name.size())
+    {
+        if (p < pattern.size() && pattern[p] == '*')
+        {
+            starP = p++;
+            starN = n;
+        }
+        else if (p < pattern.size() && pattern[p] == '?')
+        {
+            p++;
+            n = nextChar(n);
+        }
+        else if (p < pattern.size() && pattern[p] == FoldAscii(name[n]))
+        {
+            p++;
+            n++;
+        }
+        else if (starP != std::string_view::npos)
+        {
+            p = starP + 1;
+            starN = nextChar(starN);
+            n = starN;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*')
+        p++;
+    return p == pattern.size();
+}
+
+std::wstring FileIndexTable::FullPath(uint32_t index) const
+{
+    std::vector<uint32_t> chain;
+    for (uint32_t i = index; i != 0 && i != kNoEntry; i = entries[i].parent)
+        chain.push_back(i);
+
+    std::string relative;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        relative += '\\';
+        relative += Name(entries[*it]);
+    }
+
+    if (!path.empty() && path.back() == L'\\' && !relative.empty())
+        return path + Utf8ToWide(relative.substr(1));
+    return path + Utf8ToWide(relative);
+}
+
+uint32_t FileIndexTable::AddEntry(uint32_t parent, const std::string& name, uint16_t flags, uint64_t size,
+                                  uint64_t lastWriteTime)
+{
+    Entry entry;
+    entry.parent = parent;
+    entry.nameOffset = static_cast<uint32_t>(names.size());
+    entry.nameLength = static_cast<uint16_t>((std::min)(name.size(), static_cast<size_t>(0xFFFF)));
+    entry.flags = flags;
+    entry.size = size;
+    entry.lastWriteTime = lastWriteTime;
+
+    names.append(name, 0, entry.nameLength);
+    entries.push_back(entry);
+
+    uint32_t index = static_cast<uint32_t>(entries.size() - 1);
+    IndexEntry(index);
+    return index;
+}
+
+void FileIndexTable::IndexEntry(uint32_t index)
+{
+    const Entry& entry = entries[index];
+    if (entry.parent != kNoEntry)
+        children[entry.parent].push_back(index);
+
+    // Block ids only grow, so appending keeps every list sorted
+    uint32_t block = index / kBlockSize;
+    std::string_view name = Name(entry);
+    for (size_t i = 0; i + 2 < name.size(); ++i)
+    {
+        auto& blocks = trigramBlocks[Trigram(name, i)];
+        if (blocks.empty() || blocks.back() != block)
+            blocks.push_back(block);
+    }
+}
+
+uint32_t FileIndexTable::FindChild(uint32_t parent, std::string_view name) const
+{
+    auto it = children.find(parent);
+    if (it == children.end())
+        return kNoEntry;
+
+    for (uint32_t child : it->second)
+    {
+        if (!(entries[child].flags & kDeleted) && EqualsFolded(Name(entries[child]), name))
+            return child;
+    }
+    return kNoEntry;
+}
+
+uint32_t FileIndexTable::FindPath(const std::wstring& relativePath) const
+{
+    uint32_t current = 0;
+    size_t start = 0;
+    while (start < relativePath.size() && current != kNoEntry)
+    {
+        size_t end = relativePath.find_first_of(L"\\/", start);
+        if (end == std::wstring::npos)
+            end = relativePath.size();
+        if (end > start)
+            current = FindChild(current, WideToUtf8(relativePath.substr(start, end - start)));
+        start = end + 1;
+    }
+    return current;
+}
+
+void FileIndexTable::RemoveEntry(uint32_t index)
+{
+    // Detach from the parent, then tombstone the entry and everything below it
+    uint32_t parent = entries[index].parent;
+    auto siblings = children.find(parent);
+    if (siblings != children.end())
+        siblings->second.erase(std::remove(siblings->second.begin(), siblings->second.end(), index), siblings->second.end());
+
+    std::vector<uint32_t> stack = { index };
+    while (!stack.empty())
+    {
+        uint32_t current = stack.back();
+        stack.pop_back();
+
+        Entry& entry = entries[current];
+        if (entry.flags & kDeleted)
+            continue;
+        entry.flags |= kDeleted;
+        deletedCount++;
+
+        auto it = children.find(current);
+        if (it != children.end())
+        {
+            stack.insert(stack.end(), it->second.begin(), it->second.end());
+            children.erase(it);
+        }
+    }
+}
+
+bool FileIndexQuery::Parse(const std::wstring& text, FileIndexQuery& outQuery)
+{
+    std::string query = WideToUtf8(text);
+    for (auto& c : query)
+        c = FoldAscii(c);
+
+    // Terms are separated by spaces; double quotes keep spaces inside a term
+    std::vector<std::string> terms;
+    std::string term;
+    bool quoted = false;
+    for (char c : query)
+    {
+        if (c == '"')
+            quoted = !quoted;
+        else if (c == ' ' && !quoted)
+        {
+            if (!term.empty())
+                terms.push_back(std::move(term));
+            term.clear();
+        }
+        else
+            term += c;
+    }
+    if (!term.empty())
+        terms.push_back(std::move(term));
+
+    for (auto& t : terms)
+    {
+        std::replace(t.begin(), t.end(), '/', '\\');
+
+        if (t.compare(0, 4, "ext:") == 0)
+        {
+            size_t start = 4;
+            while (start <= t.size())
+            {
+                size_t end = t.find_first_of(";,", start);
+                if (end == std::string::npos)
+                    end = t.size();
+                std::string extension = t.substr(start, end - start);
+                if (!extension.empty() && extension[0] == '.')
+                    extension.erase(0, 1);
+                if (!extension.empty())
+                    outQuery.extensions.push_back(extension);
+                start = end + 1;
+            }
+        }
+        else if (t.find_first_of("*?") != std::string::npos)
+        {
+            // Every literal run of the pattern is in the name
+            size_t start = 0;
+            while (start < t.size())
+            {
+                size_t end = t.find_first_of("*?", start);
+                if (end == std::string::npos)
+                    end = t.size();
+                AddTrigrams(std::string_view(t).substr(start, end - start), outQuery.trigrams);
+                start = end + 1;
+            }
+            outQuery.globs.push_back(t);
+        }
+        else if (t.find('\\') != std::string::npos)
+        {
+            outQuery.pathTerms.push_back(t);
+        }
+        else
+        {
+            AddTrigrams(t, outQuery.trigrams);
+            outQuery.substrings.push_back(t);
+        }
+    }
+
+    // Only a single extension narrows the candidates (with several, or several ext: terms, a name
+    // needs just one of them)
+    if (outQuery.extensions.size() == 1)
+        AddTrigrams("." + outQuery.extensions[0], outQuery.trigrams);
+
+    std::sort(outQuery.trigrams.begin(), outQuery.trigrams.end());
+    outQuery.trigrams.erase(std::unique(outQuery.trigrams.begin(), outQuery.trigrams.end()), outQuery.trigrams.end());
+
+    return !outQuery.substrings.empty() || !outQuery.pathTerms.empty() || !outQuery.globs.empty() ||
+           !outQuery.extensions.empty();
+}
+
+bool FileIndexTable::Matches(uint32_t index, const FileIndexQuery& query, FolderPathCache* folderPath) const
+{
+    std::string_view name = Name(entries[index]);
+
+    for (const auto& substring : query.substrings)
+    {
+        if (!ContainsFolded(name, substring))
+            return false;
+    }
+
+    for (const auto& glob : query.globs)
+    {
+        if (!GlobMatch(name, glob))
+            return false;
+    }
+
+    if (!query.extensions.empty())
+    {
+        size_t dot = name.rfind('.');
+        if (dot == std::string_view::npos)
+            return false;
+        std::string_view extension = name.substr(dot + 1);
+        bool found = false;
+        for (const auto& candidate : query.extensions)
+        {
+            if (EqualsFolded(extension, candidate))
+            {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return false;
+    }
+
+    if (!query.pathTerms.empty())
+    {
+        FolderPathCache local;
+        FolderPathCache& cache = folderPath ? *folderPath : local;
+        uint32_t parent = entries[index].parent;
+        if (cache.folder != parent)
+        {
+            std::vector<uint32_t> chain;
+            for (uint32_t i = parent; i != 0 && i != kNoEntry; i = entries[i].parent)
+                chain.push_back(i);
+
+            cache.folder = parent;
+            cache.path.clear();
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+            {
+                cache.path += '\\';
+                cache.path += Name(entries[*it]);
+            }
+        }
+
+        std::string relative;
+        relative.reserve(cache.path.size() + 1 + name.size());
+        relative += cache.path;
+        relative += '\\';
+        relative += name;
+
+        for (const auto& term : query.pathTerms)
+        {
+            if (!ContainsFolded(relative, term))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool FileIndexTable::IsUnder(uint32_t index, uint32_t ancestor) const
+{
+    if (ancestor == 0)
+        return true;
+
+    for (uint32_t i = entries[index].parent; i != kNoEntry; i = entries[i].parent)
+    {
+        if (i == ancestor)
+            return true;
+    }
+    return false;
+}
+
+std::vector<uint32_t> FileIndexTable::CandidateBlocks(const FileIndexQuery& query) const
+{
+    uint32_t blockCount = static_cast<uint32_t>((entries.size() + kBlockSize - 1) / kBlockSize);
+
+    std::vector<uint32_t> blocks;
+    if (!query.trigrams.empty())
+    {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (uint32_t trigram : query.trigrams)
+        {
+            auto it = trigramBlocks.find(trigram);
+            if (it == trigramBlocks.end())
+                return {};  // No name contains this trigram
+            lists.push_back(&it->second);
+        }
+
+        std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+        blocks = *lists[0];
+        for (size_t i = 1; i < lists.size() && !blocks.empty(); ++i)
+        {
+            std::vector<uint32_t> intersection;
+            std::set_intersection(blocks.begin(), blocks.end(), lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(intersection));
+            blocks.swap(intersection);
+        }
+    }
+    else
+    {
+        blocks.resize(blockCount);
+        for (uint32_t i = 0; i < blockCount; ++i)
+            blocks[i] = i;
+    }
+
+    return blocks;
+}
+
+void FileIndexTable::Search(uint32_t scope, const FileIndexQuery& query, size_t maxResults,
+                            std::vector<FileIndexResult>& outResults, bool& outTruncated) const
+{
+    FolderPathCache folderPath;
+    for (uint32_t block : CandidateBlocks(query))
+    {
+        uint32_t end = (std::min)(static_cast<uint32_t>(entries.size()), (block + 1) * kBlockSize);
+        for (uint32_t i = block * kBlockSize; i < end; ++i)
+        {
+            const Entry& entry = entries[i];
+            if (i == 0 || i == scope || (entry.flags & kDeleted))
+                continue;
+            if (!Matches(i, query, &folderPath) || !IsUnder(i, scope))
+                continue;
+
+            if (outResults.size() >= maxResults)
+            {
+                outTruncated = true;
+                return;
+            }
+
+            FileIndexResult result;
+            result.path = FullPath(i);
+            result.isDirectory = (entry.flags & kDirectory) != 0;
+            result.size = entry.size;
+            result.lastWriteTime = entry.lastWriteTime;
+            outResults.push_back(std::move(result));
+        }
+    }
+}
+
+} // namespace UFB
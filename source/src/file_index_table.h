@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace UFB {
+
+// One search hit
+struct FileIndexResult
+{
+    std::wstring path;
+    bool isDirectory = false;
+    uint64_t size = 0;
+    uint64_t lastWriteTime = 0;     // FILETIME ticks
+};
+
+// Parsed search query (all text lowercase UTF-8); syntax as described on FileIndex
+struct FileIndexQuery
+{
+    std::vector<std::string> substrings;    // Name contains
+    std::vector<std::string> pathTerms;     // Relative path (with leading '\') contains
+    std::vector<std::string> globs;         // Name matches
+    std::vector<std::string> extensions;    // Extension is one of (without dot)
+    std::vector<uint32_t> trigrams;         // Every matching name contains all of these (sorted, unique)
+
+    // @return false if the text has no terms
+    static bool Parse(const std::wstring& text, FileIndexQuery& outQuery);
+};
+
+// '*' matches any run, '?' one character (UTF-8 aware); pattern is already lowercase
+bool GlobMatch(std::string_view name, std::string_view pattern);
+
+// Flat filename table of one indexed root (no file system access; FileIndex scans and persists it)
+//
+// Entries are grouped into blocks of kBlockSize and each trigram of the lowercase names maps to the
+// blocks containing it, so a search only checks the blocks that hold all of the query's trigrams
+struct FileIndexTable
+{
+    static constexpr uint32_t kNoEntry = 0xFFFFFFFF;
+    static constexpr uint32_t kBlockSize = 64;      // Entries per trigram block
+
+    struct Entry
+    {
+        uint32_t parent = kNoEntry;     // Index of the parent folder (kNoEntry for the root itself)
+        uint32_t nameOffset = 0;        // Into names
+        uint16_t nameLength = 0;        // UTF-8 bytes
+        uint16_t flags = 0;
+        uint64_t size = 0;
+        uint64_t lastWriteTime = 0;     // FILETIME ticks (folders: used to skip unchanged folders on rescan)
+    };
+
+    enum EntryFlags : uint16_t
+    {
+        kDirectory = 1,
+        kDeleted = 2
+    };
+
+    std::wstring path;
+    std::vector<Entry> entries;     // entries[0] is the root folder
+    std::string names;              // Packed UTF-8 names (original case)
+    size_t deletedCount = 0;
+
+    // Derived (rebuilt on load and compaction)
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigramBlocks;     // Trigram -> sorted block ids
+    std::unordered_map<uint32_t, std::vector<uint32_t>> children;          // Folder -> child entries
+
+    std::string_view Name(const Entry& entry) const { return std::string_view(names).substr(entry.nameOffset, entry.nameLength); }
+    std::wstring FullPath(uint32_t index) const;
+    uint32_t AddEntry(uint32_t parent, const std::string& name, uint16_t flags, uint64_t size, uint64_t lastWriteTime);
+    void IndexEntry(uint32_t index);    // Add an entry to the derived maps
+    uint32_t FindChild(uint32_t parent, std::string_view name) const;
+    uint32_t FindPath(const std::wstring& relativePath) const;
+    void RemoveEntry(uint32_t index);
+
+    // Relative path of a folder ("\a\b", empty for the root), kept while consecutive entries share it
+    struct FolderPathCache
+    {
+        uint32_t folder = kNoEntry;
+        std::string path;
+    };
+
+    // Search helpers
+    bool Matches(uint32_t index, const FileIndexQuery& query, FolderPathCache* folderPath = nullptr) const;
+    bool IsUnder(uint32_t index, uint32_t ancestor) const;
+
+    // Blocks that can hold a match: intersection of the block lists of every query trigram
+    // (every block when the query has none, e.g. only 1-2 character terms)
+    std::vector<uint32_t> CandidateBlocks(const FileIndexQuery& query) const;
+
+    // Matching entries below scope (scope itself excluded), at most maxResults
+    void Search(uint32_t scope, const FileIndexQuery& query, size_t maxResults,
+                std::vector<FileIndexResult>& outResults, bool& outTruncated) const;
+};
+
+} // namespace UFB
@@ -25,7 +25,7 @@ bool FileWatcher::WatchFile(const std::wstring& filePath, std::function<void()>
     m_isRunning = true;
 
     // Get or create watched directory for this file
-    WatchedDirectory* watchDir = GetOrCreateWatchedDirectory(filePath);
+    std::shared_ptr<WatchedDirectory> watchDir = GetOrCreateWatchedDirectory(GetDirectory(filePath));
     if (!watchDir)
     {
         std::wcerr << L"[FileWatcher] Failed to create watched directory" << std::endl;
@@ -52,198 +52,341 @@ void FileWatcher::StopWatchingFile(const std::wstring& filePath)
     auto it = m_watchedDirectories.find(dirPath);
     if (it != m_watchedDirectories.end())
     {
-        std::lock_guard<std::mutex> callbackLock(it->second->callbacksMutex);
-        it->second->fileCallbacks.erase(filename);
-
-        // If no more files to watch in this directory, stop watching
-        if (it->second->fileCallbacks.empty())
         {
-            it->second->isRunning = false;
-            if (it->second->hDirectory != INVALID_HANDLE_VALUE)
-            {
-                CloseHandle(it->second->hDirectory);
-            }
-            if (it->second->watchThread.joinable())
-            {
-                it->second->watchThread.join();
-            }
-            m_watchedDirectories.erase(it);
+            std::lock_guard<std::mutex> callbackLock(it->second->callbacksMutex);
+            it->second->fileCallbacks.erase(filename);
         }
+
+        ReleaseWatchedDirectoryIfUnused(m_watchedDirectories, it);
     }
 }
 
-void FileWatcher::StopWatching()
+bool FileWatcher::WatchDirectory(const std::wstring& dirPath, std::function<void()> callback)
 {
-    m_isRunning = false;
+    m_isRunning = true;
 
-    std::lock_guard<std::mutex> lock(m_watchedDirsMutex);
-    for (auto& [dirPath, watchDir] : m_watchedDirectories)
+    std::shared_ptr<WatchedDirectory> watchDir = GetOrCreateWatchedDirectory(dirPath);
+    if (!watchDir)
     {
-        watchDir->isRunning = false;
+        std::wcerr << L"[FileWatcher] Failed to create watched directory" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(watchDir->callbacksMutex);
+        watchDir->directoryCallback = callback;
+    }
 
-        // Close directory handle to interrupt ReadDirectoryChangesW
-        if (watchDir->hDirectory != INVALID_HANDLE_VALUE)
+    return true;
+}
+
+void FileWatcher::StopWatchingDirectory(const std::wstring& dirPath)
+{
+    std::lock_guard<std::mutex> lock(m_watchedDirsMutex);
+    auto it = m_watchedDirectories.find(dirPath);
+    if (it != m_watchedDirectories.end())
+    {
         {
-            CloseHandle(watchDir->hDirectory);
+            std::lock_guard<std::mutex> callbackLock(it->second->callbacksMutex);
+            it->second->directoryCallback = nullptr;
         }
 
-        // Wait for thread to finish
-        if (watchDir->watchThread.joinable())
+        ReleaseWatchedDirectoryIfUnused(m_watchedDirectories, it);
+    }
+}
+
+bool FileWatcher::WatchTree(const std::wstring& dirPath, std::function<void(const std::vector<std::wstring>&)> callback)
+{
+    m_isRunning = true;
+
+    std::shared_ptr<WatchedDirectory> watchDir = GetOrCreateWatchedDirectory(dirPath, true);
+    if (!watchDir)
+    {
+        std::wcerr << L"[FileWatcher] Failed to create watched tree" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(watchDir->callbacksMutex);
+        watchDir->treeCallback = callback;
+    }
+
+    return true;
+}
+
+void FileWatcher::StopWatchingTree(const std::wstring& dirPath)
+{
+    std::lock_guard<std::mutex> lock(m_watchedDirsMutex);
+    auto it = m_watchedTrees.find(dirPath);
+    if (it != m_watchedTrees.end())
+    {
         {
-            watchDir->watchThread.join();
+            std::lock_guard<std::mutex> callbackLock(it->second->callbacksMutex);
+            it->second->treeCallback = nullptr;
         }
+
+        ReleaseWatchedDirectoryIfUnused(m_watchedTrees, it);
+    }
+}
+
+void FileWatcher::ReleaseWatchedDirectoryIfUnused(std::map<std::wstring, std::shared_ptr<WatchedDirectory>>& directories,
+                                                  std::map<std::wstring, std::shared_ptr<WatchedDirectory>>::iterator it)
+{
+    {
+        std::lock_guard<std::mutex> callbackLock(it->second->callbacksMutex);
+        if (!it->second->fileCallbacks.empty() || it->second->directoryCallback || it->second->treeCallback)
+            return;
+    }
+
+    // Nothing left to watch in this directory, stop watching
+    FileWatchId id = it->second->id;
+    if (m_backend)
+    {
+        m_backend->RemoveWatch(id);
+    }
+    {
+        std::lock_guard<std::mutex> dispatchLock(m_dispatchMutex);
+        m_pending.erase(id);
+    }
+    m_watchesById.erase(id);
+    directories.erase(it);
+}
+
+void FileWatcher::StopWatching()
+{
+    m_isRunning = false;
+
+    std::unique_ptr<FileWatchBackend> backend;
+    {
+        std::lock_guard<std::mutex> lock(m_watchedDirsMutex);
+        backend = std::move(m_backend);
+        m_watchedDirectories.clear();
+        m_watchedTrees.clear();
+        m_watchesById.clear();
+    }
+
+    // Backend first (no more changes come in), then the dispatch threads (outside the lock, which
+    // a running delivery may be waiting for)
+    if (backend)
+    {
+        backend->Stop();
+    }
+
+    std::vector<std::thread> dispatchThreads;
+    {
+        std::lock_guard<std::mutex> lock(m_dispatchMutex);
+        m_dispatchRunning = false;
+        m_pending.clear();
+        dispatchThreads.swap(m_dispatchThreads);
+    }
+    m_dispatchCV.notify_all();
+    for (auto& thread : dispatchThreads)
+    {
+        if (thread.joinable())
+            thread.join();
     }
 
-    m_watchedDirectories.clear();
     std::cout << "[FileWatcher] Stopped watching all files" << std::endl;
 }
 
-void FileWatcher::WatchThread(WatchedDirectory* watchDir)
+bool FileWatcher::EnsureStartedLocked()
 {
-    const DWORD bufferSize = 1024 * 4;  // 4KB buffer
-    BYTE buffer[bufferSize];
+    if (m_backend)
+    {
+        return true;
+    }
+
+    m_backend = FileWatchBackend::Create();
+    if (!m_backend)
+    {
+        std::cerr << "[FileWatcher] No file watch backend for this platform" << std::endl;
+        return false;
+    }
 
-    OVERLAPPED overlapped = {};
-    overlapped.hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    FileWatchHandler handler;
+    handler.onChanges = [this](FileWatchId id, std::vector<std::wstring> changedPaths, bool overflow) {
+        OnChanges(id, std::move(changedPaths), overflow);
+    };
 
-    if (!overlapped.hEvent)
+    if (!m_backend->Start(handler))
     {
-        std::cerr << "[FileWatcher] Failed to create event for overlapped I/O" << std::endl;
-        return;
+        m_backend.reset();
+        return false;
     }
 
-    std::wcout << L"[FileWatcher] Watch thread started for: " << watchDir->directoryPath << std::endl;
+    std::lock_guard<std::mutex> lock(m_dispatchMutex);
+    m_dispatchRunning = true;
+    for (size_t i = 0; i < kDispatchThreads; i++)
+    {
+        m_dispatchThreads.emplace_back(&FileWatcher::DispatchThread, this);
+    }
+    return true;
+}
 
-    while (watchDir->isRunning)
+void FileWatcher::OnChanges(FileWatchId id, std::vector<std::wstring> changedPaths, bool overflow)
+{
     {
-        DWORD bytesReturned = 0;
-
-        // Request notification of changes
-        BOOL success = ReadDirectoryChangesW(
-            watchDir->hDirectory,
-            buffer,
-            bufferSize,
-            FALSE,  // Don't watch subdirectories
-            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
-            NULL,
-            &overlapped,
-            NULL
-        );
-
-        if (!success)
+        std::lock_guard<std::mutex> lock(m_dispatchMutex);
+        if (!m_dispatchRunning)
         {
-            DWORD error = GetLastError();
-            if (error != ERROR_INVALID_HANDLE)  // Expected when stopping
-            {
-                std::cerr << "[FileWatcher] ReadDirectoryChangesW failed: " << error << std::endl;
-            }
-            break;
+            return;
         }
 
-        // Wait for the event (with timeout)
-        DWORD waitResult = WaitForSingleObject(overlapped.hEvent, 500);  // 500ms timeout
+        // The first change opens the window, later ones join the batch (each path once)
+        auto [it, opened] = m_pending.try_emplace(id);
+        PendingChanges& pending = it->second;
+        if (opened)
+        {
+            pending.due = std::chrono::steady_clock::now() + std::chrono::milliseconds(kDebounceMs);
+        }
+
+        if (overflow)
+        {
+            pending.overflow = true;
+            pending.paths.clear();
+        }
+        else if (!pending.overflow)
+        {
+            pending.paths.insert(std::make_move_iterator(changedPaths.begin()), std::make_move_iterator(changedPaths.end()));
+        }
 
-        if (waitResult == WAIT_OBJECT_0)
+        if (!opened)
         {
-            // Get the result
-            success = GetOverlappedResult(watchDir->hDirectory, &overlapped, &bytesReturned, FALSE);
+            return;
+        }
+    }
+    m_dispatchCV.notify_all();
+}
 
-            if (success && bytesReturned > 0)
-            {
-                // Process notifications
-                FILE_NOTIFY_INFORMATION* notification = (FILE_NOTIFY_INFORMATION*)buffer;
+void FileWatcher::DispatchThread()
+{
+    std::unique_lock<std::mutex> lock(m_dispatchMutex);
 
-                while (true)
-                {
-                    // Extract filename from notification
-                    std::wstring filename(notification->FileName, notification->FileNameLength / sizeof(WCHAR));
-
-                    // Check if we're watching this specific file
-                    {
-                        std::lock_guard<std::mutex> lock(watchDir->callbacksMutex);
-                        auto it = watchDir->fileCallbacks.find(filename);
-                        if (it != watchDir->fileCallbacks.end())
-                        {
-                            // File changed - invoke callback
-                            try
-                            {
-                                it->second();
-                            }
-                            catch (const std::exception& e)
-                            {
-                                std::cerr << "[FileWatcher] Callback exception: " << e.what() << std::endl;
-                            }
-                        }
-                    }
-
-                    // Move to next notification (if any)
-                    if (notification->NextEntryOffset == 0)
-                        break;
-
-                    notification = (FILE_NOTIFY_INFORMATION*)((BYTE*)notification + notification->NextEntryOffset);
-                }
+    while (m_dispatchRunning)
+    {
+        // Earliest batch of a watch that isn't being delivered already
+        auto next = m_pending.end();
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it)
+        {
+            if (m_delivering.find(it->first) == m_delivering.end() && (next == m_pending.end() || it->second.due < next->second.due))
+            {
+                next = it;
             }
         }
-        else if (waitResult == WAIT_TIMEOUT)
+
+        if (next == m_pending.end())
         {
-            // Timeout - check if we should continue
+            m_dispatchCV.wait(lock);
             continue;
         }
-        else
+
+        if (next->second.due > std::chrono::steady_clock::now())
         {
-            // Error or abandoned
-            break;
+            m_dispatchCV.wait_until(lock, next->second.due);
+            continue;
         }
-    }
 
-    CloseHandle(overlapped.hEvent);
-    std::wcout << L"[FileWatcher] Watch thread stopped for: " << watchDir->directoryPath << std::endl;
+        FileWatchId id = next->first;
+        PendingChanges changes = std::move(next->second);
+        m_pending.erase(next);
+        m_delivering.insert(id);
+
+        lock.unlock();
+        Deliver(id, changes);
+        lock.lock();
+
+        m_delivering.erase(id);
+        if (m_pending.find(id) != m_pending.end())
+        {
+            m_dispatchCV.notify_all();  // Changes that came in meanwhile
+        }
+    }
 }
 
-FileWatcher::WatchedDirectory* FileWatcher::GetOrCreateWatchedDirectory(const std::wstring& filePath)
+void FileWatcher::Deliver(FileWatchId id, const PendingChanges& changes)
 {
-    std::wstring dirPath = GetDirectory(filePath);
+    std::shared_ptr<WatchedDirectory> watchDir;
+    {
+        std::lock_guard<std::mutex> lock(m_watchedDirsMutex);
+        auto it = m_watchesById.find(id);
+        if (it == m_watchesById.end())
+        {
+            return;     // Removed meanwhile
+        }
+        watchDir = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(watchDir->callbacksMutex);
 
+    try
+    {
+        // Directory watchers get one call per batch of notifications (overflows included)
+        if (watchDir->directoryCallback)
+        {
+            watchDir->directoryCallback();
+        }
+
+        // Tree watchers get the changed paths of the batch (empty after an overflow)
+        if (watchDir->treeCallback)
+        {
+            std::vector<std::wstring> changedPaths;
+            if (!changes.overflow)
+            {
+                changedPaths.assign(changes.paths.begin(), changes.paths.end());
+            }
+            watchDir->treeCallback(changedPaths);
+        }
+
+        // After an overflow only directory watchers can act
+        if (!changes.overflow)
+        {
+            for (const auto& path : changes.paths)
+            {
+                auto it = watchDir->fileCallbacks.find(path);
+                if (it != watchDir->fileCallbacks.end())
+                {
+                    it->second();
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[FileWatcher] Callback exception: " << e.what() << std::endl;
+    }
+}
+
+std::shared_ptr<FileWatcher::WatchedDirectory> FileWatcher::GetOrCreateWatchedDirectory(const std::wstring& dirPath, bool watchSubtree)
+{
     std::lock_guard<std::mutex> lock(m_watchedDirsMutex);
+    auto& directories = watchSubtree ? m_watchedTrees : m_watchedDirectories;
 
     // Check if already watching this directory
-    auto it = m_watchedDirectories.find(dirPath);
-    if (it != m_watchedDirectories.end())
+    auto it = directories.find(dirPath);
+    if (it != directories.end())
     {
-        return it->second.get();
+        return it->second;
+    }
+
+    if (!EnsureStartedLocked())
+    {
+        return nullptr;
     }
 
     // Create new watched directory
-    auto watchDir = std::make_unique<WatchedDirectory>();
+    auto watchDir = std::make_shared<WatchedDirectory>();
+    watchDir->id = m_nextWatchId++;
     watchDir->directoryPath = dirPath;
+    watchDir->watchSubtree = watchSubtree;
 
-    // Open directory handle with FILE_FLAG_BACKUP_SEMANTICS and FILE_FLAG_OVERLAPPED
-    watchDir->hDirectory = CreateFileW(
-        dirPath.c_str(),
-        FILE_LIST_DIRECTORY,
-        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
-        NULL,
-        OPEN_EXISTING,
-        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
-        NULL
-    );
-
-    if (watchDir->hDirectory == INVALID_HANDLE_VALUE)
+    if (!m_backend->AddWatch(watchDir->id, dirPath, watchSubtree))
     {
-        DWORD error = GetLastError();
-        std::wcerr << L"[FileWatcher] Failed to open directory: " << dirPath
-                   << L" Error: " << error << std::endl;
         return nullptr;
     }
 
-    // Start watch thread
-    watchDir->isRunning = true;
-    watchDir->watchThread = std::thread(&FileWatcher::WatchThread, this, watchDir.get());
-
-    WatchedDirectory* result = watchDir.get();
-    m_watchedDirectories[dirPath] = std::move(watchDir);
-
-    return result;
+    directories[dirPath] = watchDir;
+    m_watchesById[watchDir->id] = watchDir;
+    return watchDir;
 }
 
 std::wstring FileWatcher::GetFilename(const std::wstring& filePath)
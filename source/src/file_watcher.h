@@ -1,17 +1,27 @@
 #pragma once
 
-#include <windows.h>
 #include <string>
 #include <thread>
 #include <atomic>
 #include <functional>
 #include <map>
+#include <set>
+#include <vector>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "file_watcher_backend.h"
 
 namespace UFB {
 
 /**
- * FileWatcher - Watches files for changes using Windows ReadDirectoryChangesW
+ * FileWatcher - Watches files and directories for changes
+ *
+ * All watches share one OS thread (FileWatchBackend: ReadDirectoryChangesW on an I/O completion
+ * port on Windows, inotify on Linux). Changes of a watch are collected for kDebounceMs after the
+ * first one and delivered as one batch on a small pool of dispatch threads; a watch's callbacks
+ * never run concurrently with each other.
  *
  * Usage:
  *   FileWatcher watcher;
@@ -41,6 +51,37 @@ public:
      */
     void StopWatchingFile(const std::wstring& filePath);
 
+    /**
+     * Watch a directory for any change to its entries (create, delete, rename, write, size)
+     * The callback also fires when the change buffer overflows and events were lost.
+     * @param dirPath Absolute path to directory to watch
+     * @param callback Function to call when the directory contents change
+     * @return true if watching started successfully
+     */
+    bool WatchDirectory(const std::wstring& dirPath, std::function<void()> callback);
+
+    /**
+     * Stop watching a directory registered with WatchDirectory
+     * @param dirPath Absolute path to directory to stop watching
+     */
+    void StopWatchingDirectory(const std::wstring& dirPath);
+
+    /**
+     * Watch a directory and everything below it
+     * The callback receives the changed paths relative to dirPath (created, deleted, renamed or written);
+     * an empty list means the change buffer overflowed and events were lost.
+     * @param dirPath Absolute path to the root directory to watch
+     * @param callback Function to call with each batch of changed paths
+     * @return true if watching started successfully
+     */
+    bool WatchTree(const std::wstring& dirPath, std::function<void(const std::vector<std::wstring>&)> callback);
+
+    /**
+     * Stop watching a directory tree registered with WatchTree
+     * @param dirPath Absolute path to the root directory to stop watching
+     */
+    void StopWatchingTree(const std::wstring& dirPath);
+
     /**
      * Stop watching all files and cleanup
      */
@@ -51,26 +92,61 @@ public:
      */
     bool IsWatching() const { return m_isRunning.load(); }
 
+    static constexpr int kDebounceMs = 50;
+    static constexpr size_t kDispatchThreads = 2;
+
 private:
     struct WatchedDirectory
     {
+        FileWatchId id = 0;
         std::wstring directoryPath;
-        HANDLE hDirectory;
-        std::thread watchThread;
-        std::atomic<bool> isRunning{false};
         std::map<std::wstring, std::function<void()>> fileCallbacks;  // filename -> callback
-        std::mutex callbacksMutex;
+        std::function<void()> directoryCallback;  // Any entry changed (WatchDirectory)
+        std::function<void(const std::vector<std::wstring>&)> treeCallback;  // Changed paths below (WatchTree)
+        bool watchSubtree = false;
+        std::mutex callbacksMutex;                // Held while callbacks run, so Stop* waits for them
     };
 
+    // Changes of a watch waiting for its debounce window to close
+    struct PendingChanges
+    {
+        std::set<std::wstring> paths;
+        bool overflow = false;
+        std::chrono::steady_clock::time_point due;
+    };
+
+    /**
+     * Backend thread: queue changes of a watch for dispatch
+     */
+    void OnChanges(FileWatchId id, std::vector<std::wstring> changedPaths, bool overflow);
+
+    /**
+     * Dispatch thread: deliver due batches, one at a time per watch
+     */
+    void DispatchThread();
+
+    /**
+     * Run the callbacks of a watch for a batch of changes
+     */
+    void Deliver(FileWatchId id, const PendingChanges& changes);
+
     /**
-     * Background thread that monitors directory changes
+     * Start the backend and dispatch threads if they aren't running
+     * Caller must hold m_watchedDirsMutex
      */
-    void WatchThread(WatchedDirectory* watchDir);
+    bool EnsureStartedLocked();
 
     /**
-     * Get or create a WatchedDirectory for a given file path
+     * Get or create a WatchedDirectory for a given directory path
      */
-    WatchedDirectory* GetOrCreateWatchedDirectory(const std::wstring& filePath);
+    std::shared_ptr<WatchedDirectory> GetOrCreateWatchedDirectory(const std::wstring& dirPath, bool watchSubtree = false);
+
+    /**
+     * Stop watching a directory once nothing is registered on it
+     * Caller must hold m_watchedDirsMutex
+     */
+    void ReleaseWatchedDirectoryIfUnused(std::map<std::wstring, std::shared_ptr<WatchedDirectory>>& directories,
+                                         std::map<std::wstring, std::shared_ptr<WatchedDirectory>>::iterator it);
 
     /**
      * Extract filename from full path
@@ -82,9 +158,21 @@ private:
      */
     std::wstring GetDirectory(const std::wstring& filePath);
 
-    std::map<std::wstring, std::unique_ptr<WatchedDirectory>> m_watchedDirectories;
+    std::unique_ptr<FileWatchBackend> m_backend;
+    std::map<std::wstring, std::shared_ptr<WatchedDirectory>> m_watchedDirectories;
+    std::map<std::wstring, std::shared_ptr<WatchedDirectory>> m_watchedTrees;  // Subtree watches (separate OS watches)
+    std::map<FileWatchId, std::shared_ptr<WatchedDirectory>> m_watchesById;
+    FileWatchId m_nextWatchId = 1;
     std::mutex m_watchedDirsMutex;
     std::atomic<bool> m_isRunning{false};
+
+    // Dispatch
+    std::map<FileWatchId, PendingChanges> m_pending;
+    std::set<FileWatchId> m_delivering;         // Watches whose callbacks are running
+    std::vector<std::thread> m_dispatchThreads;
+    bool m_dispatchRunning = false;
+    std::mutex m_dispatchMutex;                 // Guards m_pending, m_delivering, m_dispatchRunning
+    std::condition_variable m_dispatchCV;
 };
 
 } // namespace UFB
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+
+namespace UFB {
+
+// Watch handle given to a backend by FileWatcher
+using FileWatchId = uint64_t;
+
+// Callback from the backend's thread
+struct FileWatchHandler
+{
+    // Entries of a watch that changed (created, deleted, renamed or written), relative to its
+    // directory; overflow means events were lost and changedPaths is incomplete
+    std::function<void(FileWatchId id, std::vector<std::wstring> changedPaths, bool overflow)> onChanges;
+};
+
+// OS side of FileWatcher: every watched directory multiplexed on one thread
+//
+// - Windows: overlapped ReadDirectoryChangesW on an I/O completion port
+// - Linux: inotify with epoll; trees get a watch per subdirectory, added as directories appear
+//
+// Filtering by file, debouncing and running callbacks live in FileWatcher
+class FileWatchBackend
+{
+public:
+    virtual ~FileWatchBackend() = default;
+
+    // Platform implementation (nullptr if the platform has none)
+    static std::unique_ptr<FileWatchBackend> Create();
+
+    // Start the watch thread; handler callbacks run on it
+    virtual bool Start(const FileWatchHandler& handler) = 0;
+
+    // Remove every watch and stop the thread
+    virtual void Stop() = 0;
+
+    // Watch a directory (and everything below it if subtree)
+    virtual bool AddWatch(FileWatchId id, const std::wstring& dirPath, bool subtree) = 0;
+
+    // Stop watching; changes already read may still be reported for the id
+    virtual void RemoveWatch(FileWatchId id) = 0;
+};
+
+} // namespace UFB
@@ -0,0 +1,375 @@
+#ifdef __linux__
+
+#include "file_watcher_backend.h"
+#include <sys/inotify.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+namespace UFB {
+
+namespace {
+
+// Entry changes (names, writes), plus the watched directory going away
+constexpr uint32_t kWatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE |
+                                IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+} // namespace
+
+// inotify descriptor and a wake eventfd on epoll, one thread
+class InotifyFileWatchBackend : public FileWatchBackend
+{
+public:
+    ~InotifyFileWatchBackend() override;
+
+    bool Start(const FileWatchHandler& handler) override;
+    void Stop() override;
+    bool AddWatch(FileWatchId id, const std::wstring& dirPath, bool subtree) override;
+    void RemoveWatch(FileWatchId id) override;
+
+private:
+    // A watch on an inotify descriptor; relativeDir is the directory below the watch root
+    struct WatchTarget
+    {
+        FileWatchId id;
+        std::wstring relativeDir;
+    };
+
+    struct Watch
+    {
+        std::filesystem::path rootPath;
+        bool subtree = false;
+        std::set<int> descriptors;
+    };
+
+    void WatchThread();
+    void ReadEvents(std::map<FileWatchId, std::vector<std::wstring>>& changes, std::set<FileWatchId>& overflowed);
+    bool AddDirectoryLocked(FileWatchId id, Watch& watch, const std::filesystem::path& dirPath, const std::wstring& relativeDir);
+    void AddSubdirectoriesLocked(FileWatchId id, Watch& watch, const std::filesystem::path& dirPath, const std::wstring& relativeDir,
+                                 std::vector<std::wstring>* foundEntries = nullptr);
+    static std::wstring JoinRelative(const std::wstring& relativeDir, const std::wstring& name);
+
+    FileWatchHandler m_handler;
+    int m_inotifyFd = -1;
+    int m_epollFd = -1;
+    int m_wakeFd = -1;          // eventfd that interrupts epoll_wait on Stop
+    std::atomic<bool> m_isRunning{false};
+    std::thread m_thread;
+
+    // Watches of one directory share its descriptor (a directory and a tree above it, or nested trees)
+    std::map<FileWatchId, Watch> m_watches;
+    std::map<int, std::vector<WatchTarget>> m_targets;     // inotify descriptor -> watches on it
+    std::mutex m_watchesMutex;
+};
+
+std::unique_ptr<FileWatchBackend> FileWatchBackend::Create()
+{
+    return std::make_unique<InotifyFileWatchBackend>();
+}
+
+InotifyFileWatchBackend::~InotifyFileWatchBackend()
+{
+    Stop();
+}
+
+bool InotifyFileWatchBackend::Start(const FileWatchHandler& handler)
+{
+    m_handler = handler;
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_inotifyFd < 0 || m_epollFd < 0 || m_wakeFd < 0)
+    {
+        std::cerr << "[FileWatcher] Failed to create inotify/epoll descriptors: " << strerror(errno) << std::endl;
+        for (int fd : { m_inotifyFd, m_epollFd, m_wakeFd })
+        {
+            if (fd >= 0)
+                close(fd);
+        }
+        m_inotifyFd = m_epollFd = m_wakeFd = -1;
+        return false;
+    }
+
+    for (int fd : { m_inotifyFd, m_wakeFd })
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    m_isRunning = true;
+    m_thread = std::thread(&InotifyFileWatchBackend::WatchThread, this);
+    return true;
+}
+
+void InotifyFileWatchBackend::Stop()
+{
+    if (!m_isRunning)
+    {
+        return;
+    }
+
+    m_isRunning = false;
+    uint64_t one = 1;
+    if (write(m_wakeFd, &one, sizeof(one)) < 0)
+    {
+        std::cerr << "[FileWatcher] Failed to wake watch thread: " << strerror(errno) << std::endl;
+    }
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    // Closing the inotify descriptor drops all its watches
+    close(m_inotifyFd);
+    close(m_epollFd);
+    close(m_wakeFd);
+    m_inotifyFd = m_epollFd = m_wakeFd = -1;
+
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    m_watches.clear();
+    m_targets.clear();
+}
+
+bool InotifyFileWatchBackend::AddWatch(FileWatchId id, const std::wstring& dirPath, bool subtree)
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    if (!m_isRunning || m_watches.find(id) != m_watches.end())
+    {
+        return false;
+    }
+
+    Watch& watch = m_watches[id];
+    watch.rootPath = std::filesystem::path(dirPath);
+    watch.subtree = subtree;
+
+    if (!AddDirectoryLocked(id, watch, watch.rootPath, std::wstring()))
+    {
+        m_watches.erase(id);
+        return false;
+    }
+
+    if (subtree)
+    {
+        AddSubdirectoriesLocked(id, watch, watch.rootPath, std::wstring());
+    }
+    return true;
+}
+
+void InotifyFileWatchBackend::RemoveWatch(FileWatchId id)
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    auto it = m_watches.find(id);
+    if (it == m_watches.end())
+    {
+        return;
+    }
+
+    for (int wd : it->second.descriptors)
+    {
+        auto targets = m_targets.find(wd);
+        if (targets == m_targets.end())
+        {
+            continue;
+        }
+
+        std::erase_if(targets->second, [id](const WatchTarget& target) { return target.id == id; });
+        if (targets->second.empty())
+        {
+            inotify_rm_watch(m_inotifyFd, wd);
+            m_targets.erase(targets);
+        }
+    }
+    m_watches.erase(it);
+}
+
+bool InotifyFileWatchBackend::AddDirectoryLocked(FileWatchId id, Watch& watch, const std::filesystem::path& dirPath,
+                                                 const std::wstring& relativeDir)
+{
+    int wd = inotify_add_watch(m_inotifyFd, dirPath.c_str(), kWatchMask);
+    if (wd < 0)
+    {
+        std::cerr << "[FileWatcher] Failed to watch " << dirPath.string() << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (!watch.descriptors.insert(wd).second)
+    {
+        return true;    // Already watched through this watch
+    }
+    m_targets[wd].push_back({id, relativeDir});
+    return true;
+}
+
+void InotifyFileWatchBackend::AddSubdirectoriesLocked(FileWatchId id, Watch& watch, const std::filesystem::path& dirPath,
+                                                      const std::wstring& relativeDir, std::vector<std::wstring>* foundEntries)
+{
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(dirPath, ec), end; !ec && it != end; it.increment(ec))
+    {
+        std::wstring childRelative = JoinRelative(relativeDir, it->path().filename().wstring());
+        if (foundEntries)
+        {
+            foundEntries->push_back(childRelative);
+        }
+
+        std::error_code typeError;
+        if (!it->is_directory(typeError) || it->is_symlink(typeError))
+        {
+            continue;
+        }
+
+        if (AddDirectoryLocked(id, watch, it->path(), childRelative))
+        {
+            AddSubdirectoriesLocked(id, watch, it->path(), childRelative, foundEntries);
+        }
+    }
+}
+
+std::wstring InotifyFileWatchBackend::JoinRelative(const std::wstring& relativeDir, const std::wstring& name)
+{
+    if (relativeDir.empty())
+        return name;
+    if (name.empty())
+        return relativeDir;
+    return relativeDir + static_cast<wchar_t>(std::filesystem::path::preferred_separator) + name;
+}
+
+void InotifyFileWatchBackend::WatchThread()
+{
+    std::cout << "[FileWatcher] Watch thread started" << std::endl;
+
+    epoll_event events[2];
+
+    while (m_isRunning)
+    {
+        int count = epoll_wait(m_epollFd, events, 2, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "[FileWatcher] epoll_wait failed: " << strerror(errno) << std::endl;
+            break;
+        }
+
+        bool readable = false;
+        for (int i = 0; i < count; i++)
+        {
+            if (events[i].data.fd == m_inotifyFd)
+                readable = true;
+        }
+        if (!readable || !m_isRunning)
+        {
+            continue;
+        }
+
+        std::map<FileWatchId, std::vector<std::wstring>> changes;
+        std::set<FileWatchId> overflowed;
+        ReadEvents(changes, overflowed);
+
+        if (!m_handler.onChanges)
+        {
+            continue;
+        }
+        for (FileWatchId id : overflowed)
+        {
+            m_handler.onChanges(id, std::vector<std::wstring>(), true);
+        }
+        for (auto& [id, paths] : changes)
+        {
+            if (overflowed.find(id) == overflowed.end())
+            {
+                m_handler.onChanges(id, std::move(paths), false);
+            }
+        }
+    }
+
+    std::cout << "[FileWatcher] Watch thread stopped" << std::endl;
+}
+
+void InotifyFileWatchBackend::ReadEvents(std::map<FileWatchId, std::vector<std::wstring>>& changes,
+                                         std::set<FileWatchId>& overflowed)
+{
+    alignas(inotify_event) char buffer[64 * 1024];
+
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+
+    while (true)
+    {
+        ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;      // EAGAIN: drained
+        }
+
+        for (char* pos = buffer; pos < buffer + length;)
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(pos);
+            pos += sizeof(inotify_event) + event->len;
+
+            // The kernel queue overflowed: every watch lost events
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                for (const auto& [id, watch] : m_watches)
+                    overflowed.insert(id);
+                continue;
+            }
+
+            auto targets = m_targets.find(event->wd);
+            if (targets == m_targets.end())
+            {
+                continue;
+            }
+
+            // Directory deleted or moved away: its descriptor is gone
+            if (event->mask & IN_IGNORED)
+            {
+                for (const auto& target : targets->second)
+                {
+                    auto watch = m_watches.find(target.id);
+                    if (watch != m_watches.end())
+                        watch->second.descriptors.erase(event->wd);
+                }
+                m_targets.erase(targets);
+                continue;
+            }
+
+            std::wstring name = event->len > 0 ? std::filesystem::path(event->name).wstring() : std::wstring();
+            bool newDirectory = (event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO));
+
+            // Copy: adding watches for a new directory can reallocate the target list
+            std::vector<WatchTarget> eventTargets = targets->second;
+            for (const auto& target : eventTargets)
+            {
+                std::wstring relativePath = JoinRelative(target.relativeDir, name);
+                changes[target.id].push_back(relativePath);
+
+                auto watch = m_watches.find(target.id);
+                if (newDirectory && watch != m_watches.end() && watch->second.subtree)
+                {
+                    std::filesystem::path dirPath = watch->second.rootPath / relativePath;
+                    // Entries created before the watch was in place are reported as changed too
+                    if (AddDirectoryLocked(target.id, watch->second, dirPath, relativePath))
+                    {
+                        AddSubdirectoriesLocked(target.id, watch->second, dirPath, relativePath, &changes[target.id]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace UFB
+
+#endif // __linux__
@@ -0,0 +1,301 @@
+#ifdef _WIN32
+
+#include <windows.h>
+#include "file_watcher_backend.h"
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+namespace UFB {
+
+namespace {
+
+// 4KB for single directories; trees get 64KB (the most a network share will return) to overflow less often
+constexpr DWORD kDirectoryBufferSize = 4 * 1024;
+constexpr DWORD kTreeBufferSize = 64 * 1024;
+
+// Names for directory watches, writes and sizes for file watches
+constexpr DWORD kNotifyFilter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE |
+                                FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME;
+
+// One watched directory with its outstanding read
+struct DirectoryWatch
+{
+    OVERLAPPED overlapped = {};
+    FileWatchId id = 0;
+    HANDLE hDirectory = INVALID_HANDLE_VALUE;
+    bool subtree = false;
+    std::vector<BYTE> buffer;
+};
+
+} // namespace
+
+// ReadDirectoryChangesW reads completing on one I/O completion port
+class IOCPFileWatchBackend : public FileWatchBackend
+{
+public:
+    ~IOCPFileWatchBackend() override;
+
+    bool Start(const FileWatchHandler& handler) override;
+    void Stop() override;
+    bool AddWatch(FileWatchId id, const std::wstring& dirPath, bool subtree) override;
+    void RemoveWatch(FileWatchId id) override;
+
+private:
+    void WatchThread();
+    static bool IssueRead(DirectoryWatch* watch);
+    static void CloseWatch(DirectoryWatch* watch);
+
+    FileWatchHandler m_handler;
+    HANDLE m_port = NULL;
+    std::atomic<bool> m_isRunning{false};
+    std::thread m_thread;
+
+    // A watch's buffer and OVERLAPPED stay alive until its last read completion has been dequeued
+    // (aborted ones included), so removed watches wait in m_retired for that
+    std::map<FileWatchId, std::unique_ptr<DirectoryWatch>> m_watches;
+    std::map<DirectoryWatch*, std::unique_ptr<DirectoryWatch>> m_retired;
+    std::mutex m_watchesMutex;
+};
+
+std::unique_ptr<FileWatchBackend> FileWatchBackend::Create()
+{
+    return std::make_unique<IOCPFileWatchBackend>();
+}
+
+IOCPFileWatchBackend::~IOCPFileWatchBackend()
+{
+    Stop();
+}
+
+bool IOCPFileWatchBackend::Start(const FileWatchHandler& handler)
+{
+    m_handler = handler;
+
+    m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+    if (m_port == NULL)
+    {
+        std::cerr << "[FileWatcher] Failed to create completion port: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    m_isRunning = true;
+    m_thread = std::thread(&IOCPFileWatchBackend::WatchThread, this);
+    return true;
+}
+
+void IOCPFileWatchBackend::Stop()
+{
+    if (!m_isRunning)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_watchesMutex);
+        m_isRunning = false;
+        for (auto& [id, watch] : m_watches)
+        {
+            CloseWatch(watch.get());
+            DirectoryWatch* raw = watch.get();
+            m_retired[raw] = std::move(watch);
+        }
+        m_watches.clear();
+    }
+
+    // Wake the thread; it leaves once the aborted reads are drained
+    PostQueuedCompletionStatus(m_port, 0, 0, NULL);
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    CloseHandle(m_port);
+    m_port = NULL;
+    m_retired.clear();
+}
+
+bool IOCPFileWatchBackend::AddWatch(FileWatchId id, const std::wstring& dirPath, bool subtree)
+{
+    auto watch = std::make_unique<DirectoryWatch>();
+    watch->id = id;
+    watch->subtree = subtree;
+    watch->buffer.resize(subtree ? kTreeBufferSize : kDirectoryBufferSize);
+
+    watch->hDirectory = CreateFileW(
+        dirPath.c_str(),
+        FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        NULL
+    );
+
+    if (watch->hDirectory == INVALID_HANDLE_VALUE)
+    {
+        std::wcerr << L"[FileWatcher] Failed to open directory: " << dirPath
+                   << L" Error: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    if (CreateIoCompletionPort(watch->hDirectory, m_port, 1, 0) == NULL)
+    {
+        std::wcerr << L"[FileWatcher] Failed to associate directory with completion port: " << dirPath
+                   << L" Error: " << GetLastError() << std::endl;
+        CloseHandle(watch->hDirectory);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    if (!m_isRunning || !IssueRead(watch.get()))
+    {
+        CloseHandle(watch->hDirectory);
+        return false;
+    }
+
+    m_watches[id] = std::move(watch);
+    return true;
+}
+
+void IOCPFileWatchBackend::RemoveWatch(FileWatchId id)
+{
+    std::lock_guard<std::mutex> lock(m_watchesMutex);
+    auto it = m_watches.find(id);
+    if (it == m_watches.end())
+    {
+        return;
+    }
+
+    // Closing aborts the outstanding read; its completion frees the watch
+    CloseWatch(it->second.get());
+    DirectoryWatch* raw = it->second.get();
+    m_retired[raw] = std::move(it->second);
+    m_watches.erase(it);
+}
+
+bool IOCPFileWatchBackend::IssueRead(DirectoryWatch* watch)
+{
+    ZeroMemory(&watch->overlapped, sizeof(OVERLAPPED));
+
+    BOOL success = ReadDirectoryChangesW(
+        watch->hDirectory,
+        watch->buffer.data(),
+        static_cast<DWORD>(watch->buffer.size()),
+        watch->subtree ? TRUE : FALSE,  // Subdirectories only for tree watches
+        kNotifyFilter,
+        NULL,
+        &watch->overlapped,
+        NULL
+    );
+
+    if (!success)
+    {
+        DWORD error = GetLastError();
+        if (error != ERROR_INVALID_HANDLE)  // Expected when stopping
+        {
+            std::cerr << "[FileWatcher] ReadDirectoryChangesW failed: " << error << std::endl;
+        }
+        return false;
+    }
+    return true;
+}
+
+void IOCPFileWatchBackend::CloseWatch(DirectoryWatch* watch)
+{
+    if (watch->hDirectory != INVALID_HANDLE_VALUE)
+    {
+        CancelIoEx(watch->hDirectory, NULL);
+        CloseHandle(watch->hDirectory);
+        watch->hDirectory = INVALID_HANDLE_VALUE;
+    }
+}
+
+void IOCPFileWatchBackend::WatchThread()
+{
+    std::cout << "[FileWatcher] Watch thread started" << std::endl;
+
+    int idleTimeouts = 0;
+
+    while (true)
+    {
+        DWORD bytesReturned = 0;
+        ULONG_PTR completionKey = 0;
+        LPOVERLAPPED overlapped = NULL;
+
+        BOOL success = GetQueuedCompletionStatus(m_port, &bytesReturned, &completionKey, &overlapped, 500);
+
+        if (overlapped == NULL)
+        {
+            // Wake-up from Stop or timeout; after Stop, wait a little for the aborted reads
+            if (!m_isRunning)
+            {
+                std::lock_guard<std::mutex> lock(m_watchesMutex);
+                if (m_retired.empty() || ++idleTimeouts > 4)
+                {
+                    break;
+                }
+            }
+            continue;
+        }
+
+        DirectoryWatch* watch = CONTAINING_RECORD(overlapped, DirectoryWatch, overlapped);
+
+        FileWatchId id = 0;
+        std::vector<std::wstring> changedPaths;
+        bool overflow = false;
+        {
+            std::lock_guard<std::mutex> lock(m_watchesMutex);
+
+            // Last completion of a removed watch
+            auto retired = m_retired.find(watch);
+            if (retired != m_retired.end())
+            {
+                m_retired.erase(retired);
+                if (!m_isRunning && m_retired.empty())
+                {
+                    break;
+                }
+                continue;
+            }
+
+            if (!success)
+            {
+                // The directory went away (or the share dropped); the watch stays silent until removed
+                std::cerr << "[FileWatcher] Directory read failed: " << GetLastError() << std::endl;
+                continue;
+            }
+
+            // bytesReturned == 0 means the buffer overflowed
+            id = watch->id;
+            overflow = bytesReturned == 0;
+            if (!overflow)
+            {
+                FILE_NOTIFY_INFORMATION* notification = (FILE_NOTIFY_INFORMATION*)watch->buffer.data();
+                while (true)
+                {
+                    changedPaths.emplace_back(notification->FileName, notification->FileNameLength / sizeof(WCHAR));
+                    if (notification->NextEntryOffset == 0)
+                        break;
+                    notification = (FILE_NOTIFY_INFORMATION*)((BYTE*)notification + notification->NextEntryOffset);
+                }
+            }
+
+            // Parsed out of the buffer, so the next read can reuse it right away
+            IssueRead(watch);
+        }
+
+        if (m_handler.onChanges)
+        {
+            m_handler.onChanges(id, std::move(changedPaths), overflow);
+        }
+    }
+
+    std::cout << "[FileWatcher] Watch thread stopped" << std::endl;
+}
+
+} // namespace UFB
+
+#endif // _WIN32
@@ -1,11 +1,10 @@
 #include "google_sheets_manager.h"
+#include "sheets_write_planner.h"
 #include "subscription_manager.h"
 #include "project_config.h"
 #include "utils.h"
 #include <Windows.h>
 #include <ShlObj.h>
-#include <winhttp.h>
-#include <wininet.h>
 #include <iostream>
 #include <sstream>
 #include <fstream>
@@ -13,8 +12,6 @@
 #include <chrono>
 #include <set>
 
-#pragma comment(lib, "winhttp.lib")
-
 namespace {
     // Only these folder types are synced to Google Sheets
     const std::vector<std::string> SYNCED_FOLDER_TYPES = {
@@ -32,6 +29,7 @@ GoogleSheetsManager::GoogleSheetsManager()
     , m_operatingMode("client")
     , m_consecutiveGlobalFailures(0)
     , m_syncRunning(false)
+    , m_httpClient(HttpClient::Create())
 {
 }
 
@@ -61,6 +59,11 @@ void GoogleSheetsManager::SetSubscriptionManager(SubscriptionManager* subscripti
     m_subscriptionManager = subscriptionManager;
 }
 
+void GoogleSheetsManager::SetHttpClient(std::unique_ptr<HttpClient> httpClient)
+{
+    m_httpClient = std::move(httpClient);
+}
+
 void GoogleSheetsManager::SetOperatingMode(const std::string& mode)
 {
     m_operatingMode = mode;
@@ -449,17 +452,33 @@ bool GoogleSheetsManager::DeleteRows(const std::string& spreadsheetId,
                                     const std::string& sheetId,
                                     int startIndex,
                                     int endIndex)
+{
+    return BatchDeleteRows(spreadsheetId, {RowDeletion{sheetId, startIndex, endIndex}});
+}
+
+bool GoogleSheetsManager::BatchDeleteRows(const std::string& spreadsheetId,
+                                         const std::vector<RowDeletion>& deletions)
 {
     if (!m_authManager || !m_authManager->IsAuthenticated()) {
         std::cerr << "[GoogleSheetsManager] Not authenticated" << std::endl;
         return false;
     }
 
+    if (deletions.empty()) {
+        return true;  // Nothing to delete
+    }
+
+    // Requests apply in order, so each tab's ranges must come bottom-up
     json requestBody;
-    requestBody["requests"][0]["deleteDimension"]["range"]["sheetId"] = std::stoi(sheetId);
-    requestBody["requests"][0]["deleteDimension"]["range"]["dimension"] = "ROWS";
-    requestBody["requests"][0]["deleteDimension"]["range"]["startIndex"] = startIndex;
-    requestBody["requests"][0]["deleteDimension"]["range"]["endIndex"] = endIndex;
+    requestBody["requests"] = json::array();
+    for (const auto& deletion : deletions) {
+        json request;
+        request["deleteDimension"]["range"]["sheetId"] = std::stoi(deletion.sheetId);
+        request["deleteDimension"]["range"]["dimension"] = "ROWS";
+        request["deleteDimension"]["range"]["startIndex"] = deletion.startIndex;
+        request["deleteDimension"]["range"]["endIndex"] = deletion.endIndex;
+        requestBody["requests"].push_back(request);
+    }
 
     json response;
     if (!ApiPost(BuildBatchUpdateUrl(spreadsheetId), requestBody, response)) {
@@ -542,25 +561,70 @@ bool GoogleSheetsManager::SyncAllJobs()
     int failureCount = 0;
     int totalJobs = 0;
 
-    for (const auto& job : jobs) {
-        // Skip jobs that are disabled due to errors
-        auto it = m_syncRecords.find(job.jobPath);
-        if (it != m_syncRecords.end() && it->second.disabledDueToErrors) {
-            continue;  // Don't count disabled jobs
+    HttpClientStats statsBefore = m_httpClient ? m_httpClient->GetStats() : HttpClientStats();
+    SheetsSchedulerStats schedulerBefore = m_scheduler.GetStats();
+    auto cycleStart = std::chrono::steady_clock::now();
+
+    // Skip jobs that are disabled due to errors (don't count them)
+    std::vector<std::wstring> jobPaths;
+    std::vector<std::string> cachedFolderIds;
+    {
+        std::lock_guard<std::mutex> lock(m_syncMutex);
+        for (const auto& job : jobs) {
+            auto it = m_syncRecords.find(job.jobPath);
+            if (it != m_syncRecords.end() && it->second.disabledDueToErrors) {
+                continue;
+            }
+            jobPaths.push_back(job.jobPath);
+            if (it != m_syncRecords.end() && !it->second.jobFolderId.empty()) {
+                cachedFolderIds.push_back(it->second.jobFolderId);
+            }
         }
+    }
+    totalJobs = static_cast<int>(jobPaths.size());
 
-        totalJobs++;
+    // Check every cached job folder in one batch up front
+    PrefetchFolderTrashedStates(cachedFolderIds);
 
-        if (SyncJob(job.jobPath)) {
+    // Jobs sync concurrently; the scheduler keeps their requests within the Sheets quotas
+    std::vector<bool> results = m_scheduler.RunJobs(jobPaths.size(), [this, &jobPaths](size_t index) {
+        return SyncJob(jobPaths[index]);
+    });
+    for (bool result : results) {
+        if (result) {
             successCount++;
         } else {
             failureCount++;
         }
     }
 
+    {
+        std::lock_guard<std::mutex> lock(m_syncMutex);
+        m_prefetchedFolderTrashed.clear();
+    }
+
     std::cout << "[GoogleSheetsManager] Sync complete: " << successCount << " succeeded, "
               << failureCount << " failed" << std::endl;
 
+    if (m_httpClient) {
+        HttpClientStats stats = m_httpClient->GetStats();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - cycleStart).count();
+        uint64_t calls = stats.requests - statsBefore.requests;
+        std::cout << "[GoogleSheetsManager] HTTP: " << calls << " calls ("
+                  << (seconds > 0 ? static_cast<uint64_t>(calls / seconds) : calls) << "/s), "
+                  << (stats.connectionsOpened - statsBefore.connectionsOpened) << " new connections, "
+                  << (stats.bytesSent - statsBefore.bytesSent) / 1024 << " KB sent, "
+                  << (stats.bytesReceived - statsBefore.bytesReceived) / 1024 << " KB received ("
+                  << (stats.bytesDecoded - statsBefore.bytesDecoded) / 1024 << " KB decoded)" << std::endl;
+
+        SheetsSchedulerStats scheduler = m_scheduler.GetStats();
+        std::cout << "[GoogleSheetsManager] Quota: " << (scheduler.rateLimited - schedulerBefore.rateLimited) << " rate-limited, "
+                  << (scheduler.serverErrors - schedulerBefore.serverErrors) << " server errors, "
+                  << (scheduler.retries - schedulerBefore.retries) << " retries, "
+                  << (scheduler.quotaWaitMs - schedulerBefore.quotaWaitMs) << " ms waiting for quota ("
+                  << (seconds > 0 ? static_cast<int>(totalJobs * 60 / seconds) : totalJobs) << " jobs/min)" << std::endl;
+    }
+
     // Track consecutive full-cycle failures
     const int GLOBAL_FAILURE_THRESHOLD = 3;
 
@@ -576,6 +640,7 @@ bool GoogleSheetsManager::SyncAllJobs()
             std::cerr << "[GoogleSheetsManager] Re-enable Google Sheets in settings to restart sync" << std::endl;
             StopSyncLoop();
             SetEnabled(false);
+            std::lock_guard<std::mutex> lock(m_syncMutex);
             SaveSyncRecords();
             return false;
         }
@@ -584,6 +649,7 @@ bool GoogleSheetsManager::SyncAllJobs()
         m_consecutiveGlobalFailures = 0;
     }
 
+    std::lock_guard<std::mutex> lock(m_syncMutex);
     SaveSyncRecords();
     return successCount > 0;
 }
@@ -604,61 +670,89 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
         return false;
     }
 
-    std::lock_guard<std::mutex> lock(m_syncMutex);
-
     // Extract job name from path
     size_t lastSlash = jobPath.find_last_of(L"\\/");
     std::wstring jobName = (lastSlash != std::wstring::npos) ? jobPath.substr(lastSlash + 1) : jobPath;
     std::string jobNameUtf8 = WideToUtf8(jobName);
 
+    // Jobs sync concurrently (SyncAllJobs), so the lock only covers the shared records; the job
+    // works on a copy of its record and stores it back when done. One sync per job at a time
+    JobSyncRecord record;
+    bool hasRecord = false;
+    std::string parentFolderId;
+    {
+        std::lock_guard<std::mutex> lock(m_syncMutex);
+        if (!m_jobsSyncing.insert(jobPath).second) {
+            std::cout << "[GoogleSheetsManager] Job '" << jobNameUtf8 << "' is already syncing - skipping" << std::endl;
+            return false;
+        }
+
+        auto it = m_syncRecords.find(jobPath);
+        if (it != m_syncRecords.end()) {
+            record = it->second;
+            hasRecord = true;
+        }
+        parentFolderId = m_parentFolderId;
+    }
+
+    struct SyncingGuard {
+        GoogleSheetsManager* manager;
+        const std::wstring& jobPath;
+        ~SyncingGuard() {
+            std::lock_guard<std::mutex> lock(manager->m_syncMutex);
+            manager->m_jobsSyncing.erase(jobPath);
+        }
+    } syncingGuard{this, jobPath};
+
     // Check if this job is disabled due to too many errors
-    auto it = m_syncRecords.find(jobPath);
-    if (it != m_syncRecords.end() && it->second.disabledDueToErrors) {
+    if (hasRecord && record.disabledDueToErrors) {
         std::cout << "[GoogleSheetsManager] Job '" << jobNameUtf8 << "' is disabled due to errors - skipping" << std::endl;
         return false;
     }
 
     // Validate parent folder ID is set
-    if (m_parentFolderId.empty()) {
+    if (parentFolderId.empty()) {
         std::cerr << "[GoogleSheetsManager] ✗ Parent folder ID required for Google Sheets sync" << std::endl;
         std::cerr << "[GoogleSheetsManager] ✗ Set parent folder ID in Settings → Google Sheets section" << std::endl;
-        if (it != m_syncRecords.end()) {
-            it->second.consecutiveErrorCount++;
-            CheckAndDisableJob(it->second, jobNameUtf8);
+        if (hasRecord) {
+            record.consecutiveErrorCount++;
+            CheckAndDisableJob(record, jobNameUtf8);
+            StoreSyncRecord(record, false);
         }
         return false;
     }
 
-    std::cout << "[GoogleSheetsManager] Parent Folder ID: " << m_parentFolderId << std::endl;
+    std::cout << "[GoogleSheetsManager] Parent Folder ID: " << parentFolderId << std::endl;
 
     // Get or create job folder
     // Check if we have a cached jobFolderId and validate it's not trashed
     std::string jobFolderId;
-    if (it != m_syncRecords.end() && !it->second.jobFolderId.empty()) {
-        std::cout << "[GoogleSheetsManager] Checking cached job folder ID: " << it->second.jobFolderId << std::endl;
-        if (IsFolderTrashed(it->second.jobFolderId)) {
+    if (hasRecord && !record.jobFolderId.empty()) {
+        std::cout << "[GoogleSheetsManager] Checking cached job folder ID: " << record.jobFolderId << std::endl;
+        if (IsFolderTrashed(record.jobFolderId)) {
             std::cout << "[GoogleSheetsManager] Cached folder is trashed - will create new folder" << std::endl;
-            it->second.jobFolderId = "";  // Clear cached ID
+            record.jobFolderId = "";  // Clear cached ID
             jobFolderId = "";
         } else {
             std::cout << "[GoogleSheetsManager] Cached folder is valid - reusing" << std::endl;
-            jobFolderId = it->second.jobFolderId;
+            jobFolderId = record.jobFolderId;
         }
     }
 
     // If no valid cached folder, search or create
     if (jobFolderId.empty()) {
         std::cout << "[GoogleSheetsManager] Getting/creating job folder '" << jobNameUtf8
-                  << "' inside parent folder: " << m_parentFolderId << std::endl;
-        jobFolderId = GetOrCreateJobFolder(jobNameUtf8, m_parentFolderId);
+                  << "' inside parent folder: " << parentFolderId << std::endl;
+        jobFolderId = GetOrCreateJobFolder(jobNameUtf8, parentFolderId);
     }
 
     if (jobFolderId.empty()) {
         std::cerr << "[GoogleSheetsManager] ✗ Failed to get/create job folder: " << jobNameUtf8 << std::endl;
         std::cerr << "[GoogleSheetsManager] ✗ Check that parent folder ID is valid and accessible" << std::endl;
-        if (it != m_syncRecords.end()) {
-            it->second.consecutiveErrorCount++;
-            CheckAndDisableJob(it->second, jobNameUtf8);
+        if (hasRecord) {
+            record.consecutiveErrorCount++;
+            CheckAndDisableJob(record, jobNameUtf8);
+            StoreSyncRecord(record, false);
         }
         return false;
     }
@@ -666,7 +760,7 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
     std::cout << "[GoogleSheetsManager] ✓ Job folder ID: " << jobFolderId << std::endl;
 
     // Create or update job sync record
-    if (it == m_syncRecords.end()) {
+    if (!hasRecord) {
         // New job - create spreadsheet and sheets
         std::cout << "[GoogleSheetsManager] Creating new spreadsheet for job: " << jobNameUtf8 << std::endl;
 
@@ -677,7 +771,7 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
         }
 
         // Create new sync record
-        JobSyncRecord record;
+        record = JobSyncRecord();
         record.jobPath = jobPath;
         record.spreadsheetId = spreadsheet.spreadsheetId;
         record.jobFolderId = jobFolderId;
@@ -706,12 +800,11 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
             }
         }
 
-        m_syncRecords[jobPath] = record;
-        it = m_syncRecords.find(jobPath);
+        hasRecord = true;
     }
 
-    JobSyncRecord& record = it->second;
     record.status = SheetSyncStatus::Syncing;
+    StoreSyncRecord(record, false);
 
     // Build list of folder types to sync from the sync record's sheetIds
     std::vector<std::string> folderTypes;
@@ -741,7 +834,8 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
     }
 
     std::vector<std::vector<SheetRow>> allExistingData;
-    if (!BatchGet(record.spreadsheetId, readRanges, allExistingData)) {
+    bool readSucceeded = BatchGet(record.spreadsheetId, readRanges, allExistingData);
+    if (!readSucceeded) {
         std::cerr << "[GoogleSheetsManager] Failed to batch read existing data" << std::endl;
 
         // Check if this is an old-format spreadsheet (has "Shots" sheet instead of folder-type sheets)
@@ -758,8 +852,11 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
             if (hasOldFormat) {
                 std::cout << "[GoogleSheetsManager] ⚠ Detected old spreadsheet format for job '" << jobNameUtf8
                           << "' - deleting sync record to trigger recreation" << std::endl;
-                m_syncRecords.erase(jobPath);
-                SaveSyncRecords();
+                {
+                    std::lock_guard<std::mutex> lock(m_syncMutex);
+                    m_syncRecords.erase(jobPath);
+                    SaveSyncRecords();
+                }
                 return false;  // Skip this sync, will recreate on next cycle
             }
         }
@@ -775,6 +872,7 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
 
     // ===== BIDIRECTIONAL SYNC: Detect and apply remote changes =====
     SheetsCacheManager* cacheManager = GetOrCreateCacheManager(jobPath);
+    std::map<std::string, SheetTabCache> sheetCacheByType;  // What each tab holds now, for the push diff
 
     for (const std::string& folderType : folderTypes) {
         std::string sheetName = sheetNames[folderType];
@@ -788,36 +886,10 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
 
         for (size_t i = 1; i < existingData.size(); ++i) {  // Skip header
             const SheetRow& row = existingData[i];
-            if (row.cells.size() < 12) continue;  // Need at least columns A-L
-
-            CachedSheetRow cachedRow;
-            // Column A (index 0) is Name - we skip it and use Shot Path as itemPath
-            cachedRow.itemPath = row.cells.size() > 1 ? row.cells[1] : "";
-            cachedRow.itemType = row.cells.size() > 2 ? row.cells[2] : "";
-            cachedRow.folderType = row.cells.size() > 3 ? row.cells[3] : "";
-            cachedRow.status = row.cells.size() > 4 ? row.cells[4] : "";
-            cachedRow.category = row.cells.size() > 5 ? row.cells[5] : "";
-            cachedRow.priority = row.cells.size() > 6 ? row.cells[6] : "";
-            cachedRow.deliveryDate = row.cells.size() > 7 ? row.cells[7] : "";
-            cachedRow.assignedArtist = row.cells.size() > 8 ? row.cells[8] : "";
-            cachedRow.notes = row.cells.size() > 9 ? row.cells[9] : "";
-            cachedRow.clientApproval = row.cells.size() > 10 ? row.cells[10] : "";
-            cachedRow.modifiedTimeStr = row.cells.size() > 11 ? row.cells[11] : "";
-
-            // Parse tracking columns M, N, O
-            if (row.cells.size() > 12) {
-                try { cachedRow.modifiedTime = std::stoull(row.cells[12]); } catch (...) { cachedRow.modifiedTime = 0; }
-            }
-            if (row.cells.size() > 13) {
-                try { cachedRow.syncedTime = std::stoull(row.cells[13]); } catch (...) { cachedRow.syncedTime = 0; }
-            }
-            if (row.cells.size() > 14) {
-                cachedRow.deviceId = row.cells[14];
-            }
+            if (!IsItemRow(row)) continue;  // Need at least columns A-L and a Shot Path
 
-            if (!cachedRow.itemPath.empty()) {
-                newCache.rows[cachedRow.itemPath] = cachedRow;
-            }
+            CachedSheetRow cachedRow = ToCachedSheetRow(row);
+            newCache.rows[cachedRow.itemPath] = cachedRow;
         }
 
         // Load old cache for change detection
@@ -843,13 +915,25 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
 
         // Don't save cache here - we'll save it AFTER the push phase
         // (so it reflects the data we actually pushed, including updated modifiedTime)
+        sheetCacheByType[folderType] = std::move(newCache);
     }
 
-    // Prepare batch write operations and cache data for after push
+    // ===== MINIMAL-DIFF PUSH: Write only what differs from the tabs as just read =====
+    // Each tab is diffed against the local rows; changed cells from all tabs go out in one
+    // values:batchUpdate, deleted rows in one batchUpdate of deleteDimension requests
     std::vector<CellUpdate> batchUpdates;
+    std::vector<RowDeletion> rowDeletions;
     std::map<std::string, std::vector<SheetRow>> pushedDataByType;  // Store for cache saving
+    int rowsUpdated = 0;
+    int rowsAppended = 0;
+    int rowsDeleted = 0;
+    size_t cellsWritten = 0;
 
     for (const std::string& folderType : folderTypes) {
+        if (!readSucceeded) {
+            break;  // Without the tabs' current contents there's nothing to diff against
+        }
+
         std::string sheetName = sheetNames[folderType];
         std::string sheetId = record.sheetIds[folderType];
 
@@ -862,93 +946,73 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
         // (PULL phase already applied any remote Sheets changes to local)
         std::vector<SheetRow> rows = ConvertJobToSheetRows(jobPath, folderType);
 
-        // Store for cache saving after push
-        pushedDataByType[folderType] = rows;
-
-        // Add to batch update (will clear and write all sheets in one batch)
-        if (true) {  // Always clear and rewrite, even if empty (clears deleted items)
-            CellUpdate update;
-            update.range = sheetName + "!A2:O";
-
-            // Convert SheetRow to vector<vector<string>>
-            for (const auto& row : rows) {
-                update.values.push_back(row.cells);
+        SheetTabCache localCache;
+        for (const auto& row : rows) {
+            CachedSheetRow cachedRow = ToCachedSheetRow(row);
+            if (!cachedRow.itemPath.empty()) {
+                localCache.rows[cachedRow.itemPath] = cachedRow;
             }
-
-            // If empty, still add empty update to clear the sheet
-            batchUpdates.push_back(update);
-            totalRowsSynced += rows.size();
         }
 
-        std::cout << "[GoogleSheetsManager] Prepared " << rows.size() << " rows for " << sheetName << std::endl;
-    }
+        const std::vector<SheetRow>& existingData = existingDataByType[folderType];
+        SheetRowIndex rowIndex(existingData);
+        auto changes = cacheManager->DetectChanges(sheetCacheByType[folderType], localCache);
+        SheetWritePlan plan = PlanSheetWrites(sheetName, sheetId, existingData, rowIndex, rows, changes);
 
-    // ===== BATCH CLEAR & WRITE: Clear and write all 4 tabs (2 API calls instead of 8) =====
-    if (!batchUpdates.empty()) {
-        // Step 1: Batch clear all ranges (1 API call)
-        std::vector<std::string> clearRanges;
-        for (const auto& update : batchUpdates) {
-            clearRanges.push_back(update.range);
-        }
-
-        if (!BatchClear(record.spreadsheetId, clearRanges)) {
-            std::cerr << "[GoogleSheetsManager] Failed to batch clear ranges" << std::endl;
-            allSucceeded = false;
-        }
-
-        // Step 2: Batch write all data (1 API call)
-        if (allSucceeded && !BatchUpdate(record.spreadsheetId, batchUpdates)) {
-            std::cerr << "[GoogleSheetsManager] Failed to batch write data" << std::endl;
-            allSucceeded = false;
-        }
+        batchUpdates.insert(batchUpdates.end(), plan.updates.begin(), plan.updates.end());
+        rowDeletions.insert(rowDeletions.end(), plan.deletions.begin(), plan.deletions.end());
+        rowsUpdated += plan.rowsUpdated;
+        rowsAppended += plan.rowsAppended;
+        rowsDeleted += plan.rowsDeleted;
+        cellsWritten += plan.cellsWritten;
+        totalRowsSynced += rows.size();
 
-        if (allSucceeded) {
-            std::cout << "[GoogleSheetsManager] ✓ Synced " << totalRowsSynced
-                      << " total rows across " << batchUpdates.size() << " sheets (3 API calls: 1 batchGet + 1 batchClear + 1 batchUpdate)" << std::endl;
+        std::cout << "[GoogleSheetsManager] Planned " << sheetName << ": " << plan.rowsUpdated << " updated, "
+                  << plan.rowsAppended << " appended, " << plan.rowsDeleted << " deleted ("
+                  << plan.updates.size() << " ranges, " << plan.cellsWritten << " cells) of " << rows.size() << " rows" << std::endl;
 
-            // Save caches with the data we just pushed (includes updated modifiedTime)
-            for (const auto& [folderType, rows] : pushedDataByType) {
-                std::string sheetName = sheetNames[folderType];
+        // Store for cache saving after push
+        pushedDataByType[folderType] = std::move(rows);
+    }
 
-                // Build cache from pushed data
-                SheetTabCache pushedCache;
-                pushedCache.spreadsheetId = record.spreadsheetId;
-                pushedCache.tabName = sheetName;
-                pushedCache.lastSyncTime = GetCurrentTimestamp();
+    // Deletions first: the update ranges address the tabs with those rows already gone
+    if (!rowDeletions.empty() && !BatchDeleteRows(record.spreadsheetId, rowDeletions)) {
+        std::cerr << "[GoogleSheetsManager] Failed to batch delete rows" << std::endl;
+        allSucceeded = false;
+    }
 
-                for (const auto& row : rows) {
-                    if (row.cells.size() < 2) continue;
+    if (allSucceeded && !batchUpdates.empty() && !BatchUpdate(record.spreadsheetId, batchUpdates)) {
+        std::cerr << "[GoogleSheetsManager] Failed to batch write data" << std::endl;
+        allSucceeded = false;
+    }
 
-                    CachedSheetRow cachedRow;
-                    cachedRow.itemPath = row.cells.size() > 1 ? row.cells[1] : "";
-                    cachedRow.itemType = row.cells.size() > 2 ? row.cells[2] : "";
-                    cachedRow.folderType = row.cells.size() > 3 ? row.cells[3] : "";
-                    cachedRow.status = row.cells.size() > 4 ? row.cells[4] : "";
-                    cachedRow.category = row.cells.size() > 5 ? row.cells[5] : "";
-                    cachedRow.priority = row.cells.size() > 6 ? row.cells[6] : "";
-                    cachedRow.deliveryDate = row.cells.size() > 7 ? row.cells[7] : "";
-                    cachedRow.assignedArtist = row.cells.size() > 8 ? row.cells[8] : "";
-                    cachedRow.notes = row.cells.size() > 9 ? row.cells[9] : "";
-                    cachedRow.clientApproval = row.cells.size() > 10 ? row.cells[10] : "";
-                    cachedRow.modifiedTimeStr = row.cells.size() > 11 ? row.cells[11] : "";
+    if (allSucceeded) {
+        int apiCalls = 1 + (rowDeletions.empty() ? 0 : 1) + (batchUpdates.empty() ? 0 : 1);
+        std::cout << "[GoogleSheetsManager] ✓ Synced " << totalRowsSynced << " total rows across " << pushedDataByType.size()
+                  << " sheets: " << rowsUpdated << " updated, " << rowsAppended << " appended, " << rowsDeleted
+                  << " deleted, " << cellsWritten << " cells in " << batchUpdates.size() << " ranges ("
+                  << apiCalls << " API calls)" << std::endl;
+
+        // Save caches with the data we just pushed (includes updated modifiedTime)
+        for (const auto& [folderType, rows] : pushedDataByType) {
+            std::string sheetName = sheetNames[folderType];
+
+            // Build cache from pushed data
+            SheetTabCache pushedCache;
+            pushedCache.spreadsheetId = record.spreadsheetId;
+            pushedCache.tabName = sheetName;
+            pushedCache.lastSyncTime = GetCurrentTimestamp();
 
-                    if (row.cells.size() > 12) {
-                        try { cachedRow.modifiedTime = std::stoull(row.cells[12]); } catch (...) { cachedRow.modifiedTime = 0; }
-                    }
-                    if (row.cells.size() > 13) {
-                        try { cachedRow.syncedTime = std::stoull(row.cells[13]); } catch (...) { cachedRow.syncedTime = 0; }
-                    }
-                    if (row.cells.size() > 14) {
-                        cachedRow.deviceId = row.cells[14];
-                    }
+            for (const auto& row : rows) {
+                if (row.cells.size() < 2) continue;
 
-                    if (!cachedRow.itemPath.empty()) {
-                        pushedCache.rows[cachedRow.itemPath] = cachedRow;
-                    }
+                CachedSheetRow cachedRow = ToCachedSheetRow(row);
+                if (!cachedRow.itemPath.empty()) {
+                    pushedCache.rows[cachedRow.itemPath] = cachedRow;
                 }
-
-                cacheManager->SaveCache(pushedCache);
             }
+
+            cacheManager->SaveCache(pushedCache);
         }
     }
 
@@ -960,14 +1024,14 @@ bool GoogleSheetsManager::SyncJob(const std::wstring& jobPath)
         record.disabledDueToErrors = false;
         std::cout << "[GoogleSheetsManager] ✓ Successfully synced job '" << jobNameUtf8
                   << "' (" << totalRowsSynced << " total rows)" << std::endl;
-        SaveSyncRecords();
+        StoreSyncRecord(record, true);
         return true;
     } else {
         record.status = SheetSyncStatus::Error;
         record.consecutiveErrorCount++;
         CheckAndDisableJob(record, jobNameUtf8);
         std::cerr << "[GoogleSheetsManager] ✗ Failed to sync job '" << jobNameUtf8 << "'" << std::endl;
-        SaveSyncRecords();
+        StoreSyncRecord(record, true);
         return false;
     }
 }
@@ -1029,9 +1093,12 @@ void GoogleSheetsManager::StopSyncLoop()
         m_syncRunning = false;
         m_syncCV.notify_all();
 
+        // Requests waiting for quota or backoff give up instead of holding up the join
+        m_scheduler.Cancel();
         if (m_syncThread.joinable()) {
             m_syncThread.join();
         }
+        m_scheduler.Resume();
 
         std::cout << "[GoogleSheetsManager] Stopped sync loop" << std::endl;
     }
@@ -1387,560 +1454,125 @@ bool GoogleSheetsManager::SaveSyncRecords()
     return true;
 }
 
-bool GoogleSheetsManager::ApiGet(const std::string& endpoint, json& outResponse)
+bool GoogleSheetsManager::BuildApiRequest(const std::string& method, const std::string& endpoint,
+                                          const std::string& body, HttpRequest& outRequest)
 {
-    std::cout << "[ApiGet] Called with endpoint: " << endpoint << std::endl;
-    std::cout.flush();
-
-    try {
-        if (!m_authManager) {
-            std::cerr << "[ApiGet] No auth manager" << std::endl;
-            std::cerr.flush();
-            return false;
-        }
-
-        std::cout << "[ApiGet] Getting access token..." << std::endl;
-        std::cout.flush();
-        std::string accessToken = m_authManager->GetAccessToken();
-        if (accessToken.empty()) {
-            std::cerr << "[ApiGet] Access token is empty" << std::endl;
-            std::cerr.flush();
-            return false;
-        }
-
-        std::cout << "[ApiGet] Parsing URL..." << std::endl;
-        std::cout.flush();
-
-        // Parse URL using WinHTTP functions
-        std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-        std::wstring wendpoint = converter.from_bytes(endpoint);
-
-        std::cout << "[ApiGet] URL converted to wide string" << std::endl;
-        std::cout.flush();
-
-    URL_COMPONENTS urlComponents = {0};
-    urlComponents.dwStructSize = sizeof(urlComponents);
-
-    wchar_t hostname[256] = {0};
-    wchar_t path[1024] = {0};
-
-    urlComponents.lpszHostName = hostname;
-    urlComponents.dwHostNameLength = sizeof(hostname) / sizeof(wchar_t);
-    urlComponents.lpszUrlPath = path;
-    urlComponents.dwUrlPathLength = sizeof(path) / sizeof(wchar_t);
-
-    if (!WinHttpCrackUrl(wendpoint.c_str(), 0, 0, &urlComponents)) {
-        return false;
-    }
-
-    HINTERNET hSession = WinHttpOpen(L"UFB/1.0",
-                                     WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                     WINHTTP_NO_PROXY_NAME,
-                                     WINHTTP_NO_PROXY_BYPASS,
-                                     0);
-    if (!hSession) {
+    if (!m_authManager) {
+        std::cerr << "[GoogleSheetsManager] No auth manager" << std::endl;
         return false;
     }
 
-    HINTERNET hConnect = WinHttpConnect(hSession,
-                                       hostname,
-                                       urlComponents.nPort,
-                                       0);
-    if (!hConnect) {
-        WinHttpCloseHandle(hSession);
-        return false;
-    }
-    HINTERNET hRequest = WinHttpOpenRequest(hConnect,
-                                           L"GET",
-                                           path,
-                                           nullptr,
-                                           WINHTTP_NO_REFERER,
-                                           WINHTTP_DEFAULT_ACCEPT_TYPES,
-                                           WINHTTP_FLAG_SECURE);
-    if (!hRequest) {
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
+    std::string accessToken = m_authManager->GetAccessToken();
+    if (accessToken.empty()) {
+        std::cerr << "[GoogleSheetsManager] Access token is empty" << std::endl;
         return false;
     }
 
-    std::wstring authHeader = converter.from_bytes("Authorization: Bearer " + accessToken);
-    WinHttpAddRequestHeaders(hRequest, authHeader.c_str(), -1, WINHTTP_ADDREQ_FLAG_ADD);
-
-    bool success = WinHttpSendRequest(hRequest,
-                                     WINHTTP_NO_ADDITIONAL_HEADERS,
-                                     0,
-                                     WINHTTP_NO_REQUEST_DATA,
-                                     0,
-                                     0,
-                                     0);
-
-    if (success) {
-        success = WinHttpReceiveResponse(hRequest, nullptr);
-    }
-
-    if (success) {
-        DWORD bytesAvailable = 0;
-        std::string response;
-
-        do {
-            bytesAvailable = 0;
-            if (WinHttpQueryDataAvailable(hRequest, &bytesAvailable)) {
-                if (bytesAvailable > 0) {
-                    std::vector<char> buffer(bytesAvailable + 1);
-                    DWORD bytesRead = 0;
-
-                    if (WinHttpReadData(hRequest, buffer.data(), bytesAvailable, &bytesRead)) {
-                        buffer[bytesRead] = 0;
-                        response += buffer.data();
-                    }
-                }
-            }
-        } while (bytesAvailable > 0);
-
-        try {
-            outResponse = json::parse(response);
-        }
-        catch (const std::exception& e) {
-            std::cerr << "[GoogleSheetsManager] Failed to parse response: " << e.what() << std::endl;
-            success = false;
-        }
-    }
-
-        WinHttpCloseHandle(hRequest);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-
-        return success;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "[ApiGet] Exception: " << e.what() << std::endl;
-        std::cerr.flush();
-        return false;
-    }
-    catch (...) {
-        std::cerr << "[ApiGet] Unknown exception" << std::endl;
-        std::cerr.flush();
-        return false;
+    outRequest.method = method;
+    outRequest.url = endpoint;
+    outRequest.headers = { "Authorization: Bearer " + accessToken };
+    if (method != "GET") {
+        outRequest.headers.push_back("Content-Type: application/json");
     }
+    outRequest.body = body;
+    return true;
 }
 
-bool GoogleSheetsManager::ApiPost(const std::string& endpoint, const json& requestBody, json& outResponse)
+bool GoogleSheetsManager::ApiRequest(const std::string& method, const std::string& endpoint, const std::string& body,
+                                     json& outResponse, int& outStatusCode)
 {
-    std::cout << "[ApiPost] Called with endpoint: " << endpoint << std::endl;
-    std::cout.flush();
-
-    try {
-        if (!m_authManager) {
-            std::cerr << "[ApiPost] No auth manager" << std::endl;
-            std::cerr.flush();
-            return false;
-        }
-
-        std::cout << "[ApiPost] Getting access token..." << std::endl;
-        std::cout.flush();
-        std::string accessToken = m_authManager->GetAccessToken();
-        if (accessToken.empty()) {
-            std::cerr << "[ApiPost] Access token is empty" << std::endl;
-            std::cerr.flush();
-            return false;
-        }
+    outStatusCode = 0;
 
-        std::cout << "[ApiPost] Dumping request body..." << std::endl;
-        std::cout.flush();
-        std::string postData = requestBody.dump();
-
-        std::cout << "[ApiPost] Parsing URL..." << std::endl;
-        std::cout.flush();
-
-    // Parse URL using WinHTTP functions
-    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-    std::wstring wendpoint = converter.from_bytes(endpoint);
-
-    URL_COMPONENTS urlComponents = {0};
-    urlComponents.dwStructSize = sizeof(urlComponents);
-
-    wchar_t hostname[256] = {0};
-    wchar_t path[1024] = {0};
-
-    urlComponents.lpszHostName = hostname;
-    urlComponents.dwHostNameLength = sizeof(hostname) / sizeof(wchar_t);
-    urlComponents.lpszUrlPath = path;
-    urlComponents.dwUrlPathLength = sizeof(path) / sizeof(wchar_t);
-
-    if (!WinHttpCrackUrl(wendpoint.c_str(), 0, 0, &urlComponents)) {
-        return false;
-    }
-
-    HINTERNET hSession = WinHttpOpen(L"UFB/1.0",
-                                     WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                     WINHTTP_NO_PROXY_NAME,
-                                     WINHTTP_NO_PROXY_BYPASS,
-                                     0);
-    if (!hSession) {
+    HttpRequest request;
+    if (!m_httpClient || !BuildApiRequest(method, endpoint, body, request)) {
         return false;
     }
 
-    HINTERNET hConnect = WinHttpConnect(hSession,
-                                       hostname,
-                                       urlComponents.nPort,
-                                       0);
-    if (!hConnect) {
-        WinHttpCloseHandle(hSession);
-        return false;
-    }
-    HINTERNET hRequest = WinHttpOpenRequest(hConnect,
-                                           L"POST",
-                                           path,
-                                           nullptr,
-                                           WINHTTP_NO_REFERER,
-                                           WINHTTP_DEFAULT_ACCEPT_TYPES,
-                                           WINHTTP_FLAG_SECURE);
-    if (!hRequest) {
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
+    HttpResponse response;
+    if (!m_scheduler.Execute(*m_httpClient, request, response)) {
+        std::cerr << "[GoogleSheetsManager] " << method << " request failed: " << endpoint << std::endl;
         return false;
     }
+    outStatusCode = response.statusCode;
 
-    std::wstring authHeader = converter.from_bytes("Authorization: Bearer " + accessToken);
-    WinHttpAddRequestHeaders(hRequest, authHeader.c_str(), -1, WINHTTP_ADDREQ_FLAG_ADD);
-    WinHttpAddRequestHeaders(hRequest, L"Content-Type: application/json", -1, WINHTTP_ADDREQ_FLAG_ADD);
-
-    bool success = WinHttpSendRequest(hRequest,
-                                     WINHTTP_NO_ADDITIONAL_HEADERS,
-                                     0,
-                                     (LPVOID)postData.c_str(),
-                                     (DWORD)postData.length(),
-                                     (DWORD)postData.length(),
-                                     0);
-
-    if (success) {
-        success = WinHttpReceiveResponse(hRequest, nullptr);
-    }
-
-    DWORD statusCode = 0;
-    if (success) {
-        // Check HTTP status code
-        DWORD statusCodeSize = sizeof(statusCode);
-        WinHttpQueryHeaders(hRequest,
-                           WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
-                           WINHTTP_HEADER_NAME_BY_INDEX,
-                           &statusCode,
-                           &statusCodeSize,
-                           WINHTTP_NO_HEADER_INDEX);
-
-        DWORD bytesAvailable = 0;
-        std::string response;
-
-        do {
-            bytesAvailable = 0;
-            if (WinHttpQueryDataAvailable(hRequest, &bytesAvailable)) {
-                if (bytesAvailable > 0) {
-                    std::vector<char> buffer(bytesAvailable + 1);
-                    DWORD bytesRead = 0;
-
-                    if (WinHttpReadData(hRequest, buffer.data(), bytesAvailable, &bytesRead)) {
-                        buffer[bytesRead] = 0;
-                        response += buffer.data();
-                    }
-                }
-            }
-        } while (bytesAvailable > 0);
-
-        try {
-            outResponse = json::parse(response);
-
-            // Check for rate limiting (HTTP 429)
-            if (statusCode == 429) {
-                std::cerr << "[ApiPost] Rate limit exceeded (HTTP 429)" << std::endl;
-                if (outResponse.contains("error") && outResponse["error"].contains("message")) {
-                    std::cerr << "[ERROR] " << outResponse["error"].dump(2) << std::endl;
-                }
-                success = false;
-            }
-            else if (statusCode >= 400) {
-                std::cerr << "[ApiPost] HTTP error " << statusCode << std::endl;
-                if (outResponse.contains("error")) {
-                    std::cerr << "[ERROR] " << outResponse["error"].dump(2) << std::endl;
-                }
-                success = false;
-            }
-        }
-        catch (const std::exception& e) {
-            std::cerr << "[GoogleSheetsManager] Failed to parse response: " << e.what() << std::endl;
-            success = false;
-        }
-    }
-
-        WinHttpCloseHandle(hRequest);
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-
-        // Retry logic for rate limiting (HTTP 429)
-        static thread_local int retryCount = 0; // Thread-local to avoid interference
-        if (!success && statusCode == 429) {
-            const int maxRetries = 4;
-            const int baseDelay = 5; // 5 seconds
-
-            if (retryCount < maxRetries) {
-                int delay = baseDelay * (1 << retryCount); // Exponential backoff: 5, 10, 20, 40
-                retryCount++;
-                std::cout << "[ApiPost] Rate limited. Retry " << retryCount << "/" << maxRetries
-                         << " after " << delay << " seconds..." << std::endl;
-
-                std::this_thread::sleep_for(std::chrono::seconds(delay));
-
-                // Recursive retry
-                return ApiPost(endpoint, requestBody, outResponse);
-            } else {
-                std::cerr << "[ApiPost] Max retries (" << maxRetries << ") exceeded for rate limiting" << std::endl;
-                retryCount = 0; // Reset for next operation
-                return false;
-            }
-        } else {
-            // Reset retry count on success or non-429 errors
-            retryCount = 0;
-        }
-
-        return success;
+    try {
+        outResponse = json::parse(response.body);
     }
     catch (const std::exception& e) {
-        std::cerr << "[ApiPost] Exception: " << e.what() << std::endl;
-        std::cerr.flush();
-        return false;
-    }
-    catch (...) {
-        std::cerr << "[ApiPost] Unknown exception" << std::endl;
-        std::cerr.flush();
+        std::cerr << "[GoogleSheetsManager] Failed to parse response: " << e.what() << std::endl;
         return false;
     }
+    return true;
 }
 
-bool GoogleSheetsManager::ApiPut(const std::string& endpoint, const json& requestBody, json& outResponse)
+void GoogleSheetsManager::ApiGetBatch(const std::vector<std::string>& endpoints, std::vector<json>& outResponses,
+                                      std::vector<bool>& outSuccess)
 {
-    if (!m_authManager) {
-        return false;
-    }
-
-    std::string accessToken = m_authManager->GetAccessToken();
-    if (accessToken.empty()) {
-        return false;
-    }
-
-    std::string postData = requestBody.dump();
-
-    URL_COMPONENTSA urlComponents = {0};
-    urlComponents.dwStructSize = sizeof(urlComponents);
-
-    char hostname[256] = {0};
-    char path[1024] = {0};
-
-    urlComponents.lpszHostName = hostname;
-    urlComponents.dwHostNameLength = sizeof(hostname);
-    urlComponents.lpszUrlPath = path;
-    urlComponents.dwUrlPathLength = sizeof(path);
-
-    if (!InternetCrackUrlA(endpoint.c_str(), 0, 0, &urlComponents)) {
-        return false;
-    }
-
-    HINTERNET hSession = WinHttpOpen(L"UFB/1.0",
-                                     WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                     WINHTTP_NO_PROXY_NAME,
-                                     WINHTTP_NO_PROXY_BYPASS,
-                                     0);
-    if (!hSession) {
-        return false;
-    }
+    outResponses.assign(endpoints.size(), json());
+    outSuccess.assign(endpoints.size(), false);
 
-    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-    std::wstring whostname = converter.from_bytes(hostname);
-
-    HINTERNET hConnect = WinHttpConnect(hSession,
-                                       whostname.c_str(),
-                                       urlComponents.nPort,
-                                       0);
-    if (!hConnect) {
-        WinHttpCloseHandle(hSession);
-        return false;
-    }
-
-    std::wstring wpath = converter.from_bytes(path);
-    HINTERNET hRequest = WinHttpOpenRequest(hConnect,
-                                           L"PUT",
-                                           wpath.c_str(),
-                                           nullptr,
-                                           WINHTTP_NO_REFERER,
-                                           WINHTTP_DEFAULT_ACCEPT_TYPES,
-                                           WINHTTP_FLAG_SECURE);
-    if (!hRequest) {
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return false;
-    }
-
-    std::wstring authHeader = converter.from_bytes("Authorization: Bearer " + accessToken);
-    WinHttpAddRequestHeaders(hRequest, authHeader.c_str(), -1, WINHTTP_ADDREQ_FLAG_ADD);
-    WinHttpAddRequestHeaders(hRequest, L"Content-Type: application/json", -1, WINHTTP_ADDREQ_FLAG_ADD);
-
-    bool success = WinHttpSendRequest(hRequest,
-                                     WINHTTP_NO_ADDITIONAL_HEADERS,
-                                     0,
-                                     (LPVOID)postData.c_str(),
-                                     (DWORD)postData.length(),
-                                     (DWORD)postData.length(),
-                                     0);
-
-    if (success) {
-        success = WinHttpReceiveResponse(hRequest, nullptr);
+    std::vector<HttpRequest> requests(endpoints.size());
+    for (size_t i = 0; i < endpoints.size(); i++) {
+        if (!m_httpClient || !BuildApiRequest("GET", endpoints[i], std::string(), requests[i])) {
+            return;
+        }
     }
 
-    if (success) {
-        DWORD bytesAvailable = 0;
-        std::string response;
-
-        do {
-            bytesAvailable = 0;
-            if (WinHttpQueryDataAvailable(hRequest, &bytesAvailable)) {
-                if (bytesAvailable > 0) {
-                    std::vector<char> buffer(bytesAvailable + 1);
-                    DWORD bytesRead = 0;
-
-                    if (WinHttpReadData(hRequest, buffer.data(), bytesAvailable, &bytesRead)) {
-                        buffer[bytesRead] = 0;
-                        response += buffer.data();
-                    }
-                }
-            }
-        } while (bytesAvailable > 0);
+    std::vector<HttpResponse> responses;
+    std::vector<bool> sent = m_scheduler.ExecuteBatch(*m_httpClient, requests, responses);
 
+    for (size_t i = 0; i < endpoints.size(); i++) {
+        if (!sent[i]) {
+            continue;
+        }
         try {
-            outResponse = json::parse(response);
+            outResponses[i] = json::parse(responses[i].body);
+            outSuccess[i] = true;
         }
         catch (const std::exception& e) {
             std::cerr << "[GoogleSheetsManager] Failed to parse response: " << e.what() << std::endl;
-            success = false;
         }
     }
-
-    WinHttpCloseHandle(hRequest);
-    WinHttpCloseHandle(hConnect);
-    WinHttpCloseHandle(hSession);
-
-    return success;
 }
 
-bool GoogleSheetsManager::ApiPatch(const std::string& endpoint, const json& requestBody, json& outResponse)
+bool GoogleSheetsManager::ApiGet(const std::string& endpoint, json& outResponse)
 {
-    if (!m_authManager) {
-        return false;
-    }
-
-    std::string accessToken = m_authManager->GetAccessToken();
-    if (accessToken.empty()) {
-        return false;
-    }
-
-    std::string postData = requestBody.dump();
-
-    // Parse URL using WinHTTP functions
-    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-    std::wstring wendpoint = converter.from_bytes(endpoint);
-
-    URL_COMPONENTS urlComponents = {0};
-    urlComponents.dwStructSize = sizeof(urlComponents);
-
-    wchar_t hostname[256] = {0};
-    wchar_t path[1024] = {0};
-
-    urlComponents.lpszHostName = hostname;
-    urlComponents.dwHostNameLength = sizeof(hostname) / sizeof(wchar_t);
-    urlComponents.lpszUrlPath = path;
-    urlComponents.dwUrlPathLength = sizeof(path) / sizeof(wchar_t);
+    std::cout << "[ApiGet] Called with endpoint: " << endpoint << std::endl;
 
-    if (!WinHttpCrackUrl(wendpoint.c_str(), 0, 0, &urlComponents)) {
-        return false;
-    }
+    int statusCode = 0;
+    return ApiRequest("GET", endpoint, std::string(), outResponse, statusCode);
+}
 
-    HINTERNET hSession = WinHttpOpen(L"UFB/1.0",
-                                     WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                     WINHTTP_NO_PROXY_NAME,
-                                     WINHTTP_NO_PROXY_BYPASS,
-                                     0);
-    if (!hSession) {
-        return false;
-    }
+bool GoogleSheetsManager::ApiPost(const std::string& endpoint, const json& requestBody, json& outResponse)
+{
+    std::cout << "[ApiPost] Called with endpoint: " << endpoint << std::endl;
 
-    HINTERNET hConnect = WinHttpConnect(hSession,
-                                       hostname,
-                                       urlComponents.nPort,
-                                       0);
-    if (!hConnect) {
-        WinHttpCloseHandle(hSession);
+    // Rate limiting (HTTP 429) is retried with backoff by m_scheduler; what's left is an error
+    int statusCode = 0;
+    if (!ApiRequest("POST", endpoint, requestBody.dump(), outResponse, statusCode)) {
         return false;
     }
-    HINTERNET hRequest = WinHttpOpenRequest(hConnect,
-                                           L"PATCH",
-                                           path,
-                                           nullptr,
-                                           WINHTTP_NO_REFERER,
-                                           WINHTTP_DEFAULT_ACCEPT_TYPES,
-                                           WINHTTP_FLAG_SECURE);
-    if (!hRequest) {
-        WinHttpCloseHandle(hConnect);
-        WinHttpCloseHandle(hSession);
-        return false;
-    }
-
-    std::wstring authHeader = converter.from_bytes("Authorization: Bearer " + accessToken);
-    WinHttpAddRequestHeaders(hRequest, authHeader.c_str(), -1, WINHTTP_ADDREQ_FLAG_ADD);
-    WinHttpAddRequestHeaders(hRequest, L"Content-Type: application/json", -1, WINHTTP_ADDREQ_FLAG_ADD);
-
-    bool success = WinHttpSendRequest(hRequest,
-                                     WINHTTP_NO_ADDITIONAL_HEADERS,
-                                     0,
-                                     (LPVOID)postData.c_str(),
-                                     (DWORD)postData.length(),
-                                     (DWORD)postData.length(),
-                                     0);
-
-    if (success) {
-        success = WinHttpReceiveResponse(hRequest, nullptr);
-    }
-
-    if (success) {
-        DWORD bytesAvailable = 0;
-        std::string response;
 
-        do {
-            bytesAvailable = 0;
-            if (WinHttpQueryDataAvailable(hRequest, &bytesAvailable)) {
-                if (bytesAvailable > 0) {
-                    std::vector<char> buffer(bytesAvailable + 1);
-                    DWORD bytesRead = 0;
-
-                    if (WinHttpReadData(hRequest, buffer.data(), bytesAvailable, &bytesRead)) {
-                        buffer[bytesRead] = 0;
-                        response += buffer.data();
-                    }
-                }
-            }
-        } while (bytesAvailable > 0);
-
-        try {
-            outResponse = json::parse(response);
-            success = true;
-        }
-        catch (const std::exception& e) {
-            std::cerr << "[GoogleSheetsManager] Failed to parse response: " << e.what() << std::endl;
-            success = false;
+    if (statusCode >= 400) {
+        std::cerr << "[ApiPost] HTTP error " << statusCode << std::endl;
+        if (outResponse.contains("error")) {
+            std::cerr << "[ERROR] " << outResponse["error"].dump(2) << std::endl;
         }
+        return false;
     }
+    return true;
+}
 
-    WinHttpCloseHandle(hRequest);
-    WinHttpCloseHandle(hConnect);
-    WinHttpCloseHandle(hSession);
+bool GoogleSheetsManager::ApiPut(const std::string& endpoint, const json& requestBody, json& outResponse)
+{
+    int statusCode = 0;
+    return ApiRequest("PUT", endpoint, requestBody.dump(), outResponse, statusCode);
+}
 
-    return success;
+bool GoogleSheetsManager::ApiPatch(const std::string& endpoint, const json& requestBody, json& outResponse)
+{
+    int statusCode = 0;
+    return ApiRequest("PATCH", endpoint, requestBody.dump(), outResponse, statusCode);
 }
 
 bool GoogleSheetsManager::ApiDelete(const std::string& endpoint, json& outResponse)
@@ -2071,6 +1703,25 @@ bool GoogleSheetsManager::IsFolderTrashed(const std::string& folderId)
         return true;  // Fail-safe: treat as trashed if can't verify
     }
 
+    // Already fetched with the rest of this sync cycle's folders
+    bool isPrefetched = false;
+    bool isTrashed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_syncMutex);
+        auto prefetched = m_prefetchedFolderTrashed.find(folderId);
+        if (prefetched != m_prefetchedFolderTrashed.end()) {
+            isPrefetched = true;
+            isTrashed = prefetched->second;
+            m_prefetchedFolderTrashed.erase(prefetched);
+        }
+    }
+    if (isPrefetched) {
+        if (isTrashed) {
+            std::cout << "[GoogleSheetsManager] Folder is trashed (ID: " << folderId << ")" << std::endl;
+        }
+        return isTrashed;
+    }
+
     // Query Drive API to check if folder is trashed
     std::string endpoint = "https://www.googleapis.com/drive/v3/files/" + folderId + "?fields=trashed&supportsAllDrives=true";
     json response;
@@ -2092,6 +1743,32 @@ bool GoogleSheetsManager::IsFolderTrashed(const std::string& folderId)
     return false;
 }
 
+void GoogleSheetsManager::PrefetchFolderTrashedStates(const std::vector<std::string>& folderIds)
+{
+    if (folderIds.empty()) {
+        return;
+    }
+
+    std::vector<std::string> endpoints;
+    for (const auto& folderId : folderIds) {
+        endpoints.push_back("https://www.googleapis.com/drive/v3/files/" + folderId + "?fields=trashed&supportsAllDrives=true");
+    }
+
+    // One batch instead of a round trip per job; failures are left for IsFolderTrashed to retry
+    std::vector<json> responses;
+    std::vector<bool> success;
+    ApiGetBatch(endpoints, responses, success);
+
+    std::lock_guard<std::mutex> lock(m_syncMutex);
+    for (size_t i = 0; i < folderIds.size(); i++) {
+        if (!success[i] || responses[i].contains("error")) {
+            continue;
+        }
+        m_prefetchedFolderTrashed[folderIds[i]] =
+            responses[i].contains("trashed") && responses[i]["trashed"].is_boolean() && responses[i]["trashed"].get<bool>();
+    }
+}
+
 std::string GoogleSheetsManager::FindFolderByName(const std::string& folderName, const std::string& parentFolderId)
 {
     std::cout << "[GoogleSheetsManager] FindFolderByName: " << folderName << " in parent: " << parentFolderId << std::endl;
@@ -2407,24 +2084,6 @@ int GoogleSheetsManager::FindJobRowIndex(const std::string& spreadsheetId,
     return 1;
 }
 
-int GoogleSheetsManager::FindShotRowIndex(const std::vector<SheetRow>& sheetData,
-                                         const std::wstring& shotPath)
-{
-    std::string shotPathUtf8 = WideToUtf8(shotPath);
-
-    // Start from row 1 (skip header row at index 0)
-    for (size_t i = 1; i < sheetData.size(); ++i) {
-        if (sheetData[i].cells.size() > 1) {
-            // Shot path is in column B (index 1) - column A is Name
-            if (sheetData[i].cells[1] == shotPathUtf8) {
-                return (int)i;
-            }
-        }
-    }
-
-    return -1;  // Not found
-}
-
 std::vector<std::string> GoogleSheetsManager::GetAllStatusOptions()
 {
     std::set<std::string> uniqueStatuses;
@@ -3092,6 +2751,15 @@ void GoogleSheetsManager::CheckAndDisableJob(JobSyncRecord& record, const std::s
     }
 }
 
+void GoogleSheetsManager::StoreSyncRecord(const JobSyncRecord& record, bool save)
+{
+    std::lock_guard<std::mutex> lock(m_syncMutex);
+    m_syncRecords[record.jobPath] = record;
+    if (save) {
+        SaveSyncRecords();
+    }
+}
+
 uint64_t GoogleSheetsManager::GetCurrentTimestamp() const
 {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -3101,6 +2769,8 @@ uint64_t GoogleSheetsManager::GetCurrentTimestamp() const
 
 SheetsCacheManager* GoogleSheetsManager::GetOrCreateCacheManager(const std::wstring& jobPath)
 {
+    std::lock_guard<std::mutex> lock(m_syncMutex);
+
     auto it = m_cacheManagers.find(jobPath);
     if (it != m_cacheManagers.end()) {
         return it->second.get();
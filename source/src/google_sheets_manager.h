@@ -3,10 +3,13 @@
 #include "google_oauth_manager.h"
 #include "project_config.h"
 #include "sheets_cache_manager.h"
+#include "http_client.h"
+#include "sheets_request_scheduler.h"
 #include "nlohmann/json.hpp"
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <functional>
 
 using json = nlohmann::json;
@@ -43,6 +46,13 @@ struct CellUpdate {
     std::vector<std::vector<std::string>> values;
 };
 
+// Structure for batch row deletion (0-based grid rows, end exclusive)
+struct RowDeletion {
+    std::string sheetId;      // Sheet ID (tab ID within spreadsheet)
+    int startIndex;
+    int endIndex;
+};
+
 // Sync status for individual jobs
 enum class SheetSyncStatus {
     NotSynced,
@@ -79,6 +89,9 @@ public:
     // Set subscription manager for reading job data
     void SetSubscriptionManager(SubscriptionManager* subscriptionManager);
 
+    // Replace the HTTP client (e.g. one pointed at a local stand-in server); call before syncing starts
+    void SetHttpClient(std::unique_ptr<HttpClient> httpClient);
+
     // Set operating mode (client/server) - only server mode can use Google Sheets
     void SetOperatingMode(const std::string& mode);
     bool IsServerMode() const;
@@ -128,6 +141,10 @@ public:
                    int startIndex,
                    int endIndex);
 
+    // Delete several row ranges at once (one deleteDimension each, applied in order)
+    bool BatchDeleteRows(const std::string& spreadsheetId,
+                        const std::vector<RowDeletion>& deletions);
+
     // Clear a range
     bool ClearRange(const std::string& spreadsheetId,
                    const std::string& range);
@@ -200,11 +217,33 @@ private:
 
     void SyncLoop(std::chrono::seconds interval);
 
-    // Load/save sync records
+    // Pooled keep-alive HTTP connections shared by every API call
+    std::unique_ptr<HttpClient> m_httpClient;
+
+    // Paces API calls to the Sheets quotas, retries 429/5xx, and runs job syncs concurrently
+    SheetsRequestScheduler m_scheduler;
+
+    // Jobs with a SyncJob in progress (guarded by m_syncMutex)
+    std::set<std::wstring> m_jobsSyncing;
+
+    // Trashed state of cached job folders, fetched in one batch at the start of SyncAllJobs
+    // and consumed by IsFolderTrashed (guarded by m_syncMutex)
+    std::map<std::string, bool> m_prefetchedFolderTrashed;
+
+    // Load/save sync records (save with m_syncMutex held)
     bool LoadSyncRecords();
     bool SaveSyncRecords();
 
+    // Store a job's record back into m_syncRecords (and save to disk)
+    void StoreSyncRecord(const JobSyncRecord& record, bool save);
+
     // Helper methods for API calls
+    bool BuildApiRequest(const std::string& method, const std::string& endpoint,
+                         const std::string& body, HttpRequest& outRequest);
+    bool ApiRequest(const std::string& method, const std::string& endpoint, const std::string& body,
+                    json& outResponse, int& outStatusCode);
+    void ApiGetBatch(const std::vector<std::string>& endpoints, std::vector<json>& outResponses,
+                     std::vector<bool>& outSuccess);
     bool ApiGet(const std::string& endpoint, json& outResponse);
     bool ApiPost(const std::string& endpoint, const json& requestBody, json& outResponse);
     bool ApiPut(const std::string& endpoint, const json& requestBody, json& outResponse);
@@ -217,6 +256,7 @@ private:
     std::string FindFolderByName(const std::string& folderName, const std::string& parentFolderId);
     std::string GetOrCreateJobFolder(const std::string& jobName, const std::string& parentFolderId);
     bool IsFolderTrashed(const std::string& folderId);
+    void PrefetchFolderTrashedStates(const std::vector<std::string>& folderIds);
 
     // Build API endpoint URLs
     std::string BuildSpreadsheetsUrl(const std::string& spreadsheetId = "") const;
@@ -232,10 +272,6 @@ private:
                        const std::string& sheetTitle,
                        const std::wstring& jobPath);
 
-    // Find row index for a specific shot/asset in sheet data
-    int FindShotRowIndex(const std::vector<SheetRow>& sheetData,
-                        const std::wstring& shotPath);
-
     // Sheet formatting
     bool SetupSheetFormatting(const std::string& spreadsheetId, const std::string& sheetId, const std::wstring& jobPath, const std::string& folderType);
     bool SetColumnDataValidation(const std::string& spreadsheetId, const std::string& sheetId,
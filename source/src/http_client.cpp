@@ -0,0 +1,140 @@
+#include "http_client.h"
+#include <algorithm>
+#include <cctype>
+
+#ifdef UFB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace UFB {
+
+bool HttpClient::ParseUrl(const std::string& url, bool& outSecure, std::string& outHost,
+                          uint16_t& outPort, std::string& outPath)
+{
+    size_t hostStart;
+    if (url.compare(0, 8, "https://") == 0)
+    {
+        outSecure = true;
+        outPort = 443;
+        hostStart = 8;
+    }
+    else if (url.compare(0, 7, "http://") == 0)
+    {
+        outSecure = false;
+        outPort = 80;
+        hostStart = 7;
+    }
+    else
+    {
+        return false;
+    }
+
+    size_t pathStart = url.find_first_of("/?", hostStart);
+    std::string authority = url.substr(hostStart, pathStart == std::string::npos ? std::string::npos : pathStart - hostStart);
+    outPath = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+    if (outPath[0] == '?')
+    {
+        outPath.insert(outPath.begin(), '/');
+    }
+
+    size_t colon = authority.rfind(':');
+    if (colon != std::string::npos && authority.find(']', colon) == std::string::npos)
+    {
+        int port = 0;
+        for (size_t i = colon + 1; i < authority.size(); i++)
+        {
+            if (!isdigit(static_cast<unsigned char>(authority[i])))
+                return false;
+            port = port * 10 + (authority[i] - '0');
+            if (port > 65535)
+                return false;
+        }
+        outPort = static_cast<uint16_t>(port);
+        authority.resize(colon);
+    }
+
+    outHost = authority;
+    return !outHost.empty();
+}
+
+std::string HttpClient::ResolveUrl(const HttpClientOptions& options, const std::string& url)
+{
+    if (options.endpointOverride.empty())
+    {
+        return url;
+    }
+
+    size_t schemeEnd = url.find("://");
+    if (schemeEnd == std::string::npos)
+    {
+        return url;
+    }
+
+    size_t pathStart = url.find_first_of("/?", schemeEnd + 3);
+    std::string base = options.endpointOverride;
+    while (!base.empty() && base.back() == '/')
+    {
+        base.pop_back();
+    }
+    return base + (pathStart == std::string::npos ? std::string("/") : url.substr(pathStart));
+}
+
+bool HttpClient::CanDecodeGzip()
+{
+#ifdef UFB_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool HttpClient::DecodeBody(const std::string& contentEncoding, const std::string& raw, std::string& outBody)
+{
+    std::string encoding = contentEncoding;
+    std::transform(encoding.begin(), encoding.end(), encoding.begin(),
+                   [](unsigned char c) { return static_cast<char>(tolower(c)); });
+
+    if (encoding.empty() || encoding == "identity")
+    {
+        outBody = raw;
+        return true;
+    }
+
+#ifdef UFB_HAVE_ZLIB
+    if (encoding != "gzip" && encoding != "deflate")
+    {
+        return false;
+    }
+
+    z_stream stream = {};
+    // 32: detect a gzip or zlib wrapper from the header
+    if (inflateInit2(&stream, 32 + MAX_WBITS) != Z_OK)
+    {
+        return false;
+    }
+
+    outBody.clear();
+    char buffer[64 * 1024];
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(raw.data()));
+    stream.avail_in = static_cast<uInt>(raw.size());
+
+    int result = Z_OK;
+    while (result == Z_OK)
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        outBody.append(buffer, sizeof(buffer) - stream.avail_out);
+
+        if (result == Z_BUF_ERROR && stream.avail_in == 0)
+            break;      // Truncated input
+    }
+
+    inflateEnd(&stream);
+    return result == Z_STREAM_END;
+#else
+    return false;
+#endif
+}
+
+} // namespace UFB
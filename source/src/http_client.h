@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace UFB {
+
+struct HttpRequest
+{
+    std::string method = "GET";
+    std::string url;                        // Absolute http:// or https:// URL
+    std::vector<std::string> headers;       // "Name: value"
+    std::string body;
+};
+
+struct HttpResponse
+{
+    int statusCode = 0;                     // 0 if the request never got a response
+    std::string body;                       // Decoded (gunzipped) body
+};
+
+// Totals since the client was created; difference two snapshots for a sync cycle
+struct HttpClientStats
+{
+    uint64_t requests = 0;
+    uint64_t failedRequests = 0;            // No response (connect, TLS or socket errors)
+    uint64_t connectionsOpened = 0;         // New connections (each a TCP and, for https, TLS handshake)
+    uint64_t bytesSent = 0;                 // Request bodies
+    uint64_t bytesReceived = 0;             // Response bodies as sent on the wire (compressed)
+    uint64_t bytesDecoded = 0;              // Response bodies after decompression
+};
+
+struct HttpClientOptions
+{
+    // Send every request to this "scheme://host[:port]" instead of the URL's own, keeping path and
+    // query (e.g. "http://127.0.0.1:8080" to run against a local stand-in server)
+    std::string endpointOverride;
+
+    bool compression = true;                // Accept-Encoding: gzip
+    int maxConnectionsPerHost = 4;          // Upper bound on parallel requests in SendBatch
+    int timeoutMs = 30000;
+};
+
+// HTTP client for Google APIs: one long-lived session with pooled keep-alive connections
+//
+// - Windows: WinHTTP, one session and a cached connect handle per host; WinHTTP keeps the
+//   TLS connections alive between requests, and negotiates HTTP/2 where the OS supports it
+// - Linux: plain-HTTP sockets with an idle connection pool (https isn't supported there; it's
+//   for running against local stand-in servers)
+//
+// Thread-safe: requests from several threads share the pool
+class HttpClient
+{
+public:
+    virtual ~HttpClient() = default;
+
+    // Platform implementation (nullptr if the platform has none)
+    static std::unique_ptr<HttpClient> Create(const HttpClientOptions& options = HttpClientOptions());
+
+    // Send one request and wait for the response; false if no response arrived
+    // (an HTTP error status still returns true)
+    virtual bool Send(const HttpRequest& request, HttpResponse& outResponse) = 0;
+
+    // Send independent requests together: pipelined on one connection where the backend can,
+    // otherwise in parallel over up to maxConnectionsPerHost pooled connections.
+    // outResponses and the result line up with requests
+    virtual std::vector<bool> SendBatch(const std::vector<HttpRequest>& requests,
+                                        std::vector<HttpResponse>& outResponses) = 0;
+
+    virtual HttpClientStats GetStats() const = 0;
+
+    // Drop pooled connections (e.g. after a network change)
+    virtual void CloseIdleConnections() = 0;
+
+protected:
+    // Split "scheme://host[:port]/path?query"; false if the URL isn't http(s)
+    static bool ParseUrl(const std::string& url, bool& outSecure, std::string& outHost,
+                         uint16_t& outPort, std::string& outPath);
+
+    // Apply HttpClientOptions::endpointOverride to a request URL
+    static std::string ResolveUrl(const HttpClientOptions& options, const std::string& url);
+
+    // True if DecodeBody can gunzip (built with UFB_HAVE_ZLIB)
+    static bool CanDecodeGzip();
+
+    // Decode a body by its Content-Encoding (identity, gzip or deflate); false if it's corrupt
+    // or the encoding can't be decoded
+    static bool DecodeBody(const std::string& contentEncoding, const std::string& raw, std::string& outBody);
+};
+
+} // namespace UFB
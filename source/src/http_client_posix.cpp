@@ -0,0 +1,614 @@
+#ifdef __linux__
+
+#include "http_client.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+namespace UFB {
+
+namespace {
+
+// Requests written ahead of their responses on one connection
+constexpr size_t kPipelineDepth = 16;
+
+// Idle connections kept per host
+constexpr size_t kMaxIdlePerHost = 8;
+
+bool IsIdempotent(const std::string& method)
+{
+    return method == "GET" || method == "HEAD";
+}
+
+std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+} // namespace
+
+// Blocking sockets with a keep-alive pool; plain HTTP only (no TLS library on this platform)
+class PosixHttpClient : public HttpClient
+{
+public:
+    explicit PosixHttpClient(const HttpClientOptions& options);
+    ~PosixHttpClient() override;
+
+    bool Send(const HttpRequest& request, HttpResponse& outResponse) override;
+    std::vector<bool> SendBatch(const std::vector<HttpRequest>& requests,
+                                std::vector<HttpResponse>& outResponses) override;
+    HttpClientStats GetStats() const override;
+    void CloseIdleConnections() override;
+
+private:
+    // A pooled connection; pending holds bytes read past the last response (pipelining)
+    struct Connection
+    {
+        int fd = -1;
+        std::string pending;
+        bool reused = false;
+    };
+
+    // Where a request goes, from its (resolved) URL
+    struct Target
+    {
+        std::string host;
+        uint16_t port = 0;
+        std::string path;
+        std::string key;            // "host:port"
+    };
+
+    bool ResolveTarget(const HttpRequest& request, Target& outTarget);
+    bool Acquire(const Target& target, Connection& outConnection);
+    void Release(const Target& target, Connection& connection);
+    bool Connect(const Target& target, Connection& outConnection);
+    std::string Serialize(const HttpRequest& request, const Target& target) const;
+    bool WriteAll(int fd, const std::string& data);
+    bool ReadResponse(Connection& connection, HttpResponse& outResponse, bool& outKeepAlive);
+    bool ReadMore(Connection& connection);
+    bool ReadLine(Connection& connection, std::string& outLine);
+    bool ReadBytes(Connection& connection, size_t count, std::string& outData);
+
+    // One request on one connection; retried once on a fresh connection if a reused one was stale
+    bool SendOn(const HttpRequest& request, const Target& target, HttpResponse& outResponse);
+
+    // Idempotent requests to one host (each with its own target path), written kPipelineDepth at a
+    // time ahead of their responses
+    void SendPipelined(const std::vector<HttpRequest>& requests, const std::vector<std::pair<Target, size_t>>& pipeline,
+                       std::vector<HttpResponse>& outResponses, std::vector<char>& results);
+
+    HttpClientOptions m_options;
+    bool m_compression = false;
+
+    std::map<std::string, std::vector<Connection>> m_idle;     // "host:port" -> idle connections
+    std::mutex m_idleMutex;
+
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_failedRequests{0};
+    std::atomic<uint64_t> m_connectionsOpened{0};
+    std::atomic<uint64_t> m_bytesSent{0};
+    std::atomic<uint64_t> m_bytesReceived{0};
+    std::atomic<uint64_t> m_bytesDecoded{0};
+};
+
+std::unique_ptr<HttpClient> HttpClient::Create(const HttpClientOptions& options)
+{
+    return std::make_unique<PosixHttpClient>(options);
+}
+
+PosixHttpClient::PosixHttpClient(const HttpClientOptions& options)
+    : m_options(options)
+{
+    m_compression = m_options.compression && CanDecodeGzip();
+}
+
+PosixHttpClient::~PosixHttpClient()
+{
+    CloseIdleConnections();
+}
+
+void PosixHttpClient::CloseIdleConnections()
+{
+    std::lock_guard<std::mutex> lock(m_idleMutex);
+    for (auto& [key, connections] : m_idle)
+    {
+        for (auto& connection : connections)
+        {
+            close(connection.fd);
+        }
+    }
+    m_idle.clear();
+}
+
+bool PosixHttpClient::ResolveTarget(const HttpRequest& request, Target& outTarget)
+{
+    bool secure = false;
+    if (!ParseUrl(ResolveUrl(m_options, request.url), secure, outTarget.host, outTarget.port, outTarget.path))
+    {
+        std::cerr << "[HttpClient] Invalid URL: " << request.url << std::endl;
+        return false;
+    }
+    if (secure)
+    {
+        std::cerr << "[HttpClient] https isn't supported on this platform: " << request.url << std::endl;
+        return false;
+    }
+
+    outTarget.key = outTarget.host + ":" + std::to_string(outTarget.port);
+    return true;
+}
+
+bool PosixHttpClient::Acquire(const Target& target, Connection& outConnection)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        auto& idle = m_idle[target.key];
+        while (!idle.empty())
+        {
+            Connection connection = std::move(idle.back());
+            idle.pop_back();
+
+            // An idle connection that's readable was closed by the server (or sent junk)
+            pollfd pfd = { connection.fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 0) != 0 || !connection.pending.empty())
+            {
+                close(connection.fd);
+                continue;
+            }
+
+            connection.reused = true;
+            outConnection = std::move(connection);
+            return true;
+        }
+    }
+
+    return Connect(target, outConnection);
+}
+
+void PosixHttpClient::Release(const Target& target, Connection& connection)
+{
+    std::lock_guard<std::mutex> lock(m_idleMutex);
+    auto& idle = m_idle[target.key];
+    if (idle.size() >= kMaxIdlePerHost)
+    {
+        close(connection.fd);
+    }
+    else
+    {
+        idle.push_back(std::move(connection));
+    }
+    connection.fd = -1;
+}
+
+bool PosixHttpClient::Connect(const Target& target, Connection& outConnection)
+{
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(target.host.c_str(), std::to_string(target.port).c_str(), &hints, &addresses) != 0)
+    {
+        std::cerr << "[HttpClient] Failed to resolve " << target.host << std::endl;
+        return false;
+    }
+
+    int fd = -1;
+    for (addrinfo* address = addresses; address && fd < 0; address = address->ai_next)
+    {
+        fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd < 0)
+            continue;
+
+        // Non-blocking connect so it honours the timeout, then back to blocking
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        int result = connect(fd, address->ai_addr, address->ai_addrlen);
+        if (result < 0 && errno == EINPROGRESS)
+        {
+            pollfd pfd = { fd, POLLOUT, 0 };
+            int error = 0;
+            socklen_t errorLength = sizeof(error);
+            if (poll(&pfd, 1, m_options.timeoutMs) == 1 &&
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &errorLength) == 0 && error == 0)
+            {
+                result = 0;
+            }
+        }
+
+        if (result < 0)
+        {
+            close(fd);
+            fd = -1;
+            continue;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    }
+    freeaddrinfo(addresses);
+
+    if (fd < 0)
+    {
+        std::cerr << "[HttpClient] Failed to connect to " << target.key << std::endl;
+        return false;
+    }
+
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    timeval timeout = { m_options.timeoutMs / 1000, (m_options.timeoutMs % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    m_connectionsOpened++;
+    outConnection = Connection();
+    outConnection.fd = fd;
+    return true;
+}
+
+std::string PosixHttpClient::Serialize(const HttpRequest& request, const Target& target) const
+{
+    std::string data = request.method + " " + target.path + " HTTP/1.1\r\n";
+    data += "Host: " + (target.port == 80 ? target.host : target.key) + "\r\n";
+    data += "User-Agent: UFB/1.0\r\n";
+    if (m_compression)
+    {
+        data += "Accept-Encoding: gzip\r\n";
+    }
+    for (const auto& header : request.headers)
+    {
+        data += header + "\r\n";
+    }
+    if (!request.body.empty() || !IsIdempotent(request.method))
+    {
+        data += "Content-Length: " + std::to_string(request.body.size()) + "\r\n";
+    }
+    data += "\r\n";
+    data += request.body;
+    return data;
+}
+
+bool PosixHttpClient::WriteAll(int fd, const std::string& data)
+{
+    size_t offset = 0;
+    while (offset < data.size())
+    {
+        ssize_t written = ::send(fd, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        offset += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool PosixHttpClient::ReadMore(Connection& connection)
+{
+    char buffer[16 * 1024];
+    while (true)
+    {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            return false;
+        connection.pending.append(buffer, static_cast<size_t>(received));
+        return true;
+    }
+}
+
+bool PosixHttpClient::ReadLine(Connection& connection, std::string& outLine)
+{
+    size_t end;
+    while ((end = connection.pending.find("\r\n")) == std::string::npos)
+    {
+        if (!ReadMore(connection))
+            return false;
+    }
+    outLine = connection.pending.substr(0, end);
+    connection.pending.erase(0, end + 2);
+    return true;
+}
+
+bool PosixHttpClient::ReadBytes(Connection& connection, size_t count, std::string& outData)
+{
+    while (connection.pending.size() < count)
+    {
+        if (!ReadMore(connection))
+            return false;
+    }
+    outData.append(connection.pending, 0, count);
+    connection.pending.erase(0, count);
+    return true;
+}
+
+bool PosixHttpClient::ReadResponse(Connection& connection, HttpResponse& outResponse, bool& outKeepAlive)
+{
+    std::string statusLine;
+    std::map<std::string, std::string> headers;
+
+    // Skip interim 1xx responses
+    do
+    {
+        headers.clear();
+        if (!ReadLine(connection, statusLine) || statusLine.compare(0, 5, "HTTP/") != 0)
+            return false;
+
+        size_t space = statusLine.find(' ');
+        outResponse.statusCode = space == std::string::npos ? 0 : atoi(statusLine.c_str() + space + 1);
+
+        std::string line;
+        while (ReadLine(connection, line) && !line.empty())
+        {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos)
+                continue;
+            size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+            headers[ToLower(line.substr(0, colon))] = valueStart == std::string::npos ? "" : line.substr(valueStart);
+        }
+        if (!line.empty())
+            return false;
+    } while (outResponse.statusCode >= 100 && outResponse.statusCode < 200);
+
+    bool http10 = statusLine.compare(0, 8, "HTTP/1.0") == 0;
+    std::string connectionHeader = ToLower(headers["connection"]);
+    outKeepAlive = http10 ? connectionHeader == "keep-alive" : connectionHeader != "close";
+
+    std::string raw;
+    if (outResponse.statusCode == 204 || outResponse.statusCode == 304)
+    {
+        // No body
+    }
+    else if (ToLower(headers["transfer-encoding"]).find("chunked") != std::string::npos)
+    {
+        while (true)
+        {
+            std::string sizeLine;
+            if (!ReadLine(connection, sizeLine))
+                return false;
+            size_t chunkSize = strtoul(sizeLine.c_str(), nullptr, 16);
+            if (chunkSize == 0)
+                break;
+            std::string crlf;
+            if (!ReadBytes(connection, chunkSize, raw) || !ReadBytes(connection, 2, crlf))
+                return false;
+        }
+        // Trailers up to the blank line
+        std::string trailer;
+        do
+        {
+            if (!ReadLine(connection, trailer))
+                return false;
+        } while (!trailer.empty());
+    }
+    else if (headers.count("content-length"))
+    {
+        if (!ReadBytes(connection, strtoull(headers["content-length"].c_str(), nullptr, 10), raw))
+            return false;
+    }
+    else
+    {
+        // Delimited by the server closing the connection
+        while (ReadMore(connection)) {}
+        raw.swap(connection.pending);
+        outKeepAlive = false;
+    }
+
+    m_bytesReceived += raw.size();
+    if (!DecodeBody(headers["content-encoding"], raw, outResponse.body))
+    {
+        std::cerr << "[HttpClient] Failed to decode " << headers["content-encoding"] << " response" << std::endl;
+        return false;
+    }
+    m_bytesDecoded += outResponse.body.size();
+    return true;
+}
+
+bool PosixHttpClient::SendOn(const HttpRequest& request, const Target& target, HttpResponse& outResponse)
+{
+    std::string data = Serialize(request, target);
+
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        Connection connection;
+        if (!Acquire(target, connection))
+        {
+            return false;
+        }
+
+        outResponse = HttpResponse();
+        bool keepAlive = false;
+        bool written = WriteAll(connection.fd, data);
+        if (written)
+        {
+            m_bytesSent += request.body.size();
+        }
+        if (written && ReadResponse(connection, outResponse, keepAlive))
+        {
+            if (keepAlive)
+                Release(target, connection);
+            else
+                close(connection.fd);
+            return true;
+        }
+
+        close(connection.fd);
+        // The server may drop an idle keep-alive connection just as we reuse it: once more on a
+        // new one, as long as no response had started
+        if (!connection.reused || outResponse.statusCode != 0)
+        {
+            break;
+        }
+    }
+
+    outResponse.statusCode = 0;
+    return false;
+}
+
+bool PosixHttpClient::Send(const HttpRequest& request, HttpResponse& outResponse)
+{
+    m_requests++;
+
+    Target target;
+    if (!ResolveTarget(request, target) || !SendOn(request, target, outResponse))
+    {
+        m_failedRequests++;
+        return false;
+    }
+    return true;
+}
+
+void PosixHttpClient::SendPipelined(const std::vector<HttpRequest>& requests,
+                                    const std::vector<std::pair<Target, size_t>>& pipeline,
+                                    std::vector<HttpResponse>& outResponses, std::vector<char>& results)
+{
+    // Same host and port throughout: any request's target picks the pooled connection
+    const Target& target = pipeline.front().first;
+
+    size_t done = 0;
+    while (done < pipeline.size())
+    {
+        Connection connection;
+        if (!Acquire(target, connection))
+        {
+            break;
+        }
+
+        // Write a window of requests, then read their responses in order
+        size_t windowEnd = (std::min)(pipeline.size(), done + kPipelineDepth);
+        std::string data;
+        for (size_t i = done; i < windowEnd; i++)
+        {
+            data += Serialize(requests[pipeline[i].second], pipeline[i].first);
+        }
+
+        size_t windowStart = done;
+        bool keepAlive = WriteAll(connection.fd, data);
+        while (keepAlive && done < windowEnd)
+        {
+            size_t index = pipeline[done].second;
+            if (!ReadResponse(connection, outResponses[index], keepAlive))
+            {
+                outResponses[index] = HttpResponse();
+                keepAlive = false;
+                break;
+            }
+            results[index] = 1;
+            done++;
+        }
+
+        if (keepAlive)
+        {
+            Release(target, connection);
+        }
+        else
+        {
+            // Closed mid-window (or the server doesn't keep connections alive): the unanswered
+            // requests go again on a new connection, unless a fresh one got nowhere
+            close(connection.fd);
+            if (done == windowStart && !connection.reused)
+                break;
+        }
+    }
+
+    // Anything left after a connect failure
+    for (size_t i = done; i < pipeline.size(); i++)
+    {
+        size_t index = pipeline[i].second;
+        if (!results[index])
+        {
+            results[index] = SendOn(requests[index], pipeline[i].first, outResponses[index]) ? 1 : 0;
+        }
+    }
+}
+
+std::vector<bool> PosixHttpClient::SendBatch(const std::vector<HttpRequest>& requests,
+                                             std::vector<HttpResponse>& outResponses)
+{
+    outResponses.assign(requests.size(), HttpResponse());
+    std::vector<char> results(requests.size(), 0);
+    m_requests += requests.size();
+
+    // Idempotent requests are pipelined per host; the rest go one by one over pooled connections
+    std::map<std::string, std::vector<std::pair<Target, size_t>>> pipelines;     // "host:port" -> requests
+    std::vector<std::pair<Target, size_t>> singles;
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        Target target;
+        if (!ResolveTarget(requests[i], target))
+            continue;
+
+        if (IsIdempotent(requests[i].method))
+        {
+            pipelines[target.key].emplace_back(target, i);
+        }
+        else
+        {
+            singles.emplace_back(target, i);
+        }
+    }
+
+    std::vector<std::thread> workers;
+    for (auto& [key, pipeline] : pipelines)
+    {
+        workers.emplace_back([&, &pipeline = pipeline]()
+        {
+            SendPipelined(requests, pipeline, outResponses, results);
+        });
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < singles.size(); i = next++)
+        {
+            size_t index = singles[i].second;
+            results[index] = SendOn(requests[index], singles[i].first, outResponses[index]) ? 1 : 0;
+        }
+    };
+    size_t workerCount = (std::min)(singles.size(), static_cast<size_t>((std::max)(1, m_options.maxConnectionsPerHost)));
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        workers.emplace_back(worker);
+    }
+
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    for (char result : results)
+    {
+        if (!result)
+            m_failedRequests++;
+    }
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+HttpClientStats PosixHttpClient::GetStats() const
+{
+    HttpClientStats stats;
+    stats.requests = m_requests;
+    stats.failedRequests = m_failedRequests;
+    stats.connectionsOpened = m_connectionsOpened;
+    stats.bytesSent = m_bytesSent;
+    stats.bytesReceived = m_bytesReceived;
+    stats.bytesDecoded = m_bytesDecoded;
+    return stats;
+}
+
+} // namespace UFB
+
+#endif // __linux__
@@ -0,0 +1,344 @@
+#ifdef _WIN32
+
+#include <windows.h>
+#include <winhttp.h>
+#include "http_client.h"
+#include "utils.h"
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+
+#pragma comment(lib, "winhttp.lib")
+
+namespace UFB {
+
+// One WinHTTP session for the client's lifetime. WinHTTP pools connections per session, so
+// requests reuse open TCP/TLS connections instead of handshaking each time
+class WinHttpClient : public HttpClient
+{
+public:
+    explicit WinHttpClient(const HttpClientOptions& options);
+    ~WinHttpClient() override;
+
+    bool Send(const HttpRequest& request, HttpResponse& outResponse) override;
+    std::vector<bool> SendBatch(const std::vector<HttpRequest>& requests,
+                                std::vector<HttpResponse>& outResponses) override;
+    HttpClientStats GetStats() const override;
+    void CloseIdleConnections() override;
+
+private:
+    bool OpenSession();
+    void CloseSession();
+    HINTERNET GetConnection(const std::string& host, uint16_t port);
+    static std::wstring QueryHeader(HINTERNET hRequest, DWORD infoLevel);
+    static void CALLBACK StatusCallback(HINTERNET hInternet, DWORD_PTR context, DWORD status,
+                                        LPVOID info, DWORD infoLength);
+
+    HttpClientOptions m_options;
+    bool m_decodeGzip = false;      // We send Accept-Encoding and gunzip (so wire bytes are countable)
+
+    HINTERNET m_session = nullptr;
+    std::map<std::string, HINTERNET> m_connections;     // "host:port" -> connect handle
+    std::mutex m_connectionsMutex;
+    std::shared_mutex m_sessionMutex;   // Shared per request, exclusive to replace the session
+
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_failedRequests{0};
+    std::atomic<uint64_t> m_connectionsOpened{0};
+    std::atomic<uint64_t> m_bytesSent{0};
+    std::atomic<uint64_t> m_bytesReceived{0};
+    std::atomic<uint64_t> m_bytesDecoded{0};
+};
+
+std::unique_ptr<HttpClient> HttpClient::Create(const HttpClientOptions& options)
+{
+    return std::make_unique<WinHttpClient>(options);
+}
+
+WinHttpClient::WinHttpClient(const HttpClientOptions& options)
+    : m_options(options)
+{
+    m_decodeGzip = m_options.compression && CanDecodeGzip();
+    OpenSession();
+}
+
+WinHttpClient::~WinHttpClient()
+{
+    CloseSession();
+}
+
+bool WinHttpClient::OpenSession()
+{
+    m_session = WinHttpOpen(L"UFB/1.0",
+                            WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                            WINHTTP_NO_PROXY_NAME,
+                            WINHTTP_NO_PROXY_BYPASS,
+                            0);
+    if (!m_session)
+    {
+        std::cerr << "[HttpClient] WinHttpOpen failed: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    WinHttpSetTimeouts(m_session, m_options.timeoutMs, m_options.timeoutMs, m_options.timeoutMs, m_options.timeoutMs);
+
+    DWORD maxConnections = static_cast<DWORD>((std::max)(1, m_options.maxConnectionsPerHost));
+    WinHttpSetOption(m_session, WINHTTP_OPTION_MAX_CONNS_PER_SERVER, &maxConnections, sizeof(maxConnections));
+
+#ifdef WINHTTP_OPTION_ENABLE_HTTP_PROTOCOL
+    // HTTP/2 multiplexes concurrent requests on one connection (Windows 10 1607+; ignored before)
+    DWORD protocols = WINHTTP_PROTOCOL_FLAG_HTTP2;
+    WinHttpSetOption(m_session, WINHTTP_OPTION_ENABLE_HTTP_PROTOCOL, &protocols, sizeof(protocols));
+#endif
+
+#ifdef WINHTTP_OPTION_DECOMPRESSION
+    // Without zlib, let WinHTTP negotiate and decode gzip (Windows 8.1+); wire bytes then aren't visible
+    if (m_options.compression && !m_decodeGzip)
+    {
+        DWORD decompression = WINHTTP_DECOMPRESSION_FLAG_ALL;
+        WinHttpSetOption(m_session, WINHTTP_OPTION_DECOMPRESSION, &decompression, sizeof(decompression));
+    }
+#endif
+
+    WinHttpSetStatusCallback(m_session, &WinHttpClient::StatusCallback,
+                             WINHTTP_CALLBACK_FLAG_CONNECTED_TO_SERVER, 0);
+    return true;
+}
+
+void WinHttpClient::CloseSession()
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+    for (auto& [key, hConnect] : m_connections)
+    {
+        WinHttpCloseHandle(hConnect);
+    }
+    m_connections.clear();
+
+    if (m_session)
+    {
+        WinHttpCloseHandle(m_session);
+        m_session = nullptr;
+    }
+}
+
+void WinHttpClient::CloseIdleConnections()
+{
+    std::unique_lock<std::shared_mutex> lock(m_sessionMutex);
+    CloseSession();
+    OpenSession();
+}
+
+HINTERNET WinHttpClient::GetConnection(const std::string& host, uint16_t port)
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    std::string key = host + ":" + std::to_string(port);
+    auto it = m_connections.find(key);
+    if (it != m_connections.end())
+    {
+        return it->second;
+    }
+
+    HINTERNET hConnect = WinHttpConnect(m_session, Utf8ToWide(host).c_str(), port, 0);
+    if (hConnect)
+    {
+        m_connections[key] = hConnect;
+    }
+    return hConnect;
+}
+
+void CALLBACK WinHttpClient::StatusCallback(HINTERNET hInternet, DWORD_PTR context, DWORD status,
+                                            LPVOID info, DWORD infoLength)
+{
+    // Context is set per request in Send
+    if (status == WINHTTP_CALLBACK_STATUS_CONNECTED_TO_SERVER && context != 0)
+    {
+        reinterpret_cast<WinHttpClient*>(context)->m_connectionsOpened++;
+    }
+}
+
+std::wstring WinHttpClient::QueryHeader(HINTERNET hRequest, DWORD infoLevel)
+{
+    DWORD size = 0;
+    WinHttpQueryHeaders(hRequest, infoLevel, WINHTTP_HEADER_NAME_BY_INDEX, WINHTTP_NO_OUTPUT_BUFFER,
+                        &size, WINHTTP_NO_HEADER_INDEX);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || size == 0)
+    {
+        return std::wstring();
+    }
+
+    std::wstring value(size / sizeof(wchar_t), L'\0');
+    if (!WinHttpQueryHeaders(hRequest, infoLevel, WINHTTP_HEADER_NAME_BY_INDEX, value.data(),
+                             &size, WINHTTP_NO_HEADER_INDEX))
+    {
+        return std::wstring();
+    }
+    value.resize(size / sizeof(wchar_t));
+    return value;
+}
+
+bool WinHttpClient::Send(const HttpRequest& request, HttpResponse& outResponse)
+{
+    outResponse = HttpResponse();
+    m_requests++;
+
+    bool secure = false;
+    std::string host;
+    uint16_t port = 0;
+    std::string path;
+    if (!ParseUrl(ResolveUrl(m_options, request.url), secure, host, port, path))
+    {
+        std::cerr << "[HttpClient] Invalid URL: " << request.url << std::endl;
+        m_failedRequests++;
+        return false;
+    }
+
+    std::shared_lock<std::shared_mutex> sessionLock(m_sessionMutex);
+    HINTERNET hConnect = m_session ? GetConnection(host, port) : nullptr;
+    if (!hConnect)
+    {
+        std::cerr << "[HttpClient] WinHttpConnect failed for " << host << ": " << GetLastError() << std::endl;
+        m_failedRequests++;
+        return false;
+    }
+
+    HINTERNET hRequest = WinHttpOpenRequest(hConnect,
+                                            Utf8ToWide(request.method).c_str(),
+                                            Utf8ToWide(path).c_str(),
+                                            nullptr,
+                                            WINHTTP_NO_REFERER,
+                                            WINHTTP_DEFAULT_ACCEPT_TYPES,
+                                            secure ? WINHTTP_FLAG_SECURE : 0);
+    if (!hRequest)
+    {
+        m_failedRequests++;
+        return false;
+    }
+
+    std::string headers;
+    for (const auto& header : request.headers)
+    {
+        headers += header + "\r\n";
+    }
+    if (m_decodeGzip)
+    {
+        headers += "Accept-Encoding: gzip\r\n";
+    }
+    if (!headers.empty())
+    {
+        std::wstring wheaders = Utf8ToWide(headers);
+        WinHttpAddRequestHeaders(hRequest, wheaders.c_str(), static_cast<DWORD>(-1), WINHTTP_ADDREQ_FLAG_ADD);
+    }
+
+    DWORD bodyLength = static_cast<DWORD>(request.body.size());
+    bool success = WinHttpSendRequest(hRequest,
+                                      WINHTTP_NO_ADDITIONAL_HEADERS,
+                                      0,
+                                      bodyLength ? (LPVOID)request.body.data() : WINHTTP_NO_REQUEST_DATA,
+                                      bodyLength,
+                                      bodyLength,
+                                      reinterpret_cast<DWORD_PTR>(this));
+    if (success)
+    {
+        m_bytesSent += bodyLength;
+        success = WinHttpReceiveResponse(hRequest, nullptr);
+    }
+
+    std::string raw;
+    if (success)
+    {
+        DWORD statusCode = 0;
+        DWORD statusCodeSize = sizeof(statusCode);
+        WinHttpQueryHeaders(hRequest,
+                            WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+                            WINHTTP_HEADER_NAME_BY_INDEX,
+                            &statusCode,
+                            &statusCodeSize,
+                            WINHTTP_NO_HEADER_INDEX);
+        outResponse.statusCode = static_cast<int>(statusCode);
+
+        // Read to the end so the connection goes back to the pool
+        char buffer[16 * 1024];
+        DWORD bytesRead = 0;
+        while ((success = WinHttpReadData(hRequest, buffer, sizeof(buffer), &bytesRead)) && bytesRead > 0)
+        {
+            raw.append(buffer, bytesRead);
+        }
+    }
+
+    std::string contentEncoding;
+    if (success && m_decodeGzip)
+    {
+        contentEncoding = WideToUtf8(QueryHeader(hRequest, WINHTTP_QUERY_CONTENT_ENCODING));
+    }
+    WinHttpCloseHandle(hRequest);
+
+    if (!success)
+    {
+        std::cerr << "[HttpClient] " << request.method << " " << host << " failed: " << GetLastError() << std::endl;
+        m_failedRequests++;
+        outResponse.statusCode = 0;
+        return false;
+    }
+
+    m_bytesReceived += raw.size();
+    if (!DecodeBody(contentEncoding, raw, outResponse.body))
+    {
+        std::cerr << "[HttpClient] Failed to decode " << contentEncoding << " response from " << host << std::endl;
+        m_failedRequests++;
+        return false;
+    }
+    m_bytesDecoded += outResponse.body.size();
+    return true;
+}
+
+std::vector<bool> WinHttpClient::SendBatch(const std::vector<HttpRequest>& requests,
+                                           std::vector<HttpResponse>& outResponses)
+{
+    // WinHTTP doesn't pipeline HTTP/1.1; concurrent requests share an HTTP/2 connection where
+    // negotiated, and spread over pooled keep-alive connections otherwise
+    outResponses.assign(requests.size(), HttpResponse());
+    std::vector<char> results(requests.size(), 0);
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < requests.size(); i = next++)
+        {
+            results[i] = Send(requests[i], outResponses[i]) ? 1 : 0;
+        }
+    };
+
+    size_t workerCount = (std::min)(requests.size(), static_cast<size_t>((std::max)(1, m_options.maxConnectionsPerHost)));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+HttpClientStats WinHttpClient::GetStats() const
+{
+    HttpClientStats stats;
+    stats.requests = m_requests;
+    stats.failedRequests = m_failedRequests;
+    stats.connectionsOpened = m_connectionsOpened;
+    stats.bytesSent = m_bytesSent;
+    stats.bytesReceived = m_bytesReceived;
+    stats.bytesDecoded = m_bytesDecoded;
+    return stats;
+}
+
+} // namespace UFB
+
+#endif // _WIN32
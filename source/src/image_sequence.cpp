@@ -0,0 +1,265 @@
+#include "image_sequence.h"
+#include "file_entry.h"
+#include <algorithm>
+#include <cwctype>
+#include <unordered_map>
+
+namespace UFB {
+
+namespace {
+
+// Extensions that are rendered/written as frame sequences (lowercase)
+const wchar_t* const kSequenceExtensions[] = {
+    L".exr", L".dpx", L".cin", L".png", L".jpg", L".jpeg", L".tif", L".tiff",
+    L".tga", L".bmp", L".hdr", L".sgi", L".rgb", L".iff", L".jp2", L".webp"
+};
+
+// Case-insensitive match of name[dot..] against the list, without allocating
+bool IsSequenceExtension(const std::wstring& name, size_t dot)
+{
+    const size_t length = name.size() - dot;
+    for (const wchar_t* ext : kSequenceExtensions)
+    {
+        size_t i = 0;
+        while (i < length && ext[i] != L'\0' && static_cast<wchar_t>(::towlower(name[dot + i])) == ext[i])
+            i++;
+        if (i == length && ext[i] == L'\0')
+            return true;
+    }
+    return false;
+}
+
+// Frame numbers above 9 digits are not frames (timestamps, IDs)
+constexpr size_t kMaxFrameDigits = 9;
+
+struct ParsedName
+{
+    size_t prefixLength;  // Up to and including the '.'/'_' before the frame
+    size_t digitCount;
+    bool padded;          // Leading zero: digitCount is the sequence's padding
+    int frame;
+};
+
+// Split "name.1001.exr" into prefix "name.", frame 1001 (4 digits) and suffix ".exr"
+bool ParseFrameNumber(const std::wstring& name, ParsedName& out)
+{
+    size_t dot = name.find_last_of(L'.');
+    if (dot == std::wstring::npos || dot == 0)
+        return false;
+
+    if (!IsSequenceExtension(name, dot))
+        return false;
+
+    size_t digitsStart = dot;
+    while (digitsStart > 0 && name[digitsStart - 1] >= L'0' && name[digitsStart - 1] <= L'9')
+        digitsStart--;
+
+    size_t digitCount = dot - digitsStart;
+    if (digitCount == 0 || digitCount > kMaxFrameDigits || digitsStart == 0)
+        return false;
+
+    wchar_t separator = name[digitsStart - 1];
+    if (separator != L'.' && separator != L'_')
+        return false;
+
+    int frame = 0;
+    for (size_t i = digitsStart; i < dot; i++)
+        frame = frame * 10 + (name[i] - L'0');
+
+    out.prefixLength = digitsStart;
+    out.digitCount = digitCount;
+    out.padded = digitCount > 1 && name[digitsStart] == L'0';
+    out.frame = frame;
+    return true;
+}
+
+std::wstring FormatFrame(int frame, int padding)
+{
+    std::wstring number = std::to_wstring(frame);
+    if (static_cast<int>(number.size()) < padding)
+        number.insert(0, padding - number.size(), L'0');
+    return number;
+}
+
+} // namespace
+
+void CollapseImageSequences(std::vector<FileEntry>& entries, size_t minFrames)
+{
+    struct Member
+    {
+        int frame;
+        size_t index;
+        size_t digitCount;
+        bool padded;
+
+        bool operator<(const Member& other) const { return frame < other.frame; }
+    };
+
+    struct Group
+    {
+        std::vector<Member> members;
+        size_t padding = 0;         // Width of the zero-padded members, 0 = unpadded
+        size_t displayDigits = 0;   // Number of '#' in the display name
+    };
+
+    std::unordered_map<std::wstring, size_t> groupIndex;
+    groupIndex.reserve(entries.size());
+    std::vector<Group> groups;
+    std::vector<int> groupOf(entries.size(), -1);
+
+    // Group by (prefix, suffix): the digit count alone doesn't split a sequence, so
+    // "shot.998.exr" .. "shot.1002.exr" stay together
+    std::wstring key;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const FileEntry& entry = entries[i];
+        ParsedName parsed;
+        if (entry.isDirectory || !ParseFrameNumber(entry.name, parsed))
+            continue;
+
+        key.assign(entry.name, 0, parsed.prefixLength);
+        key += L'\x01';
+        key.append(entry.name, parsed.prefixLength + parsed.digitCount, std::wstring::npos);
+
+        auto [it, inserted] = groupIndex.try_emplace(key, groups.size());
+        if (inserted)
+            groups.emplace_back();
+
+        groups[it->second].members.push_back({ parsed.frame, i, parsed.digitCount, parsed.padded });
+        groupOf[i] = static_cast<int>(it->second);
+    }
+
+    if (groups.empty())
+        return;
+
+    // Padding comes from the members with a leading zero (the most common width if they
+    // disagree). Members that can't be written with it ("shot.5.exr" next to "shot.0001.exr",
+    // or another padded width) stay individual files.
+    std::vector<std::pair<size_t, size_t>> paddedWidths;  // (width, members)
+    for (Group& group : groups)
+    {
+        if (group.members.size() < minFrames)
+            continue;
+
+        paddedWidths.clear();
+        for (const Member& member : group.members)
+        {
+            if (!member.padded)
+                continue;
+
+            auto width = std::find_if(paddedWidths.begin(), paddedWidths.end(),
+                                      [&member](const auto& entry) { return entry.first == member.digitCount; });
+            if (width == paddedWidths.end())
+                paddedWidths.emplace_back(member.digitCount, 1);
+            else
+                width->second++;
+        }
+
+        size_t bestCount = 0;
+        for (const auto& [width, count] : paddedWidths)
+        {
+            if (count > bestCount || (count == bestCount && width < group.padding))
+            {
+                group.padding = width;
+                bestCount = count;
+            }
+        }
+
+        auto fits = [&group](const Member& member) {
+            return member.padded ? member.digitCount == group.padding : member.digitCount >= group.padding;
+        };
+
+        auto firstMisfit = std::stable_partition(group.members.begin(), group.members.end(), fits);
+        for (auto it = firstMisfit; it != group.members.end(); ++it)
+            groupOf[it->index] = -1;
+        group.members.erase(firstMisfit, group.members.end());
+
+        group.displayDigits = group.padding;
+        if (group.displayDigits == 0)
+        {
+            group.displayDigits = kMaxFrameDigits;
+            for (const Member& member : group.members)
+                group.displayDigits = (std::min)(group.displayDigits, member.digitCount);
+        }
+    }
+
+    // Rebuild the listing: each sequence takes the position of its first member
+    std::vector<FileEntry> result;
+    result.reserve(entries.size());
+    std::vector<bool> emitted(groups.size(), false);
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        int g = groupOf[i];
+        if (g < 0 || groups[g].members.size() < minFrames)
+        {
+            result.push_back(std::move(entries[i]));
+            continue;
+        }
+
+        if (emitted[g])
+            continue;
+        emitted[g] = true;
+
+        Group& group = groups[g];
+        auto& members = group.members;
+        if (!std::is_sorted(members.begin(), members.end()))
+            std::sort(members.begin(), members.end());
+
+        const FileEntry& first = entries[members.front().index];
+        ParsedName parsed;
+        ParseFrameNumber(first.name, parsed);
+
+        FileEntry sequence;
+        sequence.isDirectory = false;
+        sequence.fullPath = first.fullPath;
+        sequence.framePadding = static_cast<int>(group.padding);
+        sequence.sequencePrefix = first.fullPath.substr(0, first.fullPath.size() - first.name.size() + parsed.prefixLength);
+        sequence.sequenceSuffix = first.name.substr(parsed.prefixLength + parsed.digitCount);
+        sequence.size = 0;
+        sequence.lastModified = first.lastModified;
+        sequence.frames.reserve(members.size());
+
+        for (const Member& member : members)
+        {
+            sequence.frames.push_back(member.frame);
+            sequence.size += entries[member.index].size;
+            sequence.lastModified = (std::max)(sequence.lastModified, entries[member.index].lastModified);
+        }
+
+        // "name.####.exr [1001-1100]" or "name.####.exr [1001-1100, 3 missing]"
+        int firstFrame = sequence.frames.front();
+        int lastFrame = sequence.frames.back();
+        int missing = (lastFrame - firstFrame + 1) - static_cast<int>(sequence.frames.size());
+
+        sequence.name = first.name.substr(0, parsed.prefixLength) + std::wstring(group.displayDigits, L'#') +
+                        sequence.sequenceSuffix + L" [" + std::to_wstring(firstFrame) + L"-" + std::to_wstring(lastFrame);
+        if (missing > 0)
+            sequence.name += L", " + std::to_wstring(missing) + L" missing";
+        sequence.name += L"]";
+
+        result.push_back(std::move(sequence));
+    }
+
+    entries = std::move(result);
+}
+
+void AppendEntryPaths(const FileEntry& entry, std::vector<std::wstring>& outPaths)
+{
+    if (!entry.IsSequence())
+    {
+        outPaths.push_back(entry.fullPath);
+        return;
+    }
+
+    outPaths.reserve(outPaths.size() + entry.frames.size());
+    for (int frame : entry.frames)
+        outPaths.push_back(GetSequenceFramePath(entry, frame));
+}
+
+std::wstring GetSequenceFramePath(const FileEntry& entry, int frame)
+{
+    return entry.sequencePrefix + FormatFrame(frame, entry.framePadding) + entry.sequenceSuffix;
+}
+
+} // namespace UFB
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct FileEntry;
+
+namespace UFB {
+
+// Collapse numbered image files ("name.####.ext" / "name_####.ext") into one entry per sequence
+// Single O(n) pass over the listing; directories and non-image files are left untouched.
+// Frames group on prefix + suffix; a leading zero marks the frame width as padding ("0998".."1002"
+// is one #### sequence, "998".."1002" one unpadded sequence), and frames that can't be written
+// with the group's padding stay individual files.
+// A sequence entry keeps fullPath = first frame (used for open, icon and thumbnail), gets
+// name = "name.####.ext [1001-1100]", size = total bytes and lastModified = newest frame.
+// @param minFrames - groups with fewer frames stay as individual files
+void CollapseImageSequences(std::vector<FileEntry>& entries, size_t minFrames = 2);
+
+// Append every path an entry stands for (all frames of a sequence) - use for copy/cut/delete/drag
+void AppendEntryPaths(const FileEntry& entry, std::vector<std::wstring>& outPaths);
+
+// Full path of one frame of a sequence entry
+std::wstring GetSequenceFramePath(const FileEntry& entry, int frame);
+
+} // namespace UFB
@@ -33,6 +33,11 @@
 #include "bookmark_manager.h"
 #include "subscription_panel.h"
 #include "transcode_queue_panel.h"
+#include "copy_queue_panel.h"
+#include "file_hash_service.h"
+#include "file_hash_panel.h"
+#include "file_index.h"
+#include "storage_analyzer.h"
 #include "deadline_queue_panel.h"
 #include "deadline_submit_dialog.h"
 #include "settings_dialog.h"
@@ -1012,6 +1017,8 @@ void SetupDefaultLayout(ImGuiID dockspace_id, const ImVec2& viewport_size) {
     // Dock the Browser window and Transcode Queue as tabs in the same dockspace
     ImGui::DockBuilderDockWindow("Browser", dockspace_id);
     ImGui::DockBuilderDockWindow("Transcode Queue", dockspace_id);
+    ImGui::DockBuilderDockWindow("Copy Queue", dockspace_id);
+    ImGui::DockBuilderDockWindow("Hash Results", dockspace_id);
 
     ImGui::DockBuilderFinish(dockspace_id);
     std::cout << "Main layout setup complete" << std::endl;
@@ -1297,6 +1304,41 @@ int main(int argc, char** argv)
     // Initialize backup manager
     UFB::BackupManager backupManager;
 
+    // Initialize file hash service (content hashes cached in ufb.db, shared by backups and copies)
+    UFB::FileHashService fileHashService;
+    if (fileHashService.Initialize(&subscriptionManager))
+    {
+        backupManager.SetHashService(&fileHashService);
+    }
+    else
+    {
+        std::cerr << "Failed to initialize FileHashService" << std::endl;
+    }
+
+    // Initialize file index (filename search over the subscribed jobs)
+    UFB::FileIndex fileIndex;
+    fileIndex.Initialize();
+    FileBrowser::fileIndex = &fileIndex;
+    auto updateFileIndexRoots = [&subscriptionManager, &fileIndex]() {
+        std::vector<std::wstring> roots;
+        for (const auto& subscription : subscriptionManager.GetAllSubscriptions())
+            roots.push_back(subscription.jobPath);
+        fileIndex.SetRoots(roots);
+    };
+    updateFileIndexRoots();
+
+    // Initialize storage analyzer (per-folder disk usage of jobs, shown in the shot and tracker views)
+    UFB::StorageAnalyzer storageAnalyzer;
+    if (storageAnalyzer.Initialize(&subscriptionManager))
+    {
+        ShotView::storageAnalyzer = &storageAnalyzer;
+        ProjectTrackerView::storageAnalyzer = &storageAnalyzer;
+    }
+    else
+    {
+        std::cerr << "Failed to initialize StorageAnalyzer" << std::endl;
+    }
+
     // Initialize sync manager
     UFB::SyncManager syncManager;
     if (!syncManager.Initialize(&subscriptionManager, &metadataManager, &backupManager))
@@ -1344,12 +1386,15 @@ int main(int argc, char** argv)
         }
 
         // Wire up subscription change callbacks
-        subscriptionManager.RegisterSubscriptionChangeCallback([&clientTrackingManager]() {
+        subscriptionManager.RegisterSubscriptionChangeCallback([&clientTrackingManager, &updateFileIndexRoots]() {
             // Client mode: Write own tracking file
             if (clientTrackingManager.GetOperatingMode() == "client")
             {
                 clientTrackingManager.WriteOwnTrackingFile();
             }
+
+            // Index newly subscribed jobs, drop unsubscribed ones
+            updateFileIndexRoots();
         });
 
         subscriptionManager.RegisterUnsubscribeCallback([&clientTrackingManager](const std::wstring& jobPath) {
@@ -1573,6 +1618,24 @@ int main(int argc, char** argv)
     // Initialize transcode queue panel
     UFB::TranscodeQueuePanel transcodeQueuePanel;
 
+    // Initialize copy queue panel (pastes and drops are copied by its engine instead of SHFileOperation)
+    UFB::CopyQueuePanel copyQueuePanel;
+    copyQueuePanel.SetHashService(&fileHashService);
+    // Names already taken at the destination are found before queueing and the user picks Replace / Skip / Keep Both
+    auto copyFilesCallback = [&copyQueuePanel](const std::vector<std::wstring>& sources, const std::wstring& destDirectory, bool move) {
+        UFB::CopyOperation operation = move ? UFB::CopyOperation::Move : UFB::CopyOperation::Copy;
+        auto conflicts = UFB::CopyEngine::FindConflicts(sources, destDirectory);
+        if (conflicts.empty()) {
+            copyQueuePanel.AddJob(sources, destDirectory, operation);
+        } else {
+            copyQueuePanel.AskAboutConflicts(sources, destDirectory, operation, std::move(conflicts));
+        }
+    };
+
+    // Initialize hash results panel (duplicates and manifests requested from browser context menus)
+    UFB::FileHashPanel fileHashPanel;
+    fileHashPanel.SetHashService(&fileHashService);
+
     // Initialize deadline queue panel and submit dialog
     DeadlineQueuePanel deadlineQueuePanel;
     deadlineQueuePanel.Initialize();
@@ -1630,6 +1693,21 @@ int main(int argc, char** argv)
         ImGui::SetWindowFocus("Transcode Queue");  // Switch to the Transcode Queue tab
     };
 
+    // Copy/move callbacks for both file browsers
+    fileBrowser1.onCopyFiles = copyFilesCallback;
+    fileBrowser2.onCopyFiles = copyFilesCallback;
+
+    // Content hashing callbacks for both file browsers
+    auto findDuplicatesCallback = [&fileHashPanel](const std::wstring& folder) { fileHashPanel.FindDuplicates(folder); };
+    auto createHashManifestCallback = [&fileHashPanel](const std::wstring& folder) { fileHashPanel.CreateManifest(folder); };
+    auto verifyHashManifestCallback = [&fileHashPanel](const std::wstring& manifestPath) { fileHashPanel.VerifyManifest(manifestPath); };
+    fileBrowser1.onFindDuplicates = findDuplicatesCallback;
+    fileBrowser2.onFindDuplicates = findDuplicatesCallback;
+    fileBrowser1.onCreateHashManifest = createHashManifestCallback;
+    fileBrowser2.onCreateHashManifest = createHashManifestCallback;
+    fileBrowser1.onVerifyHashManifest = verifyHashManifestCallback;
+    fileBrowser2.onVerifyHashManifest = verifyHashManifestCallback;
+
     // Shot views management
     std::vector<std::unique_ptr<ShotView>> shotViews;
 
@@ -1652,7 +1730,7 @@ int main(int argc, char** argv)
     std::vector<std::unique_ptr<FileBrowser>> standaloneBrowsers;
 
     // Set up "Open in New Window" callback for all browsers (defined early so custom views can use it)
-    std::function<void(const std::wstring&)> openInNewWindowCallback = [&standaloneBrowsers, &bookmarkManager, &subscriptionManager, &openInNewWindowCallback](const std::wstring& path) {
+    std::function<void(const std::wstring&)> openInNewWindowCallback = [&standaloneBrowsers, &bookmarkManager, &subscriptionManager, &openInNewWindowCallback, copyFilesCallback, findDuplicatesCallback, createHashManifestCallback, verifyHashManifestCallback](const std::wstring& path) {
         // Create new standalone browser
         auto browser = std::make_unique<FileBrowser>();
 
@@ -1674,6 +1752,10 @@ int main(int argc, char** argv)
 
         // Wire up callback so this browser can also open new windows
         browser->onOpenInNewWindow = openInNewWindowCallback;
+        browser->onCopyFiles = copyFilesCallback;
+        browser->onFindDuplicates = findDuplicatesCallback;
+        browser->onCreateHashManifest = createHashManifestCallback;
+        browser->onVerifyHashManifest = verifyHashManifestCallback;
 
         // Store browser
         standaloneBrowsers.push_back(std::move(browser));
@@ -1874,7 +1956,7 @@ int main(int argc, char** argv)
     };
 
     // Set up shot view callbacks for both file browsers
-    auto openShotViewCallback = [&shotViews, &bookmarkManager, &subscriptionManager, &metadataManager, &fileBrowser1, &fileBrowser2, &transcodeQueuePanel, &deadlineSubmitDialog, &openInNewWindowCallback, hwnd](const std::wstring& categoryPath, const std::wstring& categoryName) {
+    auto openShotViewCallback = [&shotViews, &bookmarkManager, &subscriptionManager, &metadataManager, &fileBrowser1, &fileBrowser2, &transcodeQueuePanel, &deadlineSubmitDialog, &openInNewWindowCallback, hwnd, copyFilesCallback](const std::wstring& categoryPath, const std::wstring& categoryName) {
         // Check if this shot view is already open
         for (const auto& sv : shotViews) {
             if (sv && sv->GetCategoryPath() == categoryPath) {
@@ -1910,6 +1992,8 @@ int main(int argc, char** argv)
             ImGui::SetWindowFocus("Transcode Queue");
         };
 
+        shotView->onCopyFiles = copyFilesCallback;
+
         // Set up deadline submission callback
         shotView->onSubmitToDeadline = [&deadlineSubmitDialog](const std::wstring& blendFilePath, const std::wstring& jobName) {
             deadlineSubmitDialog.Show(blendFilePath, jobName);
@@ -1935,6 +2019,32 @@ int main(int argc, char** argv)
 
     transcodeQueuePanel.onOpenInNewWindow = openInNewWindowCallback;
 
+    // Set up copy queue panel callbacks
+    copyQueuePanel.onOpenInLeftBrowser = [&fileBrowser1](const std::wstring& path) {
+        fileBrowser1.SetCurrentDirectory(path);
+        ImGui::SetWindowFocus("Browser");
+    };
+
+    copyQueuePanel.onOpenInRightBrowser = [&fileBrowser2](const std::wstring& path) {
+        fileBrowser2.SetCurrentDirectory(path);
+        ImGui::SetWindowFocus("Browser");
+    };
+
+    copyQueuePanel.onOpenInNewWindow = openInNewWindowCallback;
+
+    // Set up hash results panel callbacks
+    fileHashPanel.onOpenInLeftBrowser = [&fileBrowser1](const std::wstring& path) {
+        fileBrowser1.SetCurrentDirectory(path);
+        ImGui::SetWindowFocus("Browser");
+    };
+
+    fileHashPanel.onOpenInRightBrowser = [&fileBrowser2](const std::wstring& path) {
+        fileBrowser2.SetCurrentDirectory(path);
+        ImGui::SetWindowFocus("Browser");
+    };
+
+    fileHashPanel.onOpenInNewWindow = openInNewWindowCallback;
+
     // Set up deadline queue panel callbacks
     deadlineQueuePanel.onOpenInLeftBrowser = [&fileBrowser1](const std::wstring& path) {
         fileBrowser1.SetCurrentDirectory(path);
@@ -1973,7 +2083,7 @@ int main(int argc, char** argv)
     };
 
     // Set up assets view callbacks for both file browsers
-    auto openAssetsViewCallback = [&assetsViews, &bookmarkManager, &subscriptionManager, &metadataManager, &fileBrowser1, &fileBrowser2, &transcodeQueuePanel, &openInNewWindowCallback, hwnd](const std::wstring& assetsFolderPath, const std::wstring& jobName) {
+    auto openAssetsViewCallback = [&assetsViews, &bookmarkManager, &subscriptionManager, &metadataManager, &fileBrowser1, &fileBrowser2, &transcodeQueuePanel, &openInNewWindowCallback, hwnd, copyFilesCallback](const std::wstring& assetsFolderPath, const std::wstring& jobName) {
         // Check if this assets view is already open
         for (const auto& av : assetsViews) {
             if (av && av->GetAssetsFolderPath() == assetsFolderPath) {
@@ -2012,6 +2122,8 @@ int main(int argc, char** argv)
             ImGui::SetWindowFocus("Transcode Queue");
         };
 
+        assetsView->onCopyFiles = copyFilesCallback;
+
         assetsViews.push_back(std::move(assetsView));
         std::wcout << L"[Main] Opened assets view for: " << assetsFolderPath << std::endl;
     };
@@ -2020,7 +2132,7 @@ int main(int argc, char** argv)
     fileBrowser2.onOpenAssetsView = openAssetsViewCallback;
 
     // Set up postings view callbacks for both file browsers
-    auto openPostingsViewCallback = [&postingsViews, &bookmarkManager, &subscriptionManager, &metadataManager, &fileBrowser1, &fileBrowser2, &transcodeQueuePanel, &openInNewWindowCallback, hwnd](const std::wstring& postingsFolderPath, const std::wstring& jobName) {
+    auto openPostingsViewCallback = [&postingsViews, &bookmarkManager, &subscriptionManager, &metadataManager, &fileBrowser1, &fileBrowser2, &transcodeQueuePanel, &openInNewWindowCallback, hwnd, copyFilesCallback](const std::wstring& postingsFolderPath, const std::wstring& jobName) {
         // Check if this postings view is already open
         for (const auto& pv : postingsViews) {
             if (pv && pv->GetPostingsFolderPath() == postingsFolderPath) {
@@ -2055,6 +2167,8 @@ int main(int argc, char** argv)
             ImGui::SetWindowFocus("Transcode Queue");
         };
 
+        postingsView->onCopyFiles = copyFilesCallback;
+
         postingsViews.push_back(std::move(postingsView));
         std::wcout << L"[Main] Opened postings view for: " << postingsFolderPath << std::endl;
     };
@@ -2627,11 +2741,22 @@ int main(int argc, char** argv)
                 if (ImGui::MenuItem("Show Hidden Files", nullptr, &FileBrowser::showHiddenFiles)) {
                     // Toggle for all browsers - static variable shared across instances
                 }
+                if (ImGui::MenuItem("Collapse Image Sequences", nullptr, &FileBrowser::collapseImageSequences)) {
+                    // Shared by browsers and shot render panels - takes effect on next refresh
+                }
                 ImGui::Separator();
                 bool transcodeQueueOpen = transcodeQueuePanel.IsOpen();
                 if (ImGui::MenuItem("Transcode Queue", nullptr, &transcodeQueueOpen)) {
                     transcodeQueuePanel.Toggle();
                 }
+                bool copyQueueOpen = copyQueuePanel.IsOpen();
+                if (ImGui::MenuItem("Copy Queue", nullptr, &copyQueueOpen)) {
+                    copyQueuePanel.Toggle();
+                }
+                bool hashResultsOpen = fileHashPanel.IsOpen();
+                if (ImGui::MenuItem("Hash Results", nullptr, &hashResultsOpen)) {
+                    fileHashPanel.Toggle();
+                }
                 bool deadlineQueueOpen = deadlineQueuePanel.IsOpen();
                 if (ImGui::MenuItem("Deadline Queue", nullptr, &deadlineQueueOpen)) {
                     deadlineQueuePanel.Toggle();
@@ -2946,6 +3071,22 @@ int main(int argc, char** argv)
 
         transcodeQueuePanel.Render();  // Render UI
 
+        // Copy Queue Panel (dockable window, opens itself when a copy is queued)
+        copyQueuePanel.Update();  // Poll engine progress
+
+        // Dock into main dockspace on first use
+        ImGui::SetNextWindowDockID(dockspace_id, ImGuiCond_FirstUseEver);
+
+        copyQueuePanel.Render();  // Render UI
+
+        // Hash Results Panel (dockable window, opens itself when a hash task is queued)
+        fileHashPanel.Update();  // Poll task progress
+
+        // Dock into main dockspace on first use
+        ImGui::SetNextWindowDockID(dockspace_id, ImGuiCond_FirstUseEver);
+
+        fileHashPanel.Render();  // Render UI
+
         // Deadline Queue Panel (dockable window)
         deadlineQueuePanel.ProcessQueue();  // Process deadline jobs
 
@@ -3124,6 +3265,9 @@ int main(int argc, char** argv)
         // Render the path action modal (for command-line paths or paths from other instances)
         RenderPathActionModal();
 
+        // Replace / Skip / Keep Both prompt for pastes and drops onto existing names
+        copyQueuePanel.RenderConflictPrompt();
+
         // Rendering
         ImGui::Render();
         int display_w, display_h;
@@ -3156,6 +3300,18 @@ int main(int argc, char** argv)
         std::cout << "Shutting down SyncManager..." << std::endl;
         syncManager.Shutdown();
 
+        std::cout << "Shutting down FileHashService..." << std::endl;
+        fileHashService.Shutdown();
+
+        std::cout << "Shutting down StorageAnalyzer..." << std::endl;
+        ShotView::storageAnalyzer = nullptr;
+        ProjectTrackerView::storageAnalyzer = nullptr;
+        storageAnalyzer.Shutdown();
+
+        std::cout << "Shutting down FileIndex..." << std::endl;
+        FileBrowser::fileIndex = nullptr;
+        fileIndex.Shutdown();
+
         std::cout << "Shutting down FileBrowser 1..." << std::endl;
         fileBrowser1.Shutdown();
 
@@ -81,6 +81,10 @@ public:
                                                      const std::wstring& expectedDeviceId = L"",
                                                      uint64_t minTimestamp = 0);
 
+    // Change log entry JSON (same format as the device-*.json files; also used for P2P pushes)
+    nlohmann::json ChangeLogEntryToJson(const ChangeLogEntry& entry);
+    ChangeLogEntry JsonToChangeLogEntry(const nlohmann::json& json);
+
     // Shared JSON operations (DEPRECATED - kept for migration)
     bool ReadSharedJSON(const std::wstring& jobPath, std::map<std::wstring, Shot>& outShots);
     bool WriteSharedJSON(const std::wstring& jobPath, const std::map<std::wstring, Shot>& shots);
@@ -123,8 +127,6 @@ private:
     // Change log helpers
     std::filesystem::path GetChangeLogPath(const std::wstring& jobPath, const std::string& deviceId);
     std::filesystem::path GetChangesDirectory(const std::wstring& jobPath);
-    nlohmann::json ChangeLogEntryToJson(const ChangeLogEntry& entry);
-    ChangeLogEntry JsonToChangeLogEntry(const nlohmann::json& json);
 };
 
 } // namespace UFB
@@ -0,0 +1,422 @@
+#ifdef _WIN32
+// IMPORTANT: WinSock2 must be included before windows.h
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include "p2p_discovery.h"
+#include "p2p_transport.h"
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstring>
+
+namespace UFB {
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+constexpr NativeSocket kInvalidSocket = INVALID_SOCKET;
+void CloseNativeSocket(NativeSocket s) { closesocket(s); }
+int LastSocketError() { return WSAGetLastError(); }
+#else
+using NativeSocket = int;
+constexpr NativeSocket kInvalidSocket = -1;
+void CloseNativeSocket(NativeSocket s) { close(s); }
+int LastSocketError() { return errno; }
+#endif
+
+constexpr uint8_t kMagic[4] = {'U', 'F', 'B', 'D'};
+constexpr uint8_t kPacketVersion = 1;
+constexpr size_t kMaxPacketSize = 1024;
+constexpr int kPollIntervalMs = 200;
+
+// Startup announcements (after 0, ~1 and ~3 seconds; the later ones get up to 500 ms of jitter)
+constexpr int kStartupAnnounceDelaysMs[] = {0, 1000, 3000};
+constexpr int kStartupJitterMs = 500;
+
+NativeSocket ToNative(uint64_t s)
+{
+    return static_cast<NativeSocket>(s);
+}
+
+void AppendString(std::vector<uint8_t>& out, const std::string& value)
+{
+    size_t length = (std::min)(value.size(), size_t(255));
+    out.push_back(static_cast<uint8_t>(length));
+    out.insert(out.end(), value.begin(), value.begin() + length);
+}
+
+bool ReadString(const uint8_t*& pos, const uint8_t* end, std::string& out)
+{
+    if (pos >= end)
+    {
+        return false;
+    }
+    size_t length = *pos++;
+    if (static_cast<size_t>(end - pos) < length)
+    {
+        return false;
+    }
+    out.assign(reinterpret_cast<const char*>(pos), length);
+    pos += length;
+    return true;
+}
+
+} // namespace
+
+P2PDiscovery::~P2PDiscovery()
+{
+    Stop();
+}
+
+bool P2PDiscovery::Start(const std::string& deviceId, const std::string& deviceName, uint16_t port, uint32_t protocol,
+                         AnnounceCallback onAnnounce, LeaveCallback onLeave)
+{
+    if (m_isRunning)
+    {
+        return true;
+    }
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        std::cerr << "[P2P] Discovery: WSAStartup failed" << std::endl;
+        return false;
+    }
+#endif
+
+    NativeSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == kInvalidSocket)
+    {
+        std::cerr << "[P2P] Discovery: failed to create UDP socket: " << LastSocketError() << std::endl;
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    // Several instances per host share the port
+    int reuse = 1;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in bindAddr = {};
+    bindAddr.sin_family = AF_INET;
+    bindAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+    bindAddr.sin_port = htons(kPort);
+    if (bind(s, reinterpret_cast<sockaddr*>(&bindAddr), sizeof(bindAddr)) != 0)
+    {
+        std::cerr << "[P2P] Discovery: failed to bind UDP port " << kPort << ": " << LastSocketError() << std::endl;
+        CloseNativeSocket(s);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    // Join the group on the default interface and on every local address (multi-homed hosts)
+    in_addr group = {};
+    inet_pton(AF_INET, kGroupAddress, &group);
+
+    m_interfaces = P2PTransport::GetHostAddresses();
+
+    int joined = 0;
+    ip_mreq membership = {};
+    membership.imr_multiaddr = group;
+    membership.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (setsockopt(s, IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char*>(&membership), sizeof(membership)) == 0)
+    {
+        joined++;
+    }
+    for (const auto& ip : m_interfaces)
+    {
+        if (inet_pton(AF_INET, ip.c_str(), &membership.imr_interface) == 1 &&
+            setsockopt(s, IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char*>(&membership), sizeof(membership)) == 0)
+        {
+            joined++;
+        }
+    }
+
+    if (joined == 0)
+    {
+        std::cerr << "[P2P] Discovery: failed to join multicast group " << kGroupAddress << ": " << LastSocketError() << std::endl;
+        CloseNativeSocket(s);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    // Stay on the LAN, and hear other instances on this host
+    int ttl = 1;
+    setsockopt(s, IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<const char*>(&ttl), sizeof(ttl));
+    int loop = 1;
+    setsockopt(s, IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<const char*>(&loop), sizeof(loop));
+
+    m_socket = static_cast<uint64_t>(s);
+    m_deviceId = deviceId;
+    m_deviceName = deviceName;
+    m_port = port;
+    m_protocol = protocol;
+    m_onAnnounce = std::move(onAnnounce);
+    m_onLeave = std::move(onLeave);
+
+    m_isRunning = true;
+    m_thread = std::thread(&P2PDiscovery::DiscoveryThread, this);
+
+    std::cout << "[P2P] LAN discovery started on " << kGroupAddress << ":" << kPort
+              << " (" << joined << " interface(s))" << std::endl;
+    return true;
+}
+
+void P2PDiscovery::Stop()
+{
+    if (!m_isRunning)
+    {
+        return;
+    }
+
+    m_isRunning = false;
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    // Sent after the thread is gone, which owned the socket until now
+    SendPacket(PacketType::LEAVE);
+
+    CloseNativeSocket(ToNative(m_socket));
+    m_socket = ~uint64_t(0);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+
+    std::cout << "[P2P] LAN discovery stopped" << std::endl;
+}
+
+void P2PDiscovery::AnnounceNow()
+{
+    m_announceRequested = true;
+}
+
+void P2PDiscovery::DiscoveryThread()
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> jitter(0, kAnnounceJitterMs);
+
+    Clock::time_point started = Clock::now();
+    std::vector<Clock::time_point> startupAnnounces;
+    for (int delayMs : kStartupAnnounceDelaysMs)
+    {
+        int jitterMs = delayMs > 0 ? std::uniform_int_distribution<int>(0, kStartupJitterMs)(rng) : 0;
+        startupAnnounces.push_back(started + std::chrono::milliseconds(delayMs + jitterMs));
+    }
+    size_t nextStartup = 0;
+    Clock::time_point nextPeriodic = started + std::chrono::milliseconds(kAnnounceIntervalMs + jitter(rng));
+
+    NativeSocket s = ToNative(m_socket);
+    uint8_t buffer[kMaxPacketSize];
+
+    while (m_isRunning)
+    {
+        Clock::time_point now = Clock::now();
+
+        bool announce = m_announceRequested.exchange(false);
+        if (nextStartup < startupAnnounces.size() && now >= startupAnnounces[nextStartup])
+        {
+            nextStartup++;
+            announce = true;
+        }
+        if (now >= nextPeriodic)
+        {
+            nextPeriodic = now + std::chrono::milliseconds(kAnnounceIntervalMs + jitter(rng));
+            announce = true;
+        }
+        if (announce)
+        {
+            SendPacket(PacketType::ANNOUNCE);
+        }
+
+        // Wait for a packet (short timeout so announcements and Stop are handled promptly)
+#ifdef _WIN32
+        WSAPOLLFD pfd = {};
+        pfd.fd = s;
+        pfd.events = POLLRDNORM;
+        int ready = WSAPoll(&pfd, 1, kPollIntervalMs);
+#else
+        pollfd pfd = {};
+        pfd.fd = s;
+        pfd.events = POLLIN;
+        int ready = poll(&pfd, 1, kPollIntervalMs);
+#endif
+        if (ready <= 0)
+        {
+            continue;
+        }
+
+        // Drain what's queued
+        while (m_isRunning)
+        {
+            sockaddr_in from = {};
+#ifdef _WIN32
+            int fromLength = sizeof(from);
+            int received = recvfrom(s, reinterpret_cast<char*>(buffer), sizeof(buffer), 0,
+                                    reinterpret_cast<sockaddr*>(&from), &fromLength);
+#else
+            socklen_t fromLength = sizeof(from);
+            int received = static_cast<int>(recvfrom(s, buffer, sizeof(buffer), MSG_DONTWAIT,
+                                                     reinterpret_cast<sockaddr*>(&from), &fromLength));
+#endif
+            if (received <= 0)
+            {
+                break;
+            }
+
+            char ipStr[INET_ADDRSTRLEN] = {};
+            inet_ntop(AF_INET, &from.sin_addr, ipStr, INET_ADDRSTRLEN);
+            HandlePacket(buffer, static_cast<size_t>(received), ipStr);
+
+#ifdef _WIN32
+            // No per-call non-blocking flag on WinSock; poll again before the next read
+            WSAPOLLFD more = {};
+            more.fd = s;
+            more.events = POLLRDNORM;
+            if (WSAPoll(&more, 1, 0) <= 0)
+            {
+                break;
+            }
+#endif
+        }
+    }
+}
+
+std::vector<uint8_t> P2PDiscovery::EncodePacket(PacketType type) const
+{
+    std::vector<uint8_t> packet(kMagic, kMagic + sizeof(kMagic));
+    packet.push_back(kPacketVersion);
+    packet.push_back(static_cast<uint8_t>(type));
+    packet.push_back(static_cast<uint8_t>(m_port >> 8));
+    packet.push_back(static_cast<uint8_t>(m_port));
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        packet.push_back(static_cast<uint8_t>(m_protocol >> shift));
+    }
+    AppendString(packet, m_deviceId);
+    AppendString(packet, m_deviceName);
+    return packet;
+}
+
+void P2PDiscovery::SendPacket(PacketType type)
+{
+    NativeSocket s = ToNative(m_socket);
+    if (s == kInvalidSocket)
+    {
+        return;
+    }
+
+    std::vector<uint8_t> packet = EncodePacket(type);
+
+    sockaddr_in groupAddr = {};
+    groupAddr.sin_family = AF_INET;
+    groupAddr.sin_port = htons(kPort);
+    inet_pton(AF_INET, kGroupAddress, &groupAddr.sin_addr);
+
+    auto sendOnce = [&]() {
+        return sendto(s, reinterpret_cast<const char*>(packet.data()), static_cast<int>(packet.size()), 0,
+                      reinterpret_cast<const sockaddr*>(&groupAddr), sizeof(groupAddr)) >= 0;
+    };
+
+    // Out of every interface, so peers on each attached LAN hear us; the default route if none works
+    int sent = 0;
+    for (const auto& ip : m_interfaces)
+    {
+        in_addr outgoing = {};
+        if (inet_pton(AF_INET, ip.c_str(), &outgoing) != 1 ||
+            setsockopt(s, IPPROTO_IP, IP_MULTICAST_IF, reinterpret_cast<const char*>(&outgoing), sizeof(outgoing)) != 0)
+        {
+            continue;
+        }
+        if (sendOnce())
+        {
+            sent++;
+        }
+    }
+
+    if (sent == 0)
+    {
+        in_addr any = {};
+        any.s_addr = htonl(INADDR_ANY);
+        setsockopt(s, IPPROTO_IP, IP_MULTICAST_IF, reinterpret_cast<const char*>(&any), sizeof(any));
+        if (!sendOnce())
+        {
+            std::cerr << "[P2P] Discovery: failed to send packet: " << LastSocketError() << std::endl;
+        }
+    }
+}
+
+void P2PDiscovery::HandlePacket(const uint8_t* data, size_t size, const std::string& sourceIp)
+{
+    // Fixed part: magic, version, type, port, protocol
+    constexpr size_t kHeaderSize = sizeof(kMagic) + 1 + 1 + 2 + 4;
+    if (size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 || data[4] != kPacketVersion)
+    {
+        return;
+    }
+
+    PacketType type = static_cast<PacketType>(data[5]);
+    uint16_t port = static_cast<uint16_t>((data[6] << 8) | data[7]);
+    uint32_t protocol = (uint32_t(data[8]) << 24) | (uint32_t(data[9]) << 16) | (uint32_t(data[10]) << 8) | uint32_t(data[11]);
+
+    const uint8_t* pos = data + kHeaderSize;
+    const uint8_t* end = data + size;
+
+    DiscoveredPeer peer;
+    if (!ReadString(pos, end, peer.deviceId) || !ReadString(pos, end, peer.deviceName) || peer.deviceId.empty())
+    {
+        return;
+    }
+
+    // Our own packets come back through multicast loopback
+    if (peer.deviceId == m_deviceId)
+    {
+        return;
+    }
+
+    if (type == PacketType::ANNOUNCE)
+    {
+        if (port == 0)
+        {
+            return;
+        }
+        peer.ipAddress = sourceIp;
+        peer.port = port;
+        peer.protocol = protocol;
+        if (m_onAnnounce)
+        {
+            m_onAnnounce(peer);
+        }
+    }
+    else if (type == PacketType::LEAVE)
+    {
+        if (m_onLeave)
+        {
+            m_onLeave(peer.deviceId);
+        }
+    }
+}
+
+} // namespace UFB
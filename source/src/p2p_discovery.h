@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <atomic>
+
+namespace UFB {
+
+// Peer seen through a LAN announcement
+struct DiscoveredPeer
+{
+    std::string deviceId;
+    std::string deviceName;
+    std::string ipAddress;      // Source address of the announcement
+    uint16_t port = 0;          // P2P TCP port
+    uint32_t protocol = 0;      // kP2PProtocolVersion of the sender
+};
+
+// LAN peer discovery over UDP multicast (239.255.85.66:49152, TTL 1)
+//
+// - ANNOUNCE on start (three times, to ride out a lost datagram), then every 30 s plus 0-5 s of
+//   random jitter so workstations started together don't announce in lockstep
+// - LEAVE on stop, so peers stop reconnecting to us right away
+// - Every instance joins the group with SO_REUSEADDR and multicast loopback, so several instances
+//   on one host (and a loopback test) see each other
+//
+// Packet: ["UFBD"][version u8][type u8][port u16][protocol u32][deviceId: u8 length + bytes]
+//         [deviceName: u8 length + bytes], integers big-endian
+//
+// Peers across routers (WAN/VPN) don't get multicast; they're still found through the peers
+// registry on the share, which P2PManager keeps as a fallback
+class P2PDiscovery
+{
+public:
+    using AnnounceCallback = std::function<void(const DiscoveredPeer& peer)>;
+    using LeaveCallback = std::function<void(const std::string& deviceId)>;
+
+    static constexpr const char* kGroupAddress = "239.255.85.66";
+    static constexpr uint16_t kPort = 49152;
+    static constexpr int kAnnounceIntervalMs = 30000;
+    static constexpr int kAnnounceJitterMs = 5000;
+
+    P2PDiscovery() = default;
+    ~P2PDiscovery();
+
+    // Join the group and start announcing; callbacks run on the discovery thread and never for
+    // our own packets. False if the socket couldn't be set up (e.g. no multicast route)
+    bool Start(const std::string& deviceId, const std::string& deviceName, uint16_t port, uint32_t protocol,
+               AnnounceCallback onAnnounce, LeaveCallback onLeave);
+
+    // Send LEAVE and stop the thread
+    void Stop();
+
+    // Announce now (e.g. after the listening port changed)
+    void AnnounceNow();
+
+    bool IsRunning() const { return m_isRunning; }
+
+private:
+    enum class PacketType : uint8_t
+    {
+        ANNOUNCE = 1,
+        LEAVE = 2
+    };
+
+    void DiscoveryThread();
+    void SendPacket(PacketType type);
+    void HandlePacket(const uint8_t* data, size_t size, const std::string& sourceIp);
+    std::vector<uint8_t> EncodePacket(PacketType type) const;
+
+    uint64_t m_socket = ~uint64_t(0);
+    std::vector<std::string> m_interfaces;      // Local IPv4 addresses we send from (empty = default route)
+
+    std::string m_deviceId;
+    std::string m_deviceName;
+    uint16_t m_port = 0;
+    uint32_t m_protocol = 0;
+    AnnounceCallback m_onAnnounce;
+    LeaveCallback m_onLeave;
+
+    std::atomic<bool> m_isRunning{false};
+    std::atomic<bool> m_announceRequested{false};
+    std::thread m_thread;
+};
+
+} // namespace UFB
@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <set>
 #include <algorithm>
+#include <cstring>
 
 using json = nlohmann::json;
 
@@ -23,13 +24,7 @@ uint64_t P2PManager::GetCurrentTimestamp()
 // Utility: Get computer name as device name
 std::wstring P2PManager::GetDeviceName()
 {
-    wchar_t computerName[MAX_COMPUTERNAME_LENGTH + 1];
-    DWORD size = MAX_COMPUTERNAME_LENGTH + 1;
-    if (GetComputerNameW(computerName, &size))
-    {
-        return std::wstring(computerName);
-    }
-    return L"Unknown";
+    return P2PTransport::GetHostName();
 }
 
 // Utility: Get all local network IP addresses (excludes 127.0.0.1)
@@ -52,44 +47,17 @@ std::vector<std::string> P2PManager::GetAllLocalIPs()
     // Cache miss or stale - enumerate IP addresses
     std::vector<std::string> ips;
 
-    // Get hostname
-    char hostname[256];
-    if (gethostname(hostname, sizeof(hostname)) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] Failed to get hostname" << std::endl;
-        return ips;
-    }
-
-    // Resolve all addresses for this hostname
-    struct addrinfo hints = {}, *result = nullptr;
-    hints.ai_family = AF_INET;  // IPv4 only
-    hints.ai_socktype = SOCK_STREAM;
-
-    if (getaddrinfo(hostname, nullptr, &hints, &result) != 0)
-    {
-        std::cerr << "[P2P] Failed to resolve local addresses" << std::endl;
-        return ips;
-    }
-
     // Collect all non-loopback IPv4 addresses
     std::set<std::string> uniqueIPs;  // Use set to avoid duplicates
-    for (auto ptr = result; ptr != nullptr; ptr = ptr->ai_next)
+    for (const auto& ip : P2PTransport::GetHostAddresses())
     {
-        sockaddr_in* addr = (sockaddr_in*)ptr->ai_addr;
-        char ipStr[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &addr->sin_addr, ipStr, INET_ADDRSTRLEN);
-
-        std::string ip(ipStr);
-
         // Skip loopback
-        if (ip != "127.0.0.1" && ip != "0.0.0.0")
+        if (ip != "0.0.0.0" && ip.compare(0, 4, "127.") != 0)
         {
             uniqueIPs.insert(ip);
         }
     }
 
-    freeaddrinfo(result);
-
     // Convert set to vector and sort by priority
     // Priority: 192.168.x.x (common LAN) > 10.x.x.x (VPN/corporate) > 172.16-31.x.x > others
     for (const auto& ip : uniqueIPs)
@@ -191,27 +159,17 @@ PeerInfo PeerInfo::FromJson(const json& j)
 
 // Constructor
 P2PManager::P2PManager()
-    : m_listenSocket(INVALID_SOCKET)
-    , m_iocpHandle(NULL)
-    , m_listeningPort(0)
+    : m_listeningPort(0)
     , m_isRunning(false)
     , m_lastWrittenPort(0)
     , m_lastIPRefresh(0)
 {
-    // Initialize WinSock
-    WSADATA wsaData;
-    int result = WSAStartup(MAKEWORD(2, 2), &wsaData);
-    if (result != 0)
-    {
-        std::cerr << "[P2P] WSAStartup failed: " << result << std::endl;
-    }
 }
 
 // Destructor
 P2PManager::~P2PManager()
 {
     Shutdown();
-    WSACleanup();
 }
 
 // Initialize P2P (global, not per-project)
@@ -222,21 +180,37 @@ bool P2PManager::Initialize(const std::wstring& deviceId)
     m_deviceId = deviceId;
     m_deviceName = GetDeviceName();
 
-    // Create IOCP handle
-    m_iocpHandle = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 0);
-    if (m_iocpHandle == NULL)
+    // Start the socket layer (its I/O thread calls back into the handlers below)
+    m_transport = P2PTransport::Create();
+    if (!m_transport)
+    {
+        std::cerr << "[P2P] No socket transport for this platform" << std::endl;
+        return false;
+    }
+
+    P2PTransportHandler handler;
+    handler.onAccepted = [this](P2PConnection socket) { OnConnectionAccepted(socket); };
+    handler.onReceived = [this](P2PConnection socket, const char* data, size_t size) { OnDataReceived(socket, data, size); };
+    handler.onClosed = [this](P2PConnection socket) {
+        std::cout << "[P2P] Connection closed" << std::endl;
+        CloseSocket(socket);
+    };
+
+    if (!m_transport->Start(handler))
     {
-        std::cerr << "[P2P] Failed to create IOCP handle: " << GetLastError() << std::endl;
+        std::cerr << "[P2P] Failed to start socket transport" << std::endl;
+        m_transport.reset();
         return false;
     }
 
-    // Start IOCP worker thread
     m_isRunning = true;
-    m_iocpWorkerThread = std::thread(&P2PManager::IOCPWorkerThread, this);
 
     // Start heartbeat thread (handles peer discovery and keepalives)
     m_heartbeatThread = std::thread(&P2PManager::HeartbeatThread, this);
 
+    // Start the thread that sends coalesced change notifications
+    m_notifyThread = std::thread(&P2PManager::NotifyThread, this);
+
     std::wcout << L"[P2P] Initialized successfully. Device: " << m_deviceName << L" (" << deviceId << L")" << std::endl;
     return true;
 }
@@ -250,19 +224,26 @@ void P2PManager::Shutdown()
     std::cout << "[P2P] Shutting down..." << std::endl;
     m_isRunning = false;
 
+    // Send what's still queued before saying goodbye
+    {
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        m_outboxCV.notify_all();
+    }
+    if (m_notifyThread.joinable())
+        m_notifyThread.join();
+    FlushNotifies();
+
     // Send GOODBYE to all connected peers
     {
         std::lock_guard<std::mutex> lock(m_peersMutex);
-        json payload = {
-            {"deviceId", std::string(m_deviceId.begin(), m_deviceId.end())},
-            {"timestamp", GetCurrentTimestamp()}
-        };
+        P2PMessage goodbye = MakeMessage(P2PMessageType::GOODBYE);
+        goodbye.timestamp = GetCurrentTimestamp();
 
         for (auto& [deviceId, socket] : m_peerToSocket)
         {
             try
             {
-                SendMessage(socket, P2PMessageType::GOODBYE, payload);
+                SendPeerMessage(socket, goodbye);
                 std::cout << "[P2P] Sent GOODBYE to peer" << std::endl;
             }
             catch (const std::exception& e)
@@ -277,7 +258,7 @@ void P2PManager::Shutdown()
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     // Close all peer sockets using proper cleanup
-    std::vector<SOCKET> socketsToClose;
+    std::vector<P2PConnection> socketsToClose;
     {
         std::lock_guard<std::mutex> lock(m_peersMutex);
         for (auto& [deviceId, socket] : m_peerToSocket)
@@ -286,54 +267,41 @@ void P2PManager::Shutdown()
         }
     }
 
-    for (SOCKET socket : socketsToClose)
+    for (P2PConnection socket : socketsToClose)
     {
         CloseSocket(socket);
     }
 
-    // Close listen socket
-    if (m_listenSocket != INVALID_SOCKET)
+    // Send LEAVE on the LAN after the GOODBYEs, so peers drop us instead of reconnecting
+    // (waits for a connect started by an announcement to return)
+    if (m_discovery)
     {
-        closesocket(m_listenSocket);
-        m_listenSocket = INVALID_SOCKET;
+        m_discovery->Stop();
     }
 
-    // Signal IOCP to wake up worker thread
-    if (m_iocpHandle != NULL)
+    // Stop the socket layer (closes the listen socket and remaining connections)
+    if (m_transport)
     {
-        PostQueuedCompletionStatus(m_iocpHandle, 0, 0, NULL);
+        m_transport->Stop();
     }
 
     // Wait for threads to finish
-    if (m_iocpWorkerThread.joinable())
-        m_iocpWorkerThread.join();
-
     if (m_heartbeatThread.joinable())
         m_heartbeatThread.join();
 
-    // Clear all remaining contexts
-    {
-        std::lock_guard<std::mutex> lock(m_contextsMutex);
-        m_activeContexts.clear();
-    }
+    m_discovery.reset();
 
     // Clear all receive buffers
     {
         std::lock_guard<std::mutex> lock(m_buffersMutex);
-        m_receiveBuffers.clear();
+        m_receiveStates.clear();
     }
 
-    // Close IOCP handle
-    if (m_iocpHandle != NULL)
     {
-        CloseHandle(m_iocpHandle);
-        m_iocpHandle = NULL;
+        std::lock_guard<std::mutex> lock(m_peerProtocolsMutex);
+        m_peerProtocols.clear();
     }
 
-    // Cleanup WinSock (only call this once per process, ideally in the destructor)
-    // Note: We don't call WSACleanup() here because other parts of the app might use WinSock
-    // It will be cleaned up automatically when the process exits
-
     std::cout << "[P2P] Shutdown complete" << std::endl;
 }
 
@@ -370,381 +338,168 @@ std::vector<std::wstring> P2PManager::GetSubscribedProjects() const
 // Start listening for connections
 bool P2PManager::StartListening(uint16_t preferredPort)
 {
-    // Create TCP socket
-    m_listenSocket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
-    if (m_listenSocket == INVALID_SOCKET)
-    {
-        std::cerr << "[P2P] Failed to create listen socket: " << WSAGetLastError() << std::endl;
-        return false;
-    }
-
-    // NOTE: SO_REUSEADDR removed - each P2P manager needs a unique port
-    // With SO_REUSEADDR, multiple managers thought they were on the same port,
-    // causing cross-wired connections and lost messages.
-
-    // Bind to port
-    sockaddr_in addr = {};
-    addr.sin_family = AF_INET;
-    addr.sin_addr.s_addr = INADDR_ANY;
-
-    // Try preferred port, or find available port starting from 49152
-    uint16_t portToTry = (preferredPort > 0) ? preferredPort : 49152;
-    bool bound = false;
-
-    for (int attempts = 0; attempts < 100; attempts++)
-    {
-        addr.sin_port = htons(portToTry);
-        if (bind(m_listenSocket, (sockaddr*)&addr, sizeof(addr)) == 0)
-        {
-            bound = true;
-            m_listeningPort = portToTry;
-            break;
-        }
-        portToTry++;
-    }
-
-    if (!bound)
-    {
-        std::cerr << "[P2P] Failed to bind to any port" << std::endl;
-        closesocket(m_listenSocket);
-        m_listenSocket = INVALID_SOCKET;
-        return false;
-    }
-
-    // Listen for connections
-    if (listen(m_listenSocket, SOMAXCONN) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] Listen failed: " << WSAGetLastError() << std::endl;
-        closesocket(m_listenSocket);
-        m_listenSocket = INVALID_SOCKET;
-        return false;
-    }
-
-    // Associate listen socket with IOCP
-    if (CreateIoCompletionPort((HANDLE)m_listenSocket, m_iocpHandle, (ULONG_PTR)m_listenSocket, 0) == NULL)
+    if (!m_transport || !m_transport->Listen(preferredPort, m_listeningPort))
     {
-        std::cerr << "[P2P] Failed to associate listen socket with IOCP: " << GetLastError() << std::endl;
-        closesocket(m_listenSocket);
-        m_listenSocket = INVALID_SOCKET;
         return false;
     }
 
-    // Post initial accept operations
-    for (int i = 0; i < 5; i++)
-    {
-        PostAccept();
-    }
-
     std::cout << "[P2P] Listening on port " << m_listeningPort << std::endl;
 
     // Write our peer info to peers.json
     WritePeerRegistry();
 
-    return true;
-}
-
-// Post an accept operation
-bool P2PManager::PostAccept()
-{
-    // Create accept socket
-    SOCKET acceptSocket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
-    if (acceptSocket == INVALID_SOCKET)
-    {
-        std::cerr << "[P2P] Failed to create accept socket: " << WSAGetLastError() << std::endl;
-        return false;
-    }
-
-    // Create IO context
-    auto context = std::make_shared<IOContext>(IOOperation::Accept, acceptSocket);
-
-    // AcceptEx requires buffer for local and remote addresses
-    context->buffer.resize((sizeof(sockaddr_in) + 16) * 2);
-    context->wsaBuf.buf = context->buffer.data();
-    context->wsaBuf.len = static_cast<ULONG>(context->buffer.size());
-
-    // Load AcceptEx function
-    LPFN_ACCEPTEX lpfnAcceptEx = NULL;
-    GUID guidAcceptEx = WSAID_ACCEPTEX;
-    DWORD dwBytes = 0;
-
-    if (WSAIoctl(m_listenSocket, SIO_GET_EXTENSION_FUNCTION_POINTER,
-                 &guidAcceptEx, sizeof(guidAcceptEx),
-                 &lpfnAcceptEx, sizeof(lpfnAcceptEx),
-                 &dwBytes, NULL, NULL) == SOCKET_ERROR)
+    // Announce ourselves on the LAN (peers that multicast doesn't reach still find us through peers.json)
+    if (!m_discovery)
     {
-        std::cerr << "[P2P] Failed to load AcceptEx: " << WSAGetLastError() << std::endl;
-        closesocket(acceptSocket);
-        return false;
-    }
+        m_discovery = std::make_unique<P2PDiscovery>();
+        std::string deviceIdStr(m_deviceId.begin(), m_deviceId.end());
+        std::string deviceNameStr(m_deviceName.begin(), m_deviceName.end());
 
-    // Call AcceptEx
-    DWORD bytesReceived = 0;
-    if (!lpfnAcceptEx(m_listenSocket, acceptSocket, context->buffer.data(), 0,
-                      sizeof(sockaddr_in) + 16, sizeof(sockaddr_in) + 16,
-                      &bytesReceived, &context->overlapped))
-    {
-        int error = WSAGetLastError();
-        if (error != ERROR_IO_PENDING)
+        if (!m_discovery->Start(deviceIdStr, deviceNameStr, m_listeningPort, kP2PProtocolVersion,
+                                [this](const DiscoveredPeer& peer) { OnPeerAnnounced(peer); },
+                                [this](const std::string& deviceId) { OnPeerLeft(deviceId); }))
         {
-            std::cerr << "[P2P] AcceptEx failed: " << error << std::endl;
-            closesocket(acceptSocket);
-            return false;
+            std::cerr << "[P2P] LAN discovery unavailable, relying on peers.json" << std::endl;
+            m_discovery.reset();
         }
     }
 
-    // Store context in list to keep it alive
-    {
-        std::lock_guard<std::mutex> lock(m_contextsMutex);
-        m_activeContexts.push_back(context);
-    }
-
     return true;
 }
 
-// Post a receive operation
-bool P2PManager::PostReceive(SOCKET socket)
+// A peer announced itself on the LAN
+void P2PManager::OnPeerAnnounced(const DiscoveredPeer& announced)
 {
-    auto context = std::make_shared<IOContext>(IOOperation::Receive, socket);
-
-    DWORD flags = 0;
-    DWORD bytesReceived = 0;
-
-    if (WSARecv(socket, &context->wsaBuf, 1, &bytesReceived, &flags, &context->overlapped, NULL) == SOCKET_ERROR)
-    {
-        int error = WSAGetLastError();
-        if (error != WSA_IO_PENDING)
-        {
-            std::cerr << "[P2P] WSARecv failed: " << error << std::endl;
-            return false;
-        }
-    }
+    std::wstring deviceId(announced.deviceId.begin(), announced.deviceId.end());
 
-    // Store context in list to keep it alive
     {
-        std::lock_guard<std::mutex> lock(m_contextsMutex);
-        m_activeContexts.push_back(context);
-    }
-
-    return true;
-}
-
-// Post a send operation
-bool P2PManager::PostSend(SOCKET socket, const std::vector<char>& data)
-{
-    auto context = std::make_shared<IOContext>(IOOperation::Send, socket);
-    context->buffer = data;
-    context->wsaBuf.buf = context->buffer.data();
-    context->wsaBuf.len = static_cast<ULONG>(context->buffer.size());
-    context->totalBytes = data.size();
-    context->processedBytes = 0;
+        std::lock_guard<std::mutex> lock(m_peersMutex);
 
-    DWORD bytesSent = 0;
-    if (WSASend(socket, &context->wsaBuf, 1, &bytesSent, 0, &context->overlapped, NULL) == SOCKET_ERROR)
-    {
-        int error = WSAGetLastError();
-        if (error != WSA_IO_PENDING)
+        PeerInfo& peer = m_peers[deviceId];
+        if (peer.deviceId.empty())
         {
-            std::cerr << "[P2P] WSASend failed: " << error << std::endl;
-            return false;
+            peer.deviceId = deviceId;
+            peer.isActive = false;
         }
-    }
-
-    // Store context in list to keep it alive
-    {
-        std::lock_guard<std::mutex> lock(m_contextsMutex);
-        m_activeContexts.push_back(context);
-    }
-
-    return true;
-}
-
-// IOCP worker thread
-void P2PManager::IOCPWorkerThread()
-{
-    std::cout << "[P2P] IOCP worker thread started" << std::endl;
-
-    while (m_isRunning)
-    {
-        DWORD bytesTransferred = 0;
-        ULONG_PTR completionKey = 0;
-        LPOVERLAPPED overlapped = NULL;
+        peer.deviceName = std::wstring(announced.deviceName.begin(), announced.deviceName.end());
+        peer.port = announced.port;
 
-        BOOL result = GetQueuedCompletionStatus(m_iocpHandle, &bytesTransferred, &completionKey, &overlapped, 1000);
-
-        if (!result)
+        // The address the announcement came from is reachable; try it first
+        auto it = std::find(peer.ipAddresses.begin(), peer.ipAddresses.end(), announced.ipAddress);
+        if (it != peer.ipAddresses.end())
         {
-            if (overlapped == NULL)
-            {
-                // Timeout or error
-                continue;
-            }
-
-            // I/O operation failed
-            int error = GetLastError();
-            if (error != ERROR_OPERATION_ABORTED)
-            {
-                std::cerr << "[P2P] GetQueuedCompletionStatus failed: " << error << std::endl;
-            }
-            continue;
+            peer.ipAddresses.erase(it);
         }
+        peer.ipAddresses.insert(peer.ipAddresses.begin(), announced.ipAddress);
 
-        if (bytesTransferred == 0 && completionKey == 0 && overlapped == NULL)
+        if (peer.isActive || m_peerToSocket.find(deviceId) != m_peerToSocket.end())
         {
-            // Shutdown signal
-            break;
+            m_pendingAnnounced.erase(deviceId);
+            return;
         }
 
-        // Get IOContext from overlapped
-        IOContext* context = CONTAINING_RECORD(overlapped, IOContext, overlapped);
-
-        // Handle operation
-        try
+        // One connection per pair: the lower device ID connects; the other side announces back right
+        // away so the lower one hears about it without waiting for its next periodic announcement.
+        // Either side connects if nothing happened within 10 seconds (announcements arrive once per
+        // interface, and the HELLO that marks the peer active follows the connect)
+        uint64_t now = GetCurrentTimestamp();
+        auto pending = m_pendingAnnounced.find(deviceId);
+        if (pending == m_pendingAnnounced.end())
         {
-            switch (context->operation)
+            m_pendingAnnounced[deviceId] = now;
+            if (deviceId < m_deviceId)
             {
-            case IOOperation::Accept:
-                HandleAccept(context);
-                break;
-            case IOOperation::Receive:
-                HandleReceive(context, bytesTransferred);
-                break;
-            case IOOperation::Send:
-                HandleSend(context, bytesTransferred);
-                break;
-            default:
-                break;
+                m_discovery->AnnounceNow();
+                return;
             }
         }
-        catch (const std::exception& e)
-        {
-            std::cerr << "[P2P] Exception in IOCP worker: " << e.what() << std::endl;
-        }
-
-        // Remove completed context from list (only if operation is complete)
-        // For partial sends, don't remove - they'll be resubmitted
-        bool shouldRemove = true;
-        if (context->operation == IOOperation::Send)
+        else if (now - pending->second < 10000)
         {
-            // Check if this is a partial send that needs continuation
-            if (context->processedBytes < context->totalBytes)
-            {
-                shouldRemove = false; // Keep context alive for partial send continuation
-            }
+            return;
         }
-
-        if (shouldRemove)
+        else
         {
-            std::lock_guard<std::mutex> lock(m_contextsMutex);
-            m_activeContexts.remove_if([context](const std::shared_ptr<IOContext>& ctx) {
-                return ctx.get() == context;
-            });
+            pending->second = now;
         }
     }
 
-    std::cout << "[P2P] IOCP worker thread stopped" << std::endl;
-}
-
-// Handle accept completion
-void P2PManager::HandleAccept(IOContext* context)
-{
-    SOCKET acceptSocket = context->socket;
-
-    // Validate socket is still active
-    if (acceptSocket == INVALID_SOCKET)
-    {
-        std::cerr << "[P2P] HandleAccept: Invalid socket" << std::endl;
-        PostAccept(); // Post new accept
-        return;
-    }
-
-    std::cout << "[P2P] Accepted new connection" << std::endl;
-
-    // Update accept socket context
-    if (setsockopt(acceptSocket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT,
-                   (char*)&m_listenSocket, sizeof(m_listenSocket)) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] SO_UPDATE_ACCEPT_CONTEXT failed: " << WSAGetLastError() << std::endl;
-        closesocket(acceptSocket);
-        PostAccept(); // Post new accept
-        return;
-    }
+    std::cout << "[P2P] Discovered peer " << announced.deviceName << " at "
+              << announced.ipAddress << ":" << announced.port << " on the LAN" << std::endl;
 
-    // Set TCP_NODELAY to disable Nagle's algorithm (critical for VPNs and real-time)
-    int nodelay = 1;
-    if (setsockopt(acceptSocket, IPPROTO_TCP, TCP_NODELAY, (char*)&nodelay, sizeof(nodelay)) == SOCKET_ERROR)
+    if (!ConnectToPeer(announced.ipAddress, announced.port))
     {
-        std::cerr << "[P2P] Warning: Failed to set TCP_NODELAY on accepted socket: " << WSAGetLastError() << std::endl;
+        std::cout << "[P2P] Failed to connect to discovered peer at " << announced.ipAddress << ":" << announced.port << std::endl;
     }
+}
 
-    // Set SO_KEEPALIVE to detect dead connections over VPN
-    int keepalive = 1;
-    if (setsockopt(acceptSocket, SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, sizeof(keepalive)) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] Warning: Failed to set SO_KEEPALIVE on accepted socket: " << WSAGetLastError() << std::endl;
-    }
+// A peer left the LAN (shut down)
+void P2PManager::OnPeerLeft(const std::string& deviceIdStr)
+{
+    std::wstring deviceId(deviceIdStr.begin(), deviceIdStr.end());
 
-    // Associate accepted socket with IOCP
-    if (CreateIoCompletionPort((HANDLE)acceptSocket, m_iocpHandle, (ULONG_PTR)acceptSocket, 0) == NULL)
+    // Its GOODBYE closes the connection; dropping the entry stops reconnect attempts until it
+    // announces again (or shows up in peers.json)
+    std::lock_guard<std::mutex> lock(m_peersMutex);
+    auto it = m_peers.find(deviceId);
+    if (it != m_peers.end() && !it->second.isActive && m_peerToSocket.find(deviceId) == m_peerToSocket.end())
     {
-        std::cerr << "[P2P] Failed to associate accepted socket with IOCP: " << GetLastError() << std::endl;
-        closesocket(acceptSocket);
-        PostAccept(); // Post new accept
-        return;
+        std::wcout << L"[P2P] Peer left the LAN: " << it->second.deviceName << std::endl;
+        m_peers.erase(it);
     }
+    m_pendingAnnounced.erase(deviceId);
+}
 
+// Incoming connection (before its first receive)
+void P2PManager::OnConnectionAccepted(P2PConnection socket)
+{
     // Send HELLO message
-    SendHello(acceptSocket);
-
-    // Start receiving from this socket
-    PostReceive(acceptSocket);
-
-    // Post new accept
-    PostAccept();
+    SendHello(socket);
 }
 
-// Handle receive completion
-void P2PManager::HandleReceive(IOContext* context, DWORD bytesTransferred)
+// Bytes received on a connection
+void P2PManager::OnDataReceived(P2PConnection socket, const char* data, size_t size)
 {
-    SOCKET socket = context->socket;
-
-    // Validate socket is still active
-    if (socket == INVALID_SOCKET)
-    {
-        std::cerr << "[P2P] HandleReceive: Invalid socket" << std::endl;
-        return;
-    }
-
-    if (bytesTransferred == 0)
-    {
-        // Connection closed
-        std::cout << "[P2P] Connection closed by peer" << std::endl;
-        CloseSocket(socket);
-        return;
-    }
-
     // Flag for closing socket (to avoid deadlock)
     bool shouldClose = false;
     std::string closeReason;
 
-    // Append received data to buffer
+    // Append received data to the connection's ring
+    std::shared_ptr<ReceiveState> state;
     {
         std::lock_guard<std::mutex> lock(m_buffersMutex);
-        auto& buffer = m_receiveBuffers[socket];
-        buffer.insert(buffer.end(), context->buffer.begin(), context->buffer.begin() + bytesTransferred);
+        auto& slot = m_receiveStates[socket];
+        if (!slot)
+        {
+            slot = std::make_shared<ReceiveState>();
+        }
+        state = slot;
+
+        state->buffer.Append(data, size);
 
         // Update last activity timestamp for this buffer
-        m_receiveBufferLastActivity[socket] = GetCurrentTimestamp();
+        state->lastActivity = GetCurrentTimestamp();
+    }
 
-        // Process complete messages (length-prefixed)
-        while (buffer.size() >= 4)
+    // Process complete messages (length-prefixed) in place. Only this I/O thread appends to or
+    // consumes from the ring, so a frame stays valid while its handler runs without the lock
+    // (handlers may close the socket)
+    while (true)
+    {
+        const char* body = nullptr;
+        uint32_t messageLength = 0;
         {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            P2PReceiveRing& buffer = state->buffer;
+            if (state->closed || buffer.Size() < 4)
+            {
+                break;
+            }
+
             // Read message length (first 4 bytes, network byte order)
-            uint32_t messageLength = 0;
-            memcpy(&messageLength, buffer.data(), 4);
-            messageLength = ntohl(messageLength);
+            messageLength = P2PCodec::ReadLength(buffer.Peek(0, 4, state->scratch));
 
             // Sanity check: reject unreasonably large messages (> 10MB)
-            if (messageLength > 10 * 1024 * 1024)
+            if (messageLength > kP2PMaxMessageSize)
             {
                 std::cerr << "[P2P] ERROR: Invalid message length " << messageLength << " bytes, closing connection" << std::endl;
                 shouldClose = true;
@@ -756,61 +511,55 @@ void P2PManager::HandleReceive(IOContext* context, DWORD bytesTransferred)
             if (messageLength == 0)
             {
                 // Track consecutive zero-length messages
-                m_zeroLengthMessageCount[socket]++;
+                state->zeroLengthMessageCount++;
 
                 std::cerr << "[P2P] WARNING: Received zero-length message (count: "
-                          << m_zeroLengthMessageCount[socket] << "), skipping frame" << std::endl;
+                          << state->zeroLengthMessageCount << "), skipping frame" << std::endl;
 
                 // If we've received too many consecutive zero-length messages, the connection is broken
-                if (m_zeroLengthMessageCount[socket] >= 10)
+                if (state->zeroLengthMessageCount >= 10)
                 {
                     std::cerr << "[P2P] ERROR: Too many consecutive zero-length messages, closing connection" << std::endl;
-                    std::cerr << "[P2P] Buffer state - size: " << buffer.size() << " bytes" << std::endl;
+                    std::cerr << "[P2P] Buffer state - size: " << buffer.Size() << " bytes" << std::endl;
 
                     // Print first 64 bytes of buffer for debugging
-                    if (buffer.size() > 0)
+                    size_t previewSize = (buffer.Size() < 64) ? buffer.Size() : 64;
+                    const char* preview = buffer.Peek(0, previewSize, state->scratch);
+                    std::cerr << "[P2P] Buffer preview (first " << previewSize << " bytes):";
+                    for (size_t i = 0; i < previewSize; i++)
                     {
-                        size_t previewSize = (buffer.size() < 64) ? buffer.size() : 64;
-                        std::cerr << "[P2P] Buffer preview (first " << previewSize << " bytes):";
-                        for (size_t i = 0; i < previewSize; i++)
-                        {
-                            std::cerr << " " << std::hex << std::setw(2) << std::setfill('0')
-                                      << (int)(unsigned char)buffer[i];
-                        }
-                        std::cerr << std::dec << std::endl;
+                        std::cerr << " " << std::hex << std::setw(2) << std::setfill('0')
+                                  << (int)(unsigned char)preview[i];
                     }
+                    std::cerr << std::dec << std::endl;
 
                     shouldClose = true;
                     closeReason = "too many zero-length messages";
                     break;
                 }
 
-                buffer.erase(buffer.begin(), buffer.begin() + 4);
+                buffer.Consume(4);
                 continue;
             }
 
             // Reset zero-length counter on valid message
-            m_zeroLengthMessageCount[socket] = 0;
-
-            // Check if we have the complete message
-            if (buffer.size() >= 4 + messageLength)
-            {
-                // Extract message data
-                std::vector<char> messageData(buffer.begin() + 4, buffer.begin() + 4 + messageLength);
-
-                // Process message
-                ProcessMessage(socket, messageData);
+            state->zeroLengthMessageCount = 0;
 
-                // Remove processed message from buffer
-                buffer.erase(buffer.begin(), buffer.begin() + 4 + messageLength);
-            }
-            else
+            // Incomplete message, wait for more data
+            if (buffer.Size() < 4 + size_t(messageLength))
             {
-                // Incomplete message, wait for more data
                 break;
             }
-        }
-    } // Release lock before closing socket
+
+            body = buffer.Peek(4, messageLength, state->scratch);
+        } // Release lock before processing the message
+
+        ProcessMessage(socket, body, messageLength);
+
+        // Remove processed message from buffer
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        state->buffer.Consume(4 + size_t(messageLength));
+    }
 
     // Close socket if needed (outside of lock to prevent deadlock)
     if (shouldClose)
@@ -819,112 +568,62 @@ void P2PManager::HandleReceive(IOContext* context, DWORD bytesTransferred)
         CloseSocket(socket);
         return;
     }
-
-    // Continue receiving
-    PostReceive(socket);
-}
-
-// Handle send completion
-void P2PManager::HandleSend(IOContext* context, DWORD bytesTransferred)
-{
-    SOCKET socket = context->socket;
-    context->processedBytes += bytesTransferred;
-
-    // Check if all data was sent
-    if (context->processedBytes < context->totalBytes)
-    {
-        // Partial send - need to send remaining data
-        size_t remaining = context->totalBytes - context->processedBytes;
-        std::cerr << "[P2P] Partial send: sent " << context->processedBytes << "/"
-                  << context->totalBytes << " bytes, " << remaining << " remaining" << std::endl;
-
-        // Reset overlapped structure for reuse
-        ZeroMemory(&context->overlapped, sizeof(OVERLAPPED));
-
-        // Update buffer pointers for remaining data
-        context->wsaBuf.buf = context->buffer.data() + context->processedBytes;
-        context->wsaBuf.len = static_cast<ULONG>(remaining);
-
-        // Re-post send for remaining data
-        DWORD bytesSent = 0;
-        int result = WSASend(socket, &context->wsaBuf, 1, &bytesSent, 0, &context->overlapped, NULL);
-        if (result == SOCKET_ERROR)
-        {
-            int error = WSAGetLastError();
-            if (error != WSA_IO_PENDING)
-            {
-                std::cerr << "[P2P] WSASend failed on partial send retry: " << error << std::endl;
-                CloseSocket(socket);
-                return;
-            }
-        }
-        // Note: Context is kept alive by m_activeContexts until completion
-    }
-    else
-    {
-        // Send completed successfully - all bytes sent
-        // Context will be automatically cleaned up when it goes out of scope
-    }
 }
 
-// Process received message
-void P2PManager::ProcessMessage(SOCKET socket, const std::vector<char>& messageData)
+// Process received message (binary, or JSON from peers without binary support and for HELLO)
+void P2PManager::ProcessMessage(P2PConnection socket, const char* data, size_t size)
 {
     try
     {
         // Check for empty message
-        if (messageData.empty())
+        if (size == 0)
         {
             std::cerr << "[P2P] WARNING: Received empty message, ignoring" << std::endl;
             return;
         }
 
-        // Parse JSON message
-        std::string jsonStr(messageData.begin(), messageData.end());
+        P2PMessage message;
 
-        // Check for empty JSON string
-        if (jsonStr.empty())
+        if (P2PCodec::IsBinary(data, size))
         {
-            std::cerr << "[P2P] WARNING: Empty JSON string, ignoring" << std::endl;
-            return;
+            if (!P2PCodec::DecodeBinary(data, size, message))
+            {
+                std::cerr << "[P2P] Malformed or unknown binary message (" << size << " bytes, type "
+                          << (size > 1 ? (int)(unsigned char)data[1] : -1) << ")" << std::endl;
+                return;
+            }
         }
+        else
+        {
+            // Parse JSON message
+            json parsed = json::parse(data, data + size);
 
-        json message = json::parse(jsonStr);
+            uint32_t typeValue = parsed.value("type", 0);
+            P2PMessageType type = static_cast<P2PMessageType>(typeValue);
+            json payload = parsed.value("payload", json::object());
 
-        uint32_t typeValue = message.value("type", 0);
-        P2PMessageType type = static_cast<P2PMessageType>(typeValue);
-        json payload = message.value("payload", json::object());
+            if (type == P2PMessageType::HELLO)
+            {
+                OnHelloReceived(socket, payload);
+                return;
+            }
 
-        // Handle based on message type
-        switch (type)
-        {
-        case P2PMessageType::HELLO:
-            OnHelloReceived(socket, payload);
-            break;
-        case P2PMessageType::CHANGE_NOTIFY:
-            OnChangeNotifyReceived(socket, payload);
-            break;
-        case P2PMessageType::PING:
-            OnPingReceived(socket, payload);
-            break;
-        case P2PMessageType::PONG:
-            OnPongReceived(socket, payload);
-            break;
-        case P2PMessageType::GOODBYE:
-            OnGoodbyeReceived(socket, payload);
-            break;
-        default:
-            std::cerr << "[P2P] Unknown message type: " << typeValue << std::endl;
-            break;
+            if (!P2PCodec::FromJsonPayload(type, payload, message))
+            {
+                std::cerr << "[P2P] Unknown message type: " << typeValue << std::endl;
+                return;
+            }
         }
+
+        DispatchMessage(socket, message);
     }
     catch (const json::parse_error& e)
     {
         std::cerr << "[P2P] JSON parse error: " << e.what() << std::endl;
-        std::cerr << "[P2P] Message size: " << messageData.size() << " bytes" << std::endl;
-        if (!messageData.empty() && messageData.size() < 1000)
+        std::cerr << "[P2P] Message size: " << size << " bytes" << std::endl;
+        if (size > 0 && size < 1000)
         {
-            std::string preview(messageData.begin(), messageData.end());
+            std::string preview(data, size);
             std::cerr << "[P2P] Message content: " << preview << std::endl;
         }
     }
@@ -934,75 +633,106 @@ void P2PManager::ProcessMessage(SOCKET socket, const std::vector<char>& messageD
     }
 }
 
-// Create a framed message (length-prefix + JSON)
-std::vector<char> P2PManager::CreateMessage(P2PMessageType type, const json& payload)
+// Handle a decoded message based on its type
+void P2PManager::DispatchMessage(P2PConnection socket, const P2PMessage& message)
 {
-    // Create message JSON
-    json message = {
-        {"type", static_cast<uint32_t>(type)},
-        {"payload", payload}
-    };
-
-    std::string jsonStr = message.dump();
+    switch (message.type)
+    {
+    case P2PMessageType::CHANGE_NOTIFY:
+        OnChangeNotifyReceived(socket, message);
+        break;
+    case P2PMessageType::SYNC_REQUEST:
+        OnSyncRequestReceived(socket, message);
+        break;
+    case P2PMessageType::SYNC_RESPONSE:
+        OnSyncResponseReceived(socket, message);
+        break;
+    case P2PMessageType::PING:
+        OnPingReceived(socket, message);
+        break;
+    case P2PMessageType::PONG:
+        OnPongReceived(socket, message);
+        break;
+    case P2PMessageType::GOODBYE:
+        OnGoodbyeReceived(socket, message);
+        break;
+    case P2PMessageType::SYNC_SUMMARY:
+        OnSyncSummaryReceived(socket, message);
+        break;
+    case P2PMessageType::RANGE_REQUEST:
+        OnRangeRequestReceived(socket, message);
+        break;
+    case P2PMessageType::RANGE_RESPONSE:
+        OnRangeResponseReceived(socket, message);
+        break;
+    default:
+        std::cerr << "[P2P] Unexpected message type: " << static_cast<uint32_t>(message.type) << std::endl;
+        break;
+    }
+}
 
-    // Create framed message: [4-byte length][JSON data]
-    uint32_t messageLength = static_cast<uint32_t>(jsonStr.size());
-    uint32_t networkLength = htonl(messageLength);
+// Protocol version a peer announced in HELLO
+uint32_t P2PManager::GetPeerProtocol(P2PConnection socket)
+{
+    std::lock_guard<std::mutex> lock(m_peerProtocolsMutex);
+    auto it = m_peerProtocols.find(socket);
+    return it != m_peerProtocols.end() ? it->second : 1;
+}
 
-    std::vector<char> framedMessage(4 + jsonStr.size());
-    memcpy(framedMessage.data(), &networkLength, 4);
-    memcpy(framedMessage.data() + 4, jsonStr.data(), jsonStr.size());
+// Send a JSON message to a peer
+void P2PManager::SendPeerMessage(P2PConnection socket, P2PMessageType type, const json& payload)
+{
+    m_transport->Send(socket, P2PCodec::EncodeJson(type, payload));
+}
 
-    return framedMessage;
+// Send a message to a peer in the format it understands
+void P2PManager::SendPeerMessage(P2PConnection socket, const P2PMessage& message)
+{
+    if (GetPeerProtocol(socket) >= kP2PBinaryFramesVersion)
+    {
+        m_transport->Send(socket, P2PCodec::EncodeBinary(message));
+    }
+    else
+    {
+        m_transport->Send(socket, P2PCodec::EncodeJson(message));
+    }
 }
 
-// Send a message to a peer
-void P2PManager::SendMessage(SOCKET socket, P2PMessageType type, const json& payload)
+// Message from this device (deviceId filled in)
+P2PMessage P2PManager::MakeMessage(P2PMessageType type)
 {
-    std::vector<char> message = CreateMessage(type, payload);
-    PostSend(socket, message);
+    P2PMessage message;
+    message.type = type;
+    message.deviceId = std::string(m_deviceId.begin(), m_deviceId.end());
+    return message;
 }
 
 // Send HELLO message
-void P2PManager::SendHello(SOCKET socket)
+void P2PManager::SendHello(P2PConnection socket)
 {
     json payload = {
         {"deviceId", std::string(m_deviceId.begin(), m_deviceId.end())},
         {"deviceName", std::string(m_deviceName.begin(), m_deviceName.end())},
         {"port", m_listeningPort},
-        {"timestamp", GetCurrentTimestamp()}
+        {"timestamp", GetCurrentTimestamp()},
+        {"protocol", kP2PProtocolVersion}
     };
 
-    SendMessage(socket, P2PMessageType::HELLO, payload);
+    SendPeerMessage(socket, P2PMessageType::HELLO, payload);
     std::cout << "[P2P] Sent HELLO to peer" << std::endl;
 }
 
-// Send change notification
-void P2PManager::SendChangeNotify(SOCKET socket, const std::wstring& jobPath, uint64_t timestamp)
-{
-    std::string jobPathStr(jobPath.begin(), jobPath.end());
-
-    json payload = {
-        {"jobPath", jobPathStr},
-        {"deviceId", std::string(m_deviceId.begin(), m_deviceId.end())},
-        {"timestamp", timestamp}  // Use exact timestamp from change log entry
-    };
-
-    SendMessage(socket, P2PMessageType::CHANGE_NOTIFY, payload);
-}
-
 // Send PING
-void P2PManager::SendPing(SOCKET socket)
+void P2PManager::SendPing(P2PConnection socket)
 {
-    json payload = {
-        {"timestamp", GetCurrentTimestamp()}
-    };
+    P2PMessage message = MakeMessage(P2PMessageType::PING);
+    message.timestamp = GetCurrentTimestamp();
 
-    SendMessage(socket, P2PMessageType::PING, payload);
+    SendPeerMessage(socket, message);
 }
 
 // Handle HELLO received
-void P2PManager::OnHelloReceived(SOCKET socket, const json& payload)
+void P2PManager::OnHelloReceived(P2PConnection socket, const json& payload)
 {
     try
     {
@@ -1015,206 +745,697 @@ void P2PManager::OnHelloReceived(SOCKET socket, const json& payload)
 
         std::wcout << L"[P2P] Received HELLO from " << deviceName << L" (" << deviceId << L")" << std::endl;
 
-        // Get peer IP address from the actual socket connection
-        sockaddr_in peerAddr;
-        int peerAddrLen = sizeof(peerAddr);
-        if (getpeername(socket, (sockaddr*)&peerAddr, &peerAddrLen) == 0)
-        {
-            char ipStr[INET_ADDRSTRLEN];
-            inet_ntop(AF_INET, &peerAddr.sin_addr, ipStr, INET_ADDRSTRLEN);
+        // Peers from before the binary format don't send "protocol" and keep getting JSON
+        {
+            std::lock_guard<std::mutex> lock(m_peerProtocolsMutex);
+            m_peerProtocols[socket] = payload.value("protocol", 1u);
+        }
+
+        // Get peer IP address from the actual socket connection
+        std::string ipStr = m_transport->GetPeerAddress(socket);
+        if (!ipStr.empty())
+        {
+
+            // Determine if this is a new connection (peer was not previously active)
+            bool wasInactive = false;
+            {
+                std::lock_guard<std::mutex> lock(m_peersMutex);
+
+                // Check if we already have this peer's info from peers.json
+                auto existingPeer = m_peers.find(deviceId);
+                PeerInfo peer;
+
+                if (existingPeer != m_peers.end())
+                {
+                    // Keep existing IPs but ensure the connected IP is first
+                    peer = existingPeer->second;
+                    wasInactive = !peer.isActive;  // Track if peer was previously inactive
+
+                    // Remove the connected IP if it's already in the list
+                    auto it = std::find(peer.ipAddresses.begin(), peer.ipAddresses.end(), ipStr);
+                    if (it != peer.ipAddresses.end())
+                    {
+                        peer.ipAddresses.erase(it);
+                    }
+
+                    // Add connected IP at the front (highest priority)
+                    peer.ipAddresses.insert(peer.ipAddresses.begin(), ipStr);
+                }
+                else
+                {
+                    // New peer - create entry with connected IP
+                    peer.deviceId = deviceId;
+                    peer.deviceName = deviceName;
+                    peer.ipAddresses.push_back(ipStr);
+                    wasInactive = true;  // Brand new peer
+                }
+
+                peer.port = port;
+                peer.lastSeen = GetCurrentTimestamp();
+                peer.isActive = true;
+
+                m_peers[deviceId] = peer;
+                m_socketToPeer[socket] = deviceId;
+                m_peerToSocket[deviceId] = socket;
+
+                std::wcout << L"[P2P] Registered peer: " << deviceName << L" at " << std::wstring(ipStr.begin(), ipStr.end()) << L":" << port << std::endl;
+            }
+
+            // Trigger peer connected callback if this is a new/reconnected peer
+            // Call outside of mutex to avoid deadlock
+            if (wasInactive)
+            {
+                std::function<void(const std::wstring&, const std::wstring&)> callback;
+                {
+                    std::lock_guard<std::mutex> lock(m_callbackMutex);
+                    callback = m_peerConnectedCallback;
+                }
+
+                if (callback)
+                {
+                    try
+                    {
+                        std::wcout << L"[P2P] Triggering peer connected callback for: " << deviceName << std::endl;
+                        callback(deviceId, deviceName);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::cerr << "[P2P] Exception in peer connected callback: " << e.what() << std::endl;
+                    }
+                    catch (...)
+                    {
+                        std::cerr << "[P2P] Unknown exception in peer connected callback" << std::endl;
+                    }
+                }
+            }
+        }
+
+        // Don't send HELLO back - we already sent it when accepting or connecting
+        // Sending another HELLO would create an infinite loop
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[P2P] Error handling HELLO: " << e.what() << std::endl;
+    }
+}
+
+// Handle CHANGE_NOTIFY received
+void P2PManager::OnChangeNotifyReceived(P2PConnection /*socket*/, const P2PMessage& message)
+{
+    try
+    {
+        // Validate payload
+        if (message.jobPath.empty() || message.deviceId.empty() || message.timestamp == 0)
+        {
+            std::cerr << "[P2P] ERROR: CHANGE_NOTIFY has empty fields" << std::endl;
+            return;
+        }
+
+        std::wstring jobPath(message.jobPath.begin(), message.jobPath.end());
+        std::wstring peerDeviceId(message.deviceId.begin(), message.deviceId.end());
+        uint64_t timestamp = message.timestamp;
+
+        std::wcout << L"[P2P] Received CHANGE_NOTIFY for job: " << jobPath << L" from device: " << peerDeviceId
+                   << L" timestamp: " << timestamp << std::endl;
+
+        // Entries pushed along: apply them directly, the share is only read if that fails
+        if (message.entries.is_array() && !message.entries.empty())
+        {
+            P2PChangeBatch batch;
+            batch.jobPath = jobPath;
+            batch.deviceId = peerDeviceId;
+            batch.previousTimestamp = message.previousTimestamp;
+            batch.entries = message.entries;
+
+            if (DeliverEntries(batch))
+            {
+                return;
+            }
+
+            std::cerr << "[P2P] Pushed entries not applied, falling back to change log read" << std::endl;
+        }
+
+        // Trigger change callback (copy callback to avoid holding lock during call)
+        std::function<void(const std::wstring&, const std::wstring&, uint64_t)> callback;
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            callback = m_changeCallback;
+        }
+
+        // Call callback outside of lock to prevent deadlock
+        if (callback)
+        {
+            try
+            {
+                callback(jobPath, peerDeviceId, timestamp);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[P2P] Exception in change callback: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                std::cerr << "[P2P] Unknown exception in change callback" << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[P2P] Error handling CHANGE_NOTIFY: " << e.what() << std::endl;
+    }
+}
+
+// Handle SYNC_REQUEST received (peer asks for our entries of a job newer than a timestamp)
+void P2PManager::OnSyncRequestReceived(P2PConnection socket, const P2PMessage& message)
+{
+    try
+    {
+        if (message.jobPath.empty())
+        {
+            std::cerr << "[P2P] ERROR: SYNC_REQUEST missing jobPath" << std::endl;
+            return;
+        }
+
+        std::wstring jobPath(message.jobPath.begin(), message.jobPath.end());
+
+        std::function<json(const std::wstring&, uint64_t)> callback;
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            callback = m_syncRequestCallback;
+        }
+
+        P2PMessage response = MakeMessage(P2PMessageType::SYNC_RESPONSE);
+        response.jobPath = message.jobPath;
+        response.since = message.since;
+        response.entries = json::array();
+
+        if (callback)
+        {
+            try
+            {
+                response.entries = callback(jobPath, message.since);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[P2P] Exception in sync request callback: " << e.what() << std::endl;
+                response.entries = json::array();
+            }
+        }
+
+        SendPeerMessage(socket, response);
+
+        std::wcout << L"[P2P] Answered SYNC_REQUEST for job: " << jobPath << L" since " << message.since
+                   << L" with " << response.entries.size() << L" entries" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[P2P] Error handling SYNC_REQUEST: " << e.what() << std::endl;
+    }
+}
+
+// Handle SYNC_RESPONSE received
+void P2PManager::OnSyncResponseReceived(P2PConnection /*socket*/, const P2PMessage& message)
+{
+    try
+    {
+        if (message.jobPath.empty() || message.deviceId.empty())
+        {
+            std::cerr << "[P2P] ERROR: SYNC_RESPONSE missing required fields" << std::endl;
+            return;
+        }
+
+        P2PChangeBatch batch;
+        batch.jobPath = std::wstring(message.jobPath.begin(), message.jobPath.end());
+        batch.deviceId = std::wstring(message.deviceId.begin(), message.deviceId.end());
+        batch.entries = message.entries.is_array() ? message.entries : json::array();
+
+        std::wcout << L"[P2P] Received SYNC_RESPONSE for job: " << batch.jobPath << L" from device: " << batch.deviceId
+                   << L" (" << batch.entries.size() << L" entries)" << std::endl;
+
+        // Nothing to fall back to here: entries that can't be applied arrive through the share
+        if (!batch.entries.empty())
+        {
+            DeliverEntries(batch);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[P2P] Error handling SYNC_RESPONSE: " << e.what() << std::endl;
+    }
+}
+
+// Hand pushed entries to the entries callback (true if applied)
+bool P2PManager::DeliverEntries(const P2PChangeBatch& batch)
+{
+    std::function<bool(const P2PChangeBatch&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        callback = m_entriesCallback;
+    }
+
+    if (!callback)
+    {
+        return false;
+    }
+
+    try
+    {
+        return callback(batch);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[P2P] Exception in entries callback: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "[P2P] Unknown exception in entries callback" << std::endl;
+    }
+    return false;
+}
+
+// Handle PING received
+void P2PManager::OnPingReceived(P2PConnection socket, const P2PMessage& /*message*/)
+{
+    // Send PONG response
+    P2PMessage pong = MakeMessage(P2PMessageType::PONG);
+    pong.timestamp = GetCurrentTimestamp();
+
+    SendPeerMessage(socket, pong);
+}
+
+// Handle PONG received
+void P2PManager::OnPongReceived(P2PConnection socket, const P2PMessage& /*message*/)
+{
+    // Update last seen time for this peer
+    std::lock_guard<std::mutex> lock(m_peersMutex);
+    auto it = m_socketToPeer.find(socket);
+    if (it != m_socketToPeer.end())
+    {
+        auto peerIt = m_peers.find(it->second);
+        if (peerIt != m_peers.end())
+        {
+            peerIt->second.lastSeen = GetCurrentTimestamp();
+        }
+    }
+}
+
+// Handle GOODBYE received
+void P2PManager::OnGoodbyeReceived(P2PConnection socket, const P2PMessage& message)
+{
+    std::wstring deviceId(message.deviceId.begin(), message.deviceId.end());
+
+    std::wcout << L"[P2P] Received GOODBYE from " << deviceId << L", closing connection" << std::endl;
+
+    // Close the socket gracefully
+    CloseSocket(socket);
+}
+
+// Handle SYNC_SUMMARY received
+void P2PManager::OnSyncSummaryReceived(P2PConnection /*socket*/, const P2PMessage& message)
+{
+    if (message.jobPath.empty() || message.deviceId.empty() || !message.summary.is_object())
+    {
+        std::cerr << "[P2P] ERROR: SYNC_SUMMARY missing required fields" << std::endl;
+        return;
+    }
+
+    std::function<void(const std::wstring&, const std::wstring&, const json&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        callback = m_summaryCallback;
+    }
+
+    if (!callback)
+    {
+        return;
+    }
+
+    try
+    {
+        callback(std::wstring(message.deviceId.begin(), message.deviceId.end()),
+                 std::wstring(message.jobPath.begin(), message.jobPath.end()), message.summary);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[P2P] Exception in summary callback: " << e.what() << std::endl;
+    }
+}
+
+// Handle RANGE_REQUEST received (peer asks for our current shots of some buckets)
+void P2PManager::OnRangeRequestReceived(P2PConnection socket, const P2PMessage& message)
+{
+    if (message.jobPath.empty())
+    {
+        std::cerr << "[P2P] ERROR: RANGE_REQUEST missing jobPath" << std::endl;
+        return;
+    }
+
+    std::function<json(const std::wstring&, const std::vector<uint32_t>&, const std::vector<uint64_t>&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        callback = m_rangeRequestCallback;
+    }
+
+    json shots = json::array();
+    if (callback)
+    {
+        try
+        {
+            shots = callback(std::wstring(message.jobPath.begin(), message.jobPath.end()), message.buckets, message.knownShots);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[P2P] Exception in range request callback: " << e.what() << std::endl;
+            shots = json::array();
+        }
+    }
+
+    // Large answers go out in several responses under the frame limit (the peer drops the connection
+    // on larger frames); each is a set of current shots the peer applies on its own
+    P2PMessage response = MakeMessage(P2PMessageType::RANGE_RESPONSE);
+    response.jobPath = message.jobPath;
+    response.buckets = message.buckets;
+    response.entries = json::array();
+
+    size_t responses = 0;
+    size_t pieceBytes = 0;
+    for (auto& shot : shots)
+    {
+        size_t shotBytes = json::to_msgpack(shot).size();
+        if (!response.entries.empty() &&
+            (response.entries.size() >= kP2PMaxEntriesPerMessage || pieceBytes + shotBytes > kP2PMaxEntryBytesPerMessage))
+        {
+            SendPeerMessage(socket, response);
+            responses++;
+            response.entries = json::array();
+            pieceBytes = 0;
+        }
+        response.entries.push_back(std::move(shot));
+        pieceBytes += shotBytes;
+    }
+    if (!response.entries.empty() || responses == 0)
+    {
+        SendPeerMessage(socket, response);
+        responses++;
+    }
+
+    std::cout << "[P2P] Answered RANGE_REQUEST (" << message.buckets.size() << " buckets) with "
+              << shots.size() << " shots in " << responses << " response(s)" << std::endl;
+}
+
+// Handle RANGE_RESPONSE received
+void P2PManager::OnRangeResponseReceived(P2PConnection /*socket*/, const P2PMessage& message)
+{
+    if (message.jobPath.empty() || message.deviceId.empty())
+    {
+        std::cerr << "[P2P] ERROR: RANGE_RESPONSE missing required fields" << std::endl;
+        return;
+    }
+
+    P2PChangeBatch batch;
+    batch.jobPath = std::wstring(message.jobPath.begin(), message.jobPath.end());
+    batch.deviceId = std::wstring(message.deviceId.begin(), message.deviceId.end());
+    batch.entries = message.entries.is_array() ? message.entries : json::array();
+    batch.currentState = true;
+
+    std::wcout << L"[P2P] Received RANGE_RESPONSE for job: " << batch.jobPath << L" from device: " << batch.deviceId
+               << L" (" << batch.entries.size() << L" shots)" << std::endl;
+
+    if (!batch.entries.empty())
+    {
+        DeliverEntries(batch);
+    }
+}
+
+// Notify all peers of a change
+void P2PManager::NotifyPeersOfChange(const std::wstring& jobPath, uint64_t timestamp,
+                                     const json& entries, uint64_t previousTimestamp)
+{
+    std::lock_guard<std::mutex> peersLock(m_peersMutex);
+    if (m_peerToSocket.empty())
+    {
+        return;
+    }
 
-            // Determine if this is a new connection (peer was not previously active)
-            bool wasInactive = false;
-            {
-                std::lock_guard<std::mutex> lock(m_peersMutex);
+    std::lock_guard<std::mutex> lock(m_outboxMutex);
 
-                // Check if we already have this peer's info from peers.json
-                auto existingPeer = m_peers.find(deviceId);
-                PeerInfo peer;
+    // Batch of this window for the job, shared by every peer that isn't behind
+    std::shared_ptr<PendingNotify>& open = m_openNotifies[jobPath];
+    if (!open)
+    {
+        open = std::make_shared<PendingNotify>();
+        open->message = MakeMessage(P2PMessageType::CHANGE_NOTIFY);
+        open->message.jobPath = std::string(jobPath.begin(), jobPath.end());
+        open->message.previousTimestamp = previousTimestamp;
+        open->message.entries = json::array();
+    }
+    MergeNotify(*open, timestamp, entries);
 
-                if (existingPeer != m_peers.end())
-                {
-                    // Keep existing IPs but ensure the connected IP is first
-                    peer = existingPeer->second;
-                    wasInactive = !peer.isActive;  // Track if peer was previously inactive
+    bool wasEmpty = m_outboxes.empty();
 
-                    // Remove the connected IP if it's already in the list
-                    auto it = std::find(peer.ipAddresses.begin(), peer.ipAddresses.end(), ipStr);
-                    if (it != peer.ipAddresses.end())
-                    {
-                        peer.ipAddresses.erase(it);
-                    }
+    for (auto& [deviceId, socket] : m_peerToSocket)
+    {
+        std::shared_ptr<PendingNotify>& queued = m_outboxes[deviceId][jobPath];
+        if (!queued)
+        {
+            queued = open;
+        }
+        else if (queued != open)
+        {
+            // Held back from an earlier window (slow peer): merge into a copy of its own batch
+            auto merged = std::make_shared<PendingNotify>();
+            merged->message = queued->message;
+            merged->entryIndex = queued->entryIndex;
+            merged->withoutEntries = queued->withoutEntries;
+            merged->changeCount = queued->changeCount;
+            MergeNotify(*merged, timestamp, entries);
+            queued = merged;
+        }
+    }
 
-                    // Add connected IP at the front (highest priority)
-                    peer.ipAddresses.insert(peer.ipAddresses.begin(), ipStr);
-                }
-                else
-                {
-                    // New peer - create entry with connected IP
-                    peer.deviceId = deviceId;
-                    peer.deviceName = deviceName;
-                    peer.ipAddresses.push_back(ipStr);
-                    wasInactive = true;  // Brand new peer
-                }
+    // First change after a quiet period goes out right away, the rest of a burst waits for the window
+    if (wasEmpty)
+    {
+        m_nextNotifyFlush = (std::max)(m_nextNotifyFlush, std::chrono::steady_clock::now());
+        m_outboxCV.notify_one();
+    }
+}
 
-                peer.port = port;
-                peer.lastSeen = GetCurrentTimestamp();
-                peer.isActive = true;
+// Merge one notification into a batch
+void P2PManager::MergeNotify(PendingNotify& batch, uint64_t timestamp, const json& entries)
+{
+    batch.changeCount++;
+    batch.message.timestamp = (std::max)(batch.message.timestamp, timestamp);
 
-                m_peers[deviceId] = peer;
-                m_socketToPeer[socket] = deviceId;
-                m_peerToSocket[deviceId] = socket;
+    if (batch.withoutEntries)
+    {
+        return;
+    }
 
-                std::wcout << L"[P2P] Registered peer: " << deviceName << L" at " << std::wstring(ipStr, ipStr + strlen(ipStr)).c_str() << L":" << port << std::endl;
-            }
+    // A notification without entries means "re-read the share", which the merged one has to keep
+    if (!entries.is_array() || entries.empty())
+    {
+        batch.withoutEntries = true;
+        batch.message.entries = json();
+        batch.entryIndex.clear();
+        return;
+    }
 
-            // Trigger peer connected callback if this is a new/reconnected peer
-            // Call outside of mutex to avoid deadlock
-            if (wasInactive)
+    // Latest entry per shot (entries arrive oldest first)
+    for (const auto& entry : entries)
+    {
+        std::string shotPath = entry.is_object() ? entry.value("shotPath", "") : "";
+        auto it = shotPath.empty() ? batch.entryIndex.end() : batch.entryIndex.find(shotPath);
+        if (it != batch.entryIndex.end())
+        {
+            batch.message.entries[it->second] = entry;
+        }
+        else
+        {
+            if (!shotPath.empty())
             {
-                std::function<void(const std::wstring&, const std::wstring&)> callback;
-                {
-                    std::lock_guard<std::mutex> lock(m_callbackMutex);
-                    callback = m_peerConnectedCallback;
-                }
-
-                if (callback)
-                {
-                    try
-                    {
-                        std::wcout << L"[P2P] Triggering peer connected callback for: " << deviceName << std::endl;
-                        callback(deviceId, deviceName);
-                    }
-                    catch (const std::exception& e)
-                    {
-                        std::cerr << "[P2P] Exception in peer connected callback: " << e.what() << std::endl;
-                    }
-                    catch (...)
-                    {
-                        std::cerr << "[P2P] Unknown exception in peer connected callback" << std::endl;
-                    }
-                }
+                batch.entryIndex[shotPath] = batch.message.entries.size();
             }
+            batch.message.entries.push_back(entry);
         }
-
-        // Don't send HELLO back - we already sent it when accepting or connecting
-        // Sending another HELLO would create an infinite loop
     }
-    catch (const std::exception& e)
+
+    if (batch.message.entries.size() > kMaxCoalescedEntries)
     {
-        std::cerr << "[P2P] Error handling HELLO: " << e.what() << std::endl;
+        batch.withoutEntries = true;
+        batch.message.entries = json();
+        batch.entryIndex.clear();
     }
 }
 
-// Handle CHANGE_NOTIFY received
-void P2PManager::OnChangeNotifyReceived(SOCKET socket, const json& payload)
+// Sends coalesced notifications when their window closes
+void P2PManager::NotifyThread()
 {
-    try
+    std::unique_lock<std::mutex> lock(m_outboxMutex);
+
+    while (m_isRunning)
     {
-        // Validate payload
-        if (!payload.contains("jobPath") || !payload.contains("deviceId") || !payload.contains("timestamp"))
+        if (m_outboxes.empty())
         {
-            std::cerr << "[P2P] ERROR: CHANGE_NOTIFY missing required fields" << std::endl;
-            return;
+            m_outboxCV.wait(lock, [this]() { return !m_isRunning || !m_outboxes.empty(); });
+            continue;
         }
 
-        std::string jobPathStr = payload.value("jobPath", "");
-        std::string peerDeviceIdStr = payload.value("deviceId", "");
-        uint64_t timestamp = payload.value("timestamp", uint64_t(0));
-
-        if (jobPathStr.empty() || peerDeviceIdStr.empty() || timestamp == 0)
+        if (m_outboxCV.wait_until(lock, m_nextNotifyFlush, [this]() { return !m_isRunning; }))
         {
-            std::cerr << "[P2P] ERROR: CHANGE_NOTIFY has empty fields" << std::endl;
-            return;
+            break;
         }
 
-        std::wstring jobPath(jobPathStr.begin(), jobPathStr.end());
-        std::wstring peerDeviceId(peerDeviceIdStr.begin(), peerDeviceIdStr.end());
+        lock.unlock();
+        FlushNotifies();
+        lock.lock();
+    }
+}
+
+// Send the queued notifications of every peer that keeps up
+void P2PManager::FlushNotifies()
+{
+    std::map<P2PConnection, std::vector<std::shared_ptr<PendingNotify>>> sends;
+    size_t heldBack = 0;
 
-        std::wcout << L"[P2P] Received CHANGE_NOTIFY for job: " << jobPath << L" from device: " << peerDeviceId
-                   << L" timestamp: " << timestamp << std::endl;
+    {
+        std::lock_guard<std::mutex> peersLock(m_peersMutex);
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
 
-        // Trigger change callback (copy callback to avoid holding lock during call)
-        std::function<void(const std::wstring&, const std::wstring&, uint64_t)> callback;
-        {
-            std::lock_guard<std::mutex> lock(m_callbackMutex);
-            callback = m_changeCallback;
-        }
+        // Close the window: changes from now on start new batches
+        m_openNotifies.clear();
+        m_nextNotifyFlush = std::chrono::steady_clock::now() + std::chrono::milliseconds(kNotifyCoalesceMs);
 
-        // Call callback outside of lock to prevent deadlock
-        if (callback)
+        for (auto it = m_outboxes.begin(); it != m_outboxes.end();)
         {
-            try
+            auto socketIt = m_peerToSocket.find(it->first);
+            if (socketIt == m_peerToSocket.end())
             {
-                callback(jobPath, peerDeviceId, timestamp);
+                it = m_outboxes.erase(it);
+                continue;
             }
-            catch (const std::exception& e)
+
+            // Backpressure: a peer that hasn't taken the last frames keeps merging into its batches
+            if (m_transport->GetPendingSendBytes(socketIt->second) > kMaxPendingSendBytes)
             {
-                std::cerr << "[P2P] Exception in change callback: " << e.what() << std::endl;
+                heldBack++;
+                ++it;
+                continue;
             }
-            catch (...)
+
+            for (auto& [jobPath, batch] : it->second)
             {
-                std::cerr << "[P2P] Unknown exception in change callback" << std::endl;
+                sends[socketIt->second].push_back(batch);
             }
+            it = m_outboxes.erase(it);
         }
     }
-    catch (const std::exception& e)
+
+    if (heldBack > 0)
     {
-        std::cerr << "[P2P] Error handling CHANGE_NOTIFY: " << e.what() << std::endl;
+        std::cout << "[P2P] Holding back change notifications for " << heldBack << " slow peer(s)" << std::endl;
+    }
+
+    // Encode once per batch and format (only this thread touches the frames); a peer's batches
+    // go out as one send
+    size_t messageCount = 0;
+    size_t changeCount = 0;
+    for (auto& [socket, batches] : sends)
+    {
+        bool binary = GetPeerProtocol(socket) >= kP2PBinaryFramesVersion;
+
+        std::vector<char> data;
+        for (auto& batch : batches)
+        {
+            std::vector<char>& frame = binary ? batch->binaryFrame : batch->jsonFrame;
+            if (frame.empty())
+                frame = binary ? P2PCodec::EncodeBinary(batch->message) : P2PCodec::EncodeJson(batch->message);
+            data.insert(data.end(), frame.begin(), frame.end());
+            messageCount++;
+            changeCount += batch->changeCount;
+        }
+
+        m_transport->Send(socket, std::move(data));
+    }
+
+    if (!sends.empty())
+    {
+        std::cout << "[P2P] Sent " << messageCount << " CHANGE_NOTIFY message(s) carrying " << changeCount
+                  << " change(s) to " << sends.size() << " peer(s)" << std::endl;
     }
 }
 
-// Handle PING received
-void P2PManager::OnPingReceived(SOCKET socket, const json& payload)
+// Ask one peer for its entries of a job
+bool P2PManager::RequestChanges(const std::wstring& peerDeviceId, const std::wstring& jobPath, uint64_t sinceTimestamp)
 {
-    // Send PONG response
-    json pongPayload = {
-        {"timestamp", GetCurrentTimestamp()}
-    };
+    std::lock_guard<std::mutex> lock(m_peersMutex);
 
-    SendMessage(socket, P2PMessageType::PONG, pongPayload);
+    auto it = m_peerToSocket.find(peerDeviceId);
+    if (it == m_peerToSocket.end())
+    {
+        return false;
+    }
+
+    P2PMessage message = MakeMessage(P2PMessageType::SYNC_REQUEST);
+    message.jobPath = std::string(jobPath.begin(), jobPath.end());
+    message.since = sinceTimestamp;
+
+    SendPeerMessage(it->second, message);
+
+    std::wcout << L"[P2P] Sent SYNC_REQUEST to " << peerDeviceId << L" for job: " << jobPath
+               << L" since " << sinceTimestamp << std::endl;
+    return true;
 }
 
-// Handle PONG received
-void P2PManager::OnPongReceived(SOCKET socket, const json& payload)
+// Send a job summary to one or all peers
+void P2PManager::SendSyncSummary(const std::wstring& peerDeviceId, const std::wstring& jobPath, const json& summary)
 {
-    // Update last seen time for this peer
+    P2PMessage message = MakeMessage(P2PMessageType::SYNC_SUMMARY);
+    message.jobPath = std::string(jobPath.begin(), jobPath.end());
+    message.summary = summary;
+
     std::lock_guard<std::mutex> lock(m_peersMutex);
-    auto it = m_socketToPeer.find(socket);
-    if (it != m_socketToPeer.end())
+
+    for (auto& [deviceId, socket] : m_peerToSocket)
     {
-        auto peerIt = m_peers.find(it->second);
-        if (peerIt != m_peers.end())
+        if ((peerDeviceId.empty() || deviceId == peerDeviceId) && GetPeerProtocol(socket) >= kP2PAntiEntropyVersion)
         {
-            peerIt->second.lastSeen = GetCurrentTimestamp();
+            SendPeerMessage(socket, message);
         }
     }
 }
 
-// Handle GOODBYE received
-void P2PManager::OnGoodbyeReceived(SOCKET socket, const json& payload)
+// Whether a peer announced the anti-entropy protocol in HELLO
+bool P2PManager::SupportsAntiEntropy(const std::wstring& peerDeviceId)
 {
-    std::string deviceIdStr = payload.value("deviceId", "");
-    std::wstring deviceId(deviceIdStr.begin(), deviceIdStr.end());
-
-    std::wcout << L"[P2P] Received GOODBYE from " << deviceId << L", closing connection" << std::endl;
+    std::lock_guard<std::mutex> lock(m_peersMutex);
 
-    // Close the socket gracefully
-    CloseSocket(socket);
+    auto it = m_peerToSocket.find(peerDeviceId);
+    return it != m_peerToSocket.end() && GetPeerProtocol(it->second) >= kP2PAntiEntropyVersion;
 }
 
-// Notify all peers of a change
-void P2PManager::NotifyPeersOfChange(const std::wstring& jobPath, uint64_t timestamp)
+// Ask one peer for its shots of some buckets
+bool P2PManager::RequestRanges(const std::wstring& peerDeviceId, const std::wstring& jobPath, const std::vector<uint32_t>& buckets,
+                               const std::vector<uint64_t>& knownShots)
 {
     std::lock_guard<std::mutex> lock(m_peersMutex);
 
-    std::wcout << L"[P2P] Notifying " << m_peerToSocket.size() << L" peers of change to: " << jobPath
-               << L" (timestamp: " << timestamp << L")" << std::endl;
-
-    for (auto& [deviceId, socket] : m_peerToSocket)
+    auto it = m_peerToSocket.find(peerDeviceId);
+    if (it == m_peerToSocket.end() || GetPeerProtocol(it->second) < kP2PAntiEntropyVersion)
     {
-        SendChangeNotify(socket, jobPath, timestamp);
+        return false;
     }
+
+    P2PMessage message = MakeMessage(P2PMessageType::RANGE_REQUEST);
+    message.jobPath = std::string(jobPath.begin(), jobPath.end());
+    message.buckets = buckets;
+    message.knownShots = knownShots;
+
+    SendPeerMessage(it->second, message);
+
+    std::wcout << L"[P2P] Sent RANGE_REQUEST to " << peerDeviceId << L" for job: " << jobPath
+               << L" (" << buckets.size() << L" buckets)" << std::endl;
+    return true;
 }
 
 // Register change callback
@@ -1224,6 +1445,34 @@ void P2PManager::RegisterChangeCallback(std::function<void(const std::wstring&,
     m_changeCallback = callback;
 }
 
+// Register entries callback
+void P2PManager::RegisterEntriesCallback(std::function<bool(const P2PChangeBatch&)> callback)
+{
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_entriesCallback = callback;
+}
+
+// Register sync request callback
+void P2PManager::RegisterSyncRequestCallback(std::function<json(const std::wstring&, uint64_t)> callback)
+{
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_syncRequestCallback = callback;
+}
+
+// Register summary callback
+void P2PManager::RegisterSummaryCallback(std::function<void(const std::wstring&, const std::wstring&, const json&)> callback)
+{
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_summaryCallback = callback;
+}
+
+// Register range request callback
+void P2PManager::RegisterRangeRequestCallback(std::function<json(const std::wstring&, const std::vector<uint32_t>&, const std::vector<uint64_t>&)> callback)
+{
+    std::lock_guard<std::mutex> lock(m_callbackMutex);
+    m_rangeRequestCallback = callback;
+}
+
 // Register peer connected callback
 void P2PManager::RegisterPeerConnectedCallback(std::function<void(const std::wstring&, const std::wstring&)> callback)
 {
@@ -1237,11 +1486,18 @@ void P2PManager::HeartbeatThread()
     std::cout << "[P2P] Heartbeat thread started" << std::endl;
 
     int heartbeatCounter = 0;
+    int registryCounter = 0;
 
     while (m_isRunning)
     {
         // Update peer registry (read peers.json, connect to new peers)
-        UpdatePeerRegistry();
+        // With LAN discovery running it only covers peers multicast doesn't reach, so every 5 minutes
+        // (10 heartbeat cycles) is enough; without it, every cycle
+        if (registryCounter == 0 || !IsLanDiscoveryRunning())
+        {
+            UpdatePeerRegistry();
+        }
+        registryCounter = (registryCounter + 1) % 10;
 
         // Send PING to all connected peers
         {
@@ -1258,7 +1514,7 @@ void P2PManager::HeartbeatThread()
         // Cleanup stale receive buffers (not updated in 5+ minutes)
         CleanupStaleReceiveBuffers();
 
-        // Update our entry in peers.json
+        // Update our entry in peers.json (only written when our address changed or a project was added)
         WritePeerRegistry();
 
         // Cleanup stale peer files every 10 minutes (20 heartbeat cycles)
@@ -1479,8 +1735,25 @@ void P2PManager::SavePeersToFile()
             }
         }
 
-        // Only write if something changed
-        if (!hasChanged)
+        // Only write if something changed, or to projects subscribed since the last write
+        std::vector<std::wstring> projectsToWrite;
+        if (hasChanged)
+        {
+            m_writtenProjects.clear();
+            projectsToWrite = projects;
+        }
+        else
+        {
+            for (const auto& projectPath : projects)
+            {
+                if (m_writtenProjects.find(projectPath) == m_writtenProjects.end())
+                {
+                    projectsToWrite.push_back(projectPath);
+                }
+            }
+        }
+
+        if (projectsToWrite.empty())
         {
             // No changes - skip write
             return;
@@ -1500,8 +1773,7 @@ void P2PManager::SavePeersToFile()
         int successCount = 0;
         int failCount = 0;
 
-        // Write to ALL subscribed projects
-        for (const auto& projectPath : projects)
+        for (const auto& projectPath : projectsToWrite)
         {
             std::filesystem::path ufbDir = std::filesystem::path(projectPath) / L".ufb" / L"peers";
 
@@ -1548,6 +1820,7 @@ void P2PManager::SavePeersToFile()
 
                 // Atomic rename (overwrites existing file)
                 std::filesystem::rename(tempFile, ourPeerFile);
+                m_writtenProjects.insert(projectPath);
                 successCount++;
             }
             catch (const std::filesystem::filesystem_error& e)
@@ -1795,30 +2068,26 @@ void P2PManager::CleanupStaleReceiveBuffers()
     uint64_t now = GetCurrentTimestamp();
     uint64_t staleThreshold = 5 * 60 * 1000; // 5 minutes in milliseconds
 
-    std::vector<SOCKET> socketsToClose;
+    std::vector<P2PConnection> socketsToClose;
 
     // Find stale buffers
     {
         std::lock_guard<std::mutex> lock(m_buffersMutex);
 
-        for (const auto& [socket, lastActivity] : m_receiveBufferLastActivity)
+        for (const auto& [socket, state] : m_receiveStates)
         {
-            if ((now - lastActivity) > staleThreshold)
+            if ((now - state->lastActivity) > staleThreshold && !state->buffer.Empty())
             {
-                auto it = m_receiveBuffers.find(socket);
-                if (it != m_receiveBuffers.end() && !it->second.empty())
-                {
-                    std::cerr << "[P2P] WARNING: Receive buffer for socket #" << socket
-                              << " has been stalled for " << ((now - lastActivity) / 1000) << " seconds with "
-                              << it->second.size() << " bytes. Closing connection." << std::endl;
-                    socketsToClose.push_back(socket);
-                }
+                std::cerr << "[P2P] WARNING: Receive buffer for socket #" << socket
+                          << " has been stalled for " << ((now - state->lastActivity) / 1000) << " seconds with "
+                          << state->buffer.Size() << " bytes. Closing connection." << std::endl;
+                socketsToClose.push_back(socket);
             }
         }
     }
 
     // Close stale sockets (outside of lock to prevent deadlock)
-    for (SOCKET socket : socketsToClose)
+    for (P2PConnection socket : socketsToClose)
     {
         CloseSocket(socket);
     }
@@ -1838,130 +2107,25 @@ bool P2PManager::ConnectToPeer(const std::string& ipAddress, uint16_t port)
         return false;
     }
 
-    // Create socket
-    SOCKET socket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
-    if (socket == INVALID_SOCKET)
-    {
-        std::cerr << "[P2P] Failed to create connect socket: " << WSAGetLastError() << std::endl;
-        return false;
-    }
-
-    // Set non-blocking mode for connect timeout
-    u_long nonBlocking = 1;
-    if (ioctlsocket(socket, FIONBIO, &nonBlocking) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] Failed to set non-blocking mode: " << WSAGetLastError() << std::endl;
-        closesocket(socket);
-        return false;
-    }
-
-    // Set TCP_NODELAY to disable Nagle's algorithm (critical for VPNs and real-time)
-    int nodelay = 1;
-    if (setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (char*)&nodelay, sizeof(nodelay)) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] Warning: Failed to set TCP_NODELAY: " << WSAGetLastError() << std::endl;
-    }
-
-    // Set SO_KEEPALIVE to detect dead connections over VPN
-    int keepalive = 1;
-    if (setsockopt(socket, SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, sizeof(keepalive)) == SOCKET_ERROR)
-    {
-        std::cerr << "[P2P] Warning: Failed to set SO_KEEPALIVE: " << WSAGetLastError() << std::endl;
-    }
-
-    // Connect to peer (non-blocking)
-    sockaddr_in addr = {};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    inet_pton(AF_INET, ipAddress.c_str(), &addr.sin_addr);
-
-    int result = connect(socket, (sockaddr*)&addr, sizeof(addr));
-    if (result == SOCKET_ERROR)
-    {
-        int error = WSAGetLastError();
-
-        // WSAEWOULDBLOCK is expected for non-blocking connect
-        if (error != WSAEWOULDBLOCK)
-        {
-            std::cerr << "[P2P] Failed to initiate connection to " << ipAddress << ":" << port << " - " << error << std::endl;
-            closesocket(socket);
-            return false;
-        }
-
-        // Wait for connection to complete (with 3 second timeout)
-        fd_set writeSet;
-        FD_ZERO(&writeSet);
-        FD_SET(socket, &writeSet);
-
-        timeval timeout;
-        timeout.tv_sec = 3;  // 3 second timeout instead of 20-30
-        timeout.tv_usec = 0;
-
-        result = select(0, nullptr, &writeSet, nullptr, &timeout);
-        if (result == 0)
-        {
-            // Timeout
-            std::cerr << "[P2P] Connection to " << ipAddress << ":" << port << " timed out (firewall/unreachable)" << std::endl;
-            closesocket(socket);
-            return false;
-        }
-        else if (result == SOCKET_ERROR)
-        {
-            std::cerr << "[P2P] select() failed for " << ipAddress << ":" << port << " - " << WSAGetLastError() << std::endl;
-            closesocket(socket);
-            return false;
-        }
-
-        // Check if connection succeeded or failed
-        int soError = 0;
-        int soErrorLen = sizeof(soError);
-        if (getsockopt(socket, SOL_SOCKET, SO_ERROR, (char*)&soError, &soErrorLen) == SOCKET_ERROR)
-        {
-            std::cerr << "[P2P] getsockopt() failed for " << ipAddress << ":" << port << " - " << WSAGetLastError() << std::endl;
-            closesocket(socket);
-            return false;
-        }
-
-        if (soError != 0)
-        {
-            std::cerr << "[P2P] Connection to " << ipAddress << ":" << port << " failed - " << soError << std::endl;
-            closesocket(socket);
-            return false;
-        }
-    }
-
-    // Set back to blocking mode for IOCP operations
-    nonBlocking = 0;
-    if (ioctlsocket(socket, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    // Connect with a 3 second timeout (instead of the 20-30s OS default); receiving starts right away
+    P2PConnection socket = m_transport->Connect(ipAddress, port, 3000);
+    if (socket == kNoConnection)
     {
-        std::cerr << "[P2P] Failed to set blocking mode: " << WSAGetLastError() << std::endl;
-        closesocket(socket);
         return false;
     }
 
     std::cout << "[P2P] Connected to " << ipAddress << ":" << port << std::endl;
 
-    // Associate with IOCP
-    if (CreateIoCompletionPort((HANDLE)socket, m_iocpHandle, (ULONG_PTR)socket, 0) == NULL)
-    {
-        std::cerr << "[P2P] Failed to associate connect socket with IOCP: " << GetLastError() << std::endl;
-        closesocket(socket);
-        return false;
-    }
-
     // Send HELLO
     SendHello(socket);
 
-    // Start receiving
-    PostReceive(socket);
-
     return true;
 }
 
 // Close socket and cleanup
-void P2PManager::CloseSocket(SOCKET socket)
+void P2PManager::CloseSocket(P2PConnection socket)
 {
-    if (socket == INVALID_SOCKET)
+    if (socket == kNoConnection)
         return;
 
     std::lock_guard<std::mutex> lock(m_peersMutex);
@@ -1984,27 +2148,23 @@ void P2PManager::CloseSocket(SOCKET socket)
         m_socketToPeer.erase(socket);
     }
 
-    // Cancel all pending I/O operations on this socket
-    // This ensures IOCP won't complete operations after we close the socket
-    CancelIoEx((HANDLE)socket, NULL);
-
-    // Close socket
-    closesocket(socket);
+    // Close socket (cancels its pending I/O; no-op if the transport already closed it)
+    m_transport->Close(socket);
 
     // Remove from receive buffers and counters
     {
         std::lock_guard<std::mutex> lock(m_buffersMutex);
-        m_receiveBuffers.erase(socket);
-        m_receiveBufferLastActivity.erase(socket);
-        m_zeroLengthMessageCount.erase(socket);
+        auto it = m_receiveStates.find(socket);
+        if (it != m_receiveStates.end())
+        {
+            it->second->closed = true;
+            m_receiveStates.erase(it);
+        }
     }
 
-    // Remove all contexts for this socket from the list
     {
-        std::lock_guard<std::mutex> lock(m_contextsMutex);
-        m_activeContexts.remove_if([socket](const std::shared_ptr<IOContext>& ctx) {
-            return ctx->socket == socket;
-        });
+        std::lock_guard<std::mutex> lock(m_peerProtocolsMutex);
+        m_peerProtocols.erase(socket);
     }
 }
 
@@ -2015,7 +2175,7 @@ void P2PManager::RemovePeer(const std::wstring& deviceId)
     auto socketIt = m_peerToSocket.find(deviceId);
     if (socketIt != m_peerToSocket.end())
     {
-        SOCKET socket = socketIt->second;
+        P2PConnection socket = socketIt->second;
         CloseSocket(socket);
     }
 
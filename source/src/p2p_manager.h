@@ -1,44 +1,24 @@
 #pragma once
 
-// Define WIN32_LEAN_AND_MEAN to prevent windows.h from including winsock.h (old API)
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-
-// IMPORTANT: WinSock2 must be included before windows.h
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#include <mswsock.h>  // For AcceptEx and other extension functions
-#include <windows.h>
 #include <string>
 #include <vector>
-#include <list>
 #include <map>
 #include <set>
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <memory>
 #include <filesystem>
+#include <chrono>
 #include "nlohmann/json.hpp"
-
-#pragma comment(lib, "ws2_32.lib")
+#include "p2p_protocol.h"
+#include "p2p_transport.h"
+#include "p2p_discovery.h"
 
 namespace UFB {
 
-// P2P Message Types
-enum class P2PMessageType : uint32_t
-{
-    HELLO = 1,              // Initial handshake with peer info
-    CHANGE_NOTIFY = 2,      // Notify peers of metadata change
-    SYNC_REQUEST = 3,       // Request full sync of change logs
-    SYNC_RESPONSE = 4,      // Response with change log data
-    PING = 5,               // Keepalive ping
-    PONG = 6,               // Keepalive response
-    GOODBYE = 7             // Clean disconnect notification
-};
-
 // Peer information
 struct PeerInfo
 {
@@ -53,38 +33,21 @@ struct PeerInfo
     static PeerInfo FromJson(const nlohmann::json& j);
 };
 
-// I/O Operation types for IOCP
-enum class IOOperation
+// Change log entries pushed by a peer (CHANGE_NOTIFY or SYNC_RESPONSE)
+struct P2PChangeBatch
 {
-    Accept,
-    Receive,
-    Send,
-    Connect
+    std::wstring jobPath;
+    std::wstring deviceId;              // Device that made the changes
+    uint64_t previousTimestamp = 0;     // Entry the sender pushed before these (0 = unknown/not sent)
+    nlohmann::json entries;             // Change log entries (device log format), oldest first
+    bool currentState = false;          // RANGE_RESPONSE: the sender's current shots, written by any device
 };
 
-// Overlapped structure for async I/O
-struct IOContext
-{
-    OVERLAPPED overlapped;
-    IOOperation operation;
-    SOCKET socket;
-    WSABUF wsaBuf;
-    std::vector<char> buffer;
-    size_t totalBytes;          // Total bytes to send/receive
-    size_t processedBytes;      // Bytes already processed
-    std::wstring peerDeviceId;  // Associated peer
-
-    IOContext(IOOperation op, SOCKET s)
-        : operation(op), socket(s), totalBytes(0), processedBytes(0)
-    {
-        ZeroMemory(&overlapped, sizeof(OVERLAPPED));
-        buffer.resize(8192); // Default buffer size
-        wsaBuf.buf = buffer.data();
-        wsaBuf.len = static_cast<ULONG>(buffer.size());
-    }
-};
-
-// P2P Manager - Handles peer-to-peer networking using WinSock2 + IOCP
+// P2P Manager - Handles peer-to-peer networking (sockets via P2PTransport: IOCP on Windows, epoll on Linux)
+//
+// Peers are found by UDP multicast on the LAN (P2PDiscovery) and, as a fallback for peers that
+// multicast doesn't reach (WAN/VPN), through per-device files in each subscribed project's
+// .ufb/peers folder; those are written when our address changes and read every few minutes
 class P2PManager
 {
 public:
@@ -109,17 +72,57 @@ public:
     std::vector<std::wstring> GetSubscribedProjects() const;
 
     // Send a change notification to all active peers
-    void NotifyPeersOfChange(const std::wstring& jobPath, uint64_t timestamp);
-
-    // Register callback for when remote changes are detected
+    // entries (optional) are pushed along so peers can apply them without reading the share;
+    // previousTimestamp is the entry pushed before them for the job, so peers can detect gaps
+    //
+    // Notifications are queued per peer and coalesced per job: the first change after a quiet
+    // period goes out right away, later ones within kNotifyCoalesceMs are merged into one
+    // CHANGE_NOTIFY (newest timestamp, latest entry per shot). Peers with more than
+    // kMaxPendingSendBytes unsent keep merging until they catch up
+    void NotifyPeersOfChange(const std::wstring& jobPath, uint64_t timestamp,
+                             const nlohmann::json& entries = nlohmann::json(), uint64_t previousTimestamp = 0);
+
+    // Ask a peer for its own change log entries of a job newer than sinceTimestamp (answered with SYNC_RESPONSE)
+    bool RequestChanges(const std::wstring& peerDeviceId, const std::wstring& jobPath, uint64_t sinceTimestamp);
+
+    // Send a job's anti-entropy summary (SyncSummary JSON) to one peer, or all peers if peerDeviceId is empty
+    // Peers from before the anti-entropy exchange are skipped
+    void SendSyncSummary(const std::wstring& peerDeviceId, const std::wstring& jobPath, const nlohmann::json& summary);
+
+    // Whether a connected peer speaks the anti-entropy exchange (SYNC_SUMMARY / RANGE_REQUEST)
+    bool SupportsAntiEntropy(const std::wstring& peerDeviceId);
+
+    // Ask a peer for its current shots of summary buckets (answered with RANGE_RESPONSE, split into
+    // several when large); knownShots are
+    // the hashes of our shots in those buckets (SyncSummary::HashShot), which the peer leaves out
+    bool RequestRanges(const std::wstring& peerDeviceId, const std::wstring& jobPath, const std::vector<uint32_t>& buckets,
+                       const std::vector<uint64_t>& knownShots);
+
+    // Register callback for when remote changes are detected (share must be re-read)
     void RegisterChangeCallback(std::function<void(const std::wstring& jobPath, const std::wstring& peerDeviceId, uint64_t timestamp)> callback);
 
+    // Register callback for pushed entries; returns true if they were applied, otherwise a
+    // CHANGE_NOTIFY falls back to the change callback
+    void RegisterEntriesCallback(std::function<bool(const P2PChangeBatch& batch)> callback);
+
+    // Register callback that serves SYNC_REQUEST: our own entries of a job newer than sinceTimestamp
+    void RegisterSyncRequestCallback(std::function<nlohmann::json(const std::wstring& jobPath, uint64_t sinceTimestamp)> callback);
+
+    // Register callback for summaries received from peers
+    void RegisterSummaryCallback(std::function<void(const std::wstring& peerDeviceId, const std::wstring& jobPath, const nlohmann::json& summary)> callback);
+
+    // Register callback that serves RANGE_REQUEST: our current shots of the buckets the requester doesn't
+    // know, as change log entries
+    void RegisterRangeRequestCallback(std::function<nlohmann::json(const std::wstring& jobPath, const std::vector<uint32_t>& buckets,
+                                                                   const std::vector<uint64_t>& knownShots)> callback);
+
     // Register callback for when a peer successfully connects (handshake complete)
     void RegisterPeerConnectedCallback(std::function<void(const std::wstring& peerDeviceId, const std::wstring& peerDeviceName)> callback);
 
     // Peer discovery and management
     void UpdatePeerRegistry();          // Read peers.json from all subscribed projects and connect to new peers
-    void WritePeerRegistry();           // Write our info to peers.json in all subscribed projects
+    void WritePeerRegistry();           // Write our info to peers.json in subscribed projects (when it changed)
+    bool IsLanDiscoveryRunning() const { return m_discovery && m_discovery->IsRunning(); }
     std::vector<PeerInfo> GetActivePeers() const;
 
     // Connection management
@@ -132,8 +135,7 @@ public:
 
 private:
     // Core networking
-    SOCKET m_listenSocket;
-    HANDLE m_iocpHandle;
+    std::unique_ptr<P2PTransport> m_transport;
     uint16_t m_listeningPort;
     std::atomic<bool> m_isRunning;
 
@@ -144,14 +146,19 @@ private:
     std::wstring m_deviceName;
 
     // Peer management
-    std::map<std::wstring, PeerInfo> m_peers;           // deviceId -> PeerInfo
-    std::map<SOCKET, std::wstring> m_socketToPeer;      // socket -> deviceId
-    std::map<std::wstring, SOCKET> m_peerToSocket;      // deviceId -> socket
+    std::map<std::wstring, PeerInfo> m_peers;               // deviceId -> PeerInfo
+    std::map<P2PConnection, std::wstring> m_socketToPeer;   // socket -> deviceId
+    std::map<std::wstring, P2PConnection> m_peerToSocket;   // deviceId -> socket
     mutable std::mutex m_peersMutex;
 
+    // LAN discovery (started once we listen)
+    std::unique_ptr<P2PDiscovery> m_discovery;
+    std::map<std::wstring, uint64_t> m_pendingAnnounced;   // deviceId -> when we heard it and it wasn't connected yet (guarded by m_peersMutex)
+
     // Peer file state tracking (to avoid unnecessary writes)
     uint16_t m_lastWrittenPort;
     std::vector<std::string> m_lastWrittenIPs;
+    std::set<std::wstring> m_writtenProjects;   // Projects holding our current peer file
 
     // IP address caching (avoid expensive enumeration every 30s)
     std::vector<std::string> m_cachedIPs;
@@ -162,24 +169,55 @@ private:
     std::map<std::wstring, std::filesystem::file_time_type> m_peerFileTimestamps;
     std::mutex m_fileTimestampMutex;
 
-    // I/O contexts - use list to allow multiple concurrent operations per socket
-    std::list<std::shared_ptr<IOContext>> m_activeContexts;
-    std::mutex m_contextsMutex;
-
     // Message handling
-    std::map<SOCKET, std::vector<char>> m_receiveBuffers; // Partial message buffers
-    std::map<SOCKET, uint64_t> m_receiveBufferLastActivity; // Timestamp of last activity per buffer
-    std::map<SOCKET, int> m_zeroLengthMessageCount; // Track consecutive zero-length messages per socket
+    struct ReceiveState
+    {
+        P2PReceiveRing buffer;              // Partial message bytes
+        std::vector<char> scratch;          // Frames that wrap around the end of the ring
+        uint64_t lastActivity = 0;          // Timestamp of last activity
+        int zeroLengthMessageCount = 0;     // Consecutive zero-length messages
+        bool closed = false;                // Set by CloseSocket; stops parsing mid-burst
+    };
+    std::map<P2PConnection, std::shared_ptr<ReceiveState>> m_receiveStates;
     std::mutex m_buffersMutex;
 
+    // Protocol version each peer announced in HELLO (absent = 1, JSON only)
+    std::map<P2PConnection, uint32_t> m_peerProtocols;
+    std::mutex m_peerProtocolsMutex;
+
     // Callbacks
     std::function<void(const std::wstring& jobPath, const std::wstring& peerDeviceId, uint64_t timestamp)> m_changeCallback;
     std::function<void(const std::wstring& peerDeviceId, const std::wstring& peerDeviceName)> m_peerConnectedCallback;
+    std::function<bool(const P2PChangeBatch& batch)> m_entriesCallback;
+    std::function<nlohmann::json(const std::wstring& jobPath, uint64_t sinceTimestamp)> m_syncRequestCallback;
+    std::function<void(const std::wstring& peerDeviceId, const std::wstring& jobPath, const nlohmann::json& summary)> m_summaryCallback;
+    std::function<nlohmann::json(const std::wstring& jobPath, const std::vector<uint32_t>& buckets,
+                                 const std::vector<uint64_t>& knownShots)> m_rangeRequestCallback;
     std::mutex m_callbackMutex;
 
+    // Outgoing CHANGE_NOTIFY queues (see NotifyPeersOfChange)
+    static constexpr int kNotifyCoalesceMs = 50;
+    static constexpr size_t kMaxPendingSendBytes = 4 * 1024 * 1024;
+    static constexpr size_t kMaxCoalescedEntries = 2000;   // Beyond this peers are told to re-read the share
+
+    struct PendingNotify
+    {
+        P2PMessage message;                         // Coalesced CHANGE_NOTIFY
+        std::map<std::string, size_t> entryIndex;   // shotPath -> position in message.entries
+        bool withoutEntries = false;                // A merged notification had none (or too many): peers re-read the share
+        size_t changeCount = 0;                     // Notifications merged
+        std::vector<char> binaryFrame;              // Encoded at flush, shared by every peer it goes to
+        std::vector<char> jsonFrame;
+    };
+    std::map<std::wstring, std::shared_ptr<PendingNotify>> m_openNotifies;     // jobPath -> batch of the current window
+    std::map<std::wstring, std::map<std::wstring, std::shared_ptr<PendingNotify>>> m_outboxes;  // deviceId -> jobPath -> batch
+    std::chrono::steady_clock::time_point m_nextNotifyFlush;
+    std::mutex m_outboxMutex;                       // Taken after m_peersMutex
+    std::condition_variable m_outboxCV;
+
     // Worker threads
-    std::thread m_iocpWorkerThread;
     std::thread m_heartbeatThread;
+    std::thread m_notifyThread;
 
     // Peer discovery
     void LoadPeersFromFile();
@@ -188,39 +226,49 @@ private:
     void CleanupStalePeerFiles();  // Delete old peer files from disk
     void CleanupStaleReceiveBuffers();  // Clean up receive buffers that haven't been updated in 5+ minutes
 
-    // IOCP worker
-    void IOCPWorkerThread();
+    // LAN discovery events (discovery thread)
+    void OnPeerAnnounced(const DiscoveredPeer& announced);
+    void OnPeerLeft(const std::string& deviceId);
 
-    // Async operations
-    bool PostAccept();
-    bool PostReceive(SOCKET socket);
-    bool PostSend(SOCKET socket, const std::vector<char>& data);
+    // Transport events (I/O thread)
+    void OnConnectionAccepted(P2PConnection socket);
+    void OnDataReceived(P2PConnection socket, const char* data, size_t size);
 
     // Message handling
-    void HandleAccept(IOContext* context);
-    void HandleReceive(IOContext* context, DWORD bytesTransferred);
-    void HandleSend(IOContext* context, DWORD bytesTransferred);
-    void ProcessMessage(SOCKET socket, const std::vector<char>& messageData);
+    void ProcessMessage(P2PConnection socket, const char* data, size_t size);
+    void DispatchMessage(P2PConnection socket, const P2PMessage& message);
 
     // Protocol
-    std::vector<char> CreateMessage(P2PMessageType type, const nlohmann::json& payload);
-    void SendMessage(SOCKET socket, P2PMessageType type, const nlohmann::json& payload);
-    void SendHello(SOCKET socket);
-    void SendChangeNotify(SOCKET socket, const std::wstring& jobPath, uint64_t timestamp);
-    void SendPing(SOCKET socket);
+    uint32_t GetPeerProtocol(P2PConnection socket);
+    void SendPeerMessage(P2PConnection socket, P2PMessageType type, const nlohmann::json& payload);  // JSON frame
+    void SendPeerMessage(P2PConnection socket, const P2PMessage& message);  // Binary frame if the peer supports it
+    P2PMessage MakeMessage(P2PMessageType type);
+    void SendHello(P2PConnection socket);
+    void SendPing(P2PConnection socket);
 
     // Message handlers
-    void OnHelloReceived(SOCKET socket, const nlohmann::json& payload);
-    void OnChangeNotifyReceived(SOCKET socket, const nlohmann::json& payload);
-    void OnPingReceived(SOCKET socket, const nlohmann::json& payload);
-    void OnPongReceived(SOCKET socket, const nlohmann::json& payload);
-    void OnGoodbyeReceived(SOCKET socket, const nlohmann::json& payload);
+    void OnHelloReceived(P2PConnection socket, const nlohmann::json& payload);
+    void OnChangeNotifyReceived(P2PConnection socket, const P2PMessage& message);
+    void OnSyncRequestReceived(P2PConnection socket, const P2PMessage& message);
+    void OnSyncResponseReceived(P2PConnection socket, const P2PMessage& message);
+    bool DeliverEntries(const P2PChangeBatch& batch);
+    void OnPingReceived(P2PConnection socket, const P2PMessage& message);
+    void OnPongReceived(P2PConnection socket, const P2PMessage& message);
+    void OnGoodbyeReceived(P2PConnection socket, const P2PMessage& message);
+    void OnSyncSummaryReceived(P2PConnection socket, const P2PMessage& message);
+    void OnRangeRequestReceived(P2PConnection socket, const P2PMessage& message);
+    void OnRangeResponseReceived(P2PConnection socket, const P2PMessage& message);
 
     // Heartbeat
     void HeartbeatThread();
 
+    // Outgoing CHANGE_NOTIFY
+    void NotifyThread();
+    void FlushNotifies();
+    static void MergeNotify(PendingNotify& batch, uint64_t timestamp, const nlohmann::json& entries);
+
     // Cleanup
-    void CloseSocket(SOCKET socket);
+    void CloseSocket(P2PConnection socket);
     void RemovePeer(const std::wstring& deviceId);
 
     // Utility
@@ -228,7 +276,7 @@ private:
     std::vector<std::string> GetAllLocalIPs();
     std::string GetLocalIPAddress();  // Deprecated - kept for backward compatibility
     uint64_t GetCurrentTimestamp();
-    std::string SocketToString(SOCKET socket);
+    std::string SocketToString(P2PConnection socket);
 };
 
 } // namespace UFB
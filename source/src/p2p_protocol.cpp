@@ -0,0 +1,515 @@
+#include "p2p_protocol.h"
+#include <cstring>
+#include <algorithm>
+
+using json = nlohmann::json;
+
+namespace UFB {
+
+namespace {
+
+// Binary body writer (appends to a frame whose length prefix is filled in last)
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(std::vector<char>& out) : m_out(out) {}
+
+    void PutU8(uint8_t value) { m_out.push_back(static_cast<char>(value)); }
+
+    void PutU32(uint32_t value)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+            m_out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+
+    void PutU64(uint64_t value)
+    {
+        for (int shift = 56; shift >= 0; shift -= 8)
+            m_out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+
+    void PutBytes(const void* data, size_t size)
+    {
+        PutU32(static_cast<uint32_t>(size));
+        const char* bytes = static_cast<const char*>(data);
+        m_out.insert(m_out.end(), bytes, bytes + size);
+    }
+
+    void PutString(const std::string& value) { PutBytes(value.data(), value.size()); }
+
+private:
+    std::vector<char>& m_out;
+};
+
+// Binary body reader (fails once any read runs past the end)
+class BinaryReader
+{
+public:
+    BinaryReader(const char* data, size_t size)
+        : m_data(reinterpret_cast<const unsigned char*>(data)), m_size(size) {}
+
+    bool Ok() const { return m_ok; }
+
+    uint8_t GetU8()
+    {
+        if (!Need(1)) return 0;
+        return m_data[m_pos++];
+    }
+
+    uint32_t GetU32()
+    {
+        if (!Need(4)) return 0;
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++)
+            value = (value << 8) | m_data[m_pos++];
+        return value;
+    }
+
+    uint64_t GetU64()
+    {
+        if (!Need(8)) return 0;
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++)
+            value = (value << 8) | m_data[m_pos++];
+        return value;
+    }
+
+    // Pointer into the body (valid as long as the body)
+    const unsigned char* GetBytes(size_t& outSize)
+    {
+        outSize = GetU32();
+        if (!Need(outSize)) { outSize = 0; return nullptr; }
+        const unsigned char* bytes = m_data + m_pos;
+        m_pos += outSize;
+        return bytes;
+    }
+
+    std::string GetString()
+    {
+        size_t size = 0;
+        const unsigned char* bytes = GetBytes(size);
+        return bytes ? std::string(reinterpret_cast<const char*>(bytes), size) : std::string();
+    }
+
+private:
+    bool Need(size_t count)
+    {
+        if (!m_ok || m_size - m_pos < count)
+        {
+            m_ok = false;
+            return false;
+        }
+        return true;
+    }
+
+    const unsigned char* m_data;
+    size_t m_size;
+    size_t m_pos = 0;
+    bool m_ok = true;
+};
+
+void PutEntries(BinaryWriter& writer, const json& entries)
+{
+    if ((entries.is_array() || entries.is_object()) && !entries.empty())
+    {
+        std::vector<uint8_t> packed = json::to_msgpack(entries);
+        writer.PutBytes(packed.data(), packed.size());
+    }
+    else
+    {
+        writer.PutU32(0);
+    }
+}
+
+void PutBuckets(BinaryWriter& writer, const std::vector<uint32_t>& buckets)
+{
+    writer.PutU32(static_cast<uint32_t>(buckets.size()));
+    for (uint32_t bucket : buckets)
+        writer.PutU32(bucket);
+}
+
+bool GetBuckets(BinaryReader& reader, std::vector<uint32_t>& outBuckets)
+{
+    uint32_t count = reader.GetU32();
+    outBuckets.clear();
+    for (uint32_t i = 0; i < count && reader.Ok(); i++)
+        outBuckets.push_back(reader.GetU32());
+    return reader.Ok();
+}
+
+void PutHashes(BinaryWriter& writer, const std::vector<uint64_t>& hashes)
+{
+    writer.PutU32(static_cast<uint32_t>(hashes.size()));
+    for (uint64_t hash : hashes)
+        writer.PutU64(hash);
+}
+
+bool GetHashes(BinaryReader& reader, std::vector<uint64_t>& outHashes)
+{
+    uint32_t count = reader.GetU32();
+    outHashes.clear();
+    for (uint32_t i = 0; i < count && reader.Ok(); i++)
+        outHashes.push_back(reader.GetU64());
+    return reader.Ok();
+}
+
+bool GetEntries(BinaryReader& reader, json& outEntries)
+{
+    size_t size = 0;
+    const unsigned char* bytes = reader.GetBytes(size);
+    if (!reader.Ok())
+    {
+        return false;
+    }
+
+    if (size == 0)
+    {
+        outEntries = json();
+        return true;
+    }
+
+    outEntries = json::from_msgpack(bytes, bytes + size, true, false);
+    return !outEntries.is_discarded() && (outEntries.is_array() || outEntries.is_object());
+}
+
+} // namespace
+
+void P2PCodec::WriteLength(char* out, uint32_t length)
+{
+    // Network byte order
+    out[0] = static_cast<char>((length >> 24) & 0xFF);
+    out[1] = static_cast<char>((length >> 16) & 0xFF);
+    out[2] = static_cast<char>((length >> 8) & 0xFF);
+    out[3] = static_cast<char>(length & 0xFF);
+}
+
+uint32_t P2PCodec::ReadLength(const char* in)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
+
+std::vector<char> P2PCodec::EncodeJson(P2PMessageType type, const json& payload)
+{
+    // Create message JSON
+    json message = {
+        {"type", static_cast<uint32_t>(type)},
+        {"payload", payload}
+    };
+
+    std::string jsonStr = message.dump();
+
+    // Create framed message: [4-byte length][JSON data]
+    std::vector<char> frame(4 + jsonStr.size());
+    WriteLength(frame.data(), static_cast<uint32_t>(jsonStr.size()));
+    memcpy(frame.data() + 4, jsonStr.data(), jsonStr.size());
+    return frame;
+}
+
+std::vector<char> P2PCodec::EncodeJson(const P2PMessage& message)
+{
+    json payload;
+
+    switch (message.type)
+    {
+    case P2PMessageType::CHANGE_NOTIFY:
+        payload = {
+            {"jobPath", message.jobPath},
+            {"deviceId", message.deviceId},
+            {"timestamp", message.timestamp}
+        };
+        // Peers without entry support ignore these and read the share as before
+        if (message.entries.is_array() && !message.entries.empty())
+        {
+            payload["entries"] = message.entries;
+            payload["previousTimestamp"] = message.previousTimestamp;
+        }
+        break;
+    case P2PMessageType::SYNC_REQUEST:
+        payload = {
+            {"jobPath", message.jobPath},
+            {"deviceId", message.deviceId},
+            {"since", message.since}
+        };
+        break;
+    case P2PMessageType::SYNC_RESPONSE:
+        payload = {
+            {"jobPath", message.jobPath},
+            {"deviceId", message.deviceId},
+            {"since", message.since},
+            {"entries", message.entries.is_array() ? message.entries : json::array()}
+        };
+        break;
+    case P2PMessageType::GOODBYE:
+        payload = {
+            {"deviceId", message.deviceId},
+            {"timestamp", message.timestamp}
+        };
+        break;
+    case P2PMessageType::SYNC_SUMMARY:
+        payload = {
+            {"jobPath", message.jobPath},
+            {"deviceId", message.deviceId},
+            {"summary", message.summary}
+        };
+        break;
+    case P2PMessageType::RANGE_REQUEST:
+        payload = {
+            {"jobPath", message.jobPath},
+            {"deviceId", message.deviceId},
+            {"buckets", message.buckets},
+            {"knownShots", message.knownShots}
+        };
+        break;
+    case P2PMessageType::RANGE_RESPONSE:
+        payload = {
+            {"jobPath", message.jobPath},
+            {"deviceId", message.deviceId},
+            {"buckets", message.buckets},
+            {"entries", message.entries.is_array() ? message.entries : json::array()}
+        };
+        break;
+    default:
+        payload = {
+            {"timestamp", message.timestamp}
+        };
+        break;
+    }
+
+    return EncodeJson(message.type, payload);
+}
+
+std::vector<char> P2PCodec::EncodeBinary(const P2PMessage& message)
+{
+    std::vector<char> frame;
+    frame.reserve(64 + message.jobPath.size() + message.deviceId.size());
+    frame.resize(4);    // Length prefix, filled in below
+
+    BinaryWriter writer(frame);
+    writer.PutU8(kP2PBinaryFormatV1);
+    writer.PutU8(static_cast<uint8_t>(message.type));
+
+    switch (message.type)
+    {
+    case P2PMessageType::CHANGE_NOTIFY:
+        writer.PutString(message.jobPath);
+        writer.PutString(message.deviceId);
+        writer.PutU64(message.timestamp);
+        writer.PutU64(message.previousTimestamp);
+        PutEntries(writer, message.entries);
+        break;
+    case P2PMessageType::SYNC_REQUEST:
+        writer.PutString(message.jobPath);
+        writer.PutString(message.deviceId);
+        writer.PutU64(message.since);
+        break;
+    case P2PMessageType::SYNC_RESPONSE:
+        writer.PutString(message.jobPath);
+        writer.PutString(message.deviceId);
+        writer.PutU64(message.since);
+        PutEntries(writer, message.entries);
+        break;
+    case P2PMessageType::GOODBYE:
+        writer.PutString(message.deviceId);
+        writer.PutU64(message.timestamp);
+        break;
+    case P2PMessageType::SYNC_SUMMARY:
+        writer.PutString(message.jobPath);
+        writer.PutString(message.deviceId);
+        PutEntries(writer, message.summary);
+        break;
+    case P2PMessageType::RANGE_REQUEST:
+        writer.PutString(message.jobPath);
+        writer.PutString(message.deviceId);
+        PutBuckets(writer, message.buckets);
+        PutHashes(writer, message.knownShots);
+        break;
+    case P2PMessageType::RANGE_RESPONSE:
+        writer.PutString(message.jobPath);
+        writer.PutString(message.deviceId);
+        PutBuckets(writer, message.buckets);
+        PutEntries(writer, message.entries);
+        break;
+    default:
+        writer.PutU64(message.timestamp);
+        break;
+    }
+
+    WriteLength(frame.data(), static_cast<uint32_t>(frame.size() - 4));
+    return frame;
+}
+
+bool P2PCodec::DecodeBinary(const char* body, size_t size, P2PMessage& outMessage)
+{
+    BinaryReader reader(body, size);
+    if (reader.GetU8() != kP2PBinaryFormatV1)
+    {
+        return false;
+    }
+
+    outMessage.type = static_cast<P2PMessageType>(reader.GetU8());
+
+    switch (outMessage.type)
+    {
+    case P2PMessageType::CHANGE_NOTIFY:
+        outMessage.jobPath = reader.GetString();
+        outMessage.deviceId = reader.GetString();
+        outMessage.timestamp = reader.GetU64();
+        outMessage.previousTimestamp = reader.GetU64();
+        return GetEntries(reader, outMessage.entries);
+    case P2PMessageType::SYNC_REQUEST:
+        outMessage.jobPath = reader.GetString();
+        outMessage.deviceId = reader.GetString();
+        outMessage.since = reader.GetU64();
+        return reader.Ok();
+    case P2PMessageType::SYNC_RESPONSE:
+        outMessage.jobPath = reader.GetString();
+        outMessage.deviceId = reader.GetString();
+        outMessage.since = reader.GetU64();
+        return GetEntries(reader, outMessage.entries);
+    case P2PMessageType::GOODBYE:
+        outMessage.deviceId = reader.GetString();
+        outMessage.timestamp = reader.GetU64();
+        return reader.Ok();
+    case P2PMessageType::SYNC_SUMMARY:
+        outMessage.jobPath = reader.GetString();
+        outMessage.deviceId = reader.GetString();
+        return GetEntries(reader, outMessage.summary);
+    case P2PMessageType::RANGE_REQUEST:
+        outMessage.jobPath = reader.GetString();
+        outMessage.deviceId = reader.GetString();
+        if (!GetBuckets(reader, outMessage.buckets))
+            return false;
+        return GetHashes(reader, outMessage.knownShots);
+    case P2PMessageType::RANGE_RESPONSE:
+        outMessage.jobPath = reader.GetString();
+        outMessage.deviceId = reader.GetString();
+        if (!GetBuckets(reader, outMessage.buckets))
+            return false;
+        return GetEntries(reader, outMessage.entries);
+    case P2PMessageType::PING:
+    case P2PMessageType::PONG:
+        outMessage.timestamp = reader.GetU64();
+        return reader.Ok();
+    default:
+        return false;   // HELLO is JSON only
+    }
+}
+
+bool P2PCodec::FromJsonPayload(P2PMessageType type, const json& payload, P2PMessage& outMessage)
+{
+    outMessage.type = type;
+    outMessage.jobPath = payload.value("jobPath", "");
+    outMessage.deviceId = payload.value("deviceId", "");
+    outMessage.timestamp = payload.value("timestamp", uint64_t(0));
+    outMessage.previousTimestamp = payload.value("previousTimestamp", uint64_t(0));
+    outMessage.since = payload.value("since", uint64_t(0));
+
+    if (payload.contains("entries") && payload["entries"].is_array())
+    {
+        outMessage.entries = payload["entries"];
+    }
+
+    if (payload.contains("summary") && payload["summary"].is_object())
+    {
+        outMessage.summary = payload["summary"];
+    }
+
+    if (payload.contains("buckets") && payload["buckets"].is_array())
+    {
+        outMessage.buckets = payload["buckets"].get<std::vector<uint32_t>>();
+    }
+
+    if (payload.contains("knownShots") && payload["knownShots"].is_array())
+    {
+        outMessage.knownShots = payload["knownShots"].get<std::vector<uint64_t>>();
+    }
+
+    switch (type)
+    {
+    case P2PMessageType::CHANGE_NOTIFY:
+    case P2PMessageType::SYNC_REQUEST:
+    case P2PMessageType::SYNC_RESPONSE:
+    case P2PMessageType::SYNC_SUMMARY:
+    case P2PMessageType::RANGE_REQUEST:
+    case P2PMessageType::RANGE_RESPONSE:
+    case P2PMessageType::PING:
+    case P2PMessageType::PONG:
+    case P2PMessageType::GOODBYE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+P2PReceiveRing::P2PReceiveRing(size_t initialCapacity)
+{
+    size_t capacity = 1024;
+    while (capacity < initialCapacity)
+        capacity *= 2;
+    m_buffer.resize(capacity);
+}
+
+void P2PReceiveRing::Append(const char* data, size_t size)
+{
+    if (m_size + size > m_buffer.size())
+    {
+        Grow(m_size + size);
+    }
+
+    size_t capacity = m_buffer.size();
+    size_t tail = (m_head + m_size) & (capacity - 1);
+    size_t firstPart = (std::min)(size, capacity - tail);
+
+    memcpy(m_buffer.data() + tail, data, firstPart);
+    memcpy(m_buffer.data(), data + firstPart, size - firstPart);
+    m_size += size;
+}
+
+void P2PReceiveRing::Consume(size_t count)
+{
+    count = (std::min)(count, m_size);
+    m_head = (m_head + count) & (m_buffer.size() - 1);
+    m_size -= count;
+
+    if (m_size == 0)
+    {
+        m_head = 0;     // Keeps the next frames contiguous
+    }
+}
+
+const char* P2PReceiveRing::Peek(size_t offset, size_t count, std::vector<char>& scratch) const
+{
+    size_t capacity = m_buffer.size();
+    size_t start = (m_head + offset) & (capacity - 1);
+
+    if (start + count <= capacity)
+    {
+        return m_buffer.data() + start;
+    }
+
+    // Range wraps around the end
+    size_t firstPart = capacity - start;
+    scratch.resize(count);
+    memcpy(scratch.data(), m_buffer.data() + start, firstPart);
+    memcpy(scratch.data() + firstPart, m_buffer.data(), count - firstPart);
+    return scratch.data();
+}
+
+void P2PReceiveRing::Grow(size_t minCapacity)
+{
+    size_t capacity = m_buffer.size();
+    while (capacity < minCapacity)
+        capacity *= 2;
+
+    // Unwrap the contents to the start of the new buffer
+    std::vector<char> grown(capacity);
+    size_t firstPart = (std::min)(m_size, m_buffer.size() - m_head);
+    memcpy(grown.data(), m_buffer.data() + m_head, firstPart);
+    memcpy(grown.data() + firstPart, m_buffer.data(), m_size - firstPart);
+
+    m_buffer.swap(grown);
+    m_head = 0;
+}
+
+} // namespace UFB
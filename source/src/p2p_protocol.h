@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+namespace UFB {
+
+// P2P Message Types
+enum class P2PMessageType : uint32_t
+{
+    HELLO = 1,              // Initial handshake with peer info
+    CHANGE_NOTIFY = 2,      // Notify peers of metadata change (carries the change log entries)
+    SYNC_REQUEST = 3,       // Request a peer's own change log entries newer than a timestamp
+    SYNC_RESPONSE = 4,      // Response with change log entries
+    PING = 5,               // Keepalive ping
+    PONG = 6,               // Keepalive response
+    GOODBYE = 7,            // Clean disconnect notification
+    SYNC_SUMMARY = 8,       // Anti-entropy summary of a job's shot state (see SyncSummary)
+    RANGE_REQUEST = 9,      // Request the current shots of summary buckets
+    RANGE_RESPONSE = 10     // Current shots of the requested buckets (as change log entries)
+};
+
+// Protocol version announced in HELLO ("protocol")
+// - 2: binary frames
+// - 3: SYNC_SUMMARY / RANGE_REQUEST / RANGE_RESPONSE
+constexpr uint32_t kP2PProtocolVersion = 3;
+constexpr uint32_t kP2PBinaryFramesVersion = 2;
+constexpr uint32_t kP2PAntiEntropyVersion = 3;
+
+// First byte of a binary frame body (JSON bodies start with '{')
+constexpr uint8_t kP2PBinaryFormatV1 = 0xB1;
+
+// Upper bound of a frame body
+constexpr uint32_t kP2PMaxMessageSize = 10 * 1024 * 1024;
+
+// Batches are split so each frame stays well below kP2PMaxMessageSize: at most this many entries
+// (SYNC_RESPONSE, RANGE_RESPONSE) and, for RANGE_RESPONSE, this many MessagePack bytes of entries
+constexpr size_t kP2PMaxEntriesPerMessage = 1000;
+constexpr size_t kP2PMaxEntryBytesPerMessage = kP2PMaxMessageSize / 2;
+
+// Decoded message other than HELLO (fields not used by a type stay empty)
+struct P2PMessage
+{
+    P2PMessageType type = P2PMessageType::PING;
+    std::string jobPath;
+    std::string deviceId;
+    uint64_t timestamp = 0;             // PING, PONG, CHANGE_NOTIFY, GOODBYE
+    uint64_t previousTimestamp = 0;     // CHANGE_NOTIFY
+    uint64_t since = 0;                 // SYNC_REQUEST, SYNC_RESPONSE
+    nlohmann::json entries;             // CHANGE_NOTIFY, SYNC_RESPONSE, RANGE_RESPONSE (null when none)
+    nlohmann::json summary;             // SYNC_SUMMARY
+    std::vector<uint32_t> buckets;      // RANGE_REQUEST, RANGE_RESPONSE
+    std::vector<uint64_t> knownShots;   // RANGE_REQUEST: hashes of the requester's shots in those buckets
+};
+
+// Wire format of P2P frames: [4-byte big-endian body length][body]
+//
+// - JSON body: {"type": n, "payload": {...}}; always used for HELLO, and for everything sent to
+//   peers that haven't announced binary support
+// - Binary body (v1): [0xB1][type u8][fields], integers big-endian, strings as u32 length + bytes
+//     PING, PONG       timestamp
+//     CHANGE_NOTIFY    jobPath, deviceId, timestamp, previousTimestamp, entries
+//     SYNC_REQUEST     jobPath, deviceId, since
+//     SYNC_RESPONSE    jobPath, deviceId, since, entries
+//     GOODBYE          deviceId, timestamp
+//     SYNC_SUMMARY     jobPath, deviceId, summary
+//     RANGE_REQUEST    jobPath, deviceId, buckets, knownShots
+//     RANGE_RESPONSE   jobPath, deviceId, buckets, entries
+//   entries and summary are MessagePack bytes (empty when there are none), buckets and knownShots a
+//   u32 count + u32s / u64s
+class P2PCodec
+{
+public:
+    // Complete frames (length prefix included)
+    static std::vector<char> EncodeJson(P2PMessageType type, const nlohmann::json& payload);
+    static std::vector<char> EncodeJson(const P2PMessage& message);
+    static std::vector<char> EncodeBinary(const P2PMessage& message);
+
+    // Frame bodies (length prefix removed)
+    static bool IsBinary(const char* body, size_t size) { return size > 0 && static_cast<uint8_t>(body[0]) == kP2PBinaryFormatV1; }
+    static bool DecodeBinary(const char* body, size_t size, P2PMessage& outMessage);
+    static bool FromJsonPayload(P2PMessageType type, const nlohmann::json& payload, P2PMessage& outMessage);
+
+    // Length prefix
+    static void WriteLength(char* out, uint32_t length);
+    static uint32_t ReadLength(const char* in);
+};
+
+// Receive buffer of one connection: a ring that grows by doubling, so frames are parsed where
+// they landed and consumed by moving the head instead of erasing from the front
+class P2PReceiveRing
+{
+public:
+    explicit P2PReceiveRing(size_t initialCapacity = 16 * 1024);
+
+    size_t Size() const { return m_size; }
+    bool Empty() const { return m_size == 0; }
+
+    void Append(const char* data, size_t size);
+    void Consume(size_t count);
+
+    // Contiguous view of count bytes starting offset bytes past the head; points into the ring
+    // unless the range wraps, in which case it's copied into scratch. Valid until the next Append/Consume
+    const char* Peek(size_t offset, size_t count, std::vector<char>& scratch) const;
+
+private:
+    void Grow(size_t minCapacity);
+
+    std::vector<char> m_buffer;     // Capacity is a power of two
+    size_t m_head = 0;
+    size_t m_size = 0;
+};
+
+} // namespace UFB
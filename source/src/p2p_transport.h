@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+
+namespace UFB {
+
+// Connection handle given out by a transport (the socket value)
+using P2PConnection = uint64_t;
+constexpr P2PConnection kNoConnection = ~P2PConnection(0);
+
+// Callbacks from the transport's I/O thread
+struct P2PTransportHandler
+{
+    std::function<void(P2PConnection connection)> onAccepted;      // Incoming connection, before its first receive
+    std::function<void(P2PConnection connection, const char* data, size_t size)> onReceived;
+    std::function<void(P2PConnection connection)> onClosed;        // Closed by the peer or an I/O error (not after Close)
+};
+
+// Socket layer of the P2P protocol: TCP listen/connect/send/receive on one I/O thread
+//
+// - Windows: overlapped WinSock with an I/O completion port (AcceptEx, WSARecv, WSASend)
+// - Linux: non-blocking sockets with epoll; sends that don't fit the socket buffer are queued and
+//   flushed when it becomes writable
+//
+// Framing, peer bookkeeping and message handling live in P2PManager, which only sees byte streams
+class P2PTransport
+{
+public:
+    virtual ~P2PTransport() = default;
+
+    // Platform implementation (nullptr if the platform has none)
+    static std::unique_ptr<P2PTransport> Create();
+
+    // Start the I/O thread; handler callbacks run on it
+    virtual bool Start(const P2PTransportHandler& handler) = 0;
+
+    // Close every connection and stop the I/O thread
+    virtual void Stop() = 0;
+
+    // Listen on preferredPort, or the next free port above it (up to 100 tried)
+    virtual bool Listen(uint16_t preferredPort, uint16_t& outPort) = 0;
+
+    // Connect with a timeout (blocks the caller); receiving starts right away
+    virtual P2PConnection Connect(const std::string& ipAddress, uint16_t port, int timeoutMs) = 0;
+
+    // Queue bytes to send; false if the connection is gone or the send failed
+    virtual bool Send(P2PConnection connection, std::vector<char> data) = 0;
+
+    // Bytes handed to Send that haven't been written to the socket yet (0 if the connection is gone);
+    // lets callers hold back data for peers that don't keep up
+    virtual size_t GetPendingSendBytes(P2PConnection connection) = 0;
+
+    // Close a connection (no onClosed callback)
+    virtual void Close(P2PConnection connection) = 0;
+
+    // Remote IPv4 address of a connection (empty if unknown)
+    virtual std::string GetPeerAddress(P2PConnection connection) = 0;
+
+    // Host information
+    static std::wstring GetHostName();
+    static std::vector<std::string> GetHostAddresses();    // IPv4 addresses the host name resolves to
+};
+
+} // namespace UFB
@@ -0,0 +1,634 @@
+#ifdef __linux__
+
+#include "p2p_transport.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+namespace UFB {
+
+// Non-blocking sockets on epoll (level-triggered), one I/O thread
+class EpollTransport : public P2PTransport
+{
+public:
+    EpollTransport() = default;
+    ~EpollTransport() override;
+
+    bool Start(const P2PTransportHandler& handler) override;
+    void Stop() override;
+    bool Listen(uint16_t preferredPort, uint16_t& outPort) override;
+    P2PConnection Connect(const std::string& ipAddress, uint16_t port, int timeoutMs) override;
+    bool Send(P2PConnection connection, std::vector<char> data) override;
+    size_t GetPendingSendBytes(P2PConnection connection) override;
+    void Close(P2PConnection connection) override;
+    std::string GetPeerAddress(P2PConnection connection) override;
+
+private:
+    struct Connection
+    {
+        std::deque<std::vector<char>> sendQueue;    // Data the socket buffer didn't take yet
+        size_t sendOffset = 0;                      // Sent bytes of sendQueue.front()
+    };
+
+    void WorkerThread();
+    void HandleAccept();
+    void HandleReadable(int fd);
+    void HandleWritable(int fd);
+    bool AddConnection(int fd);
+    bool FlushLocked(int fd, Connection& connection);   // Write queued data; false on error
+    void CloseFromWorker(int fd);                       // Close after an I/O failure and report it
+    static void ConfigureSocket(int fd);
+
+    P2PTransportHandler m_handler;
+    int m_epollFd = -1;
+    int m_wakeFd = -1;          // eventfd that interrupts epoll_wait on Stop
+    int m_listenFd = -1;
+    std::atomic<bool> m_isRunning{false};
+    std::thread m_workerThread;
+
+    std::map<int, Connection> m_connections;
+    std::mutex m_connectionsMutex;      // Guards m_connections and the epoll registrations of connections
+};
+
+std::unique_ptr<P2PTransport> P2PTransport::Create()
+{
+    return std::make_unique<EpollTransport>();
+}
+
+EpollTransport::~EpollTransport()
+{
+    Stop();
+}
+
+bool EpollTransport::Start(const P2PTransportHandler& handler)
+{
+    m_handler = handler;
+
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0)
+    {
+        std::cerr << "[P2P] epoll_create1 failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0)
+    {
+        std::cerr << "[P2P] eventfd failed: " << strerror(errno) << std::endl;
+        close(m_epollFd);
+        m_epollFd = -1;
+        return false;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_wakeFd;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+
+    m_isRunning = true;
+    m_workerThread = std::thread(&EpollTransport::WorkerThread, this);
+    return true;
+}
+
+void EpollTransport::Stop()
+{
+    if (!m_isRunning)
+        return;
+
+    m_isRunning = false;
+
+    // Wake up the worker thread
+    uint64_t one = 1;
+    if (write(m_wakeFd, &one, sizeof(one)) < 0)
+    {
+        std::cerr << "[P2P] Failed to wake epoll thread: " << strerror(errno) << std::endl;
+    }
+
+    if (m_workerThread.joinable())
+        m_workerThread.join();
+
+    // Close all connections
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        for (auto& [fd, connection] : m_connections)
+        {
+            close(fd);
+        }
+        m_connections.clear();
+    }
+
+    if (m_listenFd >= 0)
+    {
+        close(m_listenFd);
+        m_listenFd = -1;
+    }
+
+    close(m_wakeFd);
+    close(m_epollFd);
+    m_wakeFd = -1;
+    m_epollFd = -1;
+}
+
+bool EpollTransport::Listen(uint16_t preferredPort, uint16_t& outPort)
+{
+    m_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0)
+    {
+        std::cerr << "[P2P] Failed to create listen socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // No SO_REUSEADDR, same as on Windows: each P2P manager needs a unique port
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    // Try preferred port, or find available port starting from 49152
+    uint16_t portToTry = (preferredPort > 0) ? preferredPort : 49152;
+    bool bound = false;
+
+    for (int attempts = 0; attempts < 100; attempts++)
+    {
+        addr.sin_port = htons(portToTry);
+        if (bind(m_listenFd, (sockaddr*)&addr, sizeof(addr)) == 0)
+        {
+            bound = true;
+            outPort = portToTry;
+            break;
+        }
+        portToTry++;
+    }
+
+    if (!bound || listen(m_listenFd, SOMAXCONN) != 0)
+    {
+        std::cerr << "[P2P] Failed to listen: " << strerror(errno) << std::endl;
+        close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = m_listenFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &event) != 0)
+    {
+        std::cerr << "[P2P] Failed to add listen socket to epoll: " << strerror(errno) << std::endl;
+        close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void EpollTransport::WorkerThread()
+{
+    std::cout << "[P2P] epoll worker thread started" << std::endl;
+
+    epoll_event events[64];
+
+    while (m_isRunning)
+    {
+        int count = epoll_wait(m_epollFd, events, 64, 1000);
+        if (count < 0)
+        {
+            if (errno != EINTR)
+            {
+                std::cerr << "[P2P] epoll_wait failed: " << strerror(errno) << std::endl;
+            }
+            continue;
+        }
+
+        for (int i = 0; i < count && m_isRunning; i++)
+        {
+            int fd = events[i].data.fd;
+            uint32_t flags = events[i].events;
+
+            if (fd == m_wakeFd)
+            {
+                continue;
+            }
+
+            if (fd == m_listenFd)
+            {
+                HandleAccept();
+                continue;
+            }
+
+            try
+            {
+                // Read first so data that arrived with the hang-up is still delivered
+                if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+                {
+                    HandleReadable(fd);
+                }
+
+                if (flags & EPOLLOUT)
+                {
+                    HandleWritable(fd);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[P2P] Exception in epoll worker: " << e.what() << std::endl;
+            }
+        }
+    }
+
+    std::cout << "[P2P] epoll worker thread stopped" << std::endl;
+}
+
+void EpollTransport::HandleAccept()
+{
+    while (m_isRunning)
+    {
+        int fd = accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                std::cerr << "[P2P] accept failed: " << strerror(errno) << std::endl;
+            }
+            return;
+        }
+
+        std::cout << "[P2P] Accepted new connection" << std::endl;
+
+        ConfigureSocket(fd);
+        if (!AddConnection(fd))
+        {
+            close(fd);
+            continue;
+        }
+
+        if (m_handler.onAccepted)
+        {
+            m_handler.onAccepted(static_cast<P2PConnection>(fd));
+        }
+    }
+}
+
+void EpollTransport::HandleReadable(int fd)
+{
+    char buffer[65536];
+
+    // Bounded so one busy connection doesn't starve the others (level-triggered: the rest comes next round)
+    for (int reads = 0; reads < 16 && m_isRunning; reads++)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+            if (m_connections.find(fd) == m_connections.end())
+            {
+                return;     // Closed meanwhile
+            }
+        }
+
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received > 0)
+        {
+            if (m_handler.onReceived)
+            {
+                m_handler.onReceived(static_cast<P2PConnection>(fd), buffer, static_cast<size_t>(received));
+            }
+            continue;
+        }
+
+        if (received == 0)
+        {
+            std::cout << "[P2P] Connection closed by peer" << std::endl;
+            CloseFromWorker(fd);
+            return;
+        }
+
+        if (errno == EINTR)
+        {
+            continue;
+        }
+
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            std::cerr << "[P2P] recv failed: " << strerror(errno) << std::endl;
+            CloseFromWorker(fd);
+        }
+        return;
+    }
+}
+
+void EpollTransport::HandleWritable(int fd)
+{
+    bool failed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        auto it = m_connections.find(fd);
+        if (it == m_connections.end())
+        {
+            return;
+        }
+
+        failed = !FlushLocked(fd, it->second);
+        if (!failed && it->second.sendQueue.empty())
+        {
+            // Nothing left: stop watching for writability
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.fd = fd;
+            epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+    }
+
+    if (failed)
+    {
+        CloseFromWorker(fd);
+    }
+}
+
+bool EpollTransport::FlushLocked(int fd, Connection& connection)
+{
+    while (!connection.sendQueue.empty())
+    {
+        const std::vector<char>& front = connection.sendQueue.front();
+        ssize_t sent = send(fd, front.data() + connection.sendOffset, front.size() - connection.sendOffset, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return true;
+            }
+            std::cerr << "[P2P] send failed: " << strerror(errno) << std::endl;
+            return false;
+        }
+
+        connection.sendOffset += static_cast<size_t>(sent);
+        if (connection.sendOffset == front.size())
+        {
+            connection.sendQueue.pop_front();
+            connection.sendOffset = 0;
+        }
+    }
+    return true;
+}
+
+bool EpollTransport::Send(P2PConnection connection, std::vector<char> data)
+{
+    if (data.empty())
+    {
+        return true;
+    }
+
+    int fd = static_cast<int>(connection);
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    auto it = m_connections.find(fd);
+    if (it == m_connections.end())
+    {
+        return false;
+    }
+
+    // Write directly when nothing is queued (the common case), keeping the order otherwise
+    bool wasIdle = it->second.sendQueue.empty();
+    it->second.sendQueue.push_back(std::move(data));
+
+    if (!wasIdle)
+    {
+        return true;
+    }
+
+    if (!FlushLocked(fd, it->second))
+    {
+        // The reader sees the error and reports the close
+        return false;
+    }
+
+    if (!it->second.sendQueue.empty())
+    {
+        // Socket buffer full: flush the rest when it becomes writable
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
+        event.data.fd = fd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+
+    return true;
+}
+
+size_t EpollTransport::GetPendingSendBytes(P2PConnection connection)
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    auto it = m_connections.find(static_cast<int>(connection));
+    if (it == m_connections.end())
+    {
+        return 0;
+    }
+
+    size_t pending = 0;
+    for (const auto& data : it->second.sendQueue)
+    {
+        pending += data.size();
+    }
+    return pending - it->second.sendOffset;
+}
+
+P2PConnection EpollTransport::Connect(const std::string& ipAddress, uint16_t port, int timeoutMs)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        std::cerr << "[P2P] Failed to create connect socket: " << strerror(errno) << std::endl;
+        return kNoConnection;
+    }
+
+    ConfigureSocket(fd);
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, ipAddress.c_str(), &addr.sin_addr) != 1)
+    {
+        std::cerr << "[P2P] Invalid address: " << ipAddress << std::endl;
+        close(fd);
+        return kNoConnection;
+    }
+
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        if (errno != EINPROGRESS)
+        {
+            std::cerr << "[P2P] Failed to initiate connection to " << ipAddress << ":" << port << " - " << strerror(errno) << std::endl;
+            close(fd);
+            return kNoConnection;
+        }
+
+        // Wait for connection to complete
+        pollfd pfd = {};
+        pfd.fd = fd;
+        pfd.events = POLLOUT;
+
+        int result = poll(&pfd, 1, timeoutMs);
+        if (result == 0)
+        {
+            std::cerr << "[P2P] Connection to " << ipAddress << ":" << port << " timed out (firewall/unreachable)" << std::endl;
+            close(fd);
+            return kNoConnection;
+        }
+
+        int soError = 0;
+        socklen_t soErrorLen = sizeof(soError);
+        if (result < 0 || getsockopt(fd, SOL_SOCKET, SO_ERROR, &soError, &soErrorLen) != 0 || soError != 0)
+        {
+            std::cerr << "[P2P] Connection to " << ipAddress << ":" << port << " failed - "
+                      << strerror(soError != 0 ? soError : errno) << std::endl;
+            close(fd);
+            return kNoConnection;
+        }
+    }
+
+    if (!AddConnection(fd))
+    {
+        close(fd);
+        return kNoConnection;
+    }
+
+    return static_cast<P2PConnection>(fd);
+}
+
+bool EpollTransport::AddConnection(int fd)
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        std::cerr << "[P2P] Failed to add socket to epoll: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    m_connections[fd] = Connection();
+    return true;
+}
+
+void EpollTransport::Close(P2PConnection connection)
+{
+    int fd = static_cast<int>(connection);
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+
+    if (m_connections.erase(fd) == 0)
+    {
+        return;
+    }
+
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+}
+
+void EpollTransport::CloseFromWorker(int fd)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        if (m_connections.find(fd) == m_connections.end())
+        {
+            return;
+        }
+    }
+
+    Close(static_cast<P2PConnection>(fd));
+
+    if (m_handler.onClosed)
+    {
+        m_handler.onClosed(static_cast<P2PConnection>(fd));
+    }
+}
+
+std::string EpollTransport::GetPeerAddress(P2PConnection connection)
+{
+    sockaddr_in peerAddr = {};
+    socklen_t peerAddrLen = sizeof(peerAddr);
+    if (getpeername(static_cast<int>(connection), (sockaddr*)&peerAddr, &peerAddrLen) != 0)
+    {
+        return std::string();
+    }
+
+    char ipStr[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &peerAddr.sin_addr, ipStr, INET_ADDRSTRLEN);
+    return ipStr;
+}
+
+void EpollTransport::ConfigureSocket(int fd)
+{
+    // Disable Nagle's algorithm and detect dead connections, same as on Windows
+    int enable = 1;
+    if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) != 0)
+    {
+        std::cerr << "[P2P] Warning: Failed to set TCP_NODELAY: " << strerror(errno) << std::endl;
+    }
+    if (setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &enable, sizeof(enable)) != 0)
+    {
+        std::cerr << "[P2P] Warning: Failed to set SO_KEEPALIVE: " << strerror(errno) << std::endl;
+    }
+}
+
+std::wstring P2PTransport::GetHostName()
+{
+    char hostname[256] = {};
+    if (gethostname(hostname, sizeof(hostname) - 1) != 0)
+    {
+        return L"Unknown";
+    }
+
+    std::string name(hostname);
+    return std::wstring(name.begin(), name.end());
+}
+
+std::vector<std::string> P2PTransport::GetHostAddresses()
+{
+    // Interface addresses (the host name usually resolves to 127.0.1.1 on Linux)
+    std::vector<std::string> ips;
+
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0)
+    {
+        std::cerr << "[P2P] Failed to list network interfaces: " << strerror(errno) << std::endl;
+        return ips;
+    }
+
+    for (ifaddrs* ifa = interfaces; ifa != nullptr; ifa = ifa->ifa_next)
+    {
+        if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_INET)
+        {
+            continue;
+        }
+
+        char ipStr[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &((sockaddr_in*)ifa->ifa_addr)->sin_addr, ipStr, INET_ADDRSTRLEN);
+        ips.push_back(ipStr);
+    }
+
+    freeifaddrs(interfaces);
+    return ips;
+}
+
+} // namespace UFB
+
+#endif // __linux__
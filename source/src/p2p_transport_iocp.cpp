@@ -0,0 +1,880 @@
+#ifdef _WIN32
+
+// IMPORTANT: WinSock2 must be included before windows.h
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <mswsock.h>  // For AcceptEx and other extension functions
+#include <windows.h>
+#include "p2p_transport.h"
+#include <iostream>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace UFB {
+
+namespace {
+
+// I/O Operation types for IOCP
+enum class IOOperation
+{
+    Accept,
+    Receive,
+    Send
+};
+
+// Receive buffer size of a context
+constexpr size_t kReceiveBufferSize = 8192;
+
+// Overlapped structure for async I/O (pooled, see AcquireContext)
+struct IOContext
+{
+    OVERLAPPED overlapped;
+    IOOperation operation = IOOperation::Receive;
+    SOCKET socket = INVALID_SOCKET;
+    WSABUF wsaBuf;
+    std::vector<char> buffer;   // Receive/accept buffer (kept between uses), or the bytes to send
+    size_t totalBytes = 0;      // Total bytes to send/receive
+    size_t processedBytes = 0;  // Bytes already processed
+
+    void Reset(IOOperation op, SOCKET s)
+    {
+        ZeroMemory(&overlapped, sizeof(OVERLAPPED));
+        operation = op;
+        socket = s;
+        totalBytes = 0;
+        processedBytes = 0;
+        wsaBuf.buf = buffer.data();
+        wsaBuf.len = static_cast<ULONG>(buffer.size());
+    }
+};
+
+} // namespace
+
+// Overlapped WinSock transport on an I/O completion port
+class IOCPTransport : public P2PTransport
+{
+public:
+    IOCPTransport();
+    ~IOCPTransport() override;
+
+    bool Start(const P2PTransportHandler& handler) override;
+    void Stop() override;
+    bool Listen(uint16_t preferredPort, uint16_t& outPort) override;
+    P2PConnection Connect(const std::string& ipAddress, uint16_t port, int timeoutMs) override;
+    bool Send(P2PConnection connection, std::vector<char> data) override;
+    size_t GetPendingSendBytes(P2PConnection connection) override;
+    void Close(P2PConnection connection) override;
+    std::string GetPeerAddress(P2PConnection connection) override;
+
+private:
+    void WorkerThread();
+    bool PostAccept();
+    bool PostReceive(SOCKET socket);
+    void HandleAccept(IOContext* context);
+    void HandleReceive(IOContext* context, DWORD bytesTransferred);
+    bool HandleSend(IOContext* context, DWORD bytesTransferred);
+    IOContext* AcquireContext(IOOperation operation, SOCKET socket, size_t bufferSize);
+    void ReleaseContext(IOContext* context);
+    void CloseFromWorker(SOCKET socket);    // Close after an I/O failure and report it
+    static void ConfigureSocket(SOCKET socket);
+
+    P2PTransportHandler m_handler;
+    SOCKET m_listenSocket = INVALID_SOCKET;
+    HANDLE m_iocpHandle = NULL;
+    std::atomic<bool> m_isRunning{false};
+    std::thread m_workerThread;
+
+    // I/O context pool - a context goes back to the free list only when its completion has been
+    // dequeued (including aborted ones after Close), so the kernel never writes into a reused one
+    std::vector<std::unique_ptr<IOContext>> m_contexts;     // Every context ever created
+    std::vector<IOContext*> m_freeContexts;
+    std::mutex m_contextsMutex;
+
+    std::set<SOCKET> m_connections;     // Open connections (accepted or connected)
+    std::map<SOCKET, size_t> m_pendingSendBytes;    // Bytes of posted sends not completed yet
+    std::mutex m_connectionsMutex;                  // Guards m_connections and m_pendingSendBytes
+};
+
+std::unique_ptr<P2PTransport> P2PTransport::Create()
+{
+    return std::make_unique<IOCPTransport>();
+}
+
+IOCPTransport::IOCPTransport()
+{
+    // Initialize WinSock
+    WSADATA wsaData;
+    int result = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (result != 0)
+    {
+        std::cerr << "[P2P] WSAStartup failed: " << result << std::endl;
+    }
+}
+
+IOCPTransport::~IOCPTransport()
+{
+    Stop();
+    WSACleanup();
+}
+
+bool IOCPTransport::Start(const P2PTransportHandler& handler)
+{
+    m_handler = handler;
+
+    // Create IOCP handle
+    m_iocpHandle = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 0);
+    if (m_iocpHandle == NULL)
+    {
+        std::cerr << "[P2P] Failed to create IOCP handle: " << GetLastError() << std::endl;
+        return false;
+    }
+
+    // Start IOCP worker thread
+    m_isRunning = true;
+    m_workerThread = std::thread(&IOCPTransport::WorkerThread, this);
+    return true;
+}
+
+void IOCPTransport::Stop()
+{
+    if (!m_isRunning)
+        return;
+
+    m_isRunning = false;
+
+    // Close all connections
+    std::vector<SOCKET> socketsToClose;
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        socketsToClose.assign(m_connections.begin(), m_connections.end());
+    }
+
+    for (SOCKET socket : socketsToClose)
+    {
+        Close(socket);
+    }
+
+    // Close listen socket
+    if (m_listenSocket != INVALID_SOCKET)
+    {
+        closesocket(m_listenSocket);
+        m_listenSocket = INVALID_SOCKET;
+    }
+
+    // Signal IOCP to wake up worker thread
+    if (m_iocpHandle != NULL)
+    {
+        PostQueuedCompletionStatus(m_iocpHandle, 0, 0, NULL);
+    }
+
+    if (m_workerThread.joinable())
+        m_workerThread.join();
+
+    // Close IOCP handle
+    if (m_iocpHandle != NULL)
+    {
+        CloseHandle(m_iocpHandle);
+        m_iocpHandle = NULL;
+    }
+
+    // Free the context pool (all sockets are closed, nothing completes into it anymore)
+    {
+        std::lock_guard<std::mutex> lock(m_contextsMutex);
+        m_freeContexts.clear();
+        m_contexts.clear();
+    }
+}
+
+bool IOCPTransport::Listen(uint16_t preferredPort, uint16_t& outPort)
+{
+    // Create TCP socket
+    m_listenSocket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+    if (m_listenSocket == INVALID_SOCKET)
+    {
+        std::cerr << "[P2P] Failed to create listen socket: " << WSAGetLastError() << std::endl;
+        return false;
+    }
+
+    // NOTE: SO_REUSEADDR removed - each P2P manager needs a unique port
+    // With SO_REUSEADDR, multiple managers thought they were on the same port,
+    // causing cross-wired connections and lost messages.
+
+    // Bind to port
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+
+    // Try preferred port, or find available port starting from 49152
+    uint16_t portToTry = (preferredPort > 0) ? preferredPort : 49152;
+    bool bound = false;
+
+    for (int attempts = 0; attempts < 100; attempts++)
+    {
+        addr.sin_port = htons(portToTry);
+        if (bind(m_listenSocket, (sockaddr*)&addr, sizeof(addr)) == 0)
+        {
+            bound = true;
+            outPort = portToTry;
+            break;
+        }
+        portToTry++;
+    }
+
+    if (!bound)
+    {
+        std::cerr << "[P2P] Failed to bind to any port" << std::endl;
+        closesocket(m_listenSocket);
+        m_listenSocket = INVALID_SOCKET;
+        return false;
+    }
+
+    // Listen for connections
+    if (listen(m_listenSocket, SOMAXCONN) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Listen failed: " << WSAGetLastError() << std::endl;
+        closesocket(m_listenSocket);
+        m_listenSocket = INVALID_SOCKET;
+        return false;
+    }
+
+    // Associate listen socket with IOCP
+    if (CreateIoCompletionPort((HANDLE)m_listenSocket, m_iocpHandle, (ULONG_PTR)m_listenSocket, 0) == NULL)
+    {
+        std::cerr << "[P2P] Failed to associate listen socket with IOCP: " << GetLastError() << std::endl;
+        closesocket(m_listenSocket);
+        m_listenSocket = INVALID_SOCKET;
+        return false;
+    }
+
+    // Post initial accept operations
+    for (int i = 0; i < 5; i++)
+    {
+        PostAccept();
+    }
+
+    return true;
+}
+
+// Post an accept operation
+bool IOCPTransport::PostAccept()
+{
+    // Create accept socket
+    SOCKET acceptSocket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+    if (acceptSocket == INVALID_SOCKET)
+    {
+        std::cerr << "[P2P] Failed to create accept socket: " << WSAGetLastError() << std::endl;
+        return false;
+    }
+
+    // AcceptEx requires buffer for local and remote addresses
+    IOContext* context = AcquireContext(IOOperation::Accept, acceptSocket, (sizeof(sockaddr_in) + 16) * 2);
+
+    // Load AcceptEx function
+    LPFN_ACCEPTEX lpfnAcceptEx = NULL;
+    GUID guidAcceptEx = WSAID_ACCEPTEX;
+    DWORD dwBytes = 0;
+
+    if (WSAIoctl(m_listenSocket, SIO_GET_EXTENSION_FUNCTION_POINTER,
+                 &guidAcceptEx, sizeof(guidAcceptEx),
+                 &lpfnAcceptEx, sizeof(lpfnAcceptEx),
+                 &dwBytes, NULL, NULL) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Failed to load AcceptEx: " << WSAGetLastError() << std::endl;
+        closesocket(acceptSocket);
+        ReleaseContext(context);
+        return false;
+    }
+
+    // Call AcceptEx
+    DWORD bytesReceived = 0;
+    if (!lpfnAcceptEx(m_listenSocket, acceptSocket, context->buffer.data(), 0,
+                      sizeof(sockaddr_in) + 16, sizeof(sockaddr_in) + 16,
+                      &bytesReceived, &context->overlapped))
+    {
+        int error = WSAGetLastError();
+        if (error != ERROR_IO_PENDING)
+        {
+            std::cerr << "[P2P] AcceptEx failed: " << error << std::endl;
+            closesocket(acceptSocket);
+            ReleaseContext(context);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Post a receive operation
+bool IOCPTransport::PostReceive(SOCKET socket)
+{
+    IOContext* context = AcquireContext(IOOperation::Receive, socket, kReceiveBufferSize);
+
+    DWORD flags = 0;
+    DWORD bytesReceived = 0;
+
+    if (WSARecv(socket, &context->wsaBuf, 1, &bytesReceived, &flags, &context->overlapped, NULL) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        if (error != WSA_IO_PENDING)
+        {
+            std::cerr << "[P2P] WSARecv failed: " << error << std::endl;
+            ReleaseContext(context);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Post a send operation
+bool IOCPTransport::Send(P2PConnection connection, std::vector<char> data)
+{
+    SOCKET socket = static_cast<SOCKET>(connection);
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        if (m_connections.find(socket) == m_connections.end())
+        {
+            return false;
+        }
+
+        // Counted until the context is released (completed, failed or aborted)
+        m_pendingSendBytes[socket] += data.size();
+    }
+
+    // The frame is moved in, not copied
+    IOContext* context = AcquireContext(IOOperation::Send, socket, 0);
+    context->buffer = std::move(data);
+    context->wsaBuf.buf = context->buffer.data();
+    context->wsaBuf.len = static_cast<ULONG>(context->buffer.size());
+    context->totalBytes = context->buffer.size();
+
+    DWORD bytesSent = 0;
+    if (WSASend(socket, &context->wsaBuf, 1, &bytesSent, 0, &context->overlapped, NULL) == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        if (error != WSA_IO_PENDING)
+        {
+            std::cerr << "[P2P] WSASend failed: " << error << std::endl;
+            ReleaseContext(context);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t IOCPTransport::GetPendingSendBytes(P2PConnection connection)
+{
+    std::lock_guard<std::mutex> lock(m_connectionsMutex);
+    auto it = m_pendingSendBytes.find(static_cast<SOCKET>(connection));
+    return it != m_pendingSendBytes.end() ? it->second : 0;
+}
+
+// IOCP worker thread
+void IOCPTransport::WorkerThread()
+{
+    std::cout << "[P2P] IOCP worker thread started" << std::endl;
+
+    while (m_isRunning)
+    {
+        DWORD bytesTransferred = 0;
+        ULONG_PTR completionKey = 0;
+        LPOVERLAPPED overlapped = NULL;
+
+        BOOL result = GetQueuedCompletionStatus(m_iocpHandle, &bytesTransferred, &completionKey, &overlapped, 1000);
+
+        if (!result)
+        {
+            if (overlapped == NULL)
+            {
+                // Timeout or error
+                continue;
+            }
+
+            // I/O operation failed
+            int error = GetLastError();
+            IOContext* failed = CONTAINING_RECORD(overlapped, IOContext, overlapped);
+            if (error != ERROR_OPERATION_ABORTED)
+            {
+                std::cerr << "[P2P] GetQueuedCompletionStatus failed: " << error << std::endl;
+
+                // A failed receive means the connection is gone
+                if (failed->operation == IOOperation::Receive)
+                {
+                    CloseFromWorker(failed->socket);
+                }
+            }
+            ReleaseContext(failed);
+            continue;
+        }
+
+        if (bytesTransferred == 0 && completionKey == 0 && overlapped == NULL)
+        {
+            // Shutdown signal
+            break;
+        }
+
+        // Get IOContext from overlapped
+        IOContext* context = CONTAINING_RECORD(overlapped, IOContext, overlapped);
+
+        // Handle operation
+        bool shouldRemove = true;
+        try
+        {
+            switch (context->operation)
+            {
+            case IOOperation::Accept:
+                HandleAccept(context);
+                break;
+            case IOOperation::Receive:
+                HandleReceive(context, bytesTransferred);
+                break;
+            case IOOperation::Send:
+                // Partial sends are re-posted with the same context
+                shouldRemove = !HandleSend(context, bytesTransferred);
+                break;
+            default:
+                break;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[P2P] Exception in IOCP worker: " << e.what() << std::endl;
+        }
+
+        if (shouldRemove)
+        {
+            ReleaseContext(context);
+        }
+    }
+
+    std::cout << "[P2P] IOCP worker thread stopped" << std::endl;
+}
+
+// Handle accept completion
+void IOCPTransport::HandleAccept(IOContext* context)
+{
+    SOCKET acceptSocket = context->socket;
+
+    // Validate socket is still active
+    if (acceptSocket == INVALID_SOCKET || !m_isRunning)
+    {
+        if (m_isRunning)
+        {
+            std::cerr << "[P2P] HandleAccept: Invalid socket" << std::endl;
+            PostAccept(); // Post new accept
+        }
+        return;
+    }
+
+    std::cout << "[P2P] Accepted new connection" << std::endl;
+
+    // Update accept socket context
+    if (setsockopt(acceptSocket, SOL_SOCKET, SO_UPDATE_ACCEPT_CONTEXT,
+                   (char*)&m_listenSocket, sizeof(m_listenSocket)) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] SO_UPDATE_ACCEPT_CONTEXT failed: " << WSAGetLastError() << std::endl;
+        closesocket(acceptSocket);
+        PostAccept(); // Post new accept
+        return;
+    }
+
+    ConfigureSocket(acceptSocket);
+
+    // Associate accepted socket with IOCP
+    if (CreateIoCompletionPort((HANDLE)acceptSocket, m_iocpHandle, (ULONG_PTR)acceptSocket, 0) == NULL)
+    {
+        std::cerr << "[P2P] Failed to associate accepted socket with IOCP: " << GetLastError() << std::endl;
+        closesocket(acceptSocket);
+        PostAccept(); // Post new accept
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        m_connections.insert(acceptSocket);
+    }
+
+    if (m_handler.onAccepted)
+    {
+        m_handler.onAccepted(static_cast<P2PConnection>(acceptSocket));
+    }
+
+    // Start receiving from this socket
+    if (!PostReceive(acceptSocket))
+    {
+        CloseFromWorker(acceptSocket);
+    }
+
+    // Post new accept
+    PostAccept();
+}
+
+// Handle receive completion
+void IOCPTransport::HandleReceive(IOContext* context, DWORD bytesTransferred)
+{
+    SOCKET socket = context->socket;
+
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        if (m_connections.find(socket) == m_connections.end())
+        {
+            return;     // Closed meanwhile
+        }
+    }
+
+    if (bytesTransferred == 0)
+    {
+        // Connection closed
+        std::cout << "[P2P] Connection closed by peer" << std::endl;
+        CloseFromWorker(socket);
+        return;
+    }
+
+    if (m_handler.onReceived)
+    {
+        m_handler.onReceived(static_cast<P2PConnection>(socket), context->buffer.data(), bytesTransferred);
+    }
+
+    // Continue receiving (unless the handler closed the connection)
+    bool stillOpen = false;
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        stillOpen = m_connections.find(socket) != m_connections.end();
+    }
+
+    if (stillOpen && !PostReceive(socket))
+    {
+        CloseFromWorker(socket);
+    }
+}
+
+// Handle send completion (true if the rest of a partial send was re-posted)
+bool IOCPTransport::HandleSend(IOContext* context, DWORD bytesTransferred)
+{
+    SOCKET socket = context->socket;
+    context->processedBytes += bytesTransferred;
+
+    // Check if all data was sent
+    if (context->processedBytes >= context->totalBytes)
+    {
+        return false;
+    }
+
+    // Partial send - need to send remaining data
+    size_t remaining = context->totalBytes - context->processedBytes;
+    std::cerr << "[P2P] Partial send: sent " << context->processedBytes << "/"
+              << context->totalBytes << " bytes, " << remaining << " remaining" << std::endl;
+
+    // Reset overlapped structure for reuse
+    ZeroMemory(&context->overlapped, sizeof(OVERLAPPED));
+
+    // Update buffer pointers for remaining data
+    context->wsaBuf.buf = context->buffer.data() + context->processedBytes;
+    context->wsaBuf.len = static_cast<ULONG>(remaining);
+
+    // Re-post send for remaining data
+    DWORD bytesSent = 0;
+    int result = WSASend(socket, &context->wsaBuf, 1, &bytesSent, 0, &context->overlapped, NULL);
+    if (result == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+        if (error != WSA_IO_PENDING)
+        {
+            std::cerr << "[P2P] WSASend failed on partial send retry: " << error << std::endl;
+            CloseFromWorker(socket);
+            return false;
+        }
+    }
+
+    // Context stays acquired until completion
+    return true;
+}
+
+P2PConnection IOCPTransport::Connect(const std::string& ipAddress, uint16_t port, int timeoutMs)
+{
+    // Create socket
+    SOCKET socket = WSASocket(AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED);
+    if (socket == INVALID_SOCKET)
+    {
+        std::cerr << "[P2P] Failed to create connect socket: " << WSAGetLastError() << std::endl;
+        return kNoConnection;
+    }
+
+    // Set non-blocking mode for connect timeout
+    u_long nonBlocking = 1;
+    if (ioctlsocket(socket, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Failed to set non-blocking mode: " << WSAGetLastError() << std::endl;
+        closesocket(socket);
+        return kNoConnection;
+    }
+
+    ConfigureSocket(socket);
+
+    // Connect to peer (non-blocking)
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, ipAddress.c_str(), &addr.sin_addr);
+
+    int result = connect(socket, (sockaddr*)&addr, sizeof(addr));
+    if (result == SOCKET_ERROR)
+    {
+        int error = WSAGetLastError();
+
+        // WSAEWOULDBLOCK is expected for non-blocking connect
+        if (error != WSAEWOULDBLOCK)
+        {
+            std::cerr << "[P2P] Failed to initiate connection to " << ipAddress << ":" << port << " - " << error << std::endl;
+            closesocket(socket);
+            return kNoConnection;
+        }
+
+        // Wait for connection to complete
+        fd_set writeSet;
+        FD_ZERO(&writeSet);
+        FD_SET(socket, &writeSet);
+
+        timeval timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_usec = (timeoutMs % 1000) * 1000;
+
+        result = select(0, nullptr, &writeSet, nullptr, &timeout);
+        if (result == 0)
+        {
+            // Timeout
+            std::cerr << "[P2P] Connection to " << ipAddress << ":" << port << " timed out (firewall/unreachable)" << std::endl;
+            closesocket(socket);
+            return kNoConnection;
+        }
+        else if (result == SOCKET_ERROR)
+        {
+            std::cerr << "[P2P] select() failed for " << ipAddress << ":" << port << " - " << WSAGetLastError() << std::endl;
+            closesocket(socket);
+            return kNoConnection;
+        }
+
+        // Check if connection succeeded or failed
+        int soError = 0;
+        int soErrorLen = sizeof(soError);
+        if (getsockopt(socket, SOL_SOCKET, SO_ERROR, (char*)&soError, &soErrorLen) == SOCKET_ERROR)
+        {
+            std::cerr << "[P2P] getsockopt() failed for " << ipAddress << ":" << port << " - " << WSAGetLastError() << std::endl;
+            closesocket(socket);
+            return kNoConnection;
+        }
+
+        if (soError != 0)
+        {
+            std::cerr << "[P2P] Connection to " << ipAddress << ":" << port << " failed - " << soError << std::endl;
+            closesocket(socket);
+            return kNoConnection;
+        }
+    }
+
+    // Set back to blocking mode for IOCP operations
+    nonBlocking = 0;
+    if (ioctlsocket(socket, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Failed to set blocking mode: " << WSAGetLastError() << std::endl;
+        closesocket(socket);
+        return kNoConnection;
+    }
+
+    // Associate with IOCP
+    if (CreateIoCompletionPort((HANDLE)socket, m_iocpHandle, (ULONG_PTR)socket, 0) == NULL)
+    {
+        std::cerr << "[P2P] Failed to associate connect socket with IOCP: " << GetLastError() << std::endl;
+        closesocket(socket);
+        return kNoConnection;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        m_connections.insert(socket);
+    }
+
+    // Start receiving
+    if (!PostReceive(socket))
+    {
+        Close(static_cast<P2PConnection>(socket));
+        return kNoConnection;
+    }
+
+    return static_cast<P2PConnection>(socket);
+}
+
+void IOCPTransport::Close(P2PConnection connection)
+{
+    SOCKET socket = static_cast<SOCKET>(connection);
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        if (m_connections.erase(socket) == 0)
+        {
+            return;
+        }
+        m_pendingSendBytes.erase(socket);
+    }
+
+    // Cancel all pending I/O operations on this socket
+    // This ensures IOCP won't complete operations after we close the socket
+    CancelIoEx((HANDLE)socket, NULL);
+
+    // Close socket (its contexts are released when the aborted completions are dequeued)
+    closesocket(socket);
+}
+
+void IOCPTransport::CloseFromWorker(SOCKET socket)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        if (m_connections.find(socket) == m_connections.end())
+        {
+            return;
+        }
+    }
+
+    Close(static_cast<P2PConnection>(socket));
+
+    if (m_handler.onClosed)
+    {
+        m_handler.onClosed(static_cast<P2PConnection>(socket));
+    }
+}
+
+std::string IOCPTransport::GetPeerAddress(P2PConnection connection)
+{
+    sockaddr_in peerAddr;
+    int peerAddrLen = sizeof(peerAddr);
+    if (getpeername(static_cast<SOCKET>(connection), (sockaddr*)&peerAddr, &peerAddrLen) != 0)
+    {
+        return std::string();
+    }
+
+    char ipStr[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &peerAddr.sin_addr, ipStr, INET_ADDRSTRLEN);
+    return ipStr;
+}
+
+// Take a context from the pool (bufferSize 0 leaves the buffer for the caller to fill)
+IOContext* IOCPTransport::AcquireContext(IOOperation operation, SOCKET socket, size_t bufferSize)
+{
+    IOContext* context = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_contextsMutex);
+        if (!m_freeContexts.empty())
+        {
+            context = m_freeContexts.back();
+            m_freeContexts.pop_back();
+        }
+        else
+        {
+            m_contexts.push_back(std::make_unique<IOContext>());
+            context = m_contexts.back().get();
+        }
+    }
+
+    // Reuses the buffer's capacity from earlier receives
+    if (bufferSize > 0)
+    {
+        context->buffer.resize(bufferSize);
+    }
+
+    context->Reset(operation, socket);
+    return context;
+}
+
+// Return a context to the pool once its operation is finished
+void IOCPTransport::ReleaseContext(IOContext* context)
+{
+    // Drop sent frames; receive buffers are kept for the next receive
+    if (context->operation == IOOperation::Send)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+            auto it = m_pendingSendBytes.find(context->socket);
+            if (it != m_pendingSendBytes.end())
+            {
+                it->second -= (std::min)(it->second, context->totalBytes);
+            }
+        }
+        std::vector<char>().swap(context->buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_contextsMutex);
+    m_freeContexts.push_back(context);
+}
+
+void IOCPTransport::ConfigureSocket(SOCKET socket)
+{
+    // Set TCP_NODELAY to disable Nagle's algorithm (critical for VPNs and real-time)
+    int nodelay = 1;
+    if (setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (char*)&nodelay, sizeof(nodelay)) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Warning: Failed to set TCP_NODELAY: " << WSAGetLastError() << std::endl;
+    }
+
+    // Set SO_KEEPALIVE to detect dead connections over VPN
+    int keepalive = 1;
+    if (setsockopt(socket, SOL_SOCKET, SO_KEEPALIVE, (char*)&keepalive, sizeof(keepalive)) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Warning: Failed to set SO_KEEPALIVE: " << WSAGetLastError() << std::endl;
+    }
+}
+
+std::wstring P2PTransport::GetHostName()
+{
+    wchar_t computerName[MAX_COMPUTERNAME_LENGTH + 1];
+    DWORD size = MAX_COMPUTERNAME_LENGTH + 1;
+    if (GetComputerNameW(computerName, &size))
+    {
+        return std::wstring(computerName);
+    }
+    return L"Unknown";
+}
+
+std::vector<std::string> P2PTransport::GetHostAddresses()
+{
+    std::vector<std::string> ips;
+
+    // Get hostname
+    char hostname[256];
+    if (gethostname(hostname, sizeof(hostname)) == SOCKET_ERROR)
+    {
+        std::cerr << "[P2P] Failed to get hostname" << std::endl;
+        return ips;
+    }
+
+    // Resolve all addresses for this hostname
+    struct addrinfo hints = {}, *result = nullptr;
+    hints.ai_family = AF_INET;  // IPv4 only
+    hints.ai_socktype = SOCK_STREAM;
+
+    if (getaddrinfo(hostname, nullptr, &hints, &result) != 0)
+    {
+        std::cerr << "[P2P] Failed to resolve local addresses" << std::endl;
+        return ips;
+    }
+
+    for (auto ptr = result; ptr != nullptr; ptr = ptr->ai_next)
+    {
+        sockaddr_in* addr = (sockaddr_in*)ptr->ai_addr;
+        char ipStr[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &addr->sin_addr, ipStr, INET_ADDRSTRLEN);
+        ips.push_back(ipStr);
+    }
+
+    freeaddrinfo(result);
+    return ips;
+}
+
+} // namespace UFB
+
+#endif // _WIN32
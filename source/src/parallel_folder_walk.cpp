@@ -0,0 +1,140 @@
+#include "parallel_folder_walk.h"
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+namespace UFB {
+
+namespace {
+
+// Idle threads re-check the stop flag at least this often
+constexpr auto kIdleWait = std::chrono::milliseconds(50);
+
+// Owner takes from the back (depth first), thieves from the front (folders near the top, so the
+// most work per steal)
+struct WorkQueue
+{
+    std::mutex mutex;
+    std::deque<ParallelFolderWalk::Folder> folders;
+};
+
+struct WalkState
+{
+    const std::atomic<bool>* running = nullptr;
+    const ParallelFolderWalk::VisitFolder* visit = nullptr;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;     // One per worker
+    std::atomic<int64_t> pendingFolders{0};             // Queued or being listed
+
+    // Idle workers wait here; workVersion changes whenever folders are queued or the walk ends
+    std::mutex idleMutex;
+    std::condition_variable idleCV;
+    std::atomic<uint64_t> workVersion{0};
+};
+
+void WakeIdleWorkers(WalkState& state)
+{
+    {
+        std::lock_guard<std::mutex> lock(state.idleMutex);
+        state.workVersion++;
+    }
+    state.idleCV.notify_all();
+}
+
+void Worker(WalkState& state, size_t workerIndex)
+{
+    WorkQueue& own = *state.queues[workerIndex];
+    const size_t queueCount = state.queues.size();
+    std::vector<ParallelFolderWalk::Folder> subfolders;
+
+    while (*state.running)
+    {
+        // Read before looking for work: a change after this wakes the wait below
+        const uint64_t seenVersion = state.workVersion;
+
+        ParallelFolderWalk::Folder folder;
+        bool found = false;
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.folders.empty())
+            {
+                folder = std::move(own.folders.back());
+                own.folders.pop_back();
+                found = true;
+            }
+        }
+
+        for (size_t i = 1; i < queueCount && !found; ++i)
+        {
+            WorkQueue& victim = *state.queues[(workerIndex + i) % queueCount];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.folders.empty())
+            {
+                folder = std::move(victim.folders.front());
+                victim.folders.pop_front();
+                found = true;
+            }
+        }
+
+        if (!found)
+        {
+            // Nothing queued anywhere: done once no other worker is still listing a folder, otherwise
+            // sleep until one queues subfolders
+            std::unique_lock<std::mutex> lock(state.idleMutex);
+            if (state.pendingFolders == 0)
+                break;
+            if (state.workVersion == seenVersion)
+                state.idleCV.wait_for(lock, kIdleWait);
+            continue;
+        }
+
+        subfolders.clear();
+        (*state.visit)(workerIndex, folder, subfolders);
+
+        if (!subfolders.empty())
+        {
+            state.pendingFolders += static_cast<int64_t>(subfolders.size());
+            {
+                std::lock_guard<std::mutex> lock(own.mutex);
+                for (auto& subfolder : subfolders)
+                    own.folders.push_back(std::move(subfolder));
+            }
+
+            // This worker goes on with the last one; the rest are for idle workers to take
+            if (subfolders.size() > 1)
+                WakeIdleWorkers(state);
+        }
+
+        if (--state.pendingFolders == 0)
+            WakeIdleWorkers(state);
+    }
+}
+
+} // namespace
+
+bool ParallelFolderWalk::Run(const Folder& root, int threadCount, const std::atomic<bool>& running,
+                             const VisitFolder& visit)
+{
+    WalkState state;
+    state.running = &running;
+    state.visit = &visit;
+    for (int i = 0; i < (std::max)(threadCount, 1); ++i)
+        state.queues.push_back(std::make_unique<WorkQueue>());
+
+    state.queues[0]->folders.push_back(root);
+    state.pendingFolders = 1;
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < state.queues.size(); ++i)
+        workers.emplace_back(Worker, std::ref(state), i);
+    for (auto& worker : workers)
+        worker.join();
+
+    return running;
+}
+
+} // namespace UFB
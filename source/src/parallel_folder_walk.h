@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+
+namespace UFB {
+
+// Walks a folder tree on a pool of threads (used by StorageAnalyzer)
+//
+// Every thread has its own queue of folders and takes work from the others when it runs out, so one
+// deep render tree doesn't leave the rest idle. Threads with nothing to take sleep until another one
+// queues subfolders or the walk is finished: one slow listing (an SMB round trip) doesn't keep the
+// idle ones spinning.
+class ParallelFolderWalk
+{
+public:
+    struct Folder
+    {
+        std::wstring path;
+        std::wstring parent;
+        uint64_t lastWriteTime = 0;
+    };
+
+    // Called once per folder on a worker thread (workerIndex < threadCount): list the folder and
+    // append the subfolders to descend into
+    using VisitFolder = std::function<void(size_t workerIndex, Folder& folder, std::vector<Folder>& outSubfolders)>;
+
+    // Visit root and every folder below it; returns false if running turned false first
+    static bool Run(const Folder& root, int threadCount, const std::atomic<bool>& running, const VisitFolder& visit);
+};
+
+} // namespace UFB
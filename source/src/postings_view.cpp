@@ -5,6 +5,7 @@
 #include "metadata_manager.h"
 #include "project_config.h"
 #include "utils.h"
+#include "directory_enumerator.h"
 #include "ole_drag_drop.h"
 #include "ImGuiDatePicker.hpp"
 #include <iostream>
@@ -20,6 +21,9 @@
 // C++20 changed u8"" literals to char8_t, need to cast for ImGui
 #define U8(x) reinterpret_cast<const char*>(u8##x)
 
+// Date filters are relative to now, so filtered rows are re-evaluated this often while one is active
+static constexpr double kTimeFilterRefreshSeconds = 60.0;
+
 // Helper functions to convert between tm and uint64_t Unix timestamps
 // Note: App stores timestamps in milliseconds, but mktime uses seconds
 static tm TimestampToTm(uint64_t timestampMillis)
@@ -109,6 +113,14 @@ void PostingsView::Initialize(const std::wstring& postingsFolderPath, const std:
         }
     };
 
+    m_fileBrowser.onCopyFiles = [this](const std::vector<std::wstring>& sources, const std::wstring& destDirectory, bool move) {
+        if (onCopyFiles) {
+            onCopyFiles(sources, destDirectory, move);
+        } else {
+            std::wcout << L"[PostingsView] WARNING: Parent onCopyFiles callback is NULL!" << std::endl;
+        }
+    };
+
     m_fileBrowser.onOpenInBrowser1 = [this](const std::wstring& path) {
         if (onOpenInBrowser1) onOpenInBrowser1(path);
     };
@@ -216,23 +228,21 @@ void PostingsView::RefreshPostingItems()
 {
     m_postingItems.clear();
     m_postingMetadataMap.clear();
+    m_postingRowsDirty = true;
 
     try
     {
-        for (const auto& entry : std::filesystem::directory_iterator(m_postingsFolderPath))
+        // One bulk directory read (no per-entry stat round trips on network shares)
+        std::vector<FileEntry> entries;
+        UFB::ListDirectory(m_postingsFolderPath, true, entries);
+
+        for (auto& fileEntry : entries)
         {
             // Skip hidden files/folders if needed
-            if (!showHiddenFiles && (entry.path().filename().wstring()[0] == L'.'))
+            if (!showHiddenFiles && fileEntry.name[0] == L'.')
                 continue;
 
-            FileEntry fileEntry;
-            fileEntry.name = entry.path().filename().wstring();
-            fileEntry.fullPath = entry.path().wstring();
-            fileEntry.isDirectory = entry.is_directory();
-            fileEntry.size = entry.is_directory() ? 0 : entry.file_size();
-            fileEntry.lastModified = entry.last_write_time();
-
-            m_postingItems.push_back(fileEntry);
+            m_postingItems.push_back(std::move(fileEntry));
         }
 
         // Sort alphabetically
@@ -435,6 +445,9 @@ void PostingsView::Draw(const char* title, HWND hwnd)
         }
     }
 
+    // Keyboard paste/delete (and a table that was not drawn this frame)
+    RunPendingReloads();
+
     ImGui::End();
 }
 
@@ -520,12 +533,14 @@ void PostingsView::DrawPostingsPanel(HWND hwnd)
                     m_filterStatuses.insert(status);
                 else
                     m_filterStatuses.erase(status);
+                m_postingRowsDirty = true;
             }
         }
         ImGui::Separator();
         if (ImGui::Button("Clear All"))
         {
             m_filterStatuses.clear();
+            m_postingRowsDirty = true;
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -555,12 +570,14 @@ void PostingsView::DrawPostingsPanel(HWND hwnd)
                     m_filterCategories.insert(category);
                 else
                     m_filterCategories.erase(category);
+                m_postingRowsDirty = true;
             }
         }
         ImGui::Separator();
         if (ImGui::Button("Clear All"))
         {
             m_filterCategories.clear();
+            m_postingRowsDirty = true;
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -591,6 +608,7 @@ void PostingsView::DrawPostingsPanel(HWND hwnd)
             if (ImGui::Selectable(dateOptions[i], isSelected))
             {
                 m_filterDateModified = i;
+                m_postingRowsDirty = true;
             }
         }
         ImGui::EndPopup();
@@ -608,6 +626,7 @@ void PostingsView::DrawPostingsPanel(HWND hwnd)
             m_filterStatuses.clear();
             m_filterCategories.clear();
             m_filterDateModified = 0;
+            m_postingRowsDirty = true;
         }
         if (font_icons) ImGui::PopFont();
         if (ImGui::IsItemHovered())
@@ -875,462 +894,472 @@ void PostingsView::DrawPostingsPanel(HWND hwnd)
                     });
                 }
                 sortSpecs->SpecsDirty = false;
+                m_postingRowsDirty = true;
             }
         }
 
-        for (int i = 0; i < m_postingItems.size(); i++)
-        {
-            const FileEntry& entry = m_postingItems[i];
-
-            // Apply filters - skip if doesn't pass
-            if (!PassesFilters(entry))
-                continue;
+        // Filtered rows and their labels are rebuilt only when items, metadata, filters or sort order
+        // change (or periodically while a date filter is active, since it is relative to now)
+        if (m_postingRowsDirty || (m_filterDateModified != 0 && glfwGetTime() - m_postingRowsBuiltTime > kTimeFilterRefreshSeconds))
+            RebuildPostingRows();
 
-            // Set minimum row height
-            ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
-            ImGui::TableNextColumn();
+        // Only the visible rows are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_postingRows.size()));
 
-            ImGui::PushID(i);
-
-            // Get icon
-            ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, entry.isDirectory);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                const PostingRow& postingRow = m_postingRows[row];
+                const int i = postingRow.index;
 
-            bool isSelected = (i == m_selectedPostingIndex);
+                const FileEntry& entry = m_postingItems[i];
 
-            // Get or create metadata for this posting (needed for star icon)
-            UFB::ShotMetadata* metadata = nullptr;
-            auto metadataIt = m_postingMetadataMap.find(entry.fullPath);
-            if (metadataIt != m_postingMetadataMap.end())
-                metadata = &metadataIt->second;
+                // Set minimum row height
+                ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
+                ImGui::TableNextColumn();
 
-            // Use accent color for selected items
-            ImVec4 accentColor = GetAccentColor();
-            if (isSelected)
-            {
-                ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
-                ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
-                ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
-            }
+                ImGui::PushID(i);
 
-            // Draw icon or star if tracked
-            if (metadata && metadata->isTracked)
-            {
-                // Draw star icon for tracked items (use bright variant)
-                ImVec4 brightAccent = ImVec4(accentColor.x * 1.3f, accentColor.y * 1.3f, accentColor.z * 1.3f, 1.0f);
-                ImGui::PushStyleColor(ImGuiCol_Text, brightAccent);
-                ImGui::Text("\xE2\x98\x85");  // Unicode star character (U+2605)
-                ImGui::PopStyleColor();
-                ImGui::SameLine();
-            }
-            else if (icon)
-            {
-                // Draw folder icon for untracked items
-                ImGui::Image(icon, ImVec2(16, 16));
-                ImGui::SameLine();
-            }
+                // Get icon
+                ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, entry.isDirectory);
 
-            // Convert name to UTF-8
-            char nameUtf8[512];
-            WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, nameUtf8, sizeof(nameUtf8), nullptr, nullptr);
+                bool isSelected = (i == m_selectedPostingIndex);
 
-            // Use explicit height to match row height (35.0f)
-            if (ImGui::Selectable(nameUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
-            {
-                // Select this posting item
-                m_selectedPostingIndex = i;
+                // Get or create metadata for this posting (needed for star icon)
+                UFB::ShotMetadata* metadata = nullptr;
+                auto metadataIt = m_postingMetadataMap.find(entry.fullPath);
+                if (metadataIt != m_postingMetadataMap.end())
+                    metadata = &metadataIt->second;
 
-                // Navigate right panel to this location
-                if (entry.isDirectory)
-                {
-                    m_fileBrowser.SetCurrentDirectory(entry.fullPath);
-                }
-                else
+                // Use accent color for selected items
+                ImVec4 accentColor = GetAccentColor();
+                if (isSelected)
                 {
-                    // If it's a file, navigate to its parent directory
-                    std::filesystem::path filePath(entry.fullPath);
-                    m_fileBrowser.SetCurrentDirectory(filePath.parent_path().wstring());
+                    ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
+                    ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
+                    ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
                 }
 
-                // Double-click detection
-                double currentTime = glfwGetTime();
-                if (m_lastClickedPostingIndex == i && (currentTime - m_lastClickTime) < 0.3)
+                // Draw icon or star if tracked
+                if (metadata && metadata->isTracked)
                 {
-                    // Double-clicked - open in file explorer or default app
-                    ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                    // Draw star icon for tracked items (use bright variant)
+                    ImVec4 brightAccent = ImVec4(accentColor.x * 1.3f, accentColor.y * 1.3f, accentColor.z * 1.3f, 1.0f);
+                    ImGui::PushStyleColor(ImGuiCol_Text, brightAccent);
+                    ImGui::Text("\xE2\x98\x85");  // Unicode star character (U+2605)
+                    ImGui::PopStyleColor();
+                    ImGui::SameLine();
                 }
-                m_lastClickTime = currentTime;
-                m_lastClickedPostingIndex = i;
-            }
-
-            if (isSelected)
-            {
-                ImGui::PopStyleColor(3);
-            }
-
-            // Context menu
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
-            {
-                ImGui::OpenPopup("posting_context_menu");
-            }
-
-            ShowImGuiContextMenu(hwnd, entry);
-
-            // Middle-click to open in new window
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
-            {
-                if (onOpenInNewWindow)
+                else if (icon)
                 {
-                    std::filesystem::path targetPath(entry.fullPath);
-                    std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
-                    onOpenInNewWindow(pathToOpen);
+                    // Draw folder icon for untracked items
+                    ImGui::Image(icon, ImVec2(16, 16));
+                    ImGui::SameLine();
                 }
-            }
-
-            // Push mono font for all metadata columns (not the name)
-            if (font_mono)
-                ImGui::PushFont(font_mono);
-
-            // If no metadata exists, create a default one in memory
-            UFB::ShotMetadata tempMetadata;
-            if (!metadata)
-            {
-                tempMetadata.shotPath = entry.fullPath;
-                tempMetadata.folderType = "postings";  // Fixed folder type for postings
-                tempMetadata.isTracked = false;
 
-                // Load default metadata values from ProjectConfig
-                if (m_projectConfig && m_projectConfig->IsLoaded())
+                // Use explicit height to match row height (35.0f)
+                if (ImGui::Selectable(postingRow.name.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
                 {
-                    auto defaultMeta = m_projectConfig->GetDefaultMetadata(tempMetadata.folderType);
-                    if (defaultMeta.has_value())
+                    // Select this posting item
+                    m_selectedPostingIndex = i;
+
+                    // Navigate right panel to this location
+                    if (entry.isDirectory)
                     {
-                        tempMetadata.status = defaultMeta->status;
-                        tempMetadata.category = defaultMeta->category;
-                        tempMetadata.priority = defaultMeta->priority;
-                        tempMetadata.artist = defaultMeta->artist;
-                        tempMetadata.note = defaultMeta->note;
-                        // dueDate and links stay at defaults (0 and empty)
+                        m_fileBrowser.SetCurrentDirectory(entry.fullPath);
                     }
                     else
                     {
-                        // Fallback if no default metadata found
-                        tempMetadata.priority = 2;
+                        // If it's a file, navigate to its parent directory
+                        std::filesystem::path filePath(entry.fullPath);
+                        m_fileBrowser.SetCurrentDirectory(filePath.parent_path().wstring());
                     }
+
+                    // Double-click detection
+                    double currentTime = glfwGetTime();
+                    if (m_lastClickedPostingIndex == i && (currentTime - m_lastClickTime) < 0.3)
+                    {
+                        // Double-clicked - open in file explorer or default app
+                        ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                    }
+                    m_lastClickTime = currentTime;
+                    m_lastClickedPostingIndex = i;
                 }
-                else
+
+                if (isSelected)
                 {
-                    // Fallback if ProjectConfig not loaded
-                    tempMetadata.priority = 2;
+                    ImGui::PopStyleColor(3);
                 }
 
-                metadata = &tempMetadata;
-            }
-
-            // Store if we need to save changes
-            bool metadataChanged = false;
+                // Context menu
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
+                {
+                    ImGui::OpenPopup("posting_context_menu");
+                }
 
-            // Safety check: metadata should always be valid at this point
-            if (!metadata)
-            {
-                std::cerr << "[PostingsView] ERROR: metadata pointer is null for posting: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+                ShowImGuiContextMenu(hwnd, entry);
 
-                // Fill remaining columns with error text
-                for (const auto& [col, visible] : m_visibleColumns)
+                // Middle-click to open in new window
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
                 {
-                    if (visible)
+                    if (onOpenInNewWindow)
                     {
-                        ImGui::TableNextColumn();
-                        ImGui::TextDisabled("(error)");
+                        std::filesystem::path targetPath(entry.fullPath);
+                        std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
+                        onOpenInNewWindow(pathToOpen);
                     }
                 }
 
-                // Modified column
-                ImGui::TableNextColumn();
-                ImGui::TextDisabled("(error)");
-
+                // Push mono font for all metadata columns (not the name)
                 if (font_mono)
-                    ImGui::PopFont();
-
-                ImGui::PopID();
-                continue;
-            }
-
-            // Status column
-            if (m_visibleColumns["Status"])
-            {
-                ImGui::TableNextColumn();
+                    ImGui::PushFont(font_mono);
 
-                // Get available status options
-                std::vector<UFB::StatusOption> statusOptions;
-                if (m_projectConfig && m_projectConfig->IsLoaded())
+                // If no metadata exists, create a default one in memory
+                UFB::ShotMetadata tempMetadata;
+                if (!metadata)
                 {
-                    statusOptions = m_projectConfig->GetStatusOptions("postings");
-                }
+                    tempMetadata.shotPath = entry.fullPath;
+                    tempMetadata.folderType = "postings";  // Fixed folder type for postings
+                    tempMetadata.isTracked = false;
 
-                // Color the text
-                ImVec4 statusColor = GetStatusColor(metadata->status);
-                ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
+                    // Load default metadata values from ProjectConfig
+                    if (m_projectConfig && m_projectConfig->IsLoaded())
+                    {
+                        auto defaultMeta = m_projectConfig->GetDefaultMetadata(tempMetadata.folderType);
+                        if (defaultMeta.has_value())
+                        {
+                            tempMetadata.status = defaultMeta->status;
+                            tempMetadata.category = defaultMeta->category;
+                            tempMetadata.priority = defaultMeta->priority;
+                            tempMetadata.artist = defaultMeta->artist;
+                            tempMetadata.note = defaultMeta->note;
+                            // dueDate and links stay at defaults (0 and empty)
+                        }
+                        else
+                        {
+                            // Fallback if no default metadata found
+                            tempMetadata.priority = 2;
+                        }
+                    }
+                    else
+                    {
+                        // Fallback if ProjectConfig not loaded
+                        tempMetadata.priority = 2;
+                    }
 
-                // Create combo box ID
-                std::string comboId = "##status_" + std::to_string(i);
+                    metadata = &tempMetadata;
+                }
 
-                // Display current status or "(No options configured)"
-                const char* currentStatus = statusOptions.empty() ? "(No options configured)" :
-                                           (metadata->status.empty() ? statusOptions[0].name.c_str() : metadata->status.c_str());
+                // Store if we need to save changes
+                bool metadataChanged = false;
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(comboId.c_str(), currentStatus, ImGuiComboFlags_HeightLarge))
+                // Safety check: metadata should always be valid at this point
+                if (!metadata)
                 {
-                    for (const auto& statusOption : statusOptions)
-                    {
-                        // Apply color to this option
-                        ImVec4 optionColor = GetStatusColor(statusOption.name);
-                        ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+                    std::cerr << "[PostingsView] ERROR: metadata pointer is null for posting: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
 
-                        bool isSelected = (metadata->status == statusOption.name);
-                        if (ImGui::Selectable(statusOption.name.c_str(), isSelected))
+                    // Fill remaining columns with error text
+                    for (const auto& [col, visible] : m_visibleColumns)
+                    {
+                        if (visible)
                         {
-                            metadata->status = statusOption.name;
-                            metadataChanged = true;
+                            ImGui::TableNextColumn();
+                            ImGui::TextDisabled("(error)");
                         }
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
-
-                        ImGui::PopStyleColor();
                     }
-                    ImGui::EndCombo();
-                }
 
-                ImGui::PopStyleColor();
-            }
+                    // Modified column
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("(error)");
 
-            // Category column
-            if (m_visibleColumns["Category"])
-            {
-                ImGui::TableNextColumn();
+                    if (font_mono)
+                        ImGui::PopFont();
 
-                // Get available category options
-                std::vector<UFB::CategoryOption> categoryOptions;
-                if (m_projectConfig && m_projectConfig->IsLoaded())
-                {
-                    categoryOptions = m_projectConfig->GetCategoryOptions("postings");
+                    ImGui::PopID();
+                    continue;
                 }
 
-                // Color the text
-                ImVec4 categoryColor = GetCategoryColor(metadata->category);
-                ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
+                // Status column
+                if (m_visibleColumns["Status"])
+                {
+                    ImGui::TableNextColumn();
+
+                    // Get available status options
+                    std::vector<UFB::StatusOption> statusOptions;
+                    if (m_projectConfig && m_projectConfig->IsLoaded())
+                    {
+                        statusOptions = m_projectConfig->GetStatusOptions("postings");
+                    }
+
+                    // Color the text
+                    ImVec4 statusColor = GetStatusColor(metadata->status);
+                    ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
 
-                // Create combo box ID
-                std::string comboId = "##category_" + std::to_string(i);
+                    // Create combo box ID
+                    std::string comboId = "##status_" + std::to_string(i);
 
-                // Display current category or "(No options configured)"
-                const char* currentCategory = categoryOptions.empty() ? "(No options configured)" :
-                                             (metadata->category.empty() ? categoryOptions[0].name.c_str() : metadata->category.c_str());
+                    // Display current status or "(No options configured)"
+                    const char* currentStatus = statusOptions.empty() ? "(No options configured)" :
+                                               (metadata->status.empty() ? statusOptions[0].name.c_str() : metadata->status.c_str());
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(comboId.c_str(), currentCategory, ImGuiComboFlags_HeightLarge))
-                {
-                    for (const auto& categoryOption : categoryOptions)
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(comboId.c_str(), currentStatus, ImGuiComboFlags_HeightLarge))
                     {
-                        // Apply color to this option
-                        ImVec4 optionColor = GetCategoryColor(categoryOption.name);
-                        ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
-
-                        bool isSelected = (metadata->category == categoryOption.name);
-                        if (ImGui::Selectable(categoryOption.name.c_str(), isSelected))
+                        for (const auto& statusOption : statusOptions)
                         {
-                            metadata->category = categoryOption.name;
-                            metadataChanged = true;
-                        }
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                            // Apply color to this option
+                            ImVec4 optionColor = GetStatusColor(statusOption.name);
+                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
 
-                        ImGui::PopStyleColor();
+                            bool isSelected = (metadata->status == statusOption.name);
+                            if (ImGui::Selectable(statusOption.name.c_str(), isSelected))
+                            {
+                                metadata->status = statusOption.name;
+                                metadataChanged = true;
+                            }
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+
+                            ImGui::PopStyleColor();
+                        }
+                        ImGui::EndCombo();
                     }
-                    ImGui::EndCombo();
+
+                    ImGui::PopStyleColor();
                 }
 
-                ImGui::PopStyleColor();
-            }
+                // Category column
+                if (m_visibleColumns["Category"])
+                {
+                    ImGui::TableNextColumn();
 
-            // Artist column
-            if (m_visibleColumns["Artist"])
-            {
-                ImGui::TableNextColumn();
+                    // Get available category options
+                    std::vector<UFB::CategoryOption> categoryOptions;
+                    if (m_projectConfig && m_projectConfig->IsLoaded())
+                    {
+                        categoryOptions = m_projectConfig->GetCategoryOptions("postings");
+                    }
 
-                // Get available users
-                std::vector<UFB::User> users;
-                if (m_projectConfig && m_projectConfig->IsLoaded())
-                {
-                    users = m_projectConfig->GetUsers();
-                }
+                    // Color the text
+                    ImVec4 categoryColor = GetCategoryColor(metadata->category);
+                    ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
 
-                // Create combo box ID
-                std::string comboId = "##artist_" + std::to_string(i);
+                    // Create combo box ID
+                    std::string comboId = "##category_" + std::to_string(i);
 
-                // Display current artist or "(No options configured)"
-                const char* currentArtist = users.empty() ? "(No options configured)" :
-                                           (metadata->artist.empty() ? users[0].displayName.c_str() : metadata->artist.c_str());
+                    // Display current category or "(No options configured)"
+                    const char* currentCategory = categoryOptions.empty() ? "(No options configured)" :
+                                                 (metadata->category.empty() ? categoryOptions[0].name.c_str() : metadata->category.c_str());
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(comboId.c_str(), currentArtist, ImGuiComboFlags_HeightLarge))
-                {
-                    for (const auto& user : users)
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(comboId.c_str(), currentCategory, ImGuiComboFlags_HeightLarge))
                     {
-                        bool isSelected = (metadata->artist == user.displayName);
-                        if (ImGui::Selectable(user.displayName.c_str(), isSelected))
+                        for (const auto& categoryOption : categoryOptions)
                         {
-                            metadata->artist = user.displayName;
-                            metadataChanged = true;
+                            // Apply color to this option
+                            ImVec4 optionColor = GetCategoryColor(categoryOption.name);
+                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+
+                            bool isSelected = (metadata->category == categoryOption.name);
+                            if (ImGui::Selectable(categoryOption.name.c_str(), isSelected))
+                            {
+                                metadata->category = categoryOption.name;
+                                metadataChanged = true;
+                            }
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+
+                            ImGui::PopStyleColor();
                         }
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                        ImGui::EndCombo();
                     }
-                    ImGui::EndCombo();
+
+                    ImGui::PopStyleColor();
                 }
-            }
 
-            // Priority column
-            if (m_visibleColumns["Priority"])
-            {
-                ImGui::TableNextColumn();
+                // Artist column
+                if (m_visibleColumns["Artist"])
+                {
+                    ImGui::TableNextColumn();
 
-                const char* priorityLabels[] = { "High", "Medium", "Low" };
-                const char* currentPriority = priorityLabels[metadata->priority];
+                    // Get available users
+                    std::vector<UFB::User> users;
+                    if (m_projectConfig && m_projectConfig->IsLoaded())
+                    {
+                        users = m_projectConfig->GetUsers();
+                    }
 
-                std::string comboId = "##priority_" + std::to_string(i);
+                    // Create combo box ID
+                    std::string comboId = "##artist_" + std::to_string(i);
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(comboId.c_str(), currentPriority))
-                {
-                    for (int p = 0; p < 3; p++)
+                    // Display current artist or "(No options configured)"
+                    const char* currentArtist = users.empty() ? "(No options configured)" :
+                                               (metadata->artist.empty() ? users[0].displayName.c_str() : metadata->artist.c_str());
+
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(comboId.c_str(), currentArtist, ImGuiComboFlags_HeightLarge))
                     {
-                        bool isSelected = (metadata->priority == p);
-                        if (ImGui::Selectable(priorityLabels[p], isSelected))
+                        for (const auto& user : users)
                         {
-                            metadata->priority = p;
-                            metadataChanged = true;
+                            bool isSelected = (metadata->artist == user.displayName);
+                            if (ImGui::Selectable(user.displayName.c_str(), isSelected))
+                            {
+                                metadata->artist = user.displayName;
+                                metadataChanged = true;
+                            }
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
                         }
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                        ImGui::EndCombo();
                     }
-                    ImGui::EndCombo();
                 }
-            }
 
-            // Due Date column
-            if (m_visibleColumns["DueDate"])
-            {
-                ImGui::TableNextColumn();
+                // Priority column
+                if (m_visibleColumns["Priority"])
+                {
+                    ImGui::TableNextColumn();
 
-                std::string dateStr = FormatTimestamp(metadata->dueDate);
-                std::string buttonLabel = dateStr.empty() ? "Set Date##" + std::to_string(i) : dateStr + "##" + std::to_string(i);
+                    const char* priorityLabels[] = { "High", "Medium", "Low" };
+                    const char* currentPriority = priorityLabels[metadata->priority];
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::Button(buttonLabel.c_str()))
-                {
-                    m_showDatePicker = true;
-                    m_datePickerPostingIndex = i;
+                    std::string comboId = "##priority_" + std::to_string(i);
+
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(comboId.c_str(), currentPriority))
+                    {
+                        for (int p = 0; p < 3; p++)
+                        {
+                            bool isSelected = (metadata->priority == p);
+                            if (ImGui::Selectable(priorityLabels[p], isSelected))
+                            {
+                                metadata->priority = p;
+                                metadataChanged = true;
+                            }
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+                        }
+                        ImGui::EndCombo();
+                    }
                 }
 
-                // Date picker popup
-                if (m_showDatePicker && m_datePickerPostingIndex == i)
+                // Due Date column
+                if (m_visibleColumns["DueDate"])
                 {
-                    std::string popupId = "DatePicker##" + std::to_string(i);
-                    ImGui::OpenPopup(popupId.c_str());
+                    ImGui::TableNextColumn();
+
+                    std::string dateStr = FormatTimestamp(metadata->dueDate);
+                    std::string buttonLabel = dateStr.empty() ? "Set Date##" + std::to_string(i) : dateStr + "##" + std::to_string(i);
 
-                    if (ImGui::BeginPopup(popupId.c_str()))
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::Button(buttonLabel.c_str()))
                     {
-                        tm currentDate = TimestampToTm(metadata->dueDate > 0 ? metadata->dueDate : static_cast<uint64_t>(std::time(nullptr)) * 1000);
+                        m_showDatePicker = true;
+                        m_datePickerPostingIndex = i;
+                    }
 
-                        if (ImGui::DatePicker("##datepicker", currentDate, false))
-                        {
-                            metadata->dueDate = TmToTimestamp(currentDate);
-                            metadataChanged = true;
-                        }
+                    // Date picker popup
+                    if (m_showDatePicker && m_datePickerPostingIndex == i)
+                    {
+                        std::string popupId = "DatePicker##" + std::to_string(i);
+                        ImGui::OpenPopup(popupId.c_str());
 
-                        if (ImGui::Button("Clear"))
+                        if (ImGui::BeginPopup(popupId.c_str()))
                         {
-                            metadata->dueDate = 0;
-                            metadataChanged = true;
-                            m_showDatePicker = false;
-                            ImGui::CloseCurrentPopup();
-                        }
+                            tm currentDate = TimestampToTm(metadata->dueDate > 0 ? metadata->dueDate : static_cast<uint64_t>(std::time(nullptr)) * 1000);
 
-                        ImGui::SameLine();
+                            if (ImGui::DatePicker("##datepicker", currentDate, false))
+                            {
+                                metadata->dueDate = TmToTimestamp(currentDate);
+                                metadataChanged = true;
+                            }
+
+                            if (ImGui::Button("Clear"))
+                            {
+                                metadata->dueDate = 0;
+                                metadataChanged = true;
+                                m_showDatePicker = false;
+                                ImGui::CloseCurrentPopup();
+                            }
 
-                        if (ImGui::Button("Close"))
+                            ImGui::SameLine();
+
+                            if (ImGui::Button("Close"))
+                            {
+                                m_showDatePicker = false;
+                                ImGui::CloseCurrentPopup();
+                            }
+
+                            ImGui::EndPopup();
+                        }
+                        else
                         {
                             m_showDatePicker = false;
-                            ImGui::CloseCurrentPopup();
                         }
-
-                        ImGui::EndPopup();
-                    }
-                    else
-                    {
-                        m_showDatePicker = false;
                     }
                 }
-            }
 
-            // Notes column
-            if (m_visibleColumns["Notes"])
-            {
-                ImGui::TableNextColumn();
+                // Notes column
+                if (m_visibleColumns["Notes"])
+                {
+                    ImGui::TableNextColumn();
 
-                char noteBuffer[256];
-                strncpy_s(noteBuffer, metadata->note.c_str(), sizeof(noteBuffer) - 1);
-                noteBuffer[sizeof(noteBuffer) - 1] = '\0';
+                    char noteBuffer[256];
+                    strncpy_s(noteBuffer, metadata->note.c_str(), sizeof(noteBuffer) - 1);
+                    noteBuffer[sizeof(noteBuffer) - 1] = '\0';
 
-                std::string inputId = "##note_" + std::to_string(i);
-                ImGui::SetNextItemWidth(-FLT_MIN);
+                    std::string inputId = "##note_" + std::to_string(i);
+                    ImGui::SetNextItemWidth(-FLT_MIN);
 
-                if (ImGui::InputText(inputId.c_str(), noteBuffer, sizeof(noteBuffer)))
-                {
-                    metadata->note = noteBuffer;
-                    metadataChanged = true;
+                    if (ImGui::InputText(inputId.c_str(), noteBuffer, sizeof(noteBuffer)))
+                    {
+                        metadata->note = noteBuffer;
+                        metadataChanged = true;
+                    }
                 }
-            }
 
-            // Links column
-            if (m_visibleColumns["Links"])
-            {
-                ImGui::TableNextColumn();
+                // Links column
+                if (m_visibleColumns["Links"])
+                {
+                    ImGui::TableNextColumn();
 
-                int linkCount = static_cast<int>(metadata->links.size());
-                std::string linkText = std::to_string(linkCount);
-                ImGui::TextDisabled("%s", linkText.c_str());
+                    int linkCount = static_cast<int>(metadata->links.size());
+                    std::string linkText = std::to_string(linkCount);
+                    ImGui::TextDisabled("%s", linkText.c_str());
 
-                // TODO: Add link management UI in future
-            }
+                    // TODO: Add link management UI in future
+                }
 
-            // Pop mono font
-            if (font_mono)
-                ImGui::PopFont();
+                // Pop mono font
+                if (font_mono)
+                    ImGui::PopFont();
 
-            // Modified column
-            ImGui::TableNextColumn();
-            if (font_mono)
-                ImGui::PushFont(font_mono);
-            ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
-            if (font_mono)
-                ImGui::PopFont();
+                // Modified column
+                ImGui::TableNextColumn();
+                if (font_mono)
+                    ImGui::PushFont(font_mono);
+                ImGui::TextDisabled("%s", postingRow.modified.c_str());
+                if (font_mono)
+                    ImGui::PopFont();
 
-            // Save metadata changes
-            if (metadataChanged && m_subscriptionManager)
-            {
-                // Update the map
-                m_postingMetadataMap[entry.fullPath] = *metadata;
+                // Save metadata changes
+                if (metadataChanged && m_subscriptionManager)
+                {
+                    // Update the map
+                    m_postingMetadataMap[entry.fullPath] = *metadata;
+                    m_postingRowsDirty = true;
 
-                // Save to database
-                m_subscriptionManager->CreateOrUpdateShotMetadata(*metadata);
-            }
+                    // Save to database
+                    m_subscriptionManager->CreateOrUpdateShotMetadata(*metadata);
+                }
 
-            ImGui::PopID();
+                ImGui::PopID();
+            }
         }
 
         ImGui::EndTable();
+        RunPendingReloads();
     }
 
     ImGui::PopStyleVar();  // CellPadding
@@ -1582,6 +1611,7 @@ void PostingsView::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry)
 
                 // Update local map
                 m_postingMetadataMap[entry.fullPath] = postingMeta;
+                m_postingRowsDirty = true;
             }
 
             ImGui::PopStyleColor();
@@ -1721,6 +1751,7 @@ void PostingsView::PasteFilesFromClipboard()
         UINT fileCount = DragQueryFileW(hDrop, 0xFFFFFFFF, nullptr, 0);
 
         std::wstring sourceFiles;
+        std::vector<std::wstring> sourcePaths;
         for (UINT i = 0; i < fileCount; i++)
         {
             wchar_t filePath[MAX_PATH];
@@ -1728,25 +1759,35 @@ void PostingsView::PasteFilesFromClipboard()
             {
                 sourceFiles += filePath;
                 sourceFiles += L'\0';
+                sourcePaths.push_back(filePath);
             }
         }
         sourceFiles += L'\0';
 
-        SHFILEOPSTRUCTW fileOp = {};
-        fileOp.wFunc = FO_COPY;
-        fileOp.pFrom = sourceFiles.c_str();
-        fileOp.pTo = targetDir.c_str();
-        fileOp.fFlags = FOF_ALLOWUNDO | FOF_NOCONFIRMMKDIR;
-
-        int result = SHFileOperationW(&fileOp);
-        if (result == 0 && !m_cutFiles.empty())
+        if (onCopyFiles)
         {
-            DeleteFilesToRecycleBin(m_cutFiles);
+            // Queued on the copy engine (cut + paste is a move)
+            onCopyFiles(sourcePaths, targetDir, !m_cutFiles.empty());
             m_cutFiles.clear();
         }
+        else
+        {
+            SHFILEOPSTRUCTW fileOp = {};
+            fileOp.wFunc = FO_COPY;
+            fileOp.pFrom = sourceFiles.c_str();
+            fileOp.pTo = targetDir.c_str();
+            fileOp.fFlags = FOF_ALLOWUNDO | FOF_NOCONFIRMMKDIR;
+
+            int result = SHFileOperationW(&fileOp);
+            if (result == 0 && !m_cutFiles.empty())
+            {
+                DeleteFilesToRecycleBin(m_cutFiles);
+                m_cutFiles.clear();
+            }
+        }
 
-        // Refresh file lists
-        RefreshPostingItems();
+        // Refresh file lists once the table being drawn has ended
+        m_reloadItemsPending = true;
     }
 
     CloseClipboard();
@@ -1781,8 +1822,8 @@ void PostingsView::DeleteFilesToRecycleBin(const std::vector<std::wstring>& path
     int result = SHFileOperationW(&fileOp);
     if (result == 0)
     {
-        // Refresh file lists
-        RefreshPostingItems();
+        // Refresh file lists once the table being drawn has ended
+        m_reloadItemsPending = true;
     }
 }
 
@@ -1951,6 +1992,9 @@ void PostingsView::LoadMetadata()
 
     // Collect available filter values from metadata
     CollectAvailableFilterValues();
+
+    // Filtered rows depend on metadata
+    m_postingRowsDirty = true;
 }
 
 void PostingsView::ReloadMetadata()
@@ -2315,3 +2359,34 @@ bool PostingsView::PassesFilters(const FileEntry& entry)
 
     return true;
 }
+
+void PostingsView::RebuildPostingRows()
+{
+    m_postingRows.clear();
+    m_postingRows.reserve(m_postingItems.size());
+
+    for (int i = 0; i < static_cast<int>(m_postingItems.size()); i++)
+    {
+        const FileEntry& entry = m_postingItems[i];
+        if (!PassesFilters(entry))
+            continue;
+
+        PostingRow row;
+        row.index = i;
+        row.name = UFB::WideToUtf8(entry.name);
+        row.modified = FormatFileTime(entry.lastModified);
+        m_postingRows.push_back(std::move(row));
+    }
+
+    m_postingRowsDirty = false;
+    m_postingRowsBuiltTime = glfwGetTime();
+}
+
+void PostingsView::RunPendingReloads()
+{
+    if (m_reloadItemsPending)
+    {
+        m_reloadItemsPending = false;
+        RefreshPostingItems();
+    }
+}
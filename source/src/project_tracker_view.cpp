@@ -22,6 +22,9 @@ extern ImFont* font_regular;
 extern ImFont* font_mono;
 extern ImFont* font_icons;
 
+// Static members
+UFB::StorageAnalyzer* ProjectTrackerView::storageAnalyzer = nullptr;
+
 // Helper functions to convert between tm and uint64_t Unix timestamps
 static tm TimestampToTm(uint64_t timestampMillis)
 {
@@ -48,6 +51,24 @@ static uint64_t TmToTimestamp(const tm& time)
     return static_cast<uint64_t>(timeSeconds) * 1000;
 }
 
+// Byte count as "1.23 GB" (same format as the shot view)
+static std::string FormatFileSize(uint64_t size)
+{
+    const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+    int unitIndex = 0;
+    double displaySize = static_cast<double>(size);
+
+    while (displaySize >= 1024.0 && unitIndex < 4)
+    {
+        displaySize /= 1024.0;
+        unitIndex++;
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.2f %s", displaySize, units[unitIndex]);
+    return std::string(buffer);
+}
+
 // Hex color string to ImVec4
 static ImVec4 HexToImVec4(const std::string& hex)
 {
@@ -154,6 +175,7 @@ void ProjectTrackerView::RefreshTrackedItems()
     m_trackedAssets = m_subscriptionManager->GetTrackedItems(m_jobPath, "asset");
     m_trackedPostings = m_subscriptionManager->GetTrackedItems(m_jobPath, "posting");
     m_manualTasks = m_subscriptionManager->GetTrackedItems(m_jobPath, "manual_task");
+    m_itemUsageVersion = UINT64_MAX;
 
     // Update unified items list with filters applied
     UpdateUnifiedItemsList();
@@ -684,7 +706,7 @@ void ProjectTrackerView::Draw(const char* title, HWND hwnd)
 
 void ProjectTrackerView::SortItems(std::vector<UFB::ShotMetadata>& items, int column, bool ascending)
 {
-    std::sort(items.begin(), items.end(), [column, ascending](const UFB::ShotMetadata& a, const UFB::ShotMetadata& b) {
+    std::sort(items.begin(), items.end(), [this, column, ascending](const UFB::ShotMetadata& a, const UFB::ShotMetadata& b) {
         bool result = false;
         switch (column)
         {
@@ -698,6 +720,14 @@ void ProjectTrackerView::SortItems(std::vector<UFB::ShotMetadata>& items, int co
             case 7: result = a.modifiedTime < b.modifiedTime; break; // Modified Date
             case 8: result = a.links < b.links; break;            // Links
             case 9: result = a.note < b.note; break;              // Notes
+            case 10:                                              // Size
+            {
+                auto itA = m_itemUsage.find(a.shotPath);
+                auto itB = m_itemUsage.find(b.shotPath);
+                result = (itA != m_itemUsage.end() ? itA->second.totalSize : 0) <
+                         (itB != m_itemUsage.end() ? itB->second.totalSize : 0);
+                break;
+            }
             default: result = false; break;
         }
         return ascending ? result : !result;
@@ -993,6 +1023,69 @@ void ProjectTrackerView::UpdateUnifiedItemsList()
     {
         m_selectedItemIndex = -1;
     }
+
+    RebuildItemLabels();
+}
+
+void ProjectTrackerView::RebuildItemLabels()
+{
+    m_allItemsLabels.clear();
+    m_allItemsLabels.resize(m_allItems.size());
+
+    for (size_t i = 0; i < m_allItems.size(); i++)
+    {
+        const auto& item = m_allItems[i];
+        ItemLabels& labels = m_allItemsLabels[i];
+
+        std::wstring displayPath = item.shotPath;
+        if (item.itemType == "manual_task")
+        {
+            // Extract task name from path: jobPath/__task_TaskName
+            size_t taskMarkerPos = item.shotPath.find(L"/__task_");
+            if (taskMarkerPos != std::wstring::npos)
+            {
+                displayPath = item.shotPath.substr(taskMarkerPos + 8);  // Skip "/__task_"
+            }
+        }
+        else
+        {
+            // Remove job path prefix
+            if (displayPath.find(m_jobPath) == 0)
+            {
+                displayPath = displayPath.substr(m_jobPath.length());
+                if (!displayPath.empty() && displayPath[0] == L'\\' || displayPath[0] == L'/')
+                    displayPath = displayPath.substr(1);
+            }
+        }
+        labels.path = UFB::WideToUtf8(displayPath);
+
+        labels.dueDate = item.dueDate;
+        labels.dueDateText = (item.dueDate > 0) ? FormatDate(item.dueDate) : "Not Set";
+        labels.modifiedTime = item.modifiedTime;
+        labels.modifiedText = (item.modifiedTime > 0) ? FormatDate(item.modifiedTime) : "-";
+
+        auto usageIt = m_itemUsage.find(item.shotPath);
+        labels.sizeText = (usageIt != m_itemUsage.end()) ? FormatFileSize(usageIt->second.totalSize) : "-";
+    }
+}
+
+bool ProjectTrackerView::RefreshItemUsage()
+{
+    uint64_t version = storageAnalyzer->GetVersion();
+    if (version == m_itemUsageVersion)
+        return false;
+
+    // All tracked folders, so changing filters doesn't need another lookup
+    std::vector<std::wstring> itemPaths;
+    for (const auto* items : { &m_trackedShots, &m_trackedAssets, &m_trackedPostings })
+    {
+        for (const auto& item : *items)
+            itemPaths.push_back(item.shotPath);
+    }
+
+    m_itemUsage = storageAnalyzer->GetUsage(itemPaths);
+    m_itemUsageVersion = version;
+    return true;
 }
 
 void ProjectTrackerView::DrawUnifiedTable()
@@ -1008,14 +1101,26 @@ void ProjectTrackerView::DrawUnifiedTable()
         return;
     }
 
-    // Create table with 10 columns
+    // Size column: scan the job in the background (skipped when scanned recently) and pick up new results
+    if (storageAnalyzer)
+    {
+        storageAnalyzer->ScanJob(m_jobPath);
+        if (RefreshItemUsage())
+        {
+            if (m_allItemsSortColumn == 10)
+                SortItems(m_allItems, m_allItemsSortColumn, m_allItemsSortAscending);
+            RebuildItemLabels();
+        }
+    }
+
+    // Create table with 11 columns
     ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable |
                            ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
 
     // Push larger cell padding for taller rows (matching shot_view)
     ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(8.0f, 8.0f));
 
-    if (ImGui::BeginTable("##UnifiedTrackerTable", 10, flags))
+    if (ImGui::BeginTable("##UnifiedTrackerTable", 11, flags))
     {
         // Setup columns (widths matching shot_view)
         ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthFixed, 100.0f, 0);
@@ -1028,6 +1133,7 @@ void ProjectTrackerView::DrawUnifiedTable()
         ImGui::TableSetupColumn("Modified", ImGuiTableColumnFlags_WidthFixed, 80.0f, 7);
         ImGui::TableSetupColumn("Links", ImGuiTableColumnFlags_WidthFixed, 120.0f, 8);
         ImGui::TableSetupColumn("Notes", ImGuiTableColumnFlags_WidthFixed, 250.0f, 9);
+        ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 100.0f, 10);
         ImGui::TableSetupScrollFreeze(0, 1);
 
         // Handle sorting
@@ -1038,6 +1144,7 @@ void ProjectTrackerView::DrawUnifiedTable()
                 m_allItemsSortColumn = sortsSpecs->Specs[0].ColumnIndex;
                 m_allItemsSortAscending = (sortsSpecs->Specs[0].SortDirection == ImGuiSortDirection_Ascending);
                 SortItems(m_allItems, m_allItemsSortColumn, m_allItemsSortAscending);
+                RebuildItemLabels();
                 sortsSpecs->SpecsDirty = false;
             }
         }
@@ -1052,105 +1159,62 @@ void ProjectTrackerView::DrawUnifiedTable()
         }
 
         // Draw rows
-        for (int i = 0; i < static_cast<int>(m_allItems.size()); ++i)
-        {
-            auto& item = m_allItems[i];
-
-            // Set minimum row height (matching shot_view)
-            ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
+        // Labels normally follow m_allItems already (rebuilt with the list and after sorting)
+        if (m_allItemsLabels.size() != m_allItems.size())
+            RebuildItemLabels();
 
-            ImGui::PushID(i);
+        // Only the visible rows are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_allItems.size()));
 
-            // Column 0: Type (with color badge)
-            ImGui::TableSetColumnIndex(0);
-            ImVec4 typeColor = GetTypeColor(item.itemType);
-            ImGui::PushStyleColor(ImGuiCol_Text, typeColor);
-
-            std::string typeLabel = "Unknown";
-            if (item.itemType == "shot") typeLabel = "Shot";
-            else if (item.itemType == "asset") typeLabel = "Asset";
-            else if (item.itemType == "posting") typeLabel = "Posting";
-            else if (item.itemType == "manual_task") typeLabel = "Task";
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+            {
+                auto& item = m_allItems[i];
+                ItemLabels& labels = m_allItemsLabels[i];
 
-            ImGui::TextUnformatted(typeLabel.c_str());
-            ImGui::PopStyleColor();
+                // Set minimum row height (matching shot_view)
+                ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
 
-            // Column 1: Path
-            ImGui::TableSetColumnIndex(1);
+                ImGui::PushID(i);
 
-            std::wstring displayPath = item.shotPath;
-            if (item.itemType == "manual_task")
-            {
-                // Extract task name from path: jobPath/__task_TaskName
-                size_t taskMarkerPos = item.shotPath.find(L"/__task_");
-                if (taskMarkerPos != std::wstring::npos)
-                {
-                    displayPath = item.shotPath.substr(taskMarkerPos + 8);  // Skip "/__task_"
-                }
-            }
-            else
-            {
-                // Remove job path prefix
-                if (displayPath.find(m_jobPath) == 0)
-                {
-                    displayPath = displayPath.substr(m_jobPath.length());
-                    if (!displayPath.empty() && displayPath[0] == L'\\' || displayPath[0] == L'/')
-                        displayPath = displayPath.substr(1);
-                }
-            }
+                // Column 0: Type (with color badge)
+                ImGui::TableSetColumnIndex(0);
+                ImVec4 typeColor = GetTypeColor(item.itemType);
+                ImGui::PushStyleColor(ImGuiCol_Text, typeColor);
 
-            char pathUtf8[4096];
-            WideCharToMultiByte(CP_UTF8, 0, displayPath.c_str(), -1, pathUtf8, sizeof(pathUtf8), nullptr, nullptr);
+                std::string typeLabel = "Unknown";
+                if (item.itemType == "shot") typeLabel = "Shot";
+                else if (item.itemType == "asset") typeLabel = "Asset";
+                else if (item.itemType == "posting") typeLabel = "Posting";
+                else if (item.itemType == "manual_task") typeLabel = "Task";
 
-            bool isSelected = (i == m_selectedItemIndex);
+                ImGui::TextUnformatted(typeLabel.c_str());
+                ImGui::PopStyleColor();
 
-            // Use accent color for selected items (matching shot_view)
-            ImVec4 accentColor = GetWindowsAccentColor();
-            accentColor.w = 0.3f;  // Set transparency
-            if (isSelected)
-            {
-                ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
-                ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
-                ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
-            }
+                // Column 1: Path
+                ImGui::TableSetColumnIndex(1);
 
-            // Use explicit height to match row height (35.0f)
-            if (ImGui::Selectable(pathUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
-            {
-                m_selectedItemIndex = i;
+                bool isSelected = (i == m_selectedItemIndex);
 
-                // Double-click to open
-                if (ImGui::IsMouseDoubleClicked(0))
+                // Use accent color for selected items (matching shot_view)
+                ImVec4 accentColor = GetWindowsAccentColor();
+                accentColor.w = 0.3f;  // Set transparency
+                if (isSelected)
                 {
-                    if (item.itemType == "shot" && onOpenShot)
-                        onOpenShot(item.shotPath);
-                    else if (item.itemType == "asset" && onOpenAsset)
-                        onOpenAsset(item.shotPath);
-                    else if (item.itemType == "posting" && onOpenPosting)
-                        onOpenPosting(item.shotPath);
+                    ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
+                    ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
+                    ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
                 }
 
-                // Middle-click to open in new window
-                if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
+                // Use explicit height to match row height (35.0f)
+                if (ImGui::Selectable(labels.path.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
                 {
-                    if (item.itemType != "manual_task" && onOpenInNewWindow)
-                    {
-                        onOpenInNewWindow(item.shotPath);
-                    }
-                }
-            }
-
-            if (isSelected)
-            {
-                ImGui::PopStyleColor(3);  // Pop Header, HeaderHovered, HeaderActive
-            }
+                    m_selectedItemIndex = i;
 
-            // Context menu
-            if (ImGui::BeginPopupContextItem())
-            {
-                if (item.itemType != "manual_task")
-                {
-                    if (ImGui::MenuItem("Open in Project View"))
+                    // Double-click to open
+                    if (ImGui::IsMouseDoubleClicked(0))
                     {
                         if (item.itemType == "shot" && onOpenShot)
                             onOpenShot(item.shotPath);
@@ -1160,158 +1224,230 @@ void ProjectTrackerView::DrawUnifiedTable()
                             onOpenPosting(item.shotPath);
                     }
 
-                    ImGui::Separator();
-
-                    // Reveal in Explorer
-                    if (ImGui::MenuItem("Reveal in Explorer"))
+                    // Middle-click to open in new window
+                    if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
                     {
-                        std::wstring command = L"/select,\"" + item.shotPath + L"\"";
-                        ShellExecuteW(nullptr, L"open", L"explorer.exe", command.c_str(), nullptr, SW_SHOW);
+                        if (item.itemType != "manual_task" && onOpenInNewWindow)
+                        {
+                            onOpenInNewWindow(item.shotPath);
+                        }
                     }
+                }
+
+                if (isSelected)
+                {
+                    ImGui::PopStyleColor(3);  // Pop Header, HeaderHovered, HeaderActive
+                }
 
-                    // Open in New Window
-                    if (onOpenInNewWindow)
+                // Context menu
+                if (ImGui::BeginPopupContextItem())
+                {
+                    if (item.itemType != "manual_task")
                     {
-                        if (ImGui::MenuItem("Open in New Window"))
+                        if (ImGui::MenuItem("Open in Project View"))
                         {
-                            onOpenInNewWindow(item.shotPath);
+                            if (item.itemType == "shot" && onOpenShot)
+                                onOpenShot(item.shotPath);
+                            else if (item.itemType == "asset" && onOpenAsset)
+                                onOpenAsset(item.shotPath);
+                            else if (item.itemType == "posting" && onOpenPosting)
+                                onOpenPosting(item.shotPath);
+                        }
+
+                        ImGui::Separator();
+
+                        // Reveal in Explorer
+                        if (ImGui::MenuItem("Reveal in Explorer"))
+                        {
+                            std::wstring command = L"/select,\"" + item.shotPath + L"\"";
+                            ShellExecuteW(nullptr, L"open", L"explorer.exe", command.c_str(), nullptr, SW_SHOW);
+                        }
+
+                        // Open in New Window
+                        if (onOpenInNewWindow)
+                        {
+                            if (ImGui::MenuItem("Open in New Window"))
+                            {
+                                onOpenInNewWindow(item.shotPath);
+                            }
+                        }
+
+                        // Open in Browser 1 and Browser 2
+                        if (onOpenInBrowser1)
+                        {
+                            if (ImGui::MenuItem("Open in the Left Browser"))
+                            {
+                                onOpenInBrowser1(item.shotPath);
+                            }
+                        }
+
+                        if (onOpenInBrowser2)
+                        {
+                            if (ImGui::MenuItem("Open in the Right Browser"))
+                            {
+                                onOpenInBrowser2(item.shotPath);
+                            }
                         }
+
+                        ImGui::Separator();
                     }
 
-                    // Open in Browser 1 and Browser 2
-                    if (onOpenInBrowser1)
+                    if (ImGui::MenuItem("Un-track"))
                     {
-                        if (ImGui::MenuItem("Open in the Left Browser"))
+                        item.isTracked = false;
+                        item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()
+                        ).count();
+                        if (m_subscriptionManager)
                         {
-                            onOpenInBrowser1(item.shotPath);
+                            m_subscriptionManager->CreateOrUpdateShotMetadata(item);
                         }
+                        // Defer refresh until the table has ended (can't update m_allItems while rendering)
+                        m_needsRefresh = true;
                     }
 
-                    if (onOpenInBrowser2)
+                    if (item.itemType == "manual_task")
                     {
-                        if (ImGui::MenuItem("Open in the Right Browser"))
+                        if (ImGui::MenuItem("Delete Task"))
                         {
-                            onOpenInBrowser2(item.shotPath);
+                            if (m_subscriptionManager)
+                            {
+                                m_subscriptionManager->DeleteManualTask(item.id);
+                            }
+                            m_needsRefresh = true;
                         }
                     }
 
-                    ImGui::Separator();
+                    ImGui::EndPopup();
                 }
 
-                if (ImGui::MenuItem("Un-track"))
+                // Push mono font for all metadata columns
+                if (font_mono)
+                    ImGui::PushFont(font_mono);
+
+                // Column 2: Status
+                ImGui::TableSetColumnIndex(2);
+
+                std::string displayStatus = item.status.empty() ? "Not Set" : item.status;
+                ImVec4 statusColor = item.status.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetStatusColor(item.status, item.folderType);
+                ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
+
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##status" + std::to_string(i)).c_str(), displayStatus.c_str()))
                 {
-                    item.isTracked = false;
-                    item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::system_clock::now().time_since_epoch()
-                    ).count();
-                    if (m_subscriptionManager)
+                    // Options are only needed while the combo is open
+                    std::vector<UFB::StatusOption> statusOptions;
+                    if (m_projectConfig && m_projectConfig->IsLoaded() && !item.folderType.empty())
                     {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(item);
+                        statusOptions = m_projectConfig->GetStatusOptions(item.folderType);
                     }
-                    RefreshTrackedItems();
-                }
 
-                if (item.itemType == "manual_task")
-                {
-                    if (ImGui::MenuItem("Delete Task"))
+                    if (statusOptions.empty())
                     {
-                        if (m_subscriptionManager)
-                        {
-                            m_subscriptionManager->DeleteManualTask(item.id);
-                        }
-                        // Defer refresh to next frame (can't update m_allItems while rendering)
-                        m_needsRefresh = true;
+                        ImGui::TextDisabled("(No options configured)");
                     }
-                }
+                    else
+                    {
+                        for (const auto& statusOpt : statusOptions)
+                        {
+                            bool isSelected = (item.status == statusOpt.name);
+                            ImVec4 optionColor = GetStatusColor(statusOpt.name, item.folderType);
+                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
 
-                ImGui::EndPopup();
-            }
+                            if (ImGui::Selectable(statusOpt.name.c_str(), isSelected))
+                            {
+                                item.status = statusOpt.name;
+                                item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::system_clock::now().time_since_epoch()
+                                ).count();
+                                if (m_subscriptionManager)
+                                {
+                                    m_subscriptionManager->CreateOrUpdateShotMetadata(item);
+                                }
+                            }
 
-            // Push mono font for all metadata columns
-            if (font_mono)
-                ImGui::PushFont(font_mono);
+                            ImGui::PopStyleColor();
 
-            // Column 2: Status
-            ImGui::TableSetColumnIndex(2);
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+                ImGui::PopStyleColor();
 
-            std::vector<UFB::StatusOption> statusOptions;
-            if (m_projectConfig && m_projectConfig->IsLoaded() && !item.folderType.empty())
-            {
-                statusOptions = m_projectConfig->GetStatusOptions(item.folderType);
-            }
+                // Column 3: Category
+                ImGui::TableSetColumnIndex(3);
 
-            std::string displayStatus = item.status.empty() ? "Not Set" : item.status;
-            ImVec4 statusColor = item.status.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetStatusColor(item.status, item.folderType);
-            ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
+                std::string displayCategory = item.category.empty() ? "Not Set" : item.category;
+                ImVec4 categoryColor = item.category.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetCategoryColor(item.category, item.folderType);
+                ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##status" + std::to_string(i)).c_str(), displayStatus.c_str()))
-            {
-                if (statusOptions.empty())
-                {
-                    ImGui::TextDisabled("(No options configured)");
-                }
-                else
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##category" + std::to_string(i)).c_str(), displayCategory.c_str()))
                 {
-                    for (const auto& statusOpt : statusOptions)
+                    // Options are only needed while the combo is open
+                    std::vector<UFB::CategoryOption> categoryOptions;
+                    if (m_projectConfig && m_projectConfig->IsLoaded() && !item.folderType.empty())
                     {
-                        bool isSelected = (item.status == statusOpt.name);
-                        ImVec4 optionColor = GetStatusColor(statusOpt.name, item.folderType);
-                        ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+                        categoryOptions = m_projectConfig->GetCategoryOptions(item.folderType);
+                    }
 
-                        if (ImGui::Selectable(statusOpt.name.c_str(), isSelected))
+                    if (categoryOptions.empty())
+                    {
+                        ImGui::TextDisabled("(No options configured)");
+                    }
+                    else
+                    {
+                        for (const auto& catOpt : categoryOptions)
                         {
-                            item.status = statusOpt.name;
-                            item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                std::chrono::system_clock::now().time_since_epoch()
-                            ).count();
-                            if (m_subscriptionManager)
+                            bool isSelected = (item.category == catOpt.name);
+                            ImVec4 optionColor = GetCategoryColor(catOpt.name, item.folderType);
+                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
+
+                            if (ImGui::Selectable(catOpt.name.c_str(), isSelected))
                             {
-                                m_subscriptionManager->CreateOrUpdateShotMetadata(item);
+                                item.category = catOpt.name;
+                                item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::system_clock::now().time_since_epoch()
+                                ).count();
+                                if (m_subscriptionManager)
+                                {
+                                    m_subscriptionManager->CreateOrUpdateShotMetadata(item);
+                                }
                             }
-                        }
 
-                        ImGui::PopStyleColor();
+                            ImGui::PopStyleColor();
 
-                        if (isSelected)
-                            ImGui::SetItemDefaultFocus();
+                            if (isSelected)
+                                ImGui::SetItemDefaultFocus();
+                        }
                     }
+                    ImGui::EndCombo();
                 }
-                ImGui::EndCombo();
-            }
-            ImGui::PopStyleColor();
+                ImGui::PopStyleColor();
 
-            // Column 3: Category
-            ImGui::TableSetColumnIndex(3);
+                // Column 4: Priority
+                ImGui::TableSetColumnIndex(4);
 
-            std::vector<UFB::CategoryOption> categoryOptions;
-            if (m_projectConfig && m_projectConfig->IsLoaded() && !item.folderType.empty())
-            {
-                categoryOptions = m_projectConfig->GetCategoryOptions(item.folderType);
-            }
+                const char* priorityLabels[] = { "High", "Medium", "Low" };
+                const int priorityValues[] = { 1, 2, 3 };
 
-            std::string displayCategory = item.category.empty() ? "Not Set" : item.category;
-            ImVec4 categoryColor = item.category.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetCategoryColor(item.category, item.folderType);
-            ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
+                ImVec4 priorityColor = GetPriorityColor(item.priority);
+                ImGui::PushStyleColor(ImGuiCol_Text, priorityColor);
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##category" + std::to_string(i)).c_str(), displayCategory.c_str()))
-            {
-                if (categoryOptions.empty())
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##priority" + std::to_string(i)).c_str(), GetPriorityLabel(item.priority)))
                 {
-                    ImGui::TextDisabled("(No options configured)");
-                }
-                else
-                {
-                    for (const auto& catOpt : categoryOptions)
+                    for (int p = 0; p < 3; p++)
                     {
-                        bool isSelected = (item.category == catOpt.name);
-                        ImVec4 optionColor = GetCategoryColor(catOpt.name, item.folderType);
+                        bool isSelected = (item.priority == priorityValues[p]);
+                        ImVec4 optionColor = GetPriorityColor(priorityValues[p]);
                         ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
 
-                        if (ImGui::Selectable(catOpt.name.c_str(), isSelected))
+                        if (ImGui::Selectable(priorityLabels[p], isSelected))
                         {
-                            item.category = catOpt.name;
+                            item.priority = priorityValues[p];
                             item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
                                 std::chrono::system_clock::now().time_since_epoch()
                             ).count();
@@ -1326,32 +1462,20 @@ void ProjectTrackerView::DrawUnifiedTable()
                         if (isSelected)
                             ImGui::SetItemDefaultFocus();
                     }
+                    ImGui::EndCombo();
                 }
-                ImGui::EndCombo();
-            }
-            ImGui::PopStyleColor();
-
-            // Column 4: Priority
-            ImGui::TableSetColumnIndex(4);
-
-            const char* priorityLabels[] = { "High", "Medium", "Low" };
-            const int priorityValues[] = { 1, 2, 3 };
+                ImGui::PopStyleColor();
 
-            ImVec4 priorityColor = GetPriorityColor(item.priority);
-            ImGui::PushStyleColor(ImGuiCol_Text, priorityColor);
+                // Column 5: Artist
+                ImGui::TableSetColumnIndex(5);
 
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##priority" + std::to_string(i)).c_str(), GetPriorityLabel(item.priority)))
-            {
-                for (int p = 0; p < 3; p++)
+                std::string displayArtist = item.artist.empty() ? "Not Set" : item.artist;
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::BeginCombo(("##artist" + std::to_string(i)).c_str(), displayArtist.c_str()))
                 {
-                    bool isSelected = (item.priority == priorityValues[p]);
-                    ImVec4 optionColor = GetPriorityColor(priorityValues[p]);
-                    ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
-
-                    if (ImGui::Selectable(priorityLabels[p], isSelected))
+                    if (ImGui::Selectable("-", item.artist.empty()))
                     {
-                        item.priority = priorityValues[p];
+                        item.artist = "";
                         item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
                             std::chrono::system_clock::now().time_since_epoch()
                         ).count();
@@ -1361,191 +1485,186 @@ void ProjectTrackerView::DrawUnifiedTable()
                         }
                     }
 
-                    ImGui::PopStyleColor();
-
-                    if (isSelected)
-                        ImGui::SetItemDefaultFocus();
+                    for (const auto& user : users)
+                    {
+                        bool isSelected = (item.artist == user.displayName);
+                        if (ImGui::Selectable(user.displayName.c_str(), isSelected))
+                        {
+                            item.artist = user.displayName;
+                            item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::system_clock::now().time_since_epoch()
+                            ).count();
+                            if (m_subscriptionManager)
+                            {
+                                m_subscriptionManager->CreateOrUpdateShotMetadata(item);
+                            }
+                        }
+                    }
+                    ImGui::EndCombo();
                 }
-                ImGui::EndCombo();
-            }
-            ImGui::PopStyleColor();
 
-            // Column 5: Artist
-            ImGui::TableSetColumnIndex(5);
+                // Column 6: Due Date (clickable button like shot_view)
+                ImGui::TableSetColumnIndex(6);
 
-            std::string displayArtist = item.artist.empty() ? "Not Set" : item.artist;
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::BeginCombo(("##artist" + std::to_string(i)).c_str(), displayArtist.c_str()))
-            {
-                if (ImGui::Selectable("-", item.artist.empty()))
+                // Re-formatted only when the date was edited since the labels were made
+                if (labels.dueDate != item.dueDate)
                 {
-                    item.artist = "";
-                    item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::system_clock::now().time_since_epoch()
-                    ).count();
-                    if (m_subscriptionManager)
-                    {
-                        m_subscriptionManager->CreateOrUpdateShotMetadata(item);
-                    }
+                    labels.dueDate = item.dueDate;
+                    labels.dueDateText = (item.dueDate > 0) ? FormatDate(item.dueDate) : "Not Set";
+                }
+                const std::string& dueDateStr = labels.dueDateText;
+                ImGui::SetNextItemWidth(-FLT_MIN);
+                if (ImGui::Button((dueDateStr + "##duedate" + std::to_string(i)).c_str(), ImVec2(-FLT_MIN, 0)))
+                {
+                    m_showAllItemsDatePicker = true;
+                    m_allItemsDatePickerIndex = i;
                 }
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("Click to select date");
+
+                // Column 7: Modified Date (read-only, disabled text color)
+                ImGui::TableSetColumnIndex(7);
 
-                for (const auto& user : users)
+                if (labels.modifiedTime != item.modifiedTime)
                 {
-                    bool isSelected = (item.artist == user.displayName);
-                    if (ImGui::Selectable(user.displayName.c_str(), isSelected))
-                    {
-                        item.artist = user.displayName;
-                        item.modifiedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-                            std::chrono::system_clock::now().time_since_epoch()
-                        ).count();
-                        if (m_subscriptionManager)
-                        {
-                            m_subscriptionManager->CreateOrUpdateShotMetadata(item);
-                        }
-                    }
+                    labels.modifiedTime = item.modifiedTime;
+                    labels.modifiedText = (item.modifiedTime > 0) ? FormatDate(item.modifiedTime) : "-";
                 }
-                ImGui::EndCombo();
-            }
+                const std::string& modifiedDateStr = labels.modifiedText;
+                ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+                ImGui::TextUnformatted(modifiedDateStr.c_str());
+                ImGui::PopStyleColor();
 
-            // Column 6: Due Date (clickable button like shot_view)
-            ImGui::TableSetColumnIndex(6);
+                // Column 8: Links (clickable, similar to notes)
+                ImGui::TableSetColumnIndex(8);
 
-            std::string dueDateStr = (item.dueDate > 0) ? FormatDate(item.dueDate) : "Not Set";
-            ImGui::SetNextItemWidth(-FLT_MIN);
-            if (ImGui::Button((dueDateStr + "##duedate" + std::to_string(i)).c_str(), ImVec2(-FLT_MIN, 0)))
-            {
-                m_showAllItemsDatePicker = true;
-                m_allItemsDatePickerIndex = i;
-            }
-            if (ImGui::IsItemHovered())
-                ImGui::SetTooltip("Click to select date");
+                // Pop mono font before Links/Notes columns
+                if (font_mono)
+                    ImGui::PopFont();
 
-            // Column 7: Modified Date (read-only, disabled text color)
-            ImGui::TableSetColumnIndex(7);
+                // Check if link exists (links field is a string, not empty means we have a link)
+                bool hasLink = !item.links.empty();
 
-            std::string modifiedDateStr = (item.modifiedTime > 0) ? FormatDate(item.modifiedTime) : "-";
-            ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
-            ImGui::TextUnformatted(modifiedDateStr.c_str());
-            ImGui::PopStyleColor();
+                if (hasLink)
+                {
+                    // 50/50 split for Edit and Link buttons (120px column / 2 = ~55px each with spacing)
+                    float buttonWidth = 55.0f;
 
-            // Column 8: Links (clickable, similar to notes)
-            ImGui::TableSetColumnIndex(8);
+                    // Show "Edit" button (left side)
+                    if (ImGui::Button(("Edit##linkedit" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                    {
+                        m_showLinkEditor = true;
+                        m_linkEditorItemIndex = i;
+                        m_linkEditorItemList = &m_allItems;
+                        strncpy_s(m_linkEditorBuffer, item.links.c_str(), sizeof(m_linkEditorBuffer) - 1);
+                        m_linkEditorBuffer[sizeof(m_linkEditorBuffer) - 1] = '\0';
+                    }
 
-            // Pop mono font before Links/Notes columns
-            if (font_mono)
-                ImGui::PopFont();
+                    ImGui::SameLine();
 
-            // Check if link exists (links field is a string, not empty means we have a link)
-            bool hasLink = !item.links.empty();
+                    // Show "Link" button in accent color (right side)
+                    ImVec4 accentColor = GetWindowsAccentColor();
+                    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));  // Transparent background
+                    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.2f));
+                    ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.3f));
+                    ImGui::PushStyleColor(ImGuiCol_Text, accentColor);
 
-            if (hasLink)
-            {
-                // 50/50 split for Edit and Link buttons (120px column / 2 = ~55px each with spacing)
-                float buttonWidth = 55.0f;
+                    if (ImGui::Button(("Link##linkopen" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                    {
+                        // Open link in default browser
+                        std::wstring wideLink(item.links.begin(), item.links.end());
+                        ShellExecuteW(nullptr, L"open", wideLink.c_str(), nullptr, nullptr, SW_SHOW);
+                    }
 
-                // Show "Edit" button (left side)
-                if (ImGui::Button(("Edit##linkedit" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                    ImGui::PopStyleColor(4);
+
+                    if (ImGui::IsItemHovered())
+                    {
+                        ImGui::BeginTooltip();
+                        ImGui::Text("Click to open: %s", item.links.c_str());
+                        ImGui::EndTooltip();
+                    }
+                }
+                else
                 {
-                    m_showLinkEditor = true;
-                    m_linkEditorItemIndex = i;
-                    m_linkEditorItemList = &m_allItems;
-                    strncpy_s(m_linkEditorBuffer, item.links.c_str(), sizeof(m_linkEditorBuffer) - 1);
-                    m_linkEditorBuffer[sizeof(m_linkEditorBuffer) - 1] = '\0';
+                    // Show "(click to add link)" in disabled color
+                    ImVec4 textColor = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+                    ImGui::PushStyleColor(ImGuiCol_Text, textColor);
+
+                    if (ImGui::Selectable(("(click to add link)##linkadd" + std::to_string(i)).c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
+                    {
+                        m_showLinkEditor = true;
+                        m_linkEditorItemIndex = i;
+                        m_linkEditorItemList = &m_allItems;
+                        m_linkEditorBuffer[0] = '\0';
+                    }
+
+                    ImGui::PopStyleColor();
                 }
 
-                ImGui::SameLine();
+                // Column 9: Notes (clickable text with tooltip)
+                ImGui::TableSetColumnIndex(9);
 
-                // Show "Link" button in accent color (right side)
-                ImVec4 accentColor = GetWindowsAccentColor();
-                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));  // Transparent background
-                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.2f));
-                ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(accentColor.x, accentColor.y, accentColor.z, 0.3f));
-                ImGui::PushStyleColor(ImGuiCol_Text, accentColor);
+                // Create a one-line preview
+                std::string notePreview = item.note.empty() ? "(click to add note)" : item.note;
 
-                if (ImGui::Button(("Link##linkopen" + std::to_string(i)).c_str(), ImVec2(buttonWidth, 0)))
+                // Truncate to first line only
+                size_t newlinePos = notePreview.find('\n');
+                if (newlinePos != std::string::npos)
                 {
-                    // Open link in default browser
-                    std::wstring wideLink(item.links.begin(), item.links.end());
-                    ShellExecuteW(nullptr, L"open", wideLink.c_str(), nullptr, nullptr, SW_SHOW);
+                    notePreview = notePreview.substr(0, newlinePos) + "...";
                 }
 
-                ImGui::PopStyleColor(4);
-
-                if (ImGui::IsItemHovered())
+                // Truncate if too long (max 50 chars for preview)
+                if (notePreview.length() > 50)
                 {
-                    ImGui::BeginTooltip();
-                    ImGui::Text("Click to open: %s", item.links.c_str());
-                    ImGui::EndTooltip();
+                    notePreview = notePreview.substr(0, 47) + "...";
                 }
-            }
-            else
-            {
-                // Show "(click to add link)" in disabled color
-                ImVec4 textColor = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+
+                // Make it selectable to detect clicks, fill the full cell height
+                // Adjust height to account for cell padding (8.0f top + 8.0f bottom = 16.0f)
+                std::string selectableId = "##note_preview_" + std::to_string(i);
+                ImVec4 textColor = item.note.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
                 ImGui::PushStyleColor(ImGuiCol_Text, textColor);
 
-                if (ImGui::Selectable(("(click to add link)##linkadd" + std::to_string(i)).c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
+                // Disable frame padding for this Selectable to fill the cell properly
+                ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(4.0f, 0.0f));
+                if (ImGui::Selectable(notePreview.c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
                 {
-                    m_showLinkEditor = true;
-                    m_linkEditorItemIndex = i;
-                    m_linkEditorItemList = &m_allItems;
-                    m_linkEditorBuffer[0] = '\0';
+                    // Open note editor modal
+                    m_showNoteEditor = true;
+                    m_noteEditorItemIndex = i;
+                    m_noteEditorItemList = &m_allItems;
+                    strncpy_s(m_noteEditorBuffer, item.note.c_str(), sizeof(m_noteEditorBuffer) - 1);
+                    m_noteEditorBuffer[sizeof(m_noteEditorBuffer) - 1] = '\0';
                 }
+                ImGui::PopStyleVar();
 
                 ImGui::PopStyleColor();
-            }
-
-            // Column 9: Notes (clickable text with tooltip)
-            ImGui::TableSetColumnIndex(9);
-
-            // Create a one-line preview
-            std::string notePreview = item.note.empty() ? "(click to add note)" : item.note;
 
-            // Truncate to first line only
-            size_t newlinePos = notePreview.find('\n');
-            if (newlinePos != std::string::npos)
-            {
-                notePreview = notePreview.substr(0, newlinePos) + "...";
-            }
-
-            // Truncate if too long (max 50 chars for preview)
-            if (notePreview.length() > 50)
-            {
-                notePreview = notePreview.substr(0, 47) + "...";
-            }
-
-            // Make it selectable to detect clicks, fill the full cell height
-            // Adjust height to account for cell padding (8.0f top + 8.0f bottom = 16.0f)
-            std::string selectableId = "##note_preview_" + std::to_string(i);
-            ImVec4 textColor = item.note.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
-            ImGui::PushStyleColor(ImGuiCol_Text, textColor);
-
-            // Disable frame padding for this Selectable to fill the cell properly
-            ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(4.0f, 0.0f));
-            if (ImGui::Selectable(notePreview.c_str(), false, ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 0)))
-            {
-                // Open note editor modal
-                m_showNoteEditor = true;
-                m_noteEditorItemIndex = i;
-                m_noteEditorItemList = &m_allItems;
-                strncpy_s(m_noteEditorBuffer, item.note.c_str(), sizeof(m_noteEditorBuffer) - 1);
-                m_noteEditorBuffer[sizeof(m_noteEditorBuffer) - 1] = '\0';
-            }
-            ImGui::PopStyleVar();
+                // Show full note on hover
+                if (ImGui::IsItemHovered() && !item.note.empty())
+                {
+                    ImGui::BeginTooltip();
+                    ImGui::PushTextWrapPos(400.0f);
+                    ImGui::TextUnformatted(item.note.c_str());
+                    ImGui::PopTextWrapPos();
+                    ImGui::EndTooltip();
+                }
 
-            ImGui::PopStyleColor();
+                // Column 10: Size (everything below the item folder)
+                ImGui::TableSetColumnIndex(10);
+                ImGui::TextDisabled("%s", labels.sizeText.c_str());
+                auto usageIt = m_itemUsage.find(item.shotPath);
+                if (usageIt != m_itemUsage.end() && ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("%llu files in %llu folders",
+                                      static_cast<unsigned long long>(usageIt->second.totalFiles),
+                                      static_cast<unsigned long long>(usageIt->second.totalFolders + 1));
+                }
 
-            // Show full note on hover
-            if (ImGui::IsItemHovered() && !item.note.empty())
-            {
-                ImGui::BeginTooltip();
-                ImGui::PushTextWrapPos(400.0f);
-                ImGui::TextUnformatted(item.note.c_str());
-                ImGui::PopTextWrapPos();
-                ImGui::EndTooltip();
+                ImGui::PopID();
             }
-
-            ImGui::PopID();
         }
 
         ImGui::EndTable();
@@ -1556,4 +1675,11 @@ void ProjectTrackerView::DrawUnifiedTable()
 
     // Clear rendering flag
     m_isRendering = false;
+
+    // Un-track/Delete from a row's context menu: reload now that the table has ended
+    if (m_needsRefresh)
+    {
+        m_needsRefresh = false;
+        RefreshTrackedItems();
+    }
 }
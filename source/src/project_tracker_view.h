@@ -7,6 +7,7 @@
 #include <map>
 #include <functional>
 #include "imgui.h"
+#include "storage_analyzer.h"
 
 // Forward declarations
 namespace UFB {
@@ -56,6 +57,9 @@ public:
     // Window open state
     bool IsOpen() const { return m_isOpen; }
 
+    // Folder sizes for the Size column (set by main)
+    static UFB::StorageAnalyzer* storageAnalyzer;
+
 private:
     // Window state
     bool m_isOpen = true;
@@ -83,6 +87,23 @@ private:
     int m_allItemsSortColumn = -1;
     bool m_allItemsSortAscending = true;
 
+    // Display strings for m_allItems rows (same order), rebuilt with the list and after sorting
+    // Dates remember the timestamp they were formatted from, so in-place edits re-format just that cell
+    struct ItemLabels
+    {
+        std::string path;           // UTF-8 path relative to the job (task name for manual tasks)
+        uint64_t dueDate = 0;
+        std::string dueDateText;
+        uint64_t modifiedTime = 0;
+        std::string modifiedText;
+        std::string sizeText;       // Disk usage of the item folder ("-" when not scanned)
+    };
+    std::vector<ItemLabels> m_allItemsLabels;
+
+    // Disk usage of tracked item folders (Size column), re-read when the analyzer has new results
+    std::map<std::wstring, UFB::FolderUsage> m_itemUsage;
+    uint64_t m_itemUsageVersion = UINT64_MAX;      // StorageAnalyzer version of m_itemUsage (MAX: stale)
+
     // Filter state
     std::set<std::string> m_filterTypes;        // Selected types: "shot", "asset", "posting", "manual_task"
     std::set<std::string> m_filterArtists;      // Selected artist names
@@ -119,6 +140,8 @@ private:
     void ReloadTrackedItems();  // Reload tracked items (called by observer)
     void DrawUnifiedTable();  // Draw single unified table with all items
     void UpdateUnifiedItemsList();  // Combine and filter all items into m_allItems
+    void RebuildItemLabels();  // Format display strings for m_allItems
+    bool RefreshItemUsage();  // Re-read m_itemUsage if the analyzer has new results (true if it changed)
     bool PassesFilters(const UFB::ShotMetadata& item);  // Check if item passes all active filters
     void CollectAvailableFilterValues();  // Collect unique values from all items
     void SortItems(std::vector<UFB::ShotMetadata>& items, int column, bool ascending);
@@ -0,0 +1,53 @@
+#include "pushed_entries.h"
+#include <algorithm>
+
+namespace UFB {
+
+bool PushedEntryTracker::Accept(const P2PChangeBatch& batch, PushedEntries& outEntries)
+{
+    outEntries = PushedEntries();
+    if (!batch.entries.is_array())
+        return false;
+
+    // Device IDs are ASCII (as in P2P messages)
+    const std::string deviceId(batch.deviceId.begin(), batch.deviceId.end());
+    uint64_t oldestTimestamp = UINT64_MAX;
+
+    for (const auto& entry : batch.entries)
+    {
+        if (!entry.is_object())
+            continue;
+
+        uint64_t timestamp = entry.value("timestamp", 0ULL);
+        if (entry.value("deviceId", "") != deviceId || timestamp == 0 || entry.value("shotPath", "").empty())
+            continue;
+
+        outEntries.newestTimestamp = (std::max)(outEntries.newestTimestamp, timestamp);
+        oldestTimestamp = (std::min)(oldestTimestamp, timestamp);
+
+        if (entry.value("operation", "") == "update")
+            outEntries.updates.push_back(entry);
+        else
+            outEntries.hasDeletes = true;
+    }
+
+    if (outEntries.newestTimestamp == 0)
+        return false;
+    outEntries.oldestTimestamp = oldestTimestamp;
+
+    uint64_t lastApplied = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t& applied = m_appliedTimes[{ batch.jobPath, batch.deviceId }];
+        lastApplied = applied;
+        applied = (std::max)(applied, outEntries.newestTimestamp);
+    }
+
+    // The first batch from a sender has nothing to compare against
+    if (lastApplied > 0 && batch.previousTimestamp > lastApplied)
+        outEntries.missingSince = lastApplied;
+
+    return true;
+}
+
+} // namespace UFB
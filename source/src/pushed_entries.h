@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+#include "nlohmann/json.hpp"
+#include "p2p_manager.h"
+
+namespace UFB {
+
+// Change log entries a peer pushed (CHANGE_NOTIFY, SYNC_RESPONSE), sorted out for SyncManager
+struct PushedEntries
+{
+    std::vector<nlohmann::json> updates;    // The sender's "update" entries, oldest first
+    bool hasDeletes = false;                // Deletions are materialized from the change logs (share path)
+    uint64_t oldestTimestamp = 0;
+    uint64_t newestTimestamp = 0;
+    uint64_t missingSince = 0;              // Non-zero: entries the sender pushed after this never arrived; request them
+};
+
+// Newest pushed entry applied per job and sender
+//
+// Peers push only their own entries, each batch carrying the timestamp of the entry pushed before it;
+// one newer than what was applied here means a CHANGE_NOTIFY was lost (dropped connection, peer
+// restarted) and the gap has to be asked for with SYNC_REQUEST
+class PushedEntryTracker
+{
+public:
+    // Sort a pushed batch (not currentState) and record its entries as applied
+    // @return false if it holds no usable entry made by the sender
+    bool Accept(const P2PChangeBatch& batch, PushedEntries& outEntries);
+
+private:
+    std::map<std::pair<std::wstring, std::wstring>, uint64_t> m_appliedTimes;    // (jobPath, deviceId) -> newest applied
+    std::mutex m_mutex;
+};
+
+} // namespace UFB
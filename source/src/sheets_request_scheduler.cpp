@@ -0,0 +1,332 @@
+#include "sheets_request_scheduler.h"
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace UFB {
+
+namespace {
+
+// Share of the quota that may go out at once; the rest is paced, so burst plus a minute of
+// refill stays within the per-minute quota
+constexpr double kBurstFraction = 0.1;
+
+constexpr int kBaseBackoffMs = 1000;
+constexpr int kMaxJitterMs = 1000;
+
+class SteadySchedulerClock : public SchedulerClock
+{
+public:
+    TimePoint Now() override
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    void WaitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TimePoint deadline) override
+    {
+        cv.wait_until(lock, deadline);
+    }
+};
+
+} // namespace
+
+SchedulerClock& SchedulerClock::Steady()
+{
+    static SteadySchedulerClock clock;
+    return clock;
+}
+
+TokenBucket::TokenBucket(int requestsPerMinute, SchedulerClock& clock)
+    : m_clock(clock)
+{
+    double perMinute = (std::max)(1, requestsPerMinute);
+    m_capacity = (std::max)(1.0, perMinute * kBurstFraction);
+    m_tokensPerSecond = (perMinute - m_capacity) / 60.0;
+    if (m_tokensPerSecond <= 0.0)
+    {
+        m_tokensPerSecond = perMinute / 60.0;
+        m_capacity = 1.0;
+    }
+    m_tokens = m_capacity;
+    m_lastRefill = m_clock.Now();
+    m_blockedUntil = m_lastRefill;
+}
+
+void TokenBucket::RefillLocked(SchedulerClock::TimePoint now)
+{
+    double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+    m_tokens = (std::min)(m_capacity, m_tokens + elapsed * m_tokensPerSecond);
+    m_lastRefill = now;
+}
+
+bool TokenBucket::Acquire()
+{
+    auto start = m_clock.Now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_cancelled)
+    {
+        auto now = m_clock.Now();
+        if (now < m_blockedUntil)
+        {
+            m_clock.WaitUntil(m_cv, lock, m_blockedUntil);
+            continue;
+        }
+
+        RefillLocked(now);
+        if (m_tokens >= 1.0)
+        {
+            m_tokens -= 1.0;
+            m_waitedMs += std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+            return true;
+        }
+
+        auto untilToken = std::chrono::duration<double>((1.0 - m_tokens) / m_tokensPerSecond);
+        m_clock.WaitUntil(m_cv, lock, now + std::chrono::duration_cast<std::chrono::milliseconds>(untilToken) + std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+void TokenBucket::Throttle(std::chrono::milliseconds delay)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto until = m_clock.Now() + delay;
+    if (until > m_blockedUntil)
+    {
+        m_blockedUntil = until;
+        m_tokens = 0.0;     // The server's window is spent; start refilling from empty
+    }
+}
+
+void TokenBucket::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancelled = true;
+    }
+    m_cv.notify_all();
+}
+
+void TokenBucket::Resume()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cancelled = false;
+}
+
+SheetsRequestScheduler::SheetsRequestScheduler(const SheetsQuotaOptions& options, SchedulerClock& clock)
+    : m_options(options)
+    , m_clock(clock)
+    , m_readBucket(options.readRequestsPerMinute, clock)
+    , m_writeBucket(options.writeRequestsPerMinute, clock)
+{
+}
+
+TokenBucket* SheetsRequestScheduler::BucketFor(const HttpRequest& request)
+{
+    if (request.url.find("://sheets.googleapis.com/") == std::string::npos)
+    {
+        return nullptr;     // Drive and others: not under the Sheets quota
+    }
+    return request.method == "GET" ? &m_readBucket : &m_writeBucket;
+}
+
+bool SheetsRequestScheduler::IsRetryable(const HttpRequest& request, int statusCode)
+{
+    if (statusCode == 429)
+    {
+        return true;        // Rejected before it was acted on
+    }
+    if (statusCode != 500 && statusCode != 502 && statusCode != 503 && statusCode != 504)
+    {
+        return false;
+    }
+
+    // A POST that creates something (spreadsheet, folder, sheet, appended rows) may have gone
+    // through; value writes and clears land the same way twice
+    return request.method != "POST" ||
+           request.url.find("/values:batch") != std::string::npos ||
+           request.url.find(":clear") != std::string::npos;
+}
+
+std::chrono::milliseconds SheetsRequestScheduler::BackoffDelay(int attempt)
+{
+    // Truncated exponential backoff: min(2^n seconds + random jitter, maximum)
+    thread_local std::mt19937 random(std::random_device{}());
+    std::uniform_int_distribution<int> jitter(0, kMaxJitterMs);
+
+    int64_t delay = static_cast<int64_t>(kBaseBackoffMs) << (std::min)(attempt, 16);
+    delay = (std::min)(delay + jitter(random), static_cast<int64_t>(m_options.maxBackoffMs));
+    return std::chrono::milliseconds(delay);
+}
+
+bool SheetsRequestScheduler::WaitFor(std::chrono::milliseconds delay)
+{
+    auto deadline = m_clock.Now() + delay;
+    std::unique_lock<std::mutex> lock(m_cancelMutex);
+    while (!m_cancelled && m_clock.Now() < deadline)
+    {
+        m_clock.WaitUntil(m_cancelCV, lock, deadline);
+    }
+    return !m_cancelled;
+}
+
+bool SheetsRequestScheduler::Execute(HttpClient& client, const HttpRequest& request, HttpResponse& outResponse)
+{
+    m_requests++;
+    TokenBucket* bucket = BucketFor(request);
+
+    for (int attempt = 0; ; attempt++)
+    {
+        if (bucket && !bucket->Acquire())
+        {
+            return false;
+        }
+
+        if (!client.Send(request, outResponse))
+        {
+            return false;
+        }
+
+        int status = outResponse.statusCode;
+        if (status == 429)
+            m_rateLimited++;
+        else if (status >= 500)
+            m_serverErrors++;
+
+        if (!IsRetryable(request, status))
+        {
+            return true;
+        }
+        if (attempt >= m_options.maxRetries)
+        {
+            std::cerr << "[SheetsScheduler] Giving up after " << attempt << " retries (HTTP " << status << ")" << std::endl;
+            return true;
+        }
+
+        std::chrono::milliseconds delay = BackoffDelay(attempt);
+        std::cout << "[SheetsScheduler] HTTP " << status << " - retry " << (attempt + 1) << "/" << m_options.maxRetries
+                  << " in " << delay.count() << " ms" << std::endl;
+        m_retries++;
+
+        if (status == 429 && bucket)
+        {
+            // Everyone on this quota waits it out, not just this request
+            bucket->Throttle(delay);
+        }
+        else if (!WaitFor(delay))
+        {
+            return false;
+        }
+    }
+}
+
+std::vector<bool> SheetsRequestScheduler::ExecuteBatch(HttpClient& client, const std::vector<HttpRequest>& requests,
+                                                       std::vector<HttpResponse>& outResponses)
+{
+    // Batches are paced as a whole: one token each, taken up front
+    for (const auto& request : requests)
+    {
+        TokenBucket* bucket = BucketFor(request);
+        if (bucket && !bucket->Acquire())
+        {
+            outResponses.assign(requests.size(), HttpResponse());
+            return std::vector<bool>(requests.size(), false);
+        }
+    }
+
+    m_requests += requests.size();
+    std::vector<bool> results = client.SendBatch(requests, outResponses);
+
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        int status = outResponses[i].statusCode;
+        if (!results[i] || !IsRetryable(requests[i], status))
+        {
+            continue;
+        }
+
+        if (status == 429)
+            m_rateLimited++;
+        else
+            m_serverErrors++;
+        m_retries++;
+        m_requests--;   // Counted again by Execute
+
+        std::chrono::milliseconds delay = BackoffDelay(0);
+        TokenBucket* bucket = BucketFor(requests[i]);
+        if (status == 429 && bucket)
+        {
+            bucket->Throttle(delay);
+        }
+        else if (!WaitFor(delay))
+        {
+            results[i] = false;
+            continue;
+        }
+        results[i] = Execute(client, requests[i], outResponses[i]);
+    }
+    return results;
+}
+
+std::vector<bool> SheetsRequestScheduler::RunJobs(size_t count, const std::function<bool(size_t index)>& job)
+{
+    std::vector<char> results(count, 0);
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]()
+    {
+        for (size_t i = next++; i < count; i = next++)
+        {
+            results[i] = job(i) ? 1 : 0;
+        }
+    };
+
+    size_t workerCount = (std::min)(count, static_cast<size_t>((std::max)(1, m_options.maxConcurrentJobs)));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; i++)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+void SheetsRequestScheduler::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cancelMutex);
+        m_cancelled = true;
+    }
+    m_cancelCV.notify_all();
+    m_readBucket.Cancel();
+    m_writeBucket.Cancel();
+}
+
+void SheetsRequestScheduler::Resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cancelMutex);
+        m_cancelled = false;
+    }
+    m_readBucket.Resume();
+    m_writeBucket.Resume();
+}
+
+SheetsSchedulerStats SheetsRequestScheduler::GetStats() const
+{
+    SheetsSchedulerStats stats;
+    stats.requests = m_requests;
+    stats.rateLimited = m_rateLimited;
+    stats.serverErrors = m_serverErrors;
+    stats.retries = m_retries;
+    stats.quotaWaitMs = m_readBucket.GetWaitedMs() + m_writeBucket.GetWaitedMs();
+    return stats;
+}
+
+} // namespace UFB
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "http_client.h"
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace UFB {
+
+// Google's per-minute Sheets API quotas (per user per project by default) and how hard we push them
+struct SheetsQuotaOptions
+{
+    int readRequestsPerMinute = 60;
+    int writeRequestsPerMinute = 60;
+    int maxConcurrentJobs = 4;          // Jobs synced at once by RunJobs
+    int maxRetries = 5;                 // Per request, on HTTP 429 and 5xx
+    int maxBackoffMs = 32000;
+};
+
+struct SheetsSchedulerStats
+{
+    uint64_t requests = 0;
+    uint64_t rateLimited = 0;           // HTTP 429 responses
+    uint64_t serverErrors = 0;          // HTTP 5xx responses
+    uint64_t retries = 0;
+    uint64_t quotaWaitMs = 0;           // Time requests spent waiting for a token
+};
+
+// Time source for the token buckets and retry backoff; tests substitute a simulated clock
+class SchedulerClock
+{
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    virtual ~SchedulerClock() = default;
+
+    // steady_clock with real waits (shared instance)
+    static SchedulerClock& Steady();
+
+    virtual TimePoint Now() = 0;
+
+    // Wait on cv (lock held) until notified or the clock reaches deadline; may return early
+    virtual void WaitUntil(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, TimePoint deadline) = 0;
+};
+
+// Requests per minute, handed out at a steady rate with a small burst allowance, so that no
+// 60-second window sees more than the quota. Throttle holds every caller back (after a 429)
+class TokenBucket
+{
+public:
+    explicit TokenBucket(int requestsPerMinute, SchedulerClock& clock = SchedulerClock::Steady());
+
+    // Wait for a token; false if cancelled
+    bool Acquire();
+
+    // Hand out nothing until the delay has passed
+    void Throttle(std::chrono::milliseconds delay);
+
+    // Wake waiters with failure (shutdown) / accept waiters again
+    void Cancel();
+    void Resume();
+
+    uint64_t GetWaitedMs() const { return m_waitedMs; }
+
+private:
+    void RefillLocked(SchedulerClock::TimePoint now);
+
+    SchedulerClock& m_clock;
+    double m_tokensPerSecond;
+    double m_capacity;
+    double m_tokens;
+    SchedulerClock::TimePoint m_lastRefill;
+    SchedulerClock::TimePoint m_blockedUntil;
+    bool m_cancelled = false;
+    std::atomic<uint64_t> m_waitedMs{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+// Paces Google API requests to the Sheets read/write quotas and retries rate-limited (429) and
+// server-error (5xx) responses with truncated exponential backoff plus random jitter
+//
+// - Sheets GETs count against the read bucket, other Sheets methods against the write bucket;
+//   Drive requests (a separate, much larger quota) aren't paced
+// - A 429 throttles the whole bucket, so concurrent jobs back off together instead of each
+//   spending its own retries
+// - 5xx responses are retried for requests that are safe to repeat (everything except POSTs
+//   that create something)
+class SheetsRequestScheduler
+{
+public:
+    explicit SheetsRequestScheduler(const SheetsQuotaOptions& options = SheetsQuotaOptions(),
+                                    SchedulerClock& clock = SchedulerClock::Steady());
+
+    // Send a request within quota; false if no response arrived (or shutdown). outResponse holds
+    // the last response, so a status >= 400 remains visible after retries run out
+    bool Execute(HttpClient& client, const HttpRequest& request, HttpResponse& outResponse);
+
+    // Independent requests sent together (HttpClient::SendBatch); the ones that come back 429 or
+    // 5xx go again through Execute
+    std::vector<bool> ExecuteBatch(HttpClient& client, const std::vector<HttpRequest>& requests,
+                                   std::vector<HttpResponse>& outResponses);
+
+    // Run count jobs on up to maxConcurrentJobs threads; result per job index
+    std::vector<bool> RunJobs(size_t count, const std::function<bool(size_t index)>& job);
+
+    // Fail requests waiting for quota or backoff (shutdown) / accept requests again
+    void Cancel();
+    void Resume();
+
+    SheetsSchedulerStats GetStats() const;
+
+    const SheetsQuotaOptions& GetOptions() const { return m_options; }
+
+private:
+    TokenBucket* BucketFor(const HttpRequest& request);
+    static bool IsRetryable(const HttpRequest& request, int statusCode);
+    std::chrono::milliseconds BackoffDelay(int attempt);
+    bool WaitFor(std::chrono::milliseconds delay);
+
+    SheetsQuotaOptions m_options;
+    SchedulerClock& m_clock;
+    TokenBucket m_readBucket;
+    TokenBucket m_writeBucket;
+
+    bool m_cancelled = false;
+    std::mutex m_cancelMutex;
+    std::condition_variable m_cancelCV;
+
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_rateLimited{0};
+    std::atomic<uint64_t> m_serverErrors{0};
+    std::atomic<uint64_t> m_retries{0};
+};
+
+} // namespace UFB
@@ -0,0 +1,242 @@
+#include "sheets_write_planner.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace UFB {
+
+namespace {
+
+constexpr size_t kMinItemRowCells = 12;     // Columns A-L
+
+// One row to write: where it lands once the deletions are done, and which columns
+struct RowWrite
+{
+    int row;                // 0-based sheet row
+    size_t firstColumn;
+    size_t lastColumn;
+    const SheetRow* source;
+};
+
+const std::string& CellAt(const SheetRow& row, size_t column)
+{
+    static const std::string empty;
+    return column < row.cells.size() ? row.cells[column] : empty;
+}
+
+// 0 -> A, 25 -> Z, 26 -> AA
+std::string ColumnName(size_t column)
+{
+    std::string name;
+    for (size_t n = column + 1; n > 0; n = (n - 1) / 26)
+    {
+        name.insert(name.begin(), static_cast<char>('A' + (n - 1) % 26));
+    }
+    return name;
+}
+
+// A1 range over 0-based rows and columns, inclusive
+std::string RangeA1(const std::string& sheetName, int firstRow, int lastRow, size_t firstColumn, size_t lastColumn)
+{
+    return sheetName + "!" + ColumnName(firstColumn) + std::to_string(firstRow + 1) + ":" +
+           ColumnName(lastColumn) + std::to_string(lastRow + 1);
+}
+
+} // namespace
+
+bool IsItemRow(const SheetRow& row)
+{
+    return row.cells.size() >= kMinItemRowCells && !row.cells[1].empty();
+}
+
+CachedSheetRow ToCachedSheetRow(const SheetRow& row)
+{
+    CachedSheetRow cachedRow;
+    // Column A (index 0) is Name - we skip it and use Shot Path as itemPath
+    cachedRow.itemPath = CellAt(row, 1);
+    cachedRow.itemType = CellAt(row, 2);
+    cachedRow.folderType = CellAt(row, 3);
+    cachedRow.status = CellAt(row, 4);
+    cachedRow.category = CellAt(row, 5);
+    cachedRow.priority = CellAt(row, 6);
+    cachedRow.deliveryDate = CellAt(row, 7);
+    cachedRow.assignedArtist = CellAt(row, 8);
+    cachedRow.notes = CellAt(row, 9);
+    cachedRow.clientApproval = CellAt(row, 10);
+    cachedRow.modifiedTimeStr = CellAt(row, 11);
+
+    // Tracking columns M, N, O
+    if (row.cells.size() > 12)
+    {
+        try { cachedRow.modifiedTime = std::stoull(row.cells[12]); } catch (...) { cachedRow.modifiedTime = 0; }
+    }
+    if (row.cells.size() > 13)
+    {
+        try { cachedRow.syncedTime = std::stoull(row.cells[13]); } catch (...) { cachedRow.syncedTime = 0; }
+    }
+    cachedRow.deviceId = CellAt(row, 14);
+    return cachedRow;
+}
+
+SheetRowIndex::SheetRowIndex(const std::vector<SheetRow>& sheetData)
+    : m_rowCount(static_cast<int>(sheetData.size()))
+{
+    m_rows.reserve(sheetData.size());
+    for (size_t i = 1; i < sheetData.size(); ++i)     // Skip header
+    {
+        if (IsItemRow(sheetData[i]))
+        {
+            m_rows[sheetData[i].cells[1]] = static_cast<int>(i);
+        }
+    }
+}
+
+int SheetRowIndex::Find(const std::string& itemPath) const
+{
+    auto it = m_rows.find(itemPath);
+    return it != m_rows.end() ? it->second : -1;
+}
+
+SheetWritePlan PlanSheetWrites(const std::string& sheetName, const std::string& sheetId,
+                               const std::vector<SheetRow>& sheetData, const SheetRowIndex& index,
+                               const std::vector<SheetRow>& localRows,
+                               const SheetsCacheManager::ChangeDetection& changes)
+{
+    SheetWritePlan plan;
+    int rowCount = (std::max)(index.GetRowCount(), 1);     // An empty tab still has its header row
+
+    std::unordered_map<std::string, const SheetRow*> localByPath;
+    localByPath.reserve(localRows.size());
+    for (const auto& row : localRows)
+    {
+        if (row.cells.size() > 1 && !row.cells[1].empty())
+        {
+            localByPath[row.cells[1]] = &row;
+        }
+    }
+
+    // Keep the header and each item's indexed row; deleted items and strays go
+    std::vector<char> keep(rowCount, 0);
+    keep[0] = 1;
+    for (int i = 1; i < index.GetRowCount(); ++i)
+    {
+        const SheetRow& row = sheetData[i];
+        if (IsItemRow(row) && index.Find(row.cells[1]) == i)
+        {
+            keep[i] = 1;
+        }
+    }
+    for (const auto& path : changes.deletedPaths)
+    {
+        int i = index.Find(path);
+        if (i > 0)
+        {
+            keep[i] = 0;
+        }
+    }
+
+    // Contiguous runs, collected top-down and issued bottom-up; newRow maps a kept row to where
+    // it sits once the runs above it are gone
+    std::vector<int> newRow(rowCount, 0);
+    for (int i = 1; i < rowCount; ++i)
+    {
+        if (keep[i])
+        {
+            newRow[i] = i - plan.rowsDeleted;
+            continue;
+        }
+
+        int start = i;
+        while (i + 1 < rowCount && !keep[i + 1])
+        {
+            ++i;
+        }
+        plan.deletions.push_back(RowDeletion{sheetId, start, i + 1});
+        plan.rowsDeleted += i + 1 - start;
+    }
+    std::reverse(plan.deletions.begin(), plan.deletions.end());
+
+    std::vector<RowWrite> writes;
+
+    // Modified rows: only the span from the first to the last cell that differs
+    for (const auto& changed : changes.modifiedRows)
+    {
+        int i = index.Find(changed.itemPath);
+        auto local = localByPath.find(changed.itemPath);
+        if (i < 0 || local == localByPath.end())
+        {
+            continue;
+        }
+
+        const SheetRow& current = sheetData[i];
+        const SheetRow& wanted = *local->second;
+        size_t columns = (std::max)(current.cells.size(), wanted.cells.size());
+        size_t firstColumn = columns;
+        size_t lastColumn = 0;
+        for (size_t column = 0; column < columns; ++column)
+        {
+            if (CellAt(current, column) != CellAt(wanted, column))
+            {
+                firstColumn = (std::min)(firstColumn, column);
+                lastColumn = column;
+            }
+        }
+
+        if (firstColumn < columns)
+        {
+            writes.push_back(RowWrite{newRow[i], firstColumn, lastColumn, &wanted});
+            plan.rowsUpdated++;
+        }
+    }
+
+    // Added rows, in local order, below the last remaining row
+    std::unordered_set<std::string> addedPaths;
+    for (const auto& added : changes.addedRows)
+    {
+        addedPaths.insert(added.itemPath);
+    }
+    int appendRow = rowCount - plan.rowsDeleted;
+    for (const auto& row : localRows)
+    {
+        if (row.cells.size() > 1 && addedPaths.count(row.cells[1]))
+        {
+            writes.push_back(RowWrite{appendRow++, 0, row.cells.size() - 1, &row});
+            plan.rowsAppended++;
+        }
+    }
+
+    // Coalesce: rows that follow each other share one range, as wide as its widest row
+    std::sort(writes.begin(), writes.end(),
+              [](const RowWrite& a, const RowWrite& b) { return a.row < b.row; });
+
+    for (size_t start = 0; start < writes.size(); )
+    {
+        size_t end = start + 1;
+        size_t firstColumn = writes[start].firstColumn;
+        size_t lastColumn = writes[start].lastColumn;
+        while (end < writes.size() && writes[end].row == writes[end - 1].row + 1)
+        {
+            firstColumn = (std::min)(firstColumn, writes[end].firstColumn);
+            lastColumn = (std::max)(lastColumn, writes[end].lastColumn);
+            ++end;
+        }
+
+        CellUpdate update;
+        update.range = RangeA1(sheetName, writes[start].row, writes[end - 1].row, firstColumn, lastColumn);
+        for (size_t w = start; w < end; ++w)
+        {
+            std::vector<std::string> values;
+            for (size_t column = firstColumn; column <= lastColumn; ++column)
+            {
+                values.push_back(CellAt(*writes[w].source, column));
+            }
+            update.values.push_back(std::move(values));
+        }
+        plan.cellsWritten += (end - start) * (lastColumn - firstColumn + 1);
+        plan.updates.push_back(std::move(update));
+        start = end;
+    }
+
+    return plan;
+}
+
+} // namespace UFB
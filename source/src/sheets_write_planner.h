@@ -0,0 +1,58 @@
+#pragma once
+
+#include "google_sheets_manager.h"
+#include "sheets_cache_manager.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace UFB {
+
+// Rows of a tab that hold an item (columns A-L at least, Shot Path set); the rest are strays
+bool IsItemRow(const SheetRow& row);
+
+// Sheet row (columns A-O) to cache row; column A (Name) is derived from the path and not kept
+CachedSheetRow ToCachedSheetRow(const SheetRow& row);
+
+// Where each item sits in a tab as read at the start of a sync: itemPath -> index into the A:O
+// values (index 0 is the header, so index i is sheet row i + 1). A duplicated path maps to its
+// last row, the same row the tab cache keeps
+class SheetRowIndex
+{
+public:
+    explicit SheetRowIndex(const std::vector<SheetRow>& sheetData);
+
+    // Index of the item's row, -1 if it isn't in the tab
+    int Find(const std::string& itemPath) const;
+
+    // Rows read, header included
+    int GetRowCount() const { return m_rowCount; }
+
+private:
+    std::unordered_map<std::string, int> m_rows;
+    int m_rowCount = 0;
+};
+
+// Writes that turn a tab's current contents into the local rows
+struct SheetWritePlan
+{
+    std::vector<CellUpdate> updates;        // values:batchUpdate data, top to bottom
+    std::vector<RowDeletion> deletions;     // Bottom-up, so each range is still where it was read
+    int rowsUpdated = 0;
+    int rowsAppended = 0;
+    int rowsDeleted = 0;
+    size_t cellsWritten = 0;
+};
+
+// Plan a tab's push from changes = DetectChanges(tab contents, local rows):
+// - modified rows are rewritten in place from their first to last changed cell, and rows that end
+//   up adjacent share one range
+// - added rows are appended in one range below the last remaining row
+// - deleted rows, and stray rows (blank, partial, duplicated), are deleted in contiguous runs
+// Update ranges address the tab after the deletions have been applied
+SheetWritePlan PlanSheetWrites(const std::string& sheetName, const std::string& sheetId,
+                               const std::vector<SheetRow>& sheetData, const SheetRowIndex& index,
+                               const std::vector<SheetRow>& localRows,
+                               const SheetsCacheManager::ChangeDetection& changes);
+
+} // namespace UFB
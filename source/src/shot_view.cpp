@@ -5,6 +5,8 @@
 #include "metadata_manager.h"
 #include "project_config.h"
 #include "utils.h"
+#include "image_sequence.h"
+#include "directory_cache.h"
 #include "ole_drag_drop.h"
 #include "ImGuiDatePicker.hpp"
 #include <iostream>
@@ -20,6 +22,9 @@
 // C++20 changed u8"" literals to char8_t, need to cast for ImGui
 #define U8(x) reinterpret_cast<const char*>(u8##x)
 
+// Date filters are relative to now, so filtered rows are re-evaluated this often while one is active
+static constexpr double kTimeFilterRefreshSeconds = 60.0;
+
 // Helper functions to convert between tm and uint64_t Unix timestamps
 // Note: App stores timestamps in milliseconds, but mktime uses seconds
 static tm TimestampToTm(uint64_t timestampMillis)
@@ -49,6 +54,7 @@ static uint64_t TmToTimestamp(const tm& time)
 
 // Static members
 bool ShotView::showHiddenFiles = false;
+UFB::StorageAnalyzer* ShotView::storageAnalyzer = nullptr;
 std::vector<std::wstring> ShotView::m_cutFiles;
 int ShotView::m_oleRefCount = 0;
 
@@ -155,25 +161,24 @@ void ShotView::RefreshShots()
 {
     m_shots.clear();
     m_shotMetadataMap.clear();
+    m_shotRowsDirty = true;
+    m_shotUsageVersion = UINT64_MAX;
 
     try
     {
-        for (const auto& entry : std::filesystem::directory_iterator(m_categoryPath))
+        // One bulk directory read (no per-entry stat round trips on network shares)
+        std::vector<FileEntry> entries;
+        UFB::ListDirectory(m_categoryPath, true, entries);
+
+        for (auto& fileEntry : entries)
         {
-            if (entry.is_directory())
+            if (fileEntry.isDirectory)
             {
                 // Skip hidden folders if needed
-                if (!showHiddenFiles && (entry.path().filename().wstring()[0] == L'.'))
+                if (!showHiddenFiles && fileEntry.name[0] == L'.')
                     continue;
 
-                FileEntry fileEntry;
-                fileEntry.name = entry.path().filename().wstring();
-                fileEntry.fullPath = entry.path().wstring();
-                fileEntry.isDirectory = true;
-                fileEntry.size = 0;
-                fileEntry.lastModified = entry.last_write_time();
-
-                m_shots.push_back(fileEntry);
+                m_shots.push_back(std::move(fileEntry));
             }
         }
 
@@ -208,21 +213,15 @@ void ShotView::RefreshProjectFiles()
 
         for (const auto& searchPath : searchPaths)
         {
-            if (std::filesystem::exists(searchPath) && std::filesystem::is_directory(searchPath))
+            // Missing folders just return no entries (saves separate exists/is_directory checks)
+            std::vector<FileEntry> entries;
+            UFB::ListDirectory(searchPath.wstring(), true, entries);
+
+            for (auto& fileEntry : entries)
             {
-                for (const auto& entry : std::filesystem::directory_iterator(searchPath))
+                if (!fileEntry.isDirectory)
                 {
-                    if (!entry.is_directory())
-                    {
-                        FileEntry fileEntry;
-                        fileEntry.name = entry.path().filename().wstring();
-                        fileEntry.fullPath = entry.path().wstring();
-                        fileEntry.isDirectory = false;
-                        fileEntry.size = entry.file_size();
-                        fileEntry.lastModified = entry.last_write_time();
-
-                        m_projectFiles.push_back(fileEntry);
-                    }
+                    m_projectFiles.push_back(std::move(fileEntry));
                 }
             }
         }
@@ -240,19 +239,17 @@ void ShotView::RefreshProjectFiles()
 
 void ShotView::RefreshRenderFiles()
 {
-    m_renderFiles.clear();
-
     // If m_renderCurrentDirectory is empty, initialize it to renders/outputs folder
     if (m_renderCurrentDirectory.empty())
     {
-        if (m_selectedShotPath.empty())
-            return;
-
-        // Try "renders" and "outputs" subdirectories
         std::filesystem::path rendersPath = std::filesystem::path(m_selectedShotPath) / L"renders";
         std::filesystem::path outputsPath = std::filesystem::path(m_selectedShotPath) / L"outputs";
 
-        if (std::filesystem::exists(rendersPath) && std::filesystem::is_directory(rendersPath))
+        if (m_selectedShotPath.empty())
+        {
+            // Nothing to list
+        }
+        else if (std::filesystem::exists(rendersPath) && std::filesystem::is_directory(rendersPath))
         {
             m_renderCurrentDirectory = rendersPath.wstring();
         }
@@ -260,38 +257,159 @@ void ShotView::RefreshRenderFiles()
         {
             m_renderCurrentDirectory = outputsPath.wstring();
         }
-        else
+
+        if (m_renderCurrentDirectory.empty())
         {
-            return;  // No renders or outputs folder found
+            // No renders or outputs folder found
+            m_renderEnumerator.Cancel();
+            m_pendingRenderEntries.clear();
+            m_streamingRenderListing = false;
+            m_renderListedDirectory.clear();
+            m_renderFiles.clear();
+            m_selectedRenderIndices.clear();
+            return;
         }
     }
 
-    try
+    auto& cache = UFB::DirectoryCache::Get();
+
+    // Show a recent listing of a different folder instantly (returning to a shot), then revalidate it
+    if (m_renderCurrentDirectory != m_renderListedDirectory)
     {
-        if (std::filesystem::exists(m_renderCurrentDirectory) && std::filesystem::is_directory(m_renderCurrentDirectory))
+        std::vector<FileEntry> cached;
+        uint64_t cachedVersion = 0;
+        if (cache.Lookup(m_renderCurrentDirectory, true, cached, cachedVersion))
         {
-            for (const auto& entry : std::filesystem::directory_iterator(m_renderCurrentDirectory))
-            {
-                // Include both files and directories
-                FileEntry fileEntry;
-                fileEntry.name = entry.path().filename().wstring();
-                fileEntry.fullPath = entry.path().wstring();
-                fileEntry.isDirectory = entry.is_directory();
-                fileEntry.size = entry.is_directory() ? 0 : entry.file_size();
-                fileEntry.lastModified = entry.last_write_time();
-
-                m_renderFiles.push_back(fileEntry);
-            }
+            m_selectedRenderIndices.clear();
+            m_renderListedDirectory = m_renderCurrentDirectory;
+            m_renderListedVersion = cachedVersion;
+            m_renderFiles = std::move(cached);
+            FinishRenderFiles();
         }
+    }
 
-        // Sort by last modified (newest first) - will be overridden by table sorting if user clicks column
-        std::sort(m_renderFiles.begin(), m_renderFiles.end(), [](const FileEntry& a, const FileEntry& b) {
-            return a.lastModified > b.lastModified;
-        });
+    // Read on the enumerator thread; the current rows stay until the new listing arrives
+    m_renderReadVersion = cache.GetVersion(m_renderCurrentDirectory);
+    m_renderEnumerator.Start(m_renderCurrentDirectory, true);
+    m_pendingRenderEntries.clear();
+    m_streamingRenderListing = false;
+}
+
+void ShotView::FinishRenderFiles()
+{
+    // One row per render sequence instead of one per frame
+    if (FileBrowser::collapseImageSequences)
+    {
+        UFB::CollapseImageSequences(m_renderFiles);
     }
-    catch (const std::exception& e)
+
+    // Sort by last modified (newest first) - will be overridden by table sorting if user clicks column
+    std::sort(m_renderFiles.begin(), m_renderFiles.end(), [](const FileEntry& a, const FileEntry& b) {
+        return a.lastModified > b.lastModified;
+    });
+}
+
+void ShotView::PollRenderListing()
+{
+    // Renders landing from the farm - re-read the folder on screen in the background
+    if (!m_renderEnumerator.IsBusy() && !m_renderListedDirectory.empty() && m_renderListedDirectory == m_renderCurrentDirectory)
+    {
+        double now = glfwGetTime();
+        if (UFB::DirectoryCache::Get().GetVersion(m_renderListedDirectory) != m_renderListedVersion &&
+            now - m_lastRenderAutoRefreshTime >= 1.0)  // At most once a second while frames keep arriving
+        {
+            m_lastRenderAutoRefreshTime = now;
+            RefreshRenderFiles();
+        }
+    }
+
+    std::vector<FileEntry> batch;
+    bool complete = false;
+    bool failed = false;
+
+    if (!m_renderEnumerator.Poll(batch, complete, failed))
+        return;
+
+    m_pendingRenderEntries.insert(m_pendingRenderEntries.end(), std::make_move_iterator(batch.begin()),
+                                  std::make_move_iterator(batch.end()));
+
+    bool newDirectory = (m_renderEnumerator.GetPath() != m_renderListedDirectory);
+
+    // Same folder: swap when whole (no flicker); different folder: show batches as they arrive
+    if (!complete && !newDirectory && !m_streamingRenderListing)
+        return;
+
+    if (failed)
+    {
+        std::wcerr << L"[ShotView] Failed to read render directory: " << m_renderEnumerator.GetPath() << std::endl;
+        UFB::DirectoryCache::Get().Remove(m_renderEnumerator.GetPath());
+    }
+    else if (complete)
+    {
+        UFB::DirectoryCache::Get().Store(m_renderEnumerator.GetPath(), true, m_pendingRenderEntries, m_renderReadVersion);
+    }
+
+    if (complete)
+    {
+        m_renderListedVersion = failed ? UFB::DirectoryCache::Get().GetVersion(m_renderEnumerator.GetPath()) : m_renderReadVersion;
+    }
+
+    if (newDirectory)
+    {
+        m_selectedRenderIndices.clear();
+        m_renderListedDirectory = m_renderEnumerator.GetPath();
+    }
+
+    // Selection is by index; carry it over by path when the same folder is re-read
+    std::set<std::wstring> selectedPaths;
+    for (int idx : m_selectedRenderIndices)
+    {
+        if (idx >= 0 && idx < static_cast<int>(m_renderFiles.size()))
+            selectedPaths.insert(m_renderFiles[idx].fullPath);
+    }
+
+    m_streamingRenderListing = !complete;
+
+    if (complete)
+    {
+        m_renderFiles = std::move(m_pendingRenderEntries);
+        m_pendingRenderEntries.clear();
+    }
+    else
+    {
+        m_renderFiles = m_pendingRenderEntries;
+    }
+
+    FinishRenderFiles();
+
+    m_selectedRenderIndices.clear();
+    for (size_t i = 0; i < m_renderFiles.size() && !selectedPaths.empty(); i++)
+    {
+        if (selectedPaths.count(m_renderFiles[i].fullPath))
+            m_selectedRenderIndices.insert(static_cast<int>(i));
+    }
+
+    if (complete && !m_pendingRenderSelectPath.empty())
     {
-        std::cerr << "[ShotView] Error refreshing render files: " << e.what() << std::endl;
+        bool found = false;
+        for (size_t i = 0; i < m_renderFiles.size(); i++)
+        {
+            if (m_renderFiles[i].fullPath == m_pendingRenderSelectPath)
+            {
+                m_selectedRenderIndices.clear();
+                m_selectedRenderIndices.insert(static_cast<int>(i));
+                std::wcout << L"[ShotView] Selected file in render panel: " << m_renderFiles[i].name << std::endl;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            std::wcout << L"[ShotView] File not found in project or render panels: " << m_pendingRenderSelectPath << std::endl;
+        }
+
+        m_pendingRenderSelectPath.clear();
     }
 }
 
@@ -482,7 +600,7 @@ void ShotView::Draw(const char* title, HWND hwnd)
                     {
                         if (idx >= 0 && idx < m_renderFiles.size())
                         {
-                            paths.push_back(m_renderFiles[idx].fullPath);
+                            UFB::AppendEntryPaths(m_renderFiles[idx], paths);
                         }
                     }
                 }
@@ -514,7 +632,7 @@ void ShotView::Draw(const char* title, HWND hwnd)
                     {
                         if (idx >= 0 && idx < m_renderFiles.size())
                         {
-                            paths.push_back(m_renderFiles[idx].fullPath);
+                            UFB::AppendEntryPaths(m_renderFiles[idx], paths);
                         }
                     }
                 }
@@ -552,7 +670,7 @@ void ShotView::Draw(const char* title, HWND hwnd)
                     {
                         if (idx >= 0 && idx < m_renderFiles.size())
                         {
-                            paths.push_back(m_renderFiles[idx].fullPath);
+                            UFB::AppendEntryPaths(m_renderFiles[idx], paths);
                         }
                     }
                 }
@@ -581,7 +699,7 @@ void ShotView::Draw(const char* title, HWND hwnd)
                 else if (m_selectedRenderIndices.size() == 1)
                 {
                     int idx = *m_selectedRenderIndices.begin();
-                    if (idx >= 0 && idx < m_renderFiles.size())
+                    if (idx >= 0 && idx < m_renderFiles.size() && !m_renderFiles[idx].IsSequence())
                     {
                         m_renameOriginalPath = m_renderFiles[idx].fullPath;
                         std::wstring filename = m_renderFiles[idx].name;
@@ -662,6 +780,9 @@ void ShotView::Draw(const char* title, HWND hwnd)
         }
     }
 
+    // Keyboard paste/delete (and tables that were not drawn this frame)
+    RunPendingReloads();
+
     ImGui::End();
 }
 
@@ -728,18 +849,8 @@ void ShotView::SetSelectedShotAndFile(const std::wstring& shotPath, const std::w
         }
     }
 
-    // Try to find and select the file in render files
-    for (size_t i = 0; i < m_renderFiles.size(); i++)
-    {
-        if (m_renderFiles[i].fullPath == canonicalFilePath)
-        {
-            m_selectedRenderIndices.insert(static_cast<int>(i));
-            std::wcout << L"[ShotView] Selected file in render panel: " << m_renderFiles[i].name << std::endl;
-            return;
-        }
-    }
-
-    std::wcout << L"[ShotView] File not found in project or render panels: " << canonicalFilePath << std::endl;
+    // Otherwise select it in the render files once their listing has been read
+    m_pendingRenderSelectPath = canonicalFilePath;
 }
 
 void ShotView::DrawShotsPanel(HWND hwnd)
@@ -824,12 +935,14 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                     m_filterStatuses.insert(status);
                 else
                     m_filterStatuses.erase(status);
+                m_shotRowsDirty = true;
             }
         }
         ImGui::Separator();
         if (ImGui::Button("Clear All"))
         {
             m_filterStatuses.clear();
+            m_shotRowsDirty = true;
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -859,12 +972,14 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                     m_filterCategories.insert(category);
                 else
                     m_filterCategories.erase(category);
+                m_shotRowsDirty = true;
             }
         }
         ImGui::Separator();
         if (ImGui::Button("Clear All"))
         {
             m_filterCategories.clear();
+            m_shotRowsDirty = true;
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -894,12 +1009,14 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                     m_filterArtists.insert(artist);
                 else
                     m_filterArtists.erase(artist);
+                m_shotRowsDirty = true;
             }
         }
         ImGui::Separator();
         if (ImGui::Button("Clear All"))
         {
             m_filterArtists.clear();
+            m_shotRowsDirty = true;
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -932,6 +1049,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                         m_filterPriorities.insert(priority);
                     else
                         m_filterPriorities.erase(priority);
+                    m_shotRowsDirty = true;
                 }
             }
         }
@@ -939,6 +1057,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
         if (ImGui::Button("Clear All"))
         {
             m_filterPriorities.clear();
+            m_shotRowsDirty = true;
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -969,6 +1088,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
             if (ImGui::Selectable(dueDateOptions[i], isSelected))
             {
                 m_filterDueDate = i;
+                m_shotRowsDirty = true;
             }
         }
         ImGui::EndPopup();
@@ -988,6 +1108,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
             m_filterArtists.clear();
             m_filterPriorities.clear();
             m_filterDueDate = 0;
+            m_shotRowsDirty = true;
         }
         if (font_icons) ImGui::PopFont();
         if (ImGui::IsItemHovered())
@@ -1024,6 +1145,8 @@ void ShotView::DrawShotsPanel(HWND hwnd)
         if (ImGui::Button(U8("\uE5D5##shots")))  // Material Icons refresh
         {
             RefreshShots();
+            if (storageAnalyzer && m_visibleColumns["Size"])
+                storageAnalyzer->ScanJob(std::filesystem::path(m_categoryPath).parent_path().wstring(), true);
         }
         ImGui::PopFont();
     }
@@ -1032,6 +1155,8 @@ void ShotView::DrawShotsPanel(HWND hwnd)
         if (ImGui::Button("R##shots"))
         {
             RefreshShots();
+            if (storageAnalyzer && m_visibleColumns["Size"])
+                storageAnalyzer->ScanJob(std::filesystem::path(m_categoryPath).parent_path().wstring(), true);
         }
     }
 
@@ -1100,6 +1225,14 @@ void ShotView::DrawShotsPanel(HWND hwnd)
             SaveColumnVisibility();
         }
 
+        bool sizeVisible = m_visibleColumns["Size"];
+        if (ImGui::Checkbox("Size", &sizeVisible))
+        {
+            m_visibleColumns["Size"] = sizeVisible;
+            m_shotUsageVersion = UINT64_MAX;
+            SaveColumnVisibility();
+        }
+
         ImGui::EndPopup();
     }
 
@@ -1127,6 +1260,13 @@ void ShotView::DrawShotsPanel(HWND hwnd)
         //std::cout << "[ShotView] Shots table will have " << columnCount << " columns (" << (columnCount - 2) << " metadata columns)" << std::endl;
     }
 
+    // Size column: scan the job in the background (skipped when scanned recently) and pick up new results
+    if (storageAnalyzer && m_visibleColumns["Size"])
+    {
+        storageAnalyzer->ScanJob(std::filesystem::path(m_categoryPath).parent_path().wstring());
+        RefreshShotUsage();
+    }
+
     // Push larger cell padding for taller rows (match transcoding queue style)
     ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(8.0f, 8.0f));
 
@@ -1157,6 +1297,9 @@ void ShotView::DrawShotsPanel(HWND hwnd)
         if (m_visibleColumns["Links"])
             ImGui::TableSetupColumn("Links", ImGuiTableColumnFlags_WidthFixed, 60.0f);
 
+        if (m_visibleColumns["Size"])
+            ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 100.0f);
+
         // Modified column (always last)
         ImGui::TableSetupColumn("Modified", ImGuiTableColumnFlags_WidthFixed, 150.0f);
 
@@ -1183,6 +1326,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                     if (m_visibleColumns["DueDate"]) columnIndexMap[currentIndex++] = "DueDate";
                     if (m_visibleColumns["Notes"]) columnIndexMap[currentIndex++] = "Notes";
                     if (m_visibleColumns["Links"]) columnIndexMap[currentIndex++] = "Links";
+                    if (m_visibleColumns["Size"]) columnIndexMap[currentIndex++] = "Size";
 
                     columnIndexMap[currentIndex] = "Modified";  // Modified is always last
 
@@ -1202,6 +1346,14 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                         {
                             return ascending ? (a.lastModified < b.lastModified) : (a.lastModified > b.lastModified);
                         }
+                        else if (sortField == "Size")
+                        {
+                            auto itA = m_shotUsage.find(a.fullPath);
+                            auto itB = m_shotUsage.find(b.fullPath);
+                            uint64_t sizeA = (itA != m_shotUsage.end()) ? itA->second.totalSize : 0;
+                            uint64_t sizeB = (itB != m_shotUsage.end()) ? itB->second.totalSize : 0;
+                            return ascending ? (sizeA < sizeB) : (sizeA > sizeB);
+                        }
                         else if (sortField == "Status" || sortField == "Category" || sortField == "Artist" ||
                                  sortField == "Priority" || sortField == "DueDate" || sortField == "Notes" || sortField == "Links")
                         {
@@ -1270,500 +1422,530 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                     });
                 }
                 sortSpecs->SpecsDirty = false;
+                m_shotRowsDirty = true;
             }
         }
 
-        for (int i = 0; i < m_shots.size(); i++)
+        // Filtered rows and their labels are rebuilt only when shots, metadata, filters or sort order
+        // change (or periodically while a due date filter is active, since it is relative to now)
+        if (m_shotRowsDirty || (m_filterDueDate != 0 && glfwGetTime() - m_shotRowsBuiltTime > kTimeFilterRefreshSeconds))
+            RebuildShotRows();
+
+        // Only the visible rows are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_shotRows.size()));
+
+        while (clipper.Step())
         {
-            const FileEntry& entry = m_shots[i];
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                const ShotRow& shotRow = m_shotRows[row];
+                const int i = shotRow.index;
 
-            // Apply filters - skip if doesn't pass
-            if (!PassesFilters(entry))
-                continue;
+                const FileEntry& entry = m_shots[i];
 
-            // Set minimum row height (match transcoding queue style)
-            ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
-            ImGui::TableNextColumn();
+                // Set minimum row height (match transcoding queue style)
+                ImGui::TableNextRow(ImGuiTableRowFlags_None, 35.0f);
+                ImGui::TableNextColumn();
 
-            ImGui::PushID(i);
+                ImGui::PushID(i);
 
-            // Get icon
-            ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, true);
+                // Get icon
+                ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, true);
 
-            bool isSelected = (i == m_selectedShotIndex);
+                bool isSelected = (i == m_selectedShotIndex);
 
-            // Get or create metadata for this shot (needed for star icon)
-            UFB::ShotMetadata* metadata = nullptr;
-            auto metadataIt = m_shotMetadataMap.find(entry.fullPath);
-            if (metadataIt != m_shotMetadataMap.end())
-                metadata = &metadataIt->second;
+                // Get or create metadata for this shot (needed for star icon)
+                UFB::ShotMetadata* metadata = nullptr;
+                auto metadataIt = m_shotMetadataMap.find(entry.fullPath);
+                if (metadataIt != m_shotMetadataMap.end())
+                    metadata = &metadataIt->second;
 
-            // Use accent color for selected items
-            ImVec4 accentColor = GetAccentColor();
-            if (isSelected)
-            {
-                ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
-                ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
-                ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
-            }
+                // Use accent color for selected items
+                ImVec4 accentColor = GetAccentColor();
+                if (isSelected)
+                {
+                    ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
+                    ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
+                    ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
+                }
 
-            // Draw icon or star if tracked
-            if (metadata && metadata->isTracked)
-            {
-                // Draw star icon for tracked items (use bright variant)
-                ImVec4 brightAccent = ImVec4(accentColor.x * 1.3f, accentColor.y * 1.3f, accentColor.z * 1.3f, 1.0f);
-                ImGui::PushStyleColor(ImGuiCol_Text, brightAccent);
-                ImGui::Text("\xE2\x98\x85");  // Unicode star character (U+2605)
-                ImGui::PopStyleColor();
-                ImGui::SameLine();
-            }
-            else if (icon)
-            {
-                // Draw folder icon for untracked items
-                ImGui::Image(icon, ImVec2(16, 16));
-                ImGui::SameLine();
-            }
+                // Draw icon or star if tracked
+                if (metadata && metadata->isTracked)
+                {
+                    // Draw star icon for tracked items (use bright variant)
+                    ImVec4 brightAccent = ImVec4(accentColor.x * 1.3f, accentColor.y * 1.3f, accentColor.z * 1.3f, 1.0f);
+                    ImGui::PushStyleColor(ImGuiCol_Text, brightAccent);
+                    ImGui::Text("\xE2\x98\x85");  // Unicode star character (U+2605)
+                    ImGui::PopStyleColor();
+                    ImGui::SameLine();
+                }
+                else if (icon)
+                {
+                    // Draw folder icon for untracked items
+                    ImGui::Image(icon, ImVec2(16, 16));
+                    ImGui::SameLine();
+                }
 
-            // Convert name to UTF-8
-            char nameUtf8[512];
-            WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, nameUtf8, sizeof(nameUtf8), nullptr, nullptr);
+                // Use explicit height to match row height (35.0f)
+                if (ImGui::Selectable(shotRow.name.c_str(), isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
+                {
+                    // Select this shot
+                    m_selectedShotIndex = i;
+                    m_selectedShotPath = entry.fullPath;
 
-            // Use explicit height to match row height (35.0f)
-            if (ImGui::Selectable(nameUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(0, 35.0f)))
-            {
-                // Select this shot
-                m_selectedShotIndex = i;
-                m_selectedShotPath = entry.fullPath;
+                    // Reset render navigation state when switching shots
+                    m_renderCurrentDirectory.clear();
+                    m_renderBackHistory.clear();
+                    m_renderForwardHistory.clear();
 
-                // Reset render navigation state when switching shots
-                m_renderCurrentDirectory.clear();
-                m_renderBackHistory.clear();
-                m_renderForwardHistory.clear();
+                    // Refresh project and render files
+                    RefreshProjectFiles();
+                    RefreshRenderFiles();
 
-                // Refresh project and render files
-                RefreshProjectFiles();
-                RefreshRenderFiles();
+                    // Double-click detection
+                    double currentTime = glfwGetTime();
+                    if (m_lastClickedShotIndex == i && (currentTime - m_lastClickTime) < 0.3)
+                    {
+                        // Double-clicked - open in file explorer
+                        ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                    }
+                    m_lastClickTime = currentTime;
+                    m_lastClickedShotIndex = i;
+                }
 
-                // Double-click detection
-                double currentTime = glfwGetTime();
-                if (m_lastClickedShotIndex == i && (currentTime - m_lastClickTime) < 0.3)
+                if (isSelected)
                 {
-                    // Double-clicked - open in file explorer
-                    ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                    ImGui::PopStyleColor(3);
                 }
-                m_lastClickTime = currentTime;
-                m_lastClickedShotIndex = i;
-            }
-
-            if (isSelected)
-            {
-                ImGui::PopStyleColor(3);
-            }
 
-            // Context menu
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
-            {
-                ImGui::OpenPopup("shot_context_menu");
-            }
+                // Context menu
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
+                {
+                    ImGui::OpenPopup("shot_context_menu");
+                }
 
-            ShowImGuiContextMenu(hwnd, entry, PanelType::Shots);
+                ShowImGuiContextMenu(hwnd, entry, PanelType::Shots);
 
-            // Middle-click to open in new window
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
-            {
-                if (onOpenInNewWindow)
+                // Middle-click to open in new window
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
                 {
-                    std::filesystem::path targetPath(entry.fullPath);
-                    std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
-                    onOpenInNewWindow(pathToOpen);
+                    if (onOpenInNewWindow)
+                    {
+                        std::filesystem::path targetPath(entry.fullPath);
+                        std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
+                        onOpenInNewWindow(pathToOpen);
+                    }
                 }
-            }
-
-            // Push mono font for all metadata columns (not the name)
-            if (font_mono)
-                ImGui::PushFont(font_mono);
 
-            // If no metadata exists, create a default one in memory
-            UFB::ShotMetadata tempMetadata;
-            if (!metadata)
-            {
-                tempMetadata.shotPath = entry.fullPath;
-                tempMetadata.folderType = UFB::WideToUtf8(m_categoryName);
-                tempMetadata.isTracked = false;
+                // Push mono font for all metadata columns (not the name)
+                if (font_mono)
+                    ImGui::PushFont(font_mono);
 
-                // Load default metadata values from ProjectConfig
-                if (m_projectConfig && m_projectConfig->IsLoaded())
+                // If no metadata exists, create a default one in memory
+                UFB::ShotMetadata tempMetadata;
+                if (!metadata)
                 {
-                    auto defaultMeta = m_projectConfig->GetDefaultMetadata(tempMetadata.folderType);
-                    if (defaultMeta.has_value())
+                    tempMetadata.shotPath = entry.fullPath;
+                    tempMetadata.folderType = UFB::WideToUtf8(m_categoryName);
+                    tempMetadata.isTracked = false;
+
+                    // Load default metadata values from ProjectConfig
+                    if (m_projectConfig && m_projectConfig->IsLoaded())
                     {
-                        tempMetadata.status = defaultMeta->status;
-                        tempMetadata.category = defaultMeta->category;
-                        tempMetadata.priority = defaultMeta->priority;
-                        tempMetadata.artist = defaultMeta->artist;
-                        tempMetadata.note = defaultMeta->note;
-                        // dueDate and links stay at defaults (0 and empty)
+                        auto defaultMeta = m_projectConfig->GetDefaultMetadata(tempMetadata.folderType);
+                        if (defaultMeta.has_value())
+                        {
+                            tempMetadata.status = defaultMeta->status;
+                            tempMetadata.category = defaultMeta->category;
+                            tempMetadata.priority = defaultMeta->priority;
+                            tempMetadata.artist = defaultMeta->artist;
+                            tempMetadata.note = defaultMeta->note;
+                            // dueDate and links stay at defaults (0 and empty)
+                        }
+                        else
+                        {
+                            // Fallback if no default metadata found
+                            tempMetadata.priority = 2;
+                        }
                     }
                     else
                     {
-                        // Fallback if no default metadata found
+                        // Fallback if ProjectConfig not loaded
                         tempMetadata.priority = 2;
                     }
-                }
-                else
-                {
-                    // Fallback if ProjectConfig not loaded
-                    tempMetadata.priority = 2;
-                }
-
-                metadata = &tempMetadata;
-            }
 
-            // Store if we need to save changes
-            bool metadataChanged = false;
+                    metadata = &tempMetadata;
+                }
 
-            // Safety check: metadata should always be valid at this point
-            if (!metadata)
-            {
-                std::cerr << "[ShotView] ERROR: metadata pointer is null for shot: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+                // Store if we need to save changes
+                bool metadataChanged = false;
 
-                // Fill remaining columns with error text
-                for (const auto& [col, visible] : m_visibleColumns)
+                // Safety check: metadata should always be valid at this point
+                if (!metadata)
                 {
-                    if (visible)
+                    std::cerr << "[ShotView] ERROR: metadata pointer is null for shot: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+
+                    // Fill remaining columns with error text
+                    for (const auto& [col, visible] : m_visibleColumns)
                     {
-                        ImGui::TableNextColumn();
-                        ImGui::TextDisabled("(error)");
+                        if (visible)
+                        {
+                            ImGui::TableNextColumn();
+                            ImGui::TextDisabled("(error)");
+                        }
                     }
-                }
 
-                // Modified column
-                ImGui::TableNextColumn();
-                ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
+                    // Modified column
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("%s", shotRow.modified.c_str());
 
-                // Pop mono font before continuing
-                if (font_mono)
-                    ImGui::PopFont();
+                    // Pop mono font before continuing
+                    if (font_mono)
+                        ImGui::PopFont();
 
-                ImGui::PopID();
-                continue;  // Skip to next shot
-            }
-
-            // Status column - Editable combo box
-            if (m_visibleColumns["Status"])
-            {
-                ImGui::TableNextColumn();
+                    ImGui::PopID();
+                    continue;  // Skip to next shot
+                }
 
-                // Get status options from ProjectConfig using the shot's folderType
-                std::vector<UFB::StatusOption> statusOptions;
-                if (m_projectConfig && !metadata->folderType.empty())
+                // Status column - Editable combo box
+                if (m_visibleColumns["Status"])
                 {
-                    statusOptions = m_projectConfig->GetStatusOptions(metadata->folderType);
-                    // Debug logging
-                    if (i == 0)  // Only log for first item to avoid spam
+                    ImGui::TableNextColumn();
+
+                    // Get status options from ProjectConfig using the shot's folderType
+                    std::vector<UFB::StatusOption> statusOptions;
+                    if (m_projectConfig && !metadata->folderType.empty())
                     {
-                       /* printf("[DEBUG] Shot View - folderType: '%s', statusOptions.size(): %zu\n",
-                               metadata->folderType.c_str(), statusOptions.size());*/
+                        statusOptions = m_projectConfig->GetStatusOptions(metadata->folderType);
+                        // Debug logging
+                        if (i == 0)  // Only log for first item to avoid spam
+                        {
+                           /* printf("[DEBUG] Shot View - folderType: '%s', statusOptions.size(): %zu\n",
+                                   metadata->folderType.c_str(), statusOptions.size());*/
+                        }
                     }
-                }
-                else
-                {
-                    if (i == 0)
+                    else
                     {
-                       /* printf("[DEBUG] Shot View - Cannot get status options. ProjectConfig: %p, folderType: '%s'\n",
-                               (void*)m_projectConfig, metadata->folderType.c_str());*/
+                        if (i == 0)
+                        {
+                           /* printf("[DEBUG] Shot View - Cannot get status options. ProjectConfig: %p, folderType: '%s'\n",
+                                   (void*)m_projectConfig, metadata->folderType.c_str());*/
+                        }
                     }
-                }
 
-                std::string currentStatus = metadata->status;
-                std::string displayStatus = currentStatus.empty() ? "Not Set" : currentStatus;
+                    std::string currentStatus = metadata->status;
+                    std::string displayStatus = currentStatus.empty() ? "Not Set" : currentStatus;
 
-                // Color the combo box button based on status
-                ImVec4 statusColor = currentStatus.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetStatusColor(currentStatus);
-                ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
+                    // Color the combo box button based on status
+                    ImVec4 statusColor = currentStatus.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetStatusColor(currentStatus);
+                    ImGui::PushStyleColor(ImGuiCol_Text, statusColor);
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(("##status" + std::to_string(i)).c_str(), displayStatus.c_str()))
-                {
-                    if (statusOptions.empty())
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(("##status" + std::to_string(i)).c_str(), displayStatus.c_str()))
                     {
-                        ImGui::TextDisabled("(No options configured)");
-                    }
-                    else
-                    {
-                        for (const auto& option : statusOptions)
+                        if (statusOptions.empty())
                         {
-                            bool isSelected = (currentStatus == option.name);
-                            ImVec4 optionColor = GetStatusColor(option.name);
-                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
-
-                            if (ImGui::Selectable(option.name.c_str(), isSelected))
+                            ImGui::TextDisabled("(No options configured)");
+                        }
+                        else
+                        {
+                            for (const auto& option : statusOptions)
                             {
-                                metadata->status = option.name;
-                                metadataChanged = true;
-                            }
+                                bool isSelected = (currentStatus == option.name);
+                                ImVec4 optionColor = GetStatusColor(option.name);
+                                ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
 
-                            ImGui::PopStyleColor();
+                                if (ImGui::Selectable(option.name.c_str(), isSelected))
+                                {
+                                    metadata->status = option.name;
+                                    metadataChanged = true;
+                                }
 
-                            if (isSelected)
-                                ImGui::SetItemDefaultFocus();
+                                ImGui::PopStyleColor();
+
+                                if (isSelected)
+                                    ImGui::SetItemDefaultFocus();
+                            }
                         }
+                        ImGui::EndCombo();
                     }
-                    ImGui::EndCombo();
-                }
 
-                ImGui::PopStyleColor();
-            }
-
-            // Category column - Editable combo box
-            if (m_visibleColumns["Category"])
-            {
-                ImGui::TableNextColumn();
+                    ImGui::PopStyleColor();
+                }
 
-                // Get category options from ProjectConfig using the shot's folderType
-                std::vector<UFB::CategoryOption> categoryOptions;
-                if (m_projectConfig && !metadata->folderType.empty())
+                // Category column - Editable combo box
+                if (m_visibleColumns["Category"])
                 {
-                    categoryOptions = m_projectConfig->GetCategoryOptions(metadata->folderType);
-                    // Debug logging
-                    if (i == 0)  // Only log for first item to avoid spam
+                    ImGui::TableNextColumn();
+
+                    // Get category options from ProjectConfig using the shot's folderType
+                    std::vector<UFB::CategoryOption> categoryOptions;
+                    if (m_projectConfig && !metadata->folderType.empty())
                     {
-          /*              printf("[DEBUG] Shot View - folderType: '%s', categoryOptions.size(): %zu\n",
-                               metadata->folderType.c_str(), categoryOptions.size());*/
+                        categoryOptions = m_projectConfig->GetCategoryOptions(metadata->folderType);
+                        // Debug logging
+                        if (i == 0)  // Only log for first item to avoid spam
+                        {
+              /*              printf("[DEBUG] Shot View - folderType: '%s', categoryOptions.size(): %zu\n",
+                                   metadata->folderType.c_str(), categoryOptions.size());*/
+                        }
                     }
-                }
-                else
-                {
-                    if (i == 0)
+                    else
                     {
-                       /* printf("[DEBUG] Shot View - Cannot get category options. ProjectConfig: %p, folderType: '%s'\n",
-                               (void*)m_projectConfig, metadata->folderType.c_str());*/
+                        if (i == 0)
+                        {
+                           /* printf("[DEBUG] Shot View - Cannot get category options. ProjectConfig: %p, folderType: '%s'\n",
+                                   (void*)m_projectConfig, metadata->folderType.c_str());*/
+                        }
                     }
-                }
 
-                std::string currentCategory = metadata->category;
-                std::string displayCategory = currentCategory.empty() ? "Not Set" : currentCategory;
+                    std::string currentCategory = metadata->category;
+                    std::string displayCategory = currentCategory.empty() ? "Not Set" : currentCategory;
 
-                // Color the combo box button based on category
-                ImVec4 categoryColor = currentCategory.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetCategoryColor(currentCategory);
-                ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
+                    // Color the combo box button based on category
+                    ImVec4 categoryColor = currentCategory.empty() ? ImVec4(0.5f, 0.5f, 0.5f, 1.0f) : GetCategoryColor(currentCategory);
+                    ImGui::PushStyleColor(ImGuiCol_Text, categoryColor);
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(("##category" + std::to_string(i)).c_str(), displayCategory.c_str()))
-                {
-                    if (categoryOptions.empty())
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(("##category" + std::to_string(i)).c_str(), displayCategory.c_str()))
                     {
-                        ImGui::TextDisabled("(No options configured)");
-                    }
-                    else
-                    {
-                        for (const auto& option : categoryOptions)
+                        if (categoryOptions.empty())
                         {
-                            bool isSelected = (currentCategory == option.name);
-                            ImVec4 optionColor = GetCategoryColor(option.name);
-                            ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
-
-                            if (ImGui::Selectable(option.name.c_str(), isSelected))
+                            ImGui::TextDisabled("(No options configured)");
+                        }
+                        else
+                        {
+                            for (const auto& option : categoryOptions)
                             {
-                                metadata->category = option.name;
-                                metadataChanged = true;
-                            }
+                                bool isSelected = (currentCategory == option.name);
+                                ImVec4 optionColor = GetCategoryColor(option.name);
+                                ImGui::PushStyleColor(ImGuiCol_Text, optionColor);
 
-                            ImGui::PopStyleColor();
+                                if (ImGui::Selectable(option.name.c_str(), isSelected))
+                                {
+                                    metadata->category = option.name;
+                                    metadataChanged = true;
+                                }
+
+                                ImGui::PopStyleColor();
 
-                            if (isSelected)
-                                ImGui::SetItemDefaultFocus();
+                                if (isSelected)
+                                    ImGui::SetItemDefaultFocus();
+                            }
                         }
+                        ImGui::EndCombo();
                     }
-                    ImGui::EndCombo();
-                }
 
-                ImGui::PopStyleColor();
-            }
+                    ImGui::PopStyleColor();
+                }
 
-            // Artist column - Editable combo box (from users list)
-            if (m_visibleColumns["Artist"])
-            {
-                ImGui::TableNextColumn();
+                // Artist column - Editable combo box (from users list)
+                if (m_visibleColumns["Artist"])
+                {
+                    ImGui::TableNextColumn();
 
-                // Get users from ProjectConfig
-                std::vector<UFB::User> users;
-                if (m_projectConfig)
-                    users = m_projectConfig->GetUsers();
+                    // Get users from ProjectConfig
+                    std::vector<UFB::User> users;
+                    if (m_projectConfig)
+                        users = m_projectConfig->GetUsers();
 
-                std::string currentArtist = metadata->artist;
-                std::string displayArtist = currentArtist.empty() ? "Not Assigned" : currentArtist;
+                    std::string currentArtist = metadata->artist;
+                    std::string displayArtist = currentArtist.empty() ? "Not Assigned" : currentArtist;
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(("##artist" + std::to_string(i)).c_str(), displayArtist.c_str()))
-                {
-                    // "Not Assigned" option (always available)
-                    if (ImGui::Selectable("Not Assigned", currentArtist.empty()))
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(("##artist" + std::to_string(i)).c_str(), displayArtist.c_str()))
                     {
-                        metadata->artist = "";
-                        metadataChanged = true;
-                    }
+                        // "Not Assigned" option (always available)
+                        if (ImGui::Selectable("Not Assigned", currentArtist.empty()))
+                        {
+                            metadata->artist = "";
+                            metadataChanged = true;
+                        }
 
-                    if (users.empty())
-                    {
-                        ImGui::TextDisabled("(No users configured)");
-                    }
-                    else
-                    {
-                        for (const auto& user : users)
+                        if (users.empty())
                         {
-                            bool isSelected = (currentArtist == user.displayName);
-                            if (ImGui::Selectable(user.displayName.c_str(), isSelected))
+                            ImGui::TextDisabled("(No users configured)");
+                        }
+                        else
+                        {
+                            for (const auto& user : users)
                             {
-                                metadata->artist = user.displayName;
-                                metadataChanged = true;
-                            }
+                                bool isSelected = (currentArtist == user.displayName);
+                                if (ImGui::Selectable(user.displayName.c_str(), isSelected))
+                                {
+                                    metadata->artist = user.displayName;
+                                    metadataChanged = true;
+                                }
 
-                            if (isSelected)
-                                ImGui::SetItemDefaultFocus();
+                                if (isSelected)
+                                    ImGui::SetItemDefaultFocus();
+                            }
                         }
+                        ImGui::EndCombo();
                     }
-                    ImGui::EndCombo();
                 }
-            }
-
-            // Priority column - Editable combo box
-            if (m_visibleColumns["Priority"])
-            {
-                ImGui::TableNextColumn();
 
-                const char* priorityText = (metadata->priority == 1) ? "High" :
-                                          (metadata->priority == 2) ? "Medium" : "Low";
-                ImVec4 priorityColor = (metadata->priority == 1) ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) :
-                                      (metadata->priority == 2) ? ImVec4(1.0f, 0.8f, 0.3f, 1.0f) :
-                                                                 ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
-
-                ImGui::PushStyleColor(ImGuiCol_Text, priorityColor);
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::BeginCombo(("##priority" + std::to_string(i)).c_str(), priorityText))
+                // Priority column - Editable combo box
+                if (m_visibleColumns["Priority"])
                 {
-                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
-                    if (ImGui::Selectable("High", metadata->priority == 1))
-                    {
-                        metadata->priority = 1;
-                        metadataChanged = true;
-                    }
-                    ImGui::PopStyleColor();
+                    ImGui::TableNextColumn();
 
-                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.3f, 1.0f));
-                    if (ImGui::Selectable("Medium", metadata->priority == 2))
-                    {
-                        metadata->priority = 2;
-                        metadataChanged = true;
-                    }
-                    ImGui::PopStyleColor();
+                    const char* priorityText = (metadata->priority == 1) ? "High" :
+                                              (metadata->priority == 2) ? "Medium" : "Low";
+                    ImVec4 priorityColor = (metadata->priority == 1) ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) :
+                                          (metadata->priority == 2) ? ImVec4(1.0f, 0.8f, 0.3f, 1.0f) :
+                                                                     ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
 
-                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
-                    if (ImGui::Selectable("Low", metadata->priority == 3))
+                    ImGui::PushStyleColor(ImGuiCol_Text, priorityColor);
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::BeginCombo(("##priority" + std::to_string(i)).c_str(), priorityText))
                     {
-                        metadata->priority = 3;
-                        metadataChanged = true;
-                    }
-                    ImGui::PopStyleColor();
+                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
+                        if (ImGui::Selectable("High", metadata->priority == 1))
+                        {
+                            metadata->priority = 1;
+                            metadataChanged = true;
+                        }
+                        ImGui::PopStyleColor();
 
-                    ImGui::EndCombo();
-                }
-                ImGui::PopStyleColor();
-            }
+                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.3f, 1.0f));
+                        if (ImGui::Selectable("Medium", metadata->priority == 2))
+                        {
+                            metadata->priority = 2;
+                            metadataChanged = true;
+                        }
+                        ImGui::PopStyleColor();
 
-            // DueDate column - Button to open date picker
-            if (m_visibleColumns["DueDate"])
-            {
-                ImGui::TableNextColumn();
+                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.5f, 0.5f, 1.0f));
+                        if (ImGui::Selectable("Low", metadata->priority == 3))
+                        {
+                            metadata->priority = 3;
+                            metadataChanged = true;
+                        }
+                        ImGui::PopStyleColor();
 
-                std::string dateStr = (metadata->dueDate > 0) ? FormatTimestamp(metadata->dueDate) : "Not Set";
-                ImGui::SetNextItemWidth(-FLT_MIN);
+                        ImGui::EndCombo();
+                    }
+                    ImGui::PopStyleColor();
+                }
 
-                if (ImGui::Button((dateStr + "##duedate" + std::to_string(i)).c_str(), ImVec2(-FLT_MIN, 0)))
+                // DueDate column - Button to open date picker
+                if (m_visibleColumns["DueDate"])
                 {
-                    m_showDatePicker = true;
-                    m_datePickerShotIndex = i;
-                }
+                    ImGui::TableNextColumn();
 
-                if (ImGui::IsItemHovered())
-                    ImGui::SetTooltip("Click to select date");
-            }
+                    std::string dateStr = (metadata->dueDate > 0) ? FormatTimestamp(metadata->dueDate) : "Not Set";
+                    ImGui::SetNextItemWidth(-FLT_MIN);
 
-            // Notes column - Text input
-            if (m_visibleColumns["Notes"])
-            {
-                ImGui::TableNextColumn();
+                    if (ImGui::Button((dateStr + "##duedate" + std::to_string(i)).c_str(), ImVec2(-FLT_MIN, 0)))
+                    {
+                        m_showDatePicker = true;
+                        m_datePickerShotIndex = i;
+                    }
 
-                char noteBuffer[256];
-                strncpy(noteBuffer, metadata->note.c_str(), sizeof(noteBuffer) - 1);
-                noteBuffer[sizeof(noteBuffer) - 1] = '\0';
+                    if (ImGui::IsItemHovered())
+                        ImGui::SetTooltip("Click to select date");
+                }
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                if (ImGui::InputText(("##note" + std::to_string(i)).c_str(), noteBuffer, sizeof(noteBuffer)))
+                // Notes column - Text input
+                if (m_visibleColumns["Notes"])
                 {
-                    metadata->note = noteBuffer;
-                    metadataChanged = true;
-                }
-            }
+                    ImGui::TableNextColumn();
 
-            // Links column - Button (placeholder for now)
-            if (m_visibleColumns["Links"])
-            {
-                ImGui::TableNextColumn();
+                    char noteBuffer[256];
+                    strncpy(noteBuffer, metadata->note.c_str(), sizeof(noteBuffer) - 1);
+                    noteBuffer[sizeof(noteBuffer) - 1] = '\0';
 
-                // Count links from JSON array (simplified for now)
-                int linkCount = 0;
-                if (!metadata->links.empty() && metadata->links != "[]")
-                    linkCount = 1;  // Simplified
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::InputText(("##note" + std::to_string(i)).c_str(), noteBuffer, sizeof(noteBuffer)))
+                    {
+                        metadata->note = noteBuffer;
+                        metadataChanged = true;
+                    }
+                }
 
-                ImGui::SetNextItemWidth(-FLT_MIN);
-                char linkLabel[32];
-                snprintf(linkLabel, sizeof(linkLabel), "Links (%d)##%d", linkCount, i);
-                if (ImGui::SmallButton(linkLabel))
+                // Links column - Button (placeholder for now)
+                if (m_visibleColumns["Links"])
                 {
-                    // TODO: Open links dialog
-                }
-            }
+                    ImGui::TableNextColumn();
 
-            // Save metadata if changed
-            if (metadataChanged && m_subscriptionManager)
-            {
-                // Update timestamps
-                uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::system_clock::now().time_since_epoch()
-                ).count();
+                    // Count links from JSON array (simplified for now)
+                    int linkCount = 0;
+                    if (!metadata->links.empty() && metadata->links != "[]")
+                        linkCount = 1;  // Simplified
 
-                if (metadata->id == 0)  // New metadata
-                {
-                    metadata->createdTime = now;
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    char linkLabel[32];
+                    snprintf(linkLabel, sizeof(linkLabel), "Links (%d)##%d", linkCount, i);
+                    if (ImGui::SmallButton(linkLabel))
+                    {
+                        // TODO: Open links dialog
+                    }
                 }
-                metadata->modifiedTime = now;
 
-                // Save to database
-                if (m_subscriptionManager->CreateOrUpdateShotMetadata(*metadata))
+                // Save metadata if changed
+                if (metadataChanged && m_subscriptionManager)
                 {
-                    // Update cache
-                    m_shotMetadataMap[entry.fullPath] = *metadata;
-                    std::cout << "[ShotView] Saved metadata for: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+                    // Update timestamps
+                    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()
+                    ).count();
+
+                    if (metadata->id == 0)  // New metadata
+                    {
+                        metadata->createdTime = now;
+                    }
+                    metadata->modifiedTime = now;
+
+                    // Save to database
+                    if (m_subscriptionManager->CreateOrUpdateShotMetadata(*metadata))
+                    {
+                        // Update cache
+                        m_shotMetadataMap[entry.fullPath] = *metadata;
+                        m_shotRowsDirty = true;
+                        std::cout << "[ShotView] Saved metadata for: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+                    }
+                    else
+                    {
+                        std::cerr << "[ShotView] Failed to save metadata for: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+                    }
                 }
-                else
+
+                // Size column - total of everything below the shot folder
+                if (m_visibleColumns["Size"])
                 {
-                    std::cerr << "[ShotView] Failed to save metadata for: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
+                    ImGui::TableNextColumn();
+                    ImGui::TextDisabled("%s", shotRow.size.c_str());
+
+                    auto usageIt = m_shotUsage.find(entry.fullPath);
+                    if (usageIt != m_shotUsage.end() && ImGui::IsItemHovered())
+                    {
+                        const UFB::FolderUsage& usage = usageIt->second;
+                        std::string newest = usage.newestWriteTime > 0
+                            ? FormatFileTime(std::filesystem::file_time_type(std::filesystem::file_time_type::duration(
+                                  static_cast<int64_t>(usage.newestWriteTime))))
+                            : "-";
+                        ImGui::SetTooltip("%llu files in %llu folders\nNewest file: %s",
+                                          static_cast<unsigned long long>(usage.totalFiles),
+                                          static_cast<unsigned long long>(usage.totalFolders + 1), newest.c_str());
+                    }
                 }
-            }
 
-            // Modified date column (always last)
-            ImGui::TableNextColumn();
-            ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
+                // Modified date column (always last)
+                ImGui::TableNextColumn();
+                ImGui::TextDisabled("%s", shotRow.modified.c_str());
 
-            // Pop mono font that was pushed for metadata columns
-            if (font_mono)
-                ImGui::PopFont();
+                // Pop mono font that was pushed for metadata columns
+                if (font_mono)
+                    ImGui::PopFont();
 
-            ImGui::PopID();
+                ImGui::PopID();
+            }
         }
 
         ImGui::EndTable();
+        RunPendingReloads();
     }
 
     // Pop the style variable for cell padding
@@ -1817,6 +1999,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                         if (m_subscriptionManager->CreateOrUpdateShotMetadata(metadata))
                         {
                             m_shotMetadataMap[entry.fullPath] = metadata;
+                            m_shotRowsDirty = true;
                             std::cout << "[ShotView] Updated due date for: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
                         }
                     }
@@ -1840,6 +2023,7 @@ void ShotView::DrawShotsPanel(HWND hwnd)
                         if (m_subscriptionManager->CreateOrUpdateShotMetadata(metadata))
                         {
                             m_shotMetadataMap[entry.fullPath] = metadata;
+                            m_shotRowsDirty = true;
                             std::cout << "[ShotView] Cleared due date for: " << UFB::WideToUtf8(entry.fullPath) << std::endl;
                         }
                     }
@@ -2008,110 +2192,118 @@ void ShotView::DrawProjectsPanel(HWND hwnd)
             }
         }
 
-        for (int i = 0; i < m_projectFiles.size(); i++)
-        {
-            const FileEntry& entry = m_projectFiles[i];
+        // Only the visible rows are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_projectFiles.size()));
 
-            ImGui::TableNextRow();
-            ImGui::TableNextColumn();
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+            {
+                const FileEntry& entry = m_projectFiles[i];
 
-            ImGui::PushID(1000 + i);  // Offset to avoid ID conflicts
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
 
-            // Get icon
-            ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, false);
+                ImGui::PushID(1000 + i);  // Offset to avoid ID conflicts
 
-            // Draw icon
-            if (icon)
-            {
-                ImGui::Image(icon, ImVec2(16, 16));
-                ImGui::SameLine();
-            }
+                // Get icon
+                ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, false);
 
-            // Convert name to UTF-8
-            char nameUtf8[512];
-            WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, nameUtf8, sizeof(nameUtf8), nullptr, nullptr);
+                // Draw icon
+                if (icon)
+                {
+                    ImGui::Image(icon, ImVec2(16, 16));
+                    ImGui::SameLine();
+                }
 
-            bool isSelected = m_selectedProjectIndices.find(i) != m_selectedProjectIndices.end();
-            if (ImGui::Selectable(nameUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap))
-            {
-                // Handle multi-select
-                bool ctrlPressed = ImGui::GetIO().KeyCtrl;
-                bool shiftPressed = ImGui::GetIO().KeyShift;
+                // Convert name to UTF-8
+                char nameUtf8[512];
+                WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, nameUtf8, sizeof(nameUtf8), nullptr, nullptr);
 
-                if (ctrlPressed)
+                bool isSelected = m_selectedProjectIndices.find(i) != m_selectedProjectIndices.end();
+                if (ImGui::Selectable(nameUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap))
                 {
-                    // Ctrl+Click: toggle selection
-                    if (isSelected)
-                        m_selectedProjectIndices.erase(i);
+                    // Handle multi-select
+                    bool ctrlPressed = ImGui::GetIO().KeyCtrl;
+                    bool shiftPressed = ImGui::GetIO().KeyShift;
+
+                    if (ctrlPressed)
+                    {
+                        // Ctrl+Click: toggle selection
+                        if (isSelected)
+                            m_selectedProjectIndices.erase(i);
+                        else
+                            m_selectedProjectIndices.insert(i);
+                    }
+                    else if (shiftPressed && m_lastClickedProjectIndex != -1)
+                    {
+                        // Shift+Click: range select
+                        int start = (std::min)(m_lastClickedProjectIndex, i);
+                        int end = (std::max)(m_lastClickedProjectIndex, i);
+                        for (int idx = start; idx <= end; ++idx)
+                        {
+                            m_selectedProjectIndices.insert(idx);
+                        }
+                    }
                     else
-                        m_selectedProjectIndices.insert(i);
-                }
-                else if (shiftPressed && m_lastClickedProjectIndex != -1)
-                {
-                    // Shift+Click: range select
-                    int start = (std::min)(m_lastClickedProjectIndex, i);
-                    int end = (std::max)(m_lastClickedProjectIndex, i);
-                    for (int idx = start; idx <= end; ++idx)
                     {
-                        m_selectedProjectIndices.insert(idx);
+                        // Normal click: select only this item
+                        m_selectedProjectIndices.clear();
+                        m_selectedProjectIndices.insert(i);
+
+                        // Double-click detection
+                        double currentTime = glfwGetTime();
+                        if (m_lastClickedProjectIndex == i && (currentTime - m_lastProjectClickTime) < 0.3)
+                        {
+                            // Double-clicked - open file
+                            ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                        }
+                        m_lastProjectClickTime = currentTime;
                     }
+
+                    m_lastClickedProjectIndex = i;
                 }
-                else
-                {
-                    // Normal click: select only this item
-                    m_selectedProjectIndices.clear();
-                    m_selectedProjectIndices.insert(i);
 
-                    // Double-click detection
-                    double currentTime = glfwGetTime();
-                    if (m_lastClickedProjectIndex == i && (currentTime - m_lastProjectClickTime) < 0.3)
+                // Context menu
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
+                {
+                    // If right-clicked item is not in selection, select only it
+                    if (!isSelected)
                     {
-                        // Double-clicked - open file
-                        ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                        m_selectedProjectIndices.clear();
+                        m_selectedProjectIndices.insert(i);
                     }
-                    m_lastProjectClickTime = currentTime;
+                    ImGui::OpenPopup("project_context_menu");
                 }
 
-                m_lastClickedProjectIndex = i;
-            }
+                ShowImGuiContextMenu(hwnd, entry, PanelType::Projects);
 
-            // Context menu
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
-            {
-                // If right-clicked item is not in selection, select only it
-                if (!isSelected)
+                // Middle-click to open in new window
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
                 {
-                    m_selectedProjectIndices.clear();
-                    m_selectedProjectIndices.insert(i);
+                    if (onOpenInNewWindow)
+                    {
+                        std::filesystem::path targetPath(entry.fullPath);
+                        std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
+                        onOpenInNewWindow(pathToOpen);
+                    }
                 }
-                ImGui::OpenPopup("project_context_menu");
-            }
 
-            ShowImGuiContextMenu(hwnd, entry, PanelType::Projects);
+                // Modified column
+                ImGui::TableNextColumn();
+                if (font_mono)
+                    ImGui::PushFont(font_mono);
+                ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
+                if (font_mono)
+                    ImGui::PopFont();
 
-            // Middle-click to open in new window
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
-            {
-                if (onOpenInNewWindow)
-                {
-                    std::filesystem::path targetPath(entry.fullPath);
-                    std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
-                    onOpenInNewWindow(pathToOpen);
-                }
+                ImGui::PopID();
             }
-
-            // Modified column
-            ImGui::TableNextColumn();
-            if (font_mono)
-                ImGui::PushFont(font_mono);
-            ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
-            if (font_mono)
-                ImGui::PopFont();
-
-            ImGui::PopID();
         }
 
         ImGui::EndTable();
+        RunPendingReloads();
     }
 
     ImGui::EndChild();  // End nested child window for projects panel
@@ -2148,6 +2340,9 @@ void ShotView::DrawRendersPanel(HWND hwnd)
 
     ImGui::BeginChild("##renders_content", contentSize, false, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
 
+    // Apply render listing batches from the background enumerator
+    PollRenderListing();
+
     ImGui::Text("Renders / Outputs");
 
     // Navigation buttons
@@ -2263,6 +2458,13 @@ void ShotView::DrawRendersPanel(HWND hwnd)
     if (ImGui::IsItemHovered())
         ImGui::SetTooltip("Refresh");
 
+    // Directory still being read (slow shares)
+    if (m_renderEnumerator.IsBusy())
+    {
+        ImGui::SameLine();
+        ImGui::TextDisabled("Loading...");
+    }
+
     // Show current path
     if (!m_renderCurrentDirectory.empty())
     {
@@ -2322,205 +2524,213 @@ void ShotView::DrawRendersPanel(HWND hwnd)
             }
         }
 
-        for (int i = 0; i < m_renderFiles.size(); i++)
-        {
-            const FileEntry& entry = m_renderFiles[i];
+        // Only the visible rows are drawn (render folders can hold thousands of files)
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_renderFiles.size()));
 
-            ImGui::TableNextRow();
-            ImGui::TableNextColumn();
+        while (clipper.Step())
+        {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+            {
+                const FileEntry& entry = m_renderFiles[i];
 
-            ImGui::PushID(2000 + i);  // Offset to avoid ID conflicts
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
 
-            // Get icon
-            ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, false);
+                ImGui::PushID(2000 + i);  // Offset to avoid ID conflicts
 
-            // Draw icon
-            if (icon)
-            {
-                ImGui::Image(icon, ImVec2(16, 16));
-                ImGui::SameLine();
-            }
+                // Get icon
+                ImTextureID icon = m_iconManager.GetFileIcon(entry.fullPath, false);
 
-            // Convert name to UTF-8
-            char nameUtf8[512];
-            WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, nameUtf8, sizeof(nameUtf8), nullptr, nullptr);
+                // Draw icon
+                if (icon)
+                {
+                    ImGui::Image(icon, ImVec2(16, 16));
+                    ImGui::SameLine();
+                }
 
-            bool isSelected = (m_selectedRenderIndices.find(i) != m_selectedRenderIndices.end());
+                // Convert name to UTF-8
+                char nameUtf8[512];
+                WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, nameUtf8, sizeof(nameUtf8), nullptr, nullptr);
 
-            // Use accent color for selected items
-            ImVec4 accentColor = GetAccentColor();
-            if (isSelected)
-            {
-                ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
-                ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
-                ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
-            }
+                bool isSelected = (m_selectedRenderIndices.find(i) != m_selectedRenderIndices.end());
 
-            if (ImGui::Selectable(nameUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap))
-            {
-                // Handle multi-select with Ctrl/Shift
-                if (ImGui::GetIO().KeyCtrl)
+                // Use accent color for selected items
+                ImVec4 accentColor = GetAccentColor();
+                if (isSelected)
                 {
-                    // Ctrl+Click: toggle selection
-                    if (isSelected)
-                        m_selectedRenderIndices.erase(i);
-                    else
-                        m_selectedRenderIndices.insert(i);
+                    ImGui::PushStyleColor(ImGuiCol_Header, accentColor);
+                    ImGui::PushStyleColor(ImGuiCol_HeaderHovered, ImVec4(accentColor.x * 1.1f, accentColor.y * 1.1f, accentColor.z * 1.1f, accentColor.w));
+                    ImGui::PushStyleColor(ImGuiCol_HeaderActive, ImVec4(accentColor.x * 1.2f, accentColor.y * 1.2f, accentColor.z * 1.2f, accentColor.w));
                 }
-                else if (ImGui::GetIO().KeyShift && !m_selectedRenderIndices.empty())
+
+                if (ImGui::Selectable(nameUtf8, isSelected, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap))
                 {
-                    // Shift+Click: select range
-                    int minIdx = *m_selectedRenderIndices.begin();
-                    int maxIdx = *m_selectedRenderIndices.rbegin();
-                    int rangeStart = (std::min)({i, minIdx, maxIdx});
-                    int rangeEnd = (std::max)({i, minIdx, maxIdx});
-                    m_selectedRenderIndices.clear();
-                    for (int idx = rangeStart; idx <= rangeEnd; idx++)
+                    // Handle multi-select with Ctrl/Shift
+                    if (ImGui::GetIO().KeyCtrl)
                     {
-                        m_selectedRenderIndices.insert(idx);
+                        // Ctrl+Click: toggle selection
+                        if (isSelected)
+                            m_selectedRenderIndices.erase(i);
+                        else
+                            m_selectedRenderIndices.insert(i);
                     }
-                }
-                else
-                {
-                    // Regular click: clear selection and select this item
-                    m_selectedRenderIndices.clear();
-                    m_selectedRenderIndices.insert(i);
-                }
-
-                // Double-click detection
-                double currentTime = glfwGetTime();
-                if (m_lastClickedRenderIndex == i && (currentTime - m_lastClickTime) < 0.3)
-                {
-                    // Double-clicked
-                    if (entry.isDirectory)
+                    else if (ImGui::GetIO().KeyShift && !m_selectedRenderIndices.empty())
                     {
-                        // Navigate into folder
-                        NavigateToRenderDirectory(entry.fullPath);
+                        // Shift+Click: select range
+                        int minIdx = *m_selectedRenderIndices.begin();
+                        int maxIdx = *m_selectedRenderIndices.rbegin();
+                        int rangeStart = (std::min)({i, minIdx, maxIdx});
+                        int rangeEnd = (std::max)({i, minIdx, maxIdx});
+                        m_selectedRenderIndices.clear();
+                        for (int idx = rangeStart; idx <= rangeEnd; idx++)
+                        {
+                            m_selectedRenderIndices.insert(idx);
+                        }
                     }
                     else
                     {
-                        // Open file
-                        ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                        // Regular click: clear selection and select this item
+                        m_selectedRenderIndices.clear();
+                        m_selectedRenderIndices.insert(i);
+                    }
+
+                    // Double-click detection
+                    double currentTime = glfwGetTime();
+                    if (m_lastClickedRenderIndex == i && (currentTime - m_lastClickTime) < 0.3)
+                    {
+                        // Double-clicked
+                        if (entry.isDirectory)
+                        {
+                            // Navigate into folder (after the table, the rows still point into m_renderFiles)
+                            m_pendingRenderDirectory = entry.fullPath;
+                        }
+                        else
+                        {
+                            // Open file
+                            ShellExecuteW(nullptr, L"open", entry.fullPath.c_str(), nullptr, nullptr, SW_SHOW);
+                        }
                     }
+                    m_lastClickTime = currentTime;
+                    m_lastClickedRenderIndex = i;
                 }
-                m_lastClickTime = currentTime;
-                m_lastClickedRenderIndex = i;
-            }
 
-            if (isSelected)
-            {
-                ImGui::PopStyleColor(3);
-            }
+                if (isSelected)
+                {
+                    ImGui::PopStyleColor(3);
+                }
 
-            // Drag source for file/folder (supports multi-select)
-            static bool transitionedToOLEDrag = false;
+                // Drag source for file/folder (supports multi-select)
+                static bool transitionedToOLEDrag = false;
 
-            if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
-            {
-                if (!transitionedToOLEDrag)
+                if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
                 {
-                    // Build list of file paths for drag operation
-                    std::vector<std::wstring> filePaths;
-
-                    // If this item is part of selection, drag all selected items
-                    if (m_selectedRenderIndices.find(i) != m_selectedRenderIndices.end())
+                    if (!transitionedToOLEDrag)
                     {
-                        for (int idx : m_selectedRenderIndices)
+                        // Build list of file paths for drag operation
+                        std::vector<std::wstring> filePaths;
+
+                        // If this item is part of selection, drag all selected items
+                        if (m_selectedRenderIndices.find(i) != m_selectedRenderIndices.end())
                         {
-                            if (idx < m_renderFiles.size())
+                            for (int idx : m_selectedRenderIndices)
                             {
-                                filePaths.push_back(m_renderFiles[idx].fullPath);
+                                if (idx < m_renderFiles.size())
+                                {
+                                    UFB::AppendEntryPaths(m_renderFiles[idx], filePaths);
+                                }
                             }
                         }
-                    }
-                    else
-                    {
-                        // Not selected - drag just this one
-                        filePaths.push_back(entry.fullPath);
-                    }
-
-                    // Check if mouse has left the main window (HWND) - if so, start Windows OLE drag
-                    POINT cursorPos;
-                    GetCursorPos(&cursorPos);
+                        else
+                        {
+                            // Not selected - drag just this one
+                            UFB::AppendEntryPaths(entry, filePaths);
+                        }
 
-                    RECT windowRect;
-                    GetWindowRect(hwnd, &windowRect);
+                        // Check if mouse has left the main window (HWND) - if so, start Windows OLE drag
+                        POINT cursorPos;
+                        GetCursorPos(&cursorPos);
 
-                    bool mouseOutsideHWND = !PtInRect(&windowRect, cursorPos);
+                        RECT windowRect;
+                        GetWindowRect(hwnd, &windowRect);
 
-                    if (mouseOutsideHWND && !filePaths.empty())
-                    {
-                        transitionedToOLEDrag = true;
-                        ImGui::EndDragDropSource();
+                        bool mouseOutsideHWND = !PtInRect(&windowRect, cursorPos);
 
-                        // Start Windows native drag and drop
-                        StartWindowsDragDrop(filePaths);
-                    }
-                    else
-                    {
-                        // Show drag preview
-                        char dragPreviewUtf8[512];
-                        if (filePaths.size() > 1)
+                        if (mouseOutsideHWND && !filePaths.empty())
                         {
-                            snprintf(dragPreviewUtf8, sizeof(dragPreviewUtf8), "%zu files", filePaths.size());
+                            transitionedToOLEDrag = true;
+                            ImGui::EndDragDropSource();
+
+                            // Start Windows native drag and drop
+                            StartWindowsDragDrop(filePaths);
                         }
                         else
                         {
-                            WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, dragPreviewUtf8, sizeof(dragPreviewUtf8), nullptr, nullptr);
-                        }
-                        ImGui::Text("%s", dragPreviewUtf8);
+                            // Show drag preview
+                            char dragPreviewUtf8[512];
+                            if (filePaths.size() > 1)
+                            {
+                                snprintf(dragPreviewUtf8, sizeof(dragPreviewUtf8), "%zu files", filePaths.size());
+                            }
+                            else
+                            {
+                                WideCharToMultiByte(CP_UTF8, 0, entry.name.c_str(), -1, dragPreviewUtf8, sizeof(dragPreviewUtf8), nullptr, nullptr);
+                            }
+                            ImGui::Text("%s", dragPreviewUtf8);
 
+                            ImGui::EndDragDropSource();
+                        }
+                    }
+                    else
+                    {
                         ImGui::EndDragDropSource();
                     }
                 }
-                else
+
+                if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
                 {
-                    ImGui::EndDragDropSource();
+                    transitionedToOLEDrag = false;
                 }
-            }
 
-            if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
-            {
-                transitionedToOLEDrag = false;
-            }
-
-            // Context menu
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
-            {
-                // If right-clicked item is not in selection, select only it
-                if (!isSelected)
+                // Context menu
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Right))
                 {
-                    m_selectedRenderIndices.clear();
-                    m_selectedRenderIndices.insert(i);
+                    // If right-clicked item is not in selection, select only it
+                    if (!isSelected)
+                    {
+                        m_selectedRenderIndices.clear();
+                        m_selectedRenderIndices.insert(i);
+                    }
+                    ImGui::OpenPopup("render_context_menu");
                 }
-                ImGui::OpenPopup("render_context_menu");
-            }
 
-            ShowImGuiContextMenu(hwnd, entry, PanelType::Renders);
+                ShowImGuiContextMenu(hwnd, entry, PanelType::Renders);
 
-            // Middle-click to open in new window
-            if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
-            {
-                if (onOpenInNewWindow)
+                // Middle-click to open in new window
+                if (ImGui::IsItemClicked(ImGuiMouseButton_Middle))
                 {
-                    std::filesystem::path targetPath(entry.fullPath);
-                    std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
-                    onOpenInNewWindow(pathToOpen);
+                    if (onOpenInNewWindow)
+                    {
+                        std::filesystem::path targetPath(entry.fullPath);
+                        std::wstring pathToOpen = entry.isDirectory ? entry.fullPath : targetPath.parent_path().wstring();
+                        onOpenInNewWindow(pathToOpen);
+                    }
                 }
-            }
 
-            // Modified column
-            ImGui::TableNextColumn();
-            if (font_mono)
-                ImGui::PushFont(font_mono);
-            ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
-            if (font_mono)
-                ImGui::PopFont();
+                // Modified column
+                ImGui::TableNextColumn();
+                if (font_mono)
+                    ImGui::PushFont(font_mono);
+                ImGui::TextDisabled("%s", FormatFileTime(entry.lastModified).c_str());
+                if (font_mono)
+                    ImGui::PopFont();
 
-            ImGui::PopID();
+                ImGui::PopID();
+            }
         }
 
         ImGui::EndTable();
+        RunPendingReloads();
     }
 
     ImGui::EndChild();  // End nested child window for renders panel
@@ -2589,14 +2799,14 @@ void ShotView::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry, PanelType
                 {
                     if (idx >= 0 && idx < m_renderFiles.size())
                     {
-                        paths.push_back(m_renderFiles[idx].fullPath);
+                        UFB::AppendEntryPaths(m_renderFiles[idx], paths);
                     }
                 }
             }
             else
             {
                 // Fallback: copy just this file
-                paths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, paths);
             }
 
             CopyFilesToClipboard(paths);
@@ -2625,14 +2835,14 @@ void ShotView::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry, PanelType
                 {
                     if (idx >= 0 && idx < m_renderFiles.size())
                     {
-                        paths.push_back(m_renderFiles[idx].fullPath);
+                        UFB::AppendEntryPaths(m_renderFiles[idx], paths);
                     }
                 }
             }
             else
             {
                 // Fallback: cut just this file
-                paths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, paths);
             }
 
             CutFilesToClipboard(paths);
@@ -2867,8 +3077,8 @@ void ShotView::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry, PanelType
 
         ImGui::Separator();
 
-        // Rename
-        if (ImGui::MenuItem("Rename"))
+        // Rename (not for collapsed sequences - that would rename only the first frame)
+        if (ImGui::MenuItem("Rename", nullptr, false, !entry.IsSequence()))
         {
             m_showRenameDialog = true;
             m_renameOriginalPath = entry.fullPath;
@@ -2921,6 +3131,7 @@ void ShotView::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry, PanelType
 
                 // Update local map
                 m_shotMetadataMap[entry.fullPath] = shotMeta;
+                m_shotRowsDirty = true;
             }
 
             ImGui::PopStyleColor();
@@ -2989,14 +3200,14 @@ void ShotView::ShowImGuiContextMenu(HWND hwnd, const FileEntry& entry, PanelType
                 {
                     if (idx >= 0 && idx < m_renderFiles.size())
                     {
-                        paths.push_back(m_renderFiles[idx].fullPath);
+                        UFB::AppendEntryPaths(m_renderFiles[idx], paths);
                     }
                 }
             }
             else
             {
                 // Fallback: delete just this file
-                paths.push_back(entry.fullPath);
+                UFB::AppendEntryPaths(entry, paths);
             }
 
             DeleteFilesToRecycleBin(paths);
@@ -3100,6 +3311,7 @@ void ShotView::PasteFilesFromClipboard()
         UINT fileCount = DragQueryFileW(hDrop, 0xFFFFFFFF, nullptr, 0);
 
         std::wstring sourceFiles;
+        std::vector<std::wstring> sourcePaths;
         for (UINT i = 0; i < fileCount; i++)
         {
             wchar_t filePath[MAX_PATH];
@@ -3107,30 +3319,36 @@ void ShotView::PasteFilesFromClipboard()
             {
                 sourceFiles += filePath;
                 sourceFiles += L'\0';
+                sourcePaths.push_back(filePath);
             }
         }
         sourceFiles += L'\0';
 
-        SHFILEOPSTRUCTW fileOp = {};
-        fileOp.wFunc = FO_COPY;
-        fileOp.pFrom = sourceFiles.c_str();
-        fileOp.pTo = targetDir.c_str();
-        fileOp.fFlags = FOF_ALLOWUNDO | FOF_NOCONFIRMMKDIR;
-
-        int result = SHFileOperationW(&fileOp);
-        if (result == 0 && !m_cutFiles.empty())
+        if (onCopyFiles)
         {
-            DeleteFilesToRecycleBin(m_cutFiles);
+            // Queued on the copy engine (cut + paste is a move)
+            onCopyFiles(sourcePaths, targetDir, !m_cutFiles.empty());
             m_cutFiles.clear();
         }
-
-        // Refresh file lists
-        RefreshShots();
-        if (!m_selectedShotPath.empty())
+        else
         {
-            RefreshProjectFiles();
-            RefreshRenderFiles();
+            SHFILEOPSTRUCTW fileOp = {};
+            fileOp.wFunc = FO_COPY;
+            fileOp.pFrom = sourceFiles.c_str();
+            fileOp.pTo = targetDir.c_str();
+            fileOp.fFlags = FOF_ALLOWUNDO | FOF_NOCONFIRMMKDIR;
+
+            int result = SHFileOperationW(&fileOp);
+            if (result == 0 && !m_cutFiles.empty())
+            {
+                DeleteFilesToRecycleBin(m_cutFiles);
+                m_cutFiles.clear();
+            }
         }
+
+        // Refresh file lists once the table being drawn has ended
+        m_reloadShotsPending = true;
+        m_reloadShotFilesPending = true;
     }
 
     CloseClipboard();
@@ -3165,13 +3383,9 @@ void ShotView::DeleteFilesToRecycleBin(const std::vector<std::wstring>& paths)
     int result = SHFileOperationW(&fileOp);
     if (result == 0)
     {
-        // Refresh file lists
-        RefreshShots();
-        if (!m_selectedShotPath.empty())
-        {
-            RefreshProjectFiles();
-            RefreshRenderFiles();
-        }
+        // Refresh file lists once the table being drawn has ended
+        m_reloadShotsPending = true;
+        m_reloadShotFilesPending = true;
     }
 }
 
@@ -3340,6 +3554,9 @@ void ShotView::LoadMetadata()
 
     // Collect available filter values from metadata
     CollectAvailableFilterValues();
+
+    // Filtered rows depend on metadata
+    m_shotRowsDirty = true;
 }
 
 void ShotView::ReloadMetadata()
@@ -3423,6 +3640,7 @@ void ShotView::LoadColumnVisibility()
     m_visibleColumns["DueDate"] = (displayMetadata.count("DueDate") > 0) ? displayMetadata["DueDate"] : false;
     m_visibleColumns["Notes"] = (displayMetadata.count("Notes") > 0) ? displayMetadata["Notes"] : false;
     m_visibleColumns["Links"] = (displayMetadata.count("Links") > 0) ? displayMetadata["Links"] : false;
+    m_visibleColumns["Size"] = (displayMetadata.count("Size") > 0) ? displayMetadata["Size"] : false;
 
     // Log the loaded column visibility
     std::cout << "[ShotView] Column visibility for " << folderType << ":" << std::endl;
@@ -3433,6 +3651,7 @@ void ShotView::LoadColumnVisibility()
     std::cout << "  DueDate: " << m_visibleColumns["DueDate"] << std::endl;
     std::cout << "  Notes: " << m_visibleColumns["Notes"] << std::endl;
     std::cout << "  Links: " << m_visibleColumns["Links"] << std::endl;
+    std::cout << "  Size: " << m_visibleColumns["Size"] << std::endl;
 
     // Force flush to ensure we see the output
     std::cout.flush();
@@ -3788,3 +4007,74 @@ bool ShotView::PassesFilters(const FileEntry& entry)
 
     return true;
 }
+
+void ShotView::RebuildShotRows()
+{
+    m_shotRows.clear();
+    m_shotRows.reserve(m_shots.size());
+
+    for (int i = 0; i < static_cast<int>(m_shots.size()); i++)
+    {
+        const FileEntry& entry = m_shots[i];
+        if (!PassesFilters(entry))
+            continue;
+
+        ShotRow row;
+        row.index = i;
+        row.name = UFB::WideToUtf8(entry.name);
+        row.modified = FormatFileTime(entry.lastModified);
+
+        auto usageIt = m_shotUsage.find(entry.fullPath);
+        if (usageIt != m_shotUsage.end())
+            row.size = FormatFileSize(usageIt->second.totalSize);
+        else
+            row.size = "-";
+
+        m_shotRows.push_back(std::move(row));
+    }
+
+    m_shotRowsDirty = false;
+    m_shotRowsBuiltTime = glfwGetTime();
+}
+
+void ShotView::RunPendingReloads()
+{
+    if (m_reloadShotsPending)
+    {
+        m_reloadShotsPending = false;
+        RefreshShots();
+    }
+
+    if (m_reloadShotFilesPending)
+    {
+        m_reloadShotFilesPending = false;
+        if (!m_selectedShotPath.empty())
+        {
+            RefreshProjectFiles();
+            RefreshRenderFiles();
+        }
+    }
+
+    if (!m_pendingRenderDirectory.empty())
+    {
+        std::wstring directory = std::move(m_pendingRenderDirectory);
+        m_pendingRenderDirectory.clear();
+        NavigateToRenderDirectory(directory);
+    }
+}
+
+void ShotView::RefreshShotUsage()
+{
+    uint64_t version = storageAnalyzer->GetVersion();
+    if (version == m_shotUsageVersion)
+        return;
+
+    std::vector<std::wstring> shotPaths;
+    shotPaths.reserve(m_shots.size());
+    for (const auto& shot : m_shots)
+        shotPaths.push_back(shot.fullPath);
+
+    m_shotUsage = storageAnalyzer->GetUsage(shotPaths);
+    m_shotUsageVersion = version;
+    m_shotRowsDirty = true;
+}
@@ -10,6 +10,8 @@
 #include "imgui.h"
 #include "icon_manager.h"
 #include "thumbnail_manager.h"
+#include "directory_enumerator.h"
+#include "storage_analyzer.h"
 
 // Forward declarations
 namespace UFB {
@@ -20,7 +22,7 @@ namespace UFB {
     struct ShotMetadata;
 }
 
-struct FileEntry;  // Use same FileEntry from file_browser.h
+struct FileEntry;  // Use same FileEntry from file_entry.h
 
 class ShotView
 {
@@ -64,6 +66,9 @@ public:
     // Callback for transcoding video files
     std::function<void(const std::vector<std::wstring>&)> onTranscodeToMP4;
 
+    // Callback for copying/moving files into a folder (queued on the copy engine; SHFileOperation when unset)
+    std::function<void(const std::vector<std::wstring>& sources, const std::wstring& destDirectory, bool move)> onCopyFiles;
+
     // Callback for submitting .blend files to Deadline
     std::function<void(const std::wstring& blendFilePath, const std::wstring& jobName)> onSubmitToDeadline;
 
@@ -75,6 +80,9 @@ public:
     // Public settings (share with FileBrowser)
     static bool showHiddenFiles;
 
+    // Folder sizes for the Size column (set by main)
+    static UFB::StorageAnalyzer* storageAnalyzer;
+
 private:
     // Category path and name
     std::wstring m_categoryPath;     // e.g., "D:\Projects\MyJob\ae"
@@ -105,13 +113,29 @@ private:
     std::vector<std::wstring> m_renderForwardHistory;
     bool m_isNavigatingRenderHistory = false;
 
+    // Background listing of the renders panel (render folders can hold thousands of frames)
+    UFB::DirectoryEnumerator m_renderEnumerator;
+    std::vector<FileEntry> m_pendingRenderEntries;  // Listing being read
+    std::wstring m_renderListedDirectory;           // Directory m_renderFiles belongs to
+    std::wstring m_pendingRenderSelectPath;         // File to select once the render listing completes
+    bool m_streamingRenderListing = false;          // New directory is shown batch by batch while it loads
+    uint64_t m_renderListedVersion = 0;             // UFB::DirectoryCache version of m_renderFiles
+    uint64_t m_renderReadVersion = 0;               // Version when the current read started
+    double m_lastRenderAutoRefreshTime = 0.0;       // Throttles re-reads triggered by the directory watcher
+
     // Window state
     bool m_isOpen = true;
 
     // Refresh file lists
     void RefreshShots();
     void RefreshProjectFiles();
-    void RefreshRenderFiles();
+    void RefreshRenderFiles();  // Starts a background read; PollRenderListing() applies it
+
+    // Apply render listing batches from the background enumerator (main thread, each frame)
+    void PollRenderListing();
+
+    // Collapse sequences and sort m_renderFiles after it has been replaced
+    void FinishRenderFiles();
 
     // Navigation methods for renders panel
     void NavigateToRenderDirectory(const std::wstring& path);
@@ -194,6 +218,9 @@ private:
     // Metadata management
     std::map<std::wstring, UFB::ShotMetadata> m_shotMetadataMap;  // Shot metadata cache (by shot path)
     std::map<std::string, bool> m_visibleColumns;                 // Column visibility for current category
+    std::map<std::wstring, UFB::FolderUsage> m_shotUsage;         // Disk usage by shot path (Size column)
+    uint64_t m_shotUsageVersion = UINT64_MAX;                     // StorageAnalyzer version of m_shotUsage (MAX: stale)
+    void RefreshShotUsage();                                      // Re-read m_shotUsage when the analyzer has new results
     bool m_showColumnsPopup = false;                              // Show columns filter popup
 
     // Panel window positions and sizes (for focus highlighting)
@@ -232,4 +259,26 @@ private:
     // Filter helpers
     void CollectAvailableFilterValues();           // Collect unique values from metadata
     bool PassesFilters(const FileEntry& entry);    // Check if entry passes all active filters
+
+    // Shots table rows that pass the filters, in m_shots order, with their display strings
+    // Rebuilt only when shots, metadata, filters or sort order change; the table draws only the
+    // visible ones through ImGuiListClipper
+    struct ShotRow
+    {
+        int index = 0;          // Index into m_shots
+        std::string name;       // UTF-8 name
+        std::string modified;   // Formatted modification time
+        std::string size;       // Formatted disk usage (Size column)
+    };
+    std::vector<ShotRow> m_shotRows;
+    bool m_shotRowsDirty = true;
+    double m_shotRowsBuiltTime = 0.0;
+    void RebuildShotRows();
+
+    // List reloads requested while a table's rows are being drawn (context menu actions, double-click
+    // into a render folder) wait here until the table has ended, so a row loop never sees its list replaced
+    bool m_reloadShotsPending = false;
+    bool m_reloadShotFilesPending = false;      // Project and render files of the selected shot
+    std::wstring m_pendingRenderDirectory;      // Render folder to enter
+    void RunPendingReloads();
 };
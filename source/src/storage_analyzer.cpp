@@ -0,0 +1,606 @@
+#include "storage_analyzer.h"
+#include "subscription_manager.h"
+#include "utils.h"
+#include <windows.h>
+#include <sqlite3.h>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+#include <memory>
+#include <cwctype>
+
+namespace UFB {
+
+namespace {
+
+// Unforced scan requests are ignored this long after the job was last scanned
+constexpr auto kMinRescanInterval = std::chrono::minutes(10);
+
+uint64_t FileTimeTicks(const FILETIME& time)
+{
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+std::wstring JoinPath(const std::wstring& folder, const std::wstring& name)
+{
+    if (!folder.empty() && folder.back() != L'\\' && folder.back() != L'/')
+        return folder + L'\\' + name;
+    return folder + name;
+}
+
+// Backslashes, no trailing separator ("C:\" stays as is)
+std::wstring NormalizePath(std::wstring path)
+{
+    std::replace(path.begin(), path.end(), L'/', L'\\');
+    while (path.size() > 3 && path.back() == L'\\')
+        path.pop_back();
+    return path;
+}
+
+std::wstring PathKey(const std::wstring& path)
+{
+    std::wstring key = NormalizePath(path);
+    for (auto& c : key)
+        c = static_cast<wchar_t>(std::towlower(c));
+    return key;
+}
+
+// Bounds of the rows below a folder: path > lower and path < upper ("job\" .. "job]", ']' follows '\')
+void SubtreeRange(const std::wstring& folder, std::string& outLower, std::string& outUpper)
+{
+    std::wstring prefix = folder;
+    if (prefix.back() != L'\\')
+        prefix += L'\\';
+    outLower = WideToUtf8(prefix);
+    outUpper = outLower;
+    outUpper.back() = ']';
+}
+
+// Columns: path, total_size, total_files, total_folders, own_size, own_files, newest_mtime
+constexpr const char* kUsageColumns = "path, total_size, total_files, total_folders, own_size, own_files, newest_mtime";
+
+FolderUsage ReadUsage(sqlite3_stmt* stmt)
+{
+    FolderUsage usage;
+    const char* path = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    usage.path = Utf8ToWide(path ? path : "");
+    usage.totalSize = static_cast<uint64_t>(sqlite3_column_int64(stmt, 1));
+    usage.totalFiles = static_cast<uint64_t>(sqlite3_column_int64(stmt, 2));
+    usage.totalFolders = static_cast<uint64_t>(sqlite3_column_int64(stmt, 3));
+    usage.ownSize = static_cast<uint64_t>(sqlite3_column_int64(stmt, 4));
+    usage.ownFiles = static_cast<uint64_t>(sqlite3_column_int64(stmt, 5));
+    usage.newestWriteTime = static_cast<uint64_t>(sqlite3_column_int64(stmt, 6));
+    return usage;
+}
+
+} // namespace
+
+// Shared state of one job scan
+struct StorageAnalyzer::ScanContext
+{
+    const std::map<std::wstring, StoredFolder>* stored = nullptr;
+    bool fullRescan = false;
+
+    std::vector<std::vector<ScannedFolder>> results;        // One per worker
+
+    std::atomic<uint64_t> foldersListed{0};
+    std::atomic<uint64_t> foldersReused{0};
+    std::atomic<uint64_t> entries{0};
+};
+
+StorageAnalyzer::StorageAnalyzer()
+{
+}
+
+StorageAnalyzer::~StorageAnalyzer()
+{
+    Shutdown();
+}
+
+bool StorageAnalyzer::Initialize(SubscriptionManager* subscriptionManager, int threadCount)
+{
+    if (!subscriptionManager || !subscriptionManager->GetDatabase())
+    {
+        std::cerr << "[StorageAnalyzer] Invalid database" << std::endl;
+        return false;
+    }
+
+    m_subscriptionManager = subscriptionManager;
+    m_threadCount = (std::max)(1, threadCount);
+
+    if (!CreateTables())
+        return false;
+
+    m_running = true;
+    m_taskThread = std::thread(&StorageAnalyzer::TaskThread, this);
+    return true;
+}
+
+void StorageAnalyzer::Shutdown()
+{
+    if (!m_running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_running = false;
+        m_queue.clear();
+        m_activeJobs.clear();
+    }
+    m_queueCV.notify_all();
+
+    if (m_taskThread.joinable())
+    {
+        try
+        {
+            m_taskThread.join();
+        }
+        catch (const std::system_error& e)
+        {
+            std::cerr << "[StorageAnalyzer] Thread join error: " << e.what() << std::endl;
+            try { m_taskThread.detach(); } catch (...) {}
+        }
+    }
+}
+
+bool StorageAnalyzer::CreateTables()
+{
+    // One row per folder; own_* cover files directly inside, total_* everything below.
+    // Times are FILETIME ticks so they compare exactly with directory listings
+    const char* sql = R"(
+        CREATE TABLE IF NOT EXISTS folder_usage (
+            path TEXT PRIMARY KEY COLLATE NOCASE,
+            parent TEXT COLLATE NOCASE,
+            mtime INTEGER NOT NULL,
+            own_size INTEGER NOT NULL,
+            own_files INTEGER NOT NULL,
+            own_newest INTEGER NOT NULL,
+            total_size INTEGER NOT NULL,
+            total_files INTEGER NOT NULL,
+            total_folders INTEGER NOT NULL,
+            newest_mtime INTEGER NOT NULL,
+            scanned_time INTEGER NOT NULL
+        );
+
+        CREATE INDEX IF NOT EXISTS idx_folder_usage_parent ON folder_usage(parent);
+    )";
+
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(m_subscriptionManager->GetDatabase(), sql, nullptr, nullptr, &errMsg);
+    if (rc != SQLITE_OK)
+    {
+        std::cerr << "[StorageAnalyzer] Failed to create tables: " << (errMsg ? errMsg : "") << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+
+    return true;
+}
+
+void StorageAnalyzer::ScanJob(const std::wstring& jobPath, bool force, bool fullRescan)
+{
+    if (!m_running || jobPath.empty())
+        return;
+
+    std::wstring key = PathKey(jobPath);
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (m_activeJobs.count(key))
+            return;
+
+        auto last = m_lastScanTimes.find(key);
+        if (!force && last != m_lastScanTimes.end() && std::chrono::steady_clock::now() - last->second < kMinRescanInterval)
+            return;
+
+        m_activeJobs.insert(key);
+        m_queue.push_back({ NormalizePath(jobPath), fullRescan });
+    }
+    m_queueCV.notify_one();
+}
+
+bool StorageAnalyzer::IsScanning(const std::wstring& jobPath) const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_activeJobs.count(PathKey(jobPath)) > 0;
+}
+
+void StorageAnalyzer::TaskThread()
+{
+    while (m_running)
+    {
+        ScanRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCV.wait(lock, [this] { return !m_queue.empty() || !m_running; });
+
+            if (!m_running)
+                break;
+
+            request = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        RunScan(request);
+
+        // Failed scans count too, so views asking every frame don't retry an unreachable job in a loop
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        std::wstring key = PathKey(request.jobPath);
+        m_activeJobs.erase(key);
+        m_lastScanTimes[key] = std::chrono::steady_clock::now();
+    }
+}
+
+bool StorageAnalyzer::RunScan(const ScanRequest& request)
+{
+    WIN32_FILE_ATTRIBUTE_DATA info;
+    if (!GetFileAttributesExW(request.jobPath.c_str(), GetFileExInfoStandard, &info) ||
+        !(info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+        std::wcerr << L"[StorageAnalyzer] Not a folder: " << request.jobPath << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Previous results, to skip folders that have not changed
+    std::map<std::wstring, StoredFolder> stored;
+    if (!request.fullRescan)
+        LoadStoredFolders(request.jobPath, stored);
+
+    ScanContext context;
+    context.stored = &stored;
+    context.fullRescan = request.fullRescan;
+    context.results.resize(m_threadCount);
+
+    ParallelFolderWalk::Folder root = { request.jobPath, L"", FileTimeTicks(info.ftLastWriteTime) };
+    bool completed = ParallelFolderWalk::Run(root, m_threadCount, m_running,
+        [this, &context](size_t workerIndex, ParallelFolderWalk::Folder& folder, std::vector<ParallelFolderWalk::Folder>& outSubfolders) {
+            ScanFolder(context, workerIndex, folder, outSubfolders);
+        });
+    if (!completed)
+        return false;
+
+    std::vector<ScannedFolder> folders;
+    for (auto& results : context.results)
+    {
+        std::move(results.begin(), results.end(), std::back_inserter(folders));
+        results.clear();
+    }
+    ComputeTotals(folders);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t entries = context.entries;
+    std::wcout << L"[StorageAnalyzer] Scanned " << request.jobPath << L": " << folders.size() << L" folders ("
+               << context.foldersListed.load() << L" listed, " << context.foldersReused.load() << L" unchanged), "
+               << entries << L" entries in " << seconds << L"s ("
+               << static_cast<uint64_t>(seconds > 0.0 ? entries / seconds : 0.0) << L" entries/s)" << std::endl;
+
+    if (!StoreFolders(request.jobPath, folders))
+        return false;
+
+    m_version++;
+    return true;
+}
+
+void StorageAnalyzer::ScanFolder(ScanContext& context, size_t workerIndex, ParallelFolderWalk::Folder& work,
+                                 std::vector<ParallelFolderWalk::Folder>& subfolders)
+{
+    ScannedFolder folder;
+    folder.path = std::move(work.path);
+    folder.parent = std::move(work.parent);
+    folder.lastWriteTime = work.lastWriteTime;
+
+    // Adding, removing or renaming entries updates a folder's modification time: unchanged folders keep
+    // their stored file totals and only their subfolders are checked
+    auto previous = context.fullRescan ? context.stored->end() : context.stored->find(PathKey(folder.path));
+    if (previous != context.stored->end() && previous->second.lastWriteTime == folder.lastWriteTime)
+    {
+        folder.ownSize = previous->second.ownSize;
+        folder.ownFiles = previous->second.ownFiles;
+        folder.ownNewest = previous->second.ownNewest;
+
+        for (const auto& name : previous->second.subfolders)
+        {
+            std::wstring childPath = JoinPath(folder.path, name);
+            WIN32_FILE_ATTRIBUTE_DATA info;
+            if (GetFileAttributesExW(childPath.c_str(), GetFileExInfoStandard, &info) &&
+                (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+                !(info.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+            {
+                subfolders.push_back({ childPath, folder.path, FileTimeTicks(info.ftLastWriteTime) });
+            }
+        }
+        context.foldersReused++;
+    }
+    else
+    {
+        WIN32_FIND_DATAW data;
+        HANDLE find = FindFirstFileExW(JoinPath(folder.path, L"*").c_str(), FindExInfoBasic, &data,
+                                       FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+        if (find != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                const wchar_t* name = data.cFileName;
+                if (name[0] == L'.' && (name[1] == L'\0' || (name[1] == L'.' && name[2] == L'\0')))
+                    continue;
+
+                if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                {
+                    // Junctions and symlinked folders would be counted twice (or forever)
+                    if (!(data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+                        subfolders.push_back({ JoinPath(folder.path, name), folder.path, FileTimeTicks(data.ftLastWriteTime) });
+                    continue;
+                }
+
+                folder.ownSize += (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+                folder.ownFiles++;
+                folder.ownNewest = (std::max)(folder.ownNewest, FileTimeTicks(data.ftLastWriteTime));
+            } while (FindNextFileW(find, &data));
+
+            FindClose(find);
+        }
+        context.foldersListed++;
+    }
+
+    context.entries += folder.ownFiles + subfolders.size();
+    context.results[workerIndex].push_back(std::move(folder));
+}
+
+void StorageAnalyzer::ComputeTotals(std::vector<ScannedFolder>& folders)
+{
+    std::unordered_map<std::wstring, size_t> indexByPath;
+    indexByPath.reserve(folders.size());
+    for (size_t i = 0; i < folders.size(); ++i)
+    {
+        ScannedFolder& folder = folders[i];
+        folder.usage.path = folder.path;
+        folder.usage.ownSize = folder.usage.totalSize = folder.ownSize;
+        folder.usage.ownFiles = folder.usage.totalFiles = folder.ownFiles;
+        folder.usage.newestWriteTime = folder.ownNewest;
+        indexByPath[PathKey(folder.path)] = i;
+    }
+
+    // Deepest folders first, so every folder is complete before it is added to its parent
+    std::vector<std::pair<size_t, size_t>> byDepth;     // Depth, index
+    byDepth.reserve(folders.size());
+    for (size_t i = 0; i < folders.size(); ++i)
+        byDepth.emplace_back(std::count(folders[i].path.begin(), folders[i].path.end(), L'\\'), i);
+    std::sort(byDepth.begin(), byDepth.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (const auto& pair : byDepth)
+    {
+        const ScannedFolder& folder = folders[pair.second];
+        if (folder.parent.empty())
+            continue;
+
+        auto parent = indexByPath.find(PathKey(folder.parent));
+        if (parent == indexByPath.end())
+            continue;
+
+        FolderUsage& parentUsage = folders[parent->second].usage;
+        parentUsage.totalSize += folder.usage.totalSize;
+        parentUsage.totalFiles += folder.usage.totalFiles;
+        parentUsage.totalFolders += folder.usage.totalFolders + 1;
+        parentUsage.newestWriteTime = (std::max)(parentUsage.newestWriteTime, folder.usage.newestWriteTime);
+    }
+}
+
+bool StorageAnalyzer::LoadStoredFolders(const std::wstring& jobPath, std::map<std::wstring, StoredFolder>& outFolders)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+    sqlite3* db = m_subscriptionManager->GetDatabase();
+
+    const char* sql = "SELECT path, mtime, own_size, own_files, own_newest FROM folder_usage "
+                      "WHERE path = ?1 OR (path > ?2 AND path < ?3)";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "[StorageAnalyzer] Failed to prepare load: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    std::string pathUtf8 = WideToUtf8(jobPath);
+    std::string lower, upper;
+    SubtreeRange(jobPath, lower, upper);
+    sqlite3_bind_text(stmt, 1, pathUtf8.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, lower.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 3, upper.c_str(), -1, SQLITE_TRANSIENT);
+
+    std::vector<std::wstring> paths;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const char* path = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        if (!path)
+            continue;
+
+        std::wstring folderPath = Utf8ToWide(path);
+        StoredFolder& folder = outFolders[PathKey(folderPath)];
+        folder.lastWriteTime = static_cast<uint64_t>(sqlite3_column_int64(stmt, 1));
+        folder.ownSize = static_cast<uint64_t>(sqlite3_column_int64(stmt, 2));
+        folder.ownFiles = static_cast<uint64_t>(sqlite3_column_int64(stmt, 3));
+        folder.ownNewest = static_cast<uint64_t>(sqlite3_column_int64(stmt, 4));
+        paths.push_back(std::move(folderPath));
+    }
+    sqlite3_finalize(stmt);
+
+    // Subfolder names of every stored folder
+    for (const auto& path : paths)
+    {
+        size_t separator = path.find_last_of(L'\\');
+        if (separator == std::wstring::npos)
+            continue;
+
+        auto parent = outFolders.find(PathKey(path.substr(0, separator)));
+        if (parent != outFolders.end())
+            parent->second.subfolders.push_back(path.substr(separator + 1));
+    }
+
+    return true;
+}
+
+bool StorageAnalyzer::StoreFolders(const std::wstring& jobPath, const std::vector<ScannedFolder>& folders)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+    sqlite3* db = m_subscriptionManager->GetDatabase();
+
+    // Replace everything stored for the job (folders that are gone disappear with it)
+    sqlite3_stmt* deleteStmt = nullptr;
+    sqlite3_stmt* insertStmt = nullptr;
+    const char* deleteSql = "DELETE FROM folder_usage WHERE path = ?1 OR (path > ?2 AND path < ?3)";
+    const char* insertSql = "INSERT OR REPLACE INTO folder_usage (path, parent, mtime, own_size, own_files, own_newest, "
+                            "total_size, total_files, total_folders, newest_mtime, scanned_time) "
+                            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    if (sqlite3_prepare_v2(db, deleteSql, -1, &deleteStmt, nullptr) != SQLITE_OK ||
+        sqlite3_prepare_v2(db, insertSql, -1, &insertStmt, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "[StorageAnalyzer] Failed to prepare store: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_finalize(deleteStmt);
+        sqlite3_finalize(insertStmt);
+        return false;
+    }
+
+    sqlite3_exec(db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
+
+    std::string pathUtf8 = WideToUtf8(jobPath);
+    std::string lower, upper;
+    SubtreeRange(jobPath, lower, upper);
+    sqlite3_bind_text(deleteStmt, 1, pathUtf8.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(deleteStmt, 2, lower.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(deleteStmt, 3, upper.c_str(), -1, SQLITE_TRANSIENT);
+    bool ok = sqlite3_step(deleteStmt) == SQLITE_DONE;
+    sqlite3_finalize(deleteStmt);
+
+    sqlite3_int64 now = static_cast<sqlite3_int64>(GetCurrentTimeMs());
+    for (const auto& folder : folders)
+    {
+        if (!ok)
+            break;
+
+        std::string folderUtf8 = WideToUtf8(folder.path);
+        std::string parentUtf8 = WideToUtf8(folder.parent);
+        sqlite3_bind_text(insertStmt, 1, folderUtf8.c_str(), -1, SQLITE_TRANSIENT);
+        if (folder.parent.empty())
+            sqlite3_bind_null(insertStmt, 2);
+        else
+            sqlite3_bind_text(insertStmt, 2, parentUtf8.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(insertStmt, 3, static_cast<sqlite3_int64>(folder.lastWriteTime));
+        sqlite3_bind_int64(insertStmt, 4, static_cast<sqlite3_int64>(folder.ownSize));
+        sqlite3_bind_int64(insertStmt, 5, static_cast<sqlite3_int64>(folder.ownFiles));
+        sqlite3_bind_int64(insertStmt, 6, static_cast<sqlite3_int64>(folder.ownNewest));
+        sqlite3_bind_int64(insertStmt, 7, static_cast<sqlite3_int64>(folder.usage.totalSize));
+        sqlite3_bind_int64(insertStmt, 8, static_cast<sqlite3_int64>(folder.usage.totalFiles));
+        sqlite3_bind_int64(insertStmt, 9, static_cast<sqlite3_int64>(folder.usage.totalFolders));
+        sqlite3_bind_int64(insertStmt, 10, static_cast<sqlite3_int64>(folder.usage.newestWriteTime));
+        sqlite3_bind_int64(insertStmt, 11, now);
+
+        ok = sqlite3_step(insertStmt) == SQLITE_DONE;
+        sqlite3_reset(insertStmt);
+        sqlite3_clear_bindings(insertStmt);
+    }
+    sqlite3_finalize(insertStmt);
+
+    if (!ok)
+    {
+        std::cerr << "[StorageAnalyzer] Failed to store folder usage: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    return true;
+}
+
+std::map<std::wstring, FolderUsage> StorageAnalyzer::GetUsage(const std::vector<std::wstring>& folders)
+{
+    std::map<std::wstring, FolderUsage> result;
+    if (!m_subscriptionManager || folders.empty())
+        return result;
+
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+    sqlite3* db = m_subscriptionManager->GetDatabase();
+
+    std::string sql = std::string("SELECT ") + kUsageColumns + " FROM folder_usage WHERE path = ?";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "[StorageAnalyzer] Failed to prepare lookup: " << sqlite3_errmsg(db) << std::endl;
+        return result;
+    }
+
+    // One read transaction for the whole batch
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+
+    for (const auto& folder : folders)
+    {
+        std::string pathUtf8 = WideToUtf8(NormalizePath(folder));
+        sqlite3_bind_text(stmt, 1, pathUtf8.c_str(), -1, SQLITE_TRANSIENT);
+
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            result[folder] = ReadUsage(stmt);
+
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+std::vector<FolderUsage> StorageAnalyzer::GetChildren(const std::wstring& folder)
+{
+    std::vector<FolderUsage> children;
+    if (!m_subscriptionManager)
+        return children;
+
+    std::lock_guard<std::recursive_mutex> lock(m_subscriptionManager->GetDatabaseMutex());
+    sqlite3* db = m_subscriptionManager->GetDatabase();
+
+    std::string sql = std::string("SELECT ") + kUsageColumns + " FROM folder_usage WHERE parent = ? ORDER BY total_size DESC";
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        std::cerr << "[StorageAnalyzer] Failed to prepare children query: " << sqlite3_errmsg(db) << std::endl;
+        return children;
+    }
+
+    std::string pathUtf8 = WideToUtf8(NormalizePath(folder));
+    sqlite3_bind_text(stmt, 1, pathUtf8.c_str(), -1, SQLITE_TRANSIENT);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+        children.push_back(ReadUsage(stmt));
+
+    sqlite3_finalize(stmt);
+    return children;
+}
+
+bool StorageAnalyzer::GetTree(const std::wstring& folder, int maxDepth, FolderUsageNode& outRoot)
+{
+    auto usage = GetUsage({ folder });
+    if (usage.empty())
+        return false;
+
+    outRoot.usage = usage.begin()->second;
+    outRoot.children.clear();
+
+    // One query per folder that is expanded
+    std::vector<std::pair<FolderUsageNode*, int>> pending = { { &outRoot, 0 } };
+    while (!pending.empty())
+    {
+        auto [node, depth] = pending.back();
+        pending.pop_back();
+        if (depth >= maxDepth)
+            continue;
+
+        for (auto& child : GetChildren(node->usage.path))
+            node->children.push_back({ std::move(child), {} });
+        for (auto& child : node->children)
+            pending.push_back({ &child, depth + 1 });
+    }
+
+    return true;
+}
+
+} // namespace UFB
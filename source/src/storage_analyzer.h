@@ -0,0 +1,134 @@
+#pragma once
+
+#include "parallel_folder_walk.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+
+namespace UFB {
+
+class SubscriptionManager;
+
+// Disk usage of one folder, including everything below it
+struct FolderUsage
+{
+    std::wstring path;
+    uint64_t totalSize = 0;         // Bytes in all files below
+    uint64_t totalFiles = 0;
+    uint64_t totalFolders = 0;      // Subfolders below (all levels)
+    uint64_t ownSize = 0;           // Bytes in files directly in the folder
+    uint64_t ownFiles = 0;
+    uint64_t newestWriteTime = 0;   // FILETIME ticks of the newest file below (0 if none)
+};
+
+// Folder of a usage tree (children sorted by size, largest first); one treemap rectangle per node,
+// with ownSize as the space not taken by the children
+struct FolderUsageNode
+{
+    FolderUsage usage;
+    std::vector<FolderUsageNode> children;
+};
+
+// Per-folder disk usage of subscribed jobs, stored in ufb.db (folder_usage table)
+//
+// - A job is scanned on a pool of threads (ParallelFolderWalk): every thread has its own queue of
+//   folders and takes work from the others when it runs out, so one deep render tree doesn't leave
+//   the rest idle
+// - Rescans re-list only folders whose modification time changed; the others keep their stored
+//   file totals and only their subfolders are checked
+// - Scans run one job at a time in the background; views poll GetVersion() and re-read when it changes
+class StorageAnalyzer
+{
+public:
+    StorageAnalyzer();
+    ~StorageAnalyzer();
+
+    // Initialize with the shared database (folder_usage table lives in ufb.db)
+    bool Initialize(SubscriptionManager* subscriptionManager, int threadCount = 8);
+
+    // Stop the running scan and worker threads
+    void Shutdown();
+
+    // Queue a scan of a job folder; without force it is skipped when the job was scanned recently
+    // fullRescan re-lists every folder (picks up files rewritten in place, which don't change folder times)
+    void ScanJob(const std::wstring& jobPath, bool force = false, bool fullRescan = false);
+
+    // True while the job is queued or being scanned
+    bool IsScanning(const std::wstring& jobPath) const;
+
+    // Changes whenever a scan has stored new results
+    uint64_t GetVersion() const { return m_version; }
+
+    // Stored usage of folders (missing from the result when never scanned); keyed by the given paths
+    std::map<std::wstring, FolderUsage> GetUsage(const std::vector<std::wstring>& folders);
+
+    // Direct subfolders of a folder, largest first
+    std::vector<FolderUsage> GetChildren(const std::wstring& folder);
+
+    // Usage tree below a folder, maxDepth levels deep (false if the folder was never scanned)
+    bool GetTree(const std::wstring& folder, int maxDepth, FolderUsageNode& outRoot);
+
+private:
+    struct ScanRequest
+    {
+        std::wstring jobPath;
+        bool fullRescan = false;
+    };
+
+    // Folder as stored by the previous scan
+    struct StoredFolder
+    {
+        uint64_t lastWriteTime = 0;
+        uint64_t ownSize = 0;
+        uint64_t ownFiles = 0;
+        uint64_t ownNewest = 0;
+        std::vector<std::wstring> subfolders;   // Names
+    };
+
+    // Folder as listed by this scan
+    struct ScannedFolder
+    {
+        std::wstring path;
+        std::wstring parent;
+        uint64_t lastWriteTime = 0;
+        uint64_t ownSize = 0;
+        uint64_t ownFiles = 0;
+        uint64_t ownNewest = 0;
+        FolderUsage usage;      // Totals (filled after the scan)
+    };
+
+    struct ScanContext;
+
+    void TaskThread();
+    bool RunScan(const ScanRequest& request);
+    void ScanFolder(ScanContext& context, size_t workerIndex, ParallelFolderWalk::Folder& work,
+                    std::vector<ParallelFolderWalk::Folder>& subfolders);
+    static void ComputeTotals(std::vector<ScannedFolder>& folders);
+
+    bool CreateTables();
+    bool LoadStoredFolders(const std::wstring& jobPath, std::map<std::wstring, StoredFolder>& outFolders);
+    bool StoreFolders(const std::wstring& jobPath, const std::vector<ScannedFolder>& folders);
+
+    SubscriptionManager* m_subscriptionManager = nullptr;
+    int m_threadCount = 8;
+
+    std::thread m_taskThread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_version{0};
+
+    mutable std::mutex m_queueMutex;    // Guards the queue and scan state below
+    std::condition_variable m_queueCV;
+    std::deque<ScanRequest> m_queue;
+    std::set<std::wstring> m_activeJobs;    // Lowercase paths queued or scanning
+    std::map<std::wstring, std::chrono::steady_clock::time_point> m_lastScanTimes;  // Lowercase path -> finished
+};
+
+} // namespace UFB
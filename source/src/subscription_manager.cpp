@@ -1217,7 +1217,7 @@ bool SubscriptionManager::DeleteManualTask(int taskId)
                 // Trigger P2P notification
                 if (m_localChangeCallback)
                 {
-                    m_localChangeCallback(jobPath, entry.timestamp);
+                    m_localChangeCallback(jobPath, entry.timestamp, entry);
                 }
             }
             else
@@ -1315,17 +1315,14 @@ void SubscriptionManager::BridgeToSyncCache(const ShotMetadata& metadata, const
         return;
     }
 
-    // Brief delay to allow cloud sync services (Dropbox, OneDrive) to detect file change
-    // This gives them time to start propagating the file before remote peers try to read it
-    // 500ms is small enough to not impact UX but large enough for file system watchers
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
     // Trigger P2P notification with shot's modification time (if callback is registered)
     // IMPORTANT: Send shot.modifiedTime (not entry.timestamp) because that's what
     // the remote peer will find in the Shot objects after reading change logs
+    // No delay for cloud sync services here: the entry itself is pushed to peers, which only
+    // fall back to reading the share when the push can't be applied
     if (m_localChangeCallback)
     {
-        m_localChangeCallback(jobPath, shot.modifiedTime);
+        m_localChangeCallback(jobPath, shot.modifiedTime, entry);
     }
 
     // Also update local cache immediately for local UI responsiveness
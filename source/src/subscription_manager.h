@@ -11,6 +11,8 @@
 
 namespace UFB {
 
+struct ChangeLogEntry;
+
 // Sync status for subscriptions
 enum class SyncStatus
 {
@@ -118,7 +120,8 @@ public:
     std::recursive_mutex& GetDatabaseMutex() const { return m_dbMutex; }
 
     // Register callback for when local changes are made (for immediate P2P notifications)
-    void RegisterLocalChangeCallback(std::function<void(const std::wstring& jobPath, uint64_t timestamp)> callback)
+    // timestamp is the one peers verify against; entry is the change log entry that was written
+    void RegisterLocalChangeCallback(std::function<void(const std::wstring& jobPath, uint64_t timestamp, const ChangeLogEntry& entry)> callback)
     {
         m_localChangeCallback = callback;
     }
@@ -145,7 +148,7 @@ private:
     sqlite3* m_db = nullptr;
     std::filesystem::path m_dbPath;
     MetadataManager* m_metaManager = nullptr;  // For bridging metadata systems
-    std::function<void(const std::wstring& jobPath, uint64_t timestamp)> m_localChangeCallback;  // For immediate P2P notifications
+    std::function<void(const std::wstring& jobPath, uint64_t timestamp, const ChangeLogEntry& entry)> m_localChangeCallback;  // For immediate P2P notifications
     std::function<void()> m_subscriptionChangeCallback;  // For client tracking file updates
     std::function<void(const std::wstring& jobPath)> m_unsubscribeCallback;  // For server mode pruning
 
@@ -1,9 +1,7 @@
-// Ensure WinSock2 is included before windows.h (needed by p2p_manager.h)
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #endif
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include <windows.h>
 #include <combaseapi.h>  // For CoCreateGuid
 
 #include "sync_manager.h"
@@ -77,25 +75,46 @@ bool SyncManager::Initialize(SubscriptionManager* subManager, MetadataManager* m
         OnP2PChangeReceived(changedJobPath, peerDeviceId, timestamp);
     });
 
-    // Register callback for when a peer connects (trigger initial sync)
+    // Register callback for entries pushed by peers (applied directly, no share read)
+    m_p2pManager->RegisterEntriesCallback([this](const P2PChangeBatch& batch) {
+        return OnP2PEntriesReceived(batch);
+    });
+
+    // Register callback serving our own entries to peers that missed some
+    m_p2pManager->RegisterSyncRequestCallback([this](const std::wstring& requestedJobPath, uint64_t sinceTimestamp) {
+        return GetOwnEntriesSince(requestedJobPath, sinceTimestamp);
+    });
+
+    // Register callbacks for the anti-entropy exchange (summaries, then only the buckets that differ)
+    m_p2pManager->RegisterSummaryCallback([this](const std::wstring& peerDeviceId, const std::wstring& summaryJobPath, const nlohmann::json& summary) {
+        OnSyncSummaryReceived(peerDeviceId, summaryJobPath, summary);
+    });
+
+    m_p2pManager->RegisterRangeRequestCallback([this](const std::wstring& requestedJobPath, const std::vector<uint32_t>& buckets,
+                                                      const std::vector<uint64_t>& knownShots) {
+        return GetShotsInBuckets(requestedJobPath, buckets, knownShots);
+    });
+
+    // Register callback for when a peer connects (reconcile with it)
     m_p2pManager->RegisterPeerConnectedCallback([this](const std::wstring& peerDeviceId, const std::wstring& peerDeviceName) {
         std::wcout << L"[SyncManager] Peer connected: " << peerDeviceName << L" (" << peerDeviceId << L")" << std::endl;
-        std::wcout << L"[SyncManager] Triggering full sync to exchange historical changes..." << std::endl;
 
-        // Trigger immediate sync of all subscribed jobs to exchange historical changes
-        // This ensures that when peers reconnect after being offline, they sync their change logs
-        ForceSyncAll();
+        // Exchange job summaries so peers that were offline catch up on what they missed, without
+        // re-reading every change log (the polling sync still reads the share for peers that aren't online).
+        // Peers from before the exchange don't answer summaries: re-read the share as before
+        if (m_p2pManager->SupportsAntiEntropy(peerDeviceId))
+        {
+            SendSyncSummaries(peerDeviceId);
+        }
+        else
+        {
+            ForceSyncAll();
+        }
     });
 
     // Register callback for immediate P2P notifications when local changes are made
-    m_subManager->RegisterLocalChangeCallback([this](const std::wstring& jobPath, uint64_t timestamp) {
-        // Notify P2P peers immediately when a local change is written to the change log
-        if (m_p2pManager)
-        {
-            m_p2pManager->NotifyPeersOfChange(jobPath, timestamp);
-            std::wcout << L"[SyncManager] Immediately notified P2P peers of local change to: " << jobPath
-                       << L" (timestamp: " << timestamp << L")" << std::endl;
-        }
+    m_subManager->RegisterLocalChangeCallback([this](const std::wstring& jobPath, uint64_t timestamp, const ChangeLogEntry& entry) {
+        OnLocalChange(jobPath, timestamp, entry);
     });
 
     return true;
@@ -251,6 +270,14 @@ void SyncManager::SyncTick()
         return;
     }
 
+    // Periodic anti-entropy round with all connected peers
+    uint64_t now = GetCurrentTimeMs();
+    if (now - m_lastSummaryTime >= kSummaryIntervalMs)
+    {
+        m_lastSummaryTime = now;
+        SendSyncSummaries(L"");
+    }
+
     // Sync 1-2 jobs per tick (staggered)
     int jobsToSync = (std::min)(2, static_cast<int>(m_activeJobPaths.size()));
 
@@ -571,6 +598,9 @@ SyncDiff SyncManager::ComputeDiff(const std::map<std::wstring, Shot>& cached,
 
 void SyncManager::ApplyRemoteChanges(const std::wstring& jobPath, const std::vector<Shot>& changes)
 {
+    // Sync worker and P2P pushes both update the cache
+    std::lock_guard<std::mutex> applyLock(m_applyMutex);
+
     std::wcout << L"[SyncManager] ApplyRemoteChanges: Applying " << changes.size() << L" remote changes to: " << jobPath << std::endl;
 
     for (const auto& shot : changes)
@@ -591,10 +621,27 @@ void SyncManager::ApplyRemoteChanges(const std::wstring& jobPath, const std::vec
         updatedCache[shot.shotPath] = shot;
     }
 
-    // Apply remote changes
+    // Apply remote changes (unless the cache got a newer version meanwhile, e.g. from a P2P push
+    // while the change logs were being read; same tie-breaker as ShouldAcceptRemoteChange)
+    std::vector<Shot> appliedChanges;
     for (const auto& remoteShot : changes)
     {
+        auto it = updatedCache.find(remoteShot.shotPath);
+        if (it != updatedCache.end() &&
+            (it->second.modifiedTime > remoteShot.modifiedTime ||
+             (it->second.modifiedTime == remoteShot.modifiedTime && it->second.deviceId >= remoteShot.deviceId)))
+        {
+            continue;
+        }
+
         updatedCache[remoteShot.shotPath] = remoteShot;
+        appliedChanges.push_back(remoteShot);
+    }
+
+    if (appliedChanges.empty())
+    {
+        std::wcout << L"[SyncManager] ApplyRemoteChanges: cache already up to date" << std::endl;
+        return;
     }
 
     // Convert back to vector
@@ -609,8 +656,8 @@ void SyncManager::ApplyRemoteChanges(const std::wstring& jobPath, const std::vec
     m_metaManager->UpdateCache(jobPath, updatedShots, false);
 
     // Bridge ONLY the remote changes from sync cache to shot_metadata table (so UI can see them!)
-    std::wcout << L"[SyncManager] Bridging " << changes.size() << L" remote changes from sync cache to shot_metadata" << std::endl;
-    for (const auto& remoteShot : changes)
+    std::wcout << L"[SyncManager] Bridging " << appliedChanges.size() << L" remote changes from sync cache to shot_metadata" << std::endl;
+    for (const auto& remoteShot : appliedChanges)
     {
         m_subManager->BridgeFromSyncCache(remoteShot, jobPath);
     }
@@ -710,8 +757,8 @@ void SyncManager::CreateBackupIfNeeded(const std::wstring& jobPath)
         return;
     }
 
-    // Create backup
-    if (m_backupManager->CreateBackup(jobPath))
+    // Create backup (daily backups of an unchanged job reuse the previous one)
+    if (m_backupManager->CreateBackup(jobPath, true))
     {
         std::cout << "    Backup created successfully" << std::endl;
 
@@ -1128,6 +1175,286 @@ void SyncManager::OnP2PChangeReceived(const std::wstring& jobPath, const std::ws
     }
 }
 
+bool SyncManager::OnP2PEntriesReceived(const P2PChangeBatch& batch)
+{
+    try
+    {
+        if (!m_isRunning || batch.jobPath.empty() || !m_subManager->GetSubscription(batch.jobPath))
+        {
+            return false;
+        }
+
+        // Current shots from a range transfer: any device's writes, applied last-writer-wins
+        if (batch.currentState)
+        {
+            std::vector<Shot> shots;
+            for (const auto& entryJson : batch.entries)
+            {
+                ChangeLogEntry entry = m_metaManager->JsonToChangeLogEntry(entryJson);
+                if (entry.operation == "update" && !entry.shotPath.empty() && entry.data.modifiedTime > 0)
+                {
+                    shots.push_back(entry.data);
+                }
+            }
+
+            if (!shots.empty())
+            {
+                ApplyRemoteChanges(batch.jobPath, shots);
+            }
+            return true;
+        }
+
+        // Entries made by the sending device (it only pushes and serves its own)
+        PushedEntries pushed;
+        if (!m_pushedEntries.Accept(batch, pushed))
+        {
+            return false;
+        }
+
+        // Entries the sender pushed before this batch that never arrived here: ask for them
+        if (pushed.missingSince > 0 && m_p2pManager)
+        {
+            std::wcout << L"[SyncManager] Missed pushed entries from " << batch.deviceId << L" ("
+                       << pushed.missingSince << L" .. " << batch.previousTimestamp << L"), requesting them" << std::endl;
+            m_p2pManager->RequestChanges(batch.deviceId, batch.jobPath, pushed.missingSince);
+        }
+
+        std::vector<Shot> updates;
+        updates.reserve(pushed.updates.size());
+        for (const auto& entryJson : pushed.updates)
+        {
+            updates.push_back(m_metaManager->JsonToChangeLogEntry(entryJson).data);
+        }
+
+        if (!updates.empty())
+        {
+            ApplyRemoteChanges(batch.jobPath, updates);
+        }
+
+        // Sender clock, so only meaningful between machines with synced clocks
+        uint64_t now = GetCurrentTimeMs();
+        std::wcout << L"[SyncManager] Applied " << updates.size() << L" pushed entries for " << batch.jobPath
+                   << L" from " << batch.deviceId << L" (" << (now > pushed.oldestTimestamp ? now - pushed.oldestTimestamp : 0)
+                   << L"ms after the change)" << std::endl;
+
+        return !pushed.hasDeletes;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[SyncManager] Exception in OnP2PEntriesReceived: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "[SyncManager] Unknown exception in OnP2PEntriesReceived" << std::endl;
+    }
+    return false;
+}
+
+void SyncManager::OnLocalChange(const std::wstring& jobPath, uint64_t timestamp, const ChangeLogEntry& entry)
+{
+    // Notify P2P peers when a local change is written to the change log (bursts are coalesced per job)
+    if (!m_p2pManager)
+    {
+        return;
+    }
+
+    uint64_t previousTimestamp = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_recentEntriesMutex);
+        auto& recent = m_recentEntries[jobPath];
+        if (!recent.empty())
+        {
+            previousTimestamp = recent.back().timestamp;
+        }
+
+        recent.push_back(entry);
+        if (recent.size() > kRecentEntryLimit)
+        {
+            recent.pop_front();
+        }
+    }
+
+    nlohmann::json entries = nlohmann::json::array();
+    entries.push_back(m_metaManager->ChangeLogEntryToJson(entry));
+
+    m_p2pManager->NotifyPeersOfChange(jobPath, timestamp, entries, previousTimestamp);
+    std::wcout << L"[SyncManager] Queued local change for P2P peers: " << jobPath
+               << L" (timestamp: " << timestamp << L")" << std::endl;
+}
+
+nlohmann::json SyncManager::GetOwnEntriesSince(const std::wstring& jobPath, uint64_t sinceTimestamp)
+{
+    // Only jobs we are subscribed to are served (the path comes from the peer)
+    if (!m_isRunning || jobPath.empty() || !m_subManager->GetSubscription(jobPath))
+    {
+        return nlohmann::json::array();
+    }
+
+    std::vector<ChangeLogEntry> entries;
+    bool fromMemory = false;
+
+    // Entries pushed this session cover the range if the oldest kept one is not newer than it
+    {
+        std::lock_guard<std::mutex> lock(m_recentEntriesMutex);
+        auto it = m_recentEntries.find(jobPath);
+        if (it != m_recentEntries.end() && !it->second.empty() && it->second.front().timestamp <= sinceTimestamp)
+        {
+            for (const auto& entry : it->second)
+            {
+                if (entry.timestamp > sinceTimestamp)
+                {
+                    entries.push_back(entry);
+                }
+            }
+            fromMemory = true;
+        }
+    }
+
+    // Otherwise read our own change log (active + archived)
+    if (!fromMemory)
+    {
+        for (auto& entry : m_archivalManager->ReadDeviceChangeLogs(jobPath, WideToUtf8(m_deviceId)))
+        {
+            if (entry.timestamp > sinceTimestamp)
+            {
+                entries.push_back(std::move(entry));
+            }
+        }
+
+        std::sort(entries.begin(), entries.end(),
+            [](const ChangeLogEntry& a, const ChangeLogEntry& b) { return a.timestamp < b.timestamp; });
+    }
+
+    // Oldest first; anything beyond the limit reaches the requester through the share
+    if (entries.size() > kSyncResponseLimit)
+    {
+        entries.resize(kSyncResponseLimit);
+    }
+
+    nlohmann::json result = nlohmann::json::array();
+    for (const auto& entry : entries)
+    {
+        result.push_back(m_metaManager->ChangeLogEntryToJson(entry));
+    }
+    return result;
+}
+
+void SyncManager::SendSyncSummaries(const std::wstring& peerDeviceId)
+{
+    if (!m_p2pManager || !m_subManager)
+    {
+        return;
+    }
+
+    // Compact summaries (vector + root); a peer whose root differs answers with its full summary
+    for (const auto& sub : m_subManager->GetAllSubscriptions())
+    {
+        if (!sub.isActive)
+        {
+            continue;
+        }
+
+        SyncSummary summary = SyncSummary::Build(m_metaManager->GetCachedShots(sub.jobPath));
+        m_p2pManager->SendSyncSummary(peerDeviceId, sub.jobPath, summary.Compact().ToJson());
+    }
+}
+
+void SyncManager::OnSyncSummaryReceived(const std::wstring& peerDeviceId, const std::wstring& jobPath, const nlohmann::json& summaryJson)
+{
+    try
+    {
+        if (!m_isRunning || !m_subManager->GetSubscription(jobPath))
+        {
+            return;
+        }
+
+        SyncSummary remote;
+        if (!SyncSummary::FromJson(summaryJson, remote))
+        {
+            std::cerr << "[SyncManager] Invalid summary from peer" << std::endl;
+            return;
+        }
+
+        std::vector<Shot> cachedShots = m_metaManager->GetCachedShots(jobPath);
+        SyncSummary local = SyncSummary::Build(cachedShots);
+        if (local.root == remote.root)
+        {
+            return;     // Same state
+        }
+
+        // Compact summary: answer with ours so the peer can see which buckets differ
+        if (!remote.IsFull())
+        {
+            m_p2pManager->SendSyncSummary(peerDeviceId, jobPath, local.ToJson());
+            return;
+        }
+
+        // Pull unless the peer is the one behind (it pulls from us after our summary). When neither
+        // vector is ahead the states still differ (writes the vectors can't show), so both sides pull
+        if (!local.IsBehind(remote) && remote.IsBehind(local))
+        {
+            return;
+        }
+
+        std::vector<uint32_t> buckets = local.DifferingBuckets(remote);
+        if (buckets.empty())
+        {
+            return;
+        }
+
+        // Tell the peer which versions we already have in those buckets, so only the others come back
+        std::set<uint32_t> differing(buckets.begin(), buckets.end());
+        std::vector<uint64_t> knownShots;
+        for (const auto& shot : cachedShots)
+        {
+            if (differing.count(SyncSummary::BucketOf(shot.shotPath)) > 0)
+            {
+                knownShots.push_back(SyncSummary::HashShot(shot));
+            }
+        }
+
+        std::wcout << L"[SyncManager] State of " << jobPath << L" differs from " << peerDeviceId << L" in "
+                   << buckets.size() << L"/" << SyncSummary::kBucketCount << L" buckets, requesting them" << std::endl;
+        m_p2pManager->RequestRanges(peerDeviceId, jobPath, buckets, knownShots);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[SyncManager] Exception in OnSyncSummaryReceived: " << e.what() << std::endl;
+    }
+}
+
+nlohmann::json SyncManager::GetShotsInBuckets(const std::wstring& jobPath, const std::vector<uint32_t>& buckets,
+                                              const std::vector<uint64_t>& knownShots)
+{
+    // Only jobs we are subscribed to are served (the path comes from the peer)
+    if (!m_isRunning || jobPath.empty() || !m_subManager->GetSubscription(jobPath))
+    {
+        return nlohmann::json::array();
+    }
+
+    std::set<uint32_t> wanted(buckets.begin(), buckets.end());
+    std::set<uint64_t> known(knownShots.begin(), knownShots.end());
+
+    // Current shots as update entries, so they travel like any other pushed entry
+    nlohmann::json result = nlohmann::json::array();
+    for (const auto& shot : m_metaManager->GetCachedShots(jobPath))
+    {
+        if (wanted.count(SyncSummary::BucketOf(shot.shotPath)) == 0 || known.count(SyncSummary::HashShot(shot)) > 0)
+        {
+            continue;
+        }
+
+        ChangeLogEntry entry;
+        entry.deviceId = shot.deviceId;
+        entry.timestamp = shot.modifiedTime;
+        entry.operation = "update";
+        entry.shotPath = shot.shotPath;
+        entry.data = shot;
+        result.push_back(m_metaManager->ChangeLogEntryToJson(entry));
+    }
+    return result;
+}
+
 std::wstring SyncManager::GetOrCreateDeviceId()
 {
     // Device ID is stored in %LOCALAPPDATA%/ufb/device_id.txt
@@ -4,6 +4,8 @@
 #include <vector>
 #include <map>
 #include <queue>
+#include <deque>
+#include <utility>
 #include <set>
 #include <thread>
 #include <mutex>
@@ -18,6 +20,8 @@
 #include "project_config.h"
 #include "file_watcher.h"
 #include "p2p_manager.h"
+#include "sync_summary.h"
+#include "pushed_entries.h"
 
 namespace UFB {
 
@@ -97,6 +101,18 @@ private:
     std::map<std::wstring, ExpectedChange> m_expectedChanges;  // jobPath -> expected change
     std::mutex m_expectedChangesMutex;
 
+    // P2P entry shipping (entries travel with CHANGE_NOTIFY / SYNC_RESPONSE; the share stays the durable copy)
+    static constexpr size_t kRecentEntryLimit = 256;      // Own entries kept per job to answer SYNC_REQUEST from memory
+    static constexpr size_t kSyncResponseLimit = kP2PMaxEntriesPerMessage;    // Entries per SYNC_RESPONSE
+    std::map<std::wstring, std::deque<ChangeLogEntry>> m_recentEntries;  // jobPath -> own entries pushed this session
+    std::mutex m_recentEntriesMutex;
+    PushedEntryTracker m_pushedEntries;  // Newest pushed entry applied per job and sender (gap detection)
+    std::mutex m_applyMutex;  // Serializes cache updates (sync worker and P2P pushes)
+
+    // Anti-entropy: job summaries are exchanged with peers on connect and periodically (see SyncSummary)
+    static constexpr uint64_t kSummaryIntervalMs = 60000;
+    uint64_t m_lastSummaryTime = 0;  // Sync thread only
+
     // Sync loop (fallback polling)
     void SyncLoop();
     void SyncTick();
@@ -136,6 +152,13 @@ private:
     // P2P networking
     void SetupP2PForJob(const std::wstring& jobPath);
     void OnP2PChangeReceived(const std::wstring& jobPath, const std::wstring& peerDeviceId, uint64_t timestamp);
+    bool OnP2PEntriesReceived(const P2PChangeBatch& batch);
+    void OnLocalChange(const std::wstring& jobPath, uint64_t timestamp, const ChangeLogEntry& entry);
+    nlohmann::json GetOwnEntriesSince(const std::wstring& jobPath, uint64_t sinceTimestamp);
+    void SendSyncSummaries(const std::wstring& peerDeviceId);
+    void OnSyncSummaryReceived(const std::wstring& peerDeviceId, const std::wstring& jobPath, const nlohmann::json& summaryJson);
+    nlohmann::json GetShotsInBuckets(const std::wstring& jobPath, const std::vector<uint32_t>& buckets,
+                                     const std::vector<uint64_t>& knownShots);
     std::wstring GetOrCreateDeviceId();
 
     // Shot metadata discovery
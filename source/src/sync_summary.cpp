@@ -0,0 +1,142 @@
+#include "sync_summary.h"
+#include "metadata_manager.h"
+#include "xxhash64.h"
+#include "utils.h"
+#include <algorithm>
+
+namespace UFB {
+
+uint32_t SyncSummary::BucketOf(const std::wstring& shotPath)
+{
+    // UTF-8 so the bucket doesn't depend on the platform's wchar_t size
+    std::string pathUtf8 = WideToUtf8(shotPath);
+
+    XxHash64 hash;
+    hash.Update(reinterpret_cast<const uint8_t*>(pathUtf8.data()), pathUtf8.size());
+    return static_cast<uint32_t>(hash.Digest() % kBucketCount);
+}
+
+uint64_t SyncSummary::HashShot(const Shot& shot)
+{
+    std::string pathUtf8 = WideToUtf8(shot.shotPath);
+
+    XxHash64 hash;
+    hash.Update(reinterpret_cast<const uint8_t*>(pathUtf8.data()), pathUtf8.size() + 1);  // Include the terminator as separator
+    uint8_t modified[8];
+    for (int i = 0; i < 8; i++)
+        modified[i] = static_cast<uint8_t>(shot.modifiedTime >> (8 * i));
+    hash.Update(modified, sizeof(modified));
+    hash.Update(reinterpret_cast<const uint8_t*>(shot.deviceId.data()), shot.deviceId.size());
+    return hash.Digest();
+}
+
+SyncSummary SyncSummary::Build(const std::vector<Shot>& shots)
+{
+    SyncSummary summary;
+    summary.buckets.assign(kBucketCount, 0);
+
+    for (const auto& shot : shots)
+    {
+        summary.buckets[BucketOf(shot.shotPath)] ^= HashShot(shot);
+
+        uint64_t& newest = summary.versionVector[shot.deviceId];
+        newest = (std::max)(newest, shot.modifiedTime);
+    }
+
+    // Root over the bucket hashes (order matters here, unlike within a bucket)
+    XxHash64 rootHash;
+    for (uint64_t bucket : summary.buckets)
+    {
+        uint8_t bytes[8];
+        for (int i = 0; i < 8; i++)
+            bytes[i] = static_cast<uint8_t>(bucket >> (8 * i));
+        rootHash.Update(bytes, sizeof(bytes));
+    }
+    summary.root = shots.empty() ? 0 : rootHash.Digest();
+
+    return summary;
+}
+
+SyncSummary SyncSummary::Compact() const
+{
+    SyncSummary compact;
+    compact.versionVector = versionVector;
+    compact.root = root;
+    return compact;
+}
+
+bool SyncSummary::IsBehind(const SyncSummary& other) const
+{
+    for (const auto& [deviceId, timestamp] : other.versionVector)
+    {
+        auto it = versionVector.find(deviceId);
+        if (it == versionVector.end() || it->second < timestamp)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<uint32_t> SyncSummary::DifferingBuckets(const SyncSummary& other) const
+{
+    std::vector<uint32_t> differing;
+    if (!IsFull() || !other.IsFull())
+    {
+        return differing;
+    }
+
+    for (uint32_t i = 0; i < kBucketCount; i++)
+    {
+        if (buckets[i] != other.buckets[i])
+        {
+            differing.push_back(i);
+        }
+    }
+    return differing;
+}
+
+nlohmann::json SyncSummary::ToJson() const
+{
+    nlohmann::json j = {
+        {"versionVector", versionVector},
+        {"root", root}
+    };
+
+    if (IsFull())
+    {
+        j["buckets"] = buckets;
+    }
+    return j;
+}
+
+bool SyncSummary::FromJson(const nlohmann::json& j, SyncSummary& outSummary)
+{
+    try
+    {
+        if (!j.is_object() || !j.contains("versionVector") || !j["versionVector"].is_object())
+        {
+            return false;
+        }
+
+        outSummary.versionVector = j["versionVector"].get<std::map<std::string, uint64_t>>();
+        outSummary.root = j.value("root", uint64_t(0));
+        outSummary.buckets.clear();
+
+        if (j.contains("buckets"))
+        {
+            outSummary.buckets = j["buckets"].get<std::vector<uint64_t>>();
+            if (outSummary.buckets.size() != kBucketCount)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+} // namespace UFB
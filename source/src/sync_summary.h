@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include "nlohmann/json.hpp"
+
+namespace UFB {
+
+struct Shot;
+
+// Anti-entropy summary of a job's materialized shot state (the sync cache), exchanged between peers
+// so they can find out cheaply whether and where their states differ
+//
+// - Version vector: per device, the newest modifiedTime among shots it wrote last. A peer whose
+//   vector has a newer value for some device holds writes we haven't seen
+// - Range hashes: shots are spread over kBucketCount buckets by a hash of their path; a bucket hash
+//   is the XOR of its shot hashes (path, modifiedTime, deviceId), the root hash combines the buckets
+//
+// Exchange (P2P SYNC_SUMMARY / RANGE_REQUEST / RANGE_RESPONSE):
+// 1. On connect and periodically, each peer sends a compact summary (vector + root) per job
+// 2. A receiver whose root differs answers with its full summary (vector + root + buckets)
+// 3. A receiver of a full summary that is behind requests the buckets that differ, listing the shot
+//    hashes it has there, and gets back the peer's shots in those buckets it didn't list; they're
+//    applied last-writer-wins like any remote change
+class SyncSummary
+{
+public:
+    static constexpr uint32_t kBucketCount = 64;
+
+    std::map<std::string, uint64_t> versionVector;  // deviceId -> newest modifiedTime
+    uint64_t root = 0;
+    std::vector<uint64_t> buckets;                  // kBucketCount hashes, empty in a compact summary
+
+    static SyncSummary Build(const std::vector<Shot>& shots);
+
+    static uint32_t BucketOf(const std::wstring& shotPath);
+    static uint64_t HashShot(const Shot& shot);
+
+    bool IsFull() const { return buckets.size() == kBucketCount; }
+    SyncSummary Compact() const;
+
+    // True if other knows a newer write of some device than we do
+    bool IsBehind(const SyncSummary& other) const;
+
+    // Buckets whose hashes differ (both summaries must be full)
+    std::vector<uint32_t> DifferingBuckets(const SyncSummary& other) const;
+
+    nlohmann::json ToJson() const;
+    static bool FromJson(const nlohmann::json& j, SyncSummary& outSummary);
+};
+
+} // namespace UFB
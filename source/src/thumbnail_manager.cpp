@@ -275,6 +275,27 @@ bool ThumbnailManager::IsLoading(const std::wstring& path)
     return m_inFlightPaths.find(path) != m_inFlightPaths.end();
 }
 
+void ThumbnailManager::InvalidateThumbnail(const std::wstring& path)
+{
+    unsigned int textureToDelete = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        auto it = m_cache.find(path);
+        if (it == m_cache.end())
+            return;
+
+        textureToDelete = it->second.glTexture;
+        m_cache.erase(it);
+    }
+
+    // Delete texture outside lock (same as size-change eviction in RequestThumbnail)
+    if (textureToDelete)
+    {
+        TextureUtils::DeleteTexture(textureToDelete);
+    }
+}
+
 void ThumbnailManager::ClearCache()
 {
     std::lock_guard<std::mutex> lock(m_cacheMutex);
@@ -82,6 +82,9 @@ public:
     // Check if thumbnail is currently loading
     bool IsLoading(const std::wstring& path);
 
+    // Drop one cached thumbnail so it is extracted again on next request (file changed on disk)
+    void InvalidateThumbnail(const std::wstring& path);
+
     // Clear all cached thumbnails
     void ClearCache();
 
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace UFB {
+
+// 64-bit xxHash (XXH64, seed 0), streaming
+// Used for copy verification and the file hash cache; matches the reference xxhsum -H1 output
+class XxHash64
+{
+public:
+    void Update(const uint8_t* data, size_t length)
+    {
+        m_total += length;
+
+        if (m_bufferSize + length < 32)
+        {
+            memcpy(m_buffer + m_bufferSize, data, length);
+            m_bufferSize += length;
+            return;
+        }
+
+        const uint8_t* end = data + length;
+
+        if (m_bufferSize > 0)
+        {
+            size_t fill = 32 - m_bufferSize;
+            memcpy(m_buffer + m_bufferSize, data, fill);
+            data += fill;
+            m_v[0] = Round(m_v[0], Read64(m_buffer));
+            m_v[1] = Round(m_v[1], Read64(m_buffer + 8));
+            m_v[2] = Round(m_v[2], Read64(m_buffer + 16));
+            m_v[3] = Round(m_v[3], Read64(m_buffer + 24));
+            m_bufferSize = 0;
+        }
+
+        while (end - data >= 32)
+        {
+            m_v[0] = Round(m_v[0], Read64(data));
+            m_v[1] = Round(m_v[1], Read64(data + 8));
+            m_v[2] = Round(m_v[2], Read64(data + 16));
+            m_v[3] = Round(m_v[3], Read64(data + 24));
+            data += 32;
+        }
+
+        m_bufferSize = static_cast<size_t>(end - data);
+        memcpy(m_buffer, data, m_bufferSize);
+    }
+
+    uint64_t Digest() const
+    {
+        uint64_t h;
+        if (m_total >= 32)
+        {
+            h = Rotl(m_v[0], 1) + Rotl(m_v[1], 7) + Rotl(m_v[2], 12) + Rotl(m_v[3], 18);
+            for (uint64_t v : m_v)
+                h = (h ^ Round(0, v)) * kPrime1 + kPrime4;
+        }
+        else
+        {
+            h = kPrime5;
+        }
+
+        h += m_total;
+
+        const uint8_t* p = m_buffer;
+        const uint8_t* end = m_buffer + m_bufferSize;
+        for (; end - p >= 8; p += 8)
+            h = Rotl(h ^ Round(0, Read64(p)), 27) * kPrime1 + kPrime4;
+        if (end - p >= 4)
+        {
+            h = Rotl(h ^ (Read32(p) * kPrime1), 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+            h = Rotl(h ^ (*p * kPrime5), 11) * kPrime1;
+
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+    static uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static uint64_t Round(uint64_t acc, uint64_t input) { return Rotl(acc + input * kPrime2, 31) * kPrime1; }
+    static uint64_t Read64(const uint8_t* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+    static uint64_t Read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+    uint64_t m_v[4] = { kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1 };
+    uint64_t m_total = 0;
+    uint8_t m_buffer[32] = {};
+    size_t m_bufferSize = 0;
+};
+
+} // namespace UFB
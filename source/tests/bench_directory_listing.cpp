@@ -0,0 +1,156 @@
+#include "directory_enumerator.h"
+#include "file_entry.h"
+#include "image_sequence.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Directory listing throughput (entries/s) and the UI-thread cost of streaming a large directory
+// into the file list: per-batch rebuilds (each one copies, collapses and sorts the whole listing)
+// against FileBrowser's append-and-throttle. Usage: bench_directory_listing [entries, default 100000]
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// As FileBrowser: rows rebuilt at most this often while a listing streams in
+constexpr double kStreamRebuildInterval = 0.25;
+
+// One UI frame
+constexpr auto kFrame = std::chrono::milliseconds(16);
+
+double Seconds(Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+// 100-frame sequences plus loose files, like a render output folder
+void CreateTree(const std::filesystem::path& directory, size_t count)
+{
+    std::filesystem::create_directories(directory);
+    for (size_t i = 0; i < count; i++)
+    {
+        char name[64];
+        if (i % 10 == 0)
+            std::snprintf(name, sizeof(name), "notes_%zu.txt", i);
+        else
+            std::snprintf(name, sizeof(name), "shot%03zu_comp.%04zu.exr", i / 100, 1001 + i % 100);
+
+        if (FILE* file = std::fopen((directory / name).string().c_str(), "wb"))
+            std::fclose(file);
+    }
+}
+
+// FileBrowser::RebuildFileList without the UI: copy, collapse sequences, sort by name
+void RebuildRows(const std::vector<FileEntry>& entries, std::vector<FileEntry>& rows)
+{
+    rows.assign(entries.begin(), entries.end());
+    UFB::CollapseImageSequences(rows);
+    std::sort(rows.begin(), rows.end(), [](const FileEntry& a, const FileEntry& b) { return a.name < b.name; });
+}
+
+struct StreamResult
+{
+    double wallSeconds = 0.0;
+    double uiSeconds = 0.0;     // Time the UI thread spent merging and rebuilding
+    size_t rebuilds = 0;
+    size_t rows = 0;
+};
+
+// Enumerate on the worker, poll once per frame on this thread
+StreamResult Stream(const std::wstring& path, bool throttled)
+{
+    UFB::DirectoryEnumerator enumerator;
+    std::vector<FileEntry> listing;     // m_directoryEntries
+    std::vector<FileEntry> pending;     // m_pendingEntries (per-batch policy)
+    std::vector<FileEntry> rows;        // m_files
+    StreamResult result;
+
+    const Clock::time_point start = Clock::now();
+    double lastRebuild = -kStreamRebuildInterval;
+    enumerator.Start(path, false);
+
+    for (;;)
+    {
+        std::vector<FileEntry> batch;
+        bool complete = false;
+        bool failed = false;
+        if (!enumerator.Poll(batch, complete, failed))
+        {
+            std::this_thread::sleep_for(kFrame);
+            continue;
+        }
+
+        const Clock::time_point frameStart = Clock::now();
+        if (throttled)
+        {
+            listing.insert(listing.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+            double now = Seconds(frameStart - start);
+            if (complete || now - lastRebuild >= kStreamRebuildInterval)
+            {
+                lastRebuild = now;
+                RebuildRows(listing, rows);
+                result.rebuilds++;
+            }
+        }
+        else
+        {
+            pending.insert(pending.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+            listing = pending;
+            RebuildRows(listing, rows);
+            result.rebuilds++;
+        }
+        result.uiSeconds += Seconds(Clock::now() - frameStart);
+
+        if (complete)
+            break;
+        std::this_thread::sleep_for(kFrame);
+    }
+
+    result.wallSeconds = Seconds(Clock::now() - start);
+    result.rows = rows.size();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "ufb_bench_directory_listing";
+    std::filesystem::remove_all(directory);
+
+    std::printf("Directory listing, %zu files\n", count);
+    Clock::time_point start = Clock::now();
+    CreateTree(directory, count);
+    std::printf("  created in %.2f s\n", Seconds(Clock::now() - start));
+
+    // Bulk read, warm cache: best of several
+    double best = 1e30;
+    size_t listed = 0;
+    for (int run = 0; run < 5; run++)
+    {
+        std::vector<FileEntry> entries;
+        start = Clock::now();
+        UFB::ListDirectory(directory.wstring(), false, entries);
+        best = (std::min)(best, Seconds(Clock::now() - start));
+        listed = entries.size();
+    }
+    std::printf("  ListDirectory           %8.1f ms  %6.2f Mentries/s  (%zu entries)\n", best * 1000.0,
+                listed / best / 1e6, listed);
+
+    for (bool throttled : { false, true })
+    {
+        StreamResult result = Stream(directory.wstring(), throttled);
+        std::printf("  %-23s %8.1f ms wall, %8.1f ms UI thread, %4zu rebuilds -> %zu rows\n",
+                    throttled ? "stream, throttled" : "stream, every batch", result.wallSeconds * 1000.0,
+                    result.uiSeconds * 1000.0, result.rebuilds, result.rows);
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,170 @@
+#define NOMINMAX
+#include "extractors/exr_extractor.h"
+#include <OpenEXR/ImfChannelList.h>
+#include <OpenEXR/ImfFrameBuffer.h>
+#include <OpenEXR/ImfHeader.h>
+#include <OpenEXR/ImfOutputFile.h>
+#include <OpenEXR/ImfTiledOutputFile.h>
+#include <Imath/half.h>
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// EXRExtractor::Extract time per file for the layouts the extractor handles differently:
+// single-line chunks (row sampling), multi-line chunks (bands), tiles with and without mips.
+// The fixtures are written to a temp directory first (4K half RGBA with a gradient and noise).
+namespace {
+
+const int kWidth = 3840;
+const int kHeight = 2160;
+const int kThumbnailSize = 256;
+const int kRuns = 5;
+
+struct Fixture
+{
+    const char* name;
+    Imf::Compression compression;
+    bool tiled;
+    Imf::LevelMode levels;
+};
+
+std::vector<Imath::half> MakePixels()
+{
+    std::vector<Imath::half> pixels(static_cast<size_t>(kWidth) * kHeight * 4);
+    uint32_t seed = 12345;
+    for (int y = 0; y < kHeight; y++)
+    {
+        for (int x = 0; x < kWidth; x++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            float noise = static_cast<float>(seed >> 8) / 16777216.0f * 0.05f;
+            size_t i = (static_cast<size_t>(y) * kWidth + x) * 4;
+            pixels[i + 0] = Imath::half(4.0f * x / kWidth + noise);
+            pixels[i + 1] = Imath::half(2.0f * y / kHeight + noise);
+            pixels[i + 2] = Imath::half(0.5f + 0.5f * std::sin(x * 0.01f) + noise);
+            pixels[i + 3] = Imath::half(1.0f);
+        }
+    }
+    return pixels;
+}
+
+void InsertSlices(Imf::FrameBuffer& frameBuffer, std::vector<Imath::half>& pixels)
+{
+    char* base = reinterpret_cast<char*>(pixels.data());
+    const size_t xStride = 4 * sizeof(Imath::half);
+    const size_t yStride = xStride * kWidth;
+    const char* channels[] = { "R", "G", "B", "A" };
+    for (int c = 0; c < 4; c++)
+    {
+        frameBuffer.insert(channels[c], Imf::Slice(Imf::HALF, base + c * sizeof(Imath::half), xStride, yStride));
+    }
+}
+
+void WriteFixture(const std::string& path, const Fixture& fixture, std::vector<Imath::half>& pixels)
+{
+    Imf::Header header(kWidth, kHeight);
+    header.compression() = fixture.compression;
+    for (const char* channel : { "R", "G", "B", "A" })
+    {
+        header.channels().insert(channel, Imf::Channel(Imf::HALF));
+    }
+
+    Imf::FrameBuffer frameBuffer;
+    InsertSlices(frameBuffer, pixels);
+
+    if (!fixture.tiled)
+    {
+        Imf::OutputFile file(path.c_str(), header);
+        file.setFrameBuffer(frameBuffer);
+        file.writePixels(kHeight);
+        return;
+    }
+
+    header.setTileDescription(Imf::TileDescription(64, 64, fixture.levels, Imf::ROUND_DOWN));
+    Imf::TiledOutputFile file(path.c_str(), header);
+    file.setFrameBuffer(frameBuffer);
+    file.writeTiles(0, file.numXTiles(0) - 1, 0, file.numYTiles(0) - 1, 0);
+
+    // Lower mip levels: point-sampled from the full level, good enough for timing reads
+    for (int level = 1; fixture.levels == Imf::MIPMAP_LEVELS && level < file.numLevels(); level++)
+    {
+        const int levelWidth = file.levelWidth(level);
+        const int levelHeight = file.levelHeight(level);
+        std::vector<Imath::half> levelPixels(static_cast<size_t>(levelWidth) * levelHeight * 4);
+        for (int y = 0; y < levelHeight; y++)
+        {
+            for (int x = 0; x < levelWidth; x++)
+            {
+                size_t src = (static_cast<size_t>(y << level) * kWidth + (x << level)) * 4;
+                std::copy_n(&pixels[src], 4, &levelPixels[(static_cast<size_t>(y) * levelWidth + x) * 4]);
+            }
+        }
+
+        Imf::FrameBuffer levelBuffer;
+        char* base = reinterpret_cast<char*>(levelPixels.data());
+        const size_t xStride = 4 * sizeof(Imath::half);
+        const char* channels[] = { "R", "G", "B", "A" };
+        for (int c = 0; c < 4; c++)
+        {
+            levelBuffer.insert(channels[c], Imf::Slice(Imf::HALF, base + c * sizeof(Imath::half), xStride,
+                                                       xStride * levelWidth));
+        }
+        file.setFrameBuffer(levelBuffer);
+        file.writeTiles(0, file.numXTiles(level) - 1, 0, file.numYTiles(level) - 1, level);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    const Fixture fixtures[] = {
+        { "scanline NONE",  Imf::NO_COMPRESSION,   false, Imf::ONE_LEVEL },
+        { "scanline ZIPS",  Imf::ZIPS_COMPRESSION, false, Imf::ONE_LEVEL },
+        { "scanline ZIP",   Imf::ZIP_COMPRESSION,  false, Imf::ONE_LEVEL },
+        { "scanline PIZ",   Imf::PIZ_COMPRESSION,  false, Imf::ONE_LEVEL },
+        { "scanline DWAA",  Imf::DWAA_COMPRESSION, false, Imf::ONE_LEVEL },
+        { "tiled ZIP",      Imf::ZIP_COMPRESSION,  true,  Imf::ONE_LEVEL },
+        { "tiled ZIP mips", Imf::ZIP_COMPRESSION,  true,  Imf::MIPMAP_LEVELS },
+    };
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "ufb_bench_exr_decode";
+    std::filesystem::create_directories(directory);
+
+    std::vector<Imath::half> pixels = MakePixels();
+    EXRExtractor extractor;
+
+    std::printf("EXRExtractor::Extract, %dx%d half RGBA -> %dpx thumbnail (best of %d)\n",
+                kWidth, kHeight, kThumbnailSize, kRuns);
+
+    for (const Fixture& fixture : fixtures)
+    {
+        std::string fileName = fixture.name;
+        std::replace(fileName.begin(), fileName.end(), ' ', '_');
+        std::filesystem::path path = directory / (fileName + ".exr");
+        WriteFixture(path.string(), fixture, pixels);
+
+        double best = 1e30;
+        bool ok = true;
+        for (int run = 0; run < kRuns; run++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            HBITMAP bitmap = extractor.Extract(path.wstring(), kThumbnailSize);
+            best = (std::min)(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            ok = ok && bitmap != nullptr;
+            if (bitmap)
+                DeleteObject(bitmap);
+        }
+
+        std::printf("  %-15s %8.1f ms  %6.1f MB on disk%s\n", fixture.name, best,
+                    std::filesystem::file_size(path) / (1024.0 * 1024.0), ok ? "" : "  (extract failed)");
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
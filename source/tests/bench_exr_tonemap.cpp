@@ -0,0 +1,83 @@
+#include "extractors/exr_tonemap.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace ExrTonemap;
+
+// Throughput of each tonemapping kernel on a 4K RGBA half (and float) image (Mpixels/s, best of several runs)
+int main()
+{
+    const size_t width = 3840;
+    const size_t height = 2160;
+    const size_t pixelCount = width * height;
+    const int runs = 10;
+
+    // Plausible scene values: mostly [0, 4], a few negatives, alpha in [0, 1]
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> color(0x0000, 0x4400);
+    std::uniform_int_distribution<int> alpha(0x0000, 0x3C00);
+    std::vector<uint16_t> src(pixelCount * 4);
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        src[i * 4 + 0] = static_cast<uint16_t>(color(rng));
+        src[i * 4 + 1] = static_cast<uint16_t>(color(rng));
+        src[i * 4 + 2] = static_cast<uint16_t>(color(rng) | (i % 97 == 0 ? 0x8000 : 0));
+        src[i * 4 + 3] = static_cast<uint16_t>(alpha(rng));
+    }
+    std::vector<uint8_t> dst(pixelCount * 4);
+
+    std::printf("ExrTonemap: %zux%zu half RGBA -> BGRA8, dispatched kernel: %s\n", width, height, GetActiveKernelName());
+
+    for (Kernel kernel : { Kernel::Scalar, Kernel::SSE2, Kernel::AVXF16C })
+    {
+        if (!IsKernelAvailable(kernel))
+        {
+            std::printf("  %-9s not available\n", GetKernelName(kernel));
+            continue;
+        }
+
+        for (bool premultiply : { false, true })
+        {
+            Params params;
+            params.premultiplyAlpha = premultiply;
+
+            double best = 1e30;
+            for (int run = 0; run < runs; ++run)
+            {
+                auto start = std::chrono::steady_clock::now();
+                ConvertHalfRGBAToBGRA8With(kernel, src.data(), dst.data(), pixelCount, params);
+                best = (std::min)(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            std::printf("  %-9s %-13s %8.1f Mpix/s  (%.2f ms)\n", GetKernelName(kernel),
+                        premultiply ? "premultiplied" : "straight", pixelCount / best / 1e6, best * 1000.0);
+        }
+    }
+
+    // Float input (the EXR extractor tonemaps the downscaler's float output)
+    std::vector<float> floatSrc(src.size());
+    for (size_t i = 0; i < src.size(); ++i)
+        floatSrc[i] = static_cast<float>(src[i] & 0x3FFF) / 4096.0f;
+
+    for (Kernel kernel : { Kernel::Scalar, Kernel::SSE2, Kernel::AVXF16C })
+    {
+        if (!IsKernelAvailable(kernel))
+            continue;
+
+        Params params;
+        double best = 1e30;
+        for (int run = 0; run < runs; ++run)
+        {
+            auto start = std::chrono::steady_clock::now();
+            ConvertFloatRGBAToBGRA8With(kernel, floatSrc.data(), dst.data(), pixelCount, params);
+            best = (std::min)(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::printf("  %-9s %-13s %8.1f Mpix/s  (%.2f ms)\n", GetKernelName(kernel), "float input",
+                    pixelCount / best / 1e6, best * 1000.0);
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "copy_skip.h"
+#include "xxhash64.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Content hashing throughput (GB/s) on a temp tree, and the cost of a copy's second pass over a
+// tree that is already at the destination (stamps only, nothing read).
+// Usage: bench_file_hash [tree size in MB, default 1024]
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kReadBlock = 4 * 1024 * 1024;
+
+double Seconds(Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+// Large plates plus many small files, like a delivery folder
+std::vector<std::filesystem::path> CreateTree(const std::filesystem::path& root, uint64_t totalBytes)
+{
+    std::vector<std::filesystem::path> files;
+    std::vector<uint8_t> block(kReadBlock);
+    for (size_t i = 0; i < block.size(); i++)
+        block[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+
+    std::filesystem::create_directories(root / "plates");
+    std::filesystem::create_directories(root / "small");
+    uint64_t written = 0;
+    for (int i = 0; written < totalBytes; i++)
+    {
+        // Every fourth slot is a burst of 64 small files
+        const bool small = i % 4 == 3;
+        const int count = small ? 64 : 1;
+        const uint64_t size = small ? 64 * 1024 : 16ull * 1024 * 1024;
+        for (int n = 0; n < count; n++)
+        {
+            char name[64];
+            std::snprintf(name, sizeof(name), small ? "small/f%d_%d.bin" : "plates/p%d.bin", i, n);
+            std::filesystem::path path = root / name;
+            if (FILE* file = std::fopen(path.string().c_str(), "wb"))
+            {
+                for (uint64_t left = size; left > 0;)
+                {
+                    size_t chunk = static_cast<size_t>((std::min)(left, static_cast<uint64_t>(block.size())));
+                    std::fwrite(block.data(), 1, chunk, file);
+                    left -= chunk;
+                }
+                std::fclose(file);
+            }
+            files.push_back(path);
+            written += size;
+        }
+    }
+    return files;
+}
+
+uint64_t HashFile(const std::filesystem::path& path, std::vector<uint8_t>& buffer, uint64_t& bytesRead)
+{
+    UFB::XxHash64 hash;
+    if (FILE* file = std::fopen(path.string().c_str(), "rb"))
+    {
+        size_t read;
+        while ((read = std::fread(buffer.data(), 1, buffer.size(), file)) > 0)
+        {
+            hash.Update(buffer.data(), read);
+            bytesRead += read;
+        }
+        std::fclose(file);
+    }
+    return hash.Digest();
+}
+
+// Files handed out to a pool of threads, as FileHashService::HashFiles
+double HashTree(const std::vector<std::filesystem::path>& files, int threadCount, uint64_t& outBytes)
+{
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> bytes{0};
+    std::vector<std::thread> threads;
+    const Clock::time_point start = Clock::now();
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&]() {
+            std::vector<uint8_t> buffer(kReadBlock);
+            uint64_t read = 0;
+            for (size_t i; (i = next++) < files.size();)
+                HashFile(files[i], buffer, read);
+            bytes += read;
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    outBytes = bytes;
+    return Seconds(Clock::now() - start);
+}
+
+UFB::FileStamp StampOf(const std::filesystem::path& path)
+{
+    UFB::FileStamp stamp;
+    stamp.size = std::filesystem::file_size(path);
+    stamp.lastWriteTime = static_cast<uint64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+    return stamp;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint64_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "ufb_bench_file_hash";
+    std::filesystem::remove_all(root);
+
+    // Hashing alone, from memory
+    {
+        std::vector<uint8_t> buffer(256 * 1024 * 1024);
+        for (size_t i = 0; i < buffer.size(); i++)
+            buffer[i] = static_cast<uint8_t>(i * 31);
+        double best = 1e30;
+        for (int run = 0; run < 5; run++)
+        {
+            Clock::time_point start = Clock::now();
+            UFB::XxHash64 hash;
+            hash.Update(buffer.data(), buffer.size());
+            volatile uint64_t digest = hash.Digest();
+            (void)digest;
+            best = (std::min)(best, Seconds(Clock::now() - start));
+        }
+        std::printf("XXH64 in memory, 256 MB: %6.2f GB/s\n", buffer.size() / best / 1e9);
+    }
+
+    std::printf("Temp tree, %llu MB\n", static_cast<unsigned long long>(megabytes));
+    Clock::time_point start = Clock::now();
+    const std::vector<std::filesystem::path> files = CreateTree(root / "src", megabytes * 1024 * 1024);
+    std::printf("  created %zu files in %.2f s\n", files.size(), Seconds(Clock::now() - start));
+
+    // Read + hash (page cache is warm after creating the tree; a cold share reads slower)
+    for (int threads : { 1, 2, 4, 8 })
+    {
+        uint64_t bytes = 0;
+        double seconds = HashTree(files, threads, bytes);
+        std::printf("  read + hash, %d thread(s)   %6.2f GB/s\n", threads, bytes / seconds / 1e9);
+    }
+
+    // Second pass of a copy that already completed: stamps only
+    std::filesystem::copy(root / "src", root / "dst", std::filesystem::copy_options::recursive);
+    for (const std::filesystem::path& file : files)
+        std::filesystem::last_write_time(root / "dst" / std::filesystem::relative(file, root / "src"),
+                                         std::filesystem::last_write_time(file));
+
+    auto noCache = [](const std::wstring&, const UFB::FileStamp&) -> std::optional<uint64_t> { return std::nullopt; };
+    start = Clock::now();
+    size_t skipped = 0;
+    for (const std::filesystem::path& file : files)
+    {
+        std::filesystem::path dest = root / "dst" / std::filesystem::relative(file, root / "src");
+        if (UFB::IsUnchangedAtDestination(file.wstring(), StampOf(file), dest.wstring(), StampOf(dest), noCache))
+            skipped++;
+    }
+    double seconds = Seconds(Clock::now() - start);
+    std::printf("  unchanged re-copy          %6.1f ms, %zu of %zu files skipped (%.2f GB/s effective)\n",
+                seconds * 1000.0, skipped, files.size(), megabytes * 1024.0 * 1024.0 / seconds / 1e9);
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
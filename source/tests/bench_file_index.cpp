@@ -0,0 +1,106 @@
+#include "file_index_table.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// FileIndexTable on a synthetic job tree: build time, size and query latency (selective substrings,
+// 1-2 character terms that scan every block, extensions, globs, path terms).
+// Usage: bench_file_index [entries, default 5000000]
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using UFB::FileIndexTable;
+
+double Milliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// show/shots/shNNNN/{comp,plates,renders/vNNN}/... with frame-numbered files, like a job share
+void Build(FileIndexTable& table, size_t count)
+{
+    const char* const extensions[] = { "exr", "dpx", "tif", "jpg", "nk", "mov" };
+    table.path = L"P:\\show";
+    table.AddEntry(FileIndexTable::kNoEntry, "", FileIndexTable::kDirectory, 0, 0);
+    uint32_t shots = table.AddEntry(0, "shots", FileIndexTable::kDirectory, 0, 0);
+
+    char name[96];
+    for (int shot = 0; table.entries.size() < count; shot++)
+    {
+        std::snprintf(name, sizeof(name), "sh%04d", shot * 10);
+        const std::string shotName = name;
+        uint32_t shotFolder = table.AddEntry(shots, shotName, FileIndexTable::kDirectory, 0, 0);
+        uint32_t renders = table.AddEntry(shotFolder, "renders", FileIndexTable::kDirectory, 0, 0);
+
+        for (int version = 1; version <= 10 && table.entries.size() < count; version++)
+        {
+            std::snprintf(name, sizeof(name), "v%03d", version);
+            uint32_t folder = table.AddEntry(renders, name, FileIndexTable::kDirectory, 0, 0);
+            const char* extension = extensions[(shot + version) % 6];
+            for (int frame = 1001; frame <= 1100 && table.entries.size() < count; frame++)
+            {
+                std::snprintf(name, sizeof(name), "%s_comp_v%03d.%04d.%s", shotName.c_str(), version, frame, extension);
+                table.AddEntry(folder, name, 0, 12 * 1024 * 1024, 0);
+            }
+        }
+    }
+}
+
+void Query(const FileIndexTable& table, const wchar_t* text)
+{
+    UFB::FileIndexQuery query;
+    UFB::FileIndexQuery::Parse(text, query);
+
+    // Best of several; results capped like the browser search
+    double best = 1e30;
+    size_t found = 0;
+    size_t blocks = 0;
+    bool truncated = false;
+    for (int run = 0; run < 5; run++)
+    {
+        std::vector<UFB::FileIndexResult> results;
+        truncated = false;
+        Clock::time_point start = Clock::now();
+        table.Search(0, query, 10000, results, truncated);
+        best = (std::min)(best, Milliseconds(Clock::now() - start));
+        found = results.size();
+    }
+    blocks = table.CandidateBlocks(query).size();
+
+    std::printf("  %-28ls %9.2f ms  %6zu%s results, %7zu candidate blocks\n", text, best, found, truncated ? "+" : " ",
+                blocks);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+    FileIndexTable table;
+    Clock::time_point start = Clock::now();
+    Build(table, count);
+    double buildMs = Milliseconds(Clock::now() - start);
+
+    size_t postings = 0;
+    for (const auto& pair : table.trigramBlocks)
+        postings += pair.second.size();
+    std::printf("FileIndexTable, %zu entries\n", table.entries.size());
+    std::printf("  built in %.0f ms; %.1f MB entries, %.1f MB names, %zu trigrams, %.1f MB block lists\n", buildMs,
+                table.entries.size() * sizeof(FileIndexTable::Entry) / 1e6, table.names.size() / 1e6,
+                table.trigramBlocks.size(), postings * sizeof(uint32_t) / 1e6);
+
+    Query(table, L"sh1230_comp_v004.1050");
+    Query(table, L"sh1230");
+    Query(table, L"v004.10");
+    Query(table, L"zz");
+    Query(table, L"x");
+    Query(table, L"ext:nk");
+    Query(table, L"ext:nk;mov");
+    Query(table, L"sh12*_v00?.1001.exr");
+    Query(table, L"sh0120\\renders\\v003");
+    Query(table, L"nosuchname");
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "parallel_folder_walk.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+// StorageAnalyzer's folder walk on a temp tree: entries/s and CPU time per thread count, listing
+// from the local disk (page cache) and with a simulated per-listing round trip, as on an SMB share.
+// The listing is POSIX (opendir/readdir/fstatat) in place of FindFirstFileExW.
+// Usage: bench_folder_walk [files, default 1000000]
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using UFB::ParallelFolderWalk;
+
+// shots/shNNN/vNNN with 100 frames each, like a render tree
+void CreateTree(const std::filesystem::path& root, size_t count)
+{
+    size_t created = 0;
+    for (size_t shot = 0; created < count; shot++)
+    {
+        for (size_t version = 1; version <= 10 && created < count; version++)
+        {
+            char folder[64];
+            std::snprintf(folder, sizeof(folder), "shots/sh%04zu/v%03zu", shot * 10, version);
+            const std::filesystem::path directory = root / folder;
+            std::filesystem::create_directories(directory);
+            for (size_t frame = 0; frame < 100 && created < count; frame++, created++)
+            {
+                char name[64];
+                std::snprintf(name, sizeof(name), "comp.%04zu.exr", 1001 + frame);
+                if (FILE* file = std::fopen((directory / name).string().c_str(), "wb"))
+                    std::fclose(file);
+            }
+        }
+    }
+}
+
+struct WalkResult
+{
+    double wallSeconds = 0.0;
+    double cpuSeconds = 0.0;
+    uint64_t entries = 0;
+};
+
+WalkResult Walk(const std::filesystem::path& root, int threads, std::chrono::microseconds roundTrip)
+{
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> entries{0};
+    WalkResult result;
+
+    const std::clock_t cpuStart = std::clock();
+    const Clock::time_point start = Clock::now();
+    ParallelFolderWalk::Run({ root.wstring(), L"", 0 }, threads, running,
+        [&](size_t, ParallelFolderWalk::Folder& folder, std::vector<ParallelFolderWalk::Folder>& outSubfolders) {
+            if (roundTrip.count() > 0)
+                std::this_thread::sleep_for(roundTrip);
+
+            const std::string path = std::filesystem::path(folder.path).string();
+            DIR* directory = opendir(path.c_str());
+            if (!directory)
+                return;
+
+            uint64_t count = 0;
+            while (dirent* entry = readdir(directory))
+            {
+                const char* name = entry->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                    continue;
+
+                // Size and modification time, as FindFirstFileExW returns them
+                struct stat info;
+                if (fstatat(dirfd(directory), name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+                    continue;
+                count++;
+                if (S_ISDIR(info.st_mode))
+                {
+                    std::filesystem::path child = std::filesystem::path(path) / name;
+                    outSubfolders.push_back({ child.wstring(), folder.path, static_cast<uint64_t>(info.st_mtime) });
+                }
+            }
+            closedir(directory);
+            entries += count;
+        });
+
+    result.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result.entries = entries;
+    return result;
+}
+
+void Report(const std::filesystem::path& root, std::chrono::microseconds roundTrip)
+{
+    for (int threads : { 1, 2, 4, 8 })
+    {
+        WalkResult result = Walk(root, threads, roundTrip);
+        std::printf("  %d thread(s): %9.0f entries/s  %7.2f s wall  %7.2f s CPU  (%llu entries)\n", threads,
+                    result.entries / result.wallSeconds, result.wallSeconds, result.cpuSeconds,
+                    static_cast<unsigned long long>(result.entries));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::filesystem::path root = std::filesystem::temp_directory_path() / "ufb_bench_folder_walk";
+    std::filesystem::remove_all(root);
+
+    std::printf("Creating %zu files...\n", count);
+    CreateTree(root, count);
+    Walk(root, 1, std::chrono::microseconds(0));     // Warm the page cache
+
+    std::printf("Local listing\n");
+    Report(root, std::chrono::microseconds(0));
+    std::printf("2 ms round trip per listing (network share)\n");
+    Report(root, std::chrono::microseconds(2000));
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
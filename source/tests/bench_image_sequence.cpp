@@ -0,0 +1,74 @@
+#include "image_sequence.h"
+#include "file_entry.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// CollapseImageSequences on 100,000-entry listings (ms and Mentries/s, best of several runs)
+namespace {
+
+const size_t kEntries = 100000;
+const int kRuns = 10;
+
+FileEntry MakeFile(const std::wstring& name)
+{
+    FileEntry entry;
+    entry.name = name;
+    entry.fullPath = L"//server/projects/show/shots/" + name;
+    entry.isDirectory = false;
+    entry.size = 12345;
+    entry.lastModified = std::filesystem::file_time_type{};
+    return entry;
+}
+
+// framesPerSequence = 1: no sequences at all (every name still parses as a frame)
+std::vector<FileEntry> MakeListing(size_t framesPerSequence, bool shuffle)
+{
+    std::vector<FileEntry> entries;
+    entries.reserve(kEntries);
+    for (size_t i = 0; entries.size() < kEntries; i++)
+    {
+        for (size_t frame = 0; frame < framesPerSequence && entries.size() < kEntries; frame++)
+        {
+            wchar_t number[16];
+            std::swprintf(number, 16, L"%04zu", 1001 + frame);
+            entries.push_back(MakeFile(L"sh" + std::to_wstring(i) + L"_comp_v003." + number + L".exr"));
+        }
+    }
+
+    if (shuffle)
+        std::shuffle(entries.begin(), entries.end(), std::mt19937(1));
+    return entries;
+}
+
+void Run(const char* label, size_t framesPerSequence, bool shuffle)
+{
+    const std::vector<FileEntry> listing = MakeListing(framesPerSequence, shuffle);
+    double best = 1e30;
+    size_t collapsed = 0;
+    for (int run = 0; run < kRuns; run++)
+    {
+        std::vector<FileEntry> entries = listing;
+        auto start = std::chrono::steady_clock::now();
+        UFB::CollapseImageSequences(entries);
+        best = (std::min)(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        collapsed = entries.size();
+    }
+
+    std::printf("  %-28s %8.2f ms  %6.2f Mentries/s  -> %zu entries\n", label, best, kEntries / best / 1000.0, collapsed);
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("CollapseImageSequences, %zu entries (best of %d)\n", kEntries, kRuns);
+    Run("100-frame sequences, sorted", 100, false);
+    Run("100-frame sequences, shuffled", 100, true);
+    Run("2-frame sequences, shuffled", 2, true);
+    Run("no sequences", 1, false);
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include "p2p_manager.h"
+#include "p2p_sim_peers.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// CHANGE_NOTIFY fan-out from one P2PManager to simulated peers on loopback (epoll transport):
+// notify-to-received latency of isolated changes and of a 500-edit burst, and CPU time per delivered
+// message (the simulated peers' decoding runs in this process and is included).
+// Usage: bench_p2p_fanout [peers, default 200]
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+
+// Swallows P2PManager's logging while alive, so the results stay readable
+class QuietLogs
+{
+public:
+    QuietLogs() : m_out(std::cout.rdbuf(&m_null)), m_wideOut(std::wcout.rdbuf(&m_wideNull)) {}
+    ~QuietLogs()
+    {
+        std::cout.rdbuf(m_out);
+        std::wcout.rdbuf(m_wideOut);
+    }
+
+    std::streambuf* Output() const { return m_out; }
+
+private:
+    template <typename Char>
+    struct NullBuffer : std::basic_streambuf<Char>
+    {
+        typename std::basic_streambuf<Char>::int_type overflow(typename std::basic_streambuf<Char>::int_type c) override { return c; }
+    };
+
+    NullBuffer<char> m_null;
+    NullBuffer<wchar_t> m_wideNull;
+    std::streambuf* m_out;
+    std::wstreambuf* m_wideOut;
+};
+
+double Milliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+double CpuSeconds()
+{
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+json MakeEntry(const std::string& deviceId, uint64_t timestamp, const std::string& shotPath)
+{
+    return json::array({ {
+        {"deviceId", deviceId},
+        {"timestamp", timestamp},
+        {"operation", "update"},
+        {"shotPath", shotPath},
+        {"data", {{"status", "In Progress"}, {"modifiedTime", timestamp}}}
+    } });
+}
+
+bool AllReceived(const SimulatedPeers& peers, uint64_t timestamp)
+{
+    for (size_t i = 0; i < peers.Count(); i++)
+        if (peers.NewestTimestamp(i, UFB::P2PMessageType::CHANGE_NOTIFY) < timestamp)
+            return false;
+    return true;
+}
+
+// When each peer got the CHANGE_NOTIFY carrying timestamp (or a newer one)
+std::vector<Clock::time_point> ReceiveTimes(const SimulatedPeers& peers, uint64_t timestamp)
+{
+    std::vector<Clock::time_point> times;
+    for (size_t i = 0; i < peers.Count(); i++)
+    {
+        for (const auto& received : peers.Messages(i, UFB::P2PMessageType::CHANGE_NOTIFY))
+        {
+            if (received.message.timestamp >= timestamp)
+            {
+                times.push_back(received.when);
+                break;
+            }
+        }
+    }
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t peerCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200;
+
+    std::ios::sync_with_stdio(false);
+    QuietLogs quiet;
+    std::ostream results(quiet.Output());
+    results << std::fixed << std::setprecision(2);
+
+    const std::string suffix = std::to_string(getpid());
+    const std::string hubId = "bench-hub-" + suffix;
+    const std::wstring jobPath = L"/jobs/fanout";
+
+    UFB::P2PManager hub;
+    if (!hub.Initialize(std::wstring(hubId.begin(), hubId.end())) || !hub.StartListening(0))
+    {
+        results << "Failed to start the P2P manager" << std::endl;
+        return 1;
+    }
+
+    SimulatedPeers peers;
+    if (!peers.Connect("bench-peer-" + suffix, hub.GetListeningPort(), peerCount))
+    {
+        results << "Failed to connect the simulated peers" << std::endl;
+        return 1;
+    }
+    if (!SimulatedPeers::WaitFor([&]() { return hub.GetPeerCount() >= peerCount; }, std::chrono::seconds(30)))
+    {
+        results << "Only " << hub.GetPeerCount() << " of " << peerCount << " peers registered" << std::endl;
+        return 1;
+    }
+
+    results << "CHANGE_NOTIFY fan-out to " << peerCount << " simulated peers" << std::endl;
+
+    // Isolated changes: each goes out right away (past the coalescing window of the previous one)
+    const int rounds = 50;
+    uint64_t timestamp = 1000;
+    std::vector<double> firstMs;
+    std::vector<double> lastMs;
+    double cpuMs = 0.0;
+    for (int round = 0; round < rounds; round++)
+    {
+        timestamp++;
+        const double cpuStart = CpuSeconds();
+        const Clock::time_point start = Clock::now();
+        hub.NotifyPeersOfChange(jobPath, timestamp, MakeEntry(hubId, timestamp, "shots/sh0010"), timestamp - 1);
+
+        bool received = SimulatedPeers::WaitFor([&]() { return AllReceived(peers, timestamp); }, std::chrono::seconds(10));
+        cpuMs += (CpuSeconds() - cpuStart) * 1000.0;
+        std::vector<Clock::time_point> times = ReceiveTimes(peers, timestamp);
+        if (!received || times.size() != peerCount)
+        {
+            results << "  round " << round << ": only " << times.size() << " peers received the change" << std::endl;
+            continue;
+        }
+
+        firstMs.push_back(Milliseconds(times.front() - start));
+        lastMs.push_back(Milliseconds(times.back() - start));
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    }
+
+    std::sort(firstMs.begin(), firstMs.end());
+    std::sort(lastMs.begin(), lastMs.end());
+    if (!lastMs.empty())
+    {
+        results << "  single change:  first peer " << std::setw(7) << firstMs[firstMs.size() / 2]
+                << " ms, last peer " << std::setw(7) << lastMs[lastMs.size() / 2] << " ms median, "
+                << std::setw(7) << lastMs.back() << " ms max" << std::endl;
+        results << "  CPU per delivered message: " << std::setw(7) << cpuMs * 1000.0 / (rounds * peerCount)
+                << " us" << std::endl;
+    }
+
+    // Burst: 500 edits to 100 shots as fast as they come (one bulk edit)
+    std::vector<size_t> before(peerCount);
+    for (size_t i = 0; i < peerCount; i++)
+        before[i] = peers.MessageCount(i, UFB::P2PMessageType::CHANGE_NOTIFY);
+
+    const double cpuStart = CpuSeconds();
+    const Clock::time_point start = Clock::now();
+    for (int edit = 0; edit < 500; edit++)
+    {
+        timestamp++;
+        hub.NotifyPeersOfChange(jobPath, timestamp, MakeEntry(hubId, timestamp, "shots/sh" + std::to_string(edit % 100)),
+                                timestamp - 1);
+    }
+    const double issueMs = Milliseconds(Clock::now() - start);
+
+    SimulatedPeers::WaitFor([&]() { return AllReceived(peers, timestamp); }, std::chrono::seconds(30));
+    const double burstCpuMs = (CpuSeconds() - cpuStart) * 1000.0;
+    std::vector<Clock::time_point> times = ReceiveTimes(peers, timestamp);
+
+    size_t messages = 0;
+    for (size_t i = 0; i < peerCount; i++)
+        messages += peers.MessageCount(i, UFB::P2PMessageType::CHANGE_NOTIFY) - before[i];
+
+    if (times.size() == peerCount)
+    {
+        results << "  500-edit burst: issued in " << std::setw(7) << issueMs << " ms, last peer up to date after "
+                << std::setw(7) << Milliseconds(times.back() - start) << " ms, "
+                << static_cast<double>(messages) / peerCount << " messages per peer, "
+                << std::setw(7) << burstCpuMs << " ms CPU" << std::endl;
+    }
+    else
+    {
+        results << "  500-edit burst: only " << times.size() << " peers caught up" << std::endl;
+    }
+
+    peers.Stop();
+    hub.Shutdown();
+    return 0;
+}
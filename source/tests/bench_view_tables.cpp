@@ -0,0 +1,199 @@
+#include "imgui.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// UI-thread cost of one frame of a shot/asset/posting/tracker table, on a headless ImGui context
+// (no window, no renderer; NewFrame through Render). The views themselves are Win32-only, so this
+// draws their table the same way: ImGuiListClipper over rows whose display strings are built once,
+// against formatting every row every frame and against drawing every row.
+// Usage: bench_view_tables [rows, default 10000]
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kFrames = 200;
+constexpr float kRowHeight = 35.0f;     // As the views' TableNextRow min height
+
+// Source data, as FileEntry plus metadata
+struct Item
+{
+    std::wstring name;
+    std::time_t modified = 0;
+    uintmax_t size = 0;
+    int status = 0;
+};
+
+// Display strings, as ShotView::ShotRow
+struct Row
+{
+    std::string name;
+    std::string modified;
+    std::string size;
+};
+
+const char* const kStatuses[] = { "Not Started", "In Progress", "Review", "Approved", "On Hold" };
+
+std::string ToUtf8(const std::wstring& text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (wchar_t c : text)
+        result.push_back(static_cast<char>(c < 0x80 ? c : '?'));
+    return result;
+}
+
+std::string FormatTime(std::time_t time)
+{
+    char buffer[32];
+    std::tm local = *std::localtime(&time);
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M", &local);
+    return buffer;
+}
+
+std::string FormatSize(uintmax_t size)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f MB", size / (1024.0 * 1024.0));
+    return buffer;
+}
+
+Row MakeRow(const Item& item)
+{
+    return Row{ ToUtf8(item.name), FormatTime(item.modified), FormatSize(item.size) };
+}
+
+void DrawRow(int index, const Row& row, int status)
+{
+    ImGui::TableNextRow(ImGuiTableRowFlags_None, kRowHeight);
+    ImGui::TableNextColumn();
+    ImGui::PushID(index);
+    ImGui::Selectable(row.name.c_str(), false, ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap,
+                      ImVec2(0, kRowHeight));
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(kStatuses[status]);
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(row.modified.c_str());
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(row.size.c_str());
+    ImGui::PopID();
+}
+
+enum class Mode
+{
+    AllRowsFormatted,       // Every row drawn, strings formatted per row per frame
+    ClippedFormatted,       // Visible rows only, strings formatted per row per frame
+    ClippedCached,          // Visible rows only, strings from the cached rows
+};
+
+void DrawFrame(const std::vector<Item>& items, const std::vector<Row>& rows, Mode mode)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    ImGui::Begin("Shots", nullptr, ImGuiWindowFlags_None);
+
+    if (ImGui::BeginTable("ShotsTable", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+        ImGui::TableSetupColumn("Modified", ImGuiTableColumnFlags_WidthFixed, 150.0f);
+        ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableHeadersRow();
+
+        if (mode == Mode::AllRowsFormatted)
+        {
+            for (int i = 0; i < static_cast<int>(items.size()); i++)
+                DrawRow(i, MakeRow(items[i]), items[i].status);
+        }
+        else
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(items.size()));
+            while (clipper.Step())
+            {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                {
+                    if (mode == Mode::ClippedFormatted)
+                        DrawRow(i, MakeRow(items[i]), items[i].status);
+                    else
+                        DrawRow(i, rows[i], items[i].status);
+                }
+            }
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+    ImGui::Render();
+}
+
+void Run(const char* label, const std::vector<Item>& items, const std::vector<Row>& rows, Mode mode)
+{
+    // Settle layout (column widths, clipper row height) before timing
+    for (int frame = 0; frame < 5; frame++)
+        DrawFrame(items, rows, mode);
+
+    double total = 0.0;
+    double best = 1e30;
+    for (int frame = 0; frame < kFrames; frame++)
+    {
+        Clock::time_point start = Clock::now();
+        DrawFrame(items, rows, mode);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        total += ms;
+        best = (std::min)(best, ms);
+    }
+
+    std::printf("  %-28s %8.3f ms/frame mean  %8.3f ms best\n", label, total / kFrames, best);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+    std::vector<Item> items(count);
+    const std::time_t now = std::time(nullptr);
+    for (size_t i = 0; i < count; i++)
+    {
+        items[i].name = L"SH" + std::to_wstring(1000 + i) + L"_comp";
+        items[i].modified = now - static_cast<std::time_t>(i * 37);
+        items[i].size = (i * 7919) % (64ull << 30);
+        items[i].status = static_cast<int>(i % 5);
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<Row> rows;
+    rows.reserve(count);
+    for (const Item& item : items)
+        rows.push_back(MakeRow(item));
+    std::printf("Table frame cost, %zu rows (%d frames)\n", count, kFrames);
+    std::printf("  %-28s %8.3f ms once\n", "build cached rows",
+                std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+    Run("all rows, formatted", items, rows, Mode::AllRowsFormatted);
+    Run("clipped, formatted", items, rows, Mode::ClippedFormatted);
+    Run("clipped, cached rows", items, rows, Mode::ClippedCached);
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "p2p_sim_peers.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+bool WriteAll(int fd, const std::vector<char>& data)
+{
+    size_t written = 0;
+    while (written < data.size())
+    {
+        ssize_t result = send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (result < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR)
+            {
+                pollfd waitFd = { fd, POLLOUT, 0 };
+                poll(&waitFd, 1, 100);
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+} // namespace
+
+bool SimulatedPeers::Connect(const std::string& deviceIdPrefix, uint16_t port, size_t count, int receiveBufferBytes)
+{
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto peer = std::make_unique<Peer>();
+        peer->deviceId = deviceIdPrefix + "-" + std::to_string(i);
+        peer->fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (peer->fd < 0)
+            return false;
+
+        // Before connect, so the window is negotiated with it
+        if (receiveBufferBytes > 0)
+            setsockopt(peer->fd, SOL_SOCKET, SO_RCVBUF, &receiveBufferBytes, sizeof(receiveBufferBytes));
+
+        if (connect(peer->fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        {
+            std::cerr << "[SimulatedPeers] Connect failed: " << strerror(errno) << std::endl;
+            close(peer->fd);
+            return false;
+        }
+
+        nlohmann::json hello = {
+            {"deviceId", peer->deviceId},
+            {"deviceName", peer->deviceId},
+            {"port", 0},
+            {"timestamp", 0},
+            {"protocol", UFB::kP2PProtocolVersion}
+        };
+        if (!WriteAll(peer->fd, UFB::P2PCodec::EncodeJson(UFB::P2PMessageType::HELLO, hello)))
+        {
+            close(peer->fd);
+            return false;
+        }
+
+        fcntl(peer->fd, F_SETFL, fcntl(peer->fd, F_GETFL) | O_NONBLOCK);
+        m_peers.push_back(std::move(peer));
+    }
+
+    m_running = true;
+    m_reader = std::thread(&SimulatedPeers::ReadLoop, this);
+    return true;
+}
+
+void SimulatedPeers::Stop()
+{
+    m_running = false;
+    if (m_reader.joinable())
+        m_reader.join();
+
+    for (auto& peer : m_peers)
+    {
+        if (peer->fd >= 0)
+            close(peer->fd);
+        peer->fd = -1;
+    }
+}
+
+void SimulatedPeers::SetPaused(size_t peer, bool paused)
+{
+    m_peers[peer]->paused = paused;
+}
+
+std::vector<SimulatedPeers::Received> SimulatedPeers::Messages(size_t peer, UFB::P2PMessageType type) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Received> messages;
+    for (const auto& received : m_peers[peer]->received)
+        if (received.message.type == type)
+            messages.push_back(received);
+    return messages;
+}
+
+size_t SimulatedPeers::MessageCount(size_t peer, UFB::P2PMessageType type) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& received : m_peers[peer]->received)
+        if (received.message.type == type)
+            count++;
+    return count;
+}
+
+uint64_t SimulatedPeers::NewestTimestamp(size_t peer, UFB::P2PMessageType type) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t newest = 0;
+    for (const auto& received : m_peers[peer]->received)
+        if (received.message.type == type)
+            newest = (std::max)(newest, received.message.timestamp);
+    return newest;
+}
+
+bool SimulatedPeers::WaitFor(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    Clock::time_point deadline = Clock::now() + timeout;
+    while (!predicate())
+    {
+        if (Clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void SimulatedPeers::ReadLoop()
+{
+    std::vector<pollfd> fds;
+    std::vector<Peer*> polled;
+    std::vector<char> chunk(256 * 1024);
+
+    while (m_running)
+    {
+        fds.clear();
+        polled.clear();
+        for (auto& peer : m_peers)
+        {
+            if (peer->fd >= 0 && !peer->paused)
+            {
+                fds.push_back({ peer->fd, POLLIN, 0 });
+                polled.push_back(peer.get());
+            }
+        }
+
+        if (poll(fds.data(), fds.size(), 20) <= 0)
+            continue;
+
+        for (size_t i = 0; i < fds.size(); i++)
+        {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+                continue;
+
+            Peer& peer = *polled[i];
+            ssize_t received;
+            while ((received = recv(peer.fd, chunk.data(), chunk.size(), 0)) > 0)
+                peer.buffer.Append(chunk.data(), static_cast<size_t>(received));
+            ParseFrames(peer);
+        }
+    }
+}
+
+void SimulatedPeers::ParseFrames(Peer& peer)
+{
+    while (peer.buffer.Size() >= 4)
+    {
+        uint32_t length = UFB::P2PCodec::ReadLength(peer.buffer.Peek(0, 4, peer.scratch));
+        if (peer.buffer.Size() < 4 + static_cast<size_t>(length))
+            return;
+
+        const char* body = peer.buffer.Peek(4, length, peer.scratch);
+        Received received;
+        received.when = Clock::now();
+        bool decoded = false;
+
+        if (UFB::P2PCodec::IsBinary(body, length))
+        {
+            decoded = UFB::P2PCodec::DecodeBinary(body, length, received.message);
+        }
+        else
+        {
+            nlohmann::json parsed = nlohmann::json::parse(body, body + length, nullptr, false);
+            auto type = static_cast<UFB::P2PMessageType>(parsed.is_object() ? parsed.value("type", 0u) : 0u);
+            if (type != UFB::P2PMessageType::HELLO && parsed.is_object())
+                decoded = UFB::P2PCodec::FromJsonPayload(type, parsed.value("payload", nlohmann::json::object()), received.message);
+        }
+        peer.buffer.Consume(4 + length);
+
+        if (!decoded)
+            continue;
+
+        // Keep the connection alive like a real peer
+        if (received.message.type == UFB::P2PMessageType::PING)
+        {
+            UFB::P2PMessage pong;
+            pong.type = UFB::P2PMessageType::PONG;
+            pong.deviceId = peer.deviceId;
+            pong.timestamp = received.message.timestamp;
+            WriteAll(peer.fd, UFB::P2PCodec::EncodeBinary(pong));
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        peer.received.push_back(std::move(received));
+    }
+}
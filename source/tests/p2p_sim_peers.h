@@ -0,0 +1,67 @@
+#pragma once
+
+#include "p2p_protocol.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Simulated P2P peers for loopback tests and benchmarks (POSIX sockets): each one connects to a
+// P2PManager, says HELLO (binary frames) and records the frames it receives, without a
+// P2PManager of its own, so hundreds fit in one process
+class SimulatedPeers
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Received
+    {
+        UFB::P2PMessage message;
+        Clock::time_point when;
+    };
+
+    ~SimulatedPeers() { Stop(); }
+
+    // Connect count peers (device IDs "<prefix>-<index>") to a P2PManager listening on 127.0.0.1:port
+    // @param receiveBufferBytes - SO_RCVBUF of each socket (0 = system default); small ones fill
+    //                             quickly while a peer is paused
+    bool Connect(const std::string& deviceIdPrefix, uint16_t port, size_t count, int receiveBufferBytes = 0);
+    void Stop();
+
+    size_t Count() const { return m_peers.size(); }
+    std::string DeviceId(size_t peer) const { return m_peers[peer]->deviceId; }
+
+    // A paused peer stops reading: its socket buffer fills and the sender has to queue
+    void SetPaused(size_t peer, bool paused);
+
+    // Frames of one type a peer received so far (HELLO excluded)
+    std::vector<Received> Messages(size_t peer, UFB::P2PMessageType type) const;
+    size_t MessageCount(size_t peer, UFB::P2PMessageType type) const;
+    uint64_t NewestTimestamp(size_t peer, UFB::P2PMessageType type) const;     // 0 if none
+
+    // Poll predicate until it holds or timeout passes
+    static bool WaitFor(const std::function<bool()>& predicate, std::chrono::milliseconds timeout);
+
+private:
+    struct Peer
+    {
+        std::string deviceId;
+        int fd = -1;
+        std::atomic<bool> paused{false};
+        UFB::P2PReceiveRing buffer;
+        std::vector<char> scratch;
+        std::vector<Received> received;     // Guarded by m_mutex
+    };
+
+    void ReadLoop();
+    void ParseFrames(Peer& peer);
+
+    std::vector<std::unique_ptr<Peer>> m_peers;
+    mutable std::mutex m_mutex;
+    std::atomic<bool> m_running{false};
+    std::thread m_reader;
+};
@@ -0,0 +1,341 @@
+#include "extractors/blend_reader.h"
+#include "test_check.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#ifdef UFB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef UFB_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+enum class HeaderKind
+{
+    Legacy,     // 12-byte header, 16 + pointer-size BHead
+    Large,      // 17-byte header, 32-byte BHead
+};
+
+// .blend writer for fixtures: header, file blocks, ENDB
+struct BlendBuilder
+{
+    HeaderKind kind;
+    int ptrSize;
+    bool littleEndian;
+    std::vector<uint8_t> bytes;
+
+    BlendBuilder(HeaderKind kind, int ptrSize, bool littleEndian)
+        : kind(kind), ptrSize(kind == HeaderKind::Large ? 8 : ptrSize), littleEndian(littleEndian)
+    {
+        if (kind == HeaderKind::Large)
+        {
+            Text("BLENDER17-01");
+            Text(littleEndian ? "v" : "V");
+            Text("0405");
+        }
+        else
+        {
+            Text("BLENDER");
+            Text(ptrSize == 4 ? "_" : "-");
+            Text(littleEndian ? "v" : "V");
+            Text("300");
+        }
+    }
+
+    void Text(const char* text) { bytes.insert(bytes.end(), text, text + std::strlen(text)); }
+
+    void U32(uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            int shift = littleEndian ? i * 8 : (3 - i) * 8;
+            bytes.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void U64(uint64_t value)
+    {
+        uint32_t low = static_cast<uint32_t>(value);
+        uint32_t high = static_cast<uint32_t>(value >> 32);
+        U32(littleEndian ? low : high);
+        U32(littleEndian ? high : low);
+    }
+
+    void Pointer(uint64_t value)
+    {
+        if (ptrSize == 4)
+            U32(static_cast<uint32_t>(value));
+        else
+            U64(value);
+    }
+
+    void BHead(const char* code, uint64_t length)
+    {
+        Text(code);
+        if (kind == HeaderKind::Large)
+        {
+            U32(0);             // SDNAnr
+            U64(0x1000);        // Old pointer
+            U64(length);
+            U64(1);             // nr
+        }
+        else
+        {
+            U32(static_cast<uint32_t>(length));
+            Pointer(0x1000);
+            U32(0);             // SDNAnr
+            U32(1);             // nr
+        }
+    }
+
+    void Block(const char* code, size_t length)
+    {
+        BHead(code, length);
+        for (size_t i = 0; i < length; i++)
+            bytes.push_back(static_cast<uint8_t>(i * 7));
+    }
+
+    // TEST block: dimensions, then RGBA
+    void Thumbnail(uint32_t width, uint32_t height, const std::vector<uint8_t>& rgba)
+    {
+        BHead("TEST", 8 + rgba.size());
+        U32(width);
+        U32(height);
+        bytes.insert(bytes.end(), rgba.begin(), rgba.end());
+    }
+
+    void End() { BHead("ENDB", 0); }
+};
+
+std::vector<uint8_t> MakeRGBA(uint32_t width, uint32_t height)
+{
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < rgba.size(); i++)
+        rgba[i] = static_cast<uint8_t>((i * 31 + i / 5) & 0xFF);
+    return rgba;
+}
+
+// Typical layout: REND and GLOB ahead of the thumbnail, data blocks after it
+std::vector<uint8_t> BuildBlend(HeaderKind kind, int ptrSize, bool littleEndian, const std::vector<uint8_t>& rgba,
+                                uint32_t width, uint32_t height)
+{
+    BlendBuilder blend(kind, ptrSize, littleEndian);
+    blend.Block("REND", 72);
+    blend.Block("GLOB", 1043);
+    blend.Thumbnail(width, height, rgba);
+    blend.Block("DATA", 4096);
+    blend.End();
+    return std::move(blend.bytes);
+}
+
+std::filesystem::path g_directory;
+
+std::wstring WriteFixture(const std::string& name, const std::vector<uint8_t>& bytes)
+{
+    std::filesystem::path path = g_directory / name;
+    FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (file)
+    {
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+    return path.wstring();
+}
+
+bool ReadsBack(const std::wstring& path, const std::vector<uint8_t>& rgba, uint32_t width, uint32_t height)
+{
+    std::vector<unsigned char> data;
+    uint32_t readWidth = 0, readHeight = 0;
+    return ReadBlendThumbnail(path, data, readWidth, readHeight) && readWidth == width && readHeight == height &&
+           data == rgba;
+}
+
+void TestLegacyHeaders()
+{
+    const std::vector<uint8_t> rgba = MakeRGBA(128, 96);
+
+    UFB_CHECK(ReadsBack(WriteFixture("legacy_32le.blend", BuildBlend(HeaderKind::Legacy, 4, true, rgba, 128, 96)),
+                        rgba, 128, 96));
+    UFB_CHECK(ReadsBack(WriteFixture("legacy_64le.blend", BuildBlend(HeaderKind::Legacy, 8, true, rgba, 128, 96)),
+                        rgba, 128, 96));
+    UFB_CHECK(ReadsBack(WriteFixture("legacy_32be.blend", BuildBlend(HeaderKind::Legacy, 4, false, rgba, 128, 96)),
+                        rgba, 128, 96));
+    UFB_CHECK(ReadsBack(WriteFixture("legacy_64be.blend", BuildBlend(HeaderKind::Legacy, 8, false, rgba, 128, 96)),
+                        rgba, 128, 96));
+}
+
+void TestLargeHeader()
+{
+    const std::vector<uint8_t> rgba = MakeRGBA(64, 128);
+    UFB_CHECK(ReadsBack(WriteFixture("large.blend", BuildBlend(HeaderKind::Large, 8, true, rgba, 64, 128)),
+                        rgba, 64, 128));
+
+    // Block lengths are 64-bit: a large block ahead of the thumbnail is skipped whole
+    BlendBuilder blend(HeaderKind::Large, 8, true);
+    blend.Block("REND", 300000);
+    blend.Thumbnail(64, 128, rgba);
+    blend.End();
+    UFB_CHECK(ReadsBack(WriteFixture("large_skip.blend", blend.bytes), rgba, 64, 128));
+}
+
+void TestNoThumbnail()
+{
+    std::vector<unsigned char> data;
+    uint32_t width = 0, height = 0;
+
+    // Saved without a preview: reaches ENDB
+    BlendBuilder blend(HeaderKind::Legacy, 8, true);
+    blend.Block("REND", 72);
+    blend.Block("GLOB", 1043);
+    blend.Block("DATA", 4096);
+    blend.End();
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("no_thumbnail.blend", blend.bytes), data, width, height));
+
+    // Truncated before ENDB
+    blend.bytes.resize(blend.bytes.size() - 2000);
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("truncated.blend", blend.bytes), data, width, height));
+
+    // Not a .blend file, missing file
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("not_blend.blend", std::vector<uint8_t>(64, 'x')), data, width, height));
+    UFB_CHECK(!ReadBlendThumbnail((g_directory / "missing.blend").wstring(), data, width, height));
+
+    // Unknown large-header size
+    std::vector<uint8_t> bad = BuildBlend(HeaderKind::Large, 8, true, MakeRGBA(4, 4), 4, 4);
+    bad[8] = '8';
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("bad_header.blend", bad), data, width, height));
+}
+
+void TestInvalidThumbnail()
+{
+    std::vector<unsigned char> data;
+    uint32_t width = 0, height = 0;
+
+    // Dimensions past the 1024 limit
+    BlendBuilder huge(HeaderKind::Legacy, 8, true);
+    huge.BHead("TEST", 8 + 16);
+    huge.U32(2048);
+    huge.U32(2048);
+    huge.End();
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("huge.blend", huge.bytes), data, width, height));
+
+    // Block shorter than the pixels it claims
+    BlendBuilder shortBlock(HeaderKind::Legacy, 8, true);
+    shortBlock.BHead("TEST", 8 + 16);
+    shortBlock.U32(16);
+    shortBlock.U32(16);
+    shortBlock.End();
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("short.blend", shortBlock.bytes), data, width, height));
+
+    // Zero size
+    BlendBuilder empty(HeaderKind::Legacy, 8, true);
+    empty.BHead("TEST", 8);
+    empty.U32(0);
+    empty.U32(0);
+    empty.End();
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("empty.blend", empty.bytes), data, width, height));
+}
+
+#ifdef UFB_HAVE_ZLIB
+std::vector<uint8_t> Gzip(const std::vector<uint8_t>& bytes)
+{
+    z_stream stream = {};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::vector<uint8_t> out(deflateBound(&stream, static_cast<uLong>(bytes.size())));
+    stream.next_in = const_cast<Bytef*>(bytes.data());
+    stream.avail_in = static_cast<uInt>(bytes.size());
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+void TestGzip()
+{
+    const std::vector<uint8_t> rgba = MakeRGBA(128, 128);
+
+    // Thumbnail well past the first 64KB read chunk, so inflate runs across several refills
+    BlendBuilder blend(HeaderKind::Legacy, 8, true);
+    blend.Block("REND", 72);
+    blend.Block("DATA", 200000);
+    blend.Thumbnail(128, 128, rgba);
+    blend.End();
+    UFB_CHECK(ReadsBack(WriteFixture("gzip.blend", Gzip(blend.bytes)), rgba, 128, 128));
+
+    std::vector<uint8_t> large = BuildBlend(HeaderKind::Large, 8, true, rgba, 128, 128);
+    UFB_CHECK(ReadsBack(WriteFixture("gzip_large.blend", Gzip(large)), rgba, 128, 128));
+
+    // Truncated stream
+    std::vector<uint8_t> truncated = Gzip(blend.bytes);
+    truncated.resize(truncated.size() / 2);
+    std::vector<unsigned char> data;
+    uint32_t width = 0, height = 0;
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("gzip_truncated.blend", truncated), data, width, height));
+}
+#endif
+
+#ifdef UFB_HAVE_ZSTD
+std::vector<uint8_t> Zstd(const std::vector<uint8_t>& bytes)
+{
+    std::vector<uint8_t> out(ZSTD_compressBound(bytes.size()));
+    size_t size = ZSTD_compress(out.data(), out.size(), bytes.data(), bytes.size(), 3);
+    out.resize(ZSTD_isError(size) ? 0 : size);
+    return out;
+}
+
+void TestZstd()
+{
+    const std::vector<uint8_t> rgba = MakeRGBA(128, 128);
+
+    BlendBuilder blend(HeaderKind::Legacy, 8, true);
+    blend.Block("REND", 72);
+    blend.Block("DATA", 200000);
+    blend.Thumbnail(128, 128, rgba);
+    blend.End();
+    UFB_CHECK(ReadsBack(WriteFixture("zstd.blend", Zstd(blend.bytes)), rgba, 128, 128));
+
+    // Blender 4.x writes the large header, compressed with zstd by default
+    std::vector<uint8_t> large = BuildBlend(HeaderKind::Large, 8, true, rgba, 128, 128);
+    UFB_CHECK(ReadsBack(WriteFixture("zstd_large.blend", Zstd(large)), rgba, 128, 128));
+
+    BlendBuilder noThumbnail(HeaderKind::Large, 8, true);
+    noThumbnail.Block("REND", 72);
+    noThumbnail.End();
+    std::vector<unsigned char> data;
+    uint32_t width = 0, height = 0;
+    UFB_CHECK(!ReadBlendThumbnail(WriteFixture("zstd_no_thumbnail.blend", Zstd(noThumbnail.bytes)), data, width, height));
+}
+#endif
+
+} // namespace
+
+int main()
+{
+    g_directory = std::filesystem::temp_directory_path() / "ufb_test_blend_reader";
+    std::filesystem::create_directories(g_directory);
+
+    TestLegacyHeaders();
+    TestLargeHeader();
+    TestNoThumbnail();
+    TestInvalidThumbnail();
+#ifdef UFB_HAVE_ZLIB
+    TestGzip();
+#else
+    std::printf("test_blend_reader: built without zlib, gzip input not tested\n");
+#endif
+#ifdef UFB_HAVE_ZSTD
+    TestZstd();
+#else
+    std::printf("test_blend_reader: built without zstd, zstd input not tested\n");
+#endif
+
+    std::filesystem::remove_all(g_directory);
+    return UFB::Test::Result("test_blend_reader");
+}
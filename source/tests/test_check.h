@@ -0,0 +1,36 @@
+#pragma once
+
+#include <iostream>
+
+// Minimal checks for the unit tests: a failed check is reported and counted, and the test
+// executable exits non-zero if any check failed
+namespace UFB::Test {
+
+inline int& Failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline int Result(const char* name)
+{
+    if (Failures() == 0)
+    {
+        std::cout << name << ": all checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << name << ": " << Failures() << " check(s) failed" << std::endl;
+    return 1;
+}
+
+} // namespace UFB::Test
+
+#define UFB_CHECK(condition)                                                                    \
+    do                                                                                          \
+    {                                                                                           \
+        if (!(condition))                                                                       \
+        {                                                                                       \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+            ++UFB::Test::Failures();                                                            \
+        }                                                                                       \
+    } while (0)
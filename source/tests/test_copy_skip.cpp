@@ -0,0 +1,204 @@
+#include "copy_skip.h"
+#include "xxhash64.h"
+#include "test_check.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// CopyEngine's check for files already at the destination, on a temp tree with a hash cache
+// standing in for FileHashService (path + size + mtime -> XXH64 of the content)
+namespace {
+
+std::filesystem::path g_root;
+
+void WriteFile(const std::filesystem::path& path, const std::string& contents)
+{
+    if (FILE* file = std::fopen(path.string().c_str(), "wb"))
+    {
+        std::fwrite(contents.data(), 1, contents.size(), file);
+        std::fclose(file);
+    }
+}
+
+UFB::FileStamp StampOf(const std::filesystem::path& path)
+{
+    UFB::FileStamp stamp;
+    stamp.size = std::filesystem::file_size(path);
+    stamp.lastWriteTime = static_cast<uint64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+    return stamp;
+}
+
+uint64_t HashFile(const std::filesystem::path& path)
+{
+    UFB::XxHash64 hash;
+    if (FILE* file = std::fopen(path.string().c_str(), "rb"))
+    {
+        uint8_t buffer[4096];
+        size_t read;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+            hash.Update(buffer, read);
+        std::fclose(file);
+    }
+    return hash.Digest();
+}
+
+// Cached hashes keyed like the file_hashes table; counts lookups
+class HashCache
+{
+public:
+    void Store(const std::filesystem::path& path)
+    {
+        UFB::FileStamp stamp = StampOf(path);
+        m_hashes[Key(path.wstring(), stamp)] = HashFile(path);
+    }
+
+    std::optional<uint64_t> operator()(const std::wstring& path, const UFB::FileStamp& stamp)
+    {
+        m_lookups++;
+        auto it = m_hashes.find(Key(path, stamp));
+        if (it == m_hashes.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    int Lookups() const { return m_lookups; }
+
+private:
+    using KeyType = std::pair<std::wstring, std::pair<uint64_t, uint64_t>>;
+    static KeyType Key(const std::wstring& path, const UFB::FileStamp& stamp)
+    {
+        return { path, { stamp.size, stamp.lastWriteTime } };
+    }
+
+    std::map<KeyType, uint64_t> m_hashes;
+    int m_lookups = 0;
+};
+
+bool Unchanged(const std::filesystem::path& source, const std::filesystem::path& dest, HashCache& cache)
+{
+    return UFB::IsUnchangedAtDestination(source.wstring(), StampOf(source), dest.wstring(), StampOf(dest), cache);
+}
+
+void SetSameTime(const std::filesystem::path& from, const std::filesystem::path& to)
+{
+    std::filesystem::last_write_time(to, std::filesystem::last_write_time(from));
+}
+
+void Touch(const std::filesystem::path& path)
+{
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(10));
+}
+
+void TestStamps()
+{
+    const std::filesystem::path source = g_root / "src" / "plate.exr";
+    const std::filesystem::path dest = g_root / "dst" / "plate.exr";
+    WriteFile(source, "0123456789");
+    WriteFile(dest, "0123456789");
+    SetSameTime(source, dest);
+
+    // Same size and time: skipped without any hash lookup
+    HashCache cache;
+    UFB_CHECK(Unchanged(source, dest, cache));
+    UFB_CHECK(cache.Lookups() == 0);
+
+    // Same size, different time, nothing cached: copied
+    Touch(dest);
+    UFB_CHECK(!Unchanged(source, dest, cache));
+    UFB_CHECK(cache.Lookups() == 1);    // No source hash, destination not looked up
+
+    // Different size: copied, never hashed
+    WriteFile(dest, "01234567890");
+    SetSameTime(source, dest);
+    HashCache sizeCache;
+    sizeCache.Store(source);
+    sizeCache.Store(dest);
+    UFB_CHECK(!Unchanged(source, dest, sizeCache));
+    UFB_CHECK(sizeCache.Lookups() == 0);
+}
+
+void TestCachedHashes()
+{
+    const std::filesystem::path source = g_root / "src" / "comp.nk";
+    const std::filesystem::path dest = g_root / "dst" / "comp.nk";
+    WriteFile(source, "set cut_paste_input [stack 0]");
+    WriteFile(dest, "set cut_paste_input [stack 0]");
+    Touch(dest);
+
+    // Re-saved copy with the same content: skipped on matching hashes
+    HashCache cache;
+    cache.Store(source);
+    cache.Store(dest);
+    UFB_CHECK(Unchanged(source, dest, cache));
+    UFB_CHECK(cache.Lookups() == 2);
+
+    // Same size, different content
+    WriteFile(dest, "set cut_paste_input [stack 1]");
+    Touch(dest);
+    cache.Store(dest);
+    UFB_CHECK(!Unchanged(source, dest, cache));
+
+    // A hash cached for an older state of the file doesn't count
+    WriteFile(dest, "set cut_paste_input [stack 0]");
+    Touch(dest);
+    Touch(dest);
+    HashCache stale;
+    stale.Store(source);
+    UFB_CHECK(!Unchanged(source, dest, stale));
+}
+
+// Second pass over a copied tree: every file is skipped, a changed file is not
+void TestTree()
+{
+    const std::filesystem::path source = g_root / "tree_src";
+    const std::filesystem::path dest = g_root / "tree_dst";
+    std::filesystem::create_directories(source / "renders");
+    for (int i = 0; i < 20; i++)
+        WriteFile(source / "renders" / ("frame." + std::to_string(1001 + i) + ".exr"), std::string(100 + i, 'x'));
+    std::filesystem::copy(source, dest, std::filesystem::copy_options::recursive);
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(source))
+    {
+        if (entry.is_regular_file())
+            SetSameTime(entry.path(), dest / std::filesystem::relative(entry.path(), source));
+    }
+
+    WriteFile(dest / "renders" / "frame.1005.exr", std::string(104, 'y'));
+    Touch(dest / "renders" / "frame.1005.exr");
+
+    HashCache cache;
+    int skipped = 0;
+    int copied = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(source))
+    {
+        if (!entry.is_regular_file())
+            continue;
+        if (Unchanged(entry.path(), dest / std::filesystem::relative(entry.path(), source), cache))
+            skipped++;
+        else
+            copied++;
+    }
+    UFB_CHECK(skipped == 19);
+    UFB_CHECK(copied == 1);
+}
+
+} // namespace
+
+int main()
+{
+    g_root = std::filesystem::temp_directory_path() / "ufb_test_copy_skip";
+    std::filesystem::remove_all(g_root);
+    std::filesystem::create_directories(g_root / "src");
+    std::filesystem::create_directories(g_root / "dst");
+
+    TestStamps();
+    TestCachedHashes();
+    TestTree();
+
+    std::filesystem::remove_all(g_root);
+    return UFB::Test::Result("test_copy_skip");
+}
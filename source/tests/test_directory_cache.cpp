@@ -0,0 +1,188 @@
+#include "directory_cache.h"
+#include "directory_enumerator.h"
+#include "file_entry.h"
+#include "test_check.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+// DirectoryCache on the platform's FileWatcher backend (inotify on Linux): a change on disk bumps
+// the cached directory's version, and a re-read diffs against the cached listing
+namespace {
+
+std::filesystem::path g_directory;
+
+void WriteFile(const std::filesystem::path& path, const char* contents)
+{
+    if (FILE* file = std::fopen(path.string().c_str(), "wb"))
+    {
+        std::fputs(contents, file);
+        std::fclose(file);
+    }
+}
+
+std::vector<FileEntry> List()
+{
+    std::vector<FileEntry> entries;
+    UFB_CHECK(UFB::ListDirectory(g_directory.wstring(), false, entries));
+    return entries;
+}
+
+std::wstring PathOf(const char* name)
+{
+    return (g_directory / name).wstring();
+}
+
+// Wait for the watcher (debounced by FileWatcher::kDebounceMs) to bump the version
+bool WaitForVersionChange(uint64_t version)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (UFB::DirectoryCache::Get().GetVersion(g_directory.wstring()) != version)
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+// Store the current listing as the cache would after a read; returns its version
+uint64_t Revalidate(std::vector<FileEntry>& listing)
+{
+    auto& cache = UFB::DirectoryCache::Get();
+    uint64_t version = cache.GetVersion(g_directory.wstring());
+    listing = List();
+    cache.Store(g_directory.wstring(), false, listing, version);
+    return version;
+}
+
+void TestDiffListings()
+{
+    auto entry = [](const wchar_t* name, uintmax_t size, bool isDirectory = false) {
+        FileEntry e;
+        e.name = name;
+        e.fullPath = std::wstring(L"/d/") + name;
+        e.isDirectory = isDirectory;
+        e.size = size;
+        e.lastModified = std::filesystem::file_time_type{};
+        return e;
+    };
+
+    std::vector<FileEntry> before = { entry(L"a", 1), entry(L"b", 2), entry(L"c", 3), entry(L"d", 0, true) };
+    std::vector<FileEntry> after = { entry(L"b", 2), entry(L"c", 4), entry(L"d", 0, false), entry(L"e", 5) };
+
+    UFB::ListingDiff diff = UFB::DiffListings(before, after);
+    UFB_CHECK((diff.added == std::vector<std::wstring>{ L"/d/e" }));
+    UFB_CHECK((diff.removed == std::vector<std::wstring>{ L"/d/a" }));
+    std::sort(diff.modified.begin(), diff.modified.end());
+    UFB_CHECK((diff.modified == std::vector<std::wstring>{ L"/d/c", L"/d/d" }));
+
+    UFB_CHECK(UFB::DiffListings(before, before).IsEmpty());
+}
+
+void TestWatchedChanges()
+{
+    auto& cache = UFB::DirectoryCache::Get();
+    const std::wstring directory = g_directory.wstring();
+
+    WriteFile(g_directory / "a.txt", "a");
+    WriteFile(g_directory / "b.txt", "b");
+
+    UFB_CHECK(cache.GetVersion(directory) == 0);
+    std::vector<FileEntry> listing;
+    Revalidate(listing);
+    UFB_CHECK(listing.size() == 2);
+
+    std::vector<FileEntry> cached;
+    uint64_t listedVersion = 99;
+    UFB_CHECK(cache.Lookup(directory, false, cached, listedVersion));
+    UFB_CHECK(cached.size() == 2 && listedVersion == 0);
+    UFB_CHECK(!cache.Lookup(directory, true, cached, listedVersion));
+
+    // Give the watch a moment to be in place before touching the directory
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    UFB_CHECK(cache.GetVersion(directory) == 0);
+
+    // Create
+    uint64_t version = cache.GetVersion(directory);
+    WriteFile(g_directory / "c.txt", "c");
+    UFB_CHECK(WaitForVersionChange(version));
+    std::vector<FileEntry> before = listing;
+    Revalidate(listing);
+    UFB::ListingDiff diff = UFB::DiffListings(before, listing);
+    UFB_CHECK((diff.added == std::vector<std::wstring>{ PathOf("c.txt") }));
+    UFB_CHECK(diff.removed.empty() && diff.modified.empty());
+
+    // The stored listing is current again
+    UFB_CHECK(cache.Lookup(directory, false, cached, listedVersion));
+    UFB_CHECK(listedVersion == cache.GetVersion(directory));
+
+    // Rename
+    version = cache.GetVersion(directory);
+    std::filesystem::rename(g_directory / "a.txt", g_directory / "renamed.txt");
+    UFB_CHECK(WaitForVersionChange(version));
+    before = listing;
+    Revalidate(listing);
+    diff = UFB::DiffListings(before, listing);
+    UFB_CHECK((diff.added == std::vector<std::wstring>{ PathOf("renamed.txt") }));
+    UFB_CHECK((diff.removed == std::vector<std::wstring>{ PathOf("a.txt") }));
+    UFB_CHECK(diff.modified.empty());
+
+    // Write (size changes)
+    version = cache.GetVersion(directory);
+    WriteFile(g_directory / "b.txt", "bigger contents");
+    UFB_CHECK(WaitForVersionChange(version));
+    before = listing;
+    Revalidate(listing);
+    diff = UFB::DiffListings(before, listing);
+    UFB_CHECK((diff.modified == std::vector<std::wstring>{ PathOf("b.txt") }));
+    UFB_CHECK(diff.added.empty() && diff.removed.empty());
+
+    // Delete
+    version = cache.GetVersion(directory);
+    std::filesystem::remove(g_directory / "c.txt");
+    UFB_CHECK(WaitForVersionChange(version));
+    before = listing;
+    Revalidate(listing);
+    diff = UFB::DiffListings(before, listing);
+    UFB_CHECK((diff.removed == std::vector<std::wstring>{ PathOf("c.txt") }));
+    UFB_CHECK(diff.added.empty() && diff.modified.empty());
+
+    // A change during a read leaves the stored listing stale: it was stored at the version the
+    // read started at, so the next poll re-reads
+    version = cache.GetVersion(directory);
+    listing = List();
+    WriteFile(g_directory / "during_read.txt", "x");
+    UFB_CHECK(WaitForVersionChange(version));
+    cache.Store(directory, false, listing, version);
+    UFB_CHECK(cache.Lookup(directory, false, cached, listedVersion));
+    UFB_CHECK(listedVersion != cache.GetVersion(directory));
+
+    // Removed listings have no version and no longer bump
+    cache.Remove(directory);
+    UFB_CHECK(cache.GetVersion(directory) == 0);
+    WriteFile(g_directory / "after_remove.txt", "x");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    UFB_CHECK(cache.GetVersion(directory) == 0);
+    UFB_CHECK(!cache.Lookup(directory, false, cached, listedVersion));
+}
+
+} // namespace
+
+int main()
+{
+    g_directory = std::filesystem::temp_directory_path() / "ufb_test_directory_cache";
+    std::filesystem::remove_all(g_directory);
+    std::filesystem::create_directories(g_directory);
+
+    TestDiffListings();
+    TestWatchedChanges();
+
+    UFB::DirectoryCache::Get().Clear();
+    std::filesystem::remove_all(g_directory);
+    return UFB::Test::Result("test_directory_cache");
+}
@@ -0,0 +1,229 @@
+#include "extractors/exr_tonemap.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace ExrTonemap;
+
+namespace {
+
+const Kernel kKernels[] = { Kernel::Scalar, Kernel::SSE2, Kernel::AVXF16C };
+
+// Every half bit pattern in each channel: NaNs, infinities, denormals, negatives and both zeros.
+// Channels are offset from each other so every value also meets a spread of alphas
+std::vector<uint16_t> AllHalfPixels(size_t pixelCount)
+{
+    std::vector<uint16_t> pixels(pixelCount * 4);
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        pixels[i * 4 + 0] = static_cast<uint16_t>(i);
+        pixels[i * 4 + 1] = static_cast<uint16_t>(i * 7 + 1);
+        pixels[i * 4 + 2] = static_cast<uint16_t>(i * 13 + 5);
+        pixels[i * 4 + 3] = static_cast<uint16_t>(i * 31 + 11);
+    }
+    return pixels;
+}
+
+std::vector<Params> AllParams()
+{
+    std::vector<Params> all;
+    for (Curve curve : { Curve::Linear, Curve::SRGB, Curve::Filmic })
+    {
+        for (float exposure : { 0.0f, -3.0f, 2.5f })
+        {
+            for (bool premultiply : { false, true })
+            {
+                Params params;
+                params.curve = curve;
+                params.exposure = exposure;
+                params.premultiplyAlpha = premultiply;
+                all.push_back(params);
+            }
+        }
+    }
+    return all;
+}
+
+// Count of pixels where a kernel differs from the scalar reference
+size_t Mismatches(Kernel kernel, const uint16_t* src, size_t pixelCount, const Params& params)
+{
+    std::vector<uint8_t> expected(pixelCount * 4 + 4, 0xCD);
+    std::vector<uint8_t> actual(pixelCount * 4 + 4, 0xCD);
+    ConvertHalfRGBAToBGRA8Scalar(src, expected.data(), pixelCount, params);
+    ConvertHalfRGBAToBGRA8With(kernel, src, actual.data(), pixelCount, params);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < expected.size(); i += 4)
+    {
+        if (std::memcmp(&expected[i], &actual[i], 4) != 0)
+            ++mismatches;
+    }
+    return mismatches;
+}
+
+void TestKernelsMatchScalar()
+{
+    // Full half range twice over, plus an odd tail for the scalar remainder of the SIMD loops
+    const size_t pixelCount = 2 * 65536 + 3;
+    std::vector<uint16_t> pixels = AllHalfPixels(pixelCount);
+
+    for (Kernel kernel : kKernels)
+    {
+        if (!IsKernelAvailable(kernel))
+        {
+            std::cout << "  " << GetKernelName(kernel) << ": not available, skipped" << std::endl;
+            continue;
+        }
+
+        for (const Params& params : AllParams())
+        {
+            UFB_CHECK(Mismatches(kernel, pixels.data(), pixelCount, params) == 0);
+
+            // Unaligned source and every short count (tail only, one SIMD step plus tail)
+            UFB_CHECK(Mismatches(kernel, pixels.data() + 4, pixelCount - 1, params) == 0);
+            for (size_t count = 0; count < 10; ++count)
+                UFB_CHECK(Mismatches(kernel, pixels.data() + 12, count, params) == 0);
+        }
+    }
+
+    UFB_CHECK(IsKernelAvailable(Kernel::Scalar));
+}
+
+// Exact half -> float, independent of the kernels under test
+float HalfToFloat(uint16_t h)
+{
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t exponent = (h >> 10) & 0x1F;
+    uint32_t mantissa = h & 0x3FF;
+    if (exponent == 0)
+    {
+        float value = static_cast<float>(mantissa) / 16777216.0f;
+        return sign ? -value : value;
+    }
+
+    uint32_t bits = sign | (mantissa << 13) | (exponent == 0x1F ? 0x7F800000u : (exponent + 112) << 23);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Float input: every half value widened to float, the first 8 pixels replaced by values a half can't hold
+std::vector<float> FloatPixels(const std::vector<uint16_t>& halfPixels)
+{
+    std::vector<float> pixels(halfPixels.size());
+    for (size_t i = 0; i < halfPixels.size(); ++i)
+        pixels[i] = HalfToFloat(halfPixels[i]);
+
+    const float extremes[] = { 1e30f, -1e30f, std::numeric_limits<float>::max(), std::numeric_limits<float>::min(),
+                               std::numeric_limits<float>::denorm_min(), 65520.0f, 0.49999997f, 1.0000001f };
+    for (size_t i = 0; i < sizeof(extremes) / sizeof(extremes[0]); ++i)
+    {
+        for (size_t channel = 0; channel < 4; ++channel)
+            pixels[i * 4 + channel] = extremes[(i + channel) % 8];
+    }
+    return pixels;
+}
+
+void TestFloatKernelsMatchHalf()
+{
+    const size_t pixelCount = 65536 + 7;
+    std::vector<uint16_t> halfPixels = AllHalfPixels(pixelCount);
+    std::vector<float> floatPixels = FloatPixels(halfPixels);
+
+    for (const Params& params : AllParams())
+    {
+        std::vector<uint8_t> reference(pixelCount * 4);
+        ConvertFloatRGBAToBGRA8With(Kernel::Scalar, floatPixels.data(), reference.data(), pixelCount, params);
+
+        for (Kernel kernel : kKernels)
+        {
+            if (!IsKernelAvailable(kernel))
+                continue;
+
+            std::vector<uint8_t> actual(pixelCount * 4);
+            ConvertFloatRGBAToBGRA8With(kernel, floatPixels.data(), actual.data(), pixelCount, params);
+            UFB_CHECK(actual == reference);
+
+            for (size_t count = 0; count < 10; ++count)
+            {
+                std::vector<uint8_t> shortExpected(count * 4);
+                std::vector<uint8_t> shortActual(count * 4);
+                ConvertFloatRGBAToBGRA8With(Kernel::Scalar, floatPixels.data() + 4, shortExpected.data(), count, params);
+                ConvertFloatRGBAToBGRA8With(kernel, floatPixels.data() + 4, shortActual.data(), count, params);
+                UFB_CHECK(shortActual == shortExpected);
+            }
+        }
+
+        // Half-representable floats give exactly the half path's result (past the extremes)
+        std::vector<uint8_t> fromHalf(pixelCount * 4);
+        ConvertHalfRGBAToBGRA8Scalar(halfPixels.data(), fromHalf.data(), pixelCount, params);
+        UFB_CHECK(std::equal(reference.begin() + 8 * 4, reference.end(), fromHalf.begin() + 8 * 4));
+    }
+}
+
+void TestDispatchMatchesScalar()
+{
+    std::vector<uint16_t> pixels = AllHalfPixels(65536 + 1);
+    std::vector<uint8_t> expected(pixels.size());
+    std::vector<uint8_t> actual(pixels.size());
+
+    Params params;
+    ConvertHalfRGBAToBGRA8Scalar(pixels.data(), expected.data(), pixels.size() / 4, params);
+    ConvertHalfRGBAToBGRA8(pixels.data(), actual.data(), pixels.size() / 4, params);
+    UFB_CHECK(expected == actual);
+    std::cout << "  dispatched kernel: " << GetActiveKernelName() << std::endl;
+}
+
+// Known values through the scalar reference (BGRA output)
+void TestReferenceValues()
+{
+    const uint16_t kOne = 0x3C00;
+    const uint16_t kHalf = 0x3800;
+    const uint16_t kInf = 0x7C00;
+    const uint16_t kNaN = 0x7E00;
+    const uint16_t kMinusOne = 0xBC00;
+    const uint16_t kDenormal = 0x0001;
+
+    const uint16_t src[] = {
+        kOne, kHalf, 0, kOne,                    // R=1, G=0.5, B=0
+        kInf, kNaN, kMinusOne, kOne,             // Inf clamps to white, NaN and negatives to black
+        kDenormal, kDenormal, kDenormal, kNaN,   // Denormals are ~0, NaN alpha is 0
+        kOne, kOne, kOne, kHalf,                 // Premultiplied by 0.5 when enabled
+    };
+    uint8_t dst[16];
+
+    Params linear;
+    linear.curve = Curve::Linear;
+    ConvertHalfRGBAToBGRA8Scalar(src, dst, 4, linear);
+    UFB_CHECK(dst[0] == 0 && dst[1] == 128 && dst[2] == 255 && dst[3] == 255);
+    UFB_CHECK(dst[4] == 0 && dst[5] == 0 && dst[6] == 255 && dst[7] == 255);
+    UFB_CHECK(dst[8] == 0 && dst[9] == 0 && dst[10] == 0 && dst[11] == 0);
+    UFB_CHECK(dst[12] == 255 && dst[13] == 255 && dst[14] == 255 && dst[15] == 128);
+
+    // sRGB encodes mid grey brighter; premultiply halves the last pixel first
+    Params srgb;
+    srgb.premultiplyAlpha = true;
+    ConvertHalfRGBAToBGRA8Scalar(src, dst, 4, srgb);
+    UFB_CHECK(dst[1] == 188 && dst[2] == 255);
+    UFB_CHECK(dst[12] == 188 && dst[15] == 128);
+
+    // One stop down turns white into mid grey
+    Params darker;
+    darker.curve = Curve::Linear;
+    darker.exposure = -1.0f;
+    ConvertHalfRGBAToBGRA8Scalar(src, dst, 1, darker);
+    UFB_CHECK(dst[2] == 128 && dst[3] == 255);
+}
+
+} // namespace
+
+int main()
+{
+    TestKernelsMatchScalar();
+    TestFloatKernelsMatchHalf();
+    TestDispatchMatchesScalar();
+    TestReferenceValues();
+    return UFB::Test::Result("test_exr_tonemap");
+}
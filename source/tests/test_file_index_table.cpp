@@ -0,0 +1,257 @@
+#include "file_index_table.h"
+#include "test_check.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using UFB::FileIndexQuery;
+using UFB::FileIndexTable;
+
+FileIndexQuery Parse(const std::wstring& text)
+{
+    FileIndexQuery query;
+    UFB_CHECK(FileIndexQuery::Parse(text, query));
+    return query;
+}
+
+uint32_t TrigramOf(const char* text)
+{
+    return (static_cast<uint32_t>(static_cast<uint8_t>(text[0])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(text[1])) << 8) | static_cast<uint8_t>(text[2]);
+}
+
+bool HasTrigram(const FileIndexQuery& query, const char* text)
+{
+    return std::binary_search(query.trigrams.begin(), query.trigrams.end(), TrigramOf(text));
+}
+
+void TestParseQuery()
+{
+    FileIndexQuery empty;
+    UFB_CHECK(!FileIndexQuery::Parse(L"   ", empty));
+
+    // Case folded, quotes keep spaces, '/' becomes '\'
+    FileIndexQuery query = Parse(L"Comp \"My Plate\" SH010/Comp sh*_v00?.EXR");
+    UFB_CHECK((query.substrings == std::vector<std::string>{ "comp", "my plate" }));
+    UFB_CHECK((query.pathTerms == std::vector<std::string>{ "sh010\\comp" }));
+    UFB_CHECK((query.globs == std::vector<std::string>{ "sh*_v00?.exr" }));
+    UFB_CHECK(HasTrigram(query, "com") && HasTrigram(query, "y p") && HasTrigram(query, "_v0"));
+    UFB_CHECK(HasTrigram(query, ".ex"));
+    UFB_CHECK(!HasTrigram(query, "sh0"));   // Path terms span folders: no trigrams
+    UFB_CHECK(std::is_sorted(query.trigrams.begin(), query.trigrams.end()));
+    UFB_CHECK(std::adjacent_find(query.trigrams.begin(), query.trigrams.end()) == query.trigrams.end());
+
+    // 1-2 character terms have no trigrams (every block is a candidate)
+    UFB_CHECK(Parse(L"a").trigrams.empty());
+    UFB_CHECK(Parse(L"ab 7").trigrams.empty());
+    UFB_CHECK(Parse(L"s*").trigrams.empty());
+
+    // Extensions: ';' or ',' separated, optional dot; one extension narrows by ".ext"
+    FileIndexQuery single = Parse(L"ext:.EXR");
+    UFB_CHECK((single.extensions == std::vector<std::string>{ "exr" }));
+    UFB_CHECK(HasTrigram(single, ".ex") && HasTrigram(single, "exr"));
+
+    FileIndexQuery several = Parse(L"ext:exr;dpx,.tif");
+    UFB_CHECK((several.extensions == std::vector<std::string>{ "exr", "dpx", "tif" }));
+    UFB_CHECK(several.trigrams.empty());
+
+    // Several ext: terms add up to one list, so neither may narrow the candidates
+    FileIndexQuery terms = Parse(L"ext:exr ext:dpx");
+    UFB_CHECK((terms.extensions == std::vector<std::string>{ "exr", "dpx" }));
+    UFB_CHECK(terms.trigrams.empty());
+
+    FileIndexQuery trailing = Parse(L"ext:exr;");
+    UFB_CHECK((trailing.extensions == std::vector<std::string>{ "exr" }));
+}
+
+void TestGlobMatch()
+{
+    UFB_CHECK(UFB::GlobMatch("plate.exr", "*.exr"));
+    UFB_CHECK(UFB::GlobMatch("PLATE.EXR", "*.exr"));
+    UFB_CHECK(!UFB::GlobMatch("plate.exr.bak", "*.exr"));
+    UFB_CHECK(UFB::GlobMatch("sh010_v003.exr", "sh*_v00?.exr"));
+    UFB_CHECK(!UFB::GlobMatch("sh010_v0031.exr", "sh*_v00?.exr"));
+    UFB_CHECK(UFB::GlobMatch("abcab", "*ab"));
+    UFB_CHECK(UFB::GlobMatch("aXbYb", "a*b"));
+    UFB_CHECK(UFB::GlobMatch("anything", "*"));
+    UFB_CHECK(UFB::GlobMatch("a", "a**"));
+    UFB_CHECK(!UFB::GlobMatch("", "?"));
+    UFB_CHECK(UFB::GlobMatch("", "*"));
+    UFB_CHECK(!UFB::GlobMatch("ab", "a"));
+    UFB_CHECK(!UFB::GlobMatch("a", "ab"));
+
+    // '?' is one character, not one byte
+    UFB_CHECK(UFB::GlobMatch("caf\xC3\xA9.txt", "caf?.txt"));
+    UFB_CHECK(!UFB::GlobMatch("caf\xC3\xA9.txt", "caf??.txt"));
+    UFB_CHECK(UFB::GlobMatch("\xE6\x97\xA5\xE6\x9C\xAC.exr", "??.exr"));
+}
+
+// Root "P:\show" with shots/sh###/comp|plates/... spread over many blocks
+FileIndexTable MakeTable()
+{
+    FileIndexTable table;
+    table.path = L"P:\\show";
+    table.AddEntry(FileIndexTable::kNoEntry, "", FileIndexTable::kDirectory, 0, 0);
+    uint32_t shots = table.AddEntry(0, "shots", FileIndexTable::kDirectory, 0, 0);
+
+    const char* const extensions[] = { "exr", "dpx", "tif", "nk", "EXR" };
+    for (int s = 0; s < 40; s++)
+    {
+        std::string shot = "sh" + std::to_string(100 + s * 10);
+        uint32_t shotIndex = table.AddEntry(shots, shot, FileIndexTable::kDirectory, 0, 0);
+        uint32_t comp = table.AddEntry(shotIndex, "comp", FileIndexTable::kDirectory, 0, 0);
+        for (int v = 1; v <= 12; v++)
+        {
+            std::string version = (v < 10 ? "v00" : "v0") + std::to_string(v);
+            table.AddEntry(comp, shot + "_comp_" + version + "." + extensions[(s + v) % 5], 0, 1000 + v, 0);
+        }
+        table.AddEntry(comp, "a", 0, 1, 0);
+        table.AddEntry(comp, "My Plate " + std::to_string(s) + ".mov", 0, 1, 0);
+        table.AddEntry(shotIndex, "notes", 0, 1, 0);
+    }
+    return table;
+}
+
+// Every entry the query matches, by brute force (no trigram filtering)
+std::vector<std::wstring> BruteForce(const FileIndexTable& table, uint32_t scope, const FileIndexQuery& query)
+{
+    std::vector<std::wstring> paths;
+    for (uint32_t i = 1; i < table.entries.size(); i++)
+    {
+        if (i == scope || (table.entries[i].flags & FileIndexTable::kDeleted))
+            continue;
+        if (table.Matches(i, query) && table.IsUnder(i, scope))
+            paths.push_back(table.FullPath(i));
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+std::vector<std::wstring> Search(const FileIndexTable& table, uint32_t scope, const std::wstring& text)
+{
+    FileIndexQuery query;
+    FileIndexQuery::Parse(text, query);
+    std::vector<UFB::FileIndexResult> results;
+    bool truncated = false;
+    table.Search(scope, query, 1000000, results, truncated);
+    UFB_CHECK(!truncated);
+
+    std::vector<std::wstring> paths;
+    for (const auto& result : results)
+        paths.push_back(result.path);
+    std::sort(paths.begin(), paths.end());
+
+    // The candidate blocks never drop a match
+    UFB_CHECK(paths == BruteForce(table, scope, query));
+    return paths;
+}
+
+void TestSearch()
+{
+    FileIndexTable table = MakeTable();
+    UFB_CHECK(table.entries.size() > 10 * FileIndexTable::kBlockSize);
+
+    // Substrings, including 1-2 characters
+    UFB_CHECK(Search(table, 0, L"sh150_comp_v005").size() == 1);
+    UFB_CHECK(Search(table, 0, L"sh150_comp_v005")[0] == L"P:\\show\\shots\\sh150\\comp\\sh150_comp_v005.exr");
+    UFB_CHECK(Search(table, 0, L"a").size() > 40);
+    UFB_CHECK(Search(table, 0, L"SH").size() == 1 + 40 + 40 * 12);   // "shots", shot folders, versions
+    UFB_CHECK(Search(table, 0, L"\"my plate 1\"").size() == 11);   // 1, 10-19
+
+    // Extensions, case-insensitive, one or several
+    size_t exr = Search(table, 0, L"ext:exr").size();
+    size_t dpx = Search(table, 0, L"ext:dpx").size();
+    UFB_CHECK(exr == 40 * 12 * 2 / 5);
+    UFB_CHECK(Search(table, 0, L"ext:exr;dpx").size() == exr + dpx);
+    UFB_CHECK(Search(table, 0, L"ext:exr ext:dpx").size() == exr + dpx);
+    UFB_CHECK(Search(table, 0, L"ext:exr,dpx v001").size() == Search(table, 0, L"v001 ext:.dpx;.exr").size());
+    UFB_CHECK(Search(table, 0, L"ext:n").empty());
+
+    // Globs and path terms
+    UFB_CHECK(Search(table, 0, L"sh1?0_*_v01?.*").size() == 10 * 3);
+    UFB_CHECK(Search(table, 0, L"*.mov").size() == 40);
+    UFB_CHECK(Search(table, 0, L"sh200\\comp\\a").size() == 1);
+    UFB_CHECK(Search(table, 0, L"sh200\\comp\\ a").size() == 2);     // "a" and "My Plate 10.mov"
+    UFB_CHECK(Search(table, 0, L"sh2*0\\comp").empty());                // A glob is over the name only
+    UFB_CHECK(Search(table, 0, L"shots/sh200/ ext:nk").size() >= 2);
+
+    // No name has the trigram
+    UFB_CHECK(Search(table, 0, L"zzz").empty());
+
+    // Scope: below a folder only, folder itself excluded
+    uint32_t shot = table.FindPath(L"shots\\SH150");
+    UFB_CHECK(shot != FileIndexTable::kNoEntry);
+    UFB_CHECK(Search(table, shot, L"comp").size() == 1 + 12);
+    UFB_CHECK(Search(table, shot, L"sh150").size() == 12);
+    UFB_CHECK(table.FindPath(L"shots/sh150/comp/a") != FileIndexTable::kNoEntry);
+    UFB_CHECK(table.FindPath(L"shots\\sh999") == FileIndexTable::kNoEntry);
+
+    // Removed folders take their contents with them
+    table.RemoveEntry(table.FindPath(L"shots\\sh150\\comp"));
+    UFB_CHECK(Search(table, 0, L"sh150").size() == 1);     // The shot folder
+    UFB_CHECK(Search(table, shot, L"comp").empty());
+    UFB_CHECK(table.FindPath(L"shots\\sh150\\comp") == FileIndexTable::kNoEntry);
+    UFB_CHECK(table.deletedCount == 1 + 12 + 2);
+
+    // Entries added later are found (blocks keep growing in order)
+    table.AddEntry(shot, "sh150_late.exr", 0, 1, 0);
+    UFB_CHECK(Search(table, 0, L"sh150_late").size() == 1);
+
+    // Result limit
+    FileIndexQuery query;
+    FileIndexQuery::Parse(L"sh", query);
+    std::vector<UFB::FileIndexResult> results;
+    bool truncated = false;
+    table.Search(0, query, 10, results, truncated);
+    UFB_CHECK(results.size() == 10 && truncated);
+}
+
+// Random names and queries against brute force
+void TestRandomAgainstBruteForce()
+{
+    std::mt19937 random(42);
+    const char alphabet[] = "abcAB_.0123";
+    FileIndexTable table;
+    table.path = L"R:";
+    table.AddEntry(FileIndexTable::kNoEntry, "", FileIndexTable::kDirectory, 0, 0);
+    std::vector<uint32_t> folders = { 0 };
+    for (int i = 0; i < 5000; i++)
+    {
+        std::string name;
+        int length = 1 + static_cast<int>(random() % 8);
+        for (int c = 0; c < length; c++)
+            name += alphabet[random() % (sizeof(alphabet) - 1)];
+        bool folder = random() % 8 == 0;
+        uint32_t index = table.AddEntry(folders[random() % folders.size()], name,
+                                        folder ? FileIndexTable::kDirectory : 0, 0, 0);
+        if (folder)
+            folders.push_back(index);
+    }
+
+    for (int q = 0; q < 300; q++)
+    {
+        std::wstring text;
+        int length = 1 + static_cast<int>(random() % 4);
+        for (int c = 0; c < length; c++)
+            text += static_cast<wchar_t>(alphabet[random() % (sizeof(alphabet) - 1)]);
+        if (q % 3 == 1)
+            text = L"*" + text + L"?*";
+        else if (q % 3 == 2)
+            text = L"ext:" + text + L";b";
+        Search(table, folders[q % folders.size()], text);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    TestParseQuery();
+    TestGlobMatch();
+    TestSearch();
+    TestRandomAgainstBruteForce();
+    return UFB::Test::Result("test_file_index_table");
+}
@@ -0,0 +1,233 @@
+#include "file_watcher.h"
+#include "test_check.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// FileWatcher under load on the inotify backend: 1000 watched directories share one watch thread
+// and two dispatch threads, a burst of writes gives one callback per directory, a change is delivered
+// after the debounce window and not much later, and a tree watch of 1000 directories reports changes
+// in subdirectories created after the watch was set up
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kDirectories = 1000;
+
+std::filesystem::path g_root;
+
+void WriteFile(const std::filesystem::path& path)
+{
+    if (FILE* file = std::fopen(path.string().c_str(), "wb"))
+    {
+        std::fputs("x", file);
+        std::fclose(file);
+    }
+}
+
+// "<prefix><index>"
+std::string Name(const char* prefix, int index)
+{
+    std::string name = prefix;
+    name += std::to_string(index);
+    return name;
+}
+
+size_t ThreadCount()
+{
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task"))
+    {
+        (void)entry;
+        count++;
+    }
+    return count;
+}
+
+bool WaitFor(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    Clock::time_point deadline = Clock::now() + timeout;
+    while (!predicate())
+    {
+        if (Clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+double Milliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+struct WatchedDirectory
+{
+    std::filesystem::path path;
+    std::atomic<int> callbacks{0};
+    std::atomic<Clock::rep> lastCallback{0};
+};
+
+void TestManyDirectories()
+{
+    const size_t threadsBefore = ThreadCount();
+
+    std::vector<std::unique_ptr<WatchedDirectory>> directories;
+    for (int i = 0; i < kDirectories; i++)
+    {
+        auto directory = std::make_unique<WatchedDirectory>();
+        directory->path = g_root / "flat" / Name("dir", i);
+        std::filesystem::create_directories(directory->path);
+        directories.push_back(std::move(directory));
+    }
+
+    UFB::FileWatcher watcher;
+    Clock::time_point start = Clock::now();
+    bool allWatched = true;
+    for (auto& directory : directories)
+    {
+        WatchedDirectory* watched = directory.get();
+        allWatched = allWatched && watcher.WatchDirectory(watched->path.wstring(), [watched]() {
+            watched->lastCallback = Clock::now().time_since_epoch().count();
+            watched->callbacks++;
+        });
+    }
+    std::cout << kDirectories << " directories watched in " << Milliseconds(Clock::now() - start) << " ms" << std::endl;
+    UFB_CHECK(allWatched);
+
+    // One watch thread and the dispatch pool, not a thread per directory
+    const size_t threads = ThreadCount() - threadsBefore;
+    std::cout << "threads added: " << threads << std::endl;
+    UFB_CHECK(threads == 1 + UFB::FileWatcher::kDispatchThreads);
+
+    // Burst: 20 files in every directory, coalesced into one callback per directory (two if a
+    // directory's writes straddle a debounce window)
+    for (auto& directory : directories)
+        for (int file = 0; file < 20; file++)
+            WriteFile(directory->path / (Name("f", file) + ".txt"));
+
+    auto allCalled = [&]() {
+        return std::all_of(directories.begin(), directories.end(), [](const auto& d) { return d->callbacks > 0; });
+    };
+    UFB_CHECK(WaitFor(allCalled, std::chrono::seconds(10)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * UFB::FileWatcher::kDebounceMs));
+
+    int total = 0;
+    int most = 0;
+    for (auto& directory : directories)
+    {
+        total += directory->callbacks;
+        most = (std::max)(most, directory->callbacks.load());
+    }
+    std::cout << "20000 writes: " << total << " callbacks" << std::endl;
+    UFB_CHECK(most <= 2);
+
+    // Latency of single changes: the debounce window, plus little
+    std::vector<double> latencies;
+    for (int i = 0; i < 50; i++)
+    {
+        WatchedDirectory& directory = *directories[static_cast<size_t>(i * 19) % directories.size()];
+        const int before = directory.callbacks;
+        Clock::time_point written = Clock::now();
+        WriteFile(directory.path / "latency.txt");
+        if (!WaitFor([&]() { return directory.callbacks > before; }, std::chrono::seconds(5)))
+        {
+            UFB_CHECK(!"change not delivered");
+            continue;
+        }
+        latencies.push_back(Milliseconds(Clock::time_point(Clock::duration(directory.lastCallback.load())) - written));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 * UFB::FileWatcher::kDebounceMs));
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    if (!latencies.empty())
+    {
+        const double median = latencies[latencies.size() / 2];
+        std::cout << "latency: min " << latencies.front() << " ms, median " << median << " ms, max " << latencies.back()
+                  << " ms" << std::endl;
+        UFB_CHECK(latencies.front() >= UFB::FileWatcher::kDebounceMs - 1);
+        UFB_CHECK(median < UFB::FileWatcher::kDebounceMs + 50);
+        UFB_CHECK(latencies.back() < UFB::FileWatcher::kDebounceMs + 500);
+    }
+
+    watcher.StopWatching();
+}
+
+// One tree watch over 10 x 99 subdirectories
+void TestTreeWatch()
+{
+    const std::filesystem::path tree = g_root / "tree";
+    for (int top = 0; top < 10; top++)
+        for (int sub = 0; sub < 99; sub++)
+            std::filesystem::create_directories(tree / Name("d", top) / Name("s", sub));
+
+    std::mutex mutex;
+    std::set<std::wstring> changed;
+    int callbacks = 0;
+
+    UFB::FileWatcher watcher;
+    Clock::time_point start = Clock::now();
+    UFB_CHECK(watcher.WatchTree(tree.wstring(), [&](const std::vector<std::wstring>& paths) {
+        std::lock_guard<std::mutex> lock(mutex);
+        changed.insert(paths.begin(), paths.end());
+        callbacks++;
+    }));
+    std::cout << "tree of 1000 directories watched in " << Milliseconds(Clock::now() - start) << " ms" << std::endl;
+
+    auto seen = [&](const std::filesystem::path& relative) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return changed.count(relative.wstring()) > 0;
+    };
+
+    // Deep in the existing tree, reported relative to the root
+    WriteFile(tree / "d7" / "s42" / "deep.txt");
+    UFB_CHECK(WaitFor([&]() { return seen(std::filesystem::path("d7") / "s42" / "deep.txt"); }, std::chrono::seconds(5)));
+
+    // Directories created after the watch: a file written right away (possibly before their watch
+    // is in place) and one written later are both reported
+    const std::filesystem::path fresh = std::filesystem::path("new") / "a" / "b";
+    std::filesystem::create_directories(tree / fresh);
+    WriteFile(tree / fresh / "early.txt");
+    UFB_CHECK(WaitFor([&]() { return seen(fresh / "early.txt"); }, std::chrono::seconds(5)));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * UFB::FileWatcher::kDebounceMs));
+    WriteFile(tree / fresh / "late.txt");
+    UFB_CHECK(WaitFor([&]() { return seen(fresh / "late.txt"); }, std::chrono::seconds(5)));
+
+    std::filesystem::create_directories(tree / "d3" / "s5" / "added");
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * UFB::FileWatcher::kDebounceMs));
+    WriteFile(tree / "d3" / "s5" / "added" / "inner.txt");
+    UFB_CHECK(WaitFor([&]() { return seen(std::filesystem::path("d3") / "s5" / "added" / "inner.txt"); }, std::chrono::seconds(5)));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        UFB_CHECK(changed.count(std::wstring()) == 0);
+    }
+
+    watcher.StopWatching();
+}
+
+} // namespace
+
+int main()
+{
+    g_root = std::filesystem::temp_directory_path() / "ufb_test_file_watcher";
+    std::filesystem::remove_all(g_root);
+    std::filesystem::create_directories(g_root);
+
+    TestManyDirectories();
+    TestTreeWatch();
+
+    std::filesystem::remove_all(g_root);
+    return UFB::Test::Result("test_file_watcher");
+}
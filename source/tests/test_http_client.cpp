@@ -0,0 +1,462 @@
+#include "http_client.h"
+#include "test_check.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef UFB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+// HttpClient (POSIX sockets) against an in-process stand-in server reached through
+// HttpClientOptions::endpointOverride: keep-alive reuse counted in connections, stale pooled
+// connections retried, gzip bodies decoded, and SendBatch pipelining 16 requests deep on one connection
+namespace {
+
+// Sheets-style URL; endpointOverride sends it to the stand-in server
+const std::string kApiBase = "https://sheets.googleapis.com/v4/spreadsheets/abc";
+
+std::string ToLower(std::string text)
+{
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+    return text;
+}
+
+#ifdef UFB_HAVE_ZLIB
+std::string Gzip(const std::string& data)
+{
+    z_stream stream = {};
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+#endif
+
+// 64 KB of spreadsheet-like JSON, which compresses well
+std::string LargeBody()
+{
+    std::string body = "{\"values\":[";
+    for (int row = 0; body.size() < 64 * 1024; row++)
+        body += (row ? ",[\"SH" : "[\"SH") + std::to_string(row) + "\",\"In Progress\",\"artist\"]";
+    return body + "]}";
+}
+
+// Plain HTTP/1.1 server on 127.0.0.1, a thread per connection. Answers each request with
+// "<METHOD> <path>[ <body>]", except:
+//   /large    LargeBody(), gzipped if the request accepts gzip
+//   /chunked  the same text, chunked
+//   /close    answered with "Connection: close", then the connection is closed
+// After the first bytes of a read it waits briefly for more, and records how many complete requests
+// had arrived before it answered any of them (the client's pipeline depth)
+class StandInServer
+{
+public:
+    ~StandInServer() { Stop(); }
+
+    bool Start()
+    {
+        m_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(addr);
+        if (m_fd < 0 || bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(m_fd, 64) != 0 ||
+            getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &length) != 0)
+            return false;
+
+        m_port = ntohs(addr.sin_port);
+        m_running = true;
+        m_acceptThread = std::thread(&StandInServer::AcceptLoop, this);
+        return true;
+    }
+
+    void Stop()
+    {
+        m_running = false;
+        if (m_acceptThread.joinable())
+            m_acceptThread.join();
+        CloseConnections();
+
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            threads.swap(m_threads);
+        }
+        for (auto& thread : threads)
+            thread.join();
+        if (m_fd >= 0)
+            close(m_fd);
+        m_fd = -1;
+    }
+
+    // Drop every open connection, as a server closing idle keep-alive connections does
+    void CloseConnections()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (int fd : m_open)
+            shutdown(fd, SHUT_RDWR);
+    }
+
+    std::string Endpoint() const { return "http://127.0.0.1:" + std::to_string(m_port); }
+    int Connections() const { return m_connections; }
+    int Requests() const { return m_requests; }
+    int MaxPipelineDepth() const { return m_maxDepth; }
+
+    std::vector<std::string> Hosts() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hosts;
+    }
+
+private:
+    struct Request
+    {
+        std::string method;
+        std::string path;
+        std::map<std::string, std::string> headers;     // Lower-case names
+        std::string body;
+    };
+
+    void AcceptLoop()
+    {
+        while (m_running)
+        {
+            pollfd pfd = { m_fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 20) <= 0)
+                continue;
+
+            int fd = accept4(m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0)
+                continue;
+
+            m_connections++;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_open.push_back(fd);
+            m_threads.emplace_back(&StandInServer::Serve, this, fd);
+        }
+    }
+
+    void Serve(int fd)
+    {
+        std::string buffer;
+        char chunk[16 * 1024];
+        bool open = true;
+
+        while (open && m_running)
+        {
+            pollfd pfd = { fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 20) <= 0)
+                continue;
+
+            // Collect what the client has written ahead
+            ssize_t received;
+            do
+            {
+                received = recv(fd, chunk, sizeof(chunk), 0);
+                if (received <= 0)
+                {
+                    open = false;
+                    break;
+                }
+                buffer.append(chunk, static_cast<size_t>(received));
+                pfd.revents = 0;
+            } while (poll(&pfd, 1, 20) > 0);
+
+            std::vector<Request> requests;
+            Request request;
+            while (Parse(buffer, request))
+                requests.push_back(std::move(request));
+
+            int depth = static_cast<int>(requests.size());
+            int maxDepth = m_maxDepth;
+            while (depth > maxDepth && !m_maxDepth.compare_exchange_weak(maxDepth, depth)) {}
+
+            for (const auto& parsed : requests)
+            {
+                m_requests++;
+                if (!Respond(fd, parsed))
+                {
+                    open = false;
+                    break;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open.erase(std::remove(m_open.begin(), m_open.end(), fd), m_open.end());
+        close(fd);
+    }
+
+    bool Parse(std::string& buffer, Request& outRequest)
+    {
+        size_t headerEnd = buffer.find("\r\n\r\n");
+        if (headerEnd == std::string::npos)
+            return false;
+
+        outRequest = Request();
+        size_t lineEnd = buffer.find("\r\n");
+        std::string requestLine = buffer.substr(0, lineEnd);
+        size_t space = requestLine.find(' ');
+        outRequest.method = requestLine.substr(0, space);
+        outRequest.path = requestLine.substr(space + 1, requestLine.rfind(' ') - space - 1);
+
+        for (size_t start = lineEnd + 2; start < headerEnd;)
+        {
+            size_t end = buffer.find("\r\n", start);
+            std::string line = buffer.substr(start, end - start);
+            size_t colon = line.find(':');
+            if (colon != std::string::npos)
+                outRequest.headers[ToLower(line.substr(0, colon))] = line.substr(line.find_first_not_of(' ', colon + 1));
+            start = end + 2;
+        }
+
+        size_t bodyLength = std::stoul(outRequest.headers.count("content-length") ? outRequest.headers["content-length"] : "0");
+        if (buffer.size() < headerEnd + 4 + bodyLength)
+            return false;
+
+        outRequest.body = buffer.substr(headerEnd + 4, bodyLength);
+        buffer.erase(0, headerEnd + 4 + bodyLength);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hosts.push_back(outRequest.headers["host"]);
+        return true;
+    }
+
+    bool Respond(int fd, const Request& request)
+    {
+        std::string headers = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n";
+        std::string body = request.method + " " + request.path + (request.body.empty() ? "" : " " + request.body);
+        bool closeAfter = false;
+
+        if (request.path.find("/large") != std::string::npos)
+        {
+            body = LargeBody();
+#ifdef UFB_HAVE_ZLIB
+            auto accept = request.headers.find("accept-encoding");
+            if (accept != request.headers.end() && accept->second.find("gzip") != std::string::npos)
+            {
+                body = Gzip(body);
+                headers += "Content-Encoding: gzip\r\n";
+            }
+#endif
+        }
+        else if (request.path.find("/close") != std::string::npos)
+        {
+            headers += "Connection: close\r\n";
+            closeAfter = true;
+        }
+
+        std::string response;
+        if (request.path.find("/chunked") != std::string::npos)
+        {
+            response = headers + "Transfer-Encoding: chunked\r\n\r\n";
+            for (size_t offset = 0; offset < body.size(); offset += 7)
+            {
+                std::string piece = body.substr(offset, 7);
+                char size[16];
+                snprintf(size, sizeof(size), "%zx\r\n", piece.size());
+                response += size + piece + "\r\n";
+            }
+            response += "0\r\n\r\n";
+        }
+        else
+        {
+            response = headers + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+        }
+
+        for (size_t offset = 0; offset < response.size();)
+        {
+            ssize_t written = send(fd, response.data() + offset, response.size() - offset, MSG_NOSIGNAL);
+            if (written <= 0)
+                return false;
+            offset += static_cast<size_t>(written);
+        }
+        return !closeAfter;
+    }
+
+    int m_fd = -1;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_running{false};
+    std::thread m_acceptThread;
+    std::atomic<int> m_connections{0};
+    std::atomic<int> m_requests{0};
+    std::atomic<int> m_maxDepth{0};
+
+    mutable std::mutex m_mutex;
+    std::vector<int> m_open;                // Connections being served
+    std::vector<std::thread> m_threads;
+    std::vector<std::string> m_hosts;       // Host header of every request
+};
+
+std::unique_ptr<UFB::HttpClient> CreateClient(const StandInServer& server)
+{
+    UFB::HttpClientOptions options;
+    options.endpointOverride = server.Endpoint();
+    options.timeoutMs = 5000;
+    return UFB::HttpClient::Create(options);
+}
+
+UFB::HttpRequest Get(const std::string& path)
+{
+    UFB::HttpRequest request;
+    request.url = kApiBase + path;
+    return request;
+}
+
+// Sequential requests share one pooled connection; the override keeps path and query
+void TestKeepAlive()
+{
+    StandInServer server;
+    UFB_CHECK(server.Start());
+    auto client = CreateClient(server);
+
+    for (int i = 0; i < 20; i++)
+    {
+        UFB::HttpResponse response;
+        UFB_CHECK(client->Send(Get("/values/A" + std::to_string(i) + "?majorDimension=ROWS"), response));
+        UFB_CHECK(response.statusCode == 200);
+        UFB_CHECK(response.body == "GET /v4/spreadsheets/abc/values/A" + std::to_string(i) + "?majorDimension=ROWS");
+    }
+
+    UFB::HttpRequest post;
+    post.method = "POST";
+    post.url = kApiBase + "/values:batchUpdate";
+    post.body = "{\"data\":[]}";
+    UFB::HttpResponse response;
+    UFB_CHECK(client->Send(post, response));
+    UFB_CHECK(response.body == "POST /v4/spreadsheets/abc/values:batchUpdate {\"data\":[]}");
+
+    UFB_CHECK(server.Connections() == 1);
+    UFB::HttpClientStats stats = client->GetStats();
+    UFB_CHECK(stats.requests == 21);
+    UFB_CHECK(stats.connectionsOpened == 1);
+    UFB_CHECK(stats.failedRequests == 0);
+    UFB_CHECK(stats.bytesSent == post.body.size());
+
+    const std::string host = "127.0.0.1:" + server.Endpoint().substr(server.Endpoint().rfind(':') + 1);
+    std::vector<std::string> hosts = server.Hosts();
+    UFB_CHECK(std::all_of(hosts.begin(), hosts.end(), [&](const std::string& h) { return h == host; }));
+
+    // "Connection: close" isn't pooled: the next request opens a new connection
+    UFB_CHECK(client->Send(Get("/close"), response) && response.statusCode == 200);
+    UFB_CHECK(client->Send(Get("/values/B1"), response) && response.statusCode == 200);
+    UFB_CHECK(server.Connections() == 2);
+
+    // A pooled connection the server dropped while idle is replaced without failing the request
+    server.CloseConnections();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    UFB_CHECK(client->Send(Get("/values/B2"), response));
+    UFB_CHECK(response.body == "GET /v4/spreadsheets/abc/values/B2");
+    UFB_CHECK(server.Connections() == 3);
+    UFB_CHECK(client->GetStats().failedRequests == 0);
+
+    // Chunked bodies are reassembled
+    UFB_CHECK(client->Send(Get("/chunked/values/C1"), response));
+    UFB_CHECK(response.body == "GET /v4/spreadsheets/abc/chunked/values/C1");
+}
+
+// gzipped responses are decoded; stats count both sizes
+void TestGzip()
+{
+    StandInServer server;
+    UFB_CHECK(server.Start());
+    auto client = CreateClient(server);
+
+    UFB::HttpResponse response;
+    UFB_CHECK(client->Send(Get("/large"), response));
+    UFB_CHECK(response.statusCode == 200);
+    UFB_CHECK(response.body == LargeBody());
+
+    UFB::HttpClientStats stats = client->GetStats();
+    UFB_CHECK(stats.bytesDecoded == LargeBody().size());
+#ifdef UFB_HAVE_ZLIB
+    UFB_CHECK(stats.bytesReceived * 4 < stats.bytesDecoded);
+#else
+    UFB_CHECK(stats.bytesReceived == stats.bytesDecoded);
+#endif
+
+    // Not requested when compression is off
+    UFB::HttpClientOptions options;
+    options.endpointOverride = server.Endpoint();
+    options.compression = false;
+    auto plain = UFB::HttpClient::Create(options);
+    UFB_CHECK(plain->Send(Get("/large"), response));
+    UFB_CHECK(response.body == LargeBody());
+    UFB_CHECK(plain->GetStats().bytesReceived == LargeBody().size());
+}
+
+// 40 GETs through SendBatch: written 16 ahead on one connection, responses matched in order
+void TestPipelinedBatch()
+{
+    StandInServer server;
+    UFB_CHECK(server.Start());
+    auto client = CreateClient(server);
+
+    std::vector<UFB::HttpRequest> requests;
+    for (int i = 0; i < 40; i++)
+        requests.push_back(Get((i % 10 == 9 ? "/large?row=" : "/values/R") + std::to_string(i)));
+
+    std::vector<UFB::HttpResponse> responses;
+    std::vector<bool> results = client->SendBatch(requests, responses);
+    UFB_CHECK(results.size() == 40 && responses.size() == 40);
+
+    bool matched = true;
+    for (size_t i = 0; i < requests.size() && i < responses.size() && i < results.size(); i++)
+    {
+        const bool large = i % 10 == 9;
+        const std::string expected = large ? LargeBody() : "GET /v4/spreadsheets/abc/values/R" + std::to_string(i);
+        matched = matched && results[i] && responses[i].statusCode == 200 && responses[i].body == expected;
+    }
+    UFB_CHECK(matched);
+
+    UFB_CHECK(server.Connections() == 1);
+    UFB_CHECK(server.Requests() == 40);
+    UFB_CHECK(server.MaxPipelineDepth() == 16);
+    UFB_CHECK(client->GetStats().connectionsOpened == 1);
+
+    // Writes aren't pipelined: up to maxConnectionsPerHost in parallel
+    std::vector<UFB::HttpRequest> posts;
+    for (int i = 0; i < 12; i++)
+    {
+        UFB::HttpRequest post;
+        post.method = "POST";
+        post.url = kApiBase + "/values:append";
+        post.body = std::to_string(i);
+        posts.push_back(post);
+    }
+    results = client->SendBatch(posts, responses);
+    matched = true;
+    for (size_t i = 0; i < posts.size(); i++)
+        matched = matched && results[i] && responses[i].body == "POST /v4/spreadsheets/abc/values:append " + std::to_string(i);
+    UFB_CHECK(matched);
+    UFB_CHECK(server.Connections() <= 1 + UFB::HttpClientOptions().maxConnectionsPerHost);
+    UFB_CHECK(server.MaxPipelineDepth() == 16);
+}
+
+} // namespace
+
+int main()
+{
+    TestKeepAlive();
+    TestGzip();
+    TestPipelinedBatch();
+    return UFB::Test::Result("test_http_client");
+}
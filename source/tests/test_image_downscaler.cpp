@@ -0,0 +1,257 @@
+#include "extractors/image_downscaler.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Built twice: with the SSE2 paths (test_image_downscaler) and with UFB_DOWNSCALER_NO_SIMD
+// (test_image_downscaler_scalar), both checked against the same naive area average
+namespace {
+
+// Source image as RGBA values in [0, 255] (integers, so the 8-bit formats hold them exactly)
+struct Image
+{
+    int width;
+    int height;
+    std::vector<float> rgba;
+
+    float At(int x, int y, int channel) const { return rgba[(static_cast<size_t>(y) * width + x) * 4 + channel]; }
+};
+
+Image MakeImage(int width, int height, uint32_t seed)
+{
+    Image image{ width, height, std::vector<float>(static_cast<size_t>(width) * height * 4) };
+    for (float& value : image.rgba)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        value = static_cast<float>((seed >> 16) % 256);
+    }
+    return image;
+}
+
+// Area average of the output pixel's footprint, in double, straight from the definition
+std::vector<double> NaiveAreaAverage(const Image& image, int dstWidth, int dstHeight)
+{
+    std::vector<double> out(static_cast<size_t>(dstWidth) * dstHeight * 4, 0.0);
+    const double scaleX = static_cast<double>(image.width) / dstWidth;
+    const double scaleY = static_cast<double>(image.height) / dstHeight;
+
+    for (int dy = 0; dy < dstHeight; dy++)
+    {
+        for (int dx = 0; dx < dstWidth; dx++)
+        {
+            double x0 = dx * scaleX, x1 = (dx + 1) * scaleX;
+            double y0 = dy * scaleY, y1 = (dy + 1) * scaleY;
+            double sum[4] = {};
+            double area = 0.0;
+
+            for (int y = static_cast<int>(y0); y < image.height && y < y1; y++)
+            {
+                double coverY = (std::min)(y1, y + 1.0) - (std::max)(y0, static_cast<double>(y));
+                for (int x = static_cast<int>(x0); x < image.width && x < x1; x++)
+                {
+                    double cover = coverY * ((std::min)(x1, x + 1.0) - (std::max)(x0, static_cast<double>(x)));
+                    if (cover <= 0.0)
+                        continue;
+                    for (int c = 0; c < 4; c++)
+                        sum[c] += cover * image.At(x, y, c);
+                    area += cover;
+                }
+            }
+
+            for (int c = 0; c < 4; c++)
+                out[(static_cast<size_t>(dy) * dstWidth + dx) * 4 + c] = sum[c] / area;
+        }
+    }
+    return out;
+}
+
+// Source rows in the given pixel format
+std::vector<uint8_t> PackRow(const Image& image, int y, ImageDownscaler::PixelFormat format)
+{
+    std::vector<uint8_t> row;
+    for (int x = 0; x < image.width; x++)
+    {
+        uint8_t r = static_cast<uint8_t>(image.At(x, y, 0));
+        uint8_t g = static_cast<uint8_t>(image.At(x, y, 1));
+        uint8_t b = static_cast<uint8_t>(image.At(x, y, 2));
+        uint8_t a = static_cast<uint8_t>(image.At(x, y, 3));
+        switch (format)
+        {
+            case ImageDownscaler::PixelFormat::RGB8:  row.insert(row.end(), { r, g, b }); break;
+            case ImageDownscaler::PixelFormat::RGBA8: row.insert(row.end(), { r, g, b, a }); break;
+            case ImageDownscaler::PixelFormat::BGRA8: row.insert(row.end(), { b, g, r, a }); break;
+            case ImageDownscaler::PixelFormat::RGBAF32:
+            {
+                float values[4] = { image.At(x, y, 0), image.At(x, y, 1), image.At(x, y, 2), image.At(x, y, 3) };
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+                row.insert(row.end(), bytes, bytes + sizeof(values));
+                break;
+            }
+        }
+    }
+    return row;
+}
+
+// Downscale image in one format and compare both outputs with the naive average
+void CheckDownscale(const Image& image, int dstWidth, int dstHeight, ImageDownscaler::PixelFormat format)
+{
+    ImageDownscaler scaler(image.width, image.height, dstWidth, dstHeight);
+    std::vector<float> outFloat(static_cast<size_t>(dstWidth) * dstHeight * 4, -1.0f);
+    std::vector<uint8_t> outBGRA(static_cast<size_t>(dstWidth) * dstHeight * 4 + 3, 0xCD);
+    scaler.SetOutputFloat(outFloat.data(), static_cast<size_t>(dstWidth) * 4);
+    if (format != ImageDownscaler::PixelFormat::RGBAF32)
+        scaler.SetOutputBGRA8(outBGRA.data(), static_cast<size_t>(dstWidth) * 4);
+
+    UFB_CHECK(!scaler.IsComplete());
+    for (int y = 0; y < image.height; y++)
+    {
+        std::vector<uint8_t> row = PackRow(image, y, format);
+        scaler.PushRow(row.data(), format);
+    }
+    UFB_CHECK(scaler.IsComplete());
+
+    // Extra rows are ignored
+    std::vector<uint8_t> extra = PackRow(image, 0, format);
+    scaler.PushRow(extra.data(), format);
+
+    std::vector<double> expected = NaiveAreaAverage(image, dstWidth, dstHeight);
+    const bool is8Bit = format != ImageDownscaler::PixelFormat::RGBAF32;
+
+    // 8-bit inputs come out in BGRA order, float input in its own (RGBA) order
+    const int order8[4] = { 2, 1, 0, 3 };
+    const int orderF[4] = { 0, 1, 2, 3 };
+    const int* order = is8Bit ? order8 : orderF;
+
+    double maxFloatError = 0.0;
+    int maxByteError = 0;
+    for (size_t p = 0; p < expected.size() / 4; p++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            double want = expected[p * 4 + order[c]];
+            if (format == ImageDownscaler::PixelFormat::RGB8 && order[c] == 3)
+                want = 255.0;
+
+            maxFloatError = (std::max)(maxFloatError, std::abs(outFloat[p * 4 + c] - want));
+            if (is8Bit)
+                maxByteError = (std::max)(maxByteError, std::abs(outBGRA[p * 4 + c] - static_cast<int>(std::lround(want))));
+        }
+    }
+
+    UFB_CHECK(maxFloatError < 0.01);
+    UFB_CHECK(maxByteError <= 1);
+
+    // Nothing written past the last output row
+    if (is8Bit)
+        UFB_CHECK(outBGRA[outBGRA.size() - 1] == 0xCD && outBGRA[outBGRA.size() - 3] == 0xCD);
+
+    if (maxFloatError >= 0.01 || maxByteError > 1)
+    {
+        std::cerr << "  " << image.width << "x" << image.height << " -> " << dstWidth << "x" << dstHeight
+                  << " format " << static_cast<int>(format) << ": float error " << maxFloatError
+                  << ", byte error " << maxByteError << std::endl;
+    }
+}
+
+void TestAreaAverage()
+{
+    struct Case
+    {
+        int srcWidth, srcHeight, dstWidth, dstHeight;
+    };
+
+    const Case cases[] = {
+        { 37, 23, 10, 7 },      // Non-integer ratios, widths not multiples of 4
+        { 640, 480, 123, 97 },
+        { 7, 5, 3, 2 },
+        { 301, 7, 300, 7 },     // Ratio just above 1
+        { 5, 5, 1, 1 },         // 1-pixel outputs
+        { 13, 9, 1, 1 },
+        { 6, 1000, 5, 1 },
+        { 1000, 3, 1, 3 },
+        { 1, 1, 1, 1 },
+        { 9, 9, 9, 9 },         // Identity
+        { 4, 8, 4, 3 },
+        { 17, 17, 16, 16 },     // SIMD body plus a 1-pixel tail
+    };
+
+    const ImageDownscaler::PixelFormat formats[] = {
+        ImageDownscaler::PixelFormat::RGB8,
+        ImageDownscaler::PixelFormat::RGBA8,
+        ImageDownscaler::PixelFormat::BGRA8,
+        ImageDownscaler::PixelFormat::RGBAF32,
+    };
+
+    uint32_t seed = 1;
+    for (const Case& c : cases)
+    {
+        Image image = MakeImage(c.srcWidth, c.srcHeight, seed++);
+        for (ImageDownscaler::PixelFormat format : formats)
+            CheckDownscale(image, c.dstWidth, c.dstHeight, format);
+    }
+}
+
+void TestLanczosKeepsFlatColor()
+{
+    // Normalized weights: a flat image stays flat (Lanczos overshoot only appears at edges)
+    const int width = 97;
+    const int height = 61;
+    std::vector<float> row(static_cast<size_t>(width) * 4);
+    for (int x = 0; x < width; x++)
+    {
+        row[x * 4 + 0] = 0.25f;
+        row[x * 4 + 1] = 1.5f;
+        row[x * 4 + 2] = 8.0f;
+        row[x * 4 + 3] = 1.0f;
+    }
+
+    const int dstWidth = 13;
+    const int dstHeight = 9;
+    std::vector<float> out(static_cast<size_t>(dstWidth) * dstHeight * 4);
+    ImageDownscaler scaler(width, height, dstWidth, dstHeight, ImageDownscaler::Filter::Lanczos3);
+    scaler.SetOutputFloat(out.data(), static_cast<size_t>(dstWidth) * 4);
+    for (int y = 0; y < height; y++)
+        scaler.PushRow(row.data(), ImageDownscaler::PixelFormat::RGBAF32);
+
+    UFB_CHECK(scaler.IsComplete());
+    double maxError = 0.0;
+    for (size_t i = 0; i < out.size(); i++)
+        maxError = (std::max)(maxError, std::abs(static_cast<double>(out[i]) - row[i % 4]));
+    UFB_CHECK(maxError < 1e-4);
+}
+
+void TestFitSize()
+{
+    int width = 0, height = 0;
+    ImageDownscaler::FitSize(4000, 2000, 256, width, height);
+    UFB_CHECK(width == 256 && height == 128);
+
+    ImageDownscaler::FitSize(2000, 4000, 256, width, height);
+    UFB_CHECK(width == 128 && height == 256);
+
+    // Never upscales, never collapses to zero
+    ImageDownscaler::FitSize(100, 50, 256, width, height);
+    UFB_CHECK(width == 100 && height == 50);
+
+    ImageDownscaler::FitSize(1, 5000, 256, width, height);
+    UFB_CHECK(width == 1 && height == 256);
+
+    ImageDownscaler::FitSize(0, 0, 256, width, height);
+    UFB_CHECK(width == 1 && height == 1);
+}
+
+} // namespace
+
+int main()
+{
+    TestAreaAverage();
+    TestLanczosKeepsFlatColor();
+    TestFitSize();
+#ifdef UFB_DOWNSCALER_NO_SIMD
+    return UFB::Test::Result("test_image_downscaler_scalar");
+#else
+    return UFB::Test::Result("test_image_downscaler");
+#endif
+}
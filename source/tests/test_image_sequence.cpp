@@ -0,0 +1,187 @@
+#include "image_sequence.h"
+#include "file_entry.h"
+#include "test_check.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::wstring kDirectory = L"/shots/";
+
+FileEntry MakeFile(const std::wstring& name, uintmax_t size = 100)
+{
+    FileEntry entry;
+    entry.name = name;
+    entry.fullPath = kDirectory + name;
+    entry.isDirectory = false;
+    entry.size = size;
+    entry.lastModified = std::filesystem::file_time_type{};
+    return entry;
+}
+
+std::vector<FileEntry> MakeListing(const std::vector<std::wstring>& names)
+{
+    std::vector<FileEntry> entries;
+    for (const std::wstring& name : names)
+        entries.push_back(MakeFile(name));
+    return entries;
+}
+
+const FileEntry* FindByName(const std::vector<FileEntry>& entries, const std::wstring& name)
+{
+    auto it = std::find_if(entries.begin(), entries.end(), [&name](const FileEntry& entry) { return entry.name == name; });
+    return it == entries.end() ? nullptr : &*it;
+}
+
+void TestGaps()
+{
+    std::vector<FileEntry> entries = MakeListing({ L"shot.1001.exr", L"shot.1002.exr", L"shot.1005.exr" });
+    entries[2].size = 300;
+    entries[1].lastModified = std::filesystem::file_time_type(std::chrono::hours(5));
+    UFB::CollapseImageSequences(entries);
+
+    UFB_CHECK(entries.size() == 1);
+    const FileEntry& sequence = entries[0];
+    UFB_CHECK(sequence.IsSequence());
+    UFB_CHECK(sequence.name == L"shot.####.exr [1001-1005, 2 missing]");
+    UFB_CHECK((sequence.frames == std::vector<int>{ 1001, 1002, 1005 }));
+    UFB_CHECK(sequence.fullPath == kDirectory + L"shot.1001.exr");
+    UFB_CHECK(sequence.size == 500);
+    UFB_CHECK(sequence.lastModified == std::filesystem::file_time_type(std::chrono::hours(5)));
+
+    std::vector<std::wstring> paths;
+    UFB::AppendEntryPaths(sequence, paths);
+    UFB_CHECK((paths == std::vector<std::wstring>{ kDirectory + L"shot.1001.exr", kDirectory + L"shot.1002.exr",
+                                                   kDirectory + L"shot.1005.exr" }));
+}
+
+void TestPadding()
+{
+    // Zero-padded across a digit-count change: one sequence
+    std::vector<FileEntry> padded = MakeListing({ L"a.0998.exr", L"a.0999.exr", L"a.1000.exr", L"a.1001.exr" });
+    UFB::CollapseImageSequences(padded);
+    UFB_CHECK(padded.size() == 1);
+    UFB_CHECK(padded[0].framePadding == 4);
+    UFB_CHECK(padded[0].name == L"a.####.exr [998-1001]");
+    UFB_CHECK(UFB::GetSequenceFramePath(padded[0], 998) == kDirectory + L"a.0998.exr");
+    UFB_CHECK(UFB::GetSequenceFramePath(padded[0], 1001) == kDirectory + L"a.1001.exr");
+
+    // Unpadded across a digit-count change: one sequence, frames written without padding
+    std::vector<FileEntry> unpadded = MakeListing({ L"b.9.exr", L"b.10.exr", L"b.11.exr", L"b.100.exr" });
+    UFB::CollapseImageSequences(unpadded);
+    UFB_CHECK(unpadded.size() == 1);
+    UFB_CHECK(unpadded[0].framePadding == 0);
+    UFB_CHECK(unpadded[0].name == L"b.#.exr [9-100, 88 missing]");
+    UFB_CHECK(UFB::GetSequenceFramePath(unpadded[0], 9) == kDirectory + L"b.9.exr");
+    UFB_CHECK(UFB::GetSequenceFramePath(unpadded[0], 100) == kDirectory + L"b.100.exr");
+
+    // No leading zero anywhere: the digit count is not padding, but the display keeps it
+    std::vector<FileEntry> render = MakeListing({ L"c.1001.exr", L"c.1002.exr" });
+    UFB::CollapseImageSequences(render);
+    UFB_CHECK(render.size() == 1 && render[0].framePadding == 0);
+    UFB_CHECK(render[0].name == L"c.####.exr [1001-1002]");
+
+    // Frames that can't be written with the padding stay individual files
+    std::vector<FileEntry> mixed = MakeListing({ L"d.0001.exr", L"d.0002.exr", L"d.5.exr", L"d.003.exr", L"d.0004.exr" });
+    UFB::CollapseImageSequences(mixed);
+    UFB_CHECK(mixed.size() == 3);
+    UFB_CHECK(mixed[0].name == L"d.####.exr [1-4, 1 missing]");
+    UFB_CHECK((mixed[0].frames == std::vector<int>{ 1, 2, 4 }));
+    UFB_CHECK(mixed[1].name == L"d.5.exr" && !mixed[1].IsSequence());
+    UFB_CHECK(mixed[2].name == L"d.003.exr" && !mixed[2].IsSequence());
+
+    // A single 0 is a frame number, not padding
+    std::vector<FileEntry> zero = MakeListing({ L"e.0.png", L"e.1.png", L"e.2.png" });
+    UFB::CollapseImageSequences(zero);
+    UFB_CHECK(zero.size() == 1 && zero[0].framePadding == 0);
+    UFB_CHECK((zero[0].frames == std::vector<int>{ 0, 1, 2 }));
+}
+
+void TestSeparators()
+{
+    std::vector<FileEntry> entries = MakeListing({ L"render_0001.png", L"render_0002.png", L"render-0001.png",
+                                                   L"render-0002.png", L"render0001.png", L"render0002.png" });
+    UFB::CollapseImageSequences(entries);
+
+    // '_' and '.' separate a frame number; '-' and no separator don't
+    UFB_CHECK(entries.size() == 5);
+    UFB_CHECK(entries[0].name == L"render_####.png [1-2]");
+    UFB_CHECK(UFB::GetSequenceFramePath(entries[0], 2) == kDirectory + L"render_0002.png");
+    UFB_CHECK(FindByName(entries, L"render-0001.png") && FindByName(entries, L"render0002.png"));
+}
+
+void TestMixedExtensions()
+{
+    std::vector<FileEntry> entries = MakeListing({ L"x.0001.exr", L"x.0001.png", L"x.0002.exr", L"x.0002.png",
+                                                   L"x.0003.EXR", L"x.0001.txt", L"x.0002.txt" });
+    FileEntry directory = MakeFile(L"x.0003.exr");
+    directory.isDirectory = true;
+    entries.push_back(directory);
+    UFB::CollapseImageSequences(entries);
+
+    // One sequence per extension (case as written), sequences at their first member's position
+    UFB_CHECK(entries.size() == 6);
+    UFB_CHECK(entries[0].name == L"x.####.exr [1-2]");
+    UFB_CHECK(entries[1].name == L"x.####.png [1-2]");
+    UFB_CHECK(entries[2].name == L"x.0003.EXR" && !entries[2].IsSequence());
+    UFB_CHECK(entries[3].name == L"x.0001.txt" && entries[4].name == L"x.0002.txt");
+    UFB_CHECK(entries[5].isDirectory && !entries[5].IsSequence());
+}
+
+void TestMinFrames()
+{
+    std::vector<FileEntry> entries = MakeListing({ L"single.0001.exr", L"pair.0001.exr", L"pair.0002.exr", L"readme.md" });
+    UFB::CollapseImageSequences(entries);
+    UFB_CHECK(entries.size() == 3);
+    UFB_CHECK(entries[0].name == L"single.0001.exr" && !entries[0].IsSequence());
+    UFB_CHECK(entries[1].name == L"pair.####.exr [1-2]");
+
+    std::vector<FileEntry> strict = MakeListing({ L"pair.0001.exr", L"pair.0002.exr", L"triple.1.exr", L"triple.2.exr",
+                                                  L"triple.3.exr" });
+    UFB::CollapseImageSequences(strict, 3);
+    UFB_CHECK(strict.size() == 3);
+    UFB_CHECK(!strict[0].IsSequence() && !strict[1].IsSequence());
+    UFB_CHECK(strict[2].name == L"triple.#.exr [1-3]");
+
+    // Padding misfits don't count toward the minimum
+    std::vector<FileEntry> misfits = MakeListing({ L"m.0001.exr", L"m.2.exr" });
+    UFB::CollapseImageSequences(misfits);
+    UFB_CHECK(misfits.size() == 2 && !misfits[0].IsSequence() && !misfits[1].IsSequence());
+}
+
+void TestLargeListing()
+{
+    // 1,000 sequences of 100 frames, shuffled
+    std::vector<std::wstring> names;
+    for (int shot = 0; shot < 1000; shot++)
+    {
+        for (int frame = 1001; frame <= 1100; frame++)
+            names.push_back(L"shot" + std::to_wstring(shot) + L"_comp.v001." + std::to_wstring(frame) + L".exr");
+    }
+    std::shuffle(names.begin(), names.end(), std::mt19937(7));
+
+    std::vector<FileEntry> entries = MakeListing(names);
+    UFB::CollapseImageSequences(entries);
+
+    UFB_CHECK(entries.size() == 1000);
+    bool allComplete = std::all_of(entries.begin(), entries.end(), [](const FileEntry& entry) {
+        return entry.frames.size() == 100 && entry.frames.front() == 1001 && entry.frames.back() == 1100 &&
+               entry.size == 100 * 100;
+    });
+    UFB_CHECK(allComplete);
+}
+
+} // namespace
+
+int main()
+{
+    TestGaps();
+    TestPadding();
+    TestSeparators();
+    TestMixedExtensions();
+    TestMinFrames();
+    TestLargeListing();
+    return UFB::Test::Result("test_image_sequence");
+}
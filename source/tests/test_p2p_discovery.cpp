@@ -0,0 +1,244 @@
+#include "p2p_discovery.h"
+#include "p2p_manager.h"
+#include "p2p_protocol.h"
+#include "test_check.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// LAN discovery over multicast loopback: two P2PDiscovery instances see each other's ANNOUNCE and
+// LEAVE (never their own), two P2PManagers find and connect to each other with no peers registry,
+// and an announced peer gets exactly one connection from a P2PManager whichever device ID is lower
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string g_suffix;   // Unique per run: other hosts on the LAN see these announcements too
+
+bool WaitFor(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    Clock::time_point deadline = Clock::now() + timeout;
+    while (!predicate())
+    {
+        if (Clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+// What one discovery instance heard from this run's devices
+struct Heard
+{
+    mutable std::mutex mutex;
+    std::map<std::string, UFB::DiscoveredPeer> announced;  // deviceId -> latest announcement
+    std::map<std::string, int> announceCounts;
+    std::set<std::string> left;
+
+    bool Start(UFB::P2PDiscovery& discovery, const std::string& deviceId, uint16_t port)
+    {
+        return discovery.Start(deviceId, deviceId, port, UFB::kP2PProtocolVersion,
+            [this](const UFB::DiscoveredPeer& peer) {
+                if (peer.deviceId.find(g_suffix) == std::string::npos)
+                    return;
+                std::lock_guard<std::mutex> lock(mutex);
+                announced[peer.deviceId] = peer;
+                announceCounts[peer.deviceId]++;
+            },
+            [this](const std::string& deviceId) {
+                std::lock_guard<std::mutex> lock(mutex);
+                left.insert(deviceId);
+            });
+    }
+
+    bool HasAnnounced(const std::string& deviceId) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return announced.count(deviceId) > 0;
+    }
+
+    bool HasLeft(const std::string& deviceId) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return left.count(deviceId) > 0;
+    }
+};
+
+// TCP listener standing in for a peer's P2P port: counts the connections made to it
+class CountingListener
+{
+public:
+    ~CountingListener()
+    {
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+        for (int fd : m_accepted)
+            close(fd);
+        if (m_fd >= 0)
+            close(m_fd);
+    }
+
+    bool Start()
+    {
+        m_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        socklen_t length = sizeof(addr);
+        if (m_fd < 0 || bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(m_fd, 16) != 0 ||
+            getsockname(m_fd, reinterpret_cast<sockaddr*>(&addr), &length) != 0)
+            return false;
+
+        m_port = ntohs(addr.sin_port);
+        m_running = true;
+        m_thread = std::thread([this]() {
+            while (m_running)
+            {
+                pollfd pfd = { m_fd, POLLIN, 0 };
+                if (poll(&pfd, 1, 50) > 0)
+                {
+                    int fd = accept(m_fd, nullptr, nullptr);
+                    if (fd >= 0)
+                    {
+                        m_accepted.push_back(fd);
+                        m_count++;
+                    }
+                }
+            }
+        });
+        return true;
+    }
+
+    uint16_t Port() const { return m_port; }
+    int Count() const { return m_count; }
+
+private:
+    int m_fd = -1;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_running{false};
+    std::atomic<int> m_count{0};
+    std::vector<int> m_accepted;    // Listener thread only
+    std::thread m_thread;
+};
+
+void TestAnnounceAndLeave()
+{
+    const std::string idA = "disc-a-" + g_suffix;
+    const std::string idB = "disc-b-" + g_suffix;
+
+    UFB::P2PDiscovery a;
+    UFB::P2PDiscovery b;
+    Heard heardA;
+    Heard heardB;
+    UFB_CHECK(heardA.Start(a, idA, 40001));
+    UFB_CHECK(heardB.Start(b, idB, 40002));
+
+    UFB_CHECK(WaitFor([&]() { return heardA.HasAnnounced(idB) && heardB.HasAnnounced(idA); }, std::chrono::seconds(3)));
+    {
+        std::lock_guard<std::mutex> lock(heardA.mutex);
+        auto it = heardA.announced.find(idB);
+        UFB_CHECK(it != heardA.announced.end() && it->second.port == 40002);
+        UFB_CHECK(it != heardA.announced.end() && it->second.deviceName == idB);
+        UFB_CHECK(it != heardA.announced.end() && it->second.protocol == UFB::kP2PProtocolVersion);
+        UFB_CHECK(it != heardA.announced.end() && !it->second.ipAddress.empty());
+
+        // Own packets come back through multicast loopback but aren't reported
+        UFB_CHECK(heardA.announced.count(idA) == 0);
+    }
+    UFB_CHECK(!heardB.HasAnnounced(idB));
+
+    // LEAVE on stop
+    b.Stop();
+    UFB_CHECK(WaitFor([&]() { return heardA.HasLeft(idB); }, std::chrono::seconds(2)));
+    a.Stop();
+    UFB_CHECK(!heardA.HasLeft(idA));
+}
+
+// Announce -> connect -> HELLO with nothing but multicast; shutdown (GOODBYE, LEAVE) drops the peer
+void TestManagersFindEachOther()
+{
+    const std::string idA = "disc-ma-" + g_suffix;
+    const std::string idB = "disc-mb-" + g_suffix;
+
+    UFB::P2PManager a;
+    UFB::P2PManager b;
+    UFB_CHECK(a.Initialize(std::wstring(idA.begin(), idA.end())) && a.StartListening(0));
+    UFB_CHECK(b.Initialize(std::wstring(idB.begin(), idB.end())) && b.StartListening(0));
+    UFB_CHECK(a.IsLanDiscoveryRunning() && b.IsLanDiscoveryRunning());
+
+    UFB_CHECK(WaitFor([&]() { return a.GetActivePeers().size() == 1 && b.GetActivePeers().size() == 1; },
+                      std::chrono::seconds(5)));
+    UFB_CHECK(a.GetPeerCount() == 1);
+    UFB_CHECK(b.GetPeerCount() == 1);
+
+    b.Shutdown();
+    UFB_CHECK(WaitFor([&]() { return a.GetActivePeers().empty() && a.GetPeerCount() == 0; }, std::chrono::seconds(3)));
+    a.Shutdown();
+}
+
+// A P2PManager hearing a peer: connects once if its own ID is the lower one (however often the peer
+// announces), otherwise announces back and leaves the connect to the peer
+void TestOneConnectionPerPair(bool managerIsLower)
+{
+    const std::string managerId = "disc-m-" + g_suffix;
+    const std::string peerId = (managerIsLower ? "disc-z-" : "disc-0-") + g_suffix;
+
+    UFB::P2PManager manager;
+    UFB_CHECK(manager.Initialize(std::wstring(managerId.begin(), managerId.end())) && manager.StartListening(0));
+
+    CountingListener listener;
+    UFB_CHECK(listener.Start());
+
+    UFB::P2PDiscovery peer;
+    Heard heard;
+    UFB_CHECK(heard.Start(peer, peerId, listener.Port()));
+
+    if (managerIsLower)
+    {
+        UFB_CHECK(WaitFor([&]() { return listener.Count() > 0; }, std::chrono::seconds(3)));
+    }
+    else
+    {
+        UFB_CHECK(WaitFor([&]() { return heard.HasAnnounced(managerId); }, std::chrono::seconds(3)));
+    }
+
+    // Startup announcements (three, over about 3.5 s) and extra ones don't add connections
+    peer.AnnounceNow();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    peer.AnnounceNow();
+    std::this_thread::sleep_for(std::chrono::milliseconds(3500));
+
+    UFB_CHECK(listener.Count() == (managerIsLower ? 1 : 0));
+
+    peer.Stop();
+    manager.Shutdown();
+}
+
+} // namespace
+
+int main()
+{
+    // P2PManager logs to both std::cout and std::wcout: unsynced, so glibc doesn't drop one of them
+    // once stdout has taken the other's orientation
+    std::ios::sync_with_stdio(false);
+    g_suffix = std::to_string(getpid());
+
+    TestAnnounceAndLeave();
+    TestManagersFindEachOther();
+    TestOneConnectionPerPair(true);
+    TestOneConnectionPerPair(false);
+    return UFB::Test::Result("test_p2p_discovery");
+}
@@ -0,0 +1,234 @@
+#include "p2p_manager.h"
+#include "pushed_entries.h"
+#include "test_check.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// Two P2PManagers connected over loopback (epoll transport on Linux): pushed entries from
+// notify to applied, a lost CHANGE_NOTIFY recovered with SYNC_REQUEST, and pushes for a job the
+// receiver isn't subscribed to falling back to a share read.
+// The entries callback does what SyncManager::OnP2PEntriesReceived does, minus the metadata cache
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+
+constexpr auto kTimeout = std::chrono::seconds(5);
+
+struct Node
+{
+    std::wstring deviceId;
+    UFB::P2PManager p2p;
+    UFB::PushedEntryTracker tracker;
+    std::set<std::wstring> subscribed;      // SubscriptionManager stand-in
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::map<std::pair<std::wstring, uint64_t>, Clock::time_point> applied;    // (job, entry timestamp) -> when
+    std::vector<std::wstring> shareReads;                                        // Change callback (re-read the share)
+    std::vector<uint64_t> syncRequests;                                          // since of SYNC_REQUESTs served
+    std::map<std::wstring, std::vector<json>> ownLog;                            // Entries this node made, per job
+};
+
+json MakeEntry(const Node& node, uint64_t timestamp, const std::string& shotPath)
+{
+    return {
+        {"deviceId", std::string(node.deviceId.begin(), node.deviceId.end())},
+        {"timestamp", timestamp},
+        {"operation", "update"},
+        {"shotPath", shotPath},
+        {"data", {{"status", "In Progress"}, {"modifiedTime", timestamp}}}
+    };
+}
+
+void Start(Node& node, const std::wstring& deviceId)
+{
+    node.deviceId = deviceId;
+    UFB_CHECK(node.p2p.Initialize(deviceId));
+    UFB_CHECK(node.p2p.StartListening(0));
+
+    node.p2p.RegisterEntriesCallback([&node](const UFB::P2PChangeBatch& batch) {
+        if (batch.jobPath.empty() || node.subscribed.count(batch.jobPath) == 0)
+            return false;
+
+        UFB::PushedEntries pushed;
+        if (!node.tracker.Accept(batch, pushed))
+            return false;
+
+        if (pushed.missingSince > 0)
+            node.p2p.RequestChanges(batch.deviceId, batch.jobPath, pushed.missingSince);
+
+        std::lock_guard<std::mutex> lock(node.mutex);
+        for (const auto& entry : pushed.updates)
+            node.applied.emplace(std::make_pair(batch.jobPath, entry["timestamp"].get<uint64_t>()), Clock::now());
+        node.changed.notify_all();
+        return !pushed.hasDeletes;
+    });
+
+    node.p2p.RegisterChangeCallback([&node](const std::wstring& jobPath, const std::wstring&, uint64_t) {
+        std::lock_guard<std::mutex> lock(node.mutex);
+        node.shareReads.push_back(jobPath);
+        node.changed.notify_all();
+    });
+
+    node.p2p.RegisterSyncRequestCallback([&node](const std::wstring& jobPath, uint64_t sinceTimestamp) {
+        std::lock_guard<std::mutex> lock(node.mutex);
+        node.syncRequests.push_back(sinceTimestamp);
+        json entries = json::array();
+        for (const auto& entry : node.ownLog[jobPath])
+            if (entry["timestamp"].get<uint64_t>() > sinceTimestamp)
+                entries.push_back(entry);
+        return entries;
+    });
+}
+
+template <typename Predicate>
+bool WaitFor(Node& node, Predicate predicate)
+{
+    std::unique_lock<std::mutex> lock(node.mutex);
+    return node.changed.wait_for(lock, kTimeout, predicate);
+}
+
+bool IsApplied(Node& node, const std::wstring& jobPath, uint64_t timestamp)
+{
+    return node.applied.count({ jobPath, timestamp }) > 0;
+}
+
+// Push one entry from sender (recorded in its log) and return when the push was made
+Clock::time_point Push(Node& sender, const std::wstring& jobPath, uint64_t timestamp, uint64_t previousTimestamp,
+                       const std::string& shotPath, bool lost = false)
+{
+    json entry = MakeEntry(sender, timestamp, shotPath);
+    {
+        std::lock_guard<std::mutex> lock(sender.mutex);
+        sender.ownLog[jobPath].push_back(entry);
+    }
+
+    Clock::time_point now = Clock::now();
+    if (!lost)
+        sender.p2p.NotifyPeersOfChange(jobPath, timestamp, json::array({ entry }), previousTimestamp);
+    return now;
+}
+
+void TestConnect(Node& a, Node& b)
+{
+    UFB_CHECK(a.p2p.ConnectToPeer("127.0.0.1", b.p2p.GetListeningPort()));
+
+    Clock::time_point deadline = Clock::now() + kTimeout;
+    while ((a.p2p.GetActivePeers().empty() || b.p2p.GetActivePeers().empty()) && Clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    UFB_CHECK(a.p2p.GetActivePeers().size() == 1);
+    UFB_CHECK(b.p2p.GetActivePeers().size() == 1);
+}
+
+// Isolated changes (one per coalescing window) from NotifyPeersOfChange to applied on the other node
+uint64_t TestLatency(Node& a, Node& b, const std::wstring& jobPath)
+{
+    std::vector<double> latencies;
+    uint64_t previous = 0;
+    for (uint64_t timestamp = 1001; timestamp <= 1020; timestamp++)
+    {
+        Clock::time_point pushed = Push(a, jobPath, timestamp, previous, "shots/sh0010");
+        previous = timestamp;
+
+        UFB_CHECK(WaitFor(b, [&]() { return IsApplied(b, jobPath, timestamp); }));
+        {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            auto it = b.applied.find({ jobPath, timestamp });
+            if (it != b.applied.end())
+                latencies.push_back(std::chrono::duration<double, std::milli>(it->second - pushed).count());
+        }
+
+        // Past the coalescing window, so the next change goes out right away
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    }
+
+    UFB_CHECK(latencies.size() == 20);
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "notify -> applied: median " << latencies[latencies.size() / 2] << " ms, max "
+                  << latencies.back() << " ms over " << latencies.size() << " changes" << std::endl;
+
+        // First change after a quiet period isn't held for the window; loopback is well under this
+        UFB_CHECK(latencies[latencies.size() / 2] < 50.0);
+        UFB_CHECK(latencies.back() < 500.0);
+    }
+
+    // Nothing was missed, so nothing was requested
+    std::lock_guard<std::mutex> lock(a.mutex);
+    UFB_CHECK(a.syncRequests.empty());
+    return previous;
+}
+
+// A CHANGE_NOTIFY that never arrives: the next one's previousTimestamp is newer than what the
+// receiver applied, so it asks for the gap with SYNC_REQUEST
+void TestGapRequestsChanges(Node& a, Node& b, const std::wstring& jobPath, uint64_t lastPushed)
+{
+    const uint64_t missed = lastPushed + 1;
+    const uint64_t next = lastPushed + 2;
+    Push(a, jobPath, missed, lastPushed, "shots/sh0020", true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    Push(a, jobPath, next, missed, "shots/sh0030");
+
+    UFB_CHECK(WaitFor(b, [&]() { return IsApplied(b, jobPath, next) && IsApplied(b, jobPath, missed); }));
+
+    std::lock_guard<std::mutex> lock(a.mutex);
+    UFB_CHECK(a.syncRequests.size() == 1);
+    UFB_CHECK(!a.syncRequests.empty() && a.syncRequests[0] == lastPushed);
+}
+
+// Entries for a job the receiver doesn't sync are rejected: the notification falls back to the
+// change callback and nothing is applied
+void TestUnsubscribedJob(Node& a, Node& b, const std::wstring& otherJob)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    Push(a, otherJob, 5001, 0, "shots/sh0040");
+
+    UFB_CHECK(WaitFor(b, [&]() { return std::find(b.shareReads.begin(), b.shareReads.end(), otherJob) != b.shareReads.end(); }));
+
+    std::lock_guard<std::mutex> lock(b.mutex);
+    UFB_CHECK(!IsApplied(b, otherJob, 5001));
+}
+
+} // namespace
+
+int main()
+{
+    // P2PManager logs to both std::cout and std::wcout: unsynced, so glibc doesn't drop one of them
+    // once stdout has taken the other's orientation
+    std::ios::sync_with_stdio(false);
+
+    // Unique per run: the nodes also announce themselves on the LAN
+    const std::wstring suffix = std::to_wstring(getpid());
+    const std::wstring jobPath = L"/jobs/loopback_" + suffix;
+    const std::wstring otherJob = L"/jobs/not_synced_" + suffix;
+
+    {
+        Node a;
+        Node b;
+        Start(a, L"loopback-a-" + suffix);
+        Start(b, L"loopback-b-" + suffix);
+        b.subscribed.insert(jobPath);
+
+        TestConnect(a, b);
+        uint64_t lastPushed = TestLatency(a, b, jobPath);
+        TestGapRequestsChanges(a, b, jobPath, lastPushed);
+        TestUnsubscribedJob(a, b, otherJob);
+
+        a.p2p.Shutdown();
+        b.p2p.Shutdown();
+    }
+
+    return UFB::Test::Result("test_p2p_loopback");
+}
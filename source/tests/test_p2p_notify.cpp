@@ -0,0 +1,266 @@
+#include "p2p_manager.h"
+#include "p2p_sim_peers.h"
+#include "test_check.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+// Outgoing CHANGE_NOTIFY queues of P2PManager over loopback: a bulk edit is coalesced into one
+// message per peer and job, a batch past the entry limit goes out without entries (receivers
+// re-read the share), and a peer that stops reading has its notifications merged until it catches up.
+// Two P2PManagers receive; the slow peer is a raw socket (SimulatedPeers)
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+// Past the coalescing window (kNotifyCoalesceMs), so the next change goes out right away
+constexpr auto kQuiet = std::chrono::milliseconds(60);
+
+std::string g_senderId;
+
+struct Receiver
+{
+    UFB::P2PManager p2p;
+
+    mutable std::mutex mutex;
+    std::map<std::wstring, int> applies;                    // jobPath -> entries callbacks
+    std::map<std::wstring, int> shareReads;                 // jobPath -> change callbacks
+    std::map<std::string, uint64_t> shots;                  // shotPath -> newest applied timestamp
+    uint64_t newest = 0;
+
+    void Start(const std::string& deviceId)
+    {
+        UFB_CHECK(p2p.Initialize(std::wstring(deviceId.begin(), deviceId.end())));
+        UFB_CHECK(p2p.StartListening(0));
+
+        p2p.RegisterEntriesCallback([this](const UFB::P2PChangeBatch& batch) {
+            std::lock_guard<std::mutex> lock(mutex);
+            applies[batch.jobPath]++;
+            for (const auto& entry : batch.entries)
+            {
+                uint64_t timestamp = entry.value("timestamp", 0ULL);
+                uint64_t& shot = shots[entry.value("shotPath", "")];
+                shot = (std::max)(shot, timestamp);
+                newest = (std::max)(newest, timestamp);
+            }
+            return true;
+        });
+
+        p2p.RegisterChangeCallback([this](const std::wstring& jobPath, const std::wstring&, uint64_t timestamp) {
+            std::lock_guard<std::mutex> lock(mutex);
+            shareReads[jobPath]++;
+            newest = (std::max)(newest, timestamp);
+        });
+    }
+
+    int Applies(const std::wstring& jobPath) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = applies.find(jobPath);
+        return it != applies.end() ? it->second : 0;
+    }
+
+    int ShareReads(const std::wstring& jobPath) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = shareReads.find(jobPath);
+        return it != shareReads.end() ? it->second : 0;
+    }
+
+    uint64_t Newest() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return newest;
+    }
+};
+
+json MakeEntry(uint64_t timestamp, const std::string& shotPath, size_t payloadBytes = 0)
+{
+    json entry = {
+        {"deviceId", g_senderId},
+        {"timestamp", timestamp},
+        {"operation", "update"},
+        {"shotPath", shotPath},
+        {"data", {{"status", "In Progress"}, {"modifiedTime", timestamp}}}
+    };
+    if (payloadBytes > 0)
+        entry["data"]["notes"] = std::string(payloadBytes, 'n');
+    return entry;
+}
+
+bool WaitForNewest(Receiver& a, Receiver& b, uint64_t timestamp)
+{
+    return SimulatedPeers::WaitFor([&]() { return a.Newest() >= timestamp && b.Newest() >= timestamp; }, kTimeout);
+}
+
+// 500 edits to 100 shots of one job as fast as they come, right after a single change went out
+void TestBurstIsCoalesced(UFB::P2PManager& sender, Receiver& a, Receiver& b, uint64_t& timestamp)
+{
+    const std::wstring jobPath = L"/jobs/burst";
+
+    // The lead change goes out at once and opens the next coalescing window
+    timestamp++;
+    sender.NotifyPeersOfChange(jobPath, timestamp, json::array({ MakeEntry(timestamp, "shots/lead") }), timestamp - 1);
+    UFB_CHECK(WaitForNewest(a, b, timestamp));
+    const int applies = a.Applies(jobPath);
+    UFB_CHECK(applies == 1);
+
+    Clock::time_point start = Clock::now();
+    for (int edit = 0; edit < 500; edit++)
+    {
+        timestamp++;
+        sender.NotifyPeersOfChange(jobPath, timestamp, json::array({ MakeEntry(timestamp, "shots/sh" + std::to_string(edit % 100)) }),
+                                   timestamp - 1);
+    }
+    const double issueMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    UFB_CHECK(WaitForNewest(a, b, timestamp));
+
+    for (Receiver* receiver : { &a, &b })
+    {
+        const int burstApplies = receiver->Applies(jobPath) - applies;
+        std::cout << "500-edit burst issued in " << issueMs << " ms: " << burstApplies << " message(s)" << std::endl;
+        UFB_CHECK(burstApplies >= 1 && burstApplies <= 2);
+
+        // Within one window the whole burst is one message, applied once
+        if (issueMs < 40.0)
+            UFB_CHECK(burstApplies == 1);
+
+        // Latest entry of every shot arrived
+        std::lock_guard<std::mutex> lock(receiver->mutex);
+        bool latest = true;
+        for (int shot = 0; shot < 100; shot++)
+            latest = latest && receiver->shots["shots/sh" + std::to_string(shot)] == timestamp - 99 + static_cast<uint64_t>(shot);
+        UFB_CHECK(latest);
+        UFB_CHECK(receiver->shareReads.count(jobPath) == 0);
+    }
+}
+
+// More entries than kMaxCoalescedEntries: sent without them, receivers fall back to the share
+void TestOversizedBatchFallsBack(UFB::P2PManager& sender, Receiver& a, Receiver& b, uint64_t& timestamp)
+{
+    const std::wstring jobPath = L"/jobs/oversized";
+    std::this_thread::sleep_for(kQuiet);
+
+    json entries = json::array();
+    for (int shot = 0; shot < 2500; shot++)
+        entries.push_back(MakeEntry(++timestamp, "shots/bulk" + std::to_string(shot)));
+    sender.NotifyPeersOfChange(jobPath, timestamp, entries, 0);
+
+    UFB_CHECK(WaitForNewest(a, b, timestamp));
+    UFB_CHECK(a.ShareReads(jobPath) == 1);
+    UFB_CHECK(b.ShareReads(jobPath) == 1);
+    UFB_CHECK(a.Applies(jobPath) == 0);
+    UFB_CHECK(b.Applies(jobPath) == 0);
+}
+
+// A peer that stops reading: once more than kMaxPendingSendBytes is unsent, its notifications are
+// held back and merged while the others keep getting every window
+void TestSlowPeerIsHeldBack(UFB::P2PManager& sender, Receiver& a, Receiver& b, SimulatedPeers& slow, uint64_t& timestamp)
+{
+    const std::wstring jobPath = L"/jobs/backpressure";
+    const int fastBefore = a.Applies(jobPath);
+    const size_t slowBefore = slow.MessageCount(0, UFB::P2PMessageType::CHANGE_NOTIFY);
+
+    slow.SetPaused(0, true);
+
+    // Three windows of ~4 MB each
+    for (int window = 0; window < 3; window++)
+    {
+        std::this_thread::sleep_for(kQuiet);
+        json entries = json::array();
+        for (int shot = 0; shot < 100; shot++)
+            entries.push_back(MakeEntry(++timestamp, "shots/big" + std::to_string(shot), 40 * 1024));
+        sender.NotifyPeersOfChange(jobPath, timestamp, entries, timestamp - 100);
+        UFB_CHECK(WaitForNewest(a, b, timestamp));
+    }
+
+    // Small edits of one shot, one per window
+    for (int edit = 0; edit < 5; edit++)
+    {
+        std::this_thread::sleep_for(kQuiet);
+        timestamp++;
+        sender.NotifyPeersOfChange(jobPath, timestamp, json::array({ MakeEntry(timestamp, "shots/small") }), timestamp - 1);
+        UFB_CHECK(WaitForNewest(a, b, timestamp));
+    }
+
+    UFB_CHECK(a.Applies(jobPath) - fastBefore == 8);
+    UFB_CHECK(b.Applies(jobPath) - fastBefore == 8);
+
+    // Catches up with fewer, merged messages
+    slow.SetPaused(0, false);
+    UFB_CHECK(SimulatedPeers::WaitFor([&]() { return slow.NewestTimestamp(0, UFB::P2PMessageType::CHANGE_NOTIFY) >= timestamp; },
+                                      kTimeout));
+
+    std::vector<SimulatedPeers::Received> received = slow.Messages(0, UFB::P2PMessageType::CHANGE_NOTIFY);
+    const size_t slowMessages = received.size() - slowBefore;
+    std::cout << "slow peer: " << slowMessages << " message(s), others 8" << std::endl;
+    UFB_CHECK(slowMessages < 8);
+
+    // The last one holds the latest state of the small shot, once
+    if (!received.empty())
+    {
+        const UFB::P2PMessage& last = received.back().message;
+        UFB_CHECK(last.timestamp == timestamp);
+        int smallEntries = 0;
+        uint64_t smallTimestamp = 0;
+        for (const auto& entry : last.entries)
+        {
+            if (entry.value("shotPath", "") == "shots/small")
+            {
+                smallEntries++;
+                smallTimestamp = entry.value("timestamp", 0ULL);
+            }
+        }
+        UFB_CHECK(smallEntries == 1);
+        UFB_CHECK(smallTimestamp == timestamp);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    // P2PManager logs to both std::cout and std::wcout: unsynced, so glibc doesn't drop one of them
+    // once stdout has taken the other's orientation
+    std::ios::sync_with_stdio(false);
+
+    const std::string suffix = std::to_string(getpid());
+    g_senderId = "notify-sender-" + suffix;
+
+    UFB::P2PManager sender;
+    UFB_CHECK(sender.Initialize(std::wstring(g_senderId.begin(), g_senderId.end())) && sender.StartListening(0));
+
+    Receiver a;
+    Receiver b;
+    a.Start("notify-a-" + suffix);
+    b.Start("notify-b-" + suffix);
+    UFB_CHECK(sender.ConnectToPeer("127.0.0.1", a.p2p.GetListeningPort()));
+    UFB_CHECK(sender.ConnectToPeer("127.0.0.1", b.p2p.GetListeningPort()));
+
+    // Small receive buffer, so pausing it fills up quickly
+    SimulatedPeers slow;
+    UFB_CHECK(slow.Connect("notify-slow-" + suffix, sender.GetListeningPort(), 1, 4096));
+
+    UFB_CHECK(SimulatedPeers::WaitFor([&]() { return sender.GetPeerCount() == 3; }, kTimeout));
+
+    uint64_t timestamp = 1000;
+    TestBurstIsCoalesced(sender, a, b, timestamp);
+    TestOversizedBatchFallsBack(sender, a, b, timestamp);
+    TestSlowPeerIsHeldBack(sender, a, b, slow, timestamp);
+
+    slow.Stop();
+    sender.Shutdown();
+    a.p2p.Shutdown();
+    b.p2p.Shutdown();
+    return UFB::Test::Result("test_p2p_notify");
+}
@@ -0,0 +1,239 @@
+#include "p2p_protocol.h"
+#include "test_check.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using namespace UFB;
+
+namespace {
+
+P2PMessage MakeRangeResponse()
+{
+    P2PMessage message;
+    message.type = P2PMessageType::RANGE_RESPONSE;
+    message.jobPath = "\\\\server\\jobs\\job_001";
+    message.deviceId = "device-a";
+    message.buckets = { 0, 7, 4095 };
+    message.entries = json::array({
+        { {"shotPath", "sh010"}, {"timestamp", 1700000000000ull}, {"operation", "update"} },
+        { {"shotPath", "sh020"}, {"timestamp", 1700000000001ull}, {"operation", "update"} }
+    });
+    return message;
+}
+
+// Body of an encoded frame (length prefix removed)
+std::vector<char> Body(const std::vector<char>& frame)
+{
+    return std::vector<char>(frame.begin() + 4, frame.end());
+}
+
+void TestLengthPrefix()
+{
+    char prefix[4];
+    P2PCodec::WriteLength(prefix, 0x01020304u);
+    UFB_CHECK(prefix[0] == 0x01 && prefix[1] == 0x02 && prefix[2] == 0x03 && prefix[3] == 0x04);
+    UFB_CHECK(P2PCodec::ReadLength(prefix) == 0x01020304u);
+
+    P2PCodec::WriteLength(prefix, 0xFFFFFFF0u);
+    UFB_CHECK(P2PCodec::ReadLength(prefix) == 0xFFFFFFF0u);
+}
+
+void TestBinaryRoundTrip()
+{
+    P2PMessage notify;
+    notify.type = P2PMessageType::CHANGE_NOTIFY;
+    notify.jobPath = "job";
+    notify.deviceId = "device-b";
+    notify.timestamp = 1700000000123ull;
+    notify.previousTimestamp = 1700000000100ull;
+    notify.entries = json::array({ { {"shotPath", "sh030"} } });
+
+    std::vector<char> frame = P2PCodec::EncodeBinary(notify);
+    UFB_CHECK(P2PCodec::ReadLength(frame.data()) == frame.size() - 4);
+
+    std::vector<char> body = Body(frame);
+    UFB_CHECK(P2PCodec::IsBinary(body.data(), body.size()));
+
+    P2PMessage decoded;
+    UFB_CHECK(P2PCodec::DecodeBinary(body.data(), body.size(), decoded));
+    UFB_CHECK(decoded.type == P2PMessageType::CHANGE_NOTIFY);
+    UFB_CHECK(decoded.jobPath == notify.jobPath);
+    UFB_CHECK(decoded.deviceId == notify.deviceId);
+    UFB_CHECK(decoded.timestamp == notify.timestamp);
+    UFB_CHECK(decoded.previousTimestamp == notify.previousTimestamp);
+    UFB_CHECK(decoded.entries == notify.entries);
+
+    P2PMessage range = MakeRangeResponse();
+    body = Body(P2PCodec::EncodeBinary(range));
+    P2PMessage decodedRange;
+    UFB_CHECK(P2PCodec::DecodeBinary(body.data(), body.size(), decodedRange));
+    UFB_CHECK(decodedRange.type == P2PMessageType::RANGE_RESPONSE);
+    UFB_CHECK(decodedRange.jobPath == range.jobPath);
+    UFB_CHECK(decodedRange.buckets == range.buckets);
+    UFB_CHECK(decodedRange.entries == range.entries);
+
+    P2PMessage request;
+    request.type = P2PMessageType::RANGE_REQUEST;
+    request.jobPath = "job";
+    request.deviceId = "device-c";
+    request.buckets = { 1, 2, 3 };
+    request.knownShots = { 0x0123456789ABCDEFull, 0xFFFFFFFFFFFFFFFFull };
+    body = Body(P2PCodec::EncodeBinary(request));
+    P2PMessage decodedRequest;
+    UFB_CHECK(P2PCodec::DecodeBinary(body.data(), body.size(), decodedRequest));
+    UFB_CHECK(decodedRequest.buckets == request.buckets);
+    UFB_CHECK(decodedRequest.knownShots == request.knownShots);
+
+    // No entries travel as an empty field and come back as null
+    P2PMessage response;
+    response.type = P2PMessageType::SYNC_RESPONSE;
+    response.jobPath = "job";
+    response.since = 42;
+    response.entries = json::array();
+    body = Body(P2PCodec::EncodeBinary(response));
+    P2PMessage decodedResponse;
+    UFB_CHECK(P2PCodec::DecodeBinary(body.data(), body.size(), decodedResponse));
+    UFB_CHECK(decodedResponse.since == 42);
+    UFB_CHECK(decodedResponse.entries.is_null());
+}
+
+void TestBinaryTruncation()
+{
+    std::vector<char> body = Body(P2PCodec::EncodeBinary(MakeRangeResponse()));
+
+    // Every strict prefix of a body is rejected, never read past
+    for (size_t size = 0; size < body.size(); ++size)
+    {
+        std::vector<char> truncated(body.begin(), body.begin() + size);
+        P2PMessage decoded;
+        UFB_CHECK(!P2PCodec::DecodeBinary(truncated.data(), truncated.size(), decoded));
+    }
+
+    // A string length pointing past the end of the body
+    std::vector<char> oversized = body;
+    oversized[2] = 0x7F;
+    P2PMessage decoded;
+    UFB_CHECK(!P2PCodec::DecodeBinary(oversized.data(), oversized.size(), decoded));
+
+    // HELLO is JSON only, and JSON bodies are not binary
+    std::vector<char> hello = { static_cast<char>(kP2PBinaryFormatV1), static_cast<char>(P2PMessageType::HELLO) };
+    UFB_CHECK(!P2PCodec::DecodeBinary(hello.data(), hello.size(), decoded));
+
+    std::vector<char> jsonBody = Body(P2PCodec::EncodeJson(P2PMessageType::PING, json{ {"timestamp", 1} }));
+    UFB_CHECK(!P2PCodec::IsBinary(jsonBody.data(), jsonBody.size()));
+}
+
+void TestJsonRoundTrip()
+{
+    P2PMessage range = MakeRangeResponse();
+    std::vector<char> frame = P2PCodec::EncodeJson(range);
+    UFB_CHECK(P2PCodec::ReadLength(frame.data()) == frame.size() - 4);
+
+    json parsed = json::parse(frame.begin() + 4, frame.end());
+    UFB_CHECK(parsed["type"] == static_cast<uint32_t>(P2PMessageType::RANGE_RESPONSE));
+
+    P2PMessage decoded;
+    UFB_CHECK(P2PCodec::FromJsonPayload(P2PMessageType::RANGE_RESPONSE, parsed["payload"], decoded));
+    UFB_CHECK(decoded.jobPath == range.jobPath);
+    UFB_CHECK(decoded.deviceId == range.deviceId);
+    UFB_CHECK(decoded.buckets == range.buckets);
+    UFB_CHECK(decoded.entries == range.entries);
+
+    UFB_CHECK(!P2PCodec::FromJsonPayload(static_cast<P2PMessageType>(99), json::object(), decoded));
+}
+
+void TestReceiveRing()
+{
+    // Smallest ring, so appends wrap and grow
+    P2PReceiveRing ring(1);
+    std::vector<char> scratch;
+
+    std::vector<char> first(700);
+    for (size_t i = 0; i < first.size(); ++i)
+        first[i] = static_cast<char>(i);
+
+    ring.Append(first.data(), first.size());
+    UFB_CHECK(ring.Size() == 700);
+    ring.Consume(600);
+    UFB_CHECK(ring.Size() == 100);
+
+    // Head at 600 of 1024: the next 600 bytes wrap around the end
+    std::vector<char> second(600);
+    for (size_t i = 0; i < second.size(); ++i)
+        second[i] = static_cast<char>(200 + i);
+    ring.Append(second.data(), second.size());
+    UFB_CHECK(ring.Size() == 700);
+
+    const char* view = ring.Peek(0, 700, scratch);
+    bool same = true;
+    for (size_t i = 0; i < 100; ++i)
+        same = same && view[i] == first[600 + i];
+    for (size_t i = 0; i < 600; ++i)
+        same = same && view[100 + i] == second[i];
+    UFB_CHECK(same);
+
+    // Growing past the capacity keeps the order
+    std::vector<char> third(2000, 'x');
+    ring.Append(third.data(), third.size());
+    UFB_CHECK(ring.Size() == 2700);
+    view = ring.Peek(0, 2700, scratch);
+    UFB_CHECK(view[0] == first[600] && view[100] == second[0] && view[700] == 'x' && view[2699] == 'x');
+
+    // Consuming more than is buffered empties the ring
+    ring.Consume(10000);
+    UFB_CHECK(ring.Empty());
+}
+
+void TestFramesThroughRing()
+{
+    // Frames arriving in odd-sized pieces are parsed the way the receive loop does
+    std::vector<char> stream;
+    std::vector<P2PMessage> sent;
+    for (int i = 0; i < 20; ++i)
+    {
+        P2PMessage message = MakeRangeResponse();
+        message.buckets = { static_cast<uint32_t>(i) };
+        std::vector<char> frame = P2PCodec::EncodeBinary(message);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+        sent.push_back(message);
+    }
+
+    P2PReceiveRing ring(1);
+    std::vector<char> scratch;
+    size_t received = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += 37)
+    {
+        ring.Append(stream.data() + offset, (std::min)(size_t(37), stream.size() - offset));
+
+        while (ring.Size() >= 4)
+        {
+            uint32_t length = P2PCodec::ReadLength(ring.Peek(0, 4, scratch));
+            if (ring.Size() < 4 + length)
+                break;
+
+            const char* body = ring.Peek(4, length, scratch);
+            P2PMessage decoded;
+            UFB_CHECK(P2PCodec::DecodeBinary(body, length, decoded));
+            UFB_CHECK(received < sent.size() && decoded.buckets == sent[received].buckets);
+            ring.Consume(4 + length);
+            received++;
+        }
+    }
+    UFB_CHECK(received == sent.size());
+    UFB_CHECK(ring.Empty());
+}
+
+} // namespace
+
+int main()
+{
+    TestLengthPrefix();
+    TestBinaryRoundTrip();
+    TestBinaryTruncation();
+    TestJsonRoundTrip();
+    TestReceiveRing();
+    TestFramesThroughRing();
+    return UFB::Test::Result("test_p2p_protocol");
+}
@@ -0,0 +1,149 @@
+#include "parallel_folder_walk.h"
+#include "test_check.h"
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ParallelFolderWalk on a synthetic tree (no file system access): every folder visited exactly once
+// for any thread count, stopping early, and idle workers sleeping while one listing is slow
+namespace {
+
+using UFB::ParallelFolderWalk;
+
+// Folder "/a/b/c" has 1 + (a + b + c + depth) % 4 subfolders, down to depth 7
+size_t ChildCount(const std::wstring& path, size_t depth)
+{
+    if (depth >= 7)
+        return 0;
+    size_t sum = depth;
+    for (wchar_t c : path)
+        if (c != L'/')
+            sum += static_cast<size_t>(c - L'0');
+    return 1 + sum % 4;
+}
+
+size_t Depth(const std::wstring& path)
+{
+    size_t depth = 0;
+    for (wchar_t c : path)
+        if (c == L'/')
+            depth++;
+    return depth;
+}
+
+// Expected folder count, walked on this thread
+size_t CountTree(const std::wstring& path)
+{
+    size_t count = 1;
+    for (size_t i = 0; i < ChildCount(path, Depth(path)); i++)
+        count += CountTree(path + L"/" + std::to_wstring(i));
+    return count;
+}
+
+void ListChildren(const ParallelFolderWalk::Folder& folder, std::vector<ParallelFolderWalk::Folder>& outSubfolders)
+{
+    const size_t count = ChildCount(folder.path, Depth(folder.path));
+    for (size_t i = 0; i < count; i++)
+        outSubfolders.push_back({ folder.path + L"/" + std::to_wstring(i), folder.path, folder.lastWriteTime + 1 });
+}
+
+void TestVisitsEveryFolderOnce()
+{
+    const size_t expected = CountTree(L"/1");
+    UFB_CHECK(expected > 500);
+
+    for (int threads : { 1, 2, 4, 8 })
+    {
+        std::mutex mutex;
+        std::map<std::wstring, int> visits;
+        bool parentsMatch = true;
+        bool indexesValid = true;
+        std::atomic<bool> running{true};
+
+        bool completed = ParallelFolderWalk::Run({ L"/1", L"", 0 }, threads, running,
+            [&](size_t workerIndex, ParallelFolderWalk::Folder& folder, std::vector<ParallelFolderWalk::Folder>& outSubfolders) {
+                ListChildren(folder, outSubfolders);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                visits[folder.path]++;
+                if (workerIndex >= static_cast<size_t>(threads))
+                    indexesValid = false;
+                const size_t slash = folder.path.rfind(L'/');
+                if (folder.lastWriteTime != Depth(folder.path) - 1 ||
+                    (slash > 0 && folder.parent != folder.path.substr(0, slash)))
+                    parentsMatch = false;
+            });
+
+        UFB_CHECK(completed);
+        UFB_CHECK(visits.size() == expected);
+        bool once = true;
+        for (const auto& pair : visits)
+            once = once && pair.second == 1;
+        UFB_CHECK(once);
+        UFB_CHECK(parentsMatch);
+        UFB_CHECK(indexesValid);
+    }
+}
+
+void TestZeroThreads()
+{
+    std::atomic<bool> running{true};
+    size_t visited = 0;
+    bool completed = ParallelFolderWalk::Run({ L"/1", L"", 0 }, 0, running,
+        [&](size_t, ParallelFolderWalk::Folder& folder, std::vector<ParallelFolderWalk::Folder>& outSubfolders) {
+            ListChildren(folder, outSubfolders);
+            visited++;
+        });
+    UFB_CHECK(completed);
+    UFB_CHECK(visited == CountTree(L"/1"));
+}
+
+void TestStop()
+{
+    std::atomic<bool> running{true};
+    std::atomic<size_t> visited{0};
+    bool completed = ParallelFolderWalk::Run({ L"/1", L"", 0 }, 4, running,
+        [&](size_t, ParallelFolderWalk::Folder& folder, std::vector<ParallelFolderWalk::Folder>& outSubfolders) {
+            ListChildren(folder, outSubfolders);
+            if (++visited == 50)
+                running = false;
+        });
+    UFB_CHECK(!completed);
+    UFB_CHECK(visited < CountTree(L"/1"));
+}
+
+// One folder takes 300 ms to list (a slow share) while the other workers have nothing to take:
+// they must sleep, not spin
+void TestIdleWorkersSleep()
+{
+    std::atomic<bool> running{true};
+    const std::clock_t cpuStart = std::clock();
+    const auto wallStart = std::chrono::steady_clock::now();
+
+    bool completed = ParallelFolderWalk::Run({ L"/slow", L"", 0 }, 8, running,
+        [&](size_t, ParallelFolderWalk::Folder&, std::vector<ParallelFolderWalk::Folder>&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        });
+
+    const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    UFB_CHECK(completed);
+    UFB_CHECK(wallSeconds >= 0.3);
+    UFB_CHECK(cpuSeconds < 0.1);
+}
+
+} // namespace
+
+int main()
+{
+    TestVisitsEveryFolderOnce();
+    TestZeroThreads();
+    TestStop();
+    TestIdleWorkersSleep();
+    return UFB::Test::Result("test_parallel_folder_walk");
+}
@@ -0,0 +1,436 @@
+#include "extractors/psd_reader.h"
+#include "extractors/image_downscaler.h"
+#include "test_check.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Big-endian PSD/PSB writer for fixtures
+struct PsdBuilder
+{
+    std::vector<uint8_t> bytes;
+
+    void U8(uint8_t value) { bytes.push_back(value); }
+    void U16(uint16_t value) { U8(static_cast<uint8_t>(value >> 8)); U8(static_cast<uint8_t>(value)); }
+    void U32(uint32_t value) { U16(static_cast<uint16_t>(value >> 16)); U16(static_cast<uint16_t>(value)); }
+    void U64(uint64_t value) { U32(static_cast<uint32_t>(value >> 32)); U32(static_cast<uint32_t>(value)); }
+    void Bytes(const std::vector<uint8_t>& data) { bytes.insert(bytes.end(), data.begin(), data.end()); }
+    void Text(const char* text) { bytes.insert(bytes.end(), text, text + std::strlen(text)); }
+
+    // Header, empty color mode data; resources and the layer section are left to the caller
+    void Header(bool psb, uint16_t channels, uint32_t width, uint32_t height, uint16_t depth, uint16_t mode)
+    {
+        Text("8BPS");
+        U16(psb ? 2 : 1);
+        for (int i = 0; i < 6; i++)
+            U8(0);
+        U16(channels);
+        U32(height);
+        U32(width);
+        U16(depth);
+        U16(mode);
+    }
+
+    void EmptySections(bool psb)
+    {
+        U32(0);                 // Color mode data
+        U32(0);                 // Image resources
+        if (psb)
+            U64(0);             // Layer and mask info
+        else
+            U32(0);
+    }
+};
+
+struct RGBImage
+{
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint8_t> planes;   // R plane, G plane, B plane
+};
+
+RGBImage MakeRGB(uint32_t width, uint32_t height)
+{
+    RGBImage image{ width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 3) };
+    for (size_t i = 0; i < image.planes.size(); i++)
+        image.planes[i] = static_cast<uint8_t>((i * 37 + i / 7) & 0xFF);
+    return image;
+}
+
+// PackBits: literal runs only, at most 128 bytes each
+std::vector<uint8_t> PackLiteral(const uint8_t* row, size_t length)
+{
+    std::vector<uint8_t> packed;
+    for (size_t i = 0; i < length; i += 128)
+    {
+        size_t count = (std::min)(static_cast<size_t>(128), length - i);
+        packed.push_back(static_cast<uint8_t>(count - 1));
+        packed.insert(packed.end(), row + i, row + i + count);
+    }
+    return packed;
+}
+
+// 8-bit RGB document, raw or RLE composite
+std::vector<uint8_t> BuildRGB(const RGBImage& image, bool rle, bool psb = false)
+{
+    PsdBuilder psd;
+    psd.Header(psb, 3, image.width, image.height, 8, 3);
+    psd.EmptySections(psb);
+    psd.U16(rle ? 1 : 0);
+
+    if (!rle)
+    {
+        psd.Bytes(image.planes);
+        return std::move(psd.bytes);
+    }
+
+    std::vector<std::vector<uint8_t>> rows;
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        for (uint32_t y = 0; y < image.height; y++)
+        {
+            const uint8_t* row = image.planes.data() + (static_cast<size_t>(c) * image.height + y) * image.width;
+            rows.push_back(PackLiteral(row, image.width));
+        }
+    }
+    for (const auto& row : rows)
+    {
+        if (psb)
+            psd.U32(static_cast<uint32_t>(row.size()));
+        else
+            psd.U16(static_cast<uint16_t>(row.size()));
+    }
+    for (const auto& row : rows)
+        psd.Bytes(row);
+    return std::move(psd.bytes);
+}
+
+std::filesystem::path g_directory;
+
+std::wstring WriteFixture(const std::string& name, const std::vector<uint8_t>& bytes)
+{
+    std::filesystem::path path = g_directory / name;
+    FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (file)
+    {
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+        std::fclose(file);
+    }
+    return path.wstring();
+}
+
+// Decode at full size; BGRA output
+bool Decode(const std::wstring& path, std::vector<uint8_t>& bgra, int& width, int& height)
+{
+    PsdReader reader;
+    if (!reader.Open(path))
+        return false;
+
+    width = reader.GetWidth();
+    height = reader.GetHeight();
+    bgra.assign(static_cast<size_t>(width) * height * 4, 0);
+    ImageDownscaler scaler(width, height, width, height);
+    scaler.SetOutputBGRA8(bgra.data(), static_cast<size_t>(width) * 4);
+    return reader.DecodeComposite(scaler);
+}
+
+bool MatchesRGB(const std::vector<uint8_t>& bgra, const RGBImage& image)
+{
+    const size_t pixels = static_cast<size_t>(image.width) * image.height;
+    for (size_t i = 0; i < pixels; i++)
+    {
+        if (bgra[i * 4 + 2] != image.planes[i] || bgra[i * 4 + 1] != image.planes[pixels + i] ||
+            bgra[i * 4 + 0] != image.planes[2 * pixels + i] || bgra[i * 4 + 3] != 255)
+            return false;
+    }
+    return true;
+}
+
+void TestValidComposites()
+{
+    RGBImage image = MakeRGB(300, 5);   // Rows longer than one 128-byte literal run
+    std::vector<uint8_t> bgra;
+    int width = 0, height = 0;
+
+    UFB_CHECK(Decode(WriteFixture("raw.psd", BuildRGB(image, false)), bgra, width, height));
+    UFB_CHECK(width == 300 && height == 5 && MatchesRGB(bgra, image));
+
+    UFB_CHECK(Decode(WriteFixture("rle.psd", BuildRGB(image, true)), bgra, width, height));
+    UFB_CHECK(MatchesRGB(bgra, image));
+
+    // PSB: 4-byte RLE counts and an 8-byte layer section length
+    UFB_CHECK(Decode(WriteFixture("rle.psb", BuildRGB(image, true, true)), bgra, width, height));
+    UFB_CHECK(MatchesRGB(bgra, image));
+
+    // PSB allows dimensions past the PSD limit of 30000
+    RGBImage wide = MakeRGB(40000, 2);
+    UFB_CHECK(Decode(WriteFixture("wide.psb", BuildRGB(wide, true, true)), bgra, width, height));
+    UFB_CHECK(width == 40000 && MatchesRGB(bgra, wide));
+}
+
+void TestPackBitsRuns()
+{
+    // One row of 10: a repeat run, a -128 no-op, a literal, then a repeat that overruns the row
+    PsdBuilder psd;
+    psd.Header(false, 1, 10, 1, 8, 1);
+    psd.EmptySections(false);
+    psd.U16(1);
+    std::vector<uint8_t> packed = { 0xFD, 7, 0x80, 0x01, 1, 2, 0xF0, 9 };
+    psd.U16(static_cast<uint16_t>(packed.size()));
+    psd.Bytes(packed);
+
+    std::vector<uint8_t> bgra;
+    int width = 0, height = 0;
+    UFB_CHECK(Decode(WriteFixture("packbits.psd", psd.bytes), bgra, width, height));
+    const uint8_t expected[10] = { 7, 7, 7, 7, 1, 2, 9, 9, 9, 9 };
+    bool same = true;
+    for (int x = 0; x < 10; x++)
+        same = same && bgra[x * 4] == expected[x] && bgra[x * 4 + 1] == expected[x] && bgra[x * 4 + 2] == expected[x];
+    UFB_CHECK(same);
+
+    // A row that stops early leaves the rest black instead of reading the next row's bytes
+    PsdBuilder shortRow;
+    shortRow.Header(false, 1, 10, 1, 8, 1);
+    shortRow.EmptySections(false);
+    shortRow.U16(1);
+    shortRow.U16(2);
+    shortRow.Bytes({ 0x02, 5 });    // Literal of 3 with only 1 byte present
+    UFB_CHECK(Decode(WriteFixture("short_row.psd", shortRow.bytes), bgra, width, height));
+    UFB_CHECK(bgra[0] == 5 && bgra[4] == 0 && bgra[9 * 4] == 0);
+}
+
+void TestTruncatedRLE()
+{
+    RGBImage image = MakeRGB(64, 16);
+    std::vector<uint8_t> full = BuildRGB(image, true);
+    const size_t headerBytes = 26 + 4 + 4 + 4 + 2;
+    std::vector<uint8_t> bgra;
+    int width = 0, height = 0;
+
+    // File ends inside the row byte count table
+    std::vector<uint8_t> inCounts(full.begin(), full.begin() + headerBytes + 3 * 16 * 2 - 5);
+    UFB_CHECK(!Decode(WriteFixture("trunc_counts.psd", inCounts), bgra, width, height));
+
+    // File ends inside the packed rows
+    std::vector<uint8_t> inData(full.begin(), full.end() - 40);
+    UFB_CHECK(!Decode(WriteFixture("trunc_data.psd", inData), bgra, width, height));
+
+    // A row count far larger than any real encoder writes
+    std::vector<uint8_t> oversizedCount = full;
+    oversizedCount[headerBytes] = 0xFF;
+    oversizedCount[headerBytes + 1] = 0xFF;
+    UFB_CHECK(!Decode(WriteFixture("huge_count.psd", oversizedCount), bgra, width, height));
+
+    // Raw composite cut short
+    std::vector<uint8_t> raw = BuildRGB(image, false);
+    raw.resize(raw.size() - 1);
+    UFB_CHECK(!Decode(WriteFixture("trunc_raw.psd", raw), bgra, width, height));
+
+    // Unsupported (ZIP) composite compression
+    std::vector<uint8_t> zip = full;
+    zip[headerBytes - 1] = 2;
+    UFB_CHECK(!Decode(WriteFixture("zip.psd", zip), bgra, width, height));
+}
+
+void TestMalformedHeaders()
+{
+    auto opens = [](const std::string& name, const std::vector<uint8_t>& bytes) {
+        PsdReader reader;
+        return reader.Open(WriteFixture(name, bytes));
+    };
+
+    PsdBuilder tooWide;
+    tooWide.Header(false, 3, 30001, 1, 8, 3);
+    tooWide.EmptySections(false);
+    UFB_CHECK(!opens("too_wide.psd", tooWide.bytes));
+
+    PsdBuilder tooTallPSB;
+    tooTallPSB.Header(true, 3, 1, 300001, 8, 3);
+    tooTallPSB.EmptySections(true);
+    UFB_CHECK(!opens("too_tall.psb", tooTallPSB.bytes));
+
+    PsdBuilder zeroSize;
+    zeroSize.Header(false, 3, 0, 10, 8, 3);
+    zeroSize.EmptySections(false);
+    UFB_CHECK(!opens("zero.psd", zeroSize.bytes));
+
+    PsdBuilder tooManyChannels;
+    tooManyChannels.Header(false, 57, 1, 1, 8, 3);
+    tooManyChannels.EmptySections(false);
+    UFB_CHECK(!opens("channels.psd", tooManyChannels.bytes));
+
+    PsdBuilder badDepth;
+    badDepth.Header(false, 4, 1, 1, 32, 4);     // 32-bit CMYK doesn't exist
+    badDepth.EmptySections(false);
+    UFB_CHECK(!opens("depth.psd", badDepth.bytes));
+
+    PsdBuilder badVersion;
+    badVersion.Header(false, 3, 1, 1, 8, 3);
+    badVersion.bytes[5] = 3;
+    badVersion.EmptySections(false);
+    UFB_CHECK(!opens("version.psd", badVersion.bytes));
+
+    UFB_CHECK(!opens("signature.psd", { '8', 'B', 'P', 'X' }));
+    UFB_CHECK(!opens("empty.psd", {}));
+
+    // PSB 8-byte layer section length that can't be a file offset
+    PsdBuilder hugeLayers;
+    hugeLayers.Header(true, 3, 1, 1, 8, 3);
+    hugeLayers.U32(0);
+    hugeLayers.U32(0);
+    hugeLayers.U64(0xFFFFFFFFFFFFFF00ull);
+    UFB_CHECK(!opens("huge_layers.psb", hugeLayers.bytes));
+
+    // Plausible 8-byte length that points past the end: opens, but there's no composite
+    PsdBuilder pastEnd;
+    pastEnd.Header(true, 3, 2, 2, 8, 3);
+    pastEnd.U32(0);
+    pastEnd.U32(0);
+    pastEnd.U64(1ull << 33);
+    pastEnd.U16(0);
+    PsdReader reader;
+    UFB_CHECK(reader.Open(WriteFixture("past_end.psb", pastEnd.bytes)));
+    std::vector<uint8_t> out(16);
+    ImageDownscaler scaler(2, 2, 2, 2);
+    scaler.SetOutputBGRA8(out.data(), 8);
+    UFB_CHECK(!reader.DecodeComposite(scaler));
+
+    // Indexed colour without a full palette
+    PsdBuilder shortPalette;
+    shortPalette.Header(false, 1, 1, 1, 8, 2);
+    shortPalette.U32(3);
+    shortPalette.Bytes({ 1, 2, 3 });
+    shortPalette.U32(0);
+    shortPalette.U32(0);
+    UFB_CHECK(!opens("palette.psd", shortPalette.bytes));
+
+    // Section lengths past the end of the file
+    PsdBuilder truncatedSections;
+    truncatedSections.Header(false, 3, 1, 1, 8, 3);
+    truncatedSections.U32(0);
+    UFB_CHECK(!opens("sections.psd", truncatedSections.bytes));
+}
+
+void TestImageResources()
+{
+    PsdBuilder psd;
+    psd.Header(false, 3, 4, 4, 8, 3);
+    psd.U32(0);
+
+    // Thumbnail (1036): 28-byte header then the JPEG; version info (1057) with no merged data;
+    // then a block whose size runs past the section, which ends the resource scan
+    std::vector<uint8_t> jpeg = { 0xFF, 0xD8, 0xFF, 0xE0, 1, 2, 3, 0xFF, 0xD9 };
+    PsdBuilder resources;
+    resources.Text("8BIM");
+    resources.U16(1036);
+    resources.U16(0);                          // Empty Pascal name, padded to even
+    resources.U32(static_cast<uint32_t>(28 + jpeg.size()));
+    resources.U32(1);                          // kJpegRGB
+    resources.U32(160);
+    resources.U32(120);
+    for (int i = 0; i < 4; i++)
+        resources.U32(0);
+    resources.Bytes(jpeg);
+    resources.U8(0);                           // Pad odd data to even
+    resources.Text("8BIM");
+    resources.U16(1057);
+    resources.U8(3);                           // Odd-length name "abc", no pad byte
+    resources.Text("abc");
+    resources.U32(5);
+    resources.Bytes({ 0, 0, 0, 1, 0 });
+    resources.U8(0);
+    resources.Text("8BIM");
+    resources.U16(1005);
+    resources.U16(0);
+    resources.U32(1000);
+
+    psd.U32(static_cast<uint32_t>(resources.bytes.size()));
+    psd.Bytes(resources.bytes);
+    psd.U32(0);
+    psd.U16(0);
+    psd.Bytes(std::vector<uint8_t>(4 * 4 * 3, 128));
+
+    PsdReader reader;
+    UFB_CHECK(reader.Open(WriteFixture("resources.psd", psd.bytes)));
+    UFB_CHECK(reader.GetThumbnailJPEG() == jpeg);
+    UFB_CHECK(reader.GetThumbnailWidth() == 160 && reader.GetThumbnailHeight() == 120);
+    UFB_CHECK(!reader.HasMergedImage());
+
+    // The composite still decodes after the resource scan stopped early
+    std::vector<uint8_t> out(4 * 4 * 4);
+    ImageDownscaler scaler(4, 4, 4, 4);
+    scaler.SetOutputBGRA8(out.data(), 16);
+    UFB_CHECK(reader.DecodeComposite(scaler));
+    UFB_CHECK(out[0] == 128 && out[3] == 255);
+}
+
+void TestSampleDepths()
+{
+    std::vector<uint8_t> bgra;
+    int width = 0, height = 0;
+
+    // 16-bit grayscale: the high byte is the value
+    PsdBuilder gray16;
+    gray16.Header(false, 1, 2, 1, 16, 1);
+    gray16.EmptySections(false);
+    gray16.U16(0);
+    gray16.U16(0xAB12);
+    gray16.U16(0x00FF);
+    UFB_CHECK(Decode(WriteFixture("gray16.psd", gray16.bytes), bgra, width, height));
+    UFB_CHECK(bgra[0] == 0xAB && bgra[4] == 0x00);
+
+    // 32-bit grayscale: linear float, clamped, NaN to black
+    PsdBuilder gray32;
+    gray32.Header(false, 1, 4, 1, 32, 1);
+    gray32.EmptySections(false);
+    gray32.U16(0);
+    for (float value : { 1.0f, 4.0f, -1.0f })
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        gray32.U32(bits);
+    }
+    gray32.U32(0x7FC00000u);
+    UFB_CHECK(Decode(WriteFixture("gray32.psd", gray32.bytes), bgra, width, height));
+    UFB_CHECK(bgra[0] == 255 && bgra[4] == 255 && bgra[8] == 0 && bgra[12] == 0);
+
+    // 1-bit bitmap: set bits are black
+    PsdBuilder bitmap;
+    bitmap.Header(false, 1, 9, 1, 1, 0);
+    bitmap.EmptySections(false);
+    bitmap.U16(0);
+    bitmap.Bytes({ 0x80, 0x80 });
+    UFB_CHECK(Decode(WriteFixture("bitmap.psd", bitmap.bytes), bgra, width, height));
+    UFB_CHECK(bgra[0] == 0 && bgra[4] == 255 && bgra[8 * 4] == 0);
+
+    // CMYK is stored inverted: 255 everywhere is white
+    PsdBuilder cmyk;
+    cmyk.Header(false, 4, 1, 1, 8, 4);
+    cmyk.EmptySections(false);
+    cmyk.U16(0);
+    cmyk.Bytes({ 255, 0, 255, 255 });
+    UFB_CHECK(Decode(WriteFixture("cmyk.psd", cmyk.bytes), bgra, width, height));
+    UFB_CHECK(bgra[0] == 255 && bgra[1] == 0 && bgra[2] == 255);
+}
+
+} // namespace
+
+int main()
+{
+    g_directory = std::filesystem::temp_directory_path() / "ufb_test_psd_reader";
+    std::filesystem::create_directories(g_directory);
+
+    TestValidComposites();
+    TestPackBitsRuns();
+    TestTruncatedRLE();
+    TestMalformedHeaders();
+    TestImageResources();
+    TestSampleDepths();
+
+    std::filesystem::remove_all(g_directory);
+    return UFB::Test::Result("test_psd_reader");
+}
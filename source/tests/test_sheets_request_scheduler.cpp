@@ -0,0 +1,424 @@
+#include "sheets_request_scheduler.h"
+#include "test_check.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SheetsRequestScheduler against a fake Sheets server that enforces per-minute read/write quotas
+// (429 past them) and can fail requests with 5xx, on a simulated clock: pacing keeps every 60-second
+// window within quota, retries back off exponentially with jitter, a 429 throttles the whole bucket,
+// and Cancel fails requests waiting for quota or backoff (real clock)
+namespace {
+
+using TimePoint = UFB::SchedulerClock::TimePoint;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+const std::string kSheetsBase = "https://sheets.googleapis.com/v4/spreadsheets/abc";
+const std::string kDriveBase = "https://www.googleapis.com/drive/v3/files";
+
+// Virtual time that jumps to a wait's deadline instead of sleeping, so minutes of pacing run at once
+class SimulatedClock : public UFB::SchedulerClock
+{
+public:
+    TimePoint Now() override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_now;
+    }
+
+    void WaitUntil(std::condition_variable&, std::unique_lock<std::mutex>&, TimePoint deadline) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_now = (std::max)(m_now, deadline);
+    }
+
+private:
+    std::mutex m_mutex;
+    TimePoint m_now = TimePoint() + std::chrono::hours(1);
+};
+
+// Fake Sheets API: answers 200 within quota (per rolling minute, reads and writes separately),
+// 429 past it, and a scripted number of 5xx for chosen URLs first. Drive requests aren't limited
+class FakeSheetsServer : public UFB::HttpClient
+{
+public:
+    struct Logged
+    {
+        TimePoint when;
+        std::string method;
+        std::string url;
+        int status;
+    };
+
+    FakeSheetsServer(UFB::SchedulerClock& clock, int readsPerMinute, int writesPerMinute)
+        : m_clock(clock), m_readsPerMinute(readsPerMinute), m_writesPerMinute(writesPerMinute) {}
+
+    // The next count requests to url get status
+    void FailNext(const std::string& url, int count, int status = 503)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_failures[url] = { count, status };
+    }
+
+    bool Send(const UFB::HttpRequest& request, UFB::HttpResponse& outResponse) override
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TimePoint now = m_clock.Now();
+        outResponse = UFB::HttpResponse();
+        outResponse.statusCode = 200;
+
+        auto failure = m_failures.find(request.url);
+        if (failure != m_failures.end() && failure->second.first > 0)
+        {
+            failure->second.first--;
+            outResponse.statusCode = failure->second.second;
+        }
+        else if (request.url.find("://sheets.googleapis.com/") != std::string::npos)
+        {
+            const bool read = request.method == "GET";
+            std::vector<TimePoint>& accepted = read ? m_acceptedReads : m_acceptedWrites;
+            const size_t inWindow = static_cast<size_t>(std::count_if(accepted.begin(), accepted.end(),
+                [&](TimePoint t) { return now - t < seconds(60); }));
+            if (inWindow >= static_cast<size_t>(read ? m_readsPerMinute : m_writesPerMinute))
+                outResponse.statusCode = 429;
+            else
+                accepted.push_back(now);
+        }
+
+        outResponse.body = request.method + " " + request.url;
+        m_log.push_back({ now, request.method, request.url, outResponse.statusCode });
+        return true;
+    }
+
+    std::vector<bool> SendBatch(const std::vector<UFB::HttpRequest>& requests,
+                                std::vector<UFB::HttpResponse>& outResponses) override
+    {
+        outResponses.assign(requests.size(), UFB::HttpResponse());
+        std::vector<bool> results;
+        for (size_t i = 0; i < requests.size(); i++)
+            results.push_back(Send(requests[i], outResponses[i]));
+        return results;
+    }
+
+    UFB::HttpClientStats GetStats() const override { return UFB::HttpClientStats(); }
+    void CloseIdleConnections() override {}
+
+    std::vector<Logged> Log() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_log;
+    }
+
+    int Count(int status) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<int>(std::count_if(m_log.begin(), m_log.end(), [&](const Logged& l) { return l.status == status; }));
+    }
+
+private:
+    UFB::SchedulerClock& m_clock;
+    int m_readsPerMinute;
+    int m_writesPerMinute;
+    std::map<std::string, std::pair<int, int>> m_failures;     // url -> (remaining, status)
+    std::vector<TimePoint> m_acceptedReads;
+    std::vector<TimePoint> m_acceptedWrites;
+    std::vector<Logged> m_log;
+    mutable std::mutex m_mutex;
+};
+
+UFB::HttpRequest Request(const std::string& method, const std::string& url)
+{
+    UFB::HttpRequest request;
+    request.method = method;
+    request.url = url;
+    return request;
+}
+
+// Most requests of a method the server saw in any 60-second window
+size_t MaxPerMinute(const std::vector<FakeSheetsServer::Logged>& log, bool reads)
+{
+    std::vector<TimePoint> times;
+    for (const auto& logged : log)
+        if (logged.url.find("://sheets.") != std::string::npos && (logged.method == "GET") == reads)
+            times.push_back(logged.when);
+    std::sort(times.begin(), times.end());
+
+    size_t most = 0;
+    for (size_t first = 0, last = 0; last < times.size(); last++)
+    {
+        while (times[last] - times[first] >= seconds(60))
+            first++;
+        most = (std::max)(most, last - first + 1);
+    }
+    return most;
+}
+
+double Seconds(TimePoint from, TimePoint to)
+{
+    return std::chrono::duration<double>(to - from).count();
+}
+
+void TestTokenBucket()
+{
+    SimulatedClock clock;
+    UFB::TokenBucket bucket(60, clock);
+    const TimePoint start = clock.Now();
+
+    // 6 at once (the burst allowance), then 54 per minute
+    for (int i = 0; i < 6; i++)
+        UFB_CHECK(bucket.Acquire());
+    UFB_CHECK(clock.Now() == start);
+    for (int i = 0; i < 54; i++)
+        UFB_CHECK(bucket.Acquire());
+    UFB_CHECK(std::abs(Seconds(start, clock.Now()) - 60.0) < 0.2);
+    UFB_CHECK(bucket.GetWaitedMs() >= 59000);
+
+    // Throttle holds every token back until it has passed
+    const TimePoint throttled = clock.Now();
+    bucket.Throttle(seconds(5));
+    UFB_CHECK(bucket.Acquire());
+    UFB_CHECK(clock.Now() - throttled >= seconds(5));
+}
+
+// 200 Sheets reads, 100 writes and 52 Drive requests over four jobs: no 429, every minute in quota
+void TestPacingWithinQuota()
+{
+    SimulatedClock clock;
+    FakeSheetsServer server(clock, 60, 60);
+    UFB::SheetsRequestScheduler scheduler(UFB::SheetsQuotaOptions(), clock);
+    const TimePoint start = clock.Now();
+
+    std::vector<bool> results = scheduler.RunJobs(4, [&](size_t job) {
+        bool ok = true;
+        for (int i = 0; i < 50; i++)
+        {
+            UFB::HttpResponse response;
+            const std::string cell = "/values/J" + std::to_string(job) + "R" + std::to_string(i);
+            ok = scheduler.Execute(server, Request("GET", kSheetsBase + cell), response) && response.statusCode == 200 && ok;
+            if (i % 2 == 0)
+                ok = scheduler.Execute(server, Request("PUT", kSheetsBase + cell), response) && response.statusCode == 200 && ok;
+            if (i % 4 == 0)
+                ok = scheduler.Execute(server, Request("GET", kDriveBase + "/f" + std::to_string(i)), response) && ok;
+        }
+        return ok;
+    });
+
+    UFB_CHECK(std::count(results.begin(), results.end(), true) == 4);
+    UFB_CHECK(server.Count(429) == 0);
+    UFB_CHECK(server.Log().size() == 200 + 100 + 52);
+    UFB_CHECK(MaxPerMinute(server.Log(), true) <= 60);
+    UFB_CHECK(MaxPerMinute(server.Log(), false) <= 60);
+
+    // Reads set the pace: 6 at once, then 54 a minute, with little slack
+    const double elapsed = Seconds(start, clock.Now());
+    std::cout << "200 reads paced over " << elapsed << " s" << std::endl;
+    UFB_CHECK(elapsed >= (200 - 6) / 0.9 - 1.0);
+    UFB_CHECK(elapsed <= (200 - 6) / 0.9 + 5.0);
+
+    UFB::SheetsSchedulerStats stats = scheduler.GetStats();
+    UFB_CHECK(stats.requests == 352);
+    UFB_CHECK(stats.retries == 0);
+}
+
+// 5xx: retried after 1, 2, 4, 8 s (+ up to 1 s jitter each), truncated at maxBackoffMs
+void TestBackoffWithJitter()
+{
+    SimulatedClock clock;
+    FakeSheetsServer server(clock, 1000, 1000);
+    UFB::SheetsQuotaOptions options;
+    options.readRequestsPerMinute = 6000;
+    options.writeRequestsPerMinute = 6000;
+    UFB::SheetsRequestScheduler scheduler(options, clock);
+
+    std::set<long long> jitters;
+    for (int request = 0; request < 10; request++)
+    {
+        const std::string url = kSheetsBase + "/values/B" + std::to_string(request);
+        server.FailNext(url, 4);
+        const size_t logStart = server.Log().size();
+
+        UFB::HttpResponse response;
+        UFB_CHECK(scheduler.Execute(server, Request("GET", url), response));
+        UFB_CHECK(response.statusCode == 200);
+
+        std::vector<FakeSheetsServer::Logged> log = server.Log();
+        UFB_CHECK(log.size() - logStart == 5);
+        for (size_t attempt = 1; attempt < 5 && logStart + attempt < log.size(); attempt++)
+        {
+            const long long gapMs = std::chrono::duration_cast<milliseconds>(log[logStart + attempt].when -
+                                                                              log[logStart + attempt - 1].when).count();
+            const long long baseMs = 1000LL << (attempt - 1);
+            UFB_CHECK(gapMs >= baseMs && gapMs <= baseMs + 1000 + 1);
+            jitters.insert(gapMs - baseMs);
+        }
+    }
+    UFB_CHECK(jitters.size() > 10);
+
+    // Retries run out: the last 503 is returned
+    const std::string failing = kSheetsBase + "/values:batchUpdate";
+    server.FailNext(failing, 100);
+    UFB::HttpResponse response;
+    UFB_CHECK(scheduler.Execute(server, Request("POST", failing), response));
+    UFB_CHECK(response.statusCode == 503);
+
+    // A POST that creates something isn't repeated on 5xx
+    const std::string create = kSheetsBase + ":addSheet";
+    server.FailNext(create, 1);
+    const size_t before = server.Log().size();
+    UFB_CHECK(scheduler.Execute(server, Request("POST", create), response));
+    UFB_CHECK(response.statusCode == 503);
+    UFB_CHECK(server.Log().size() - before == 1);
+
+    UFB::SheetsSchedulerStats stats = scheduler.GetStats();
+    UFB_CHECK(stats.retries == 10 * 4 + 5);
+    UFB_CHECK(stats.serverErrors == 10 * 4 + 6 + 1);
+
+    // Truncated at maxBackoffMs
+    options.maxBackoffMs = 3000;
+    UFB::SheetsRequestScheduler truncated(options, clock);
+    const std::string slow = kSheetsBase + "/values/T1";
+    server.FailNext(slow, 5);
+    const size_t logStart = server.Log().size();
+    UFB_CHECK(truncated.Execute(server, Request("GET", slow), response) && response.statusCode == 200);
+    std::vector<FakeSheetsServer::Logged> log = server.Log();
+    for (size_t i = logStart + 1; i < log.size(); i++)
+        UFB_CHECK(log[i].when - log[i - 1].when <= milliseconds(3000));
+}
+
+// The scheduler thinks it has twice the server's read quota: 429s throttle the read bucket for
+// every job at once, while writes carry on
+void TestRateLimitThrottlesBucket()
+{
+    SimulatedClock clock;
+    FakeSheetsServer server(clock, 30, 60);
+    UFB::SheetsQuotaOptions options;
+    options.readRequestsPerMinute = 60;
+    options.maxRetries = 10;
+    UFB::SheetsRequestScheduler scheduler(options, clock);
+
+    std::vector<bool> results = scheduler.RunJobs(4, [&](size_t job) {
+        bool ok = true;
+        for (int i = 0; i < 30; i++)
+        {
+            UFB::HttpResponse response;
+            const std::string url = kSheetsBase + "/values/J" + std::to_string(job) + "R" + std::to_string(i);
+            ok = scheduler.Execute(server, Request("GET", url), response) && response.statusCode == 200 && ok;
+        }
+        return ok;
+    });
+    UFB_CHECK(std::count(results.begin(), results.end(), true) == 4);
+
+    std::vector<FakeSheetsServer::Logged> log = server.Log();
+    const int rateLimited = server.Count(429);
+    std::cout << "120 reads against half the assumed quota: " << rateLimited << " x 429" << std::endl;
+    UFB_CHECK(rateLimited > 0);
+    UFB_CHECK(MaxPerMinute(log, true) <= 30 + static_cast<size_t>(rateLimited));
+
+    // After a 429 the bucket hands out nothing for the backoff (at least 1 s): only requests that
+    // already held a token (one per other job) reach the server in that time
+    for (size_t i = 0; i < log.size(); i++)
+    {
+        if (log[i].status != 429)
+            continue;
+        int within = 0;
+        for (size_t j = i + 1; j < log.size() && log[j].when - log[i].when < milliseconds(1000); j++)
+            within++;
+        UFB_CHECK(within <= options.maxConcurrentJobs - 1);
+    }
+
+    // Writes have their own bucket
+    const std::string url = kSheetsBase + "/values/W1";
+    server.FailNext(kSheetsBase + "/values/R1", 1, 429);
+    UFB::HttpResponse response;
+    UFB_CHECK(scheduler.Execute(server, Request("GET", kSheetsBase + "/values/R1"), response) && response.statusCode == 200);
+    const TimePoint throttledAt = clock.Now();
+    UFB_CHECK(scheduler.Execute(server, Request("PUT", url), response) && response.statusCode == 200);
+    UFB_CHECK(clock.Now() == throttledAt);
+
+    // Batches: the 429s among them go again and succeed
+    std::vector<UFB::HttpRequest> batch;
+    for (int i = 0; i < 10; i++)
+        batch.push_back(Request("GET", kSheetsBase + "/values/Batch" + std::to_string(i)));
+    server.FailNext(batch[3].url, 1, 429);
+    server.FailNext(batch[7].url, 1, 503);
+    std::vector<UFB::HttpResponse> responses;
+    std::vector<bool> batchResults = scheduler.ExecuteBatch(server, batch, responses);
+    bool allOk = true;
+    for (size_t i = 0; i < batch.size(); i++)
+        allOk = allOk && batchResults[i] && responses[i].statusCode == 200;
+    UFB_CHECK(allOk);
+}
+
+// Real clock: Cancel fails a request waiting for a token and one waiting out a backoff
+void TestCancel()
+{
+    using Clock = std::chrono::steady_clock;
+    FakeSheetsServer server(UFB::SchedulerClock::Steady(), 1000, 1000);
+    UFB::SheetsQuotaOptions options;
+    options.readRequestsPerMinute = 1;
+    UFB::SheetsRequestScheduler scheduler(options);
+
+    UFB::HttpResponse response;
+    UFB_CHECK(scheduler.Execute(server, Request("GET", kSheetsBase + "/values/C1"), response));
+
+    // The next read waits about a minute for its token
+    std::atomic<bool> finished{false};
+    bool result = true;
+    Clock::time_point cancelled;
+    std::thread waiting([&]() {
+        UFB::HttpResponse waitingResponse;
+        result = scheduler.Execute(server, Request("GET", kSheetsBase + "/values/C2"), waitingResponse);
+        finished = true;
+    });
+    std::this_thread::sleep_for(milliseconds(100));
+    UFB_CHECK(!finished);
+    cancelled = Clock::now();
+    scheduler.Cancel();
+    waiting.join();
+    UFB_CHECK(!result);
+    UFB_CHECK(Clock::now() - cancelled < milliseconds(500));
+
+    // Backoff of a write (1-2 s) is cut short too
+    scheduler.Resume();
+    const std::string url = kSheetsBase + "/values:batchUpdate";
+    server.FailNext(url, 10);
+    finished = false;
+    std::thread backingOff([&]() {
+        UFB::HttpResponse backoffResponse;
+        result = scheduler.Execute(server, Request("POST", url), backoffResponse);
+        finished = true;
+    });
+    std::this_thread::sleep_for(milliseconds(200));
+    UFB_CHECK(!finished);
+    cancelled = Clock::now();
+    scheduler.Cancel();
+    backingOff.join();
+    UFB_CHECK(!result);
+    UFB_CHECK(Clock::now() - cancelled < milliseconds(500));
+
+    // Drive requests aren't paced, and go through again after Resume
+    scheduler.Resume();
+    UFB_CHECK(scheduler.Execute(server, Request("GET", kDriveBase + "/f1"), response) && response.statusCode == 200);
+}
+
+} // namespace
+
+int main()
+{
+    TestTokenBucket();
+    TestPacingWithinQuota();
+    TestBackoffWithJitter();
+    TestRateLimitThrottlesBucket();
+    TestCancel();
+    return UFB::Test::Result("test_sheets_request_scheduler");
+}
@@ -0,0 +1,324 @@
+#include "sheets_write_planner.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace UFB;
+
+namespace {
+
+const char* kTab = "3D";
+const char* kSheetId = "123456";
+
+SheetRow Header()
+{
+    return SheetRow{ { "Name", "Shot Path", "Item Type", "Folder Type", "Status", "Category", "Priority", "Due Date",
+                       "Artist", "Note", "Links", "Last Modified", "ModifiedTime", "SyncedTime", "Device ID" } };
+}
+
+SheetRow ItemRow(int n, const std::string& status = "In Progress")
+{
+    std::string name = "sh" + std::to_string(n * 10);
+    return SheetRow{ { name, "shots/" + name, "shot", "3d", status, "Animation", "MEDIUM", "2024-11-15",
+                       "artist", "", "", "2024-10-01 10:15 AM", std::to_string(1700000000000ull + n),
+                       "1710000000000", "WORKSTATION-07" } };
+}
+
+// Changes the way SheetsCacheManager::DetectChanges reports them (rows as cache rows, deletions by path)
+SheetsCacheManager::ChangeDetection Changes(const std::vector<SheetRow>& modified, const std::vector<SheetRow>& added,
+                                            const std::vector<std::string>& deletedPaths)
+{
+    SheetsCacheManager::ChangeDetection changes;
+    for (const auto& row : modified)
+        changes.modifiedRows.push_back(ToCachedSheetRow(row));
+    for (const auto& row : added)
+        changes.addedRows.push_back(ToCachedSheetRow(row));
+    changes.deletedPaths = deletedPaths;
+    return changes;
+}
+
+SheetWritePlan Plan(const std::vector<SheetRow>& sheet, const std::vector<SheetRow>& local,
+                    const SheetsCacheManager::ChangeDetection& changes)
+{
+    SheetRowIndex index(sheet);
+    return PlanSheetWrites(kTab, kSheetId, sheet, index, local, changes);
+}
+
+// Parse "Tab!E12:L14" into 0-based rows and columns
+bool ParseRange(const std::string& range, int& firstRow, int& lastRow, int& firstColumn, int& lastColumn)
+{
+    size_t pos = range.find('!');
+    if (pos == std::string::npos)
+        return false;
+    ++pos;
+
+    auto column = [&range, &pos]()
+    {
+        int value = 0;
+        while (pos < range.size() && std::isalpha(static_cast<unsigned char>(range[pos])))
+            value = value * 26 + (range[pos++] - 'A' + 1);
+        return value - 1;
+    };
+    auto row = [&range, &pos]()
+    {
+        int value = 0;
+        while (pos < range.size() && std::isdigit(static_cast<unsigned char>(range[pos])))
+            value = value * 10 + (range[pos++] - '0');
+        return value - 1;
+    };
+
+    firstColumn = column();
+    firstRow = row();
+    if (pos >= range.size() || range[pos++] != ':')
+        return false;
+    lastColumn = column();
+    lastRow = row();
+    return pos == range.size() && firstRow >= 0 && firstColumn >= 0 && lastRow >= firstRow && lastColumn >= firstColumn;
+}
+
+// Apply a plan the way the Sheets API does: deletions in order, then the value updates
+bool Apply(std::vector<SheetRow>& sheet, const SheetWritePlan& plan)
+{
+    for (const auto& deletion : plan.deletions)
+    {
+        if (deletion.sheetId != kSheetId || deletion.startIndex < 1 || deletion.endIndex > static_cast<int>(sheet.size()) ||
+            deletion.startIndex >= deletion.endIndex)
+            return false;
+        sheet.erase(sheet.begin() + deletion.startIndex, sheet.begin() + deletion.endIndex);
+    }
+
+    for (const auto& update : plan.updates)
+    {
+        int firstRow, lastRow, firstColumn, lastColumn;
+        if (!ParseRange(update.range, firstRow, lastRow, firstColumn, lastColumn) ||
+            static_cast<int>(update.values.size()) != lastRow - firstRow + 1)
+            return false;
+
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            const auto& values = update.values[row - firstRow];
+            if (static_cast<int>(values.size()) != lastColumn - firstColumn + 1)
+                return false;
+            if (static_cast<int>(sheet.size()) <= row)
+                sheet.resize(row + 1);
+            auto& cells = sheet[row].cells;
+            if (static_cast<int>(cells.size()) <= lastColumn)
+                cells.resize(lastColumn + 1);
+            for (int column = firstColumn; column <= lastColumn; ++column)
+                cells[column] = values[column - firstColumn];
+        }
+    }
+    return true;
+}
+
+// The tab after the plan holds the header and exactly the local rows, in order
+bool MatchesLocal(const std::vector<SheetRow>& sheet, const std::vector<SheetRow>& local)
+{
+    if (sheet.size() != local.size() + 1 || sheet[0].cells != Header().cells)
+        return false;
+
+    std::unordered_map<std::string, const SheetRow*> byPath;
+    for (const auto& row : local)
+        byPath[row.cells[1]] = &row;
+
+    for (size_t i = 1; i < sheet.size(); ++i)
+    {
+        if (!IsItemRow(sheet[i]))
+            return false;
+        auto it = byPath.find(sheet[i].cells[1]);
+        if (it == byPath.end() || it->second->cells != sheet[i].cells)
+            return false;
+        byPath.erase(it);
+    }
+    return byPath.empty();
+}
+
+std::vector<SheetRow> MakeSheet(int items)
+{
+    std::vector<SheetRow> sheet = { Header() };
+    for (int n = 0; n < items; ++n)
+        sheet.push_back(ItemRow(n));
+    return sheet;
+}
+
+void TestNoChanges()
+{
+    std::vector<SheetRow> sheet = MakeSheet(10);
+    std::vector<SheetRow> local(sheet.begin() + 1, sheet.end());
+
+    SheetWritePlan plan = Plan(sheet, local, Changes({}, {}, {}));
+    UFB_CHECK(plan.updates.empty());
+    UFB_CHECK(plan.deletions.empty());
+    UFB_CHECK(plan.cellsWritten == 0);
+}
+
+void TestModifiedCellsOnly()
+{
+    std::vector<SheetRow> sheet = MakeSheet(10);
+    std::vector<SheetRow> local(sheet.begin() + 1, sheet.end());
+
+    // One cell of item 3 (sheet row 5): only that cell is written
+    local[3].cells[4] = "For Review";
+    SheetWritePlan plan = Plan(sheet, local, Changes({ local[3] }, {}, {}));
+    UFB_CHECK(plan.updates.size() == 1);
+    UFB_CHECK(!plan.updates.empty() && plan.updates[0].range == "3D!E5:E5");
+    UFB_CHECK(plan.cellsWritten == 1);
+    UFB_CHECK(plan.rowsUpdated == 1);
+    UFB_CHECK(plan.deletions.empty());
+
+    // Cells E and L of the same row: one range spanning both
+    local[3].cells[11] = "2024-10-18 09:00 AM";
+    plan = Plan(sheet, local, Changes({ local[3] }, {}, {}));
+    UFB_CHECK(plan.updates.size() == 1);
+    UFB_CHECK(!plan.updates.empty() && plan.updates[0].range == "3D!E5:L5");
+    UFB_CHECK(plan.cellsWritten == 8);
+
+    // Adjacent rows share a range as wide as both; a row further down gets its own
+    local[4].cells[8] = "someone else";
+    local[8].cells[4] = "Final";
+    plan = Plan(sheet, local, Changes({ local[8], local[3], local[4] }, {}, {}));
+    UFB_CHECK(plan.updates.size() == 2);
+    UFB_CHECK(plan.updates.size() == 2 && plan.updates[0].range == "3D!E5:L6" && plan.updates[1].range == "3D!E10:E10");
+    UFB_CHECK(plan.rowsUpdated == 3);
+
+    std::vector<SheetRow> applied = sheet;
+    UFB_CHECK(Apply(applied, plan));
+    UFB_CHECK(MatchesLocal(applied, local));
+}
+
+void TestDeletionsAndAppends()
+{
+    std::vector<SheetRow> sheet = MakeSheet(10);
+    std::vector<SheetRow> local;
+    for (int n = 0; n < 10; ++n)
+    {
+        if (n != 1 && n != 2 && n != 6)
+            local.push_back(ItemRow(n));
+    }
+    local[4].cells[4] = "Final";        // Item 7, sheet row 9 before the deletions, 6 after
+    local.push_back(ItemRow(20));
+    local.push_back(ItemRow(21));
+
+    SheetWritePlan plan = Plan(sheet, local,
+                               Changes({ local[4] }, { local[7], local[8] }, { "shots/sh10", "shots/sh20", "shots/sh60" }));
+
+    // Contiguous runs, bottom-up
+    UFB_CHECK(plan.deletions.size() == 2);
+    UFB_CHECK(plan.deletions.size() == 2 && plan.deletions[0].startIndex == 7 && plan.deletions[0].endIndex == 8);
+    UFB_CHECK(plan.deletions.size() == 2 && plan.deletions[1].startIndex == 2 && plan.deletions[1].endIndex == 4);
+    UFB_CHECK(plan.rowsDeleted == 3);
+
+    // Updates address the tab after the deletions; the appended rows follow the last remaining row
+    UFB_CHECK(plan.updates.size() == 2);
+    UFB_CHECK(plan.updates.size() == 2 && plan.updates[0].range == "3D!E6:E6");
+    UFB_CHECK(plan.updates.size() == 2 && plan.updates[1].range == "3D!A9:O10");
+    UFB_CHECK(plan.rowsAppended == 2);
+
+    std::vector<SheetRow> applied = sheet;
+    UFB_CHECK(Apply(applied, plan));
+    UFB_CHECK(MatchesLocal(applied, local));
+}
+
+void TestStrayRows()
+{
+    // Blank row, partial row, and a duplicated path (the last copy is the one kept)
+    std::vector<SheetRow> sheet = MakeSheet(6);
+    sheet.insert(sheet.begin() + 2, SheetRow{ { "", "" } });
+    sheet.insert(sheet.begin() + 5, SheetRow{ { "sh99", "shots/sh99", "shot" } });
+    SheetRow staleCopy = ItemRow(4, "Stale");
+    sheet.insert(sheet.begin() + 3, staleCopy);
+
+    std::vector<SheetRow> local;
+    for (int n = 0; n < 6; ++n)
+        local.push_back(ItemRow(n));
+
+    SheetRowIndex index(sheet);
+    UFB_CHECK(index.Find("shots/sh40") > 3);     // Last copy
+    UFB_CHECK(index.Find("shots/sh99") == -1);   // Partial rows aren't items
+
+    SheetWritePlan plan = Plan(sheet, local, Changes({}, {}, {}));
+    UFB_CHECK(plan.rowsDeleted == 3);
+    UFB_CHECK(plan.updates.empty());
+
+    std::vector<SheetRow> applied = sheet;
+    UFB_CHECK(Apply(applied, plan));
+    UFB_CHECK(MatchesLocal(applied, local));
+}
+
+void TestEmptyTab()
+{
+    std::vector<SheetRow> sheet = { Header() };
+    std::vector<SheetRow> local = { ItemRow(0), ItemRow(1), ItemRow(2) };
+
+    SheetWritePlan plan = Plan(sheet, local, Changes({}, local, {}));
+    UFB_CHECK(plan.deletions.empty());
+    UFB_CHECK(plan.updates.size() == 1);
+    UFB_CHECK(!plan.updates.empty() && plan.updates[0].range == "3D!A2:O4");
+    UFB_CHECK(plan.cellsWritten == 45);
+
+    std::vector<SheetRow> applied = sheet;
+    UFB_CHECK(Apply(applied, plan));
+    UFB_CHECK(MatchesLocal(applied, local));
+}
+
+void TestMixedLargeTab()
+{
+    // Every third item modified, every seventh deleted, a few added, strays scattered
+    std::vector<SheetRow> sheet = MakeSheet(1000);
+    for (int i = 0; i < 20; ++i)
+        sheet.insert(sheet.begin() + 1 + i * 45, SheetRow{ { "" } });
+
+    std::vector<SheetRow> local;
+    std::vector<SheetRow> modified;
+    std::vector<std::string> deleted;
+    for (int n = 0; n < 1000; ++n)
+    {
+        SheetRow row = ItemRow(n);
+        if (n % 7 == 0)
+        {
+            deleted.push_back(row.cells[1]);
+            continue;
+        }
+        if (n % 3 == 0)
+        {
+            row.cells[4] = "For Review";
+            row.cells[12] = std::to_string(1800000000000ull + n);
+            modified.push_back(row);
+        }
+        local.push_back(row);
+    }
+    std::vector<SheetRow> added;
+    for (int n = 1000; n < 1010; ++n)
+    {
+        added.push_back(ItemRow(n));
+        local.push_back(added.back());
+    }
+
+    SheetWritePlan plan = Plan(sheet, local, Changes(modified, added, deleted));
+    UFB_CHECK(plan.rowsUpdated == static_cast<int>(modified.size()));
+    UFB_CHECK(plan.rowsAppended == 10);
+    UFB_CHECK(plan.rowsDeleted == static_cast<int>(deleted.size()) + 20);
+
+    // Far fewer cells than rewriting the tab
+    UFB_CHECK(plan.cellsWritten < local.size() * 15 / 2);
+
+    std::vector<SheetRow> applied = sheet;
+    UFB_CHECK(Apply(applied, plan));
+    UFB_CHECK(MatchesLocal(applied, local));
+}
+
+} // namespace
+
+int main()
+{
+    TestNoChanges();
+    TestModifiedCellsOnly();
+    TestDeletionsAndAppends();
+    TestStrayRows();
+    TestEmptyTab();
+    TestMixedLargeTab();
+    return UFB::Test::Result("test_sheets_write_planner");
+}
@@ -0,0 +1,190 @@
+#include "sync_summary.h"
+#include "metadata_manager.h"
+#include "test_check.h"
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace UFB;
+
+namespace {
+
+Shot MakeShot(const std::wstring& path, uint64_t modifiedTime, const std::string& deviceId)
+{
+    Shot shot;
+    shot.shotPath = path;
+    shot.shotType = "vfx_shot";
+    shot.modifiedTime = modifiedTime;
+    shot.deviceId = deviceId;
+    return shot;
+}
+
+std::vector<Shot> MakeJob()
+{
+    std::vector<Shot> shots;
+    for (int i = 0; i < 500; ++i)
+    {
+        shots.push_back(MakeShot(L"seq01/sh" + std::to_wstring(i * 10), 1700000000000ull + i,
+                                 i % 3 == 0 ? "device-a" : "device-b"));
+    }
+    return shots;
+}
+
+// Shots the peer sends back for a range request: in the differing buckets and not known to the requester
+// (what SyncManager::OnSyncSummaryReceived asks for and GetShotsInBuckets answers)
+std::vector<Shot> RangeTransfer(const std::vector<Shot>& requester, const std::vector<Shot>& peer)
+{
+    std::vector<uint32_t> buckets = SyncSummary::Build(requester).DifferingBuckets(SyncSummary::Build(peer));
+    std::set<uint32_t> differing(buckets.begin(), buckets.end());
+
+    std::set<uint64_t> known;
+    for (const auto& shot : requester)
+    {
+        if (differing.count(SyncSummary::BucketOf(shot.shotPath)) > 0)
+            known.insert(SyncSummary::HashShot(shot));
+    }
+
+    std::vector<Shot> sent;
+    for (const auto& shot : peer)
+    {
+        if (differing.count(SyncSummary::BucketOf(shot.shotPath)) > 0 && known.count(SyncSummary::HashShot(shot)) == 0)
+            sent.push_back(shot);
+    }
+    return sent;
+}
+
+void TestSameState()
+{
+    std::vector<Shot> shots = MakeJob();
+    std::vector<Shot> shuffled(shots.rbegin(), shots.rend());
+
+    SyncSummary a = SyncSummary::Build(shots);
+    SyncSummary b = SyncSummary::Build(shuffled);
+    UFB_CHECK(a.IsFull());
+    UFB_CHECK(a.root != 0);
+    UFB_CHECK(a.root == b.root);
+    UFB_CHECK(a.DifferingBuckets(b).empty());
+    UFB_CHECK(!a.IsBehind(b) && !b.IsBehind(a));
+    UFB_CHECK(a.versionVector.size() == 2);
+    UFB_CHECK(a.versionVector["device-a"] == 1700000000000ull + 498);
+    UFB_CHECK(a.versionVector["device-b"] == 1700000000000ull + 499);
+
+    UFB_CHECK(SyncSummary::Build({}).root == 0);
+}
+
+void TestUpdatedShot()
+{
+    std::vector<Shot> local = MakeJob();
+    std::vector<Shot> remote = local;
+    remote[42].modifiedTime = 1800000000000ull;
+    remote[42].deviceId = "device-c";
+
+    SyncSummary localSummary = SyncSummary::Build(local);
+    SyncSummary remoteSummary = SyncSummary::Build(remote);
+    UFB_CHECK(localSummary.root != remoteSummary.root);
+
+    // Only the changed shot's bucket differs, and only that shot travels
+    std::vector<uint32_t> differing = localSummary.DifferingBuckets(remoteSummary);
+    UFB_CHECK(differing.size() == 1);
+    UFB_CHECK(!differing.empty() && differing[0] == SyncSummary::BucketOf(remote[42].shotPath));
+
+    std::vector<Shot> sent = RangeTransfer(local, remote);
+    UFB_CHECK(sent.size() == 1);
+    UFB_CHECK(!sent.empty() && sent[0].shotPath == remote[42].shotPath && sent[0].deviceId == "device-c");
+
+    // The vector shows who is behind
+    UFB_CHECK(localSummary.IsBehind(remoteSummary));
+    UFB_CHECK(!remoteSummary.IsBehind(localSummary));
+}
+
+void TestAddedAndRemovedShots()
+{
+    std::vector<Shot> local = MakeJob();
+    std::vector<Shot> remote = local;
+    remote.push_back(MakeShot(L"seq02/sh010", 1700000000999ull, "device-b"));
+    remote.erase(remote.begin() + 7);
+
+    std::vector<uint32_t> differing = SyncSummary::Build(local).DifferingBuckets(SyncSummary::Build(remote));
+    std::set<uint32_t> expected = { SyncSummary::BucketOf(L"seq02/sh010"), SyncSummary::BucketOf(local[7].shotPath) };
+    UFB_CHECK(std::set<uint32_t>(differing.begin(), differing.end()) == expected);
+
+    std::vector<Shot> sent = RangeTransfer(local, remote);
+    UFB_CHECK(sent.size() == 1);
+    UFB_CHECK(!sent.empty() && sent[0].shotPath == L"seq02/sh010");
+}
+
+void TestConcurrentWrites()
+{
+    // Both sides wrote since they last met: each vector is ahead somewhere, so both pull. Each side
+    // gets the other's new write plus its older copy of the shot it changed itself (dropped by
+    // last-writer-wins when applied)
+    std::vector<Shot> local = MakeJob();
+    std::vector<Shot> remote = local;
+    local[3].modifiedTime = 1800000000000ull;
+    remote[4].modifiedTime = 1800000000001ull;
+    remote[4].deviceId = "device-c";
+
+    SyncSummary localSummary = SyncSummary::Build(local);
+    SyncSummary remoteSummary = SyncSummary::Build(remote);
+    UFB_CHECK(localSummary.root != remoteSummary.root);
+    UFB_CHECK(localSummary.IsBehind(remoteSummary));
+    UFB_CHECK(remoteSummary.IsBehind(localSummary));
+
+    std::vector<Shot> pulled = RangeTransfer(local, remote);
+    UFB_CHECK(pulled.size() == 2);
+    UFB_CHECK(std::any_of(pulled.begin(), pulled.end(),
+                          [](const Shot& shot) { return shot.deviceId == "device-c"; }));
+
+    pulled = RangeTransfer(remote, local);
+    UFB_CHECK(pulled.size() == 2);
+    UFB_CHECK(std::any_of(pulled.begin(), pulled.end(),
+                          [](const Shot& shot) { return shot.modifiedTime == 1800000000000ull; }));
+}
+
+void TestCompactAndJson()
+{
+    SyncSummary full = SyncSummary::Build(MakeJob());
+    SyncSummary compact = full.Compact();
+    UFB_CHECK(!compact.IsFull());
+    UFB_CHECK(compact.root == full.root);
+    UFB_CHECK(compact.versionVector == full.versionVector);
+    UFB_CHECK(full.DifferingBuckets(compact).empty());
+
+    SyncSummary parsed;
+    UFB_CHECK(SyncSummary::FromJson(full.ToJson(), parsed));
+    UFB_CHECK(parsed.IsFull() && parsed.root == full.root && parsed.buckets == full.buckets);
+    UFB_CHECK(parsed.versionVector == full.versionVector);
+
+    nlohmann::json compactJson = compact.ToJson();
+    UFB_CHECK(!compactJson.contains("buckets"));
+    UFB_CHECK(SyncSummary::FromJson(compactJson, parsed));
+    UFB_CHECK(!parsed.IsFull() && parsed.root == full.root);
+
+    // Malformed summaries from a peer are rejected
+    nlohmann::json shortBuckets = full.ToJson();
+    shortBuckets["buckets"].erase(shortBuckets["buckets"].begin());
+    UFB_CHECK(!SyncSummary::FromJson(shortBuckets, parsed));
+
+    nlohmann::json badVector = full.ToJson();
+    badVector["versionVector"] = "device-a";
+    UFB_CHECK(!SyncSummary::FromJson(badVector, parsed));
+
+    nlohmann::json badBuckets = full.ToJson();
+    badBuckets["buckets"][0] = "x";
+    UFB_CHECK(!SyncSummary::FromJson(badBuckets, parsed));
+
+    UFB_CHECK(!SyncSummary::FromJson(nlohmann::json::array(), parsed));
+}
+
+} // namespace
+
+int main()
+{
+    TestSameState();
+    TestUpdatedShot();
+    TestAddedAndRemovedShots();
+    TestConcurrentWrites();
+    TestCompactAndJson();
+    return UFB::Test::Result("test_sync_summary");
+}
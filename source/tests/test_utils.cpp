@@ -0,0 +1,80 @@
+#include "utils.h"
+
+// Portable stand-ins for the utils.cpp functions the tested modules call (utils.cpp is Win32 only)
+namespace UFB {
+
+std::string WideToUtf8(const std::wstring& wstr)
+{
+    std::string result;
+    for (size_t i = 0; i < wstr.size(); ++i)
+    {
+        uint32_t code = static_cast<uint32_t>(wstr[i]);
+
+        // UTF-16 surrogate pair (16-bit wchar_t)
+        if (code >= 0xD800 && code <= 0xDBFF && i + 1 < wstr.size())
+        {
+            uint32_t low = static_cast<uint32_t>(wstr[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF)
+            {
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+            }
+        }
+
+        if (code < 0x80)
+        {
+            result.push_back(static_cast<char>(code));
+        }
+        else if (code < 0x800)
+        {
+            result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else if (code < 0x10000)
+        {
+            result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+        else
+        {
+            result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+    return result;
+}
+
+std::wstring Utf8ToWide(const std::string& str)
+{
+    std::wstring result;
+    for (size_t i = 0; i < str.size();)
+    {
+        uint8_t lead = static_cast<uint8_t>(str[i]);
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 1;
+        if (i + length > str.size())
+            length = 1;
+
+        uint32_t code = length == 1 ? lead : lead & (0x7F >> length);
+        for (size_t j = 1; j < length; ++j)
+            code = (code << 6) | (static_cast<uint8_t>(str[i + j]) & 0x3F);
+        i += length;
+
+        // UTF-16 surrogate pair (16-bit wchar_t)
+        if (sizeof(wchar_t) == 2 && code >= 0x10000)
+        {
+            code -= 0x10000;
+            result.push_back(static_cast<wchar_t>(0xD800 + (code >> 10)));
+            result.push_back(static_cast<wchar_t>(0xDC00 + (code & 0x3FF)));
+        }
+        else
+        {
+            result.push_back(static_cast<wchar_t>(code));
+        }
+    }
+    return result;
+}
+
+} // namespace UFB
@@ -0,0 +1,103 @@
+#include "xxhash64.h"
+#include "test_check.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// XXH64 (seed 0) against the reference implementation (xxhsum -H1 / libxxhash 0.8)
+namespace {
+
+// xxHash's own sanity buffer: byte i is the top byte of PRIME32 * PRIME64^i
+std::vector<uint8_t> SanityBuffer(size_t size)
+{
+    std::vector<uint8_t> buffer(size);
+    uint64_t generator = 0x9E3779B1ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        buffer[i] = static_cast<uint8_t>(generator >> 56);
+        generator *= 0x9E3779B185EBCA8Dull;
+    }
+    return buffer;
+}
+
+uint64_t Hash(const uint8_t* data, size_t length)
+{
+    UFB::XxHash64 hash;
+    hash.Update(data, length);
+    return hash.Digest();
+}
+
+uint64_t Hash(const std::string& text)
+{
+    return Hash(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+}
+
+struct KnownAnswer
+{
+    size_t length;
+    uint64_t hash;
+};
+
+// Lengths around the 4-, 8- and 32-byte paths of the algorithm
+const KnownAnswer kSanity[] = {
+    { 0, 0xEF46DB3751D8E999ull },
+    { 1, 0xE934A84ADB052768ull },
+    { 3, 0xFF7E1959CB50794Aull },
+    { 4, 0x9136A0DCA57457EEull },
+    { 8, 0xCDBCF538E71D1348ull },
+    { 14, 0x8282DCC4994E35C8ull },
+    { 31, 0x299B39A290E6D783ull },
+    { 32, 0x18B216492BB44B70ull },
+    { 33, 0x55C8DC3E578F5B59ull },
+    { 63, 0xA9EFBE0FA0F3F4E7ull },
+    { 64, 0xEF558F8ACAC2B5CDull },
+    { 100, 0x4BFE019CD91D9EA4ull },
+    { 222, 0xB641AE8CB691C174ull },
+    { 2367, 0xA82418DDEC0EA581ull },
+};
+
+void TestKnownAnswers()
+{
+    const std::vector<uint8_t> buffer = SanityBuffer(2367);
+    for (const KnownAnswer& answer : kSanity)
+        UFB_CHECK(Hash(buffer.data(), answer.length) == answer.hash);
+
+    UFB_CHECK(Hash("") == 0xEF46DB3751D8E999ull);
+    UFB_CHECK(Hash("a") == 0xD24EC4F1A98C6E5Bull);
+    UFB_CHECK(Hash("abc") == 0x44BC2CF5AD770999ull);
+    UFB_CHECK(Hash("The quick brown fox jumps over the lazy dog") == 0x0B242D361FDA71BCull);
+}
+
+// Any split of the input into Update calls gives the one-shot digest
+void TestStreaming()
+{
+    const std::vector<uint8_t> buffer = SanityBuffer(2367);
+    const uint64_t expected = 0xA82418DDEC0EA581ull;
+
+    for (size_t step : { 1, 3, 7, 31, 32, 33, 100, 1000 })
+    {
+        UFB::XxHash64 hash;
+        for (size_t offset = 0; offset < buffer.size(); offset += step)
+            hash.Update(buffer.data() + offset, (std::min)(step, buffer.size() - offset));
+        UFB_CHECK(hash.Digest() == expected);
+    }
+
+    // Empty updates change nothing, and Digest doesn't end the stream
+    UFB::XxHash64 hash;
+    hash.Update(buffer.data(), 0);
+    hash.Update(buffer.data(), 100);
+    UFB_CHECK(hash.Digest() == 0x4BFE019CD91D9EA4ull);
+    hash.Update(buffer.data() + 100, 0);
+    hash.Update(buffer.data() + 100, 122);
+    UFB_CHECK(hash.Digest() == 0xB641AE8CB691C174ull);
+}
+
+} // namespace
+
+int main()
+{
+    TestKnownAnswers();
+    TestStreaming();
+    return UFB::Test::Result("test_xxhash64");
+}